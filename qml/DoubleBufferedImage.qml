@@ -18,6 +18,10 @@ Item {
     property alias fillMode: buffer1Image.fillMode
     property bool showLoadingText: false
     property string loadingText: "Loading Images!"
+    // Largest size to decode files at (0x0 = full resolution). Zoomed-in detail comes from
+    // TiledImageLayer, so a pane only needs its screen size. Frames served from memory
+    // (image://frames) are already decoded and are shown as they are.
+    property size decodeSize: Qt.size(0, 0)
     
     // Expose image sources for effects (e.g., HueSaturation)
     readonly property string currentImageSource: frontBuffer === 1 ? buffer1Source : buffer2Source
@@ -85,6 +89,7 @@ Item {
             id: buffer1Image
             anchors.fill: parent
             source: buffer1Source
+            sourceSize: buffer1Source.indexOf("file:") === 0 ? root.decodeSize : Qt.size(0, 0)
             fillMode: Image.PreserveAspectFit
             asynchronous: false  // Synchronous for immediate display during scrubbing
             cache: false  // Disable cache - we're loading directly from disk each time
@@ -115,6 +120,7 @@ Item {
             id: buffer2Image
             anchors.fill: parent
             source: buffer2Source
+            sourceSize: buffer2Source.indexOf("file:") === 0 ? root.decodeSize : Qt.size(0, 0)
             fillMode: Image.PreserveAspectFit
             asynchronous: false  // Synchronous for immediate display during scrubbing
             cache: false  // Disable cache - we're loading directly from disk each time
@@ -14,6 +14,7 @@
  */
 
 import QtQuick 2.2
+import QtQuick.Window 2.2
 import QtGraphicalEffects 1.0
 import Theme 1.0
 
@@ -76,6 +77,9 @@ Rectangle {
             id: doubleBufferedImage
             anchors.fill: parent
             showLoadingText: true
+            // Screen resolution, rounded up to 256 px steps so resizing doesn't re-decode constantly
+            decodeSize: Qt.size(Math.ceil(width * Screen.devicePixelRatio / 256) * 256,
+                                Math.ceil(height * Screen.devicePixelRatio / 256) * 256)
             
             // Connect image errors to show error dialog
             onImageError: function(source) {
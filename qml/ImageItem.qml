@@ -9,6 +9,7 @@
  * - Context menu for image effects (hue, saturation, lightness, opacity)
  * - Smooth animations for zoom reset and context menu fade
  * - Double-buffered image loading via ReloadedAllImages component
+ * - Full-resolution tiles of the visible area while zoomed in (TiledImageLayer)
  * 
  * This component is used in:
  * - TopLayout_three.qml (3-window comparison view)
@@ -262,6 +263,55 @@ Rectangle {
     function startLoadAllImages(startFrame, endFrame, pathImageA, pathImageB, pathImageC, pathImageD){
         reloadedAllImages_Id.startLoadAllImages(startFrame, endFrame, pathImageA, pathImageB, pathImageC, pathImageD)
     }
+
+    /**
+     * @brief Area of the image shown in the viewport, in image pixels
+     *
+     * Same fit-and-center math as TiledImageLayer; zoom and pan are in the
+     * mapping from the viewport to mapImage_Id. Used for region statistics (roiStats).
+     *
+     * @param frameNumber - Frame whose image size is used
+     * @return Qt.rect in image pixels (clipped to the image), or an empty rect
+     */
+    function visibleImageRect(frameNumber){
+        var topLeft = mapImage_Id.mapFromItem(rect, 0, 0)
+        var bottomRight = mapImage_Id.mapFromItem(rect, rect.width, rect.height)
+        var area = imageRectOf(frameNumber, Math.min(topLeft.x, bottomRight.x), Math.min(topLeft.y, bottomRight.y),
+                               Math.max(topLeft.x, bottomRight.x), Math.max(topLeft.y, bottomRight.y))
+        return area.width > 0 && area.height > 0 ? area : Qt.rect(0, 0, 0, 0)
+    }
+
+    /**
+     * @brief Image pixel under a point of the (zoomed and panned) image, e.g. the cursor
+     * @param frameNumber - Frame whose image size is used
+     * @param x - X in mapImage_Id coordinates (dragArea's mouseX)
+     * @param y - Y in mapImage_Id coordinates (dragArea's mouseY)
+     * @return Qt.point in image pixels, or null if the point is outside the image
+     */
+    function imagePointAt(frameNumber, x, y){
+        var area = imageRectOf(frameNumber, x, y, x, y)
+        return area.width < 0 ? null : Qt.point(area.x, area.y)
+    }
+
+    // Map a box in mapImage_Id coordinates to image pixels (fit-and-center like TiledImageLayer),
+    // clipped to the image; width -1 if the box misses the image
+    function imageRectOf(frameNumber, x1, y1, x2, y2){
+        var imageSize = imageLoaderManager.getImageSize(Utils.IMAGE_TYPE_ORIG, frameNumber)
+        if (imageSize.width <= 0 || imageSize.height <= 0 || mapImage_Id.width <= 0 || mapImage_Id.height <= 0) {
+            return Qt.rect(0, 0, -1, -1)
+        }
+        var paintedScale = Math.min(mapImage_Id.width / imageSize.width, mapImage_Id.height / imageSize.height)
+        var offsetX = (mapImage_Id.width - imageSize.width * paintedScale) / 2
+        var offsetY = (mapImage_Id.height - imageSize.height * paintedScale) / 2
+        var left = Math.max(0, (x1 - offsetX) / paintedScale)
+        var top = Math.max(0, (y1 - offsetY) / paintedScale)
+        var right = Math.min(imageSize.width, (x2 - offsetX) / paintedScale)
+        var bottom = Math.min(imageSize.height, (y2 - offsetY) / paintedScale)
+        if (right < left || bottom < top || left >= imageSize.width || top >= imageSize.height) {
+            return Qt.rect(0, 0, -1, -1)
+        }
+        return Qt.rect(left, top, right - left, bottom - top)
+    }
     //****************************************************************
 
 
@@ -371,7 +421,8 @@ Rectangle {
                     id: mapImage_Id
                     anchors.fill: parent
                     clip:true
-                    ReloadedAllImages{ id:reloadedAllImages_Id; imagePathA:imagePathA; imagePathB:imagePathB; imagePathC:imagePathC; imagePathD:imagePathD; image_type:imageType}
+                    ReloadedAllImages{ id:reloadedAllImages_Id; imagePathA:imagePathA; imagePathB:imagePathB; imagePathC:imagePathC; imagePathD:imagePathD; image_type:imageType
+                                        zoom: imageItem_id.m_zoom2; viewportItem: rect; panX: imageHoldId.x; panY: imageHoldId.y }
                     Item{
                         id: imageMark_Id
                         visible : false
@@ -436,6 +487,9 @@ Rectangle {
                         imageTargetMark_Id.y = mouseY - (imageTargetMark_Id.width/2)
                         getMoveImageMarkX(mouseX)
                         getMoveImageMarkY(mouseY)
+                        if (imageType != "imageD"){
+                            imageThree_id.probeMoved(imageItem_id, mouseX, mouseY)
+                        }
                     }
                     onMouseXChanged: {
                         // Fallback for compatibility
@@ -4,6 +4,12 @@
  * 
  * A separate, independent window that displays log messages from the Logger singleton.
  * Can be moved outside the main application window.
+ * 
+ * Logger is a C++ list model (LogModel), filtered by level; the ListView only creates
+ * delegates for the visible lines and follows new entries while scrolled to the end.
+ * 
+ * The search field searches the whole session (logSearch, a LogSearchModel over the
+ * archived log) in the background; "key:<testKey>" limits it to one test's lines.
  */
 
 import QtQuick 2.2
@@ -27,18 +33,33 @@ Window {
     // Window properties
     property bool isVisible: false
     
+    // Level checkboxes as a LogModel::Level bit mask (for the archive search)
+    readonly property int levelMask: (Logger.showInfo ? 1 : 0) | (Logger.showWarning ? 2 : 0)
+                                     | (Logger.showError ? 4 : 0) | (Logger.showDebug ? 8 : 0)
+    readonly property bool searchActive: logSearch.active
+    
+    onLevelMaskChanged: {
+        if (searchField.text.length > 0) {
+            searchTimer.restart()
+        }
+    }
+    
+    // Debounce typing: search once the user pauses
+    Timer {
+        id: searchTimer
+        interval: 250
+        onTriggered: logSearch.search(searchField.text, logWindow.levelMask)
+    }
+    
     // Sync isVisible with window visibility (one-way to avoid binding loop)
     onVisibleChanged: {
         // Only update isVisible if it's different (avoid binding loop)
         if (isVisible !== visible) {
             isVisible = visible
         }
-        // Update Logger when visibility changes
-        if (Logger) {
-            Logger.logWindowVisible = visible
-            if (visible) {
-                updateLogDisplay()
-            }
+        if (visible) {
+            logListView.followTail = true
+            logListView.positionViewAtEnd()
         }
     }
     
@@ -150,6 +171,35 @@ Window {
                 }
             }
             
+            // Copies the shown (filtered) entries as plain text
+            Button {
+                text: "Copy"
+                height: 25
+                width: 60
+                onClicked: {
+                    if (logWindow.searchActive) {
+                        logSearch.copyToClipboard()
+                    } else {
+                        Logger.copyToClipboard()
+                    }
+                }
+                style: ButtonStyle {
+                    background: Rectangle {
+                        color: control.hovered ? Theme.buttonHovered : Theme.buttonDefault
+                        border.color: Theme.borderDark
+                        border.width: 1
+                        radius: 3
+                    }
+                    label: Text {
+                        text: control.text
+                        font.pixelSize: Theme.fontSizeSmall
+                        color: Theme.textLight
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                    }
+                }
+            }
+            
             // Separator
             Rectangle {
                 width: 1
@@ -168,10 +218,9 @@ Window {
             
             CheckBox {
                 id: filterInfo
-                checked: Logger && Logger.showInfo !== undefined ? Logger.showInfo : true
+                checked: Logger.showInfo
                 onCheckedChanged: {
-                    if (Logger) Logger.showInfo = checked
-                    updateLogDisplay()
+                    Logger.showInfo = checked
                 }
                 style: CheckBoxStyle {
                     label: Text {
@@ -184,10 +233,9 @@ Window {
             
             CheckBox {
                 id: filterWarning
-                checked: Logger && Logger.showWarning !== undefined ? Logger.showWarning : true
+                checked: Logger.showWarning
                 onCheckedChanged: {
-                    if (Logger) Logger.showWarning = checked
-                    updateLogDisplay()
+                    Logger.showWarning = checked
                 }
                 style: CheckBoxStyle {
                     label: Text {
@@ -200,10 +248,9 @@ Window {
             
             CheckBox {
                 id: filterError
-                checked: Logger && Logger.showError !== undefined ? Logger.showError : true
+                checked: Logger.showError
                 onCheckedChanged: {
-                    if (Logger) Logger.showError = checked
-                    updateLogDisplay()
+                    Logger.showError = checked
                 }
                 style: CheckBoxStyle {
                     label: Text {
@@ -216,10 +263,9 @@ Window {
             
             CheckBox {
                 id: filterDebug
-                checked: Logger && Logger.showDebug !== undefined ? Logger.showDebug : true
+                checked: Logger.showDebug
                 onCheckedChanged: {
-                    if (Logger) Logger.showDebug = checked
-                    updateLogDisplay()
+                    Logger.showDebug = checked
                 }
                 style: CheckBoxStyle {
                     label: Text {
@@ -240,23 +286,45 @@ Window {
             
             Text {
                 anchors.verticalCenter: parent.verticalCenter
-                text: "Entries: " + (Logger && Logger.logEntries ? Logger.logEntries.length : 0)
+                text: logWindow.searchActive
+                      ? "Matches: " + logSearch.count + (logSearch.searching ? " (searching...)" : "")
+                      : "Entries: " + Logger.count + (Logger.count !== Logger.totalCount ? " / " + Logger.totalCount : "")
                         font.pixelSize: Theme.fontSizeMedium
                 color: Theme.textLight
             }
         }
-    }
-    
-    // Function to update log display
-    function updateLogDisplay() {
-        if (Logger && typeof Logger.getFormattedTextHTML === "function") {
-            logTextArea.text = Logger.getFormattedTextHTML(0)
-        } else {
-            logTextArea.text = ""
+        
+        // Search over the whole session (not only the entries above)
+        TextField {
+            id: searchField
+            anchors.right: parent.right
+            anchors.rightMargin: 10
+            anchors.verticalCenter: parent.verticalCenter
+            width: 220
+            height: 25
+            placeholderText: "Search log (key:<test>)"
+            inputMethodHints: Qt.ImhNoPredictiveText
+            font.pixelSize: Theme.fontSizeExtraSmall
+            onTextChanged: searchTimer.restart()
+            Keys.onPressed: {
+                if (event.key === Qt.Key_Escape) {
+                    text = ""
+                    event.accepted = true
+                }
+            }
+            style: TextFieldStyle {
+                textColor: Theme.textLight
+                background: Rectangle {
+                    color: Theme.buttonDefault
+                    border.color: Theme.borderDark
+                    border.width: 1
+                    radius: 3
+                }
+            }
         }
     }
     
-    // Log content area - use TextArea for selectable, color-coded text
+    // Log content area - one delegate per visible line (selection: use Copy)
     Rectangle {
         id: logContentContainer
         anchors.top: toolbar.bottom
@@ -270,48 +338,56 @@ Window {
             anchors.fill: parent
             anchors.margins: 5
             
-            // Inner Rectangle to ensure TextArea fills space
-            Rectangle {
-                width: scrollView.width
-                height: Math.max(scrollView.height, logTextArea.implicitHeight)
-                color: Theme.backgroundDark  // Match TextArea background
+            ListView {
+                id: logListView
                 
-                TextArea {
-                    id: logTextArea
-                    anchors.fill: parent  // Fill the inner Rectangle
-                    readOnly: true
-                    textFormat: TextEdit.RichText  // Enable HTML formatting for colors
-                    text: ""
+                // Keep showing the newest entries unless the user scrolled up
+                property bool followTail: true
+                
+                model: logWindow.searchActive ? logSearch : Logger
+                clip: true
+                boundsBehavior: Flickable.StopAtBounds
+                onMovementEnded: followTail = atYEnd
+                
+                delegate: Text {
+                    width: logListView.width
+                    text: "[" + timestamp + "] [" + level + "] " + message
+                    textFormat: Text.PlainText
+                    wrapMode: Text.Wrap
                     font.family: "Consolas, Courier New, monospace"
-                        font.pixelSize: Theme.fontSizeExtraSmall
-                    selectByMouse: true  // Enable text selection
-                    wrapMode: TextEdit.Wrap
-                    
-                    style: TextAreaStyle {
-                        backgroundColor: Theme.backgroundDark
-                        textColor: Theme.textLight
-                        selectionColor: Theme.selectionHighlight
-                    }
-                    
-                    // Auto-scroll to bottom when new entries are added
-                    Connections {
-                        target: Logger ? Logger : null
-                        enabled: Logger !== null && Logger !== undefined
-                        onLogEntryAdded: {
-                            if (Logger && Logger.logWindowVisible) {
-                                updateLogDisplay()
-                                // Scroll to bottom
-                                Qt.callLater(function() {
-                                    if (scrollView.flickableItem) {
-                                        scrollView.flickableItem.contentY = Math.max(0, scrollView.flickableItem.contentHeight - scrollView.flickableItem.height)
-                                    }
-                                })
-                            }
-                        }
-                        onLogCleared: {
-                            logTextArea.text = ""
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                    color: level === "ERROR" ? Theme.statusError
+                         : level === "WARNING" ? Theme.statusWarning
+                         : level === "INFO" ? Theme.statusSuccess
+                         : Theme.textMediumGray
+                }
+                
+                Text {
+                    anchors.centerIn: parent
+                    visible: logListView.count === 0
+                    text: logWindow.searchActive ? (logSearch.searching ? "Searching..." : "No matches") : "No log entries"
+                    color: Theme.textMediumGray
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+                
+                Connections {
+                    target: Logger
+                    onEntriesAdded: {
+                        if (logWindow.visible && logListView.followTail && !logWindow.searchActive) {
+                            Qt.callLater(logListView.positionViewAtEnd)
                         }
                     }
+                    onLogCleared: {
+                        logListView.followTail = true
+                    }
+                }
+                
+                Connections {
+                    target: logSearch
+                    onResultsChanged: {
+                        logListView.followTail = true
+                        Qt.callLater(logListView.positionViewAtEnd)
+                    }
                 }
             }
         }
@@ -334,11 +410,5 @@ Window {
             x = (screen.width - width) / 2
             y = (screen.height - height) / 2
         }
-        // Initialize Logger visibility state
-        if (Logger) {
-            Logger.logWindowVisible = isVisible
-            // Initialize log display
-            updateLogDisplay()
-        }
     }
 }
@@ -151,6 +151,140 @@ Item {
         anchors.fill: parent
     }
     
+    // Live performance metrics overlay (F12), hidden by default
+    PerformanceHud {
+        id: performanceHud
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 8
+        visible: false
+        z: 100  // Above the image panes and chart
+    }
+
+    Shortcut {
+        sequence: "F12"
+        context: Qt.ApplicationShortcut
+        onActivated: {
+            performanceHud.visible = !performanceHud.visible
+            Logger.debug("[UI] Performance HUD " + (performanceHud.visible ? "shown" : "hidden"))
+        }
+    }
+
+    // RGB values under the cursor and viewport histogram (F11), hidden by default
+    PixelProbePanel {
+        id: pixelProbePanel
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 8
+        visible: false
+        z: 100  // Above the image panes and chart
+    }
+
+    Shortcut {
+        sequence: "F11"
+        context: Qt.ApplicationShortcut
+        onActivated: {
+            pixelProbePanel.visible = !pixelProbePanel.visible
+            Logger.debug("[UI] Pixel probe " + (pixelProbePanel.visible ? "shown" : "hidden"))
+        }
+    }
+
+    // Display exposure / tone curve of the A and B renders (toneMapper); shown while not the identity
+    Rectangle {
+        id: toneMapperBadge
+        readonly property bool hasToneMapper: typeof toneMapper !== "undefined" && toneMapper !== null
+        anchors.top: parent.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.margins: 8
+        width: toneMapperText.width + 16
+        height: toneMapperText.height + 8
+        radius: 4
+        color: Theme.overlayDark
+        border.color: Theme.statusWarning
+        border.width: 1
+        visible: hasToneMapper && !toneMapper.identity
+        z: 100
+
+        Text {
+            id: toneMapperText
+            anchors.centerIn: parent
+            text: !toneMapperBadge.hasToneMapper ? "" :
+                  "EV " + (toneMapper.exposure > 0 ? "+" : "") + toneMapper.exposure.toFixed(1) + "  " + toneMapper.curveName
+            color: Theme.statusWarning
+            font.pixelSize: Theme.fontSizeMedium
+        }
+    }
+
+    // Scrub proxies of the open event being built (proxyBuilder); click to stop
+    Rectangle {
+        id: proxyBuildBadge
+        readonly property bool hasProxyBuilder: typeof proxyBuilder !== "undefined" && proxyBuilder !== null
+        anchors.top: toneMapperBadge.visible ? toneMapperBadge.bottom : parent.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.margins: 8
+        width: proxyBuildText.width + 16
+        height: proxyBuildText.height + 12
+        radius: 4
+        color: Theme.overlayDark
+        border.color: Theme.borderAccent
+        border.width: 1
+        visible: hasProxyBuilder && proxyBuilder.building
+        z: 100
+
+        Text {
+            id: proxyBuildText
+            anchors.horizontalCenter: parent.horizontalCenter
+            anchors.top: parent.top
+            anchors.topMargin: 4
+            text: !proxyBuildBadge.hasProxyBuilder ? "" :
+                  "Building scrub proxies " + Math.round(proxyBuilder.progress * 100) + "%"
+            color: Theme.textAccent
+            font.pixelSize: Theme.fontSizeMedium
+        }
+
+        Rectangle {
+            anchors.left: parent.left
+            anchors.bottom: parent.bottom
+            anchors.margins: 2
+            height: 2
+            width: !proxyBuildBadge.hasProxyBuilder ? 0 : (parent.width - 4) * proxyBuilder.progress
+            color: Theme.borderAccent
+        }
+
+        MouseArea {
+            anchors.fill: parent
+            cursorShape: Qt.PointingHandCursor
+            onClicked: {
+                proxyBuilder.cancel()
+                Logger.info("[UI] Scrub proxy build canceled")
+            }
+        }
+    }
+
+    Shortcut {
+        sequence: "Ctrl+]"
+        context: Qt.ApplicationShortcut
+        onActivated: toneMapper.stepExposure(0.5)
+    }
+
+    Shortcut {
+        sequence: "Ctrl+["
+        context: Qt.ApplicationShortcut
+        onActivated: toneMapper.stepExposure(-0.5)
+    }
+
+    Shortcut {
+        sequence: "Ctrl+T"
+        context: Qt.ApplicationShortcut
+        onActivated: toneMapper.cycleCurve()
+    }
+
+    Shortcut {
+        sequence: "Ctrl+0"
+        context: Qt.ApplicationShortcut
+        onActivated: toneMapper.reset()
+    }
+
     /**
      * @brief Show error message in global error dialog
      * 
@@ -177,6 +311,12 @@ Item {
         }
     }
 
+    // Frame sets from FrameSetPresenter (all visible panes decoded for the frame)
+    Connections {
+        target: typeof frameSetPresenter !== "undefined" ? frameSetPresenter : null
+        onFrameSetReady: presentFrame(frame)
+    }
+
     // Connect to XmlDataModel error signals (for errors not handled by Tableview)
     Connections {
         target: xmlDataModel
@@ -228,6 +368,26 @@ Item {
             return  // Component not ready - exit early
         }
         
+        // Switch all visible panes together: the presenter emits frameSetReady once every
+        // pane's image for this frame is decoded (see presentFrame below)
+        if (typeof frameSetPresenter !== "undefined" && frameSetPresenter &&
+            chartComponent && typeof chartComponent.getVisibleImageTypes === "function") {
+            frameSetPresenter.requestFrame(val, chartComponent.getVisibleImageTypes())
+            return
+        }
+        presentFrame(val)
+    }
+    
+    /**
+     * @brief Show a frame on all image views
+     * 
+     * @param val - Frame number (already clamped to the current range)
+     */
+    function presentFrame(val) {
+        if (!swipeViewComponent || typeof swipeViewComponent.indexUpdate !== "function") {
+            return  // Component not ready - exit early
+        }
+        
         // Convert actual frame number to padded frame string for image loading
         // val is already the frame number (e.g., 388, 389, etc.)
         // formatFrameNumber with isZeroIndexed=false will pad it as-is (388 -> "0388")
@@ -321,6 +481,10 @@ Item {
             imageLoaderManager.clearCache()  // Clear cache when switching events
             Logger.debug("[UI] Image paths updated, cache cleared")
         }
+        // Scrub proxies of the event (built in the background if missing or out of date)
+        if (typeof proxyBuilder !== "undefined" && proxyBuilder) {
+            proxyBuilder.open(startFrame, endFrame)
+        }
 
         //-- when set is selected - delete old images and chart and create new images and new chart ------------
         swipeViewComponent.startLoadAllImages(startFrame, endFrame, sourcePath, testPath, diffPath, alphaPath)
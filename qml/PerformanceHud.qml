@@ -0,0 +1,189 @@
+/**
+ * @file PerformanceHud.qml
+ * @brief Overlay showing live cache, decode and frame-pacing metrics
+ *
+ * Shows the latest MetricsRegistry snapshot together with the frame pacing counters
+ * of PlaybackEngine and FrameSetPresenter, so a slow session can be diagnosed while
+ * it happens (e.g. low cache hit rate vs. slow decodes vs. a busy proxy filter).
+ * Below them, MemoryGovernor's budget and the memory held by each cache.
+ *
+ * The registry only takes snapshots while the HUD is visible. Toggled with F12 in Main.qml.
+ *
+ * Usage:
+ * ```qml
+ * PerformanceHud {
+ *     anchors.top: parent.top
+ *     anchors.right: parent.right
+ *     visible: false
+ * }
+ * ```
+ */
+
+import QtQuick 2.6
+import Theme 1.0
+
+Rectangle {
+    id: performanceHud
+
+    readonly property bool hasRegistry: typeof metricsRegistry !== "undefined" && metricsRegistry !== null
+    readonly property var snapshot: hasRegistry ? metricsRegistry.snapshot : ({})
+    readonly property bool hasGovernor: typeof memoryGovernor !== "undefined" && memoryGovernor !== null
+
+    width: 280
+    height: metricsColumn.height + 16
+    radius: 6
+    color: Theme.overlayDark
+    border.color: Theme.borderAccent
+    border.width: 1
+
+    // Snapshots cost nothing while nobody looks at them
+    onVisibleChanged: {
+        if (hasRegistry) {
+            metricsRegistry.active = visible
+        }
+    }
+
+    /**
+     * @brief Format a snapshot value
+     * @param key - Snapshot key
+     * @param unit - "ms", "%", "MB" or "" (plain number)
+     * @returns Formatted value, or "-" if not measured yet
+     */
+    function formatValue(key, unit) {
+        var value = snapshot[key]
+        if (value === undefined || value < 0) {
+            return "-"
+        }
+        if (unit === "%") {
+            return (value * 100).toFixed(0) + " %"
+        }
+        if (unit === "MB") {
+            return (value / (1024 * 1024)).toFixed(1) + " MB"
+        }
+        if (unit === "ms") {
+            return value.toFixed(value < 10 ? 2 : 0) + " ms"
+        }
+        return value.toFixed(0)
+    }
+
+    /**
+     * @brief Format a byte count in MB
+     */
+    function formatMegabytes(bytes) {
+        return (bytes / (1024 * 1024)).toFixed(1) + " MB"
+    }
+
+    /**
+     * @brief Format one HUD row
+     * @param row - {key, unit}; unit "latency" shows p50 / p99, "pair" shows key / key2
+     */
+    function formatRow(row) {
+        if (row.unit === "latency") {
+            return formatValue(row.key + "P50Ms", "ms") + " / " + formatValue(row.key + "P99Ms", "ms")
+        }
+        if (row.unit === "pair") {
+            return formatValue(row.key, "") + " / " + formatValue(row.key2, "")
+        }
+        return formatValue(row.key, row.unit)
+    }
+
+    Column {
+        id: metricsColumn
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.margins: 8
+        spacing: 2
+
+        Text {
+            text: "Performance (F12)"
+            color: Theme.textAccent
+            font.pixelSize: Theme.fontSizeMedium
+            font.bold: true
+        }
+
+        Repeater {
+            model: [
+                { label: "Frame ring hit rate", key: "frameRingHitRate", unit: "%" },
+                { label: "Compressed frame hit rate", key: "compressedFrameHitRate", unit: "%" },
+                { label: "Tile cache hit rate", key: "tileCacheHitRate", unit: "%" },
+                { label: "Image cache hit rate", key: "imageCacheHitRate", unit: "%" },
+                { label: "Cache memory", key: "cacheBytes", unit: "MB" },
+                { label: "Compressed frames", key: "compressedFrameBytes", unit: "MB" },
+                { label: "Decodes queued / running", key: "decodesQueued", key2: "decodesInFlight", unit: "pair" },
+                { label: "Decode p50 / p99", key: "decode", unit: "latency" },
+                { label: "Scrub to present p50 / p99", key: "scrubToPresent", unit: "latency" },
+                { label: "Proxy filter p50 / p99", key: "proxyFilter", unit: "latency" },
+                { label: "XML parse p50 / p99", key: "xmlParse", unit: "latency" }
+            ]
+
+            delegate: Item {
+                width: metricsColumn.width
+                height: Theme.fontSizeExtraSmall + 6
+
+                Text {
+                    anchors.left: parent.left
+                    text: modelData.label
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+                Text {
+                    anchors.right: parent.right
+                    text: performanceHud.formatRow(modelData)  // Re-evaluated on every snapshot
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+            }
+        }
+
+        // Frame pacing (PlaybackEngine while playing, FrameSetPresenter while scrubbing)
+        Text {
+            visible: typeof playbackEngine !== "undefined" && playbackEngine !== null
+            text: visible ? "Playback: " + playbackEngine.achievedFps.toFixed(1) + " fps, "
+                            + playbackEngine.droppedFrames + " dropped" : ""
+            color: Theme.textLight
+            font.pixelSize: Theme.fontSizeExtraSmall
+        }
+        Text {
+            visible: typeof frameSetPresenter !== "undefined" && frameSetPresenter !== null
+            text: visible ? "Frame sets: " + frameSetPresenter.presentedFrameSets + " shown, "
+                            + frameSetPresenter.droppedFrameSets + " dropped, "
+                            + frameSetPresenter.tornFrameSets + " torn" : ""
+            color: Theme.textLight
+            font.pixelSize: Theme.fontSizeExtraSmall
+        }
+
+        // Memory budget across all caches, then each cache (largest first)
+        Text {
+            visible: performanceHud.hasGovernor
+            text: visible ? "Memory: " + performanceHud.formatMegabytes(memoryGovernor.usedBytes) + " / "
+                            + (memoryGovernor.budgetBytes > 0 ? performanceHud.formatMegabytes(memoryGovernor.budgetBytes) : "unlimited")
+                            + (memoryGovernor.underPressure ? " (system memory low)" : "") : ""
+            color: visible && memoryGovernor.underPressure ? Theme.statusWarning : Theme.textLight
+            font.pixelSize: Theme.fontSizeExtraSmall
+        }
+        Repeater {
+            model: performanceHud.hasGovernor ? memoryGovernor.breakdown : []
+
+            delegate: Item {
+                width: metricsColumn.width
+                height: Theme.fontSizeExtraSmall + 6
+
+                Text {
+                    anchors.left: parent.left
+                    anchors.leftMargin: 8
+                    text: modelData.name
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+                Text {
+                    anchors.right: parent.right
+                    text: performanceHud.formatMegabytes(modelData.bytes)
+                          + (modelData.releasedBytes > 0 ? " (" + performanceHud.formatMegabytes(modelData.releasedBytes) + " released)" : "")
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file PixelProbePanel.qml
+ * @brief Overlay with the RGB values under the cursor and a viewport histogram
+ *
+ * Shows pixelProbe's samples: the pixel under the cursor in every pane of the
+ * A/B/C view (orig, test, diff and, if present, alpha), read from the decoded
+ * frame caches. Below them, red/green/blue histograms of the visible viewport
+ * of one pane; click A, B or C to switch panes.
+ *
+ * The probe only works while the panel is visible. Toggled with F11 in Main.qml.
+ *
+ * Usage:
+ * ```qml
+ * PixelProbePanel {
+ *     anchors.bottom: parent.bottom
+ *     anchors.left: parent.left
+ *     visible: false
+ * }
+ * ```
+ */
+
+import QtQuick 2.6
+import Theme 1.0
+
+Rectangle {
+    id: pixelProbePanel
+
+    readonly property bool hasProbe: typeof pixelProbe !== "undefined" && pixelProbe !== null
+
+    width: 280
+    height: probeColumn.height + 16
+    radius: 6
+    color: Theme.overlayDark
+    border.color: Theme.borderAccent
+    border.width: 1
+
+    onVisibleChanged: {
+        if (hasProbe) {
+            pixelProbe.active = visible
+        }
+    }
+
+    Column {
+        id: probeColumn
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.margins: 8
+        spacing: 2
+
+        Text {
+            text: "Pixel probe (F11)"
+                  + (pixelProbePanel.hasProbe && pixelProbe.samples.length > 0
+                     ? "  x " + pixelProbe.position.x + "  y " + pixelProbe.position.y : "")
+            color: Theme.textAccent
+            font.pixelSize: Theme.fontSizeMedium
+            font.bold: true
+        }
+
+        Text {
+            visible: pixelProbePanel.hasProbe && pixelProbe.samples.length === 0
+            text: "Move the cursor over the A/B/C view"
+            color: Theme.textLight
+            font.pixelSize: Theme.fontSizeExtraSmall
+        }
+
+        // One row per pane: swatch and R G B (A) values
+        Repeater {
+            model: pixelProbePanel.hasProbe ? pixelProbe.samples : []
+
+            delegate: Item {
+                width: probeColumn.width
+                height: Theme.fontSizeExtraSmall + 6
+
+                Rectangle {
+                    id: swatch
+                    anchors.left: parent.left
+                    anchors.verticalCenter: parent.verticalCenter
+                    width: 10
+                    height: 10
+                    border.color: Theme.textLight
+                    border.width: 1
+                    color: modelData.valid ? Qt.rgba(modelData.r / 255, modelData.g / 255, modelData.b / 255, 1) : "transparent"
+                }
+                Text {
+                    anchors.left: swatch.right
+                    anchors.leftMargin: 6
+                    text: modelData.label
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                }
+                Text {
+                    anchors.right: parent.right
+                    text: modelData.valid ? "R " + modelData.r + "  G " + modelData.g + "  B " + modelData.b
+                                            + (modelData.type === "D" ? "  A " + modelData.a : "")
+                                          : "decoding..."
+                    color: Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                    font.family: "Courier"
+                }
+            }
+        }
+
+        // Histogram pane selector
+        Row {
+            spacing: 8
+            Text {
+                text: "Viewport histogram:"
+                color: Theme.textLight
+                font.pixelSize: Theme.fontSizeExtraSmall
+            }
+            Repeater {
+                model: ["A", "B", "C"]
+                delegate: Text {
+                    text: modelData
+                    color: pixelProbePanel.hasProbe && pixelProbe.histogramType === modelData ? Theme.textAccent : Theme.textLight
+                    font.pixelSize: Theme.fontSizeExtraSmall
+                    font.bold: pixelProbePanel.hasProbe && pixelProbe.histogramType === modelData
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: pixelProbe.histogramType = modelData
+                    }
+                }
+            }
+        }
+
+        Canvas {
+            id: histogramCanvas
+            width: probeColumn.width
+            height: 80
+
+            onPaint: {
+                var ctx = getContext("2d")
+                ctx.clearRect(0, 0, width, height)
+                if (!pixelProbePanel.hasProbe || pixelProbe.histogramMax <= 0) {
+                    return
+                }
+                var channels = pixelProbe.histogram
+                var colors = ["rgba(255, 80, 80, 0.9)", "rgba(80, 255, 80, 0.9)", "rgba(80, 140, 255, 0.9)"]
+                // Square root scale: a flat background would flatten everything else on a linear one
+                var scale = height / Math.sqrt(pixelProbe.histogramMax)
+                ctx.lineWidth = 1
+                for (var channel = 0; channel < channels.length; ++channel) {
+                    var bins = channels[channel]
+                    ctx.strokeStyle = colors[channel]
+                    ctx.beginPath()
+                    for (var bin = 0; bin < bins.length; ++bin) {
+                        var x = bin * (width - 1) / (bins.length - 1)
+                        var y = height - Math.sqrt(bins[bin]) * scale
+                        if (bin === 0) {
+                            ctx.moveTo(x, y)
+                        } else {
+                            ctx.lineTo(x, y)
+                        }
+                    }
+                    ctx.stroke()
+                }
+            }
+
+            Connections {
+                target: pixelProbePanel.hasProbe ? pixelProbe : null
+                onHistogramChanged: histogramCanvas.requestPaint()
+            }
+        }
+
+        Text {
+            text: pixelProbePanel.hasProbe && pixelProbe.histogramPixels > 0
+                  ? pixelProbe.histogramPixels + " pixels" : "-"
+            color: Theme.textLight
+            font.pixelSize: Theme.fontSizeExtraSmall
+        }
+    }
+}
@@ -11,6 +11,8 @@
  * - Frame tracking to prevent stale images from displaying
  * - Image effect controls (hue, saturation, lightness, opacity)
  * - Error handling for missing image files
+ * - Full-resolution tiles while zoomed in (TiledImageLayer, panes A/B/C)
+ * - Scrub proxies while frameSetPresenter shows them (not while zoomed in)
  * 
  * The component creates ImageFileAB, ImageFileC, or ImageFileD components
  * based on the image type and manages their lifecycle.
@@ -34,6 +36,17 @@ Item {
     property int startFrame: 0
     property int endFrame: 0
 
+    // Zoom state of the enclosing ImageItem, for the tile layer
+    property real zoom: 1.0
+    property Item viewportItem: null
+    property real panX: 0
+    property real panY: 0
+
+    // Difference pane effect values (same defaults as ImageFileC), applied to its tiles too
+    property real hueValue: 1.0
+    property real lightnessValue: 0.15
+    property real saturationValue: 0.5
+
 
     /**
      * @brief Initialize image component when a new event set is selected
@@ -232,6 +245,27 @@ Item {
      */
     function indexUpdate(frameIndex)
     {
+        // Frames already decoded by the playback engine are served from memory (image://frames/...)
+        function frameSource(imageType, frameNum) {
+            var toneMapped = typeof toneMapper !== "undefined" && toneMapper && !toneMapper.identity && toneMapper.appliesTo(imageType)
+            // Scrubbing through frames not decoded yet: reduced-size proxies, scaled up to fit
+            if (container_Id.zoom <= 1.0 && typeof frameSetPresenter !== "undefined" && frameSetPresenter &&
+                frameSetPresenter.proxyFrames && typeof proxyBuilder !== "undefined" && proxyBuilder) {
+                var proxySource = proxyBuilder.frameSource(imageType, frameNum)
+                if (proxySource !== "") {
+                    return toneMapped ? proxySource + "/" + toneMapper.revision : proxySource
+                }
+            }
+            // Exposure / tone curve set: renders go through the frame provider, which applies it
+            if (toneMapped) {
+                return "image://frames/" + imageType + "/" + frameNum + "/" + toneMapper.revision
+            }
+            if (typeof playbackEngine !== "undefined" && playbackEngine) {
+                return playbackEngine.frameSource(imageType, frameNum)
+            }
+            return imageLoaderManager.getImageFilePath(imageType, frameNum)
+        }
+        
         // Check if object_list has a valid object
         // If not, try to create it now (might have failed earlier or component wasn't ready)
         if (!object_list || object_list.length === 0 || !object_list[0]) {
@@ -255,32 +289,34 @@ Item {
             // Frame is out of bounds, skip loading to prevent errors
             return
         }
+        tileLayer_id.frameNumber = frameNum
+
         var frameIndex_path
         if (image_type === Utils.IMAGE_COMPONENT_A){
-            frameIndex_path = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_ORIG, frameNum)
+            frameIndex_path = frameSource(Utils.IMAGE_TYPE_ORIG, frameNum)
             if (object_list[0] && typeof object_list[0].indexUpdate === "function") {
                 object_list[0].indexUpdate(frameIndex_path)
             }
         }
 
         if (image_type === Utils.IMAGE_COMPONENT_B){
-            frameIndex_path = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_TEST, frameNum)
+            frameIndex_path = frameSource(Utils.IMAGE_TYPE_TEST, frameNum)
             if (object_list[0] && typeof object_list[0].indexUpdate === "function") {
                 object_list[0].indexUpdate(frameIndex_path)
             }
         }
 
         if (image_type === Utils.IMAGE_COMPONENT_C){
-            frameIndex_path = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_DIFF, frameNum)
+            frameIndex_path = frameSource(Utils.IMAGE_TYPE_DIFF, frameNum)
             if (object_list[0] && typeof object_list[0].indexUpdate === "function") {
                 object_list[0].indexUpdate(frameIndex_path)
             }
         }
 
         if (image_type === Utils.IMAGE_COMPONENT_D){
-            var imagePathA = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_ORIG, frameNum)
-            var imagePathB = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_TEST, frameNum)
-            var imagePathD = imageLoaderManager.getImageFilePath(Utils.IMAGE_TYPE_ALPHA, frameNum)
+            var imagePathA = frameSource(Utils.IMAGE_TYPE_ORIG, frameNum)
+            var imagePathB = frameSource(Utils.IMAGE_TYPE_TEST, frameNum)
+            var imagePathD = frameSource(Utils.IMAGE_TYPE_ALPHA, frameNum)
             if (object_list[0] && typeof object_list[0].indexUpdate === "function") {
                 object_list[0].indexUpdate(imagePathA, imagePathB, imagePathD)
             }
@@ -298,6 +334,7 @@ Item {
 
     //--- hue slider -----------------
     function hueSlider(val){
+        hueValue = val
         for (var i = 0; i < object_list.length; i++){
             object_list[i].sliderUpdateHue(val)
         }
@@ -305,6 +342,7 @@ Item {
 
     //--- light slider -----------------
     function lightSlider(val){
+        lightnessValue = val
         for (var i = 0; i < object_list.length; i++){
             object_list[i].sliderUpdateLight(val)
         }
@@ -312,6 +350,7 @@ Item {
 
     //--- saturation slider -----------------
     function saturationSlider(val){
+        saturationValue = val
         for (var i = 0; i < object_list.length; i++){
             object_list[i].sliderUpdateSat(val)
         }
@@ -324,4 +363,32 @@ Item {
         }
     }
 
+    // Zoomed-in detail: visible tiles of the frame's image pyramid over the pane.
+    // The alpha view (imageD) composites A/B/D itself and is not tiled.
+    TiledImageLayer {
+        id: tileLayer_id
+        anchors.fill: parent
+        z: 1  // Above the dynamically created pane
+        imageType: image_type === Utils.IMAGE_COMPONENT_A ? Utils.IMAGE_TYPE_ORIG :
+                   image_type === Utils.IMAGE_COMPONENT_B ? Utils.IMAGE_TYPE_TEST :
+                   image_type === Utils.IMAGE_COMPONENT_C ? Utils.IMAGE_TYPE_DIFF : ""
+        zoom: container_Id.zoom
+        viewportItem: container_Id.viewportItem
+        panX: container_Id.panX
+        panY: container_Id.panY
+        effectEnabled: image_type === Utils.IMAGE_COMPONENT_C
+        hueValue: container_Id.hueValue
+        saturationValue: container_Id.saturationValue
+        lightnessValue: container_Id.lightnessValue
+    }
+
+    // Exposure / tone curve changed: reload the current frame with the new settings
+    Connections {
+        target: typeof toneMapper !== "undefined" ? toneMapper : null
+        onSettingsChanged: {
+            if (tileLayer_id.frameNumber > 0) {
+                container_Id.indexUpdate(Utils.formatFrameNumber(tileLayer_id.frameNumber, false))
+            }
+        }
+    }
 }
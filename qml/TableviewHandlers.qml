@@ -540,14 +540,6 @@ Item {
             Connections {
                 target: testerRunner ? testerRunner : null
                 enabled: testerRunner !== null && testerRunner !== undefined
-                onOutputLine: function(line, isError) {
-                    // Log all test runner output lines in real-time
-                    if (isError) {
-                        Logger.error("[freeDView_tester] " + line)
-                    } else {
-                        Logger.info("[freeDView_tester] " + line)
-                    }
-                }
                 onRunStarted: function(mode) {
                     Logger.info("Test runner started: " + mode)
                     tableViewContainer.isLoading = true
@@ -67,6 +67,13 @@ Item {
             case 7: return minValColumn.title
             case 8: return notesColumn.title
             case 9: return statusColumn.title
+            case 10: return p5ValueColumn.title
+            case 11: return medianValueColumn.title
+            case 12: return framesUnderColumn.title
+            case 13: return longestBadRunColumn.title
+            case 14: return worstVersionDeltaColumn.title
+            case 15: return regressedFramesColumn.title
+            case 16: return sparklineColumn.title
             default: return "Unknown Column"
         }
     }
@@ -132,6 +139,7 @@ Item {
             case 7: return 6;  // Min Value
             case 8: return 7;  // Notes
             case 9: return 8;  // Status
+            // 10-16: computed statistics / version comparison / sparkline columns (model 12-18) are read-only
             default: return -1;
         }
     }
@@ -489,6 +497,13 @@ Item {
                                 case 7: currentValue = rowData.minValue || ""; break
                                 case 8: currentValue = rowData.notes || ""; break
                                 case 9: currentValue = rowData.status || ""; break
+                                case 10: currentValue = rowData.p5Value !== undefined ? String(rowData.p5Value) : ""; break
+                                case 11: currentValue = rowData.medianValue !== undefined ? String(rowData.medianValue) : ""; break
+                                case 12: currentValue = rowData.framesUnder !== undefined ? String(rowData.framesUnder) : ""; break
+                                case 13: currentValue = rowData.longestBadRun !== undefined ? String(rowData.longestBadRun) : ""; break
+                                case 14: currentValue = rowData.worstVersionDelta !== undefined ? String(rowData.worstVersionDelta) : ""; break
+                                case 15: currentValue = rowData.regressedFrames !== undefined ? String(rowData.regressedFrames) : ""; break
+                                case 16: currentValue = rowData.sparklinePath || ""; break
                                 default: currentValue = "";
                             }
                             
@@ -738,6 +753,25 @@ Item {
             }
         }
 
+        Component {
+            id: sparklineDelegate
+            Item {
+                Image {
+                    anchors.verticalCenter: parent.verticalCenter
+                    anchors.horizontalCenter: parent.horizontalCenter
+                    height: 32
+                    width: sparklineColumn.width - 10
+                    fillMode: Image.Stretch
+                    smooth: false
+                    cache: true
+                    asynchronous: true
+                    sourceSize.width: 120
+                    sourceSize.height: 32
+                    source: styleData.value ? "file:///" + String(styleData.value).replace(/\\/g, "/") : ""
+                }
+            }
+        }
+
         Component {
             id: statusDelegate
             Item {
@@ -899,6 +933,13 @@ Item {
                                 case 7: columnTitle = minValColumn.title; break
                                 case 8: columnTitle = notesColumn.title; break
                                 case 9: columnTitle = statusColumn.title; break
+                                case 10: columnTitle = p5ValueColumn.title; break
+                                case 11: columnTitle = medianValueColumn.title; break
+                                case 12: columnTitle = framesUnderColumn.title; break
+                                case 13: columnTitle = longestBadRunColumn.title; break
+                                case 14: columnTitle = worstVersionDeltaColumn.title; break
+                                case 15: columnTitle = regressedFramesColumn.title; break
+                                case 16: columnTitle = sparklineColumn.title; break
                                 default: columnTitle = "Unknown Column"; break
                             }
                             
@@ -1076,6 +1117,75 @@ Item {
             delegate: statusDelegate
         }
 
+        // Computed statistics columns - filled by xmlDataModel's background pass after loading.
+        // Sorting by them floats the worst events to the top without opening each one.
+        TableViewColumn {
+            id: p5ValueColumn
+            title: "P5 Value"
+            role: "p5Value"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(10) : 80
+        }
+
+        TableViewColumn {
+            id: medianValueColumn
+            title: "Median Value"
+            role: "medianValue"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(11) : 80
+        }
+
+        TableViewColumn {
+            id: framesUnderColumn
+            title: "Frames Under"
+            role: "framesUnder"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(12) : 80
+        }
+
+        TableViewColumn {
+            id: longestBadRunColumn
+            title: "Longest Bad Run"
+            role: "longestBadRun"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(13) : 80
+        }
+
+        // Latest render version vs the previous one (negative = got worse)
+        TableViewColumn {
+            id: worstVersionDeltaColumn
+            title: "Worst Version Delta"
+            role: "worstVersionDelta"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(14) : 80
+        }
+
+        TableViewColumn {
+            id: regressedFramesColumn
+            title: "Regressed Frames"
+            role: "regressedFrames"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(15) : 80
+        }
+
+        // Pre-rendered PNG of the per-frame values (see SparklineRenderer) - the delegate only loads it;
+        // the role's ?v=<mtime> query changes when it is re-rendered, so the cached image is replaced
+        TableViewColumn {
+            id: sparklineColumn
+            title: "Sparkline"
+            role: "sparklinePath"
+            movable: false
+            resizable: true
+            width: xmlDataModel && tableView ? tableView.viewport.width * xmlDataModel.getColumnWidthRatio(16) : 120
+            delegate: sparklineDelegate
+        }
+
         rowDelegate: Rectangle {
             id: rowRect
             height: 65
@@ -1108,7 +1218,10 @@ Item {
             Text {
                 anchors.fill: parent
                 anchors.margins: 4
-                text: styleData.value !== undefined ? styleData.value : ""
+                // Computed statistics are numbers; show fractional values with 3 decimals
+                text: styleData.value === undefined ? ""
+                      : (typeof styleData.value === "number" && styleData.value % 1 !== 0) ? styleData.value.toFixed(3)
+                      : styleData.value
                 color: styleData.selected ? Theme.primaryAccent : "black"
                 horizontalAlignment: Text.AlignHCenter
                 verticalAlignment: Text.AlignVCenter
@@ -0,0 +1,159 @@
+/**
+ * @file TiledImageLayer.qml
+ * @brief Full-resolution detail for a zoomed-in pane, from the frame's tile pyramid
+ *
+ * Sits over a pane's image inside the zoomed (scaled) item of ImageItem. The pane
+ * itself only decodes its frame at screen resolution; once the user zooms in, this
+ * layer asks ImageLoaderManager which pyramid tiles cover the visible part of the
+ * frame at the current zoom and shows them (image://tiles, decoded on QML's loader
+ * threads and LRU-cached in C++). Zooming or panning only loads tiles that weren't
+ * visible before; synchronized panes each load just their own visible tiles.
+ *
+ * Until a tile has loaded, the pane's screen-resolution image shows through.
+ *
+ * Tiles of the A/B renders are tone mapped by the provider; their URLs carry the
+ * tone mapper's revision, so changing exposure or curve reloads them.
+ */
+
+import QtQuick 2.2
+import QtQuick.Window 2.2
+import QtGraphicalEffects 1.0
+
+Item {
+    id: tileLayer_id
+
+    property string imageType: ""          // "A", "B" or "C"; empty disables the layer
+    property int frameNumber: 0
+    property real zoom: 1.0
+    property Item viewportItem: null       // Item the zoomed pane is clipped to
+    property real panX: 0                  // Pane offset - panning refreshes the tiles
+    property real panY: 0
+
+    // Optional HueSaturation per tile (difference pane)
+    property bool effectEnabled: false
+    property real hueValue: 0.0
+    property real saturationValue: 0.0
+    property real lightnessValue: 0.0
+
+    readonly property bool active: zoom > 1.01 && imageType !== "" && frameNumber > 0
+    property size imageSize: Qt.size(0, 0)
+
+    // PreserveAspectFit placement of the frame in this item, same as the pane's Image
+    readonly property real paintedScale: imageSize.width > 0 && imageSize.height > 0 ?
+        Math.min(width / imageSize.width, height / imageSize.height) : 0
+    readonly property real offsetX: (width - imageSize.width * paintedScale) / 2
+    readonly property real offsetY: (height - imageSize.height * paintedScale) / 2
+
+    visible: active
+
+    onActiveChanged: scheduleRefresh()
+    onFrameNumberChanged: scheduleRefresh()
+    onZoomChanged: scheduleRefresh()
+    onPanXChanged: scheduleRefresh()
+    onPanYChanged: scheduleRefresh()
+    onWidthChanged: scheduleRefresh()
+    onHeightChanged: scheduleRefresh()
+
+    /**
+     * @brief Refresh the visible tiles shortly (coalesces wheel steps and drag moves)
+     */
+    function scheduleRefresh() {
+        if (active) {
+            refreshTimer_id.restart()
+        } else {
+            refreshTimer_id.stop()
+            tileModel_id.clear()
+        }
+    }
+
+    /**
+     * @brief Work out the visible part of the frame and update the tile set
+     *
+     * Tiles that are still visible at the same level are kept (no reload), tiles that
+     * are no longer needed are dropped, and new ones are appended.
+     */
+    function refresh() {
+        if (!active || !viewportItem || typeof imageLoaderManager === "undefined" || !imageLoaderManager) {
+            tileModel_id.clear()
+            return
+        }
+        imageSize = imageLoaderManager.getImageSize(imageType, frameNumber)
+        if (paintedScale <= 0) {
+            tileModel_id.clear()
+            return
+        }
+
+        // Viewport corners in this (scaled) item, then in full-resolution image pixels
+        var topLeft = mapFromItem(viewportItem, 0, 0)
+        var bottomRight = mapFromItem(viewportItem, viewportItem.width, viewportItem.height)
+        var left = (Math.min(topLeft.x, bottomRight.x) - offsetX) / paintedScale
+        var top = (Math.min(topLeft.y, bottomRight.y) - offsetY) / paintedScale
+        var right = (Math.max(topLeft.x, bottomRight.x) - offsetX) / paintedScale
+        var bottom = (Math.max(topLeft.y, bottomRight.y) - offsetY) / paintedScale
+        var screenScale = paintedScale * zoom * Screen.devicePixelRatio
+
+        var tiles = imageLoaderManager.getVisibleTiles(imageType, frameNumber, screenScale,
+                                                       left, top, right - left, bottom - top)
+        var revision = typeof toneMapper !== "undefined" && toneMapper && toneMapper.appliesTo(imageType) ?
+                       "/" + toneMapper.revision : ""
+        var wanted = {}
+        for (var i = 0; i < tiles.length; i++) {
+            tiles[i].source += revision
+            wanted[tiles[i].source] = tiles[i]
+        }
+        for (var j = tileModel_id.count - 1; j >= 0; j--) {
+            var source = tileModel_id.get(j).source
+            if (wanted[source]) {
+                delete wanted[source]
+            } else {
+                tileModel_id.remove(j)
+            }
+        }
+        for (var key in wanted) {
+            var tile = wanted[key]
+            tileModel_id.append({ source: tile.source, tileX: tile.x, tileY: tile.y,
+                                  tileWidth: tile.width, tileHeight: tile.height })
+        }
+    }
+
+    Connections {
+        target: typeof toneMapper !== "undefined" ? toneMapper : null
+        onSettingsChanged: tileLayer_id.scheduleRefresh()
+    }
+
+    Timer {
+        id: refreshTimer_id
+        interval: 30
+        repeat: false
+        onTriggered: refresh()
+    }
+
+    ListModel {
+        id: tileModel_id
+    }
+
+    Repeater {
+        model: tileModel_id
+
+        Image {
+            x: tileLayer_id.offsetX + tileX * tileLayer_id.paintedScale
+            y: tileLayer_id.offsetY + tileY * tileLayer_id.paintedScale
+            width: tileWidth * tileLayer_id.paintedScale
+            height: tileHeight * tileLayer_id.paintedScale
+            source: model.source
+            asynchronous: true
+            cache: false  // Tiles are cached in ImageLoaderManager
+            smooth: true
+            opacity: status === Image.Ready ? 1 : 0
+
+            // Effect at the tile's own resolution, not at its (unzoomed) item size
+            layer.enabled: tileLayer_id.effectEnabled && status === Image.Ready
+            layer.textureSize: Qt.size(implicitWidth, implicitHeight)
+            layer.effect: HueSaturation {
+                hue: tileLayer_id.hueValue
+                saturation: tileLayer_id.saturationValue
+                lightness: tileLayer_id.lightnessValue
+            }
+        }
+    }
+}
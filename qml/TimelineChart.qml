@@ -71,8 +71,6 @@ Rectangle {
     property int last_endFrame: 0
     property var chartList_frame: []
     property int actualFrameCount: 0
-    property var originalChartList_frame: []
-    property var originalChartList_val: []
     property real currentThreshold: 1.0
     property int filteredPointCount: 0
     
@@ -134,14 +132,6 @@ Rectangle {
         // Store chartList_frame for reference
         chartList_frame = chartList_frame
         
-        // Store original data for filtering
-        originalChartList_frame = []
-        originalChartList_val = []
-        for (var j = 0; j < chartList_frame.length; j++) {
-            originalChartList_frame.push(chartList_frame[j])
-            originalChartList_val.push(chartList_val[j])
-        }
-        
         // minVal_x and maxVal_x are for graph display (actual frame numbers from data)
         minVal_x = startFrame
         maxVal_x = endFrame
@@ -152,14 +142,25 @@ Rectangle {
         chartValue_y = chartList_val
         
         // Initially show all points (filtering will be applied when threshold is set)
-        lineSeries.clear()
-        scatterSeries_id.clear()
-        for (var i = 0; i < chartList_frame.length; i++){
-            lineSeries.append(chartList_frame[i], chartList_val[i])
-            scatterSeries_id.append(chartList_frame[i], chartList_val[i])
+        // Series are filled from C++ in one replace() call each (see TimelineSeriesFeeder)
+        // timelineSeriesFeeder.loadRow() was already called for this event by openSelectedSet()
+        // Line/scatter get min/max downsampled points for the visible window (one bucket per pixel)
+        if (typeof timelineSeriesFeeder !== "undefined" && timelineSeriesFeeder) {
+            timelineSeriesFeeder.setViewWindow(startFrame - Constants.chartAxisPadding,
+                                               endFrame + Constants.chartAxisPadding,
+                                               Math.round(chart.plotArea.width))
+            filteredPointCount = timelineSeriesFeeder.fillSeries(lineSeries, scatterSeries_id)
+            // Previous render version as a dashed overlay, frames that got worse marked
+            timelineSeriesFeeder.loadVersionOverlay(versionOverlaySeries_id, versionRegressedSeries_id)
+        } else {
+            Logger.error("[UI] timelineSeriesFeeder not available - chart series not filled")
+            lineSeries.clear()
+            scatterSeries_id.clear()
+            versionOverlaySeries_id.clear()
+            versionRegressedSeries_id.clear()
+            roiSeries_id.clear()
+            filteredPointCount = 0
         }
-        // Initialize filtered point count to all points
-        filteredPointCount = chartList_frame.length
 
         // Slider uses actual frame numbers (startFrame to endFrame), not array indices
         timeSlider_id.minimumValue = startFrame
@@ -170,6 +171,27 @@ Rectangle {
         destroyTimeSliderZoomSelComponent()}
 
 
+    /**
+     * @brief Rebuild the line/scatter series for the current zoom window
+     * 
+     * The feeder keeps the full-resolution data and writes only the points between
+     * value_start and value_end, downsampled to min/max per pixel column of the plot
+     * area. Low-value (problematic) frames are always kept. Called through
+     * lodRefreshTimer so dragging the zoom handles doesn't rebuild on every pixel.
+     */
+    function refreshVisibleSeries() {
+        if (typeof timelineSeriesFeeder === "undefined" || !timelineSeriesFeeder) {
+            return
+        }
+        timelineSeriesFeeder.setViewWindow(value_start, value_end, Math.round(chart.plotArea.width))
+        timelineSeriesFeeder.refreshVisible(lineSeries, scatterSeries_id, scatterUnderValue_id)
+        timelineSeriesFeeder.refreshOverlay(versionOverlaySeries_id, versionRegressedSeries_id)
+        timelineSeriesFeeder.refreshRoiCurve(roiSeries_id)
+    }
+
+    onValue_startChanged: lodRefreshTimer.restart()
+    onValue_endChanged: lodRefreshTimer.restart()
+
     /**
      * @brief Destroy timeline zoom selector and reset slider range
      * 
@@ -814,6 +836,9 @@ Rectangle {
         legend.visible: false
         // qmllint enable M17
         
+        // Bucket count for downsampling follows the plot width
+        onPlotAreaChanged: lodRefreshTimer.restart()
+        
         // MouseArea for tooltip when hovering over chart (page 3 only)
         MouseArea {
             anchors.fill: parent
@@ -865,6 +890,34 @@ Rectangle {
             markerSize: 5
         }
 
+        // Previous render version (filled by timelineSeriesFeeder.loadVersionOverlay)
+        LineSeries {
+            id: versionOverlaySeries_id
+            axisX: axisX
+            axisY: axisY
+            width: 1
+            style: Qt.DashLine
+            color: Theme.selectionHighlight
+        }
+
+        // Unchanged-pixel fraction of the A/B/C view's visible region (roiStats.computeRange)
+        LineSeries {
+            id: roiSeries_id
+            axisX: axisX
+            axisY: axisY
+            width: 1
+            color: Theme.primaryAccent
+        }
+
+        // Frames that got worse in the latest render version
+        ScatterSeries {
+            id: versionRegressedSeries_id
+            axisX: axisX
+            axisY: axisY
+            markerSize: 7
+            color: Theme.statusWarning
+        }
+
         ScatterSeries {
             id: scatterUnderValue_id
             markerSize: 8
@@ -979,6 +1032,65 @@ Rectangle {
         }
     }
     
+    /**
+     * @brief Get the image types shown on the current page
+     * 
+     * @return {Array} Image types of the visible panes (empty on the table page)
+     */
+    function getVisibleImageTypes() {
+        var currentPage = getCurrentPageIndex()
+        if (currentPage === Constants.pageThreeWindow) {
+            // Page 2 (3-window): A, B, C
+            return [Constants.imageTypeOrig, Constants.imageTypeTest, Constants.imageTypeDiff]
+        } else if (currentPage === Constants.pageSingleWindow) {
+            // Page 3 (single-window): A/B toggle + D
+            // Note: We can't determine which version is visible from here, so both A and B
+            return [Constants.imageTypeOrig, Constants.imageTypeTest, Constants.imageTypeAlpha]
+        }
+        // Page 1 (table) or unknown: no image panes
+        return []
+    }
+    
+    /**
+     * @brief Start playback through the C++ playback engine (or the QML timer fallback)
+     * 
+     * The engine paces frames by elapsed time, decodes ahead for every visible pane and
+     * emits frameSetReady only when all panes have the frame (see presentPlaybackFrame).
+     * 
+     * @param direction - 1 for forward, -1 for reverse
+     */
+    function startPlaybackEngine(direction) {
+        if (typeof playbackEngine !== "undefined" && playbackEngine) {
+            playbackEngine.setRange(timeSlider_id.minimumValue, timeSlider_id.maximumValue)
+            playbackEngine.setPaneTypes(getVisibleImageTypes())
+            playbackEngine.frameInterval = playbackSpeed
+            playbackEngine.start(Math.round(timeSlider_id.value), direction)
+        } else {
+            Logger.warning("[UI] playbackEngine not available - using QML timer playback")
+            playbackTimer.running = true
+        }
+    }
+    
+    /**
+     * @brief Show a frame delivered by the playback engine on the slider, chart and all panes
+     * 
+     * Moves the markers and panes directly instead of through the scrub throttle, so every
+     * pane switches to the new frame in the same update.
+     * 
+     * @param frame - Frame number
+     */
+    function presentPlaybackFrame(frame) {
+        if (!isPlayingForward && !isPlayingReverse) {
+            return
+        }
+        chartAnimationEnabled = false
+        setSliderVal(frame)
+        // onValueChanged queued a throttled update for the same frame - drop it
+        pendingChartUpdate = -1
+        throttledChartUpdateTimer.stop()
+        chart.moveMarks(frame)
+    }
+    
     /**
      * @brief Start forward playback (automatic frame progression)
      */
@@ -989,7 +1101,7 @@ Rectangle {
         }
         Logger.info("[UI] Playback started: Forward")
         isPlayingForward = true
-        playbackTimer.running = true
+        startPlaybackEngine(1)
     }
     
     /**
@@ -1002,7 +1114,7 @@ Rectangle {
         }
         Logger.info("[UI] Playback started: Reverse")
         isPlayingReverse = true
-        playbackTimer.running = true
+        startPlaybackEngine(-1)
     }
     
     /**
@@ -1010,15 +1122,45 @@ Rectangle {
      */
     function stopPlayback() {
         if (isPlayingForward || isPlayingReverse) {
-            Logger.info("[UI] Playback stopped")
+            if (typeof playbackEngine !== "undefined" && playbackEngine) {
+                Logger.info("[UI] Playback stopped - achieved " + playbackEngine.achievedFps.toFixed(1)
+                            + " fps, " + playbackEngine.droppedFrames + " frames skipped")
+            } else {
+                Logger.info("[UI] Playback stopped")
+            }
         }
         isPlayingForward = false
         isPlayingReverse = false
         playbackTimer.running = false
+        if (typeof playbackEngine !== "undefined" && playbackEngine) {
+            playbackEngine.stop()
+        }
         // Re-enable chart animation when playback stops
         chartAnimationEnabled = true
     }
     
+    onPlaybackSpeedChanged: {
+        if (typeof playbackEngine !== "undefined" && playbackEngine) {
+            playbackEngine.frameInterval = playbackSpeed
+        }
+    }
+    
+    Connections {
+        target: typeof playbackEngine !== "undefined" ? playbackEngine : null
+        onFrameSetReady: presentPlaybackFrame(frame)
+        onFinished: stopPlayback()
+    }
+
+    // Region curve computed (or cleared) - plot it for the current zoom window
+    Connections {
+        target: typeof roiStats !== "undefined" ? roiStats : null
+        onRangeReady: {
+            if (typeof timelineSeriesFeeder !== "undefined" && timelineSeriesFeeder) {
+                timelineSeriesFeeder.refreshRoiCurve(roiSeries_id)
+            }
+        }
+    }
+    
     /**
      * @brief Timer to throttle chart updates during rapid scrubbing
      * 
@@ -1040,6 +1182,20 @@ Rectangle {
         }
     }
     
+    /**
+     * @brief Timer to batch series rebuilds while zooming or resizing
+     * 
+     * value_start/value_end change on every mouse move while a zoom handle is dragged;
+     * only the latest window is downsampled and pushed to the chart.
+     */
+    Timer {
+        id: lodRefreshTimer
+        interval: 16  // ~60fps max update rate
+        running: false
+        repeat: false
+        onTriggered: refreshVisibleSeries()
+    }
+    
     /**
      * @brief Timer to trigger preload when scrubbing pauses
      * 
@@ -1057,20 +1213,9 @@ Rectangle {
                 var maxFrame = maxVal_x
                 
                 // Determine which image types to preload based on current page
-                var currentPage = getCurrentPageIndex()
-                var imageTypes = []
-                
-                if (currentPage === Constants.pageThreeWindow) {
-                    // Page 2 (3-window): Preload A, B, C
-                    imageTypes = [Constants.imageTypeOrig, Constants.imageTypeTest, Constants.imageTypeDiff]
-                } else if (currentPage === Constants.pageSingleWindow) {
-                    // Page 3 (single-window): Preload only visible version (A or B) + D
-                    // Note: We can't determine which version is visible from here,
-                    // so preload both A and B plus D (the optimization in ImageFileD
-                    // will only load the visible one)
-                    imageTypes = [Constants.imageTypeOrig, Constants.imageTypeTest, Constants.imageTypeAlpha]
-                } else {
-                    // Page 1 (table) or unknown: Don't preload (not viewing images)
+                // Page 1 (table) or unknown: Don't preload (not viewing images)
+                var imageTypes = getVisibleImageTypes()
+                if (imageTypes.length === 0) {
                     return
                 }
                 
@@ -1084,6 +1229,8 @@ Rectangle {
     
     /**
      * @brief Timer for automatic frame progression during playback
+     * 
+     * Fallback only - playback normally runs in playbackEngine (C++).
      */
     Timer {
         id: playbackTimer
@@ -1430,51 +1577,29 @@ Rectangle {
         }
         currentThreshold = numThreshold
         
-        // Clear existing series (but keep chartValue_y intact for frame number lookups)
-        lineSeries.clear()
-        scatterSeries_id.clear()
-        // NOTE: Do NOT modify chartValue_y - it must remain aligned with original frame numbers
+        // NOTE: chartValue_y is not modified - it must remain aligned with original frame numbers
         // for moveMarks() to work correctly
-        
-        // Filter and add points based on threshold
-        var count = 0
-        for (var i = 0; i < originalChartList_frame.length; i++) {
-            var yValue = originalChartList_val[i]
-            // Only add points where Y value is less than or equal to threshold
-            if (yValue <= threshold) {
-                var xValue = originalChartList_frame[i]
-                lineSeries.append(xValue, yValue)
-                scatterSeries_id.append(xValue, yValue)
-                count++
-                // Do NOT push to chartValue_y - keep original array for lookups
-            }
+        // Filtering runs natively; line, scatter and red "under threshold" series are each
+        // replaced once (the red series shows the same points: frames with value <= threshold)
+        if (typeof timelineSeriesFeeder !== "undefined" && timelineSeriesFeeder) {
+            filteredPointCount = timelineSeriesFeeder.applyThreshold(numThreshold, lineSeries, scatterSeries_id, scatterUnderValue_id)
         }
-        
-        // Update filtered point count
-        filteredPointCount = count
-        
-        // Also update the red scatter points (for frames under threshold)
-        setScaterPointsToRed(threshold)
     }
     
     /**
      * @brief Highlight scatter points below threshold value in red
      * 
-     * Creates a separate scatter series (scatterUnderValue_id) containing only
+     * Fills the separate scatter series (scatterUnderValue_id) with only the
      * points where the frame value is less than or equal to the threshold.
      * This visual indicator helps users quickly identify problematic frames.
      * 
      * @param val - Threshold value (frames with value <= val are highlighted red)
      */
     function setScaterPointsToRed(val) {
-        scatterUnderValue_id.clear()
-        for (var i = 0; i < scatterSeries_id.count; i++){
-            var framVal = scatterSeries_id.at(i)
-            if (framVal.y <= val){
-                scatterUnderValue_id.append(framVal.x,  framVal.y)
-            }
+        if (typeof timelineSeriesFeeder !== "undefined" && timelineSeriesFeeder) {
+            currentThreshold = val
+            timelineSeriesFeeder.applyThreshold(val, null, null, scatterUnderValue_id)
         }
-
     }
 
     /**
@@ -1486,15 +1611,14 @@ Rectangle {
      */
     function setTimeMarkerOnRedScatterPointsForward()
     {
-        var getLowVal_list = []
-        for (var i = 0; i < scatterUnderValue_id.count; i++){
-            var framVal = scatterUnderValue_id.at(i)
-            if (framVal.x > timeSlider_id.value)
-            {
-                getLowVal_list.push(framVal.x)
-            }
+        // Indexed lookup in C++ (the red series itself is downsampled)
+        if (typeof timelineSeriesFeeder === "undefined" || !timelineSeriesFeeder) {
+            return
+        }
+        var frame = timelineSeriesFeeder.nextFrameAtOrBelow(Math.round(timeSlider_id.value), currentThreshold)
+        if (frame >= 0) {
+            setSliderVal(frame)
         }
-        setSliderVal(getLowVal_list[0])
     }
 
     /**
@@ -1506,14 +1630,13 @@ Rectangle {
      */
     function setTimeMarkerOnRedScatterPointsPrevious()
     {
-        var getLowVal_list = []
-        for (var i = 0; i < scatterUnderValue_id.count; i++){
-            var framVal = scatterUnderValue_id.at(i)
-            if (framVal.x < timeSlider_id.value)
-            {
-                getLowVal_list.push(framVal.x)
-            }
+        // Indexed lookup in C++ (the red series itself is downsampled)
+        if (typeof timelineSeriesFeeder === "undefined" || !timelineSeriesFeeder) {
+            return
+        }
+        var frame = timelineSeriesFeeder.previousFrameAtOrBelow(Math.round(timeSlider_id.value), currentThreshold)
+        if (frame >= 0) {
+            setSliderVal(frame)
         }
-        setSliderVal(getLowVal_list[getLowVal_list.length-1])
     }
 }
@@ -54,6 +54,12 @@ Rectangle {
     property real imageThree_xMouse: 0
     property real imageThree_yMouse: 0
 
+    // Region statistics of the visible area (roiStats), refreshed after zoom/pan/frame changes settle
+    property int roiFrame: 0
+    property int roiStartFrame: 0
+    property int roiEndFrame: 0
+    property var roiReadout: ({ valid: false })
+
     /**
      * @brief Update FreeDView version names in 3-window view
      * 
@@ -83,6 +89,56 @@ Rectangle {
         imageA_Id.indexUpdate(frameIndex)
         imageB_Id.indexUpdate(frameIndex)
         imageC_Id.indexUpdate(frameIndex)
+        roiFrame = parseInt(frameIndex, 10)
+        roiTimer_id.restart()
+        Qt.callLater(requestProbeHistogram)  // After all panes took the new view
+    }
+
+    /**
+     * @brief Recompute the region statistics readout for the current frame and view
+     */
+    function updateRoiStats(){
+        if (typeof roiStats === "undefined" || !roiStats || roiFrame <= 0) {
+            roiReadout = { valid: false }
+            return
+        }
+        roiReadout = roiStats.frameStats(roiFrame, imageA_Id.visibleImageRect(roiFrame))
+    }
+
+    /**
+     * @brief Report the cursor to the pixel probe (pixelProbe), as an image pixel of the current frame
+     * @param item - ImageItem under the cursor (panes share zoom and pan, so any pane maps the same)
+     * @param x - Cursor X in the item's image coordinates
+     * @param y - Cursor Y in the item's image coordinates
+     */
+    function probeMoved(item, x, y){
+        if (typeof pixelProbe === "undefined" || !pixelProbe || !pixelProbe.active || roiFrame <= 0) {
+            return
+        }
+        var point = item.imagePointAt(roiFrame, x, y)
+        if (point !== null) {
+            pixelProbe.probe(roiFrame, point)
+        }
+    }
+
+    /**
+     * @brief Ask the pixel probe for a histogram of the visible viewport (it throttles to the display rate)
+     */
+    function requestProbeHistogram(){
+        if (typeof pixelProbe === "undefined" || !pixelProbe || !pixelProbe.active || roiFrame <= 0) {
+            return
+        }
+        pixelProbe.requestHistogram(roiFrame, imageA_Id.visibleImageRect(roiFrame))
+    }
+
+    /**
+     * @brief Plot the visible region's unchanged-pixel fraction over the whole sequence in the timeline
+     */
+    function plotRoiRange(){
+        if (typeof roiStats === "undefined" || !roiStats || roiEndFrame < roiStartFrame) {
+            return
+        }
+        roiStats.computeRange(roiStartFrame, roiEndFrame, imageA_Id.visibleImageRect(roiFrame > 0 ? roiFrame : roiStartFrame))
     }
 
     /**
@@ -100,6 +156,8 @@ Rectangle {
      * @param y_changed - New Y position
      */
     function updateMouseMoveVal(imageType, x_changed, y_changed){
+        roiTimer_id.restart()
+        Qt.callLater(requestProbeHistogram)  // After all panes took the new view
         if (imageType === Utils.IMAGE_COMPONENT_A) {
             imageB_Id.undefinedAnchors()
             imageB_Id.setImageMove(x_changed, y_changed)
@@ -146,6 +204,8 @@ Rectangle {
      * @param m_min - Minimum zoom level
      */
     function updateZoomVal(imageType, m_x1, m_y1, m_y2, m_x2, m_zoom1, m_zoom2, m_max, m_min){
+        roiTimer_id.restart()
+        Qt.callLater(requestProbeHistogram)  // After all panes took the new view
         if (imageType === Utils.IMAGE_COMPONENT_A) {
             imageB_Id.undefinedAnchors()
             imageB_Id.m_x1 = m_x1
@@ -223,6 +283,8 @@ Rectangle {
         imageA_Id.resetZoomAndReDfinedAnchors()
         imageB_Id.resetZoomAndReDfinedAnchors()
         imageC_Id.resetZoomAndReDfinedAnchors()
+        roiTimer_id.restart()
+        Qt.callLater(requestProbeHistogram)
     }
 
     /**
@@ -315,6 +377,27 @@ Rectangle {
         imageA_Id.startLoadAllImages(startFrame, endFrame, pathImageA, pathImageB, pathImageC, pathImageD)
         imageB_Id.startLoadAllImages(startFrame, endFrame, pathImageA, pathImageB, pathImageC, pathImageD)
         imageC_Id.startLoadAllImages(startFrame, endFrame, pathImageA, pathImageB, pathImageC, pathImageD)
+        roiStartFrame = startFrame
+        roiEndFrame = endFrame
+        roiFrame = startFrame
+        if (typeof roiStats !== "undefined" && roiStats) {
+            roiStats.clearRange()
+        }
+        roiTimer_id.restart()
+    }
+
+    // Probe panel opened: histogram of the current view
+    Connections {
+        target: typeof pixelProbe !== "undefined" ? pixelProbe : null
+        onActiveChanged: imageThree_id.requestProbeHistogram()
+        onHistogramTypeChanged: imageThree_id.requestProbeHistogram()
+    }
+
+    //-- Settle zoom/pan/scrub before comparing the region ------------------
+    Timer {
+        id: roiTimer_id
+        interval: 150
+        onTriggered: updateRoiStats()
     }
 
     //****************************************************************
@@ -477,6 +560,41 @@ Rectangle {
                     y:64
                     color: Theme.primaryAccent  // Light green matching UI theme
                 }
+                // Statistics of the visible region (A vs B)
+                Text{
+                    id: roiText_id
+                    visible: imageThree_id.roiReadout.valid === true
+                    text: !visible ? "" :
+                          "View " + imageThree_id.roiReadout.width + "x" + imageThree_id.roiReadout.height +
+                          "  mean " + imageThree_id.roiReadout.meanAbsDiff.toFixed(2) +
+                          "  max " + imageThree_id.roiReadout.maxAbsDiff +
+                          "  PSNR " + (imageThree_id.roiReadout.identical ? "inf" : imageThree_id.roiReadout.psnr.toFixed(1) + " dB") +
+                          "  changed " + imageThree_id.roiReadout.changedPercent.toFixed(2) + "%" +
+                          (imageThree_id.roiReadout.bitsPerChannel === 16 ? "  (16-bit)" : "")
+                    font.family: "Helvetica"
+                    font.pointSize: Theme.fontSizeMedium
+                    x:24
+                    y:92
+                    color: Theme.primaryAccent
+                }
+                Text{
+                    id: roiPlotText_id
+                    visible: roiText_id.visible
+                    text: typeof roiStats !== "undefined" && roiStats && roiStats.rangeRunning ? "Plotting..." : "Plot in timeline"
+                    font.family: "Helvetica"
+                    font.pointSize: Theme.fontSizeMedium
+                    font.underline: roiPlotMouse_id.containsMouse
+                    x:24
+                    y:112
+                    color: Theme.primaryAccent
+                    MouseArea {
+                        id: roiPlotMouse_id
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: imageThree_id.plotRoiRange()
+                    }
+                }
                 // MouseArea to show tooltip when hovering over Difference window
                 MouseArea {
                     anchors.fill: parent
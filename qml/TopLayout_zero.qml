@@ -617,6 +617,11 @@ Rectangle {
         var val = parseFloat(value)
         frameUnderThreshold = value
         
+        // Frames Under / Longest Bad Run table columns follow the same threshold
+        if (typeof xmlDataModel !== "undefined" && xmlDataModel && !isNaN(val)) {
+            xmlDataModel.statsThreshold = val
+        }
+        
         // Update min frame value in other components
         if (typeof mainItem !== "undefined" && mainItem) {
             mainItem.getMinFrameValueFromTopLayoutZero(frameUnderThreshold)
@@ -725,6 +730,11 @@ Rectangle {
         frameList_frame = xmlDataModel.getFrameList_frame(value)
         frameList_val = xmlDataModel.getFrameList_val(value)
         
+        // Load the same points into the C++ series feeder (fills the timeline chart without JS loops)
+        if (typeof timelineSeriesFeeder !== "undefined" && timelineSeriesFeeder) {
+            timelineSeriesFeeder.loadRow(value)
+        }
+        
         // Validate that we got valid frame data
         if (startFrame < 0 || endFrame < 0 || !frameList_frame || frameList_frame.length === 0) {
             var frameDataErrorMessage = "Cannot load test data\n\n" +
@@ -31,7 +31,39 @@ SOURCES += src/main.cpp \
            src/xmldatamodel.cpp \
            src/xmldataloader.cpp \
            src/freeDView_tester_runner.cpp \
-           src/imageloadermanager.cpp
+           src/imageloadermanager.cpp \
+           src/timelineseriesfeeder.cpp \
+           src/seriesdecimator.cpp \
+           src/framevalueindex.cpp \
+           src/eventstats.cpp \
+           src/versioncomparator.cpp \
+           src/sparklinerenderer.cpp \
+           src/framering.cpp \
+           src/playbackengine.cpp \
+           src/frameimageprovider.cpp \
+           src/framesetpresenter.cpp \
+           src/abcompositor.cpp \
+           src/abcompositoritem.cpp \
+           src/tilepyramid.cpp \
+           src/tileimageprovider.cpp \
+           src/tracer.cpp \
+           src/metricsregistry.cpp \
+           src/headlessreport.cpp \
+           src/scrubtrace.cpp \
+           src/logmodel.cpp \
+           src/logarchive.cpp \
+           src/logsearchmodel.cpp \
+           src/memorygovernor.cpp \
+           src/roistats.cpp \
+           src/roistatsservice.cpp \
+           src/channelhistogram.cpp \
+           src/pixelprobe.cpp \
+           src/tonemapper.cpp \
+           src/qoicodec.cpp \
+           src/compressedframecache.cpp \
+           src/proxysequence.cpp \
+           src/proxybuilder.cpp \
+           src/proxyimageprovider.cpp
 
 HEADERS += \
     src/inireader.h \
@@ -39,7 +71,40 @@ HEADERS += \
     src/xmldatamodel.h \
     src/xmldataloader.h \
     src/freeDView_tester_runner.h \
-    src/imageloadermanager.h
+    src/imageloadermanager.h \
+    src/timelineseriesfeeder.h \
+    src/seriesdecimator.h \
+    src/framevalueindex.h \
+    src/eventstats.h \
+    src/versioncomparator.h \
+    src/sparklinerenderer.h \
+    src/framering.h \
+    src/playbackengine.h \
+    src/frameimageprovider.h \
+    src/framesetpresenter.h \
+    src/abcompositor.h \
+    src/abcompositoritem.h \
+    src/tilepyramid.h \
+    src/tileimageprovider.h \
+    src/tracer.h \
+    src/metricsregistry.h \
+    src/headlessreport.h \
+    src/scrubtrace.h \
+    src/logmodel.h \
+    src/mpmcring.h \
+    src/logarchive.h \
+    src/logsearchmodel.h \
+    src/memorygovernor.h \
+    src/roistats.h \
+    src/roistatsservice.h \
+    src/channelhistogram.h \
+    src/pixelprobe.h \
+    src/tonemapper.h \
+    src/qoicodec.h \
+    src/compressedframecache.h \
+    src/proxysequence.h \
+    src/proxybuilder.h \
+    src/proxyimageprovider.h
 
 # Add src directory to include path so headers can be found
 INCLUDEPATH += src
@@ -78,13 +143,14 @@ OTHER_FILES += \
     qml/TableviewTable.qml \
     qml/Theme.qml \
     qml/Constants.qml \
-    qml/Logger.qml \
     qml/LogWindow.qml \
     qml/MenuBar.qml \
     qml/TooltipManager.qml \
     qml/ErrorDialog.qml \
     qml/DoubleBufferedImage.qml \
-    qml/PlaybackSpeedMenu.qml
+    qml/PlaybackSpeedMenu.qml \
+    qml/TiledImageLayer.qml \
+    qml/PerformanceHud.qml
 
 # DISTFILES section removed - files are now properly organized in their respective directories
 # and tracked through RESOURCES, SOURCES, HEADERS, and OTHER_FILES sections above
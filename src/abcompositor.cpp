@@ -0,0 +1,157 @@
+#include "abcompositor.h"
+#include <algorithm>
+#include <cmath>
+
+ABCompositeParams::ABCompositeParams()
+    : hue(0.0f)
+    , saturation(0.0f)
+    , lightness(0.0f)
+    , opacity(1.0f)
+{
+}
+
+namespace {
+
+// Kept in step with the fragment shader in abcompositoritem.cpp
+
+struct Hsl
+{
+    float h;
+    float s;
+    float l;
+};
+
+Hsl rgbToHsl(float r, float g, float b)
+{
+    const float maxC = std::max(r, std::max(g, b));
+    const float minC = std::min(r, std::min(g, b));
+    const float l = (maxC + minC) * 0.5f;
+    const float d = maxC - minC;
+    if (d < 1e-5f) {
+        return { 0.0f, 0.0f, l };
+    }
+    const float s = l > 0.5f ? d / (2.0f - maxC - minC) : d / (maxC + minC);
+    float h;
+    if (maxC == r) {
+        h = (g - b) / d + (g < b ? 6.0f : 0.0f);
+    } else if (maxC == g) {
+        h = (b - r) / d + 2.0f;
+    } else {
+        h = (r - g) / d + 4.0f;
+    }
+    return { h / 6.0f, s, l };
+}
+
+float fract(float x)
+{
+    return x - std::floor(x);
+}
+
+float hueToRgb(float p, float q, float t)
+{
+    t = fract(t);
+    if (t < 1.0f / 6.0f) {
+        return p + (q - p) * 6.0f * t;
+    }
+    if (t < 0.5f) {
+        return q;
+    }
+    if (t < 2.0f / 3.0f) {
+        return p + (q - p) * (2.0f / 3.0f - t) * 6.0f;
+    }
+    return p;
+}
+
+void hslToRgb(const Hsl &hsl, float &r, float &g, float &b)
+{
+    if (hsl.s < 1e-5f) {
+        r = g = b = hsl.l;
+        return;
+    }
+    const float q = hsl.l < 0.5f ? hsl.l * (1.0f + hsl.s) : hsl.l + hsl.s - hsl.l * hsl.s;
+    const float p = 2.0f * hsl.l - q;
+    r = hueToRgb(p, q, hsl.h + 1.0f / 3.0f);
+    g = hueToRgb(p, q, hsl.h);
+    b = hueToRgb(p, q, hsl.h - 1.0f / 3.0f);
+}
+
+float clamp01(float x)
+{
+    return std::max(0.0f, std::min(1.0f, x));
+}
+
+int toByte(float x)
+{
+    return static_cast<int>(clamp01(x) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+QRgb ABCompositor::adjustColor(QRgb color, const ABCompositeParams &params)
+{
+    float r = qRed(color) / 255.0f;
+    float g = qGreen(color) / 255.0f;
+    float b = qBlue(color) / 255.0f;
+
+    // Saturation: move away from / towards the luma grey
+    const float luma = r * 0.2125f + g * 0.7154f + b * 0.0721f;
+    const float saturationScale = 1.0f + params.saturation;
+    r = clamp01(luma + (r - luma) * saturationScale);
+    g = clamp01(luma + (g - luma) * saturationScale);
+    b = clamp01(luma + (b - luma) * saturationScale);
+
+    // Hue: rotate
+    Hsl hsl = rgbToHsl(r, g, b);
+    hsl.h = fract(hsl.h + params.hue);
+    hslToRgb(hsl, r, g, b);
+
+    // Lightness: blend towards white (positive) or black (negative)
+    const float target = params.lightness >= 0.0f ? 1.0f : 0.0f;
+    const float amount = std::fabs(params.lightness);
+    r += (target - r) * amount;
+    g += (target - g) * amount;
+    b += (target - b) * amount;
+
+    return qRgba(toByte(r), toByte(g), toByte(b), qAlpha(color));
+}
+
+QImage ABCompositor::composite(const QImage &base, const QImage &mask, const ABCompositeParams &params)
+{
+    const QSize size = base.isNull() ? mask.size() : base.size();
+    if (size.isEmpty()) {
+        return QImage();
+    }
+
+    QImage result = base.isNull() ? QImage(size, QImage::Format_ARGB32_Premultiplied)
+                                  : base.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (base.isNull()) {
+        result.fill(Qt::transparent);
+    }
+    if (mask.isNull() || params.opacity <= 0.0f) {
+        return result;
+    }
+
+    QImage maskImage = mask.size() == size ? mask : mask.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    maskImage = maskImage.convertToFormat(QImage::Format_ARGB32);  // Unpremultiplied for the colour adjustment
+
+    const float opacity = clamp01(params.opacity);
+    for (int y = 0; y < size.height(); ++y) {
+        const QRgb *maskLine = reinterpret_cast<const QRgb *>(maskImage.constScanLine(y));
+        QRgb *outLine = reinterpret_cast<QRgb *>(result.scanLine(y));
+        for (int x = 0; x < size.width(); ++x) {
+            const QRgb maskPixel = maskLine[x];
+            const float k = qAlpha(maskPixel) / 255.0f * opacity;
+            if (k <= 0.0f) {
+                continue;
+            }
+            const QRgb adjusted = adjustColor(maskPixel, params);
+            const QRgb basePixel = outLine[x];
+            const float keep = 1.0f - k;
+            outLine[x] = qRgba(toByte(qRed(adjusted) / 255.0f * k + qRed(basePixel) / 255.0f * keep),
+                               toByte(qGreen(adjusted) / 255.0f * k + qGreen(basePixel) / 255.0f * keep),
+                               toByte(qBlue(adjusted) / 255.0f * k + qBlue(basePixel) / 255.0f * keep),
+                               toByte(k + qAlpha(basePixel) / 255.0f * keep));
+        }
+    }
+    return result;
+}
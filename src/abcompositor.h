@@ -0,0 +1,56 @@
+#ifndef ABCOMPOSITOR_H
+#define ABCOMPOSITOR_H
+
+#include <QImage>
+#include <QRgb>
+
+/**
+ * @brief ABCompositeParams - Overlay adjustments of the A/B/D alpha view
+ *
+ * Same ranges as the QtGraphicalEffects HueSaturation sliders the view used before.
+ */
+struct ABCompositeParams
+{
+    float hue;         // -1.0 .. 1.0, fraction of a full turn added to the hue
+    float saturation;  // -1.0 (grey) .. 1.0 (double saturation)
+    float lightness;   // -1.0 (black) .. 1.0 (white)
+    float opacity;     // 0.0 .. 1.0, overlay opacity of the mask
+
+    ABCompositeParams();
+};
+
+/**
+ * @brief ABCompositor - CPU reference of the A/B/D alpha view compositing
+ *
+ * The alpha view shows the mask (imageD), colour-adjusted and at the overlay opacity,
+ * on top of the original (A) or test (B) render:
+ *
+ *     k   = mask.alpha * opacity
+ *     out = adjust(mask.rgb) * k + base * (1 - k)      (premultiplied)
+ *
+ * ABCompositorItem does this in one fragment shader pass; the functions here are the
+ * same arithmetic on the CPU, used by its software-rendered fallback (no OpenGL,
+ * e.g. CI with QT_QUICK_BACKEND=software) and by the unit tests.
+ */
+class ABCompositor
+{
+public:
+    /**
+     * @brief Apply saturation, hue and lightness to one colour
+     * @param color - Unpremultiplied colour (alpha is passed through)
+     * @param params - Adjustments (opacity is ignored)
+     * @return Adjusted unpremultiplied colour
+     */
+    static QRgb adjustColor(QRgb color, const ABCompositeParams &params);
+
+    /**
+     * @brief Composite the adjusted mask over a base render
+     * @param base - Original or test render (may be null: composited over transparent)
+     * @param mask - Alpha mask (may be null: base is returned unchanged); scaled to the base size if it differs
+     * @param params - Adjustments and overlay opacity
+     * @return Premultiplied ARGB32 image the size of base (or of mask if base is null)
+     */
+    static QImage composite(const QImage &base, const QImage &mask, const ABCompositeParams &params);
+};
+
+#endif // ABCOMPOSITOR_H
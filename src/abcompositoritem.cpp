@@ -0,0 +1,427 @@
+#include "abcompositoritem.h"
+#include "logger.h"
+
+#include <QQuickWindow>
+#include <QQuickImageProvider>
+#include <QQmlEngine>
+#include <QQmlFile>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGRendererInterface>
+#include <QSGTexture>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QUrl>
+
+namespace {
+
+const char *const SlotNames[] = { "A", "B", "D" };
+
+/**
+ * @brief Material holding the three textures and the adjustment uniforms
+ */
+class ABCompositorMaterial : public QSGMaterial
+{
+public:
+    ABCompositorMaterial()
+        : showA(true)
+    {
+        textures[0] = textures[1] = textures[2] = nullptr;
+        setFlag(Blending, true);
+    }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader *createShader() const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        const ABCompositorMaterial *o = static_cast<const ABCompositorMaterial *>(other);
+        for (int i = 0; i < 3; ++i) {
+            if (textures[i] != o->textures[i]) {
+                return textures[i] < o->textures[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    QSGTexture *textures[3];  // A, B, D (owned by the node)
+    bool showA;
+    ABCompositeParams params;
+};
+
+/**
+ * @brief Single-pass shader: base = A or B, mask colour-adjusted and blended over it
+ *
+ * The adjustment is the same arithmetic as ABCompositor::adjustColor().
+ */
+class ABCompositorShader : public QSGMaterialShader
+{
+public:
+    const char *vertexShader() const override
+    {
+        return "attribute highp vec4 qt_VertexPosition;\n"
+               "attribute highp vec2 qt_VertexTexCoord;\n"
+               "uniform highp mat4 qt_Matrix;\n"
+               "varying highp vec2 texCoord;\n"
+               "void main() {\n"
+               "    texCoord = qt_VertexTexCoord;\n"
+               "    gl_Position = qt_Matrix * qt_VertexPosition;\n"
+               "}\n";
+    }
+
+    const char *fragmentShader() const override
+    {
+        return "uniform sampler2D textureA;\n"
+               "uniform sampler2D textureB;\n"
+               "uniform sampler2D textureD;\n"
+               "uniform lowp float showA;\n"
+               "uniform highp vec4 adjust;\n"  // hue, saturation, lightness, overlay opacity
+               "uniform lowp float qt_Opacity;\n"
+               "varying highp vec2 texCoord;\n"
+               "highp vec3 rgbToHsl(highp vec3 c) {\n"
+               "    highp float maxC = max(c.r, max(c.g, c.b));\n"
+               "    highp float minC = min(c.r, min(c.g, c.b));\n"
+               "    highp float l = (maxC + minC) * 0.5;\n"
+               "    highp float d = maxC - minC;\n"
+               "    if (d < 1e-5) return vec3(0.0, 0.0, l);\n"
+               "    highp float s = l > 0.5 ? d / (2.0 - maxC - minC) : d / (maxC + minC);\n"
+               "    highp float h;\n"
+               "    if (maxC == c.r) h = (c.g - c.b) / d + (c.g < c.b ? 6.0 : 0.0);\n"
+               "    else if (maxC == c.g) h = (c.b - c.r) / d + 2.0;\n"
+               "    else h = (c.r - c.g) / d + 4.0;\n"
+               "    return vec3(h / 6.0, s, l);\n"
+               "}\n"
+               "highp float hueToRgb(highp float p, highp float q, highp float t) {\n"
+               "    t = fract(t);\n"
+               "    if (t < 1.0 / 6.0) return p + (q - p) * 6.0 * t;\n"
+               "    if (t < 0.5) return q;\n"
+               "    if (t < 2.0 / 3.0) return p + (q - p) * (2.0 / 3.0 - t) * 6.0;\n"
+               "    return p;\n"
+               "}\n"
+               "highp vec3 hslToRgb(highp vec3 hsl) {\n"
+               "    if (hsl.y < 1e-5) return vec3(hsl.z);\n"
+               "    highp float q = hsl.z < 0.5 ? hsl.z * (1.0 + hsl.y) : hsl.z + hsl.y - hsl.z * hsl.y;\n"
+               "    highp float p = 2.0 * hsl.z - q;\n"
+               "    return vec3(hueToRgb(p, q, hsl.x + 1.0 / 3.0), hueToRgb(p, q, hsl.x), hueToRgb(p, q, hsl.x - 1.0 / 3.0));\n"
+               "}\n"
+               "void main() {\n"
+               "    lowp vec4 base = mix(texture2D(textureB, texCoord), texture2D(textureA, texCoord), showA);\n"
+               "    lowp vec4 mask = texture2D(textureD, texCoord);\n"
+               "    highp vec3 c = mask.rgb / max(1.0 / 256.0, mask.a);\n"
+               "    highp float luma = dot(c, vec3(0.2125, 0.7154, 0.0721));\n"
+               "    c = clamp(mix(vec3(luma), c, 1.0 + adjust.y), 0.0, 1.0);\n"
+               "    highp vec3 hsl = rgbToHsl(c);\n"
+               "    c = hslToRgb(vec3(fract(hsl.x + adjust.x), hsl.y, hsl.z));\n"
+               "    c = mix(c, vec3(step(0.0, adjust.z)), abs(adjust.z));\n"
+               "    highp float k = mask.a * clamp(adjust.w, 0.0, 1.0);\n"
+               "    gl_FragColor = (vec4(c * k, k) + base * (1.0 - k)) * qt_Opacity;\n"
+               "}\n";
+    }
+
+    char const *const *attributeNames() const override
+    {
+        static const char *const names[] = { "qt_VertexPosition", "qt_VertexTexCoord", nullptr };
+        return names;
+    }
+
+    void updateState(const RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override
+    {
+        Q_UNUSED(oldMaterial);
+        ABCompositorMaterial *material = static_cast<ABCompositorMaterial *>(newMaterial);
+        QOpenGLShaderProgram *shaderProgram = program();
+
+        if (state.isMatrixDirty()) {
+            shaderProgram->setUniformValue(m_matrixId, state.combinedMatrix());
+        }
+        if (state.isOpacityDirty()) {
+            shaderProgram->setUniformValue(m_opacityId, state.opacity());
+        }
+        shaderProgram->setUniformValue(m_showAId, material->showA ? 1.0f : 0.0f);
+        shaderProgram->setUniformValue(m_adjustId, material->params.hue, material->params.saturation,
+                                       material->params.lightness, material->params.opacity);
+
+        // Bind D and B on units 2 and 1, leave unit 0 (A) active as the renderer expects
+        QOpenGLFunctions *functions = QOpenGLContext::currentContext()->functions();
+        functions->glActiveTexture(GL_TEXTURE2);
+        material->textures[2]->bind();
+        functions->glActiveTexture(GL_TEXTURE1);
+        material->textures[1]->bind();
+        functions->glActiveTexture(GL_TEXTURE0);
+        material->textures[0]->bind();
+    }
+
+protected:
+    void initialize() override
+    {
+        QOpenGLShaderProgram *shaderProgram = program();
+        m_matrixId = shaderProgram->uniformLocation("qt_Matrix");
+        m_opacityId = shaderProgram->uniformLocation("qt_Opacity");
+        m_showAId = shaderProgram->uniformLocation("showA");
+        m_adjustId = shaderProgram->uniformLocation("adjust");
+        shaderProgram->bind();
+        shaderProgram->setUniformValue("textureA", 0);
+        shaderProgram->setUniformValue("textureB", 1);
+        shaderProgram->setUniformValue("textureD", 2);
+    }
+
+private:
+    int m_matrixId = -1;
+    int m_opacityId = -1;
+    int m_showAId = -1;
+    int m_adjustId = -1;
+};
+
+QSGMaterialShader *ABCompositorMaterial::createShader() const
+{
+    return new ABCompositorShader;
+}
+
+/**
+ * @brief Geometry node owning the textures of the OpenGL path
+ */
+class ABCompositorNode : public QSGGeometryNode
+{
+public:
+    explicit ABCompositorNode(QSGTexture *emptyTexture)
+        : m_material(new ABCompositorMaterial)
+        , m_emptyTexture(emptyTexture)
+    {
+        m_textures[0] = m_textures[1] = m_textures[2] = nullptr;
+        QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4);
+        setGeometry(geometry);
+        setMaterial(m_material);
+        setFlags(OwnsGeometry | OwnsMaterial);
+        updateMaterialTextures();
+    }
+
+    ~ABCompositorNode() override
+    {
+        qDeleteAll(m_textures, m_textures + 3);
+        delete m_emptyTexture;
+    }
+
+    /**
+     * @brief Replace a slot's texture (nullptr = none, sampled as transparent)
+     */
+    void setTexture(int slot, QSGTexture *texture)
+    {
+        delete m_textures[slot];
+        m_textures[slot] = texture;
+        updateMaterialTextures();
+    }
+
+    ABCompositorMaterial *compositorMaterial() const { return m_material; }
+
+private:
+    void updateMaterialTextures()
+    {
+        for (int i = 0; i < 3; ++i) {
+            m_material->textures[i] = m_textures[i] ? m_textures[i] : m_emptyTexture;
+        }
+        markDirty(DirtyMaterial);
+    }
+
+    ABCompositorMaterial *m_material;  // Owned through OwnsMaterial
+    QSGTexture *m_textures[3];
+    QSGTexture *m_emptyTexture;
+};
+
+} // namespace
+
+ABCompositorItem::ABCompositorItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_compositeDirty(true)
+    , m_showA(true)
+{
+    for (int i = 0; i < SlotCount; ++i) {
+        m_textureDirty[i] = false;
+    }
+    setFlag(ItemHasContents, true);
+}
+
+bool ABCompositorItem::setSources(const QString &sourceA, const QString &sourceB, const QString &sourceD)
+{
+    const QString sources[SlotCount] = { sourceA, sourceB, sourceD };
+    QImage images[SlotCount];
+    bool changed = false;
+
+    // Load everything first - the current frame stays up until the whole set is in
+    for (int i = 0; i < SlotCount; ++i) {
+        if (sources[i] == m_sources[i]) {
+            images[i] = m_images[i];
+            continue;
+        }
+        changed = true;
+        if (sources[i].isEmpty()) {
+            continue;
+        }
+        images[i] = loadImage(sources[i]);
+        if (images[i].isNull()) {
+            DEBUG_LOG("ABCompositorItem") << "setSources - Failed to load" << SlotNames[i] << sources[i];
+            emit imageError(QString::fromLatin1(SlotNames[i]), sources[i]);
+            return false;
+        }
+    }
+    if (!changed) {
+        return true;
+    }
+
+    for (int i = 0; i < SlotCount; ++i) {
+        if (sources[i] != m_sources[i]) {
+            m_sources[i] = sources[i];
+            m_images[i] = images[i];
+            m_textureDirty[i] = true;
+        }
+    }
+    m_compositeDirty = true;
+    emit sourcesChanged();
+    update();
+    return true;
+}
+
+void ABCompositorItem::setShowA(bool showA)
+{
+    if (showA == m_showA) {
+        return;
+    }
+    m_showA = showA;
+    m_compositeDirty = true;
+    emit showAChanged();
+    update();
+}
+
+void ABCompositorItem::setHue(qreal hue)
+{
+    updateAdjustment(m_params.hue, hue);
+}
+
+void ABCompositorItem::setSaturation(qreal saturation)
+{
+    updateAdjustment(m_params.saturation, saturation);
+}
+
+void ABCompositorItem::setLightness(qreal lightness)
+{
+    updateAdjustment(m_params.lightness, lightness);
+}
+
+void ABCompositorItem::setOverlayOpacity(qreal opacity)
+{
+    updateAdjustment(m_params.opacity, opacity);
+}
+
+void ABCompositorItem::updateAdjustment(float &field, qreal value)
+{
+    const float newValue = static_cast<float>(value);
+    if (qFuzzyCompare(field, newValue)) {
+        return;
+    }
+    field = newValue;
+    m_compositeDirty = true;
+    emit adjustmentsChanged();
+    update();
+}
+
+QImage ABCompositorItem::loadImage(const QString &source) const
+{
+    const QUrl url(source);
+    if (url.scheme() == QLatin1String("image")) {
+        // image://<provider>/<id>, e.g. decoded frames from FrameRing
+        QQmlEngine *engine = qmlEngine(this);
+        QQmlImageProviderBase *base = engine ? engine->imageProvider(url.host()) : nullptr;
+        if (!base || base->imageType() != QQmlImageProviderBase::Image) {
+            return QImage();
+        }
+        QSize size;
+        return static_cast<QQuickImageProvider *>(base)->requestImage(url.path().mid(1), &size, QSize());
+    }
+    return QImage(QQmlFile::urlToLocalFileOrQrc(url));
+}
+
+QRectF ABCompositorItem::paintedRect() const
+{
+    const QImage &base = m_images[m_showA ? SlotA : SlotB];
+    const QSize imageSize = base.isNull() ? m_images[SlotD].size() : base.size();
+    if (imageSize.isEmpty() || width() <= 0 || height() <= 0) {
+        return QRectF();
+    }
+    // PreserveAspectFit, centered
+    const QSizeF fitted = QSizeF(imageSize).scaled(QSizeF(width(), height()), Qt::KeepAspectRatio);
+    return QRectF(QPointF((width() - fitted.width()) / 2.0, (height() - fitted.height()) / 2.0), fitted);
+}
+
+bool ABCompositorItem::useSoftwarePath() const
+{
+    static const bool forced = qEnvironmentVariableIsSet("RENDERCOMPARE_SOFTWARE_COMPOSITOR");
+    if (forced) {
+        return true;
+    }
+    QSGRendererInterface *rendererInterface = window() ? window()->rendererInterface() : nullptr;
+    return !rendererInterface || rendererInterface->graphicsApi() != QSGRendererInterface::OpenGL;
+}
+
+QSGNode *ABCompositorItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+    const QRectF rect = paintedRect();
+    if (rect.isEmpty()) {
+        delete oldNode;
+        for (int i = 0; i < SlotCount; ++i) {
+            m_textureDirty[i] = !m_images[i].isNull();  // Re-upload when content comes back
+        }
+        m_compositeDirty = true;
+        return nullptr;
+    }
+
+    if (useSoftwarePath()) {
+        QSGImageNode *node = static_cast<QSGImageNode *>(oldNode);
+        if (!node) {
+            node = window()->createImageNode();
+            node->setOwnsTexture(true);
+            node->setFiltering(QSGTexture::Linear);
+            m_compositeDirty = true;
+        }
+        if (m_compositeDirty) {
+            const QImage composite = ABCompositor::composite(m_images[m_showA ? SlotA : SlotB], m_images[SlotD], m_params);
+            node->setTexture(window()->createTextureFromImage(composite));
+            m_compositeDirty = false;
+        }
+        node->setRect(rect);
+        return node;
+    }
+
+    ABCompositorNode *node = static_cast<ABCompositorNode *>(oldNode);
+    if (!node) {
+        QImage empty(1, 1, QImage::Format_ARGB32_Premultiplied);
+        empty.fill(Qt::transparent);
+        node = new ABCompositorNode(window()->createTextureFromImage(empty));
+        for (int i = 0; i < SlotCount; ++i) {
+            m_textureDirty[i] = true;
+        }
+    }
+    for (int i = 0; i < SlotCount; ++i) {
+        if (m_textureDirty[i]) {
+            QSGTexture *texture = m_images[i].isNull() ? nullptr : window()->createTextureFromImage(m_images[i]);
+            if (texture) {
+                texture->setFiltering(QSGTexture::Linear);
+            }
+            node->setTexture(i, texture);
+            m_textureDirty[i] = false;
+        }
+    }
+
+    ABCompositorMaterial *material = node->compositorMaterial();
+    material->showA = m_showA;
+    material->params = m_params;
+    QSGGeometry::updateTexturedRectGeometry(node->geometry(), rect, QRectF(0, 0, 1, 1));
+    node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+    return node;
+}
@@ -0,0 +1,101 @@
+#ifndef ABCOMPOSITORITEM_H
+#define ABCOMPOSITORITEM_H
+
+#include <QQuickItem>
+#include <QImage>
+#include <QString>
+
+#include "abcompositor.h"
+
+/**
+ * @brief ABCompositorItem - Draws the A/B/D alpha view in one pass
+ *
+ * Replaces ImageFileD's stacked Images with OpacityMask and HueSaturation effects
+ * (two buffers, several offscreen passes per frame). The item keeps the original (A),
+ * test (B) and mask (D) images as textures, and a single fragment shader picks A or B,
+ * colour-adjusts the mask and blends it over at the overlay opacity. Toggling A/B or
+ * moving a slider only changes uniforms.
+ *
+ * setSources() loads all images before anything changes on screen, so the item is
+ * double-buffered by itself: a failed load keeps the previous frame and reports
+ * imageError(). Sources that are unchanged are not reloaded, and "image://" URLs are
+ * served by the engine's image providers (e.g. decoded frames from FrameRing).
+ *
+ * Without OpenGL (software scene graph backend, or RENDERCOMPARE_SOFTWARE_COMPOSITOR
+ * set) the same compositing runs on the CPU through ABCompositor.
+ * Images are drawn with PreserveAspectFit.
+ */
+class ABCompositorItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString sourceA READ sourceA NOTIFY sourcesChanged)
+    Q_PROPERTY(QString sourceB READ sourceB NOTIFY sourcesChanged)
+    Q_PROPERTY(QString sourceD READ sourceD NOTIFY sourcesChanged)
+    Q_PROPERTY(bool showA READ showA WRITE setShowA NOTIFY showAChanged)
+    Q_PROPERTY(qreal hue READ hue WRITE setHue NOTIFY adjustmentsChanged)
+    Q_PROPERTY(qreal saturation READ saturation WRITE setSaturation NOTIFY adjustmentsChanged)
+    Q_PROPERTY(qreal lightness READ lightness WRITE setLightness NOTIFY adjustmentsChanged)
+    Q_PROPERTY(qreal overlayOpacity READ overlayOpacity WRITE setOverlayOpacity NOTIFY adjustmentsChanged)
+
+public:
+    explicit ABCompositorItem(QQuickItem *parent = nullptr);
+
+    /**
+     * @brief Switch to a new frame
+     *
+     * Empty sources are released (e.g. the hidden version while scrubbing). The new
+     * images replace the current ones only if all non-empty sources loaded.
+     *
+     * @param sourceA - URL of the original render, or empty
+     * @param sourceB - URL of the test render, or empty
+     * @param sourceD - URL of the alpha mask, or empty
+     * @return true if all non-empty sources loaded
+     */
+    Q_INVOKABLE bool setSources(const QString &sourceA, const QString &sourceB, const QString &sourceD);
+
+    QString sourceA() const { return m_sources[SlotA]; }
+    QString sourceB() const { return m_sources[SlotB]; }
+    QString sourceD() const { return m_sources[SlotD]; }
+    bool showA() const { return m_showA; }
+    void setShowA(bool showA);
+    qreal hue() const { return m_params.hue; }
+    void setHue(qreal hue);
+    qreal saturation() const { return m_params.saturation; }
+    void setSaturation(qreal saturation);
+    qreal lightness() const { return m_params.lightness; }
+    void setLightness(qreal lightness);
+    qreal overlayOpacity() const { return m_params.opacity; }
+    void setOverlayOpacity(qreal opacity);
+
+signals:
+    /**
+     * @brief An image could not be loaded
+     * @param imageType - "A", "B" or "D"
+     * @param source - URL that failed
+     */
+    void imageError(const QString &imageType, const QString &source);
+
+    void sourcesChanged();
+    void showAChanged();
+    void adjustmentsChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    enum Slot { SlotA = 0, SlotB = 1, SlotD = 2, SlotCount = 3 };
+
+    QImage loadImage(const QString &source) const;
+    QRectF paintedRect() const;
+    bool useSoftwarePath() const;
+    void updateAdjustment(float &field, qreal value);
+
+    QString m_sources[SlotCount];
+    QImage m_images[SlotCount];
+    bool m_textureDirty[SlotCount];  // Image changed since the last upload
+    bool m_compositeDirty;           // Software path: CPU composite must be redone
+    bool m_showA;
+    ABCompositeParams m_params;
+};
+
+#endif // ABCOMPOSITORITEM_H
@@ -0,0 +1,93 @@
+#include "channelhistogram.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const int kLanes = 4;  // Partial tables per channel, one per pixel of an unrolled group
+
+/**
+ * @brief Partial tables: [lane][channel][bin]
+ */
+struct PartialTables
+{
+    quint32 counts[kLanes][3][ChannelHistogram::Bins];
+
+    PartialTables() { std::memset(counts, 0, sizeof(counts)); }
+
+    inline void add(int lane, QRgb pixel)
+    {
+        ++counts[lane][0][qRed(pixel)];
+        ++counts[lane][1][qGreen(pixel)];
+        ++counts[lane][2][qBlue(pixel)];
+    }
+};
+
+void binRow(const QRgb *pixels, int count, PartialTables &tables)
+{
+    int x = 0;
+    for (; x + kLanes <= count; x += kLanes) {
+        tables.add(0, pixels[x]);
+        tables.add(1, pixels[x + 1]);
+        tables.add(2, pixels[x + 2]);
+        tables.add(3, pixels[x + 3]);
+    }
+    for (; x < count; ++x) {
+        tables.add(0, pixels[x]);
+    }
+}
+
+} // namespace
+
+ChannelHistogram::ChannelHistogram()
+    : pixelCount(0)
+    , red(Bins, 0)
+    , green(Bins, 0)
+    , blue(Bins, 0)
+{
+}
+
+quint32 ChannelHistogram::maxCount() const
+{
+    if (!isValid()) {
+        return 0;
+    }
+    return std::max({ *std::max_element(red.cbegin(), red.cend()),
+                      *std::max_element(green.cbegin(), green.cend()),
+                      *std::max_element(blue.cbegin(), blue.cend()) });
+}
+
+ChannelHistogram ChannelHistogram::compute(const QImage &image, const QRect &rect)
+{
+    ChannelHistogram histogram;
+    const QRect area = rect.intersected(image.rect());
+    if (area.isEmpty()) {
+        return histogram;
+    }
+
+    // 32-bit pixels are read in place; anything else converts just the region
+    QImage pixels = image;
+    QPoint origin = area.topLeft();
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32
+        && image.format() != QImage::Format_ARGB32_Premultiplied) {
+        pixels = image.copy(area).convertToFormat(QImage::Format_RGB32);
+        origin = QPoint(0, 0);
+    }
+
+    PartialTables tables;
+    for (int y = 0; y < area.height(); ++y) {
+        const QRgb *row = reinterpret_cast<const QRgb *>(pixels.constScanLine(origin.y() + y)) + origin.x();
+        binRow(row, area.width(), tables);
+    }
+
+    QVector<quint32> *channels[3] = { &histogram.red, &histogram.green, &histogram.blue };
+    for (int channel = 0; channel < 3; ++channel) {
+        quint32 *bins = channels[channel]->data();
+        for (int bin = 0; bin < Bins; ++bin) {
+            bins[bin] = tables.counts[0][channel][bin] + tables.counts[1][channel][bin]
+                      + tables.counts[2][channel][bin] + tables.counts[3][channel][bin];
+        }
+    }
+    histogram.pixelCount = area.width() * area.height();
+    return histogram;
+}
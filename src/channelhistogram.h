@@ -0,0 +1,44 @@
+#ifndef CHANNELHISTOGRAM_H
+#define CHANNELHISTOGRAM_H
+
+#include <QImage>
+#include <QRect>
+#include <QVector>
+
+/**
+ * @brief ChannelHistogram - Red, green and blue histograms of an image region
+ *
+ * Used by the pixel probe panel for the visible viewport of a pane, so it runs
+ * at display rate on full-resolution frames. Binning is unrolled over four
+ * pixels into four partial tables per channel: consecutive pixels of a flat
+ * area would otherwise increment the same counter back to back and serialize
+ * on store-to-load forwarding. The partial tables are summed at the end.
+ */
+struct ChannelHistogram
+{
+    static const int Bins = 256;
+
+    int pixelCount;
+    QVector<quint32> red;    // Bins counts each
+    QVector<quint32> green;
+    QVector<quint32> blue;
+
+    ChannelHistogram();
+
+    bool isValid() const { return pixelCount > 0; }
+
+    /**
+     * @brief Largest count of any bin of any channel (0 if empty)
+     */
+    quint32 maxCount() const;
+
+    /**
+     * @brief Count the pixels of a region
+     * @param image - Image (any format; other than 32-bit RGB, only the region is converted)
+     * @param rect - Region in image pixels (clipped to the image)
+     * @return Histogram (pixelCount == 0 if the region misses the image)
+     */
+    static ChannelHistogram compute(const QImage &image, const QRect &rect);
+};
+
+#endif // CHANNELHISTOGRAM_H
@@ -0,0 +1,122 @@
+#include "compressedframecache.h"
+#include "logger.h"
+#include "metricsregistry.h"
+#include <QMutexLocker>
+#include <cstdlib>
+
+CompressedFrameCache::CompressedFrameCache(qint64 capacityBytes)
+    : m_capacityBytes(qMax(qint64(0), capacityBytes))
+    , m_bytes(0)
+    , m_generation(0)
+    , m_anchorFrame(1)
+{
+}
+
+void CompressedFrameCache::setCapacityBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_capacityBytes = qMax(qint64(0), bytes);
+    while (m_bytes > m_capacityBytes && !m_frames.isEmpty()) {
+        eraseFarthest();
+    }
+    publishMetrics();
+    DEBUG_LOG("CompressedFrameCache") << "setCapacityBytes -" << m_capacityBytes / (1024 * 1024) << "MB";
+}
+
+qint64 CompressedFrameCache::capacityBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_capacityBytes;
+}
+
+int CompressedFrameCache::generation() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_generation;
+}
+
+bool CompressedFrameCache::contains(quint64 key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_frames.contains(key);
+}
+
+QByteArray CompressedFrameCache::data(quint64 key) const
+{
+    QMutexLocker locker(&m_mutex);
+    m_anchorFrame = frameOf(key);
+    return m_frames.value(key);  // Shared, not copied
+}
+
+bool CompressedFrameCache::insert(quint64 key, const QByteArray &data, int generation)
+{
+    QMutexLocker locker(&m_mutex);
+    if (generation != m_generation || data.isEmpty() || data.size() > m_capacityBytes) {
+        return false;
+    }
+    auto it = m_frames.find(key);
+    if (it != m_frames.end()) {
+        m_bytes -= it.value().size();
+        it.value() = data;
+    } else {
+        m_frames.insert(key, data);
+    }
+    m_bytes += data.size();
+    while (m_bytes > m_capacityBytes) {
+        eraseFarthest();
+    }
+    publishMetrics();
+    return true;
+}
+
+void CompressedFrameCache::eraseFarthest()
+{
+    auto farthest = m_frames.begin();
+    int farthestDistance = -1;
+    for (auto it = m_frames.begin(); it != m_frames.end(); ++it) {
+        const int distance = std::abs(frameOf(it.key()) - m_anchorFrame);
+        if (distance > farthestDistance) {
+            farthestDistance = distance;
+            farthest = it;
+        }
+    }
+    m_bytes -= farthest.value().size();
+    m_frames.erase(farthest);
+}
+
+qint64 CompressedFrameCache::release(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 before = m_bytes;
+    while (before - m_bytes < bytes && !m_frames.isEmpty()) {
+        eraseFarthest();
+    }
+    publishMetrics();
+    return before - m_bytes;
+}
+
+void CompressedFrameCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_frames.clear();
+    m_bytes = 0;
+    ++m_generation;
+    publishMetrics();
+}
+
+int CompressedFrameCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_frames.size();
+}
+
+qint64 CompressedFrameCache::bytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bytes;
+}
+
+void CompressedFrameCache::publishMetrics() const
+{
+    MetricsRegistry::setGauge(MetricsRegistry::CompressedFrameBytes, m_bytes);
+}
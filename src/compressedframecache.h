@@ -0,0 +1,94 @@
+#ifndef COMPRESSEDFRAMECACHE_H
+#define COMPRESSEDFRAMECACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+
+/**
+ * @brief CompressedFrameCache - Second frame cache tier holding frames losslessly compressed
+ *
+ * FrameRing keeps only the frames around the playhead decoded (the hot tier). Frames
+ * it drops are compressed with QoiCodec on worker threads and kept here, at a
+ * fraction of their decoded size, so a whole event sequence can stay in memory;
+ * decoding a frame again decompresses it from here instead of reading and decoding
+ * the file.
+ *
+ * Entries are keyed like FrameRing (image type in the high 32 bits, frame number in
+ * the low 32 bits). Over capacity, the entries farthest from the last frame looked up
+ * are dropped first. clear() bumps the generation, so compressions started for the
+ * previous event are not inserted.
+ *
+ * All functions are thread-safe.
+ */
+class CompressedFrameCache
+{
+public:
+    explicit CompressedFrameCache(qint64 capacityBytes = Q_INT64_C(512) * 1024 * 1024);
+
+    /**
+     * @brief Set the memory the compressed frames may use (drops frames if over it)
+     * @param bytes - Capacity in bytes (0 disables the tier)
+     */
+    void setCapacityBytes(qint64 bytes);
+    qint64 capacityBytes() const;
+
+    /**
+     * @brief Current generation, to pass to insert() for work started now
+     */
+    int generation() const;
+
+    bool contains(quint64 key) const;
+
+    /**
+     * @brief Get a compressed frame; its frame becomes the one eviction keeps closest
+     * @return QOI stream, or empty if not cached
+     */
+    QByteArray data(quint64 key) const;
+
+    /**
+     * @brief Add a compressed frame
+     * @param key - Frame key
+     * @param data - QOI stream
+     * @param generation - generation() when the compression started
+     * @return false if the cache was cleared since, the tier is disabled, or the frame is too large
+     */
+    bool insert(quint64 key, const QByteArray &data, int generation);
+
+    /**
+     * @brief Drop the frames farthest from the last frame looked up (MemoryGovernor release callback)
+     * @param bytes - Bytes to free
+     * @return Bytes freed
+     */
+    qint64 release(qint64 bytes);
+
+    /**
+     * @brief Drop all frames and ignore inserts of compressions already started
+     */
+    void clear();
+
+    int size() const;
+    qint64 bytes() const;
+
+private:
+    static int frameOf(quint64 key) { return static_cast<int>(key & 0xffffffffu); }
+
+    /**
+     * @brief Drop the frame farthest from m_anchorFrame (m_mutex must be held, m_frames not empty)
+     */
+    void eraseFarthest();
+
+    /**
+     * @brief Publish the memory gauge to MetricsRegistry (m_mutex must be held)
+     */
+    void publishMetrics() const;
+
+    mutable QMutex m_mutex;
+    QHash<quint64, QByteArray> m_frames;
+    qint64 m_capacityBytes;
+    qint64 m_bytes;
+    int m_generation;
+    mutable int m_anchorFrame;  // Last frame looked up - the playhead
+};
+
+#endif // COMPRESSEDFRAMECACHE_H
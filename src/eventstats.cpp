@@ -0,0 +1,71 @@
+#include "eventstats.h"
+#include <algorithm>
+#include <cmath>
+
+EventStats::EventStats()
+    : frameCount(0)
+    , p5Value(-1.0)
+    , medianValue(-1.0)
+    , p95Value(-1.0)
+    , framesUnderThreshold(0)
+    , longestBadRun(0)
+    , histogram(HistogramBins, 0)
+{
+}
+
+namespace {
+
+/**
+ * @brief Nearest-rank percentile; partially reorders 'values'
+ */
+double percentile(QVector<float> &values, double fraction)
+{
+    const int rank = std::min(values.size() - 1,
+                              std::max(0, static_cast<int>(std::ceil(fraction * values.size())) - 1));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values.at(rank);
+}
+
+} // namespace
+
+EventStats EventStats::compute(const QVector<float> &values, double threshold)
+{
+    EventStats stats;
+    if (values.isEmpty()) {
+        return stats;
+    }
+    stats.frameCount = values.size();
+
+    for (float value : values) {
+        int bin = static_cast<int>(value * HistogramBins);
+        bin = std::max(0, std::min(HistogramBins - 1, bin));
+        ++stats.histogram[bin];
+    }
+
+    // nth_element reorders, so work on a copy
+    QVector<float> scratch = values;
+    stats.p5Value = percentile(scratch, 0.05);
+    stats.medianValue = percentile(scratch, 0.50);
+    stats.p95Value = percentile(scratch, 0.95);
+
+    applyThreshold(stats, values, threshold);
+    return stats;
+}
+
+void EventStats::applyThreshold(EventStats &stats, const QVector<float> &values, double threshold)
+{
+    int under = 0;
+    int run = 0;
+    int longest = 0;
+    for (float value : values) {
+        if (value <= threshold) {
+            ++under;
+            ++run;
+            longest = std::max(longest, run);
+        } else {
+            run = 0;
+        }
+    }
+    stats.framesUnderThreshold = under;
+    stats.longestBadRun = longest;
+}
@@ -0,0 +1,49 @@
+#ifndef EVENTSTATS_H
+#define EVENTSTATS_H
+
+#include <QVector>
+
+/**
+ * @brief EventStats - Summary statistics of one event's per-frame compare values
+ *
+ * Computed for every event by XmlDataModel's background statistics pass so the
+ * table can be sorted by how bad an event is without opening its timeline.
+ * Values are the per-frame similarity values from compareResult.xml, in frame order.
+ *
+ * Threshold-dependent fields (framesUnderThreshold, longestBadRun) can be
+ * recomputed with applyThreshold() without redoing the percentiles.
+ */
+struct EventStats
+{
+    static const int HistogramBins = 10;  // Bins over [0, 1], values outside are clamped
+
+    int frameCount;
+    double p5Value;            // 5th percentile (the "bad tail")
+    double medianValue;        // 50th percentile
+    double p95Value;           // 95th percentile
+    int framesUnderThreshold;  // Frames with value <= threshold
+    int longestBadRun;         // Longest run of consecutive frames with value <= threshold
+    QVector<int> histogram;    // HistogramBins counts
+
+    EventStats();
+
+    bool isValid() const { return frameCount > 0; }
+
+    /**
+     * @brief Compute all statistics for a series
+     * @param values - Per-frame values in frame order
+     * @param threshold - Frames with value <= threshold count as bad
+     * @return Statistics (frameCount == 0 if values is empty)
+     */
+    static EventStats compute(const QVector<float> &values, double threshold);
+
+    /**
+     * @brief Recompute only framesUnderThreshold and longestBadRun
+     * @param stats - Statistics to update
+     * @param values - Same series the statistics were computed from
+     * @param threshold - New threshold
+     */
+    static void applyThreshold(EventStats &stats, const QVector<float> &values, double threshold);
+};
+
+#endif // EVENTSTATS_H
@@ -0,0 +1,45 @@
+#include "frameimageprovider.h"
+#include "framering.h"
+#include "imageloadermanager.h"
+#include "tonemapper.h"
+#include "logger.h"
+
+FrameImageProvider::FrameImageProvider(FrameRing *ring, ImageLoaderManager *imageLoaderManager, ToneMapper *toneMapper)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_ring(ring)
+    , m_imageLoaderManager(imageLoaderManager)
+    , m_toneMapper(toneMapper)
+{
+}
+
+QImage FrameImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    // id: "<type>/<frame>[/<tone mapper revision>]", e.g. "A/388"
+    const QStringList parts = id.split('/');
+    bool ok = false;
+    const int frameNumber = parts.size() == 2 || parts.size() == 3 ? parts.at(1).toInt(&ok) : 0;
+    if (!ok) {
+        DEBUG_LOG("FrameImageProvider") << "requestImage - Invalid id:" << id;
+        return QImage();
+    }
+    const QString imageType = parts.at(0);
+
+    QImage image = m_ring ? m_ring->image(imageType, frameNumber) : QImage();
+    if (image.isNull() && m_imageLoaderManager) {
+        // Evicted since the URL was handed out - load it directly
+        image.load(m_imageLoaderManager->getImageDiskPath(imageType, frameNumber));
+    }
+
+    if (size) {
+        *size = image.size();
+    }
+    if (!image.isNull() && requestedSize.width() > 0 && requestedSize.height() > 0
+        && requestedSize != image.size()) {
+        image = image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    // After scaling: fewer pixels to map
+    if (m_toneMapper && m_toneMapper->appliesTo(imageType)) {
+        image = m_toneMapper->apply(image);
+    }
+    return image;
+}
@@ -0,0 +1,40 @@
+#ifndef FRAMEIMAGEPROVIDER_H
+#define FRAMEIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+// Forward declarations
+class FrameRing;
+class ImageLoaderManager;
+class ToneMapper;
+
+/**
+ * @brief FrameImageProvider - Serves decoded frames from FrameRing to QML ("image://frames/<type>/<frame>")
+ *
+ * PlaybackEngine::frameSource() hands out these URLs only for frames that are already
+ * decoded, so a pane's Image gets its pixels without touching the disk. If a frame was
+ * evicted in between, it is loaded from disk as a fallback.
+ *
+ * Frames are tone mapped for display here (ToneMapper). While its settings aren't the
+ * identity, the A/B panes load every frame through this provider with the tone mapper's
+ * revision appended ("image://frames/<type>/<frame>/<revision>"), so changes reload them.
+ */
+class FrameImageProvider : public QQuickImageProvider
+{
+public:
+    /**
+     * @param ring - Decoded frame cache (not owned)
+     * @param imageLoaderManager - Path resolver for the disk fallback (not owned)
+     * @param toneMapper - Display exposure and curve (not owned, may be null)
+     */
+    FrameImageProvider(FrameRing *ring, ImageLoaderManager *imageLoaderManager, ToneMapper *toneMapper);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    FrameRing *m_ring;
+    ImageLoaderManager *m_imageLoaderManager;
+    ToneMapper *m_toneMapper;
+};
+
+#endif // FRAMEIMAGEPROVIDER_H
@@ -0,0 +1,339 @@
+#include "framering.h"
+#include "imageloadermanager.h"
+#include "logger.h"
+#include "metricsregistry.h"
+#include "memorygovernor.h"
+#include "qoicodec.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrent>
+#include <cstdlib>
+
+FrameRing::FrameRing(QObject *parent)
+    : QObject(parent)
+    , m_imageLoaderManager(nullptr)
+    , m_generation(0)
+    , m_capacity(18)  // PlaybackEngine resizes it for its decode-ahead window
+    , m_nextTicket(0)
+    , m_running(0)
+    , m_demoting(0)
+    , m_bytes(0)
+    , m_anchorFrame(1)
+    , m_memoryGovernor(nullptr)
+    , m_consumerId(0)
+    , m_compressedConsumerId(0)
+{
+    // Two decoders keep up with 30fps 1080p JPEG without starving the UI thread
+    m_pool.setMaxThreadCount(2);
+    // Compressing costs about as much as decoding; during playback every frame is dropped once
+    m_demotePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+}
+
+FrameRing::~FrameRing()
+{
+    setMemoryGovernor(nullptr);
+    m_pool.clear();
+    m_demotePool.clear();
+    m_pool.waitForDone();
+    m_demotePool.waitForDone();
+}
+
+void FrameRing::setImageLoaderManager(ImageLoaderManager *manager)
+{
+    if (m_imageLoaderManager) {
+        disconnect(m_imageLoaderManager, nullptr, this, nullptr);
+    }
+    m_imageLoaderManager = manager;
+    if (m_imageLoaderManager) {
+        connect(m_imageLoaderManager, &ImageLoaderManager::imagePathsChanged, this, &FrameRing::clear);
+    }
+}
+
+void FrameRing::setMemoryGovernor(MemoryGovernor *governor)
+{
+    if (m_memoryGovernor) {
+        m_memoryGovernor->removeConsumer(m_consumerId);
+        m_memoryGovernor->removeConsumer(m_compressedConsumerId);
+    }
+    m_memoryGovernor = governor;
+    if (governor) {
+        // Highest priority: dropping these frames stalls playback until they are decoded again
+        m_consumerId = governor->addConsumer(QStringLiteral("frameRing"), 3,
+                                             [this]() { return bytes(); },
+                                             [this](qint64 bytes) { return release(bytes); });
+        // Dropping compressed frames only means reading the files again
+        m_compressedConsumerId = governor->addConsumer(
+            QStringLiteral("compressedFrames"), 1,
+            [this]() { return m_compressed.bytes(); },
+            [this](qint64 bytes) { return m_compressed.release(bytes); });
+    }
+}
+
+void FrameRing::setCapacity(int images)
+{
+    if (images <= 0) {
+        DEBUG_LOG("FrameRing") << "setCapacity - Invalid capacity:" << images << "(must be > 0)";
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_capacity = images;
+}
+
+quint64 FrameRing::key(const QString &imageType, int frameNumber)
+{
+    const quint64 type = imageType.isEmpty() ? 0u : imageType.at(0).unicode();
+    return (type << 32) | static_cast<quint32>(frameNumber);
+}
+
+bool FrameRing::request(const QString &imageType, int frameNumber, const QObject *requester)
+{
+    if (!m_imageLoaderManager) {
+        return false;
+    }
+    const QString filePath = m_imageLoaderManager->getImageDiskPath(imageType, frameNumber);
+    if (filePath.isEmpty()) {
+        return false;
+    }
+
+    int generation;
+    quint64 ticket;
+    {
+        QMutexLocker locker(&m_mutex);
+        const quint64 k = key(imageType, frameNumber);
+        if (m_failed.contains(k)) {
+            return false;
+        }
+        if (m_images.contains(k)) {
+            MetricsRegistry::increment(MetricsRegistry::FrameRingHits);
+            return true;
+        }
+        if (m_pending.contains(k)) {
+            auto queued = m_queued.find(k);
+            if (queued != m_queued.end()) {
+                queued->requesters.insert(requester);
+            }
+            return true;
+        }
+        m_pending.insert(k);
+        generation = m_generation;
+        ticket = ++m_nextTicket;
+        m_queued.insert(k, QueuedDecode{ticket, {requester}});
+        publishMetrics();
+    }
+    MetricsRegistry::increment(MetricsRegistry::FrameRingMisses);
+    QtConcurrent::run(&m_pool, [this, imageType, frameNumber, filePath, generation, ticket]() {
+        decode(imageType, frameNumber, filePath, generation, ticket);
+    });
+    return true;
+}
+
+void FrameRing::cancelQueued(const QObject *requester)
+{
+    // The pool tasks stay queued but find their ticket gone and return at once; running
+    // decodes stay pending, so requesting them again doesn't decode them twice
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_queued.begin(); it != m_queued.end();) {
+        it->requesters.remove(requester);
+        if (it->requesters.isEmpty()) {
+            m_pending.remove(it.key());
+            it = m_queued.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    publishMetrics();
+}
+
+void FrameRing::decode(const QString &imageType, int frameNumber, const QString &filePath, int generation,
+                       quint64 ticket)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto queued = m_queued.constFind(key(imageType, frameNumber));
+        if (generation != m_generation || queued == m_queued.constEnd() || queued->ticket != ticket) {
+            return;  // Canceled (or the event switched) before it started
+        }
+        m_queued.erase(queued);
+        ++m_running;
+        publishMetrics();
+    }
+
+    QImage image;
+    bool loaded;
+    {
+        ScopedLatency latency(MetricsRegistry::DecodeLatency);
+        const QByteArray compressed = m_compressed.data(key(imageType, frameNumber));
+        if (!compressed.isEmpty()) {
+            image = QoiCodec::decode(compressed);  // Promoted from the compressed tier
+        }
+        if (!image.isNull()) {
+            MetricsRegistry::increment(MetricsRegistry::CompressedFrameHits);
+            loaded = true;
+        } else {
+            MetricsRegistry::increment(MetricsRegistry::CompressedFrameMisses);
+            loaded = image.load(filePath);
+        }
+    }
+    if (!loaded) {
+        DEBUG_LOG("FrameRing") << "decode - Failed to load:" << filePath;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        --m_running;
+        publishMetrics();
+        if (generation != m_generation) {
+            return;  // Event switched while decoding
+        }
+        const quint64 k = key(imageType, frameNumber);
+        m_pending.remove(k);
+        if (image.isNull()) {
+            m_failed.insert(k);  // Don't retry a missing file every tick
+        } else {
+            m_bytes += image.sizeInBytes();
+            m_images.insert(k, image);
+            evictFarthestFrom(frameNumber);
+            publishMetrics();
+        }
+    }
+    if (!image.isNull() && m_memoryGovernor) {
+        m_memoryGovernor->requestCheck();
+    }
+    if (image.isNull()) {
+        emit frameFailed(imageType, frameNumber);
+    } else {
+        emit frameDecoded(imageType, frameNumber);
+    }
+}
+
+void FrameRing::evictFarthestFrom(int frameNumber)
+{
+    while (m_images.size() > m_capacity) {
+        eraseFarthestFrom(frameNumber);
+    }
+}
+
+void FrameRing::eraseFarthestFrom(int frameNumber)
+{
+    auto farthest = m_images.begin();
+    int farthestDistance = -1;
+    for (auto it = m_images.begin(); it != m_images.end(); ++it) {
+        const int distance = std::abs(frameOf(it.key()) - frameNumber);
+        if (distance > farthestDistance) {
+            farthestDistance = distance;
+            farthest = it;
+        }
+    }
+    m_bytes -= farthest.value().sizeInBytes();
+    demote(farthest.key(), farthest.value());
+    m_images.erase(farthest);
+}
+
+void FrameRing::demote(quint64 k, const QImage &image)
+{
+    // Skipped if already compressed (promoted earlier) or the compressions fall behind:
+    // the file can still be read again
+    if (!QoiCodec::canEncode(image) || m_demoting >= m_capacity || m_compressed.contains(k)
+        || m_compressed.capacityBytes() <= 0) {
+        return;
+    }
+    ++m_demoting;
+    const int generation = m_compressed.generation();
+    QtConcurrent::run(&m_demotePool, [this, k, image, generation]() {
+        const bool inserted = generation == m_compressed.generation()  // Skip the work after an event switch
+                              && m_compressed.insert(k, QoiCodec::encode(image), generation);
+        {
+            QMutexLocker locker(&m_mutex);
+            --m_demoting;
+        }
+        if (inserted && m_memoryGovernor) {
+            m_memoryGovernor->requestCheck();
+        }
+    });
+}
+
+qint64 FrameRing::release(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 before = m_bytes;
+    while (before - m_bytes < bytes && !m_images.isEmpty()) {
+        eraseFarthestFrom(m_anchorFrame);
+    }
+    publishMetrics();
+    return before - m_bytes;
+}
+
+void FrameRing::publishMetrics() const
+{
+    MetricsRegistry::setGauge(MetricsRegistry::DecodesQueued, m_queued.size());
+    MetricsRegistry::setGauge(MetricsRegistry::DecodesInFlight, m_running);
+    MetricsRegistry::setGauge(MetricsRegistry::FrameRingBytes, m_bytes);
+}
+
+bool FrameRing::contains(const QString &imageType, int frameNumber) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_images.contains(key(imageType, frameNumber));
+}
+
+bool FrameRing::containsFrameSet(int frameNumber, const QStringList &imageTypes) const
+{
+    if (imageTypes.isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&m_mutex);
+    for (const QString &imageType : imageTypes) {
+        if (!m_images.contains(key(imageType, frameNumber))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QImage FrameRing::image(const QString &imageType, int frameNumber) const
+{
+    QMutexLocker locker(&m_mutex);
+    m_anchorFrame = frameNumber;
+    return m_images.value(key(imageType, frameNumber));
+}
+
+void FrameRing::retainRange(int first, int last)
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_images.begin(); it != m_images.end();) {
+        const int frame = frameOf(it.key());
+        if (frame < first || frame > last) {
+            m_bytes -= it.value().sizeInBytes();
+            demote(it.key(), it.value());
+            it = m_images.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    publishMetrics();
+}
+
+void FrameRing::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_compressed.clear();  // Compressions queued or running for the old event are not inserted
+    m_images.clear();
+    m_pending.clear();
+    m_queued.clear();  // Queued decodes of the old event are skipped
+    m_failed.clear();
+    m_bytes = 0;
+    ++m_generation;
+    publishMetrics();
+}
+
+int FrameRing::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_images.size();
+}
+
+qint64 FrameRing::bytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bytes;
+}
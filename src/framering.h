@@ -0,0 +1,197 @@
+#ifndef FRAMERING_H
+#define FRAMERING_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QImage>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QThreadPool>
+#include "compressedframecache.h"
+
+// Forward declaration
+class ImageLoaderManager;
+class MemoryGovernor;
+
+/**
+ * @brief FrameRing - Bounded cache of decoded frames, filled ahead of playback
+ *
+ * Holds decoded QImages per (image type, frame number). Frames are requested ahead
+ * of the playhead and decoded on a small private thread pool, so presenting a frame
+ * never waits for disk or JPEG/PNG decoding. Frames outside the window kept by
+ * retainRange() (or farthest from the newest frame, once over capacity) are dropped.
+ *
+ * Frames keep the precision they decode to: 16-bit PNG/TIFF renders stay
+ * QImage::Format_RGBA64, so statistics see every bit; ToneMapper reduces them to
+ * 8 bits only for display.
+ *
+ * Frames dropped from the ring are demoted to a CompressedFrameCache: compressed
+ * losslessly on another private pool and kept at a fraction of their decoded size, so
+ * the ring stays small while a whole sequence stays in memory. Decoding a frame
+ * again promotes it from there (on the decode pool) instead of reading the file.
+ * 16-bit frames are not demoted.
+ *
+ * File paths come from ImageLoaderManager; switching events (setImagePaths) clears
+ * the ring and the compressed frames and discards decodes still in flight.
+ */
+class FrameRing : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameRing(QObject *parent = nullptr);
+    ~FrameRing();
+
+    /**
+     * @brief Set the manager that resolves image paths
+     * @param manager - ImageLoaderManager instance (not owned)
+     */
+    void setImageLoaderManager(ImageLoaderManager *manager);
+
+    /**
+     * @brief Report decoded and compressed memory to a governor, which may drop frames farthest from the playhead
+     * @param governor - Governor (not owned), or nullptr to unregister
+     */
+    void setMemoryGovernor(MemoryGovernor *governor);
+
+    /**
+     * @brief Set the maximum number of decoded images kept
+     * @param images - Maximum image count (all types together), must be > 0
+     */
+    void setCapacity(int images);
+    int capacity() const { return m_capacity; }
+
+    /**
+     * @brief The compressed tier behind the ring (e.g. to set its capacity)
+     */
+    CompressedFrameCache *compressedFrames() { return &m_compressed; }
+
+    /**
+     * @brief Decode a frame in the background unless it is cached or already pending
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @param requester - Who needs the frame, so cancelQueued() drops only its own requests
+     * @return false if the frame can't be decoded (no path, or it failed before)
+     */
+    bool request(const QString &imageType, int frameNumber, const QObject *requester = nullptr);
+
+    /**
+     * @brief Drop a requester's decodes that haven't started yet (e.g. frames scrubbed past)
+     *
+     * Decodes another requester still needs, and decodes already running, continue.
+     */
+    void cancelQueued(const QObject *requester);
+
+    /**
+     * @brief Check whether a frame is decoded
+     */
+    bool contains(const QString &imageType, int frameNumber) const;
+
+    /**
+     * @brief Check whether a frame is decoded for every given image type
+     * @param frameNumber - Frame number
+     * @param imageTypes - Image types of the visible panes
+     * @return true if all are decoded (false for an empty type list)
+     */
+    bool containsFrameSet(int frameNumber, const QStringList &imageTypes) const;
+
+    /**
+     * @brief Get a decoded frame
+     * @return Decoded image, or null image if not cached
+     */
+    QImage image(const QString &imageType, int frameNumber) const;
+
+    /**
+     * @brief Drop decoded frames outside [first, last]
+     */
+    void retainRange(int first, int last);
+
+    /**
+     * @brief Drop all decoded frames and discard pending decodes
+     */
+    void clear();
+
+    /**
+     * @brief Number of decoded images currently held
+     */
+    int size() const;
+
+    /**
+     * @brief Memory of the decoded images in bytes
+     */
+    qint64 bytes() const;
+
+signals:
+    /**
+     * @brief Emitted (from a worker thread) when a frame has been decoded
+     */
+    void frameDecoded(const QString &imageType, int frameNumber);
+
+    /**
+     * @brief Emitted (from a worker thread) when a frame could not be decoded
+     */
+    void frameFailed(const QString &imageType, int frameNumber);
+
+private:
+    static quint64 key(const QString &imageType, int frameNumber);
+    static int frameOf(quint64 key) { return static_cast<int>(key & 0xffffffffu); }
+
+    void decode(const QString &imageType, int frameNumber, const QString &filePath, int generation, quint64 ticket);
+
+    /**
+     * @brief Compress a dropped frame into the compressed tier in the background (m_mutex must be held)
+     */
+    void demote(quint64 key, const QImage &image);
+
+    /**
+     * @brief Drop the images farthest from a frame until under capacity (m_mutex must be held)
+     */
+    void evictFarthestFrom(int frameNumber);
+
+    /**
+     * @brief Drop the one image farthest from a frame (m_mutex must be held, m_images not empty)
+     */
+    void eraseFarthestFrom(int frameNumber);
+
+    /**
+     * @brief Drop the images farthest from the last presented frame (MemoryGovernor release callback)
+     * @param bytes - Bytes to free
+     * @return Bytes freed
+     */
+    qint64 release(qint64 bytes);
+
+    /**
+     * @brief Publish queue and memory gauges to MetricsRegistry (m_mutex must be held)
+     */
+    void publishMetrics() const;
+
+    struct QueuedDecode
+    {
+        quint64 ticket;                      // Pool task that decodes it; others skip it
+        QSet<const QObject *> requesters;
+    };
+
+    ImageLoaderManager *m_imageLoaderManager;
+    mutable QMutex m_mutex;
+    QHash<quint64, QImage> m_images;
+    QSet<quint64> m_pending;  // Queued or running
+    QHash<quint64, QueuedDecode> m_queued;  // Waiting for a pool thread
+    QSet<quint64> m_failed;  // Missing/corrupt files - not retried until clear()
+    int m_generation;   // Bumped by clear() so stale decodes are dropped
+    int m_capacity;
+    quint64 m_nextTicket;
+    int m_running;      // Decodes in progress
+    int m_demoting;     // Compressions queued or running
+    qint64 m_bytes;     // Memory of m_images
+    mutable int m_anchorFrame;  // Last frame handed out by image() - the playhead
+    MemoryGovernor *m_memoryGovernor;
+    int m_consumerId;
+    int m_compressedConsumerId;
+    CompressedFrameCache m_compressed;
+    QThreadPool m_pool;
+    QThreadPool m_demotePool;
+};
+
+#endif // FRAMERING_H
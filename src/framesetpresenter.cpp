@@ -0,0 +1,185 @@
+#include "framesetpresenter.h"
+#include "framering.h"
+#include "proxybuilder.h"
+#include "logger.h"
+#include "metricsregistry.h"
+#include "scrubtrace.h"
+
+FrameSetPresenter::FrameSetPresenter(FrameRing *ring, QObject *parent)
+    : QObject(parent)
+    , m_ring(ring)
+    , m_proxyBuilder(nullptr)
+    , m_pendingFrame(-1)
+    , m_settleFrame(-1)
+    , m_maxWaitMs(100)  // ~3 decodes of a 1080p JPEG; longer feels like lag while scrubbing
+    , m_settleMs(150)   // Between scrub steps while dragging the slider
+    , m_proxyFrames(false)
+    , m_refining(false)
+    , m_presented(0)
+    , m_dropped(0)
+    , m_torn(0)
+{
+    m_waitTimer.setSingleShot(true);
+    connect(&m_waitTimer, &QTimer::timeout, this, &FrameSetPresenter::onWaitTimeout);
+    m_settleTimer.setSingleShot(true);
+    connect(&m_settleTimer, &QTimer::timeout, this, &FrameSetPresenter::onSettleTimeout);
+    if (m_ring) {
+        // Emitted from decoder threads - queued to this (GUI) thread
+        connect(m_ring, &FrameRing::frameDecoded, this, &FrameSetPresenter::onFrameDecoded, Qt::QueuedConnection);
+        connect(m_ring, &FrameRing::frameFailed, this, &FrameSetPresenter::onFrameFailed, Qt::QueuedConnection);
+    }
+}
+
+void FrameSetPresenter::setMaxWaitMs(int ms)
+{
+    if (ms < 0 || ms == m_maxWaitMs) {
+        return;
+    }
+    m_maxWaitMs = ms;
+    emit maxWaitMsChanged();
+}
+
+void FrameSetPresenter::setSettleMs(int ms)
+{
+    if (ms < 0 || ms == m_settleMs) {
+        return;
+    }
+    m_settleMs = ms;
+    emit settleMsChanged();
+}
+
+void FrameSetPresenter::setProxyBuilder(ProxyBuilder *builder)
+{
+    m_proxyBuilder = builder;
+}
+
+bool FrameSetPresenter::setRecordPath(const QString &filePath)
+{
+    m_recordFile.close();
+    if (filePath.isEmpty()) {
+        return true;
+    }
+    m_recordFile.setFileName(filePath);
+    if (!m_recordFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || m_recordFile.write(ScrubTrace::header()) < 0) {
+        ERROR_LOG("FrameSetPresenter::setRecordPath - Cannot write scrub trace:" << filePath);
+        m_recordFile.close();
+        return false;
+    }
+    m_recordTimer.start();
+    INFO_LOG("Recording scrub trace to" << filePath);
+    return true;
+}
+
+void FrameSetPresenter::requestFrame(int frame, const QStringList &imageTypes)
+{
+    if (m_recordFile.isOpen()) {
+        m_recordFile.write(ScrubTrace::formatStep({m_recordTimer.elapsed(), frame, imageTypes}));
+    }
+    if (m_pendingFrame >= 0 && m_pendingFrame != frame && !m_refining) {
+        ++m_dropped;  // Overtaken before all its panes were decoded
+    }
+    m_pendingFrame = frame;
+    m_pendingTypes = imageTypes;
+    m_refining = false;
+    m_settleTimer.stop();
+    m_requestTimer.start();
+
+    if (imageTypes.isEmpty() || !m_ring || m_ring->containsFrameSet(frame, imageTypes)) {
+        present(true);
+        return;
+    }
+
+    // Frames scrubbed past are no longer needed - decode this one next
+    m_ring->cancelQueued(this);
+    if (m_proxyBuilder && m_proxyBuilder->containsFrameSet(frame, imageTypes)) {
+        // Decoding full resolution waits until scrubbing pauses
+        present(true, true);
+        m_settleTimer.start(m_settleMs);
+        return;
+    }
+    decodeFrameSet();
+}
+
+void FrameSetPresenter::decodeFrameSet()
+{
+    for (const QString &imageType : m_pendingTypes) {
+        if (!m_ring->request(imageType, m_pendingFrame, this)) {
+            present(false);  // Can't be completed - don't hold the other panes back
+            return;
+        }
+    }
+    m_waitTimer.start(m_maxWaitMs);
+}
+
+void FrameSetPresenter::resetCounters()
+{
+    m_presented = 0;
+    m_dropped = 0;
+    m_torn = 0;
+    emit countersChanged();
+}
+
+void FrameSetPresenter::onFrameDecoded(const QString &imageType, int frameNumber)
+{
+    Q_UNUSED(imageType);
+    if (frameNumber == m_pendingFrame && m_ring->containsFrameSet(m_pendingFrame, m_pendingTypes)) {
+        present(true);
+    }
+}
+
+void FrameSetPresenter::onFrameFailed(const QString &imageType, int frameNumber)
+{
+    if (frameNumber == m_pendingFrame && m_pendingTypes.contains(imageType)) {
+        present(false);
+    }
+}
+
+void FrameSetPresenter::onWaitTimeout()
+{
+    if (m_pendingFrame >= 0) {
+        present(false);
+    }
+}
+
+void FrameSetPresenter::onSettleTimeout()
+{
+    if (!m_proxyFrames || !m_ring) {
+        return;
+    }
+    // The frame set shown from proxies is pending again until full resolution is decoded
+    m_pendingFrame = m_settleFrame;
+    m_refining = true;
+    if (m_ring->containsFrameSet(m_pendingFrame, m_pendingTypes)) {
+        present(true);
+        return;
+    }
+    decodeFrameSet();
+}
+
+void FrameSetPresenter::present(bool complete, bool proxy)
+{
+    const int frame = m_pendingFrame;
+    m_pendingFrame = -1;
+    m_waitTimer.stop();
+    if (proxy) {
+        m_settleFrame = frame;
+    }
+    if (!m_refining) {
+        // Refinements were already presented once (from proxies)
+        MetricsRegistry::recordLatency(MetricsRegistry::ScrubToPresentLatency, m_requestTimer.nsecsElapsed());
+        ++m_presented;
+    }
+    m_refining = false;
+    if (!complete) {
+        ++m_torn;
+        DEBUG_LOG("FrameSetPresenter") << "present - Frame" << frame << "presented incomplete (torn:" << m_torn
+                                       << "dropped:" << m_dropped << "presented:" << m_presented << ")";
+    }
+    emit countersChanged();
+    // Set before frameSetReady: the panes pick their image source from it
+    if (m_proxyFrames != proxy) {
+        m_proxyFrames = proxy;
+        emit proxyFramesChanged();
+    }
+    emit frameSetReady(frame);
+}
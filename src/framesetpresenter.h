@@ -0,0 +1,136 @@
+#ifndef FRAMESETPRESENTER_H
+#define FRAMESETPRESENTER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFile>
+
+// Forward declarations
+class FrameRing;
+class ProxyBuilder;
+
+/**
+ * @brief FrameSetPresenter - Switches all visible panes to a frame together
+ *
+ * Each pane (ImageFileAB/C/D) double-buffers on its own, so while scrubbing fast the
+ * orig, test and diff panes could show different frames for a moment. Main.qml now
+ * asks the presenter for a frame instead of updating the panes directly; the
+ * presenter decodes the missing images into the shared FrameRing and emits
+ * frameSetReady(frame) once every visible pane's image is in memory. The panes
+ * then read them through image://frames and all swap in the same update.
+ *
+ * Only the most recent request is presented - requests overtaken by a newer one
+ * count as dropped. If a frame set can't be completed (missing file, or not decoded
+ * within maxWaitMs) it is presented anyway and counted as torn, since the panes
+ * then load from disk individually.
+ *
+ * With a ProxyBuilder set, frames not decoded yet whose scrub proxies exist are
+ * presented at once from the proxies (proxyFrames is true while they are shown).
+ * Once no new frame was requested for settleMs, the frame set is decoded at full
+ * resolution and presented again.
+ *
+ * Requests can be recorded to a scrub trace (see ScrubTrace) and replayed offline
+ * with tests/scrubreplay.
+ */
+class FrameSetPresenter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int maxWaitMs READ maxWaitMs WRITE setMaxWaitMs NOTIFY maxWaitMsChanged)
+    Q_PROPERTY(int presentedFrameSets READ presentedFrameSets NOTIFY countersChanged)
+    Q_PROPERTY(int droppedFrameSets READ droppedFrameSets NOTIFY countersChanged)
+    Q_PROPERTY(int tornFrameSets READ tornFrameSets NOTIFY countersChanged)
+    Q_PROPERTY(bool proxyFrames READ proxyFrames NOTIFY proxyFramesChanged)
+    Q_PROPERTY(int settleMs READ settleMs WRITE setSettleMs NOTIFY settleMsChanged)
+
+public:
+    /**
+     * @param ring - Decoded frame cache (not owned, see PlaybackEngine::frameRing())
+     */
+    explicit FrameSetPresenter(FrameRing *ring, QObject *parent = nullptr);
+
+    /**
+     * @brief Request a frame on all visible panes
+     * @param frame - Frame number
+     * @param imageTypes - Image types of the visible panes (empty = present immediately)
+     */
+    Q_INVOKABLE void requestFrame(int frame, const QStringList &imageTypes);
+
+    /**
+     * @brief Reset the debug counters
+     */
+    Q_INVOKABLE void resetCounters();
+
+    /**
+     * @brief Record every frame request to a scrub trace file
+     * @param filePath - Trace file (overwritten); empty stops recording
+     * @return false if the file can't be written
+     */
+    bool setRecordPath(const QString &filePath);
+
+    /**
+     * @brief Present scrub proxies while frames aren't decoded yet
+     * @param builder - Proxies of the open event (not owned, may be null)
+     */
+    void setProxyBuilder(ProxyBuilder *builder);
+
+    int maxWaitMs() const { return m_maxWaitMs; }
+    void setMaxWaitMs(int ms);
+    int presentedFrameSets() const { return m_presented; }
+    int droppedFrameSets() const { return m_dropped; }
+    int tornFrameSets() const { return m_torn; }
+    bool proxyFrames() const { return m_proxyFrames; }
+    int settleMs() const { return m_settleMs; }
+    void setSettleMs(int ms);
+
+signals:
+    /**
+     * @brief All visible panes should switch to this frame now
+     */
+    void frameSetReady(int frame);
+
+    void maxWaitMsChanged();
+    void countersChanged();
+    void proxyFramesChanged();
+    void settleMsChanged();
+
+private slots:
+    void onFrameDecoded(const QString &imageType, int frameNumber);
+    void onFrameFailed(const QString &imageType, int frameNumber);
+    void onWaitTimeout();
+    void onSettleTimeout();
+
+private:
+    /**
+     * @brief Decode the pending frame set into the ring (presented when complete)
+     */
+    void decodeFrameSet();
+
+    /**
+     * @param complete - false if some panes load their image themselves
+     * @param proxy - Panes show the scrub proxies
+     */
+    void present(bool complete, bool proxy = false);
+
+    FrameRing *m_ring;
+    ProxyBuilder *m_proxyBuilder;
+    QTimer m_waitTimer;
+    QTimer m_settleTimer;       // Scrubbing paused on a proxy frame set: refine it
+    QElapsedTimer m_requestTimer;  // Since the pending frame was requested (scrub-to-present latency)
+    int m_pendingFrame;         // -1 = nothing pending
+    int m_settleFrame;          // Shown from proxies
+    QStringList m_pendingTypes;
+    int m_maxWaitMs;
+    int m_settleMs;
+    bool m_proxyFrames;
+    bool m_refining;            // Pending frame set is already shown from proxies
+    int m_presented;
+    int m_dropped;
+    int m_torn;
+    QFile m_recordFile;            // Open while recording a scrub trace
+    QElapsedTimer m_recordTimer;   // Since recording started
+};
+
+#endif // FRAMESETPRESENTER_H
@@ -0,0 +1,162 @@
+#include "framevalueindex.h"
+#include <algorithm>
+#include <limits>
+
+FrameValueIndex::FrameValueIndex()
+    : m_leafCount(0)
+{
+}
+
+void FrameValueIndex::build(const QVector<QPointF> &points)
+{
+    clear();
+    if (points.isEmpty()) {
+        return;
+    }
+
+    const int count = points.size();
+    m_frames.reserve(count);
+    m_sortedValues.reserve(count);
+    for (const QPointF &point : points) {
+        m_frames.append(static_cast<int>(point.x()));
+        m_sortedValues.append(point.y());
+    }
+
+    m_leafCount = 1;
+    while (m_leafCount < count) {
+        m_leafCount <<= 1;
+    }
+
+    // Padding leaves never match: +inf is never <= threshold, -inf never > threshold
+    m_minTree.fill(std::numeric_limits<double>::infinity(), 2 * m_leafCount);
+    m_maxTree.fill(-std::numeric_limits<double>::infinity(), 2 * m_leafCount);
+    for (int i = 0; i < count; ++i) {
+        m_minTree[m_leafCount + i] = m_sortedValues.at(i);
+        m_maxTree[m_leafCount + i] = m_sortedValues.at(i);
+    }
+    for (int node = m_leafCount - 1; node >= 1; --node) {
+        m_minTree[node] = std::min(m_minTree.at(2 * node), m_minTree.at(2 * node + 1));
+        m_maxTree[node] = std::max(m_maxTree.at(2 * node), m_maxTree.at(2 * node + 1));
+    }
+
+    std::sort(m_sortedValues.begin(), m_sortedValues.end());
+}
+
+void FrameValueIndex::clear()
+{
+    m_frames.clear();
+    m_sortedValues.clear();
+    m_minTree.clear();
+    m_maxTree.clear();
+    m_leafCount = 0;
+}
+
+int FrameValueIndex::nextFrameAtOrBelow(int frame, double threshold) const
+{
+    if (isEmpty()) {
+        return -1;
+    }
+    const int from = static_cast<int>(std::upper_bound(m_frames.cbegin(), m_frames.cend(), frame) - m_frames.cbegin());
+    const int index = firstAtOrBelow(from, threshold);
+    return index >= 0 ? m_frames.at(index) : -1;
+}
+
+int FrameValueIndex::previousFrameAtOrBelow(int frame, double threshold) const
+{
+    if (isEmpty()) {
+        return -1;
+    }
+    const int to = static_cast<int>(std::lower_bound(m_frames.cbegin(), m_frames.cend(), frame) - m_frames.cbegin()) - 1;
+    const int index = lastAtOrBelow(to, threshold);
+    return index >= 0 ? m_frames.at(index) : -1;
+}
+
+int FrameValueIndex::countAtOrBelow(double threshold) const
+{
+    return static_cast<int>(std::upper_bound(m_sortedValues.cbegin(), m_sortedValues.cend(), threshold) - m_sortedValues.cbegin());
+}
+
+QVector<QPair<int, int>> FrameValueIndex::runsAtOrBelow(double threshold) const
+{
+    QVector<QPair<int, int>> runs;
+    int position = 0;
+    while (position < size()) {
+        const int runStart = firstAtOrBelow(position, threshold);
+        if (runStart < 0) {
+            break;
+        }
+        const int runEnd = firstAbove(runStart, threshold);
+        if (runEnd < 0) {
+            runs.append(qMakePair(runStart, size() - 1));
+            break;
+        }
+        runs.append(qMakePair(runStart, runEnd - 1));
+        position = runEnd;
+    }
+    return runs;
+}
+
+int FrameValueIndex::firstAtOrBelow(int from, double threshold) const
+{
+    if (from >= size()) {
+        return -1;
+    }
+    return firstAtOrBelow(1, 0, m_leafCount, from, threshold);
+}
+
+int FrameValueIndex::lastAtOrBelow(int to, double threshold) const
+{
+    if (to < 0) {
+        return -1;
+    }
+    return lastAtOrBelow(1, 0, m_leafCount, to, threshold);
+}
+
+int FrameValueIndex::firstAbove(int from, double threshold) const
+{
+    if (from >= size()) {
+        return -1;
+    }
+    return firstAbove(1, 0, m_leafCount, from, threshold);
+}
+
+int FrameValueIndex::firstAtOrBelow(int node, int nodeBegin, int nodeEnd, int from, double threshold) const
+{
+    // Subtree entirely before 'from', or nothing in it passes the threshold
+    if (nodeEnd <= from || m_minTree.at(node) > threshold) {
+        return -1;
+    }
+    if (nodeEnd - nodeBegin == 1) {
+        return nodeBegin;
+    }
+    const int mid = (nodeBegin + nodeEnd) / 2;
+    const int left = firstAtOrBelow(2 * node, nodeBegin, mid, from, threshold);
+    return left >= 0 ? left : firstAtOrBelow(2 * node + 1, mid, nodeEnd, from, threshold);
+}
+
+int FrameValueIndex::lastAtOrBelow(int node, int nodeBegin, int nodeEnd, int to, double threshold) const
+{
+    // Subtree entirely after 'to', or nothing in it passes the threshold
+    if (nodeBegin > to || m_minTree.at(node) > threshold) {
+        return -1;
+    }
+    if (nodeEnd - nodeBegin == 1) {
+        return nodeBegin;
+    }
+    const int mid = (nodeBegin + nodeEnd) / 2;
+    const int right = lastAtOrBelow(2 * node + 1, mid, nodeEnd, to, threshold);
+    return right >= 0 ? right : lastAtOrBelow(2 * node, nodeBegin, mid, to, threshold);
+}
+
+int FrameValueIndex::firstAbove(int node, int nodeBegin, int nodeEnd, int from, double threshold) const
+{
+    if (nodeEnd <= from || m_maxTree.at(node) <= threshold) {
+        return -1;
+    }
+    if (nodeEnd - nodeBegin == 1) {
+        return nodeBegin;
+    }
+    const int mid = (nodeBegin + nodeEnd) / 2;
+    const int left = firstAbove(2 * node, nodeBegin, mid, from, threshold);
+    return left >= 0 ? left : firstAbove(2 * node + 1, mid, nodeEnd, from, threshold);
+}
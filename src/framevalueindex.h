@@ -0,0 +1,103 @@
+#ifndef FRAMEVALUEINDEX_H
+#define FRAMEVALUEINDEX_H
+
+#include <QVector>
+#include <QPointF>
+#include <QPair>
+
+/**
+ * @brief FrameValueIndex - Threshold queries over one event's (frame, value) series
+ *
+ * Next/previous "problematic frame" navigation and the red under-threshold series
+ * used to rescan every point in QML. This index answers the same questions in
+ * logarithmic time so they stay instant on any sequence length:
+ * - next/previous frame with value <= threshold (min segment tree descent)
+ * - number of frames with value <= threshold (sorted value array)
+ * - contiguous runs of frames with value <= threshold (min + max segment trees,
+ *   O(log n) per run)
+ *
+ * Input points must be sorted by X (frame number). "Contiguous" means adjacent
+ * entries in the series, which are consecutive frames in compareResult.xml.
+ */
+class FrameValueIndex
+{
+public:
+    FrameValueIndex();
+
+    /**
+     * @brief Build the index from a series
+     * @param points - (frame, value) points sorted by frame
+     */
+    void build(const QVector<QPointF> &points);
+
+    /**
+     * @brief Drop all indexed data
+     */
+    void clear();
+
+    bool isEmpty() const { return m_frames.isEmpty(); }
+    int size() const { return m_frames.size(); }
+
+    /**
+     * @brief Find the first frame after a given frame with value <= threshold
+     * @param frame - Frame to search after (exclusive)
+     * @param threshold - Threshold value
+     * @return Frame number, or -1 if there is none
+     */
+    int nextFrameAtOrBelow(int frame, double threshold) const;
+
+    /**
+     * @brief Find the last frame before a given frame with value <= threshold
+     * @param frame - Frame to search before (exclusive)
+     * @param threshold - Threshold value
+     * @return Frame number, or -1 if there is none
+     */
+    int previousFrameAtOrBelow(int frame, double threshold) const;
+
+    /**
+     * @brief Count frames with value <= threshold
+     * @param threshold - Threshold value
+     * @return Number of frames
+     */
+    int countAtOrBelow(double threshold) const;
+
+    /**
+     * @brief Get the contiguous runs of frames with value <= threshold
+     * @param threshold - Threshold value
+     * @return (first index, last index) pairs into the indexed series, in frame order
+     */
+    QVector<QPair<int, int>> runsAtOrBelow(double threshold) const;
+
+    /**
+     * @brief Frame number at a series index
+     */
+    int frameAt(int index) const { return m_frames.at(index); }
+
+private:
+    /**
+     * @brief First series index >= from whose value is <= threshold (-1 if none)
+     */
+    int firstAtOrBelow(int from, double threshold) const;
+
+    /**
+     * @brief Last series index <= to whose value is <= threshold (-1 if none)
+     */
+    int lastAtOrBelow(int to, double threshold) const;
+
+    /**
+     * @brief First series index >= from whose value is > threshold (-1 if none)
+     */
+    int firstAbove(int from, double threshold) const;
+
+    int firstAtOrBelow(int node, int nodeBegin, int nodeEnd, int from, double threshold) const;
+    int lastAtOrBelow(int node, int nodeBegin, int nodeEnd, int to, double threshold) const;
+    int firstAbove(int node, int nodeBegin, int nodeEnd, int from, double threshold) const;
+
+    QVector<int> m_frames;          // Frame numbers, ascending
+    QVector<double> m_sortedValues; // Values sorted ascending (for counts)
+    QVector<double> m_minTree;      // Segment tree of minimum values (node 1 = root)
+    QVector<double> m_maxTree;      // Segment tree of maximum values (node 1 = root)
+    int m_leafCount;                // Leaves in the trees (power of two >= size())
+};
+
+#endif // FRAMEVALUEINDEX_H
@@ -1,5 +1,6 @@
 #include "freeDView_tester_runner.h"
 #include "logger.h"
+#include "tracer.h"
 #include <QDir>
 #include <QFileInfo>
 #include <QTextStream>
@@ -19,6 +20,7 @@ TesterRunner::TesterRunner(QObject *parent)
 
 void TesterRunner::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
+    TRACE_SCOPE("TesterRunner", "onProcessFinished");
     // Read any remaining output
     const QString stdOut = QString::fromLocal8Bit(m_process.readAllStandardOutput());
     const QString stdErr = QString::fromLocal8Bit(m_process.readAllStandardError());
@@ -331,6 +333,7 @@ void TesterRunner::runNextStep()
 
 void TesterRunner::startProcess(const QString &program, const QStringList &args, const QString &workingDir)
 {
+    TRACE_SCOPE("TesterRunner", "startProcess");
     DEBUG_LOG("TesterRunner") << "Starting process";
     DEBUG_LOG("TesterRunner") << "  Program:" << program;
     DEBUG_LOG("TesterRunner") << "  Arguments:" << args;
@@ -566,6 +569,7 @@ void TesterRunner::startProcess(const QString &program, const QStringList &args,
 
 QString TesterRunner::extractTestKeyFromPath(const QString &folderPath)
 {
+    TRACE_SCOPE("TesterRunner", "extractTestKeyFromPath");
     // Extract test key from folder path
     // Input format: "path/to/testSets_results/SportType/Event/Set/F####" or absolute path
     // Output format: "SportType/Event/Set/F####" (relative path, normalized separators)
@@ -632,6 +636,7 @@ QString TesterRunner::extractTestKeyFromPath(const QString &folderPath)
 
 QString TesterRunner::findTestKeyByFrameCount(int frameCount)
 {
+    TRACE_SCOPE("TesterRunner", "findTestKeyByFrameCount");
     // Find test key(s) that match the given frame count
     QStringList matchingKeys;
     for (auto it = this->m_activeTests.begin(); it != this->m_activeTests.end(); ++it) {
@@ -673,6 +678,7 @@ QString TesterRunner::findTestKeyByFrameCount(int frameCount)
 
 void TesterRunner::onPrepareUIProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
+    TRACE_SCOPE("TesterRunner", "onPrepareUIProcessFinished");
     // Read any remaining output
     const QString stdOut = QString::fromLocal8Bit(m_prepareUIProcess.readAllStandardOutput());
     const QString stdErr = QString::fromLocal8Bit(m_prepareUIProcess.readAllStandardError());
@@ -0,0 +1,319 @@
+#include "headlessreport.h"
+#include "xmldataloader.h"
+#include "xmldatamodel.h"
+#include "inireader.h"
+#include "logger.h"
+#include "tracer.h"
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const int ExitPassed = 0;
+const int ExitFailing = 1;
+const int ExitError = 2;
+
+QString statusOf(const HeadlessReport::EventResult &result)
+{
+    if (result.isMissing()) {
+        return QStringLiteral("missing");
+    }
+    return result.isFailing() ? QStringLiteral("fail") : QStringLiteral("pass");
+}
+
+QString rangesText(const QVector<HeadlessReport::FrameRange> &ranges)
+{
+    QStringList parts;
+    for (const HeadlessReport::FrameRange &range : ranges) {
+        parts.append(range.first == range.last ? QString::number(range.first)
+                                               : QString("%1-%2").arg(range.first).arg(range.last));
+    }
+    return parts.join(';');
+}
+
+QByteArray csvField(const QString &text)
+{
+    if (!text.contains(',') && !text.contains('"') && !text.contains('\n')) {
+        return text.toUtf8();
+    }
+    QString quoted = text;
+    quoted.replace('"', QStringLiteral("\"\""));
+    return '"' + quoted.toUtf8() + '"';
+}
+
+} // namespace
+
+HeadlessReport::HeadlessReport(double threshold)
+    : m_threshold(threshold)
+{
+}
+
+bool HeadlessReport::load(const QString &resultsPath, const QString &testSetsPath)
+{
+    TRACE_SCOPE("HeadlessReport", "load");
+    m_resultsPath = resultsPath;
+    m_results.clear();
+    m_errorString.clear();
+
+    // The loader normally runs on its own thread; here it runs on this one, in a local event loop
+    XmlDataLoader loader;
+    QEventLoop loop;
+    bool success = false;
+    QObject::connect(&loader, &XmlDataLoader::rowLoaded, [this](const QVariantList &rowData, const QString &) {
+        if (rowData.size() < 12) {
+            return;  // Same check as XmlDataModel::onRowLoaded()
+        }
+        EventResult result;
+        result.id = rowData.at(0).toString();
+        result.eventName = rowData.at(1).toString();
+        result.testKey = rowData.at(10).toString();
+        m_results.append(result);
+    });
+    QObject::connect(&loader, &XmlDataLoader::errorOccurred, [this](const QString &message) {
+        m_errorString = message;
+    });
+    QObject::connect(&loader, &XmlDataLoader::loadingFinished, [&loop, &success](bool ok, int) {
+        success = ok;
+        loop.quit();
+    });
+    loader.loadData(resultsPath, testSetsPath);
+    loop.exec();
+
+    if (!success && m_errorString.isEmpty()) {
+        m_errorString = QString("No events found in %1").arg(resultsPath);
+    }
+    return success;
+}
+
+void HeadlessReport::computeStats()
+{
+    TRACE_SCOPE("HeadlessReport", "computeStats");
+    // One directory scan shared by all events, then one task per event (as in XmlDataModel::computeEventStats)
+    const QStringList candidates = XmlDataModel::scanCompareResultXmls(m_resultsPath);
+    const QString resultsPath = m_resultsPath;
+    const double threshold = m_threshold;
+
+    QtConcurrent::blockingMap(m_results, [&candidates, &resultsPath, threshold](EventResult &result) {
+        TRACE_SCOPE("HeadlessReport", "eventStats");
+        result.xmlPath = XmlDataModel::pickCompareResultXml(resultsPath, result.eventName, result.testKey, candidates);
+        QVector<QPointF> points;
+        if (result.xmlPath.isEmpty() || !XmlDataModel::readFrameValues(result.xmlPath, points)) {
+            return;
+        }
+        QVector<float> values;
+        values.reserve(points.size());
+        for (const QPointF &point : points) {
+            values.append(static_cast<float>(point.y()));
+        }
+        result.stats = EventStats::compute(values, threshold);
+        result.rangesUnderThreshold = rangesUnderThreshold(points, threshold);
+    });
+}
+
+int HeadlessReport::failingCount() const
+{
+    return static_cast<int>(std::count_if(m_results.begin(), m_results.end(),
+                                          [](const EventResult &result) { return result.isFailing(); }));
+}
+
+int HeadlessReport::missingCount() const
+{
+    return static_cast<int>(std::count_if(m_results.begin(), m_results.end(),
+                                          [](const EventResult &result) { return result.isMissing(); }));
+}
+
+QVector<HeadlessReport::FrameRange> HeadlessReport::rangesUnderThreshold(const QVector<QPointF> &points,
+                                                                         double threshold)
+{
+    QVector<FrameRange> ranges;
+    bool inRange = false;
+    for (const QPointF &point : points) {
+        const int frame = static_cast<int>(point.x());
+        if (point.y() <= threshold) {
+            if (inRange) {
+                ranges.last().last = frame;
+            } else {
+                ranges.append(FrameRange{frame, frame});
+                inRange = true;
+            }
+        } else {
+            inRange = false;
+        }
+    }
+    return ranges;
+}
+
+QVector<HeadlessReport::EventResult> HeadlessReport::sortedResults(bool failingOnly) const
+{
+    QVector<EventResult> sorted;
+    for (const EventResult &result : m_results) {
+        if (!failingOnly || result.isFailing() || result.isMissing()) {
+            sorted.append(result);
+        }
+    }
+    // Stable: ties keep the uiData.xml order, so reports of two runs diff cleanly
+    std::stable_sort(sorted.begin(), sorted.end(), [](const EventResult &a, const EventResult &b) {
+        const int rankA = a.isFailing() ? 0 : (a.isMissing() ? 1 : 2);
+        const int rankB = b.isFailing() ? 0 : (b.isMissing() ? 1 : 2);
+        if (rankA != rankB) {
+            return rankA < rankB;
+        }
+        if (a.stats.framesUnderThreshold != b.stats.framesUnderThreshold) {
+            return a.stats.framesUnderThreshold > b.stats.framesUnderThreshold;
+        }
+        return a.stats.longestBadRun > b.stats.longestBadRun;
+    });
+    return sorted;
+}
+
+QByteArray HeadlessReport::toJson(bool failingOnly) const
+{
+    QJsonArray events;
+    for (const EventResult &result : sortedResults(failingOnly)) {
+        QJsonObject event;
+        event["id"] = result.id;
+        event["eventName"] = result.eventName;
+        event["testKey"] = result.testKey;
+        event["status"] = statusOf(result);
+        event["compareResultXml"] = result.xmlPath;
+        if (!result.isMissing()) {
+            event["frameCount"] = result.stats.frameCount;
+            event["framesUnderThreshold"] = result.stats.framesUnderThreshold;
+            event["longestBadRun"] = result.stats.longestBadRun;
+            event["p5Value"] = result.stats.p5Value;
+            event["medianValue"] = result.stats.medianValue;
+            event["p95Value"] = result.stats.p95Value;
+            QJsonArray ranges;
+            for (const FrameRange &range : result.rangesUnderThreshold) {
+                ranges.append(QJsonArray{range.first, range.last});
+            }
+            event["rangesUnderThreshold"] = ranges;
+        }
+        events.append(event);
+    }
+
+    QJsonObject summary;
+    summary["events"] = m_results.size();
+    summary["failing"] = failingCount();
+    summary["missing"] = missingCount();
+    summary["passing"] = m_results.size() - failingCount() - missingCount();
+
+    QJsonObject root;
+    root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["resultsPath"] = m_resultsPath;
+    root["threshold"] = m_threshold;
+    root["summary"] = summary;
+    root["events"] = events;
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+QByteArray HeadlessReport::toCsv(bool failingOnly) const
+{
+    QByteArray csv = "id,eventName,testKey,status,frameCount,framesUnderThreshold,longestBadRun,"
+                     "p5Value,medianValue,p95Value,rangesUnderThreshold,compareResultXml\n";
+    for (const EventResult &result : sortedResults(failingOnly)) {
+        const bool missing = result.isMissing();
+        QList<QByteArray> fields;
+        fields << csvField(result.id) << csvField(result.eventName) << csvField(result.testKey)
+               << statusOf(result).toUtf8()
+               << (missing ? QByteArray() : QByteArray::number(result.stats.frameCount))
+               << (missing ? QByteArray() : QByteArray::number(result.stats.framesUnderThreshold))
+               << (missing ? QByteArray() : QByteArray::number(result.stats.longestBadRun))
+               << (missing ? QByteArray() : QByteArray::number(result.stats.p5Value, 'f', 6))
+               << (missing ? QByteArray() : QByteArray::number(result.stats.medianValue, 'f', 6))
+               << (missing ? QByteArray() : QByteArray::number(result.stats.p95Value, 'f', 6))
+               << csvField(rangesText(result.rangesUnderThreshold))
+               << csvField(result.xmlPath);
+        csv += fields.join(',') + '\n';
+    }
+    return csv;
+}
+
+int HeadlessReport::run(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render Compare batch triage report (no GUI)");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("headless", "Run without GUI and write a report."));
+    parser.addOption(QCommandLineOption("results", "testSets_results directory (default: from renderCompare.ini).", "dir"));
+    parser.addOption(QCommandLineOption("testsets", "testSets directory (default: from renderCompare.ini).", "dir"));
+    parser.addOption(QCommandLineOption("threshold", "Frames with value <= threshold are bad (default: 1.0).", "value", "1.0"));
+    parser.addOption(QCommandLineOption("format", "Report format: json or csv (default: json).", "format", "json"));
+    parser.addOption(QCommandLineOption("output", "Report file (default: standard output).", "file", "-"));
+    parser.addOption(QCommandLineOption("all", "Also list passing events."));
+
+    // --trace is handled by main() and takes an optional file, which QCommandLineParser can't express
+    QStringList reportArguments = arguments;
+    const int traceIndex = reportArguments.indexOf("--trace");
+    if (traceIndex > 0) {
+        const bool hasFile = traceIndex + 1 < reportArguments.size() && !reportArguments.at(traceIndex + 1).startsWith('-');
+        reportArguments.erase(reportArguments.begin() + traceIndex, reportArguments.begin() + traceIndex + (hasFile ? 2 : 1));
+    }
+    if (!parser.parse(reportArguments)) {
+        ERROR_LOG("HeadlessReport -" << parser.errorText());
+        return ExitError;
+    }
+    if (parser.isSet("help")) {
+        std::fputs(qPrintable(parser.helpText()), stdout);
+        return ExitPassed;
+    }
+
+    bool thresholdOk = false;
+    const double threshold = parser.value("threshold").toDouble(&thresholdOk);
+    const QString format = parser.value("format").toLower();
+    if (!thresholdOk || (format != "json" && format != "csv")) {
+        ERROR_LOG("HeadlessReport - Invalid --threshold or --format:" << parser.value("threshold") << parser.value("format"));
+        return ExitError;
+    }
+
+    // Paths from the command line, otherwise from the same INI file the GUI reads
+    QString resultsPath = parser.value("results");
+    QString testSetsPath = parser.value("testsets");
+    if (resultsPath.isEmpty()) {
+        IniReader iniReader;
+        if (!iniReader.readINIFile()) {
+            ERROR_LOG("HeadlessReport - No --results given and renderCompare.ini could not be read");
+            return ExitError;
+        }
+        resultsPath = iniReader.setTestResultsPath();
+        if (testSetsPath.isEmpty()) {
+            testSetsPath = iniReader.setTestPath();
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    HeadlessReport report(threshold);
+    if (!report.load(resultsPath, testSetsPath)) {
+        ERROR_LOG("HeadlessReport - Failed to load results:" << report.errorString());
+        return ExitError;
+    }
+    const qint64 loadMs = timer.restart();
+    report.computeStats();
+    INFO_LOG("HeadlessReport -" << report.results().size() << "events," << report.failingCount() << "failing,"
+             << report.missingCount() << "without compareResult.xml (load" << loadMs << "ms, stats"
+             << timer.elapsed() << "ms)");
+
+    const bool failingOnly = !parser.isSet("all");
+    const QByteArray output = format == "csv" ? report.toCsv(failingOnly) : report.toJson(failingOnly);
+    const QString outputPath = parser.value("output");
+    QFile file(outputPath);
+    const bool opened = outputPath == "-" ? file.open(stdout, QIODevice::WriteOnly)
+                                          : file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (!opened || file.write(output) != output.size()) {
+        ERROR_LOG("HeadlessReport - Failed to write report:" << outputPath);
+        return ExitError;
+    }
+    file.close();
+
+    return report.failingCount() > 0 ? ExitFailing : ExitPassed;
+}
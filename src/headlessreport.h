@@ -0,0 +1,112 @@
+#ifndef HEADLESSREPORT_H
+#define HEADLESSREPORT_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QPointF>
+#include <QByteArray>
+#include "eventstats.h"
+
+/**
+ * @brief HeadlessReport - Batch triage report without the GUI ("renderCompare --headless")
+ *
+ * Runs the same data pipeline as the table view - uiData.xml through XmlDataLoader,
+ * then every event's compareResult.xml through XmlDataModel's statistics helpers
+ * (one directory scan, events in parallel on the global thread pool) - and writes a
+ * JSON or CSV report of the events with frames at or under the threshold, with the
+ * frame ranges concerned. Only needs a QCoreApplication, so it runs in CI containers
+ * without a display or GPU.
+ *
+ * Usage:
+ *   renderCompare --headless [--results <dir>] [--testsets <dir>] [--threshold <value>]
+ *                 [--format json|csv] [--output <file>] [--all]
+ *
+ * Exit code: 0 = no failing events, 1 = failing events found, 2 = usage or load error.
+ */
+class HeadlessReport
+{
+public:
+    /**
+     * @brief Consecutive frames at or under the threshold (frame numbers, inclusive)
+     */
+    struct FrameRange {
+        int first;
+        int last;
+    };
+
+    struct EventResult {
+        QString id;
+        QString eventName;
+        QString testKey;
+        QString xmlPath;  // compareResult.xml (empty = not found)
+        EventStats stats;
+        QVector<FrameRange> rangesUnderThreshold;
+
+        bool isMissing() const { return !stats.isValid(); }
+        bool isFailing() const { return stats.isValid() && stats.framesUnderThreshold > 0; }
+    };
+
+    /**
+     * @param threshold - Frames with value <= threshold count as bad (same as the table's threshold)
+     */
+    explicit HeadlessReport(double threshold = 1.0);
+
+    /**
+     * @brief Read the events listed in uiData.xml (blocks until loaded)
+     * @param resultsPath - Path to the testSets_results directory
+     * @param testSetsPath - Optional testSets directory (fallback thumbnail lookup)
+     * @return false if uiData.xml couldn't be read (see errorString())
+     */
+    bool load(const QString &resultsPath, const QString &testSetsPath = QString());
+
+    /**
+     * @brief Compute the statistics and bad frame ranges of all loaded events (in parallel)
+     */
+    void computeStats();
+
+    const QVector<EventResult> &results() const { return m_results; }
+    int failingCount() const;
+    int missingCount() const;
+    QString errorString() const { return m_errorString; }
+
+    /**
+     * @brief Report as JSON (summary and one object per event, worst first)
+     * @param failingOnly - Leave out passing events
+     */
+    QByteArray toJson(bool failingOnly) const;
+
+    /**
+     * @brief Report as CSV (one line per event, worst first)
+     * @param failingOnly - Leave out passing events
+     */
+    QByteArray toCsv(bool failingOnly) const;
+
+    /**
+     * @brief Find the runs of consecutive frames at or under a threshold
+     * @param points - (frame, value) points in frame order, from XmlDataModel::readFrameValues()
+     * @param threshold - Frames with value <= threshold are bad
+     * @return Frame ranges in frame order
+     */
+    static QVector<FrameRange> rangesUnderThreshold(const QVector<QPointF> &points, double threshold);
+
+    /**
+     * @brief Command line entry point (QCoreApplication must exist)
+     * @param arguments - Application arguments (including "--headless")
+     * @return Process exit code
+     */
+    static int run(const QStringList &arguments);
+
+private:
+    /**
+     * @brief Events in report order: failing (most bad frames first), missing, passing
+     */
+    QVector<EventResult> sortedResults(bool failingOnly) const;
+
+    double m_threshold;
+    QString m_resultsPath;
+    QString m_errorString;
+    QVector<EventResult> m_results;
+};
+
+#endif // HEADLESSREPORT_H
@@ -1,13 +1,96 @@
 #include "imageloadermanager.h"
 #include <QFileInfo>
 #include <QDir>
+#include <QDirIterator>
 #include <QStandardPaths>
 #include <QImage>
+#include <QImageReader>
+#include <QVariantMap>
+#include <algorithm>
+#include "tilepyramid.h"
+#include "tracer.h"
+#include "metricsregistry.h"
+#include "memorygovernor.h"
+
+namespace {
+
+qint64 pixmapBytes(const QPixmap &pixmap)
+{
+    return static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+// Frame formats other than the default JPEG/PNG, tried in this order (renderers that
+// write 16-bit PNG, TIFF or EXR); EXR needs a Qt image plugin such as kimageformats
+const char *const kHighBitDepthExtensions[] = { ".png", ".tif", ".tiff", ".exr" };
+
+/**
+ * @brief Find the extension of the frames in a folder
+ * @param basePath - Frame path prefix (the folder, ending with a separator)
+ * @param defaultExtension - Extension used when frames of that type exist (or nothing matches)
+ * @param highBitDepth - Output: whether the first frame found decodes to more than 8 bits per channel
+ * @return Extension including the dot
+ */
+QString detectFrameExtension(const QString &basePath, const QString &defaultExtension, bool &highBitDepth)
+{
+    highBitDepth = false;
+    if (basePath.isEmpty()) {
+        return defaultExtension;
+    }
+    const QFileInfo prefixInfo(basePath + QLatin1Char('x'));
+    const QString prefix = prefixInfo.fileName().chopped(1);
+    QStringList nameFilters(QLatin1Char('*') + defaultExtension);
+    for (const char *extension : kHighBitDepthExtensions) {
+        nameFilters.append(QLatin1Char('*') + QLatin1String(extension));
+    }
+
+    // One matching file per extension is enough; stop at the first default one (the common case)
+    QHash<QString, QString> samples;
+    QDirIterator it(prefixInfo.absolutePath(), nameFilters, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QString name = it.fileName();
+        if (!name.startsWith(prefix)) {
+            continue;
+        }
+        const QString extension = name.mid(name.lastIndexOf(QLatin1Char('.'))).toLower();
+        if (!samples.contains(extension)) {
+            samples.insert(extension, it.filePath());
+        }
+        if (extension == defaultExtension) {
+            break;
+        }
+    }
+
+    QString extension = defaultExtension;
+    if (!samples.contains(defaultExtension)) {
+        for (const char *candidate : kHighBitDepthExtensions) {
+            if (samples.contains(QLatin1String(candidate))) {
+                extension = QLatin1String(candidate);
+                break;
+            }
+        }
+    }
+    if (samples.contains(extension)) {
+        // Header only; 16-bit PNG/TIFF decode to 64-bit formats
+        const QImage::Format format = QImageReader(samples.value(extension)).imageFormat();
+        highBitDepth = format == QImage::Format_RGBA64 || format == QImage::Format_RGBX64
+                       || format == QImage::Format_RGBA64_Premultiplied;
+    }
+    return extension;
+}
+
+} // namespace
 
 ImageLoaderManager::ImageLoaderManager(QObject *parent)
     : QObject(parent)
     , m_maxCacheSize(6)  // Small cache: 6 images (~36MB for 1920x1080) for adjacent frames
+    , m_cacheBytes(0)
     , m_threadPool(new QThreadPool(this))
+    , m_tileCacheBytes(0)
+    , m_maxTileCacheBytes(96 * 1024 * 1024)  // ~96 tiles of 512x512 ARGB32
+    , m_memoryGovernor(nullptr)
+    , m_imageConsumerId(0)
+    , m_tileConsumerId(0)
 {
     // Set thread pool to use 2 threads - prevents too many simultaneous loads that cause memory issues
     m_threadPool->setMaxThreadCount(2);
@@ -15,9 +98,52 @@ ImageLoaderManager::ImageLoaderManager(QObject *parent)
 
 ImageLoaderManager::~ImageLoaderManager()
 {
+    setMemoryGovernor(nullptr);
     clearCache();
 }
 
+void ImageLoaderManager::setMemoryGovernor(MemoryGovernor *governor)
+{
+    if (m_memoryGovernor) {
+        m_memoryGovernor->removeConsumer(m_imageConsumerId);
+        m_memoryGovernor->removeConsumer(m_tileConsumerId);
+    }
+    m_memoryGovernor = governor;
+    if (!governor) {
+        return;
+    }
+    // Tiles are re-decoded per visible area on demand - cheapest to give back
+    m_tileConsumerId = governor->addConsumer(
+        QStringLiteral("tileCache"), 0,
+        [this]() { QMutexLocker locker(&m_tileMutex); return m_tileCacheBytes; },
+        [this](qint64 bytes) { return releaseTileCache(bytes); });
+    m_imageConsumerId = governor->addConsumer(
+        QStringLiteral("imageCache"), 1,
+        [this]() { QMutexLocker locker(&m_cacheMutex); return m_cacheBytes; },
+        [this](qint64 bytes) { return releaseImageCache(bytes); });
+}
+
+qint64 ImageLoaderManager::releaseImageCache(qint64 bytes)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    const qint64 before = m_cacheBytes;
+    while (before - m_cacheBytes < bytes && !m_cacheAccessOrder.isEmpty()) {
+        m_cacheBytes -= pixmapBytes(m_cache.take(m_cacheAccessOrder.takeFirst()));
+    }
+    return before - m_cacheBytes;
+}
+
+qint64 ImageLoaderManager::releaseTileCache(qint64 bytes)
+{
+    QMutexLocker locker(&m_tileMutex);
+    const qint64 before = m_tileCacheBytes;
+    while (before - m_tileCacheBytes < bytes && !m_tileAccessOrder.isEmpty()) {
+        m_tileCacheBytes -= m_tileCache.take(m_tileAccessOrder.takeFirst()).sizeInBytes();
+    }
+    MetricsRegistry::setGauge(MetricsRegistry::TileCacheBytes, m_tileCacheBytes);
+    return before - m_tileCacheBytes;
+}
+
 void ImageLoaderManager::setImagePaths(const QString &pathA, const QString &pathB, const QString &pathC, const QString &pathD)
 {
     // Remove file:/// prefix if present and convert to native path
@@ -37,8 +163,28 @@ void ImageLoaderManager::setImagePaths(const QString &pathA, const QString &path
     m_pathC = cleanPath(pathC);
     m_pathD = cleanPath(pathD);
 
+    // Frame format per type: the default JPEG/PNG, or 16-bit PNG/TIFF/EXR from HDR renderers
+    const QString paths[4] = { m_pathA, m_pathB, m_pathC, m_pathD };
+    const char *const types[4] = { "A", "B", "C", "D" };
+    m_extensions.clear();
+    m_highBitDepthTypes.clear();
+    for (int i = 0; i < 4; ++i) {
+        const QString defaultExtension = i == 3 ? QStringLiteral(".png") : QStringLiteral(".jpg");
+        bool highBitDepth = false;
+        const QString extension = detectFrameExtension(paths[i], defaultExtension, highBitDepth);
+        m_extensions.insert(QLatin1String(types[i]), extension);
+        if (highBitDepth) {
+            m_highBitDepthTypes.insert(QLatin1String(types[i]));
+        }
+        if (extension != defaultExtension || highBitDepth) {
+            INFO_LOG("ImageLoaderManager - Type" << types[i] << "frames are" << extension
+                     << (highBitDepth ? "(16 bits per channel)" : ""));
+        }
+    }
+
     // Clear cache when paths change
     clearCache();
+    emit imagePathsChanged();
 }
 
 QPixmap ImageLoaderManager::getImageIfCached(const QString &imageType, int frameNumber) const
@@ -62,6 +208,7 @@ QPixmap ImageLoaderManager::getImageIfCached(const QString &imageType, int frame
 
 QPixmap ImageLoaderManager::getImage(const QString &imageType, int frameNumber)
 {
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "getImage", frameNumber);
     if (frameNumber < 1) {
         emit errorOccurred(QString("Invalid frame number: %1").arg(frameNumber));
         return QPixmap();
@@ -71,8 +218,10 @@ QPixmap ImageLoaderManager::getImage(const QString &imageType, int frameNumber)
     if (m_maxCacheSize > 0) {
         QPixmap cached = getImageIfCached(imageType, frameNumber);
         if (!cached.isNull()) {
+            MetricsRegistry::increment(MetricsRegistry::ImageCacheHits);
             return cached;  // Cache hit
         }
+        MetricsRegistry::increment(MetricsRegistry::ImageCacheMisses);
     }
 
     // Cache miss or cache disabled: Load from disk
@@ -83,6 +232,8 @@ QPixmap ImageLoaderManager::getImage(const QString &imageType, int frameNumber)
         if (m_maxCacheSize > 0) {
             QMutexLocker locker(&m_cacheMutex);
             QString key = getCacheKey(imageType, frameNumber);
+            // Another thread may have loaded the same image meanwhile
+            m_cacheBytes += pixmapBytes(pixmap) - pixmapBytes(m_cache.value(key));
             m_cache[key] = pixmap;
             
             // Update access order (move to end = most recently used)
@@ -91,6 +242,9 @@ QPixmap ImageLoaderManager::getImage(const QString &imageType, int frameNumber)
             
             // Evict oldest if cache is full
             evictOldestIfNeeded();
+            if (m_memoryGovernor) {
+                m_memoryGovernor->requestCheck();
+            }
         }
         
         emit imageLoaded(imageType, frameNumber);
@@ -170,10 +324,20 @@ void ImageLoaderManager::clearCache()
     QMutexLocker locker(&m_cacheMutex);
     m_cache.clear();
     m_cacheAccessOrder.clear();
+    m_cacheBytes = 0;
+    locker.unlock();
+
+    QMutexLocker tileLocker(&m_tileMutex);
+    m_tileCache.clear();
+    m_tileAccessOrder.clear();
+    m_tileCacheBytes = 0;
+    m_imageSizes.clear();
+    MetricsRegistry::setGauge(MetricsRegistry::TileCacheBytes, 0);
 }
 
 void ImageLoaderManager::preloadAdjacentFrames(int currentFrame, int maxFrame, const QStringList &imageTypes)
 {
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "preloadAdjacentFrames", currentFrame);
     if (m_maxCacheSize == 0) {
         return;  // Cache disabled
     }
@@ -221,12 +385,10 @@ void ImageLoaderManager::evictOldestIfNeeded()
         return;  // Cache disabled
     }
     
-    QMutexLocker locker(&m_cacheMutex);
-    
-    // Remove oldest entries until cache is within limit
-    while (m_cache.size() >= m_maxCacheSize && !m_cacheAccessOrder.isEmpty()) {
+    // Remove oldest entries until cache is within limit (caller holds m_cacheMutex)
+    while (m_cache.size() > m_maxCacheSize && !m_cacheAccessOrder.isEmpty()) {
         QString oldestKey = m_cacheAccessOrder.takeFirst();
-        m_cache.remove(oldestKey);
+        m_cacheBytes -= pixmapBytes(m_cache.take(oldestKey));
     }
 }
 
@@ -248,6 +410,7 @@ void ImageLoaderManager::evictOldestIfNeeded()
  */
 QPixmap ImageLoaderManager::loadImageFromDisk(const QString &imageType, const int frameNumber)
 {
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "loadImageFromDisk", frameNumber);
     // Validate imageType parameter
     if (imageType != "A" && imageType != "B" && imageType != "C" && imageType != "D") {
         QString errorMsg = QString("Invalid image type: %1 (must be A, B, C, or D)").arg(imageType);
@@ -285,7 +448,12 @@ QPixmap ImageLoaderManager::loadImageFromDisk(const QString &imageType, const in
     // Load as QImage first (more memory efficient), then convert to QPixmap
     // This two-step process helps avoid memory fragmentation
     QImage image;
-    if (!image.load(filePath)) {
+    bool loaded;
+    {
+        ScopedLatency latency(MetricsRegistry::DecodeLatency);
+        loaded = image.load(filePath);
+    }
+    if (!loaded) {
         // Distinguish between memory issues and file corruption issues
         QString errorMsg;
         if (image.isNull() && QFileInfo(filePath).exists()) {
@@ -322,6 +490,7 @@ QPixmap ImageLoaderManager::loadImageFromDisk(const QString &imageType, const in
 
 QString ImageLoaderManager::getImageFilePath(const QString &imageType, int frameNumber) const
 {
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "getImageFilePath", frameNumber);
     // Validate image type
     if (imageType != "A" && imageType != "B" && imageType != "C" && imageType != "D") {
         DEBUG_LOG("ImageLoaderManager") << "getImageFilePath - Invalid imageType:" << imageType;
@@ -381,28 +550,223 @@ QString ImageLoaderManager::getImageFilePath(const QString &imageType, int frame
     return qmlPath;
 }
 
+QString ImageLoaderManager::getImageDiskPath(const QString &imageType, int frameNumber) const
+{
+    if (frameNumber < 1) {
+        return QString();
+    }
+
+    QString basePath;
+    QString extension;
+    if (!getImageTypePathAndExtension(imageType, basePath, extension) || basePath.isEmpty()) {
+        return QString();
+    }
+
+    // Same naming as loadImageFromDisk(): basePath + 4-digit frame number + extension
+    return basePath + QString("%1").arg(frameNumber, 4, 10, QChar('0')) + extension;
+}
+
+QSize ImageLoaderManager::getImageSize(const QString &imageType, int frameNumber)
+{
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "getImageSize", frameNumber);
+    const QString path = getImageDiskPath(imageType, frameNumber);
+    if (path.isEmpty()) {
+        return QSize();
+    }
+
+    QMutexLocker locker(&m_tileMutex);
+    auto it = m_imageSizes.constFind(path);
+    if (it != m_imageSizes.constEnd()) {
+        return it.value();
+    }
+    locker.unlock();
+
+    // Reads the header only
+    const QSize size = QImageReader(path).size();
+    if (size.isValid()) {
+        locker.relock();
+        m_imageSizes.insert(path, size);
+    }
+    return size;
+}
+
+QImage ImageLoaderManager::getTile(const QString &imageType, int frameNumber, int level, int column, int row)
+{
+    TRACE_SCOPE_VALUE("ImageLoaderManager", "getTile", frameNumber);
+    const QString path = getImageDiskPath(imageType, frameNumber);
+    const QSize imageSize = getImageSize(imageType, frameNumber);
+    if (path.isEmpty() || !imageSize.isValid() || level < 0 || level >= TilePyramid::levelCount(imageSize)) {
+        return QImage();
+    }
+
+    const QString key = QString("%1#%2/%3/%4").arg(path).arg(level).arg(column).arg(row);
+    const QString levelKey = QString("%1#%2").arg(path).arg(level);
+    QImage tile;
+    {
+        QMutexLocker locker(&m_tileMutex);
+        if (waitForTile(key, levelKey, tile)) {
+            return tile;
+        }
+    }
+    MetricsRegistry::increment(MetricsRegistry::TileCacheMisses);
+
+    if (TilePyramid::decodesClipped(path, level)) {
+        // Decode outside the lock - several loader threads may decode tiles at once
+        tile = TilePyramid::decodeTile(path, imageSize, level, column, row);
+        if (tile.isNull()) {
+            DEBUG_LOG("ImageLoaderManager") << "getTile - Failed to decode tile" << key;
+            return tile;
+        }
+        QMutexLocker locker(&m_tileMutex);
+        insertTile(key, tile);
+        return tile;
+    }
+
+    // The whole frame is decoded anyway: decode the level once and cache all of its tiles
+    {
+        QMutexLocker locker(&m_tileMutex);
+        if (waitForTile(key, levelKey, tile)) {
+            return tile;
+        }
+        m_decodingLevels.insert(levelKey);
+    }
+    const QVector<QImage> tiles = TilePyramid::decodeLevelTiles(path, imageSize, level);
+    const int columns = TilePyramid::columnCount(imageSize, level);
+    tile = column >= 0 && column < columns ? tiles.value(row * columns + column) : QImage();
+
+    // Nearest tiles last, so they are evicted last when the level exceeds the cache
+    QVector<int> order;
+    for (int i = 0; i < tiles.size(); ++i) {
+        order.append(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [columns, column, row](int a, int b) {
+        const int distanceA = qMax(qAbs(a % columns - column), qAbs(a / columns - row));
+        const int distanceB = qMax(qAbs(b % columns - column), qAbs(b / columns - row));
+        return distanceA > distanceB;
+    });
+
+    QMutexLocker locker(&m_tileMutex);
+    for (int index : order) {
+        insertTile(QString("%1/%2/%3").arg(levelKey).arg(index % columns).arg(index / columns), tiles.at(index));
+    }
+    m_decodingLevels.remove(levelKey);
+    m_levelDecoded.wakeAll();
+    if (tile.isNull()) {
+        DEBUG_LOG("ImageLoaderManager") << "getTile - Failed to decode tile" << key;
+    }
+    return tile;
+}
+
+bool ImageLoaderManager::waitForTile(const QString &key, const QString &levelKey, QImage &tile)
+{
+    for (;;) {
+        auto it = m_tileCache.constFind(key);
+        if (it != m_tileCache.constEnd()) {
+            m_tileAccessOrder.removeOne(key);
+            m_tileAccessOrder.append(key);
+            MetricsRegistry::increment(MetricsRegistry::TileCacheHits);
+            tile = it.value();
+            return true;
+        }
+        if (!m_decodingLevels.contains(levelKey)) {
+            return false;
+        }
+        m_levelDecoded.wait(&m_tileMutex);
+    }
+}
+
+void ImageLoaderManager::insertTile(const QString &key, const QImage &tile)
+{
+    if (m_maxTileCacheBytes <= 0 || tile.isNull() || m_tileCache.contains(key)) {
+        return;
+    }
+    m_tileCache.insert(key, tile);
+    m_tileAccessOrder.append(key);
+    m_tileCacheBytes += tile.sizeInBytes();
+    while (m_tileCacheBytes > m_maxTileCacheBytes && m_tileAccessOrder.size() > 1) {
+        const QImage evicted = m_tileCache.take(m_tileAccessOrder.takeFirst());
+        m_tileCacheBytes -= evicted.sizeInBytes();
+    }
+    MetricsRegistry::setGauge(MetricsRegistry::TileCacheBytes, m_tileCacheBytes);
+    if (m_memoryGovernor) {
+        m_memoryGovernor->requestCheck();
+    }
+}
+
+QVariantList ImageLoaderManager::getVisibleTiles(const QString &imageType, int frameNumber, qreal scale,
+                                                 qreal x, qreal y, qreal width, qreal height)
+{
+    QVariantList result;
+    const QSize imageSize = getImageSize(imageType, frameNumber);
+    if (!imageSize.isValid()) {
+        return result;
+    }
+
+    const int level = TilePyramid::levelForScale(scale, TilePyramid::levelCount(imageSize));
+    const QVector<TileId> tiles = TilePyramid::visibleTiles(imageSize, level, QRectF(x, y, width, height));
+    for (const TileId &tile : tiles) {
+        QVariantMap entry;
+        entry["source"] = QString("image://tiles/%1/%2/%3/%4/%5")
+                              .arg(imageType).arg(frameNumber).arg(tile.level).arg(tile.column).arg(tile.row);
+        entry["level"] = tile.level;
+        entry["x"] = tile.sourceRect.x();
+        entry["y"] = tile.sourceRect.y();
+        entry["width"] = tile.sourceRect.width();
+        entry["height"] = tile.sourceRect.height();
+        result.append(entry);
+    }
+    return result;
+}
+
+void ImageLoaderManager::setMaxTileCacheMegabytes(int megabytes)
+{
+    if (megabytes < 0) {
+        DEBUG_LOG("ImageLoaderManager") << "setMaxTileCacheMegabytes - Invalid size:" << megabytes << "(must be >= 0)";
+        return;
+    }
+    QMutexLocker locker(&m_tileMutex);
+    m_maxTileCacheBytes = static_cast<qint64>(megabytes) * 1024 * 1024;
+    while (m_tileCacheBytes > m_maxTileCacheBytes && !m_tileAccessOrder.isEmpty()) {
+        const QImage evicted = m_tileCache.take(m_tileAccessOrder.takeFirst());
+        m_tileCacheBytes -= evicted.sizeInBytes();
+    }
+    MetricsRegistry::setGauge(MetricsRegistry::TileCacheBytes, m_tileCacheBytes);
+}
+
+int ImageLoaderManager::getTileCacheSize() const
+{
+    QMutexLocker locker(&m_tileMutex);
+    return m_tileCache.size();
+}
+
 bool ImageLoaderManager::getImageTypePathAndExtension(const QString &imageType, QString &basePath, QString &extension) const
 {
+    // Extensions detected by setImagePaths(); JPEG renders and PNG alpha images by default
     if (imageType == "A") {
         basePath = m_pathA;
-        extension = ".jpg";
+        extension = m_extensions.value(imageType, QStringLiteral(".jpg"));
         return true;
     } else if (imageType == "B") {
         basePath = m_pathB;
-        extension = ".jpg";
+        extension = m_extensions.value(imageType, QStringLiteral(".jpg"));
         return true;
     } else if (imageType == "C") {
         basePath = m_pathC;
-        extension = ".jpg";
+        extension = m_extensions.value(imageType, QStringLiteral(".jpg"));
         return true;
     } else if (imageType == "D") {
         basePath = m_pathD;
-        extension = ".png";  // Alpha images are PNG
+        extension = m_extensions.value(imageType, QStringLiteral(".png"));  // Alpha images are PNG
         return true;
     }
     return false;
 }
 
+bool ImageLoaderManager::isHighBitDepth(const QString &imageType) const
+{
+    return m_highBitDepthTypes.contains(imageType);
+}
+
 QString ImageLoaderManager::getCacheKey(const QString &imageType, int frameNumber) const
 {
     // Format: "A_0001", "B_0002", etc.
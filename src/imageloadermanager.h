@@ -4,13 +4,20 @@
 #include <QObject>
 #include <QString>
 #include <QPixmap>
+#include <QImage>
+#include <QSize>
+#include <QVariantList>
 #include <QHash>
+#include <QSet>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QThreadPool>
 #include <QRunnable>
 #include <QDebug>
 #include "logger.h"
 
+class MemoryGovernor;
+
 /**
  * @brief ImageLoaderManager - Manages image paths and provides file paths to QML
  * 
@@ -27,6 +34,10 @@
  * - Leverages QML's optimized native image loading
  * - No memory storage in C++ (images loaded on-demand by QML)
  * - Synchronous loading provides immediate display during scrubbing
+ *
+ * Zoomed-in panes are the exception: they show tiles of an on-demand image pyramid
+ * (see TilePyramid), decoded here only for the visible area and kept in a byte-limited
+ * LRU tile cache, and served to QML through the "tiles" image provider.
  */
 class ImageLoaderManager : public QObject
 {
@@ -42,6 +53,9 @@ public:
      * @param pathB - Base path for test images (image type B)
      * @param pathC - Base path for diff images (image type C)
      * @param pathD - Base path for alpha images (image type D)
+     *
+     * Also detects each type's frame format: .jpg (.png for D) unless the folder only has
+     * .png, .tif/.tiff or .exr frames, as written by high-bit-depth renderers.
      */
     Q_INVOKABLE void setImagePaths(const QString &pathA, const QString &pathB, const QString &pathC, const QString &pathD);
 
@@ -61,6 +75,75 @@ public:
      */
     Q_INVOKABLE QString getImageFilePath(const QString &imageType, int frameNumber) const;
 
+    /**
+     * @brief Get the native file path for an image (for C++ decoders)
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @return Native file path without file:/// prefix, or empty string if the type or base path is invalid
+     */
+    QString getImageDiskPath(const QString &imageType, int frameNumber) const;
+
+    /**
+     * @brief Get the full-resolution size of an image without decoding it
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @return Image size, or invalid size if the file can't be read
+     */
+    Q_INVOKABLE QSize getImageSize(const QString &imageType, int frameNumber);
+
+    /**
+     * @brief Get one tile of a frame's image pyramid, decoding it if not cached
+     *
+     * Thread-safe; called from QML's image loader threads through TileImageProvider.
+     * Formats that can't clip while decoding (PNG, TIFF, EXR) decode the whole level
+     * once and cache all of its tiles; other threads wanting a tile of that level wait.
+     *
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @param level - Pyramid level (0 = full resolution)
+     * @param column - Tile column
+     * @param row - Tile row
+     * @return Tile image, or null image if the frame or tile doesn't exist
+     */
+    QImage getTile(const QString &imageType, int frameNumber, int level, int column, int row);
+
+    /**
+     * @brief Tiles needed to show part of a frame at a display scale
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @param scale - Screen pixels per full-resolution image pixel
+     * @param x - Visible area left, in full-resolution image pixels
+     * @param y - Visible area top
+     * @param width - Visible area width
+     * @param height - Visible area height
+     * @return List of maps {source, level, x, y, width, height}; source is an image://tiles URL,
+     *         x/y/width/height the area the tile covers in full-resolution image pixels
+     */
+    Q_INVOKABLE QVariantList getVisibleTiles(const QString &imageType, int frameNumber, qreal scale,
+                                             qreal x, qreal y, qreal width, qreal height);
+
+    /**
+     * @brief Set the tile cache budget
+     * @param megabytes - Maximum decoded tile memory (default: 96 MB, 0 = tiles are not cached)
+     */
+    Q_INVOKABLE void setMaxTileCacheMegabytes(int megabytes);
+
+    /**
+     * @brief Get the number of tiles currently cached
+     */
+    int getTileCacheSize() const;
+
+    /**
+     * @brief Register the image and tile caches with a memory governor
+     * @param governor - Governor to report to and release memory for, or nullptr to unregister
+     */
+    void setMemoryGovernor(MemoryGovernor *governor);
+
+    /**
+     * @brief Get the decoded size of the cached images in bytes
+     */
+    qint64 getCacheBytes() const { QMutexLocker locker(&m_cacheMutex); return m_cacheBytes; }
+
     /**
      * @brief Get image only if it's already cached (doesn't load from disk)
      * @param imageType - Image type: "A", "B", "C", or "D"
@@ -134,6 +217,17 @@ public:
      * @return true if imageType is valid, false otherwise
      */
     bool getImageTypePathAndExtension(const QString &imageType, QString &basePath, QString &extension) const;
+
+    /**
+     * @brief Whether an image type's frames have more than 8 bits per channel (e.g. 16-bit PNG)
+     *
+     * Detected by setImagePaths() from the first frame's header. Such frames are decoded to
+     * QImage::Format_RGBA64 by FrameRing and region decodes; the pixmap cache holds display
+     * (8-bit) copies only.
+     *
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     */
+    Q_INVOKABLE bool isHighBitDepth(const QString &imageType) const;
     
     /**
      * @brief Get maximum cache size
@@ -162,6 +256,11 @@ signals:
      */
     void errorOccurred(const QString &errorMessage);
 
+    /**
+     * @brief Emitted when setImagePaths() switched to a new event (decoded frames are stale)
+     */
+    void imagePathsChanged();
+
 private:
     /**
      * @brief Load image from disk synchronously
@@ -186,6 +285,10 @@ private:
     QString m_pathC;  // diff images
     QString m_pathD;  // alpha images
 
+    // Frame file extension per image type and types with 16-bit frames, detected by setImagePaths()
+    QHash<QString, QString> m_extensions;
+    QSet<QString> m_highBitDepthTypes;
+
     // Image cache: key = "A_0001", value = QPixmap
     QHash<QString, QPixmap> m_cache;
     
@@ -193,8 +296,11 @@ private:
     // Mutable because updating access order is a logical const operation (doesn't change observable cache state)
     mutable QStringList m_cacheAccessOrder;
     
-    // Maximum cache size (default: 20 images = ~120MB for 1920x1080)
+    // Maximum cache size in images; the memory governor may keep fewer
     int m_maxCacheSize;
+
+    // Decoded size of m_cache (width * height * depth)
+    qint64 m_cacheBytes;
     
     // Mutex for thread-safe cache access
     mutable QMutex m_cacheMutex;
@@ -203,9 +309,42 @@ private:
     QThreadPool *m_threadPool;
     
     /**
-     * @brief Evict oldest images from cache if over limit
+     * @brief Evict oldest images from cache if over limit (caller holds m_cacheMutex)
      */
     void evictOldestIfNeeded();
+
+    /**
+     * @brief Evict least recently used images / tiles (MemoryGovernor release callbacks)
+     * @param bytes - Bytes to free
+     * @return Bytes freed
+     */
+    qint64 releaseImageCache(qint64 bytes);
+    qint64 releaseTileCache(qint64 bytes);
+
+    /**
+     * @brief Look up a tile, waiting while another thread decodes its level (m_tileMutex held)
+     * @return true and the tile if cached
+     */
+    bool waitForTile(const QString &key, const QString &levelKey, QImage &tile);
+
+    /**
+     * @brief Add a tile to the LRU tile cache, evicting the oldest (m_tileMutex held)
+     */
+    void insertTile(const QString &key, const QImage &tile);
+
+    // Tile cache: key = "<file path>#<level>/<column>/<row>", evicted by decoded size
+    QHash<QString, QImage> m_tileCache;
+    QStringList m_tileAccessOrder;  // Most recent at end
+    qint64 m_tileCacheBytes;
+    qint64 m_maxTileCacheBytes;
+    QHash<QString, QSize> m_imageSizes;  // File path -> full-resolution size
+    QSet<QString> m_decodingLevels;      // "<file path>#<level>" being decoded whole
+    QWaitCondition m_levelDecoded;
+    mutable QMutex m_tileMutex;
+
+    MemoryGovernor *m_memoryGovernor;
+    int m_imageConsumerId;
+    int m_tileConsumerId;
 };
 
 /**
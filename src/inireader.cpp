@@ -12,6 +12,8 @@
 IniReader::IniReader(QObject *parent)
     : QObject(parent)
     , m_isValid(false)
+    , m_memoryBudgetMB(1024)
+    , m_minAvailableMemoryMB(256)
 {
 }
 
@@ -194,6 +196,16 @@ bool IniReader::parseINIFile(const QString &filePath)
     m_freedviewVer = settings.value("freedviewVer", "").toString();
     settings.endGroup();
 
+    // Optional [memory] section - cache budget (see MemoryGovernor)
+    settings.beginGroup("memory");
+    bool ok = false;
+    const int budgetMB = settings.value("budgetMB", 1024).toInt(&ok);
+    m_memoryBudgetMB = ok && budgetMB >= 0 ? budgetMB : 1024;
+    const int minAvailableMB = settings.value("minAvailableMB", 256).toInt(&ok);
+    m_minAvailableMemoryMB = ok && minAvailableMB >= 0 ? minAvailableMB : 256;
+    settings.endGroup();
+    DEBUG_LOG("IniReader") << "memory budget:" << m_memoryBudgetMB << "MB, min available:" << m_minAvailableMemoryMB << "MB";
+
         // Resolve freeDViewTesterPath (allow relative paths)
         if (!testerPathValue.isEmpty()) {
             if (QDir::isRelativePath(testerPathValue)) {
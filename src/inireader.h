@@ -19,6 +19,8 @@ class IniReader : public QObject
     Q_PROPERTY(QString freeDViewTesterPath READ freeDViewTesterPath NOTIFY pathsChanged)
     Q_PROPERTY(QString iniFilePath READ iniFilePath NOTIFY pathsChanged)
     Q_PROPERTY(bool isValid READ isValid NOTIFY pathsChanged)
+    Q_PROPERTY(int memoryBudgetMB READ memoryBudgetMB NOTIFY pathsChanged)
+    Q_PROPERTY(int minAvailableMemoryMB READ minAvailableMemoryMB NOTIFY pathsChanged)
 
 public:
     explicit IniReader(QObject *parent = nullptr);
@@ -61,6 +63,16 @@ public:
      */
     bool isValid() const { return m_isValid; }
 
+    /**
+     * @brief Memory budget for all caches together ([memory] budgetMB, default 1024, 0 = unlimited)
+     */
+    int memoryBudgetMB() const { return m_memoryBudgetMB; }
+
+    /**
+     * @brief Free system memory below which caches shrink ([memory] minAvailableMB, default 256, 0 = ignore)
+     */
+    int minAvailableMemoryMB() const { return m_minAvailableMemoryMB; }
+
     /**
      * @brief Find all compareResult.xml files in the results path
      * @return List of XML file paths
@@ -106,6 +118,8 @@ private:
     QString m_freeDViewTesterPath;
     QString m_iniFilePath;
     bool m_isValid;
+    int m_memoryBudgetMB;
+    int m_minAvailableMemoryMB;
 };
 
 #endif // INIREADER_H
@@ -0,0 +1,399 @@
+#include "logarchive.h"
+#include "logger.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <cstring>
+
+namespace {
+
+// Longer words are not indexed (hashes, paths without separators); their lines are always candidates
+const int kMaxTokenLength = 64;
+
+// Lines confirmed per read lock, so append() on the GUI thread never waits long
+const int kVerifyChunk = 4096;
+
+// Indexed words matched against a query word per read lock (a long session holds 100k+)
+const int kTokenScanChunk = 4096;
+
+QStringList splitTokens(const QString &text, bool *hasLongWord)
+{
+    QStringList tokens;
+    const QString lower = text.toLower();
+    int start = -1;
+    for (int i = 0; i <= lower.size(); ++i) {
+        const bool wordChar = i < lower.size() && lower.at(i).isLetterOrNumber();
+        if (wordChar) {
+            if (start < 0) {
+                start = i;
+            }
+            continue;
+        }
+        if (start < 0) {
+            continue;
+        }
+        const int length = i - start;
+        if (length > kMaxTokenLength) {
+            if (hasLongWord) {
+                *hasLongWord = true;
+            }
+        } else if (length >= 2) {
+            const QString token = lower.mid(start, length);
+            if (!tokens.contains(token)) {
+                tokens.append(token);
+            }
+        }
+        start = -1;
+    }
+    return tokens;
+}
+
+} // namespace
+
+LogArchive::Query LogArchive::Query::parse(const QString &input, unsigned levelMask)
+{
+    Query query;
+    query.levelMask = levelMask;
+    QStringList words;
+    for (const QString &word : input.split(' ', QString::SkipEmptyParts)) {
+        if (word.startsWith(QLatin1String("key:"), Qt::CaseInsensitive) && word.size() > 4) {
+            query.testKey = word.mid(4);
+        } else {
+            words.append(word);
+        }
+    }
+    query.text = words.join(' ');
+    return query;
+}
+
+LogArchive::LogArchive(qint64 segmentBytes)
+    : m_segmentBytes(qBound(qint64(4096), segmentBytes, qint64(1024) * 1024 * 1024))
+    , m_writable(false)
+{
+}
+
+LogArchive::~LogArchive()
+{
+    close();
+}
+
+bool LogArchive::open(const QString &directory, QString *errorString)
+{
+    close();
+
+    QWriteLocker locker(&m_lock);
+    if (!QDir().mkpath(directory)) {
+        if (errorString) {
+            *errorString = QString("Cannot create log archive directory %1").arg(directory);
+        }
+        return false;
+    }
+    m_directory = directory;
+    m_writable = openSegment(errorString);
+    return m_writable;
+}
+
+void LogArchive::close()
+{
+    QWriteLocker locker(&m_lock);
+    for (Segment &segment : m_segments) {
+        closeSegment(segment);
+    }
+    m_segments.clear();
+    m_writable = false;
+
+    // Without the mapped segments the lines can't be read back
+    m_lines.clear();
+    for (QVector<quint32> &postings : m_levelPostings) {
+        postings.clear();
+    }
+    m_testKeys.clear();
+    m_testKeyIds.clear();
+    m_testKeyPostings.clear();
+    m_tokens.clear();
+    m_tokenIds.clear();
+    m_tokenPostings.clear();
+    m_unindexedLines.clear();
+}
+
+bool LogArchive::isOpen() const
+{
+    QReadLocker locker(&m_lock);
+    return m_writable;
+}
+
+bool LogArchive::openSegment(QString *errorString)
+{
+    const QString path = QDir(m_directory).filePath(QString("segment-%1.log").arg(m_segments.size(), 4, 10, QChar('0')));
+    QFile *file = new QFile(path);
+
+    // Full size up front: appends are memcpy into the mapping, no write() per line
+    uchar *data = nullptr;
+    if (file->open(QIODevice::ReadWrite | QIODevice::Truncate) && file->resize(m_segmentBytes)) {
+        data = file->map(0, m_segmentBytes);
+    }
+    if (!data) {
+        const QString reason = QString("Cannot map log archive segment %1: %2").arg(path, file->errorString());
+        ERROR_LOG("LogArchive::openSegment -" << reason);
+        if (errorString) {
+            *errorString = reason;
+        }
+        file->remove();
+        delete file;
+        return false;
+    }
+    m_segments.append(Segment{file, data, 0});
+    return true;
+}
+
+void LogArchive::closeSegment(Segment &segment)
+{
+    segment.file->unmap(segment.data);
+    segment.file->resize(segment.used);  // Drop the unused tail
+    segment.file->close();
+    delete segment.file;
+    segment.file = nullptr;
+    segment.data = nullptr;
+}
+
+void LogArchive::append(qint64 timeMs, int level, const QString &testKey, const QString &message)
+{
+    level = qBound(0, level, LevelCount - 1);
+    const QByteArray header = QByteArray::number(timeMs) + '\t' + QByteArray::number(level) + '\t' + testKey.toUtf8() + '\t';
+    QByteArray messageUtf8 = message.toUtf8();
+    bool hasLongWord = false;
+    const QStringList tokens = splitTokens(message, &hasLongWord);
+
+    QWriteLocker locker(&m_lock);
+    if (!m_writable) {
+        return;
+    }
+
+    // A line never spans two segments
+    const qint64 maxMessageBytes = m_segmentBytes - header.size() - 1;
+    if (maxMessageBytes <= 0) {
+        return;
+    }
+    if (messageUtf8.size() > maxMessageBytes) {
+        messageUtf8.truncate(static_cast<int>(maxMessageBytes));
+    }
+    const qint64 lineBytes = header.size() + messageUtf8.size() + 1;
+    if (m_segments.last().used + lineBytes > m_segmentBytes && !openSegment(nullptr)) {
+        m_writable = false;  // Disk full or similar - keep what was archived so far
+        return;
+    }
+
+    Segment &segment = m_segments.last();
+    uchar *target = segment.data + segment.used;
+    std::memcpy(target, header.constData(), static_cast<size_t>(header.size()));
+    std::memcpy(target + header.size(), messageUtf8.constData(), static_cast<size_t>(messageUtf8.size()));
+    target[lineBytes - 1] = '\n';
+
+    LineRef ref;
+    ref.timeMs = timeMs;
+    ref.segment = static_cast<quint32>(m_segments.size() - 1);
+    ref.offset = static_cast<quint32>(segment.used);
+    ref.headerBytes = static_cast<quint32>(header.size());
+    ref.messageBytes = static_cast<quint32>(messageUtf8.size());
+    ref.testKeyId = 0;
+    ref.level = static_cast<quint8>(level);
+    segment.used += lineBytes;
+
+    // Index
+    const quint32 index = static_cast<quint32>(m_lines.size());
+    m_levelPostings[level].append(index);
+    if (!testKey.isEmpty()) {
+        quint32 &id = m_testKeyIds[testKey];
+        if (id == 0) {
+            m_testKeys.append(testKey);
+            m_testKeyPostings.append(QVector<quint32>());
+            id = static_cast<quint32>(m_testKeys.size());
+        }
+        ref.testKeyId = id;
+        m_testKeyPostings[static_cast<int>(id - 1)].append(index);
+    }
+    for (const QString &token : tokens) {
+        quint32 &id = m_tokenIds[token];
+        if (id == 0) {
+            m_tokens.append(token);
+            m_tokenPostings.append(QVector<quint32>());
+            id = static_cast<quint32>(m_tokens.size());
+        }
+        m_tokenPostings[static_cast<int>(id - 1)].append(index);
+    }
+    if (hasLongWord) {
+        m_unindexedLines.append(index);
+    }
+    m_lines.append(ref);
+}
+
+quint32 LogArchive::lineCount() const
+{
+    QReadLocker locker(&m_lock);
+    return static_cast<quint32>(m_lines.size());
+}
+
+int LogArchive::segmentCount() const
+{
+    QReadLocker locker(&m_lock);
+    return m_segments.size();
+}
+
+QString LogArchive::messageOf(const LineRef &ref) const
+{
+    const uchar *start = m_segments.at(static_cast<int>(ref.segment)).data + ref.offset + ref.headerBytes;
+    return QString::fromUtf8(reinterpret_cast<const char *>(start), static_cast<int>(ref.messageBytes));
+}
+
+bool LogArchive::line(quint32 index, Line &line) const
+{
+    QReadLocker locker(&m_lock);
+    if (index >= static_cast<quint32>(m_lines.size())) {
+        return false;
+    }
+    const LineRef &ref = m_lines.at(static_cast<int>(index));
+    line.timeMs = ref.timeMs;
+    line.level = ref.level;
+    line.testKey = ref.testKeyId ? m_testKeys.at(static_cast<int>(ref.testKeyId - 1)) : QString();
+    line.message = messageOf(ref);
+    return true;
+}
+
+void LogArchive::addPostings(QBitArray &bits, const QVector<quint32> &postings)
+{
+    const quint32 size = static_cast<quint32>(bits.size());
+    for (quint32 index : postings) {
+        if (index >= size) {
+            break;  // Appended after the search started
+        }
+        bits.setBit(static_cast<int>(index));
+    }
+}
+
+QVector<LogArchive::LineRange> LogArchive::search(const Query &query, const std::function<bool()> &isCanceled) const
+{
+    auto canceled = [&isCanceled]() { return isCanceled && isCanceled(); };
+
+    // 1. Narrow down with the index (lines appended meanwhile are not part of this search)
+    QBitArray candidates;
+    int size = 0;
+    {
+        QReadLocker locker(&m_lock);
+        size = m_lines.size();
+        candidates = QBitArray(size, true);
+
+        const unsigned allLevels = (1u << LevelCount) - 1;
+        if ((query.levelMask & allLevels) != allLevels) {
+            QBitArray levels(size);
+            for (int level = 0; level < LevelCount; ++level) {
+                if (query.levelMask & (1u << level)) {
+                    addPostings(levels, m_levelPostings[level]);
+                }
+            }
+            candidates &= levels;
+        }
+
+        if (!query.testKey.isEmpty()) {
+            const quint32 id = m_testKeyIds.value(query.testKey, 0);
+            if (id == 0) {
+                return QVector<LineRange>();
+            }
+            QBitArray testKeyLines(size);
+            addPostings(testKeyLines, m_testKeyPostings.at(static_cast<int>(id - 1)));
+            candidates &= testKeyLines;
+        }
+    }
+
+    // Each query word is part of some indexed word of a matching line. Words only get
+    // appended to m_tokens, so the scan goes on by index after each lock release.
+    for (const QString &token : splitTokens(query.text, nullptr)) {
+        QBitArray tokenLines(size);
+        int next = 0;
+        int tokenCount = 0;
+        do {
+            if (canceled()) {
+                return QVector<LineRange>();
+            }
+            QReadLocker locker(&m_lock);
+            if (m_lines.size() < size) {
+                return QVector<LineRange>();  // Closed meanwhile
+            }
+            if (next == 0) {
+                addPostings(tokenLines, m_unindexedLines);
+            }
+            tokenCount = m_tokens.size();
+            const int end = qMin(tokenCount, next + kTokenScanChunk);
+            for (; next < end; ++next) {
+                if (m_tokens.at(next).contains(token)) {
+                    addPostings(tokenLines, m_tokenPostings.at(next));
+                }
+            }
+        } while (next < tokenCount);
+        candidates &= tokenLines;
+    }
+
+    // 2. Confirm the candidates against the message text
+    if (!query.text.isEmpty()) {
+        int next = 0;
+        while (next < size) {
+            if (canceled()) {
+                return QVector<LineRange>();
+            }
+            QReadLocker locker(&m_lock);
+            if (m_lines.size() < size) {
+                return QVector<LineRange>();  // Closed meanwhile
+            }
+            const int end = qMin(size, next + kVerifyChunk);
+            for (; next < end; ++next) {
+                if (candidates.testBit(next) && !messageOf(m_lines.at(next)).contains(query.text, Qt::CaseInsensitive)) {
+                    candidates.clearBit(next);
+                }
+            }
+        }
+    }
+    return toRanges(candidates);
+}
+
+QVector<LogArchive::LineRange> LogArchive::toRanges(const QBitArray &bits)
+{
+    QVector<LineRange> ranges;
+    const int size = bits.size();
+    int index = 0;
+    while (index < size) {
+        if (!bits.testBit(index)) {
+            ++index;
+            continue;
+        }
+        const int first = index;
+        while (index < size && bits.testBit(index)) {
+            ++index;
+        }
+        ranges.append(LineRange{static_cast<quint32>(first), static_cast<quint32>(index - first)});
+    }
+    return ranges;
+}
+
+QStringList LogArchive::tokenize(const QString &text)
+{
+    return splitTokens(text, nullptr);
+}
+
+QString LogArchive::sessionDirectory(const QString &root)
+{
+    // Sorts by start time; the process id keeps two instances started in the same second apart
+    return QDir(root).filePath(QString("%1-%2").arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"))
+                                   .arg(QCoreApplication::applicationPid()));
+}
+
+void LogArchive::pruneSessions(const QString &root, int keep)
+{
+    const QDir rootDir(root);
+    const QStringList sessions = rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (int i = 0; i < sessions.size() - qMax(0, keep); ++i) {
+        if (!QDir(rootDir.filePath(sessions.at(i))).removeRecursively()) {
+            WARNING_LOG("LogArchive::pruneSessions - Cannot remove" << rootDir.filePath(sessions.at(i)));
+        }
+    }
+}
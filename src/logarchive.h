@@ -0,0 +1,170 @@
+#ifndef LOGARCHIVE_H
+#define LOGARCHIVE_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class QFile;
+
+/**
+ * @brief LogArchive - Complete, searchable log history of a session
+ *
+ * LogModel only holds the newest maxLogEntries lines; a multi-hour tester run
+ * produces far more. Every line is also appended here, into memory-mapped
+ * segment files ("segment-0000.log", ... rotated at segmentBytes) under the
+ * session directory, one "timeMs<TAB>level<TAB>testKey<TAB>message" line each.
+ *
+ * An in-memory index keeps, per line, where it is stored, plus posting lists
+ * (ascending line numbers) by level, by test key and by token (lowercased words
+ * of 2+ letters/digits). search() narrows the candidates with the index, then
+ * confirms them against the text, so it only reads the lines that can match.
+ *
+ * Thread safety: append() from one thread (LogModel drains on the GUI thread);
+ * search(), line() and lineCount() from any thread.
+ */
+class LogArchive
+{
+public:
+    static const int LevelCount = 4;  // LogModel::Level: Info, Warning, Error, Debug
+
+    struct Line {
+        qint64 timeMs = 0;
+        int level = 0;
+        QString testKey;
+        QString message;
+    };
+
+    /**
+     * @brief Consecutive matching lines [first, first + count)
+     */
+    struct LineRange {
+        quint32 first;
+        quint32 count;
+    };
+
+    struct Query {
+        QString text;                               // Case-insensitive substring of the message; empty = any
+        unsigned levelMask = (1u << LevelCount) - 1;  // Bit per level
+        QString testKey;                            // Exact test key; empty = any
+
+        /**
+         * @brief Query from search field input: "key:<testKey>" terms set testKey, the rest is text
+         * @param input - Search field text, e.g. "key:Soccer/Final/Set1/F0100 timeout"
+         * @param levelMask - Bit per level (from the level checkboxes)
+         */
+        static Query parse(const QString &input, unsigned levelMask);
+    };
+
+    /**
+     * @param segmentBytes - Size of each segment file (lines never span two segments)
+     */
+    explicit LogArchive(qint64 segmentBytes = 16 * 1024 * 1024);
+    ~LogArchive();
+
+    LogArchive(const LogArchive &) = delete;
+    LogArchive &operator=(const LogArchive &) = delete;
+
+    /**
+     * @brief Start a new archive in a directory (created if needed, existing segments overwritten)
+     * @param directory - Session directory
+     * @param errorString - Optional: reason on failure
+     * @return true if the first segment could be created and mapped
+     */
+    bool open(const QString &directory, QString *errorString = nullptr);
+
+    /**
+     * @brief Unmap the segments, trim them to their used size and drop the index
+     */
+    void close();
+
+    bool isOpen() const;
+    QString directory() const { return m_directory; }
+
+    /**
+     * @brief Append a line (ignored if the archive isn't open)
+     * @param timeMs - Milliseconds since epoch
+     * @param level - 0..LevelCount-1 (LogModel::Level)
+     * @param testKey - Test the line belongs to, or empty
+     * @param message - Message text (cut to fit one segment if larger)
+     */
+    void append(qint64 timeMs, int level, const QString &testKey, const QString &message);
+
+    quint32 lineCount() const;
+    int segmentCount() const;
+
+    /**
+     * @brief Read a line back from its segment
+     * @return false if index is out of range
+     */
+    bool line(quint32 index, Line &line) const;
+
+    /**
+     * @brief Lines matching a query, in order (any thread, concurrent with append())
+     * @param query - Filter
+     * @param isCanceled - Optional: polled while searching; returns empty ranges once true
+     * @return Matching lines as ranges of consecutive line numbers
+     */
+    QVector<LineRange> search(const Query &query, const std::function<bool()> &isCanceled = std::function<bool()>()) const;
+
+    /**
+     * @brief New session directory under a root: <root>/<yyyyMMdd-hhmmss>-<pid>
+     */
+    static QString sessionDirectory(const QString &root);
+
+    /**
+     * @brief Delete all but the newest session directories under a root
+     * @param root - Directory holding session directories
+     * @param keep - Sessions to keep
+     */
+    static void pruneSessions(const QString &root, int keep);
+
+    /**
+     * @brief Lowercased words of 2+ letters/digits, each once (what the token index holds)
+     */
+    static QStringList tokenize(const QString &text);
+
+private:
+    struct Segment {
+        QFile *file;
+        uchar *data;
+        qint64 used;
+    };
+
+    struct LineRef {
+        qint64 timeMs;
+        quint32 segment;
+        quint32 offset;      // Start of the line in the segment
+        quint32 headerBytes; // "time\tlevel\ttestKey\t"
+        quint32 messageBytes;
+        quint32 testKeyId;   // Index into m_testKeys + 1, 0 = none
+        quint8 level;
+    };
+
+    bool openSegment(QString *errorString);
+    void closeSegment(Segment &segment);
+    QString messageOf(const LineRef &ref) const;
+    static void addPostings(QBitArray &bits, const QVector<quint32> &postings);
+    static QVector<LineRange> toRanges(const QBitArray &bits);
+
+    const qint64 m_segmentBytes;
+    QString m_directory;
+
+    mutable QReadWriteLock m_lock;  // Guards everything below
+    QVector<Segment> m_segments;
+    bool m_writable;
+    QVector<LineRef> m_lines;
+    QVector<quint32> m_levelPostings[LevelCount];
+    QStringList m_testKeys;
+    QHash<QString, quint32> m_testKeyIds;
+    QVector<QVector<quint32>> m_testKeyPostings;
+    QStringList m_tokens;  // In first-seen order, so search() can scan them in chunks
+    QHash<QString, quint32> m_tokenIds;
+    QVector<QVector<quint32>> m_tokenPostings;
+    QVector<quint32> m_unindexedLines;  // Lines with words too long to index - always candidates
+};
+
+#endif // LOGARCHIVE_H
@@ -0,0 +1,330 @@
+#include "logmodel.h"
+#include "logarchive.h"
+#include <QClipboard>
+#include <QDebug>
+#include <QDateTime>
+#include <QGuiApplication>
+#include <QStringList>
+
+namespace {
+
+std::atomic<LogModel *> s_handlerModel(nullptr);
+QtMessageHandler s_previousHandler = nullptr;
+
+// Set while LogModel prints its own entries, which are in the model already
+thread_local bool t_printingOwnEntry = false;
+
+LogModel::Level levelOf(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return LogModel::Debug;
+    case QtWarningMsg:
+        return LogModel::Warning;
+    case QtCriticalMsg:
+    case QtFatalMsg:
+        return LogModel::Error;
+    case QtInfoMsg:
+    default:
+        return LogModel::Info;
+    }
+}
+
+void forwardMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    LogModel *model = s_handlerModel.load(std::memory_order_acquire);
+    if (model && !t_printingOwnEntry) {
+        model->append(levelOf(type), message);
+    }
+    if (s_previousHandler) {
+        s_previousHandler(type, context, message);
+    }
+}
+
+QString formatTime(qint64 timeMs)
+{
+    return QDateTime::fromMSecsSinceEpoch(timeMs).toString(QStringLiteral("hh:mm:ss.zzz"));
+}
+
+} // namespace
+
+LogModel::LogModel(int maxEntries, int pendingCapacity, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_pending(qMax(2, pendingCapacity))
+    , m_drainScheduled(false)
+    , m_dropped(0)
+    , m_droppedTotal(0)
+    , m_entries(qMax(1, maxEntries))
+    , m_firstSequence(0)
+    , m_count(0)
+    , m_levelMask((1u << Info) | (1u << Warning) | (1u << Error) | (1u << Debug))
+    , m_debugToConsole(true)
+    , m_archive(nullptr)
+{
+}
+
+LogModel::~LogModel()
+{
+    if (s_handlerModel.load() == this) {
+        installMessageHandler(nullptr);
+    }
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= count()) {
+        return QVariant();
+    }
+    const Entry &entry = entryAt(m_rows[static_cast<size_t>(index.row())]);
+    switch (role) {
+    case LevelRole:
+        return levelName(entry.level);
+    case MessageRole:
+        return entry.message;
+    case TimestampRole:
+        return formatTime(entry.timeMs);  // Only for the rows a view shows
+    case Qt::DisplayRole:
+        return formatLine(entry);
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LogModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[LevelRole] = "level";
+    roles[MessageRole] = "message";
+    roles[TimestampRole] = "timestamp";
+    return roles;
+}
+
+void LogModel::append(Level level, const QString &message)
+{
+    if (message.isEmpty()) {
+        return;
+    }
+    if (!m_pending.push(Entry{QDateTime::currentMSecsSinceEpoch(), level, message})) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);  // GUI thread too busy to drain - reported on the next drain
+    }
+    scheduleDrain();
+}
+
+void LogModel::log(const QString &level, const QString &message)
+{
+    const QString name = level.toUpper();
+    if (name == QLatin1String("WARNING")) {
+        logEntry(Warning, message);
+    } else if (name == QLatin1String("ERROR")) {
+        logEntry(Error, message);
+    } else if (name == QLatin1String("DEBUG")) {
+        logEntry(Debug, message);
+    } else {
+        logEntry(Info, message);
+    }
+}
+
+void LogModel::logEntry(Level level, const QString &message)
+{
+    if (message.isEmpty()) {
+        return;
+    }
+    append(level, message);
+
+    // Console: INFO, WARNING and ERROR always, DEBUG only if enabled (as Logger.qml did)
+    if (level != Debug || enableDebugConsoleOutput()) {
+        t_printingOwnEntry = true;
+        qInfo().noquote() << "[" + levelName(level) + "]" << formatTime(QDateTime::currentMSecsSinceEpoch()) << "-" << message;
+        t_printingOwnEntry = false;
+    }
+}
+
+void LogModel::scheduleDrain()
+{
+    // One queued drain per burst, however many threads are logging
+    if (!m_drainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+void LogModel::flush()
+{
+    // Entries pushed from here on schedule the next drain
+    m_drainScheduled.store(false, std::memory_order_release);
+
+    QVector<Entry> batch;
+    Entry entry;
+    while (batch.size() < m_pending.capacity() && m_pending.pop(entry)) {
+        batch.append(std::move(entry));
+    }
+    const int dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        m_droppedTotal += dropped;
+        batch.append(Entry{QDateTime::currentMSecsSinceEpoch(), Warning,
+                           QString("%1 log messages dropped (logged faster than they could be shown)").arg(dropped)});
+    }
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    // The archive keeps every entry, including those the history has no room for
+    if (m_archive) {
+        for (const Entry &drained : batch) {
+            m_archive->append(drained.timeMs, drained.level, m_currentTestKey, drained.message);
+        }
+    }
+
+    // A batch larger than the history only keeps its newest entries
+    const int capacity = m_entries.size();
+    const int firstKept = qMax(0, batch.size() - capacity);
+    const int incoming = batch.size() - firstKept;
+
+    // Make room: the oldest entries go, and with them their rows
+    const qint64 overflow = m_count + incoming - capacity;
+    if (overflow > 0) {
+        const qint64 newFirstSequence = m_firstSequence + overflow;
+        int removedRows = 0;
+        while (removedRows < count() && m_rows[static_cast<size_t>(removedRows)] < newFirstSequence) {
+            ++removedRows;
+        }
+        if (removedRows > 0) {
+            beginRemoveRows(QModelIndex(), 0, removedRows - 1);
+            m_rows.erase(m_rows.begin(), m_rows.begin() + removedRows);
+            endRemoveRows();
+        }
+        m_firstSequence = newFirstSequence;
+        m_count -= overflow;
+    }
+
+    // Store the batch, then insert the rows that pass the level filter in one go
+    QVector<qint64> shown;
+    const qint64 nextSequence = m_firstSequence + m_count;
+    for (int i = firstKept; i < batch.size(); ++i) {
+        const qint64 sequence = nextSequence + (i - firstKept);
+        Entry &slot = m_entries[static_cast<int>(sequence % capacity)];
+        slot = std::move(batch[i]);
+        if (isShown(slot.level)) {
+            shown.append(sequence);
+        }
+    }
+    m_count += incoming;
+    if (!shown.isEmpty()) {
+        beginInsertRows(QModelIndex(), count(), count() + shown.size() - 1);
+        m_rows.insert(m_rows.end(), shown.begin(), shown.end());
+        endInsertRows();
+    }
+
+    emit countChanged();
+    emit entriesAdded();
+
+    // More arrived than one drain takes - continue on the next event loop pass
+    if (batch.size() >= m_pending.capacity()) {
+        scheduleDrain();
+    }
+}
+
+void LogModel::clear()
+{
+    Entry entry;
+    while (m_pending.pop(entry)) {
+    }
+    m_dropped.store(0, std::memory_order_relaxed);
+
+    beginResetModel();
+    m_rows.clear();
+    m_firstSequence += m_count;
+    m_count = 0;
+    m_entries.fill(Entry{0, Info, QString()});  // Release the message strings
+    endResetModel();
+
+    emit countChanged();
+    emit logCleared();
+    logEntry(Info, QStringLiteral("Log cleared"));
+}
+
+QString LogModel::plainText() const
+{
+    QStringList lines;
+    lines.reserve(count());
+    for (qint64 sequence : m_rows) {
+        lines.append(formatLine(entryAt(sequence)));
+    }
+    return lines.join('\n');
+}
+
+void LogModel::copyToClipboard() const
+{
+    if (QClipboard *clipboard = QGuiApplication::clipboard()) {
+        clipboard->setText(plainText());
+    }
+}
+
+void LogModel::setEnableDebugConsoleOutput(bool enable)
+{
+    if (m_debugToConsole.exchange(enable) != enable) {
+        emit enableDebugConsoleOutputChanged();
+    }
+}
+
+void LogModel::setShown(Level level, bool show)
+{
+    if (isShown(level) == show) {
+        return;
+    }
+    if (show) {
+        m_levelMask |= (1u << level);
+    } else {
+        m_levelMask &= ~(1u << level);
+    }
+
+    // Rare (a checkbox) - rebuild the shown rows
+    beginResetModel();
+    m_rows.clear();
+    for (qint64 sequence = m_firstSequence; sequence < m_firstSequence + m_count; ++sequence) {
+        if (isShown(entryAt(sequence).level)) {
+            m_rows.push_back(sequence);
+        }
+    }
+    endResetModel();
+    emit filterChanged();
+    emit countChanged();
+}
+
+QString LogModel::levelName(Level level)
+{
+    switch (level) {
+    case Warning:
+        return QStringLiteral("WARNING");
+    case Error:
+        return QStringLiteral("ERROR");
+    case Debug:
+        return QStringLiteral("DEBUG");
+    case Info:
+    default:
+        return QStringLiteral("INFO");
+    }
+}
+
+QString LogModel::formatLine(const Entry &entry) const
+{
+    return QString("[%1] [%2] %3").arg(formatTime(entry.timeMs), levelName(entry.level), entry.message);
+}
+
+void LogModel::installMessageHandler(LogModel *model)
+{
+    if (model) {
+        s_handlerModel.store(model, std::memory_order_release);
+        if (!s_previousHandler) {
+            s_previousHandler = qInstallMessageHandler(forwardMessage);
+        }
+    } else if (s_previousHandler) {
+        qInstallMessageHandler(s_previousHandler);
+        s_previousHandler = nullptr;
+        s_handlerModel.store(nullptr, std::memory_order_release);
+    }
+}
@@ -0,0 +1,191 @@
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <deque>
+#include "mpmcring.h"
+
+class LogArchive;
+
+/**
+ * @brief LogModel - Application log ("Logger" QML singleton) and LogWindow list model
+ *
+ * Replaces Logger.qml, which kept the entries in a JS array (shift() per message
+ * once full) and had LogWindow re-format the whole buffer as HTML for every message.
+ *
+ * Any thread can log: append() only pushes into a lock-free MpmcRing; the GUI thread
+ * drains it in batches (one queued call per burst), stores the entries in a fixed-size
+ * circular history and inserts just the new rows. Timestamps are formatted only for
+ * the rows a view asks for, so the log window renders the visible lines only.
+ *
+ * Sources: QML (Logger.info() etc.), freeDView_tester output lines, and - through
+ * installMessageHandler() - qDebug/qInfo/qWarning/qCritical from C++ on any thread.
+ *
+ * With an archive set, every drained entry is also appended to the LogArchive, which
+ * keeps the whole session (searchable through LogSearchModel) after it left the history.
+ *
+ * Roles: level ("INFO", "WARNING", "ERROR", "DEBUG"), message, timestamp ("hh:mm:ss.zzz").
+ */
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int totalCount READ totalCount NOTIFY countChanged)
+    Q_PROPERTY(int maxLogEntries READ maxLogEntries CONSTANT)
+    Q_PROPERTY(int droppedCount READ droppedCount NOTIFY countChanged)
+    Q_PROPERTY(bool showInfo READ showInfo WRITE setShowInfo NOTIFY filterChanged)
+    Q_PROPERTY(bool showWarning READ showWarning WRITE setShowWarning NOTIFY filterChanged)
+    Q_PROPERTY(bool showError READ showError WRITE setShowError NOTIFY filterChanged)
+    Q_PROPERTY(bool showDebug READ showDebug WRITE setShowDebug NOTIFY filterChanged)
+    Q_PROPERTY(bool enableDebugConsoleOutput READ enableDebugConsoleOutput WRITE setEnableDebugConsoleOutput NOTIFY enableDebugConsoleOutputChanged)
+
+public:
+    enum Level {
+        Info = 0,
+        Warning,
+        Error,
+        Debug
+    };
+    Q_ENUM(Level)
+
+    enum Roles {
+        LevelRole = Qt::UserRole + 1,
+        MessageRole,
+        TimestampRole
+    };
+
+    struct Entry {
+        qint64 timeMs;  // Milliseconds since epoch
+        Level level;
+        QString message;
+    };
+
+    /**
+     * @param maxEntries - Entries kept in the history (oldest are dropped)
+     * @param pendingCapacity - Entries that can wait for the GUI thread before new ones are dropped
+     */
+    explicit LogModel(int maxEntries = 10000, int pendingCapacity = 8192, QObject *parent = nullptr);
+    ~LogModel();
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    /**
+     * @brief Add an entry (thread-safe, lock-free, not printed); the row appears on the next drain
+     * @param level - Log level
+     * @param message - Message text (empty messages are ignored)
+     */
+    void append(Level level, const QString &message);
+
+    /**
+     * @brief Log from QML: Logger.log("WARNING", "...")
+     * @param level - "INFO", "WARNING", "ERROR" or "DEBUG" (anything else = INFO)
+     */
+    Q_INVOKABLE void log(const QString &level, const QString &message);
+    Q_INVOKABLE void info(const QString &message) { logEntry(Info, message); }
+    Q_INVOKABLE void warning(const QString &message) { logEntry(Warning, message); }
+    Q_INVOKABLE void error(const QString &message) { logEntry(Error, message); }
+    Q_INVOKABLE void debug(const QString &message) { logEntry(Debug, message); }
+
+    /**
+     * @brief Remove all entries
+     */
+    Q_INVOKABLE void clear();
+
+    /**
+     * @brief Move pending entries into the model now (GUI thread; normally automatic)
+     */
+    Q_INVOKABLE void flush();
+
+    /**
+     * @brief Shown entries as plain text ("[time] [LEVEL] message" per line)
+     */
+    Q_INVOKABLE QString plainText() const;
+
+    /**
+     * @brief Copy the shown entries to the clipboard
+     */
+    Q_INVOKABLE void copyToClipboard() const;
+
+    int count() const { return static_cast<int>(m_rows.size()); }
+    int totalCount() const { return static_cast<int>(m_count); }
+    int maxLogEntries() const { return m_entries.size(); }
+    int droppedCount() const { return m_droppedTotal; }
+    bool showInfo() const { return isShown(Info); }
+    void setShowInfo(bool show) { setShown(Info, show); }
+    bool showWarning() const { return isShown(Warning); }
+    void setShowWarning(bool show) { setShown(Warning, show); }
+    bool showError() const { return isShown(Error); }
+    void setShowError(bool show) { setShown(Error, show); }
+    bool showDebug() const { return isShown(Debug); }
+    void setShowDebug(bool show) { setShown(Debug, show); }
+    bool enableDebugConsoleOutput() const { return m_debugToConsole.load(std::memory_order_relaxed); }
+    void setEnableDebugConsoleOutput(bool enable);
+
+    static QString levelName(Level level);
+
+    /**
+     * @brief Also store every entry in an archive (GUI thread; nullptr = none)
+     */
+    void setArchive(LogArchive *archive) { m_archive = archive; }
+
+    /**
+     * @brief Test that entries drained from now on belong to, in the archive (GUI thread; empty = none)
+     * @param testKey - Test key, e.g. "SportType/Event/Set/F####"
+     */
+    void setCurrentTestKey(const QString &testKey) { m_currentTestKey = testKey; }
+
+    /**
+     * @brief Route Qt messages (qDebug() ... qCritical(), from any thread) into a model
+     *
+     * Messages still go to the previous handler (console) as well.
+     * @param model - Receiving model, or nullptr to restore the previous handler
+     */
+    static void installMessageHandler(LogModel *model);
+
+signals:
+    void countChanged();
+    void filterChanged();
+    void enableDebugConsoleOutputChanged();
+
+    /**
+     * @brief New rows were added (once per drained batch)
+     */
+    void entriesAdded();
+
+    void logCleared();
+
+private:
+    /**
+     * @brief Add an entry and print it to the console (QML and tester output)
+     */
+    void logEntry(Level level, const QString &message);
+    bool isShown(Level level) const { return (m_levelMask & (1u << level)) != 0; }
+    void setShown(Level level, bool show);
+    void scheduleDrain();
+    const Entry &entryAt(qint64 sequence) const { return m_entries.at(static_cast<int>(sequence % m_entries.size())); }
+    QString formatLine(const Entry &entry) const;
+
+    MpmcRing<Entry> m_pending;
+    std::atomic<bool> m_drainScheduled;
+    std::atomic<int> m_dropped;  // Entries lost because m_pending was full (since the last drain)
+    int m_droppedTotal;
+
+    // History: circular buffer of the newest entries, addressed by sequence number
+    QVector<Entry> m_entries;
+    qint64 m_firstSequence;  // Sequence number of the oldest entry held
+    qint64 m_count;          // Entries held
+    std::deque<qint64> m_rows;  // Sequence numbers of the shown (level-filtered) entries
+    unsigned m_levelMask;
+    std::atomic<bool> m_debugToConsole;
+
+    LogArchive *m_archive;
+    QString m_currentTestKey;
+};
+
+#endif // LOGMODEL_H
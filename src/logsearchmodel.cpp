@@ -0,0 +1,177 @@
+#include "logsearchmodel.h"
+#include "logmodel.h"
+#include "logger.h"
+#include <QClipboard>
+#include <QDateTime>
+#include <QGuiApplication>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+QString formatTime(qint64 timeMs)
+{
+    return QDateTime::fromMSecsSinceEpoch(timeMs).toString(QStringLiteral("hh:mm:ss.zzz"));
+}
+
+} // namespace
+
+LogSearchModel::LogSearchModel(LogArchive *archive, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_archive(archive)
+    , m_watcher(new QFutureWatcher<QVector<LogArchive::LineRange>>(this))
+    , m_generation(0)
+    , m_runningGeneration(-1)
+    , m_count(0)
+    , m_active(false)
+    , m_cachedRow(-1)
+{
+    // One search at a time; a superseded one stops at its next cancel check
+    m_pool.setMaxThreadCount(1);
+    connect(m_watcher, &QFutureWatcherBase::finished, this, &LogSearchModel::onSearchFinished);
+}
+
+LogSearchModel::~LogSearchModel()
+{
+    ++m_generation;  // Cancel
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+int LogSearchModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogSearchModel::data(const QModelIndex &index, int role) const
+{
+    LogArchive::Line line;
+    if (!index.isValid() || !lineForRow(index.row(), line)) {
+        return QVariant();
+    }
+    switch (role) {
+    case LevelRole:
+        return LogModel::levelName(static_cast<LogModel::Level>(line.level));
+    case MessageRole:
+        return line.message;
+    case TimestampRole:
+        return formatTime(line.timeMs);
+    case TestKeyRole:
+        return line.testKey;
+    case Qt::DisplayRole:
+        return QString("[%1] [%2] %3").arg(formatTime(line.timeMs), LogModel::levelName(static_cast<LogModel::Level>(line.level)), line.message);
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LogSearchModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[LevelRole] = "level";
+    roles[MessageRole] = "message";
+    roles[TimestampRole] = "timestamp";
+    roles[TestKeyRole] = "testKey";
+    return roles;
+}
+
+void LogSearchModel::search(const QString &text, int levelMask)
+{
+    const LogArchive::Query query = LogArchive::Query::parse(text, static_cast<unsigned>(levelMask));
+    if (query.text.isEmpty() && query.testKey.isEmpty()) {
+        clear();
+        return;
+    }
+
+    const int generation = ++m_generation;
+    m_runningGeneration = generation;
+    LogArchive *archive = m_archive;
+    std::atomic<int> *latestGeneration = &m_generation;
+    QFuture<QVector<LogArchive::LineRange>> future = QtConcurrent::run(&m_pool, [archive, query, generation, latestGeneration]() {
+        return archive->search(query, [generation, latestGeneration]() {
+            return latestGeneration->load(std::memory_order_relaxed) != generation;
+        });
+    });
+    m_watcher->setFuture(future);
+    emit searchingChanged();
+}
+
+void LogSearchModel::clear()
+{
+    ++m_generation;
+    m_runningGeneration = -1;
+    setResults(QVector<LogArchive::LineRange>(), false);
+    emit searchingChanged();
+}
+
+void LogSearchModel::onSearchFinished()
+{
+    emit searchingChanged();
+
+    // Cleared (or superseded) while running - the result is empty or stale
+    if (m_runningGeneration != m_generation.load()) {
+        return;
+    }
+    m_runningGeneration = -1;
+    setResults(m_watcher->result(), true);
+    DEBUG_LOG("LogSearchModel") << "onSearchFinished -" << m_count << "matching lines in" << m_ranges.size() << "ranges";
+}
+
+void LogSearchModel::setResults(const QVector<LogArchive::LineRange> &ranges, bool active)
+{
+    beginResetModel();
+    m_ranges = ranges;
+    m_rangeRows.clear();
+    m_rangeRows.reserve(ranges.size());
+    m_count = 0;
+    for (const LogArchive::LineRange &range : ranges) {
+        m_rangeRows.append(m_count);
+        m_count += static_cast<int>(range.count);
+    }
+    m_active = active;
+    m_cachedRow = -1;
+    endResetModel();
+    emit resultsChanged();
+}
+
+int LogSearchModel::lineAt(int row) const
+{
+    if (row < 0 || row >= m_count) {
+        return -1;
+    }
+    // Last range starting at or before the row
+    const int range = static_cast<int>(std::upper_bound(m_rangeRows.cbegin(), m_rangeRows.cend(), row) - m_rangeRows.cbegin()) - 1;
+    return static_cast<int>(m_ranges.at(range).first) + (row - m_rangeRows.at(range));
+}
+
+bool LogSearchModel::lineForRow(int row, LogArchive::Line &line) const
+{
+    if (row == m_cachedRow) {
+        line = m_cachedLine;
+        return true;
+    }
+    const int lineNumber = lineAt(row);
+    if (lineNumber < 0 || !m_archive->line(static_cast<quint32>(lineNumber), line)) {
+        return false;
+    }
+    m_cachedRow = row;
+    m_cachedLine = line;
+    return true;
+}
+
+QString LogSearchModel::plainText() const
+{
+    QStringList lines;
+    lines.reserve(m_count);
+    for (int row = 0; row < m_count; ++row) {
+        lines.append(data(index(row), Qt::DisplayRole).toString());
+    }
+    return lines.join('\n');
+}
+
+void LogSearchModel::copyToClipboard() const
+{
+    if (QClipboard *clipboard = QGuiApplication::clipboard()) {
+        clipboard->setText(plainText());
+    }
+}
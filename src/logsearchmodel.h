@@ -0,0 +1,99 @@
+#ifndef LOGSEARCHMODEL_H
+#define LOGSEARCHMODEL_H
+
+#include <QAbstractListModel>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include "logarchive.h"
+
+/**
+ * @brief LogSearchModel - Search results over the whole LogArchive ("logSearch" in QML)
+ *
+ * search() runs LogArchive::search() on a background thread; a newer search
+ * cancels the running one. Results are kept as line ranges and rows read their
+ * line from the archive only when a view asks for them, so a search matching
+ * hundreds of thousands of lines costs a few bytes per range.
+ *
+ * Roles match LogModel (level, message, timestamp) plus testKey, so LogWindow
+ * uses the same delegate for live entries and search results.
+ */
+class LogSearchModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY resultsChanged)
+    Q_PROPERTY(bool active READ active NOTIFY resultsChanged)
+    Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged)
+
+public:
+    enum Roles {
+        LevelRole = Qt::UserRole + 1,
+        MessageRole,
+        TimestampRole,
+        TestKeyRole
+    };
+
+    explicit LogSearchModel(LogArchive *archive, QObject *parent = nullptr);
+    ~LogSearchModel();
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    /**
+     * @brief Search the archive (asynchronous; resultsChanged when done)
+     * @param text - Search field input, see LogArchive::Query::parse(); empty = no search (active false)
+     * @param levelMask - Bit per LogModel::Level
+     */
+    Q_INVOKABLE void search(const QString &text, int levelMask);
+
+    /**
+     * @brief Drop the results and cancel a running search
+     */
+    Q_INVOKABLE void clear();
+
+    /**
+     * @brief Results as plain text ("[time] [LEVEL] message" per line)
+     */
+    Q_INVOKABLE QString plainText() const;
+    Q_INVOKABLE void copyToClipboard() const;
+
+    int count() const { return m_count; }
+    bool active() const { return m_active; }
+    bool searching() const { return m_watcher->isRunning(); }
+
+    /**
+     * @brief Archive line number shown in a row, or -1
+     */
+    int lineAt(int row) const;
+
+signals:
+    void resultsChanged();
+    void searchingChanged();
+
+private slots:
+    void onSearchFinished();
+
+private:
+    void setResults(const QVector<LogArchive::LineRange> &ranges, bool active);
+    bool lineForRow(int row, LogArchive::Line &line) const;
+
+    LogArchive *m_archive;
+    QThreadPool m_pool;
+    QFutureWatcher<QVector<LogArchive::LineRange>> *m_watcher;
+    std::atomic<int> m_generation;  // Bumped per search / clear; older searches cancel themselves
+    int m_runningGeneration;
+
+    QVector<LogArchive::LineRange> m_ranges;
+    QVector<int> m_rangeRows;  // First row of each range
+    int m_count;
+    bool m_active;
+
+    // Several roles of one row are asked for in a row
+    mutable int m_cachedRow;
+    mutable LogArchive::Line m_cachedLine;
+};
+
+#endif // LOGSEARCHMODEL_H
@@ -13,14 +13,18 @@
 ** - Create and configure backend services (IniReader, XmlDataModel, etc.)
 ** - Expose services to QML via context properties
 ** - Load and display Main.qml as the root component
+** - With --headless: write a batch triage report instead (see HeadlessReport)
 **
 ****************************************************************************/
 
 #include <QtWidgets/QApplication>
+#include <QtCore/QCoreApplication>
 #include <QtQml/QQmlContext>
 #include <QtQuick/QQuickView>
 #include <QtQml/QQmlEngine>
 #include <QtCore/QDir>
+#include <QtCore/QDateTime>
+#include <QtCore/QStandardPaths>
 #include <QtQml/qqml.h>
 
 #include "inireader.h"
@@ -28,13 +32,115 @@
 #include "xmldatamodel.h"
 #include "freeDView_tester_runner.h"
 #include "imageloadermanager.h"
+#include "timelineseriesfeeder.h"
+#include "playbackengine.h"
+#include "frameimageprovider.h"
+#include "framesetpresenter.h"
+#include "proxybuilder.h"
+#include "proxyimageprovider.h"
+#include "abcompositoritem.h"
+#include "tileimageprovider.h"
+#include "tracer.h"
+#include "metricsregistry.h"
+#include "headlessreport.h"
+#include "logmodel.h"
+#include "logarchive.h"
+#include "logsearchmodel.h"
+#include "memorygovernor.h"
+#include "roistatsservice.h"
+#include "pixelprobe.h"
+#include "tonemapper.h"
+#include "logger.h"
 
+namespace {
+
+LogModel *s_logModel = nullptr;
+
+/**
+ * @brief Singleton provider for "import Logger 1.0" (the instance is owned by main())
+ */
+QObject *loggerProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(engine);
+    Q_UNUSED(scriptEngine);
+    QQmlEngine::setObjectOwnership(s_logModel, QQmlEngine::CppOwnership);
+    return s_logModel;
+}
+
+/**
+ * @brief Trace file requested with "--trace [file]" or RENDERCOMPARE_TRACE=<file>
+ * @return Output path, or empty string if tracing wasn't requested
+ */
+QString traceOutputPath(const QStringList &arguments)
+{
+    const QString defaultPath = QStringLiteral("renderCompare-trace-%1.json")
+                                    .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+    const int flagIndex = arguments.indexOf(QStringLiteral("--trace"));
+    if (flagIndex > 0) {
+        const QString next = arguments.value(flagIndex + 1);
+        return (next.isEmpty() || next.startsWith('-')) ? defaultPath : next;
+    }
+    const QString env = qEnvironmentVariable("RENDERCOMPARE_TRACE");
+    if (env.isEmpty() || env == "0") {
+        return QString();
+    }
+    return (env == "1") ? defaultPath : env;
+}
+
+/**
+ * @brief Check for "--headless" before any application object exists
+ */
+bool isHeadless(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--headless") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
 
 int main(int argc, char *argv[])
 {
+    // Batch triage report (CI): no window, so no QApplication - works without a display or GPU
+    if (isHeadless(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        const QString tracePath = traceOutputPath(app.arguments());
+        if (!tracePath.isEmpty()) {
+            Tracer::start(tracePath);
+        }
+        const int exitCode = HeadlessReport::run(app.arguments());
+        Tracer::stop();
+        return exitCode;
+    }
+
     // Qt Charts uses Qt Graphics View Framework for drawing, therefore QApplication must be used.
     QApplication app(argc, argv);
 
+    // Hot-path tracing (off by default); the trace is written when the app exits
+    const QString tracePath = traceOutputPath(app.arguments());
+    if (!tracePath.isEmpty()) {
+        Tracer::start(tracePath);
+    }
+
+    // Whole-session log history for search, next to the sessions of the last few runs
+    const QString logRoot = QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("logs");
+    LogArchive::pruneSessions(logRoot, 9);
+    LogArchive logArchive;
+    QString logArchiveError;
+    const bool logArchiveOpen = logArchive.open(LogArchive::sessionDirectory(logRoot), &logArchiveError);
+
+    // Application log ("Logger" in QML); also collects qDebug() ... qCritical() from every thread
+    LogModel logModel;
+    LogModel::installMessageHandler(&logModel);
+    s_logModel = &logModel;
+    logModel.setArchive(&logArchive);
+    if (!logArchiveOpen) {
+        WARNING_LOG("Log search disabled -" << logArchiveError);
+    }
+
     QQuickView viewer;
 
     // Add import path for QML modules (allows running without installing modules)
@@ -56,17 +162,66 @@ int main(int argc, char *argv[])
     qmlRegisterType<IniReader>("com.rendercompare", 1, 0, "IniReader");
     qmlRegisterType<XmlDataModel>("com.rendercompare", 1, 0, "XmlDataModel");
     qmlRegisterType<TesterRunner>("com.rendercompare", 1, 0, "TesterRunner");
+    qmlRegisterType<ABCompositorItem>("com.rendercompare", 1, 0, "ABCompositorItem");
     
     // Register QML singletons for theme, constants, and logger
     qmlRegisterSingletonType(QUrl("qrc:/qml/Theme.qml"), "Theme", 1, 0, "Theme");
     qmlRegisterSingletonType(QUrl("qrc:/qml/Constants.qml"), "Constants", 1, 0, "Constants");
-    qmlRegisterSingletonType(QUrl("qrc:/qml/Logger.qml"), "Logger", 1, 0, "Logger");
+    qmlRegisterSingletonType<LogModel>("Logger", 1, 0, "Logger", loggerProvider);
 
     // Create long-lived instances so QML keeps valid pointers
     IniReader iniReader;
+    MemoryGovernor memoryGovernor;  // Declared before the caches, which unregister when destroyed
     XmlDataModel xmlDataModel;
     TesterRunner testerRunner;
+    // freeDView_tester output goes straight into the log, without a QML handler per line
+    QObject::connect(&testerRunner, &TesterRunner::outputLine, &logModel, [&logModel](const QString &line, bool isError) {
+        if (isError) {
+            logModel.error("[freeDView_tester] " + line);
+        } else {
+            logModel.info("[freeDView_tester] " + line);
+        }
+    });
+    // Archived lines are indexed by the test being compared
+    QObject::connect(&testerRunner, &TesterRunner::testProgressUpdated, &logModel, [&logModel](const QString &testKey) {
+        logModel.setCurrentTestKey(testKey);
+    });
+    QObject::connect(&testerRunner, &TesterRunner::runFinished, &logModel, [&logModel]() {
+        logModel.setCurrentTestKey(QString());
+    });
+    LogSearchModel logSearch(&logArchive);
     ImageLoaderManager imageLoaderManager;
+    TimelineSeriesFeeder timelineSeriesFeeder;
+    timelineSeriesFeeder.setDataModel(&xmlDataModel);
+    PlaybackEngine playbackEngine;
+    playbackEngine.setImageLoaderManager(&imageLoaderManager);
+    // Reduced-size local copies of the open event's sequences for scrubbing
+    ProxyBuilder proxyBuilder;
+    proxyBuilder.setImageLoaderManager(&imageLoaderManager);
+    proxyBuilder.setCacheDirectory(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("proxies"));
+    // A finished run may have re-rendered the open event's sequences
+    QObject::connect(&testerRunner, &TesterRunner::runFinished, &proxyBuilder, [&proxyBuilder]() {
+        proxyBuilder.refresh();
+    });
+    FrameSetPresenter frameSetPresenter(playbackEngine.frameRing());
+    frameSetPresenter.setProxyBuilder(&proxyBuilder);
+    RoiStatsService roiStats;  // Statistics of the A/B/C view's visible region
+    roiStats.setFrameRing(playbackEngine.frameRing());
+    roiStats.setImageLoaderManager(&imageLoaderManager);
+    timelineSeriesFeeder.setRoiStatsService(&roiStats);
+    PixelProbe pixelProbe;  // Pixel values under the cursor (only while its panel is shown)
+    pixelProbe.setFrameRing(playbackEngine.frameRing());
+    pixelProbe.setImageLoaderManager(&imageLoaderManager);
+    ToneMapper toneMapper;  // Display exposure / tone curve of the A and B panes
+    // Record scrubbing for offline replay with tests/scrubreplay ("--record-scrub <file>")
+    const int recordScrubIndex = app.arguments().indexOf(QStringLiteral("--record-scrub"));
+    if (recordScrubIndex > 0) {
+        frameSetPresenter.setRecordPath(app.arguments().value(recordScrubIndex + 1));
+    }
+    MetricsRegistry metricsRegistry;  // Snapshots for the performance HUD (only while it is shown)
+    xmlDataModel.setMemoryGovernor(&memoryGovernor);
+    imageLoaderManager.setMemoryGovernor(&memoryGovernor);
+    playbackEngine.frameRing()->setMemoryGovernor(&memoryGovernor);
     
     // Limit global thread pool to prevent too many simultaneous image loads
     // This works with QtConcurrent::run to throttle concurrent operations
@@ -79,12 +234,31 @@ int main(int argc, char *argv[])
     if (iniReader.readINIFile()) {
         xmlDataModel.loadData(iniReader.setTestResultsPath(), QString(), iniReader.setTestPath());
     }
+    memoryGovernor.setBudgetBytes(static_cast<qint64>(iniReader.memoryBudgetMB()) * 1024 * 1024);
+    memoryGovernor.setMinAvailableBytes(static_cast<qint64>(iniReader.minAvailableMemoryMB()) * 1024 * 1024);
 
     // Expose to QML (even if INI load failed, to keep bindings valid)
     viewer.rootContext()->setContextProperty("iniReader", &iniReader);
     viewer.rootContext()->setContextProperty("xmlDataModel", &xmlDataModel);
     viewer.rootContext()->setContextProperty("testerRunner", &testerRunner);
     viewer.rootContext()->setContextProperty("imageLoaderManager", &imageLoaderManager);
+    viewer.rootContext()->setContextProperty("timelineSeriesFeeder", &timelineSeriesFeeder);
+    viewer.rootContext()->setContextProperty("playbackEngine", &playbackEngine);
+    viewer.rootContext()->setContextProperty("frameSetPresenter", &frameSetPresenter);
+    viewer.rootContext()->setContextProperty("proxyBuilder", &proxyBuilder);
+    viewer.rootContext()->setContextProperty("roiStats", &roiStats);
+    viewer.rootContext()->setContextProperty("pixelProbe", &pixelProbe);
+    viewer.rootContext()->setContextProperty("toneMapper", &toneMapper);
+    viewer.rootContext()->setContextProperty("metricsRegistry", &metricsRegistry);
+    viewer.rootContext()->setContextProperty("memoryGovernor", &memoryGovernor);
+    viewer.rootContext()->setContextProperty("logSearch", &logSearch);
+    // Decoded playback frames (image://frames/<type>/<frame>); the QML engine takes ownership of the provider
+    viewer.engine()->addImageProvider(QStringLiteral("frames"),
+                                      new FrameImageProvider(playbackEngine.frameRing(), &imageLoaderManager, &toneMapper));
+    // Image pyramid tiles for zoomed-in panes (image://tiles/<type>/<frame>/<level>/<column>/<row>)
+    viewer.engine()->addImageProvider(QStringLiteral("tiles"), new TileImageProvider(&imageLoaderManager, &toneMapper));
+    // Scrub proxies (image://proxies/<type>/<frame>)
+    viewer.engine()->addImageProvider(QStringLiteral("proxies"), new ProxyImageProvider(&proxyBuilder, &toneMapper));
     viewer.rootContext()->setContextProperty("appVersion", appVersion);
     
     // Load main QML component and configure window
@@ -98,6 +272,8 @@ int main(int argc, char *argv[])
     
     viewer.show();
 
-    return app.exec();
+    const int exitCode = app.exec();
+    Tracer::stop();
+    return exitCode;
 }
 
@@ -0,0 +1,216 @@
+#include "memorygovernor.h"
+#include "logger.h"
+#include "tracer.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QVariantMap>
+#include <algorithm>
+
+namespace {
+
+// Trim to this fraction of the budget, so the next insertion doesn't trim again right away
+const int kHeadroomPercent = 10;
+
+} // namespace
+
+MemoryGovernor::MemoryGovernor(QObject *parent)
+    : QObject(parent)
+    , m_nextId(1)
+    , m_checkScheduled(false)
+    , m_meminfoPath(QStringLiteral("/proc/meminfo"))
+    , m_budgetBytes(1024LL * 1024 * 1024)
+    , m_minAvailableBytes(256LL * 1024 * 1024)
+    , m_usedBytes(0)
+    , m_availableBytes(-1)
+    , m_underPressure(false)
+{
+    m_timer.setInterval(1000);
+    connect(&m_timer, &QTimer::timeout, this, &MemoryGovernor::enforce);
+    m_timer.start();
+}
+
+int MemoryGovernor::addConsumer(const QString &name, int priority, BytesFunction bytes, ReleaseFunction release)
+{
+    QMutexLocker locker(&m_mutex);
+    Consumer consumer;
+    consumer.id = m_nextId++;
+    consumer.name = name;
+    consumer.priority = priority;
+    consumer.bytes = bytes;
+    consumer.release = release;
+    consumer.lastBytes = 0;
+    consumer.releasedBytes = 0;
+    m_consumers.append(consumer);
+    return consumer.id;
+}
+
+void MemoryGovernor::removeConsumer(int id)
+{
+    QMutexLocker enforceLocker(&m_enforceMutex);
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_consumers.size(); ++i) {
+        if (m_consumers.at(i).id == id) {
+            m_consumers.remove(i);
+            return;
+        }
+    }
+}
+
+void MemoryGovernor::requestCheck()
+{
+    if (!m_checkScheduled.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, "check", Qt::QueuedConnection);
+    }
+}
+
+void MemoryGovernor::check()
+{
+    // Budget only - system memory is sampled by the timer
+    enforceBudget();
+}
+
+void MemoryGovernor::enforce()
+{
+    m_availableBytes = readAvailableSystemBytes(m_meminfoPath);
+    enforceBudget();
+}
+
+void MemoryGovernor::setBudgetBytes(qint64 bytes)
+{
+    bytes = qMax(qint64(0), bytes);
+    if (m_budgetBytes != bytes) {
+        m_budgetBytes = bytes;
+        emit budgetChanged();
+        requestCheck();
+    }
+}
+
+void MemoryGovernor::setMinAvailableBytes(qint64 bytes)
+{
+    bytes = qMax(qint64(0), bytes);
+    if (m_minAvailableBytes != bytes) {
+        m_minAvailableBytes = bytes;
+        emit budgetChanged();
+        requestCheck();
+    }
+}
+
+void MemoryGovernor::enforceBudget()
+{
+    TRACE_SCOPE("MemoryGovernor", "enforceBudget");
+    m_checkScheduled.store(false, std::memory_order_release);
+
+    // The callbacks take the caches' locks: call them on a snapshot, without m_mutex
+    QMutexLocker enforceLocker(&m_enforceMutex);
+    QMutexLocker locker(&m_mutex);
+    QVector<Consumer> consumers = m_consumers;
+    locker.unlock();
+
+    qint64 used = 0;
+    for (Consumer &consumer : consumers) {
+        consumer.lastBytes = consumer.bytes();
+        used += consumer.lastBytes;
+    }
+
+    // Target: under the budget (0 = none), and under system pressure also give back the shortfall
+    const bool pressure = m_availableBytes >= 0 && m_minAvailableBytes > 0 && m_availableBytes < m_minAvailableBytes;
+    qint64 target = used;
+    if (m_budgetBytes > 0 && used > m_budgetBytes) {
+        target = m_budgetBytes * (100 - kHeadroomPercent) / 100;
+    }
+    if (pressure) {
+        target = qMin(target, used - (m_minAvailableBytes - m_availableBytes));
+    }
+    target = qMax(qint64(0), target);
+
+    if (used > target) {
+        // Lowest priority first; equal priorities by size, largest first
+        QVector<int> order;
+        for (int i = 0; i < consumers.size(); ++i) {
+            order.append(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&consumers](int a, int b) {
+            const Consumer &first = consumers.at(a);
+            const Consumer &second = consumers.at(b);
+            return first.priority != second.priority ? first.priority < second.priority : first.lastBytes > second.lastBytes;
+        });
+
+        qint64 excess = used - target;
+        for (int index : order) {
+            if (excess <= 0) {
+                break;
+            }
+            Consumer &consumer = consumers[index];
+            if (consumer.lastBytes <= 0) {
+                continue;
+            }
+            const qint64 freed = consumer.release(qMin(excess, consumer.lastBytes));
+            consumer.releasedBytes += freed;
+            excess -= freed;
+        }
+
+        const qint64 before = used;
+        used = 0;
+        for (Consumer &consumer : consumers) {
+            consumer.lastBytes = consumer.bytes();
+            used += consumer.lastBytes;
+        }
+        DEBUG_LOG("MemoryGovernor") << "enforceBudget - Released" << (before - used) / (1024 * 1024) << "MB, now"
+                                    << used / (1024 * 1024) << "MB" << (pressure ? "(system memory low)" : "");
+    }
+
+    // Keep the sampled bytes and released totals (consumers added meanwhile show up next check)
+    locker.relock();
+    for (Consumer &consumer : m_consumers) {
+        for (const Consumer &sampled : consumers) {
+            if (sampled.id == consumer.id) {
+                consumer.lastBytes = sampled.lastBytes;
+                consumer.releasedBytes = sampled.releasedBytes;
+                break;
+            }
+        }
+    }
+    locker.unlock();
+    enforceLocker.unlock();
+
+    QVector<const Consumer *> byUsage;
+    for (const Consumer &consumer : consumers) {
+        byUsage.append(&consumer);
+    }
+    std::stable_sort(byUsage.begin(), byUsage.end(), [](const Consumer *a, const Consumer *b) {
+        return a->lastBytes > b->lastBytes;
+    });
+    QVariantList breakdown;
+    for (const Consumer *consumer : byUsage) {
+        QVariantMap entry;
+        entry["name"] = consumer->name;
+        entry["priority"] = consumer->priority;
+        entry["bytes"] = consumer->lastBytes;
+        entry["releasedBytes"] = consumer->releasedBytes;
+        breakdown.append(entry);
+    }
+
+    m_usedBytes = used;
+    m_underPressure = pressure;
+    m_breakdown = breakdown;
+    emit usageChanged();
+}
+
+qint64 MemoryGovernor::readAvailableSystemBytes(const QString &meminfoPath)
+{
+    QFile file(meminfoPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    // "MemAvailable:    8030412 kB"
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith("MemAvailable:")) {
+            const QList<QByteArray> parts = line.mid(13).simplified().split(' ');
+            bool ok = false;
+            const qint64 kilobytes = parts.value(0).toLongLong(&ok);
+            return ok ? kilobytes * 1024 : -1;
+        }
+    }
+    return -1;
+}
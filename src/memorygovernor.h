@@ -0,0 +1,134 @@
+#ifndef MEMORYGOVERNOR_H
+#define MEMORYGOVERNOR_H
+
+#include <QObject>
+#include <QMutex>
+#include <QString>
+#include <QTimer>
+#include <QVariantList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief MemoryGovernor - One memory budget for all caches
+ *
+ * Caches (ImageLoaderManager pixmaps and tiles, FrameRing, XmlDataModel's parsed
+ * XML) register as consumers: a function reporting the bytes they hold right now
+ * and one releasing memory, least recently used first. When their sum exceeds the
+ * budget, the governor asks the consumers to release the excess (plus 10% headroom),
+ * lowest priority first, so cheap-to-rebuild data goes before decoded playback frames.
+ *
+ * System pressure: when the available memory (/proc/meminfo MemAvailable on Linux)
+ * drops below minAvailableBytes, the caches give back the shortfall even under budget.
+ *
+ * Checks run once a second and whenever a cache calls requestCheck() after growing.
+ * The callbacks are called on the governor's thread, never while a cache calls
+ * requestCheck(), so consumers may hold their own lock when they request a check.
+ * They run without the consumer list locked: caches may register meanwhile, and
+ * removeConsumer() waits for callbacks in progress.
+ *
+ * Budget and threshold come from the [memory] section of renderCompare.ini.
+ */
+class MemoryGovernor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qint64 budgetBytes READ budgetBytes WRITE setBudgetBytes NOTIFY budgetChanged)
+    Q_PROPERTY(qint64 minAvailableBytes READ minAvailableBytes WRITE setMinAvailableBytes NOTIFY budgetChanged)
+    Q_PROPERTY(qint64 usedBytes READ usedBytes NOTIFY usageChanged)
+    Q_PROPERTY(qint64 availableSystemBytes READ availableSystemBytes NOTIFY usageChanged)
+    Q_PROPERTY(bool underPressure READ underPressure NOTIFY usageChanged)
+    Q_PROPERTY(QVariantList breakdown READ breakdown NOTIFY usageChanged)
+
+public:
+    typedef std::function<qint64()> BytesFunction;
+    typedef std::function<qint64(qint64)> ReleaseFunction;
+
+    explicit MemoryGovernor(QObject *parent = nullptr);
+
+    /**
+     * @brief Register a cache
+     * @param name - Shown in the breakdown, e.g. "frameRing"
+     * @param priority - Lower priorities release memory first
+     * @param bytes - Returns the bytes the cache holds (any thread, thread-safe)
+     * @param release - Frees about the given bytes, least valuable first; returns the bytes freed
+     * @return Consumer id for removeConsumer()
+     */
+    int addConsumer(const QString &name, int priority, BytesFunction bytes, ReleaseFunction release);
+
+    /**
+     * @brief Unregister a cache (before it is destroyed); waits for a check in progress
+     */
+    void removeConsumer(int id);
+
+    /**
+     * @brief Check the budget soon (any thread, cheap; one check per burst)
+     */
+    void requestCheck();
+
+    /**
+     * @brief Sample system memory and enforce the budget now
+     */
+    Q_INVOKABLE void enforce();
+
+    qint64 budgetBytes() const { return m_budgetBytes; }
+    void setBudgetBytes(qint64 bytes);
+    qint64 minAvailableBytes() const { return m_minAvailableBytes; }
+    void setMinAvailableBytes(qint64 bytes);
+    qint64 usedBytes() const { return m_usedBytes; }
+    qint64 availableSystemBytes() const { return m_availableBytes; }
+    bool underPressure() const { return m_underPressure; }
+
+    /**
+     * @brief Per-cache usage: [{name, priority, bytes, releasedBytes}], highest usage first
+     */
+    QVariantList breakdown() const { return m_breakdown; }
+
+    /**
+     * @brief Read the file used for system memory (default /proc/meminfo; tests use a fixture)
+     */
+    void setMeminfoPath(const QString &path) { m_meminfoPath = path; }
+
+    /**
+     * @brief MemAvailable from a /proc/meminfo style file
+     * @return Bytes, or -1 if unknown (no such file, e.g. not Linux)
+     */
+    static qint64 readAvailableSystemBytes(const QString &meminfoPath);
+
+signals:
+    void budgetChanged();
+    void usageChanged();
+
+private slots:
+    void check();
+
+private:
+    struct Consumer {
+        int id;
+        QString name;
+        int priority;
+        BytesFunction bytes;
+        ReleaseFunction release;
+        qint64 lastBytes;
+        qint64 releasedBytes;  // Total released on request, for diagnostics
+    };
+
+    void enforceBudget();
+
+    QMutex m_enforceMutex;  // Held while calling the consumers, so removed ones aren't called
+    QMutex m_mutex;  // Guards m_consumers (added/removed from the caches' threads)
+    QVector<Consumer> m_consumers;
+    int m_nextId;
+    std::atomic<bool> m_checkScheduled;
+    QTimer m_timer;
+    QString m_meminfoPath;
+
+    qint64 m_budgetBytes;
+    qint64 m_minAvailableBytes;
+    qint64 m_usedBytes;
+    qint64 m_availableBytes;
+    bool m_underPressure;
+    QVariantList m_breakdown;
+};
+
+#endif // MEMORYGOVERNOR_H
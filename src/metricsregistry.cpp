@@ -0,0 +1,173 @@
+#include "metricsregistry.h"
+#include "logger.h"
+#include <QtAlgorithms>
+#include <cmath>
+
+std::atomic<qint64> MetricsRegistry::s_counters[MetricsRegistry::CounterCount];
+std::atomic<qint64> MetricsRegistry::s_gauges[MetricsRegistry::GaugeCount];
+LatencyHistogram MetricsRegistry::s_latencies[MetricsRegistry::LatencyCount];
+
+namespace {
+
+// Snapshot keys, in enum order
+const char *const CounterRateKeys[][2] = {
+    { "imageCacheHitRate", "imageCacheLookupsPerSecond" },
+    { "tileCacheHitRate", "tileCacheLookupsPerSecond" },
+    { "frameRingHitRate", "frameRingRequestsPerSecond" },
+    { "compressedFrameHitRate", "compressedFrameLookupsPerSecond" },
+};
+const char *const GaugeKeys[] = { "tileCacheBytes", "frameRingBytes", "decodesQueued", "decodesInFlight",
+                                  "compressedFrameBytes" };
+const char *const LatencyKeys[] = { "decode", "scrubToPresent", "proxyFilter", "xmlParse" };
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+    for (std::atomic<quint64> &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+QVector<quint64> LatencyHistogram::takeCounts()
+{
+    QVector<quint64> counts(BucketCount);
+    for (int i = 0; i < BucketCount; ++i) {
+        counts[i] = m_buckets[i].exchange(0, std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+int LatencyHistogram::bucketIndex(qint64 microseconds)
+{
+    if (microseconds < 4) {
+        return microseconds < 0 ? 0 : static_cast<int>(microseconds);
+    }
+    // Highest set bit selects the power of two, the two bits below it the quarter
+    const int msb = 63 - qCountLeadingZeroBits(static_cast<quint64>(microseconds));
+    const int quarter = static_cast<int>((microseconds >> (msb - 2)) & 3);
+    return qMin(4 + (msb - 2) * 4 + quarter, BucketCount - 1);
+}
+
+qint64 LatencyHistogram::bucketLowerBound(int index)
+{
+    if (index < 4) {
+        return index;
+    }
+    const int msb = (index - 4) / 4 + 2;
+    const int quarter = (index - 4) % 4;
+    return static_cast<qint64>(4 + quarter) << (msb - 2);
+}
+
+double LatencyHistogram::percentileMs(const QVector<quint64> &counts, double fraction)
+{
+    quint64 total = 0;
+    for (quint64 count : counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return -1.0;
+    }
+
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(std::ceil(fraction * total)));
+    quint64 seen = 0;
+    for (int i = 0; i < counts.size(); ++i) {
+        seen += counts.at(i);
+        if (seen >= rank) {
+            const qint64 lower = bucketLowerBound(i);
+            const qint64 upper = i + 1 < counts.size() ? bucketLowerBound(i + 1) : lower * 2;
+            return (lower + upper) / 2.0 / 1000.0;
+        }
+    }
+    return -1.0;
+}
+
+MetricsRegistry::MetricsRegistry(QObject *parent)
+    : QObject(parent)
+{
+    for (int i = 0; i < CounterCount; ++i) {
+        m_lastCounters[i] = counterValue(static_cast<Counter>(i));
+    }
+    for (int i = 0; i < LatencyCount; ++i) {
+        m_lastP50[i] = -1.0;
+        m_lastP99[i] = -1.0;
+    }
+    m_timer.setInterval(500);  // Fast enough to follow a scrub, slow enough to read
+    connect(&m_timer, &QTimer::timeout, this, &MetricsRegistry::takeSnapshot);
+}
+
+void MetricsRegistry::setActive(bool active)
+{
+    if (active == isActive()) {
+        return;
+    }
+    if (active) {
+        takeSnapshot();  // Start the first interval from now
+        m_timer.start();
+    } else {
+        m_timer.stop();
+    }
+    emit activeChanged();
+}
+
+void MetricsRegistry::setInterval(int ms)
+{
+    if (ms <= 0) {
+        DEBUG_LOG("MetricsRegistry") << "setInterval - Invalid interval:" << ms << "(must be > 0)";
+        return;
+    }
+    if (ms == m_timer.interval()) {
+        return;
+    }
+    m_timer.setInterval(ms);
+    emit intervalChanged();
+}
+
+void MetricsRegistry::takeSnapshot()
+{
+    // Rates are per second of the time actually elapsed (the timer may fire late)
+    const double seconds = m_sinceSnapshot.isValid() ? qMax<qint64>(1, m_sinceSnapshot.restart()) / 1000.0
+                                                     : m_timer.interval() / 1000.0;
+    if (!m_sinceSnapshot.isValid()) {
+        m_sinceSnapshot.start();
+    }
+    QVariantMap snapshot;
+
+    // Counters come in hit/miss pairs
+    qint64 deltas[CounterCount];
+    for (int i = 0; i < CounterCount; ++i) {
+        const qint64 value = counterValue(static_cast<Counter>(i));
+        deltas[i] = value - m_lastCounters[i];
+        m_lastCounters[i] = value;
+    }
+    for (int pair = 0; pair < CounterCount / 2; ++pair) {
+        const qint64 hits = deltas[pair * 2];
+        const qint64 lookups = hits + deltas[pair * 2 + 1];
+        snapshot[CounterRateKeys[pair][0]] = lookups > 0 ? static_cast<double>(hits) / lookups : -1.0;
+        snapshot[CounterRateKeys[pair][1]] = lookups / seconds;
+    }
+
+    for (int i = 0; i < GaugeCount; ++i) {
+        snapshot[GaugeKeys[i]] = gaugeValue(static_cast<Gauge>(i));
+    }
+    snapshot["cacheBytes"] = gaugeValue(TileCacheBytes) + gaugeValue(FrameRingBytes);
+
+    for (int i = 0; i < LatencyCount; ++i) {
+        const QVector<quint64> counts = s_latencies[i].takeCounts();
+        quint64 samples = 0;
+        for (quint64 count : counts) {
+            samples += count;
+        }
+        if (samples > 0) {
+            m_lastP50[i] = LatencyHistogram::percentileMs(counts, 0.50);
+            m_lastP99[i] = LatencyHistogram::percentileMs(counts, 0.99);
+        }
+        const QString key = QLatin1String(LatencyKeys[i]);
+        snapshot[key + "P50Ms"] = m_lastP50[i];
+        snapshot[key + "P99Ms"] = m_lastP99[i];
+        snapshot[key + "PerSecond"] = samples / seconds;
+    }
+
+    m_snapshot = snapshot;
+    emit snapshotChanged();
+}
@@ -0,0 +1,189 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief LatencyHistogram - Lock-free latency histogram with log-scale buckets
+ *
+ * Buckets are 1 µs wide up to 4 µs, then each power of two is split into four, so
+ * any percentile is within 12.5% of the true value (from 1 µs up to ~70 minutes).
+ * record() is one relaxed atomic increment; it can be called from any thread.
+ */
+class LatencyHistogram
+{
+public:
+    static const int BucketCount = 4 + 4 * 30;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Add one sample
+     * @param nanoseconds - Measured duration
+     */
+    void record(qint64 nanoseconds)
+    {
+        m_buckets[bucketIndex(nanoseconds / 1000)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take the samples recorded since the last call (and start counting from zero)
+     * @return Sample count per bucket
+     */
+    QVector<quint64> takeCounts();
+
+    static int bucketIndex(qint64 microseconds);
+
+    /**
+     * @brief Smallest value (µs) that falls into a bucket
+     */
+    static qint64 bucketLowerBound(int index);
+
+    /**
+     * @brief Estimate a percentile from bucket counts
+     * @param counts - Bucket counts (from takeCounts())
+     * @param fraction - Percentile as a fraction, e.g. 0.99
+     * @return Bucket midpoint in milliseconds, or -1 if there are no samples
+     */
+    static double percentileMs(const QVector<quint64> &counts, double fraction);
+
+private:
+    Q_DISABLE_COPY(LatencyHistogram)
+
+    std::atomic<quint64> m_buckets[BucketCount];
+};
+
+/**
+ * @brief MetricsRegistry - Live performance counters, gauges and latency histograms
+ *
+ * Hot paths update metrics through the static functions (increment, setGauge,
+ * recordLatency, or a ScopedLatency); each update is one relaxed atomic operation,
+ * so instrumented code isn't slowed down or serialized. The registry QObject takes a
+ * snapshot every interval ms while active and publishes it to QML as a QVariantMap
+ * (shown by PerformanceHud.qml):
+ *
+ * - Counters are reported as rates over the last interval (e.g. tileCacheHitRate)
+ * - Gauges are reported as their current value
+ * - Latency percentiles (e.g. decodeP50Ms, decodeP99Ms) cover the samples of the last
+ *   interval that had any, so rare operations (XML parsing) stay visible until the next one
+ *
+ * Values not measured yet are -1.
+ */
+class MetricsRegistry : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    Q_PROPERTY(QVariantMap snapshot READ snapshot NOTIFY snapshotChanged)
+
+public:
+    enum Counter {
+        ImageCacheHits,      // ImageLoaderManager pixmap cache
+        ImageCacheMisses,
+        TileCacheHits,       // ImageLoaderManager tile cache
+        TileCacheMisses,
+        FrameRingHits,       // Decoded frame requested again
+        FrameRingMisses,     // Decode started
+        CompressedFrameHits,    // Decode served from CompressedFrameCache
+        CompressedFrameMisses,  // Decode read the file
+        CounterCount
+    };
+
+    enum Gauge {
+        TileCacheBytes,
+        FrameRingBytes,
+        DecodesQueued,
+        DecodesInFlight,
+        CompressedFrameBytes,
+        GaugeCount
+    };
+
+    enum Latency {
+        DecodeLatency,          // Full-frame decode (FrameRing, ImageLoaderManager)
+        ScrubToPresentLatency,  // FrameSetPresenter::requestFrame() to frameSetReady
+        ProxyFilterLatency,     // SortFilterProxyModel re-filtering
+        XmlParseLatency,        // uiData.xml and compareResult.xml parsing
+        LatencyCount
+    };
+
+    explicit MetricsRegistry(QObject *parent = nullptr);
+
+    static void increment(Counter counter, qint64 amount = 1)
+    {
+        s_counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    static void setGauge(Gauge gauge, qint64 value)
+    {
+        s_gauges[gauge].store(value, std::memory_order_relaxed);
+    }
+
+    static void recordLatency(Latency latency, qint64 nanoseconds)
+    {
+        s_latencies[latency].record(nanoseconds);
+    }
+
+    static qint64 counterValue(Counter counter) { return s_counters[counter].load(std::memory_order_relaxed); }
+    static qint64 gaugeValue(Gauge gauge) { return s_gauges[gauge].load(std::memory_order_relaxed); }
+
+    bool isActive() const { return m_timer.isActive(); }
+    void setActive(bool active);
+    int interval() const { return m_timer.interval(); }
+    void setInterval(int ms);
+    QVariantMap snapshot() const { return m_snapshot; }
+
+    /**
+     * @brief Take a snapshot now (also done by the timer while active)
+     */
+    Q_INVOKABLE void takeSnapshot();
+
+signals:
+    void activeChanged();
+    void intervalChanged();
+    void snapshotChanged();
+
+private:
+    static std::atomic<qint64> s_counters[CounterCount];
+    static std::atomic<qint64> s_gauges[GaugeCount];
+    static LatencyHistogram s_latencies[LatencyCount];
+
+    QTimer m_timer;
+    QElapsedTimer m_sinceSnapshot;
+    QVariantMap m_snapshot;
+    qint64 m_lastCounters[CounterCount];  // Counter values at the previous snapshot
+    double m_lastP50[LatencyCount];
+    double m_lastP99[LatencyCount];
+};
+
+/**
+ * @brief ScopedLatency - Records the lifetime of a scope into a latency histogram
+ */
+class ScopedLatency
+{
+public:
+    explicit ScopedLatency(MetricsRegistry::Latency latency)
+        : m_latency(latency)
+        , m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedLatency()
+    {
+        MetricsRegistry::recordLatency(m_latency, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::steady_clock::now() - m_start).count());
+    }
+
+private:
+    Q_DISABLE_COPY(ScopedLatency)
+
+    MetricsRegistry::Latency m_latency;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif // METRICSREGISTRY_H
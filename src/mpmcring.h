@@ -0,0 +1,122 @@
+#ifndef MPMCRING_H
+#define MPMCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief MpmcRing - Bounded lock-free multi-producer / multi-consumer queue
+ *
+ * Fixed number of slots (rounded up to a power of two), each with a sequence
+ * number that says whether it is free for the producer or filled for the consumer
+ * of a given lap (D. Vyukov's bounded MPMC queue). push() and pop() never block
+ * and never allocate; push() fails when the ring is full, so producers decide
+ * whether to drop or retry.
+ *
+ * Used by LogModel so any thread can log without taking a lock the GUI thread holds.
+ */
+template <typename T>
+class MpmcRing
+{
+public:
+    /**
+     * @param capacity - Minimum number of slots (rounded up to a power of two)
+     */
+    explicit MpmcRing(int capacity)
+        : m_mask(roundUpToPowerOfTwo(capacity) - 1)
+        , m_slots(new Slot[m_mask + 1])
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing &) = delete;
+    MpmcRing &operator=(const MpmcRing &) = delete;
+
+    /**
+     * @brief Append a value (any thread)
+     * @return false if the ring is full (value not taken)
+     */
+    bool push(T value)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &m_slots[pos & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Slot free in this lap - claim it
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Still holds a value from the previous lap: full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);  // Another producer claimed it
+            }
+        }
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest value (any thread)
+     * @return false if the ring is empty
+     */
+    bool pop(T &value)
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &m_slots[pos & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Not filled yet: empty
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(slot->value);
+        slot->value = T();  // Don't keep the payload (e.g. shared string data) alive in the slot
+        slot->sequence.store(pos + m_mask + 1, std::memory_order_release);  // Free for the next lap
+        return true;
+    }
+
+    int capacity() const { return static_cast<int>(m_mask + 1); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUpToPowerOfTwo(int capacity)
+    {
+        size_t size = 2;
+        while (size < static_cast<size_t>(capacity)) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    // Producers and consumers update different cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+};
+
+#endif // MPMCRING_H
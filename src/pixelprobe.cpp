@@ -0,0 +1,285 @@
+#include "pixelprobe.h"
+#include "framering.h"
+#include "imageloadermanager.h"
+#include "logger.h"
+#include <QImageReader>
+#include <QPixmap>
+#include <QtMath>
+#include <QtConcurrent>
+
+namespace {
+
+const int kHistogramIntervalMs = 16;  // One display frame at 60 Hz
+
+const char *const kPaneTypes[] = { "A", "B", "C", "D" };
+
+QString paneLabel(const QString &imageType)
+{
+    if (imageType == QLatin1String("A")) {
+        return QStringLiteral("Orig");
+    }
+    if (imageType == QLatin1String("B")) {
+        return QStringLiteral("Test");
+    }
+    if (imageType == QLatin1String("C")) {
+        return QStringLiteral("Diff");
+    }
+    return QStringLiteral("Alpha");
+}
+
+/**
+ * @brief Histogram of a region from a decoded image (or a copy of just the region), else from disk
+ * @param image - Decoded pixels, or null image
+ * @param origin - Image pixel of image's top-left
+ * @param path - Image file (used if image is null)
+ * @param rect - Region in image pixels
+ */
+ChannelHistogram histogramOf(const QImage &image, const QPoint &origin, const QString &path, const QRect &rect)
+{
+    if (!image.isNull()) {
+        return ChannelHistogram::compute(image, rect.translated(-origin));
+    }
+    if (path.isEmpty()) {
+        return ChannelHistogram();
+    }
+    QImageReader reader(path);
+    const QRect clipped = reader.size().isValid() ? rect.intersected(QRect(QPoint(0, 0), reader.size())) : rect;
+    if (clipped.isEmpty()) {
+        return ChannelHistogram();
+    }
+    reader.setClipRect(clipped);
+    const QImage region = reader.read();
+    return ChannelHistogram::compute(region, region.rect());
+}
+
+} // namespace
+
+PixelProbe::PixelProbe(QObject *parent)
+    : QObject(parent)
+    , m_frameRing(nullptr)
+    , m_imageLoaderManager(nullptr)
+    , m_active(false)
+    , m_frameNumber(0)
+    , m_histogramType(QStringLiteral("A"))
+    , m_watcher(new QFutureWatcher<ChannelHistogram>(this))
+    , m_hasPending(false)
+    , m_pendingFrame(0)
+    , m_histogramGeneration(0)
+    , m_runningGeneration(-1)
+{
+    // One histogram at a time; newer requests replace the pending one
+    m_pool.setMaxThreadCount(1);
+    m_throttle.setSingleShot(true);
+    m_throttle.setInterval(kHistogramIntervalMs);
+    connect(&m_throttle, &QTimer::timeout, this, &PixelProbe::startPendingHistogram);
+    connect(m_watcher, &QFutureWatcherBase::finished, this, &PixelProbe::onHistogramFinished);
+}
+
+PixelProbe::~PixelProbe()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void PixelProbe::setFrameRing(FrameRing *ring)
+{
+    if (m_frameRing) {
+        disconnect(m_frameRing, nullptr, this, nullptr);
+    }
+    m_frameRing = ring;
+    if (m_frameRing) {
+        connect(m_frameRing, &FrameRing::frameDecoded, this, &PixelProbe::onFrameDecoded, Qt::QueuedConnection);
+    }
+}
+
+void PixelProbe::setImageLoaderManager(ImageLoaderManager *manager)
+{
+    m_imageLoaderManager = manager;
+}
+
+void PixelProbe::setActive(bool active)
+{
+    if (active == m_active) {
+        return;
+    }
+    m_active = active;
+    if (!m_active) {
+        clear();
+    }
+    DEBUG_LOG("PixelProbe") << "setActive -" << m_active;
+    emit activeChanged();
+}
+
+void PixelProbe::setHistogramType(const QString &imageType)
+{
+    if (imageType == m_histogramType) {
+        return;
+    }
+    m_histogramType = imageType;
+    ++m_histogramGeneration;  // A running histogram is of the old pane
+    m_histogram = ChannelHistogram();
+    emit histogramTypeChanged();
+    emit histogramChanged();
+}
+
+void PixelProbe::probe(int frameNumber, const QPointF &imagePoint)
+{
+    if (!m_active || !m_imageLoaderManager) {
+        return;
+    }
+    const QPoint point(qFloor(imagePoint.x()), qFloor(imagePoint.y()));
+    if (frameNumber == m_frameNumber && point == m_position) {
+        return;
+    }
+    m_frameNumber = frameNumber;
+    m_position = point;
+    updateSamples();
+}
+
+void PixelProbe::clear()
+{
+    m_frameNumber = 0;
+    m_position = QPoint();
+    m_hasPending = false;
+    ++m_histogramGeneration;
+    const bool hadSamples = !m_samples.isEmpty();
+    m_samples.clear();
+    if (hadSamples) {
+        emit samplesChanged();
+    }
+    if (m_histogram.isValid()) {
+        m_histogram = ChannelHistogram();
+        emit histogramChanged();
+    }
+}
+
+bool PixelProbe::cachedPixel(const QString &imageType, int frameNumber, const QPoint &point, QRgb &pixel) const
+{
+    if (m_frameRing) {
+        const QImage image = m_frameRing->image(imageType, frameNumber);
+        if (!image.isNull()) {
+            if (!image.rect().contains(point)) {
+                return false;
+            }
+            pixel = image.pixel(point);
+            return true;
+        }
+    }
+    const QPixmap pixmap = m_imageLoaderManager->getImageIfCached(imageType, frameNumber);
+    if (pixmap.isNull() || !pixmap.rect().contains(point)) {
+        return false;
+    }
+    // Convert only the probed pixel
+    pixel = pixmap.copy(QRect(point, QSize(1, 1))).toImage().pixel(0, 0);
+    return true;
+}
+
+void PixelProbe::updateSamples()
+{
+    m_samples.clear();
+    for (const char *type : kPaneTypes) {
+        const QString imageType = QLatin1String(type);
+        if (m_imageLoaderManager->getImageDiskPath(imageType, m_frameNumber).isEmpty()) {
+            continue;  // Event has no images of this type (e.g. no alpha)
+        }
+        QVariantMap sample;
+        sample["type"] = imageType;
+        sample["label"] = paneLabel(imageType);
+        QRgb pixel = 0;
+        const bool valid = cachedPixel(imageType, m_frameNumber, m_position, pixel);
+        sample["valid"] = valid;
+        if (valid) {
+            sample["r"] = qRed(pixel);
+            sample["g"] = qGreen(pixel);
+            sample["b"] = qBlue(pixel);
+            sample["a"] = qAlpha(pixel);
+        } else if (m_frameRing && m_position.x() >= 0 && m_position.y() >= 0) {
+            m_frameRing->request(imageType, m_frameNumber);  // onFrameDecoded fills it in
+        }
+        m_samples.append(sample);
+    }
+    emit samplesChanged();
+}
+
+void PixelProbe::onFrameDecoded(const QString &imageType, int frameNumber)
+{
+    Q_UNUSED(imageType);
+    if (m_active && frameNumber == m_frameNumber && m_frameNumber > 0) {
+        updateSamples();
+    }
+}
+
+void PixelProbe::requestHistogram(int frameNumber, const QRectF &viewport)
+{
+    if (!m_active || !m_imageLoaderManager) {
+        return;
+    }
+    m_hasPending = true;
+    m_pendingFrame = frameNumber;
+    m_pendingViewport = viewport.toAlignedRect();
+    if (!m_watcher->isRunning() && !m_throttle.isActive()) {
+        startPendingHistogram();
+    }
+}
+
+void PixelProbe::startPendingHistogram()
+{
+    if (!m_hasPending || m_watcher->isRunning() || !m_imageLoaderManager) {
+        return;
+    }
+    m_hasPending = false;
+    const QRect viewport = m_pendingViewport;
+    if (viewport.isEmpty()) {
+        return;
+    }
+
+    // Decoded pixels are read here (the pixmap cache is main-thread only); the worker bins them
+    QImage image;
+    QPoint origin;
+    if (m_frameRing) {
+        image = m_frameRing->image(m_histogramType, m_pendingFrame);
+    }
+    if (image.isNull()) {
+        const QPixmap pixmap = m_imageLoaderManager->getImageIfCached(m_histogramType, m_pendingFrame);
+        const QRect area = viewport.intersected(pixmap.rect());
+        if (!area.isEmpty()) {
+            image = pixmap.copy(area).toImage();
+            origin = area.topLeft();
+        }
+    }
+    const QString path = image.isNull() ? m_imageLoaderManager->getImageDiskPath(m_histogramType, m_pendingFrame) : QString();
+
+    m_runningGeneration = m_histogramGeneration;
+    m_watcher->setFuture(QtConcurrent::run(&m_pool, [image, origin, path, viewport]() {
+        return histogramOf(image, origin, path, viewport);
+    }));
+    m_throttle.start();
+}
+
+void PixelProbe::onHistogramFinished()
+{
+    // Cleared (or switched panes) while binning
+    if (m_active && m_runningGeneration == m_histogramGeneration) {
+        m_histogram = m_watcher->result();
+        emit histogramChanged();
+    }
+    // A newer viewport arrived while binning
+    if (m_hasPending && !m_throttle.isActive()) {
+        startPendingHistogram();
+    }
+}
+
+QVariantList PixelProbe::histogram() const
+{
+    QVariantList channels;
+    const QVector<quint32> *bins[3] = { &m_histogram.red, &m_histogram.green, &m_histogram.blue };
+    for (const QVector<quint32> *channel : bins) {
+        QVariantList counts;
+        counts.reserve(channel->size());
+        for (quint32 count : *channel) {
+            counts.append(static_cast<int>(count));
+        }
+        channels.append(QVariant(counts));
+    }
+    return channels;
+}
@@ -0,0 +1,132 @@
+#ifndef PIXELPROBE_H
+#define PIXELPROBE_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QPoint>
+#include <QRect>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariantList>
+#include "channelhistogram.h"
+
+// Forward declarations
+class FrameRing;
+class ImageLoaderManager;
+
+/**
+ * @brief PixelProbe - RGB values under the cursor and viewport histograms ("pixelProbe" in QML)
+ *
+ * The A/B/C view reports the image pixel under the cursor with probe(); samples
+ * then holds that pixel of every pane (A, B, C, and D if the event has alpha
+ * images), read from decoded frames only: the playback FrameRing, then the
+ * ImageLoaderManager pixmap cache. Panes not decoded yet are requested from the
+ * FrameRing and the samples update when they arrive.
+ *
+ * requestHistogram() bins the visible viewport of one pane on a private worker
+ * thread. Requests are coalesced: at most one runs at a time and a new one starts
+ * at most once per display frame, with the latest viewport.
+ *
+ * Does nothing while inactive (the panel is hidden).
+ */
+class PixelProbe : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool active READ active WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(QVariantList samples READ samples NOTIFY samplesChanged)
+    Q_PROPERTY(QPoint position READ position NOTIFY samplesChanged)
+    Q_PROPERTY(QString histogramType READ histogramType WRITE setHistogramType NOTIFY histogramTypeChanged)
+    Q_PROPERTY(QVariantList histogram READ histogram NOTIFY histogramChanged)
+    Q_PROPERTY(int histogramMax READ histogramMax NOTIFY histogramChanged)
+    Q_PROPERTY(int histogramPixels READ histogramPixels NOTIFY histogramChanged)
+
+public:
+    explicit PixelProbe(QObject *parent = nullptr);
+    ~PixelProbe();
+
+    /**
+     * @brief Set the decoded playback frames to read from first
+     * @param ring - FrameRing instance (not owned)
+     */
+    void setFrameRing(FrameRing *ring);
+
+    /**
+     * @brief Set the manager that caches pixmaps and resolves image paths
+     * @param manager - ImageLoaderManager instance (not owned)
+     */
+    void setImageLoaderManager(ImageLoaderManager *manager);
+
+    /**
+     * @brief Sample every pane at an image pixel
+     * @param frameNumber - Frame number (1-indexed)
+     * @param imagePoint - Position in image pixels (fraction is dropped)
+     */
+    Q_INVOKABLE void probe(int frameNumber, const QPointF &imagePoint);
+
+    /**
+     * @brief Bin the visible viewport of the histogram pane (asynchronous; histogramChanged when done)
+     * @param frameNumber - Frame number (1-indexed)
+     * @param viewport - Visible area in image pixels
+     */
+    Q_INVOKABLE void requestHistogram(int frameNumber, const QRectF &viewport);
+
+    /**
+     * @brief Drop the samples and histogram (e.g. the cursor left the panes)
+     */
+    Q_INVOKABLE void clear();
+
+    bool active() const { return m_active; }
+    void setActive(bool active);
+    const QVariantList &samples() const { return m_samples; }
+    QPoint position() const { return m_position; }
+    QString histogramType() const { return m_histogramType; }
+    void setHistogramType(const QString &imageType);
+    QVariantList histogram() const;
+    int histogramMax() const { return static_cast<int>(m_histogram.maxCount()); }
+    int histogramPixels() const { return m_histogram.pixelCount; }
+
+    /**
+     * @brief The histogram last published
+     */
+    const ChannelHistogram &channelHistogram() const { return m_histogram; }
+
+signals:
+    void activeChanged();
+    void samplesChanged();
+    void histogramTypeChanged();
+    void histogramChanged();
+
+private slots:
+    void onFrameDecoded(const QString &imageType, int frameNumber);
+    void onHistogramFinished();
+    void startPendingHistogram();
+
+private:
+    /**
+     * @brief Decoded pixel of a pane, from the FrameRing or the pixmap cache
+     * @return true if the frame is decoded and the point is inside it
+     */
+    bool cachedPixel(const QString &imageType, int frameNumber, const QPoint &point, QRgb &pixel) const;
+    void updateSamples();
+
+    FrameRing *m_frameRing;
+    ImageLoaderManager *m_imageLoaderManager;
+    bool m_active;
+
+    int m_frameNumber;      // Probed frame (0 = none)
+    QPoint m_position;      // Probed image pixel
+    QVariantList m_samples;
+
+    QString m_histogramType;
+    QThreadPool m_pool;
+    QFutureWatcher<ChannelHistogram> *m_watcher;
+    QTimer m_throttle;          // Minimum spacing of histogram starts (one display frame)
+    bool m_hasPending;
+    int m_pendingFrame;
+    QRect m_pendingViewport;
+    int m_histogramGeneration;  // Bumped by clear() / setHistogramType(); older results are dropped
+    int m_runningGeneration;
+    ChannelHistogram m_histogram;
+};
+
+#endif // PIXELPROBE_H
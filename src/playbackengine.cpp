@@ -0,0 +1,258 @@
+#include "playbackengine.h"
+#include "framering.h"
+#include "imageloadermanager.h"
+#include "logger.h"
+#include <QtMath>
+#include <cstdlib>
+
+namespace {
+
+// Longest time a frame set may be missing before it is shown anyway (panes load it from disk)
+const qint64 MaxHoldMs = 250;
+
+// Window for achievedFps
+const qint64 FpsWindowMs = 1000;
+
+} // namespace
+
+PlaybackEngine::PlaybackEngine(QObject *parent)
+    : QObject(parent)
+    , m_imageLoaderManager(nullptr)
+    , m_ring(new FrameRing(this))
+    , m_firstFrame(1)
+    , m_lastFrame(1)
+    , m_clockFrame(1)
+    , m_currentFrame(1)
+    , m_direction(1)
+    , m_frameInterval(100)
+    , m_decodeAhead(4)  // 4 frames x 3 panes of 1080p is ~100MB of decoded images
+    , m_prerolled(false)
+    , m_achievedFps(0.0)
+    , m_droppedFrames(0)
+{
+    // Coarse timers can fire up to 5% late on Windows - too much at 33ms per frame
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &PlaybackEngine::onTick);
+}
+
+void PlaybackEngine::setImageLoaderManager(ImageLoaderManager *manager)
+{
+    m_imageLoaderManager = manager;
+    m_ring->setImageLoaderManager(manager);
+}
+
+void PlaybackEngine::setRange(int firstFrame, int lastFrame)
+{
+    if (lastFrame < firstFrame) {
+        DEBUG_LOG("PlaybackEngine") << "setRange - Invalid range:" << firstFrame << lastFrame;
+        return;
+    }
+    m_firstFrame = firstFrame;
+    m_lastFrame = lastFrame;
+    m_currentFrame = qBound(m_firstFrame, m_currentFrame, m_lastFrame);
+}
+
+void PlaybackEngine::setPaneTypes(const QStringList &imageTypes)
+{
+    m_paneTypes = imageTypes;
+    // Keep room for the decode-ahead window of every pane plus the frame on screen
+    m_ring->setCapacity(qMax(1, (m_decodeAhead + 2) * qMax(1, m_paneTypes.size())));
+}
+
+void PlaybackEngine::setFrameInterval(int ms)
+{
+    if (ms <= 0) {
+        DEBUG_LOG("PlaybackEngine") << "setFrameInterval - Invalid interval:" << ms << "(must be > 0)";
+        return;
+    }
+    if (ms == m_frameInterval) {
+        return;
+    }
+    m_frameInterval = ms;
+    if (isPlaying()) {
+        // Keep the current frame, count the new speed from here
+        rebaseClock();
+        m_timer.setInterval(qBound(4, m_frameInterval / 4, 16));
+    }
+    emit frameIntervalChanged();
+}
+
+void PlaybackEngine::setDecodeAhead(int frames)
+{
+    if (frames < 1 || frames == m_decodeAhead) {
+        return;
+    }
+    m_decodeAhead = frames;
+    setPaneTypes(m_paneTypes);  // Resize the ring
+    emit decodeAheadChanged();
+}
+
+void PlaybackEngine::start(int fromFrame, int direction)
+{
+    m_direction = direction < 0 ? -1 : 1;
+    m_currentFrame = qBound(m_firstFrame, fromFrame, m_lastFrame);
+    m_droppedFrames = 0;
+    m_achievedFps = 0.0;
+    m_presentTimes.clear();
+    m_prerolled = false;
+    m_runTimer.start();
+    m_holdTimer.start();
+    rebaseClock();
+
+    requestAhead(m_currentFrame);
+    // Tick several times per frame so the presented frame tracks the clock closely
+    m_timer.start(qBound(4, m_frameInterval / 4, 16));
+
+    DEBUG_LOG("PlaybackEngine") << "start - Frame:" << m_currentFrame << "direction:" << m_direction
+                                << "interval:" << m_frameInterval << "ms panes:" << m_paneTypes;
+    emit playingChanged();
+    emit statsChanged();
+}
+
+void PlaybackEngine::stop()
+{
+    if (!m_timer.isActive()) {
+        return;
+    }
+    m_timer.stop();
+    DEBUG_LOG("PlaybackEngine") << "stop - Achieved fps:" << m_achievedFps << "dropped frames:" << m_droppedFrames;
+    emit playingChanged();
+}
+
+void PlaybackEngine::prefetch(int frame, int direction)
+{
+    const int previousDirection = m_direction;
+    m_direction = direction < 0 ? -1 : 1;
+    requestAhead(frame);
+    m_direction = previousDirection;
+}
+
+QString PlaybackEngine::frameSource(const QString &imageType, int frameNumber) const
+{
+    if (m_ring->contains(imageType, frameNumber)) {
+        return QString("image://frames/%1/%2").arg(imageType).arg(frameNumber);
+    }
+    return m_imageLoaderManager ? m_imageLoaderManager->getImageFilePath(imageType, frameNumber) : QString();
+}
+
+int PlaybackEngine::targetFrame(int startFrame, int direction, qint64 elapsedMs, int intervalMs,
+                                int firstFrame, int lastFrame)
+{
+    if (intervalMs <= 0) {
+        return qBound(firstFrame, startFrame, lastFrame);
+    }
+    const qint64 steps = elapsedMs / intervalMs;
+    const qint64 target = startFrame + (direction < 0 ? -steps : steps);
+    return static_cast<int>(qBound<qint64>(firstFrame, target, lastFrame));
+}
+
+int PlaybackEngine::pickReadyFrame(int currentFrame, int target, const std::function<bool(int)> &isReady)
+{
+    // Newest ready frame wins - anything between it and the current frame is skipped
+    const int step = target > currentFrame ? -1 : 1;
+    for (int frame = target; frame != currentFrame; frame += step) {
+        if (isReady(frame)) {
+            return frame;
+        }
+    }
+    return currentFrame;
+}
+
+bool PlaybackEngine::isFrameSetReady(int frame) const
+{
+    // No image pane visible (e.g. table page): only the slider moves
+    return m_paneTypes.isEmpty() || m_ring->containsFrameSet(frame, m_paneTypes);
+}
+
+void PlaybackEngine::onTick()
+{
+    const int endFrame = m_direction > 0 ? m_lastFrame : m_firstFrame;
+
+    // Pre-roll: don't start the clock until the first frame is decoded, or the
+    // opening frames would all be skipped while the ring fills up
+    if (!m_prerolled) {
+        const int firstStep = m_currentFrame == endFrame ? m_currentFrame : m_currentFrame + m_direction;
+        if (!isFrameSetReady(firstStep) && m_holdTimer.elapsed() < MaxHoldMs) {
+            return;
+        }
+        m_prerolled = true;
+        rebaseClock();
+    }
+
+    const int target = targetFrame(m_clockFrame, m_direction, m_clock.elapsed(), m_frameInterval,
+                                   m_firstFrame, m_lastFrame);
+    requestAhead(target);
+
+    if (target != m_currentFrame) {
+        int frame = pickReadyFrame(m_currentFrame, target,
+                                   [this](int f) { return isFrameSetReady(f); });
+        if (frame == target || frame != m_currentFrame) {
+            m_holdTimer.restart();
+        } else if (m_holdTimer.elapsed() >= MaxHoldMs) {
+            // Nothing decoded in time (missing or very slow files) - move on anyway
+            frame = target;
+            m_holdTimer.restart();
+        }
+        if (frame != m_currentFrame) {
+            present(frame);
+        }
+    } else {
+        m_holdTimer.restart();  // Nothing due yet - not waiting on a decode
+    }
+
+    if (m_currentFrame == endFrame) {
+        stop();
+        emit finished();
+    }
+}
+
+void PlaybackEngine::requestAhead(int fromFrame)
+{
+    if (m_paneTypes.isEmpty()) {
+        return;
+    }
+
+    const int endFrame = m_direction > 0 ? m_lastFrame : m_firstFrame;
+    int frame = fromFrame;
+    for (int i = 0; i <= m_decodeAhead; ++i) {
+        for (const QString &imageType : m_paneTypes) {
+            m_ring->request(imageType, frame);
+        }
+        if (frame == endFrame) {
+            break;
+        }
+        frame += m_direction;
+    }
+
+    // Keep the frame on screen, drop everything behind it
+    const int behind = m_currentFrame;
+    m_ring->retainRange(qMin(behind, frame), qMax(behind, frame));
+}
+
+void PlaybackEngine::present(int frame)
+{
+    const int skipped = std::abs(frame - m_currentFrame) - 1;
+    if (skipped > 0) {
+        m_droppedFrames += skipped;
+    }
+    m_currentFrame = frame;
+
+    // Achieved fps over the last second of presented frames
+    const qint64 now = m_runTimer.elapsed();
+    m_presentTimes.enqueue(now);
+    while (m_presentTimes.size() > 1 && now - m_presentTimes.head() > FpsWindowMs) {
+        m_presentTimes.dequeue();
+    }
+    const qint64 span = now - m_presentTimes.head();
+    m_achievedFps = span > 0 ? (m_presentTimes.size() - 1) * 1000.0 / span : 0.0;
+
+    emit currentFrameChanged();
+    emit frameSetReady(frame);
+    emit statsChanged();
+}
+
+void PlaybackEngine::rebaseClock()
+{
+    m_clockFrame = m_currentFrame;
+    m_clock.start();
+}
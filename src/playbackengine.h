@@ -0,0 +1,177 @@
+#ifndef PLAYBACKENGINE_H
+#define PLAYBACKENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <functional>
+
+// Forward declarations
+class ImageLoaderManager;
+class FrameRing;
+
+/**
+ * @brief PlaybackEngine - Paced forward/reverse playback with decode-ahead
+ *
+ * Replaces the QML playbackTimer in TimelineChart.qml, which stepped the slider one
+ * frame per tick and let each pane load its image synchronously: a slow decode
+ * stalled the whole timeline and the real frame rate was unknown.
+ *
+ * The engine derives the frame to show from elapsed time (not from tick count),
+ * keeps a FrameRing filled with the next frames of every visible pane, and emits
+ * frameSetReady(frame) only when all visible panes have that frame decoded, so QML
+ * updates every pane in one go. If it falls behind, it skips to the newest frame
+ * set that is ready instead of waiting; skipped frames are counted in droppedFrames.
+ *
+ * Usage from QML:
+ *   playbackEngine.setRange(firstFrame, lastFrame)
+ *   playbackEngine.setPaneTypes(["A", "B", "C"])
+ *   playbackEngine.frameInterval = playbackSpeed   // ms per frame
+ *   playbackEngine.start(currentFrame, 1)          // 1 = forward, -1 = reverse
+ *   onFrameSetReady: moveTo(frame)                 // panes read playbackEngine.frameSource(type, frame)
+ */
+class PlaybackEngine : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY playingChanged)
+    Q_PROPERTY(int direction READ direction NOTIFY playingChanged)
+    Q_PROPERTY(int frameInterval READ frameInterval WRITE setFrameInterval NOTIFY frameIntervalChanged)
+    Q_PROPERTY(int decodeAhead READ decodeAhead WRITE setDecodeAhead NOTIFY decodeAheadChanged)
+    Q_PROPERTY(int currentFrame READ currentFrame NOTIFY currentFrameChanged)
+    Q_PROPERTY(double achievedFps READ achievedFps NOTIFY statsChanged)
+    Q_PROPERTY(int droppedFrames READ droppedFrames NOTIFY statsChanged)
+
+public:
+    explicit PlaybackEngine(QObject *parent = nullptr);
+
+    /**
+     * @brief Set the manager that resolves image paths
+     * @param manager - ImageLoaderManager instance (not owned)
+     */
+    void setImageLoaderManager(ImageLoaderManager *manager);
+
+    /**
+     * @brief Decoded frame cache shared with the "frames" image provider
+     */
+    FrameRing *frameRing() const { return m_ring; }
+
+    /**
+     * @brief Set the playable frame range (slider minimum/maximum)
+     */
+    Q_INVOKABLE void setRange(int firstFrame, int lastFrame);
+
+    /**
+     * @brief Set the image types of the visible panes
+     * @param imageTypes - e.g. ["A", "B", "C"] for the 3-window page; empty = no panes (slider only)
+     */
+    Q_INVOKABLE void setPaneTypes(const QStringList &imageTypes);
+
+    /**
+     * @brief Start playback
+     * @param fromFrame - Frame currently shown
+     * @param direction - 1 for forward, -1 for reverse
+     */
+    Q_INVOKABLE void start(int fromFrame, int direction);
+
+    /**
+     * @brief Stop playback (keeps the decoded frames)
+     */
+    Q_INVOKABLE void stop();
+
+    /**
+     * @brief Decode the frames after a given frame (e.g. when scrubbing pauses)
+     * @param frame - Current frame
+     * @param direction - 1 to decode forward, -1 to decode backward
+     */
+    Q_INVOKABLE void prefetch(int frame, int direction = 1);
+
+    /**
+     * @brief Get the source URL for a pane image
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number (1-indexed)
+     * @return "image://frames/<type>/<frame>" if the frame is decoded, otherwise the file URL
+     */
+    Q_INVOKABLE QString frameSource(const QString &imageType, int frameNumber) const;
+
+    bool isPlaying() const { return m_timer.isActive(); }
+    int direction() const { return m_direction; }
+    int frameInterval() const { return m_frameInterval; }
+    void setFrameInterval(int ms);
+    int decodeAhead() const { return m_decodeAhead; }
+    void setDecodeAhead(int frames);
+    int currentFrame() const { return m_currentFrame; }
+    double achievedFps() const { return m_achievedFps; }
+    int droppedFrames() const { return m_droppedFrames; }
+
+    /**
+     * @brief Frame the clock is at after a given time
+     * @param startFrame - Frame at elapsed time 0
+     * @param direction - 1 or -1
+     * @param elapsedMs - Time since startFrame was shown
+     * @param intervalMs - Milliseconds per frame
+     * @param firstFrame - First frame of the range
+     * @param lastFrame - Last frame of the range
+     * @return Target frame, clamped to [firstFrame, lastFrame]
+     */
+    static int targetFrame(int startFrame, int direction, qint64 elapsedMs, int intervalMs,
+                           int firstFrame, int lastFrame);
+
+    /**
+     * @brief Pick the frame to present between the current frame and the target
+     * @param currentFrame - Frame shown now
+     * @param target - Frame the clock is at
+     * @param isReady - Whether a frame's set is decoded
+     * @return The ready frame closest to target in (currentFrame, target], or currentFrame if none
+     */
+    static int pickReadyFrame(int currentFrame, int target, const std::function<bool(int)> &isReady);
+
+signals:
+    void playingChanged();
+    void frameIntervalChanged();
+    void decodeAheadChanged();
+    void currentFrameChanged();
+    void statsChanged();
+
+    /**
+     * @brief Every visible pane has this frame decoded - present it on all panes at once
+     */
+    void frameSetReady(int frame);
+
+    /**
+     * @brief Playback reached the end (or start, in reverse) of the range
+     */
+    void finished();
+
+private slots:
+    void onTick();
+
+private:
+    bool isFrameSetReady(int frame) const;
+    void requestAhead(int fromFrame);
+    void present(int frame);
+    void rebaseClock();
+
+    ImageLoaderManager *m_imageLoaderManager;
+    FrameRing *m_ring;
+    QTimer m_timer;
+    QElapsedTimer m_clock;          // Time since m_clockFrame was presented
+    QElapsedTimer m_holdTimer;      // Time the target has been waiting for its frame set
+    QQueue<qint64> m_presentTimes;  // Presentation timestamps of the last second (ms, m_runTimer)
+    QElapsedTimer m_runTimer;
+    QStringList m_paneTypes;
+    int m_firstFrame;
+    int m_lastFrame;
+    int m_clockFrame;               // Frame the clock counts from
+    int m_currentFrame;
+    int m_direction;
+    int m_frameInterval;
+    int m_decodeAhead;
+    bool m_prerolled;               // false until the first frame after start() is ready
+    double m_achievedFps;
+    int m_droppedFrames;
+};
+
+#endif // PLAYBACKENGINE_H
@@ -0,0 +1,348 @@
+#include "proxybuilder.h"
+#include "imageloadermanager.h"
+#include "qoicodec.h"
+#include "logger.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QFuture>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrent>
+
+namespace {
+
+const char *const kImageTypes[] = { "A", "B", "C", "D" };
+
+} // namespace
+
+ProxyBuilder::ProxyBuilder(QObject *parent)
+    : QObject(parent)
+    , m_imageLoaderManager(nullptr)
+    , m_maxDimension(DefaultMaxDimension)
+    , m_firstFrame(0)
+    , m_lastFrame(-1)
+    , m_generation(0)
+    , m_building(false)
+    , m_buildGeneration(-1)
+    , m_doneFrames(0)
+    , m_totalFrames(0)
+{
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    m_writerPool.setMaxThreadCount(1);
+    m_progressTimer.setInterval(100);
+    connect(&m_progressTimer, &QTimer::timeout, this, &ProxyBuilder::progressChanged);
+    connect(&m_watcher, &QFutureWatcher<BuildResult>::finished, this, &ProxyBuilder::onBuildFinished);
+}
+
+ProxyBuilder::~ProxyBuilder()
+{
+    cancel();
+    m_writerPool.waitForDone();
+    m_pool.waitForDone();
+}
+
+void ProxyBuilder::setImageLoaderManager(ImageLoaderManager *manager)
+{
+    if (m_imageLoaderManager) {
+        disconnect(m_imageLoaderManager, nullptr, this, nullptr);
+    }
+    m_imageLoaderManager = manager;
+    if (m_imageLoaderManager) {
+        connect(m_imageLoaderManager, &ImageLoaderManager::imagePathsChanged, this, &ProxyBuilder::closeProxies);
+    }
+}
+
+void ProxyBuilder::setCacheDirectory(const QString &path)
+{
+    m_cacheDirectory = path;
+    if (!path.isEmpty() && !QDir().mkpath(path)) {
+        WARNING_LOG("ProxyBuilder - Cannot create the proxy folder" << path << "- scrubbing without proxies");
+    }
+}
+
+void ProxyBuilder::setMaxDimension(int pixels)
+{
+    if (pixels <= 0 || pixels == m_maxDimension) {
+        return;
+    }
+    m_maxDimension = pixels;
+    emit maxDimensionChanged();
+    refresh();  // Proxies of the open event were scaled to the old limit
+}
+
+void ProxyBuilder::closeProxies()
+{
+    // Event switched: its builds and proxies no longer apply
+    cancel();
+    ++m_generation;
+    m_lastFrame = m_firstFrame - 1;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_sequences.isEmpty()) {
+            return;
+        }
+        m_sequences.clear();
+    }
+    emit proxiesChanged();
+}
+
+qint64 ProxyBuilder::sourceStamp(const QString &imageType) const
+{
+    qint64 stamp = 0;
+    for (int frameNumber : { m_firstFrame, m_lastFrame }) {
+        const QFileInfo info(m_imageLoaderManager->getImageDiskPath(imageType, frameNumber));
+        if (info.exists()) {
+            stamp = qMax(stamp, info.lastModified().toMSecsSinceEpoch());
+        }
+    }
+    return stamp;
+}
+
+void ProxyBuilder::open(int firstFrame, int lastFrame)
+{
+    if (!m_imageLoaderManager || m_cacheDirectory.isEmpty() || lastFrame < firstFrame) {
+        return;
+    }
+    closeProxies();
+    m_firstFrame = firstFrame;
+    m_lastFrame = lastFrame;
+    refresh();
+}
+
+void ProxyBuilder::refresh()
+{
+    if (!m_imageLoaderManager || m_lastFrame < m_firstFrame) {
+        return;
+    }
+    cancel();
+    ++m_generation;
+
+    QVector<Task> tasks;
+    QHash<QString, QSharedPointer<const ProxySequence>> sequences;
+    for (const char *type : kImageTypes) {
+        const QString imageType = QLatin1String(type);
+        QString basePath;
+        QString extension;
+        if (!m_imageLoaderManager->getImageTypePathAndExtension(imageType, basePath, extension) || basePath.isEmpty()) {
+            continue;
+        }
+        const qint64 stamp = sourceStamp(imageType);
+        if (stamp == 0) {
+            continue;  // No frames (e.g. no alpha images)
+        }
+        Task task;
+        task.imageType = imageType;
+        task.sourcePath = basePath + extension;
+        task.proxyPath = QDir(m_cacheDirectory).filePath(ProxySequence::fileNameFor(task.sourcePath));
+        task.sourceStamp = stamp;
+        for (int frameNumber = m_firstFrame; frameNumber <= m_lastFrame; ++frameNumber) {
+            task.filePaths.append(m_imageLoaderManager->getImageDiskPath(imageType, frameNumber));
+        }
+
+        QSharedPointer<ProxySequence> sequence(new ProxySequence());
+        if (sequence->open(task.proxyPath) && sequence->sourcePath() == task.sourcePath
+            && sequence->sourceStamp() == stamp && sequence->maxDimension() == m_maxDimension
+            && sequence->firstFrame() == m_firstFrame
+            && sequence->frameCount() == m_lastFrame - m_firstFrame + 1) {
+            sequences.insert(imageType, sequence);
+        } else {
+            tasks.append(task);
+        }
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        m_sequences = sequences;  // Re-rendered sequences stop using their old proxies
+    }
+    emit proxiesChanged();
+    if (tasks.isEmpty()) {
+        return;
+    }
+
+    m_buildGeneration = m_generation;
+    m_doneFrames = 0;
+    m_totalFrames = tasks.size() * (m_lastFrame - m_firstFrame + 1);
+    m_buildTimer.start();
+    setBuilding(true);
+    m_progressTimer.start();
+    const int firstFrame = m_firstFrame;
+    const int maxDimension = m_maxDimension;
+    const int generation = m_generation;
+    m_watcher.setFuture(QtConcurrent::run(&m_writerPool, [this, tasks, firstFrame, maxDimension, generation]() {
+        return build(tasks, firstFrame, maxDimension, generation);
+    }));
+    emit progressChanged();
+}
+
+void ProxyBuilder::cancel()
+{
+    m_buildGeneration = -1;  // The build returns after the frames in progress
+}
+
+ProxyBuilder::BuildResult ProxyBuilder::build(const QVector<Task> &tasks, int firstFrame, int maxDimension,
+                                              int generation)
+{
+    BuildResult result;
+    result.generation = generation;
+    result.success = true;
+    // Frames in flight at once: every thread busy, without holding a whole sequence in memory
+    const int batchSize = m_pool.maxThreadCount() * 4;
+
+    for (const Task &task : tasks) {
+        ProxySequenceWriter writer(task.proxyPath);
+        const int frameCount = task.filePaths.size();
+        if (!writer.begin(task.sourcePath, task.sourceStamp, maxDimension, firstFrame, frameCount)) {
+            result.success = false;
+            continue;
+        }
+        QSize sourceSize;
+        for (int batchFirst = 0; batchFirst < frameCount && !isCanceled(generation); batchFirst += batchSize) {
+            const int batchEnd = qMin(frameCount, batchFirst + batchSize);
+            QVector<QByteArray> frames(batchEnd - batchFirst);
+            QVector<QSize> sizes(frames.size());
+            QVector<QFuture<void>> futures;
+            for (int i = 0; i < frames.size(); ++i) {
+                const QString filePath = task.filePaths.at(batchFirst + i);
+                QByteArray *frame = &frames[i];
+                QSize *size = &sizes[i];
+                futures.append(QtConcurrent::run(&m_pool, [this, filePath, maxDimension, frame, size, generation]() {
+                    if (!isCanceled(generation)) {
+                        *frame = transcode(filePath, maxDimension, size);
+                        ++m_doneFrames;
+                    }
+                }));
+            }
+            for (QFuture<void> &future : futures) {
+                future.waitForFinished();
+            }
+            for (int i = 0; i < frames.size(); ++i) {
+                if (!sourceSize.isValid() && sizes.at(i).isValid()) {
+                    sourceSize = sizes.at(i);
+                }
+                if (!writer.addFrame(frames.at(i))) {
+                    result.success = false;
+                }
+            }
+        }
+        if (isCanceled(generation)) {
+            writer.cancel();
+            result.success = false;
+            break;
+        }
+        if (result.success && writer.commit(sourceSize)) {
+            result.imageTypes.append(task.imageType);
+            result.proxyPaths.append(task.proxyPath);
+        } else {
+            writer.cancel();
+            result.success = false;
+        }
+    }
+    return result;
+}
+
+QByteArray ProxyBuilder::transcode(const QString &filePath, int maxDimension, QSize *sourceSize)
+{
+    QImageReader reader(filePath);
+    const QSize size = reader.size();
+    if (size.isValid() && (size.width() > maxDimension || size.height() > maxDimension)) {
+        reader.setScaledSize(size.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio));  // JPEG: scaled DCT
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return QByteArray();
+    }
+    if (image.width() > maxDimension || image.height() > maxDimension) {
+        image = image.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    *sourceSize = size.isValid() ? size : image.size();
+    // 16-bit renders become 8-bit proxies; full resolution keeps the precision
+    return QoiCodec::encode(image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                          : QImage::Format_RGB32));
+}
+
+void ProxyBuilder::onBuildFinished()
+{
+    const BuildResult result = m_watcher.result();
+    m_progressTimer.stop();
+    if (result.generation != m_generation) {
+        // Superseded: a newer build may be running
+        setBuilding(m_watcher.isRunning());
+        return;
+    }
+
+    QStringList opened;
+    for (int i = 0; i < result.imageTypes.size(); ++i) {
+        QSharedPointer<ProxySequence> sequence(new ProxySequence());
+        if (sequence->open(result.proxyPaths.at(i))) {
+            QMutexLocker locker(&m_mutex);
+            m_sequences.insert(result.imageTypes.at(i), sequence);
+            opened.append(result.imageTypes.at(i));
+        }
+    }
+    INFO_LOG("ProxyBuilder - Scrub proxies of" << opened.join(", ") << "built in" << m_buildTimer.elapsed() << "ms"
+             << (result.success ? "" : "(incomplete)"));
+    setBuilding(false);
+    emit progressChanged();
+    emit proxiesChanged();
+    emit buildFinished(result.success);
+}
+
+void ProxyBuilder::setBuilding(bool building)
+{
+    if (m_building != building) {
+        m_building = building;
+        emit buildingChanged();
+    }
+}
+
+double ProxyBuilder::progress() const
+{
+    if (!m_building) {
+        return 0.0;
+    }
+    return m_totalFrames > 0 ? qMin(1.0, static_cast<double>(m_doneFrames) / m_totalFrames) : 0.0;
+}
+
+QStringList ProxyBuilder::proxyTypes() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList types = m_sequences.keys();
+    types.sort();
+    return types;
+}
+
+QString ProxyBuilder::frameSource(const QString &imageType, int frameNumber) const
+{
+    QMutexLocker locker(&m_mutex);
+    const QSharedPointer<const ProxySequence> sequence = m_sequences.value(imageType);
+    if (!sequence || !sequence->contains(frameNumber)) {
+        return QString();
+    }
+    return QStringLiteral("image://proxies/%1/%2").arg(imageType).arg(frameNumber);
+}
+
+bool ProxyBuilder::containsFrameSet(int frameNumber, const QStringList &imageTypes) const
+{
+    if (imageTypes.isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&m_mutex);
+    for (const QString &imageType : imageTypes) {
+        const QSharedPointer<const ProxySequence> sequence = m_sequences.value(imageType);
+        if (!sequence || !sequence->contains(frameNumber)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QImage ProxyBuilder::frame(const QString &imageType, int frameNumber) const
+{
+    QSharedPointer<const ProxySequence> sequence;
+    {
+        QMutexLocker locker(&m_mutex);
+        sequence = m_sequences.value(imageType);
+    }
+    // Decompressed outside the lock; the sequence stays mapped while referenced
+    return sequence ? sequence->frame(frameNumber) : QImage();
+}
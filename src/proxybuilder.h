@@ -0,0 +1,184 @@
+#ifndef PROXYBUILDER_H
+#define PROXYBUILDER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <atomic>
+
+#include "proxysequence.h"
+
+// Forward declaration
+class ImageLoaderManager;
+
+/**
+ * @brief ProxyBuilder - Local scrub proxies of the open event's sequences ("proxyBuilder" in QML)
+ *
+ * Scrubbing 4K JPEG sequences off a network share is bound by IO and decoding. When
+ * an event is opened (open()), every A/B/C/D sequence without an up-to-date proxy is
+ * transcoded in the background: each frame is decoded at reduced size (at most
+ * maxDimension pixels wide or high; JPEGs decode scaled) and compressed with QoiCodec
+ * into one sequential ProxySequence file per sequence in the local cache directory.
+ * Frames are transcoded on a private pool with one thread per core; progress is
+ * published for the UI.
+ *
+ * Proxies are reused by later sessions unless the sequence was re-rendered (the
+ * modification times of its first and last frames changed) or maxDimension changed.
+ * refresh() checks again, e.g. after a freeDView_tester run.
+ *
+ * FrameSetPresenter shows proxies (image://proxies, see ProxyImageProvider) while
+ * scrubbing through frames not decoded yet and switches to full resolution when
+ * scrubbing pauses; zoomed-in panes always show full resolution.
+ */
+class ProxyBuilder : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool building READ isBuilding NOTIFY buildingChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(QStringList proxyTypes READ proxyTypes NOTIFY proxiesChanged)
+    Q_PROPERTY(int maxDimension READ maxDimension WRITE setMaxDimension NOTIFY maxDimensionChanged)
+
+public:
+    static const int DefaultMaxDimension = 960;  // 4K renders at a quarter of their size
+
+    explicit ProxyBuilder(QObject *parent = nullptr);
+    ~ProxyBuilder();
+
+    /**
+     * @brief Set the manager that resolves the sequences' paths
+     * @param manager - ImageLoaderManager instance (not owned); switching events closes the proxies
+     */
+    void setImageLoaderManager(ImageLoaderManager *manager);
+
+    /**
+     * @brief Set the folder the proxy files are kept in (created if needed)
+     */
+    void setCacheDirectory(const QString &path);
+    QString cacheDirectory() const { return m_cacheDirectory; }
+
+    /**
+     * @brief Use the proxies of the current event, building those missing or out of date
+     * @param firstFrame - First frame number of the event
+     * @param lastFrame - Last frame number of the event
+     */
+    Q_INVOKABLE void open(int firstFrame, int lastFrame);
+
+    /**
+     * @brief Check the open event's proxies again and rebuild re-rendered sequences
+     */
+    Q_INVOKABLE void refresh();
+
+    /**
+     * @brief Stop building (proxies finished so far are kept)
+     */
+    Q_INVOKABLE void cancel();
+
+    /**
+     * @brief URL of a proxy frame
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     * @param frameNumber - Frame number
+     * @return "image://proxies/<type>/<frame>", or empty if there is no proxy of the frame
+     */
+    Q_INVOKABLE QString frameSource(const QString &imageType, int frameNumber) const;
+
+    /**
+     * @brief Check whether every given image type has a proxy of a frame
+     * @return false for an empty type list
+     */
+    bool containsFrameSet(int frameNumber, const QStringList &imageTypes) const;
+
+    /**
+     * @brief Decompress a proxy frame (any thread)
+     * @return Reduced-size frame, or null image if there is no proxy of it
+     */
+    QImage frame(const QString &imageType, int frameNumber) const;
+
+    bool isBuilding() const { return m_building; }
+    double progress() const;
+    QStringList proxyTypes() const;
+    int maxDimension() const { return m_maxDimension; }
+    void setMaxDimension(int pixels);
+
+signals:
+    void buildingChanged();
+    void progressChanged();
+    void proxiesChanged();
+    void maxDimensionChanged();
+
+    /**
+     * @brief Emitted when a build ends
+     * @param success - false if canceled or a proxy file couldn't be written
+     */
+    void buildFinished(bool success);
+
+private slots:
+    void onBuildFinished();
+
+private:
+    struct Task
+    {
+        QString imageType;
+        QString sourcePath;  // Folder of the frames
+        QString proxyPath;
+        qint64 sourceStamp;
+        QStringList filePaths;  // Frames in order
+    };
+
+    struct BuildResult
+    {
+        int generation;
+        bool success;
+        QStringList imageTypes;  // Built
+        QStringList proxyPaths;
+    };
+
+    /**
+     * @brief Modification stamp of a sequence (its first and last frames), 0 if neither exists
+     */
+    qint64 sourceStamp(const QString &imageType) const;
+
+    /**
+     * @brief Write the proxy files of some sequences (coordinator thread)
+     */
+    BuildResult build(const QVector<Task> &tasks, int firstFrame, int maxDimension, int generation);
+
+    /**
+     * @brief Decode one frame at proxy size and compress it (transcoding pool)
+     * @param maxDimension - Proxy size limit of the build
+     * @param sourceSize - Set to the full-resolution size
+     * @return QoiCodec stream, or empty if the frame can't be read
+     */
+    static QByteArray transcode(const QString &filePath, int maxDimension, QSize *sourceSize);
+
+    bool isCanceled(int generation) const { return m_buildGeneration != generation; }
+
+    void closeProxies();
+    void setBuilding(bool building);
+
+    ImageLoaderManager *m_imageLoaderManager;
+    QString m_cacheDirectory;
+    int m_maxDimension;
+    int m_firstFrame;
+    int m_lastFrame;       // < m_firstFrame while no event is open
+    int m_generation;      // Bumped when the event changes, so older builds are ignored
+    bool m_building;
+    std::atomic<int> m_buildGeneration;  // Build allowed to continue; cancel() stops any
+    std::atomic<int> m_doneFrames;
+    int m_totalFrames;
+    mutable QMutex m_mutex;  // Guards m_sequences for frame() on other threads
+    QHash<QString, QSharedPointer<const ProxySequence>> m_sequences;
+    QFutureWatcher<BuildResult> m_watcher;
+    QElapsedTimer m_buildTimer;
+    QTimer m_progressTimer;      // Publishes m_doneFrames while building
+    QThreadPool m_pool;          // Transcoding, one thread per core
+    QThreadPool m_writerPool;    // Coordinates a build and writes the files
+};
+
+#endif // PROXYBUILDER_H
@@ -0,0 +1,38 @@
+#include "proxyimageprovider.h"
+#include "proxybuilder.h"
+#include "tonemapper.h"
+#include "logger.h"
+
+ProxyImageProvider::ProxyImageProvider(ProxyBuilder *builder, ToneMapper *toneMapper)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_builder(builder)
+    , m_toneMapper(toneMapper)
+{
+}
+
+QImage ProxyImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    // id: "<type>/<frame>[/<tone mapper revision>]", e.g. "A/388"
+    const QStringList parts = id.split('/');
+    bool ok = false;
+    const int frameNumber = parts.size() == 2 || parts.size() == 3 ? parts.at(1).toInt(&ok) : 0;
+    if (!ok) {
+        DEBUG_LOG("ProxyImageProvider") << "requestImage - Invalid id:" << id;
+        return QImage();
+    }
+    const QString imageType = parts.at(0);
+
+    QImage image = m_builder ? m_builder->frame(imageType, frameNumber) : QImage();
+    if (size) {
+        *size = image.size();
+    }
+    // Only ever scaled down: proxies are already small, the scene graph scales them up
+    if (!image.isNull() && requestedSize.width() > 0 && requestedSize.height() > 0
+        && (requestedSize.width() < image.width() || requestedSize.height() < image.height())) {
+        image = image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    if (m_toneMapper && m_toneMapper->appliesTo(imageType)) {
+        image = m_toneMapper->apply(image);
+    }
+    return image;
+}
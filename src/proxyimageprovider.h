@@ -0,0 +1,34 @@
+#ifndef PROXYIMAGEPROVIDER_H
+#define PROXYIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+// Forward declarations
+class ProxyBuilder;
+class ToneMapper;
+
+/**
+ * @brief ProxyImageProvider - Serves scrub proxies from ProxyBuilder to QML ("image://proxies/<type>/<frame>")
+ *
+ * Frames are decompressed from the memory-mapped proxy files, which is much faster than
+ * decoding the full-resolution JPEGs. Panes show them scaled up to fit until
+ * FrameSetPresenter switches back to full resolution. Like FrameImageProvider, a tone
+ * mapper revision may be appended to the id and the frames are tone mapped for display.
+ */
+class ProxyImageProvider : public QQuickImageProvider
+{
+public:
+    /**
+     * @param builder - Proxy files of the open event (not owned)
+     * @param toneMapper - Display exposure and curve (not owned, may be null)
+     */
+    ProxyImageProvider(ProxyBuilder *builder, ToneMapper *toneMapper);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    ProxyBuilder *m_builder;
+    ToneMapper *m_toneMapper;
+};
+
+#endif // PROXYIMAGEPROVIDER_H
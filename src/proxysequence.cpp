@@ -0,0 +1,170 @@
+#include "proxysequence.h"
+#include "qoicodec.h"
+#include "logger.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+
+namespace {
+
+const quint32 kMagic = 0x52435058;  // "RCPX"
+const quint32 kVersion = 2;  // 2: proxy size limit
+
+// Bytes of an index entry: qint64 offset, qint32 size
+const qint64 kEntryBytes = 12;
+
+} // namespace
+
+ProxySequence::ProxySequence()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_sourceStamp(0)
+    , m_maxDimension(0)
+    , m_firstFrame(0)
+{
+}
+
+QString ProxySequence::fileNameFor(const QString &sourcePath)
+{
+    const QByteArray hash = QCryptographicHash::hash(QDir::cleanPath(sourcePath).toUtf8(), QCryptographicHash::Sha1);
+    return QString::fromLatin1(hash.toHex()) + QStringLiteral(".rcproxy");
+}
+
+bool ProxySequence::open(const QString &filePath)
+{
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    m_size = m_file.size();
+
+    // Header and index are read from the file, not the mapping: proxies of long sequences exceed 2 GB
+    QDataStream stream(&m_file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 frameCount = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    stream >> magic >> version;
+    if (magic == kMagic && version == kVersion) {
+        stream >> m_sourcePath >> m_sourceStamp >> m_maxDimension >> m_firstFrame >> frameCount >> width >> height;
+    }
+    bool valid = stream.status() == QDataStream::Ok && magic == kMagic && version == kVersion && frameCount >= 0;
+    // A truncated or damaged file must not make us allocate an index it can't hold
+    if (valid && qint64(frameCount) * kEntryBytes > m_size - m_file.pos()) {
+        valid = false;
+    }
+    if (valid) {
+        m_sourceSize = QSize(width, height);
+        m_index.resize(frameCount);
+        for (Entry &entry : m_index) {
+            stream >> entry.offset >> entry.size;
+        }
+        const qint64 dataStart = m_file.pos();
+        valid = stream.status() == QDataStream::Ok;
+        for (const Entry &entry : m_index) {
+            if (entry.size < 0 || (entry.size > 0 && (entry.offset < dataStart || entry.offset + entry.size > m_size))) {
+                valid = false;
+                break;
+            }
+        }
+    }
+    if (!valid) {
+        DEBUG_LOG("ProxySequence") << "open - Not a valid proxy file:" << filePath;
+        m_file.close();
+        m_index.clear();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        DEBUG_LOG("ProxySequence") << "open - Cannot map:" << filePath;
+        m_file.close();
+        m_index.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ProxySequence::contains(int frameNumber) const
+{
+    const int i = frameNumber - m_firstFrame;
+    return i >= 0 && i < m_index.size() && m_index.at(i).size > 0;
+}
+
+QImage ProxySequence::frame(int frameNumber) const
+{
+    if (!contains(frameNumber)) {
+        return QImage();
+    }
+    const Entry &entry = m_index.at(frameNumber - m_firstFrame);
+    return QoiCodec::decode(QByteArray::fromRawData(reinterpret_cast<const char *>(m_data + entry.offset), entry.size));
+}
+
+ProxySequenceWriter::ProxySequenceWriter(const QString &filePath)
+    : m_file(filePath)
+    , m_sourceStamp(0)
+    , m_maxDimension(0)
+    , m_firstFrame(0)
+    , m_frameCount(0)
+{
+}
+
+bool ProxySequenceWriter::begin(const QString &sourcePath, qint64 sourceStamp, int maxDimension, int firstFrame,
+                                int frameCount)
+{
+    m_sourcePath = sourcePath;
+    m_sourceStamp = sourceStamp;
+    m_maxDimension = maxDimension;
+    m_firstFrame = firstFrame;
+    m_frameCount = frameCount;
+    m_offsets.clear();
+    m_sizes.clear();
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        ERROR_LOG("ProxySequenceWriter::begin - Cannot write" << m_file.fileName() << ":" << m_file.errorString());
+        return false;
+    }
+    return writeHeader(QSize());  // Placeholder of the same size, filled in by commit()
+}
+
+bool ProxySequenceWriter::writeHeader(const QSize &sourceSize)
+{
+    QDataStream stream(&m_file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << kMagic << kVersion << m_sourcePath << m_sourceStamp << qint32(m_maxDimension) << qint32(m_firstFrame)
+           << qint32(m_frameCount) << qint32(sourceSize.width()) << qint32(sourceSize.height());
+    for (int i = 0; i < m_frameCount; ++i) {
+        stream << m_offsets.value(i, 0) << m_sizes.value(i, 0);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+bool ProxySequenceWriter::addFrame(const QByteArray &data)
+{
+    if (m_offsets.size() >= m_frameCount) {
+        return false;
+    }
+    m_offsets.append(m_file.pos());
+    m_sizes.append(data.size());
+    return data.isEmpty() || m_file.write(data) == data.size();
+}
+
+bool ProxySequenceWriter::commit(const QSize &sourceSize)
+{
+    if (m_offsets.size() != m_frameCount || !m_file.seek(0) || !writeHeader(sourceSize)) {
+        cancel();
+        return false;
+    }
+    if (!m_file.commit()) {
+        ERROR_LOG("ProxySequenceWriter::commit - Cannot write" << m_file.fileName() << ":" << m_file.errorString());
+        return false;
+    }
+    return true;
+}
+
+void ProxySequenceWriter::cancel()
+{
+    m_file.cancelWriting();
+    m_file.commit();  // Discards the temporary file
+}
@@ -0,0 +1,135 @@
+#ifndef PROXYSEQUENCE_H
+#define PROXYSEQUENCE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QSaveFile>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief ProxySequence - Reduced-resolution copy of one image sequence in a single local file
+ *
+ * Written by ProxyBuilder into the local cache directory, so scrubbing doesn't read
+ * and decode full-resolution JPEGs from the (network) results share. Layout:
+ *
+ * - Header: magic "RCPX", version, source folder, source stamp, proxy size limit,
+ *   first frame, frame count, source image size
+ * - Index: offset and size of every frame (size 0 = no proxy for that frame)
+ * - Frames: QoiCodec streams, in frame order
+ *
+ * The file is memory-mapped; frame() decompresses straight from the mapping. An
+ * open sequence is never modified, so it can be read from any thread.
+ */
+class ProxySequence
+{
+public:
+    ProxySequence();
+
+    /**
+     * @brief Map a proxy file
+     * @param filePath - File written by ProxySequenceWriter
+     * @return false if missing, of another version, or damaged
+     */
+    bool open(const QString &filePath);
+
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief Proxy file name for a sequence (hash of its folder, so any path fits)
+     * @param sourcePath - Folder of the full-resolution frames, e.g. ".../images/A/"
+     */
+    static QString fileNameFor(const QString &sourcePath);
+
+    QString sourcePath() const { return m_sourcePath; }
+    qint64 sourceStamp() const { return m_sourceStamp; }
+    int maxDimension() const { return m_maxDimension; }
+    int firstFrame() const { return m_firstFrame; }
+    int frameCount() const { return m_index.size(); }
+    QSize sourceSize() const { return m_sourceSize; }
+
+    /**
+     * @brief Check whether the sequence has a proxy of a frame
+     */
+    bool contains(int frameNumber) const;
+
+    /**
+     * @brief Decompress a proxy frame
+     * @return Format_RGB32 / Format_ARGB32 image, or null image if not contained
+     */
+    QImage frame(int frameNumber) const;
+
+private:
+    struct Entry
+    {
+        qint64 offset;
+        qint32 size;
+    };
+
+    QFile m_file;
+    const uchar *m_data;  // Mapping of the whole file
+    qint64 m_size;
+    QString m_sourcePath;
+    qint64 m_sourceStamp;
+    int m_maxDimension;
+    int m_firstFrame;
+    QSize m_sourceSize;
+    QVector<Entry> m_index;
+};
+
+/**
+ * @brief ProxySequenceWriter - Writes a ProxySequence file frame by frame
+ *
+ * Frames are appended in order as they are transcoded; the header and index are
+ * filled in by commit(). The file only replaces an existing one once committed.
+ */
+class ProxySequenceWriter
+{
+public:
+    explicit ProxySequenceWriter(const QString &filePath);
+
+    /**
+     * @brief Start the file
+     * @param sourcePath - Folder of the full-resolution frames
+     * @param sourceStamp - Modification stamp of the frames, to detect re-renders
+     * @param maxDimension - Size limit the frames were scaled to, to detect a changed setting
+     * @param firstFrame - First frame number
+     * @param frameCount - Number of frames (frames without a proxy are added empty)
+     * @return false if the file can't be written
+     */
+    bool begin(const QString &sourcePath, qint64 sourceStamp, int maxDimension, int firstFrame, int frameCount);
+
+    /**
+     * @brief Append the next frame
+     * @param data - QoiCodec stream, or empty if the frame has no proxy
+     */
+    bool addFrame(const QByteArray &data);
+
+    /**
+     * @brief Write the header and index and replace the file
+     * @param sourceSize - Size of the full-resolution frames
+     * @return false if writing failed or not every frame was added
+     */
+    bool commit(const QSize &sourceSize);
+
+    /**
+     * @brief Discard the file (an existing one is kept)
+     */
+    void cancel();
+
+private:
+    bool writeHeader(const QSize &sourceSize);
+
+    QSaveFile m_file;
+    QString m_sourcePath;
+    qint64 m_sourceStamp;
+    int m_maxDimension;
+    int m_firstFrame;
+    int m_frameCount;
+    QVector<qint64> m_offsets;
+    QVector<qint32> m_sizes;
+};
+
+#endif // PROXYSEQUENCE_H
@@ -0,0 +1,202 @@
+#include "qoicodec.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const quint8 kOpIndex = 0x00;  // 00xxxxxx - pixel from the index
+const quint8 kOpDiff = 0x40;   // 01xxxxxx - small difference from the previous pixel
+const quint8 kOpLuma = 0x80;   // 10xxxxxx - green difference, red/blue relative to it
+const quint8 kOpRun = 0xc0;    // 11xxxxxx - repeat the previous pixel
+const quint8 kOpRgb = 0xfe;
+const quint8 kOpRgba = 0xff;
+const quint8 kMask2 = 0xc0;
+
+const int kHeaderSize = 14;
+const int kPaddingSize = 8;
+const quint8 kPadding[kPaddingSize] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+const int kMaxRun = 62;
+const QRgb kStartPixel = 0xff000000;  // Opaque black
+
+inline int indexOf(QRgb pixel)
+{
+    return (qRed(pixel) * 3 + qGreen(pixel) * 5 + qBlue(pixel) * 7 + qAlpha(pixel) * 11) % 64;
+}
+
+inline void writeUInt32(quint8 *&out, quint32 value)
+{
+    *out++ = static_cast<quint8>(value >> 24);
+    *out++ = static_cast<quint8>(value >> 16);
+    *out++ = static_cast<quint8>(value >> 8);
+    *out++ = static_cast<quint8>(value);
+}
+
+inline quint32 readUInt32(const quint8 *in)
+{
+    return (quint32(in[0]) << 24) | (quint32(in[1]) << 16) | (quint32(in[2]) << 8) | quint32(in[3]);
+}
+
+} // namespace
+
+bool QoiCodec::canEncode(const QImage &image)
+{
+    return !image.isNull()
+           && (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32);
+}
+
+QByteArray QoiCodec::encode(const QImage &image)
+{
+    if (!canEncode(image)) {
+        return QByteArray();
+    }
+    const int width = image.width();
+    const int height = image.height();
+    const bool hasAlpha = image.format() == QImage::Format_ARGB32;
+    const QRgb opaque = hasAlpha ? 0u : 0xff000000u;  // RGB32 alpha bytes are meant to be 0xff
+
+    // Worst case: every pixel a literal RGBA op
+    const qint64 maxSize = kHeaderSize + qint64(width) * height * 5 + kPaddingSize;
+    if (maxSize > std::numeric_limits<int>::max()) {
+        return QByteArray();
+    }
+    QByteArray data(static_cast<int>(maxSize), Qt::Uninitialized);
+    quint8 *out = reinterpret_cast<quint8 *>(data.data());
+    *out++ = 'q';
+    *out++ = 'o';
+    *out++ = 'i';
+    *out++ = 'f';
+    writeUInt32(out, static_cast<quint32>(width));
+    writeUInt32(out, static_cast<quint32>(height));
+    *out++ = hasAlpha ? 4 : 3;
+    *out++ = 0;  // sRGB with linear alpha
+
+    QRgb index[64];
+    std::memset(index, 0, sizeof(index));
+    QRgb previous = kStartPixel;
+    int run = 0;
+    for (int y = 0; y < height; ++y) {
+        const QRgb *row = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            const QRgb pixel = row[x] | opaque;
+            if (pixel == previous) {
+                if (++run == kMaxRun) {
+                    *out++ = kOpRun | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                *out++ = kOpRun | (run - 1);
+                run = 0;
+            }
+
+            const int slot = indexOf(pixel);
+            if (index[slot] == pixel) {
+                *out++ = kOpIndex | slot;
+            } else {
+                index[slot] = pixel;
+                if (qAlpha(pixel) == qAlpha(previous)) {
+                    const signed char dr = static_cast<signed char>(qRed(pixel) - qRed(previous));
+                    const signed char dg = static_cast<signed char>(qGreen(pixel) - qGreen(previous));
+                    const signed char db = static_cast<signed char>(qBlue(pixel) - qBlue(previous));
+                    const int drg = dr - dg;
+                    const int dbg = db - dg;
+                    if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                        *out++ = kOpDiff | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+                    } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+                        *out++ = kOpLuma | (dg + 32);
+                        *out++ = static_cast<quint8>(((drg + 8) << 4) | (dbg + 8));
+                    } else {
+                        *out++ = kOpRgb;
+                        *out++ = static_cast<quint8>(qRed(pixel));
+                        *out++ = static_cast<quint8>(qGreen(pixel));
+                        *out++ = static_cast<quint8>(qBlue(pixel));
+                    }
+                } else {
+                    *out++ = kOpRgba;
+                    *out++ = static_cast<quint8>(qRed(pixel));
+                    *out++ = static_cast<quint8>(qGreen(pixel));
+                    *out++ = static_cast<quint8>(qBlue(pixel));
+                    *out++ = static_cast<quint8>(qAlpha(pixel));
+                }
+            }
+            previous = pixel;
+        }
+    }
+    if (run > 0) {
+        *out++ = kOpRun | (run - 1);
+    }
+    std::memcpy(out, kPadding, kPaddingSize);
+    out += kPaddingSize;
+
+    data.resize(static_cast<int>(out - reinterpret_cast<quint8 *>(data.data())));
+    data.squeeze();  // Held for a long time: don't keep the worst-case allocation
+    return data;
+}
+
+QImage QoiCodec::decode(const QByteArray &data)
+{
+    if (data.size() < kHeaderSize + kPaddingSize || !data.startsWith("qoif")) {
+        return QImage();
+    }
+    const quint8 *in = reinterpret_cast<const quint8 *>(data.constData());
+    const quint32 width = readUInt32(in + 4);
+    const quint32 height = readUInt32(in + 8);
+    const int channels = in[12];
+    if (width == 0 || height == 0 || width > 65535 || height > 65535 || (channels != 3 && channels != 4)) {
+        return QImage();
+    }
+
+    QImage image(static_cast<int>(width), static_cast<int>(height),
+                 channels == 4 ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    if (image.isNull()) {
+        return QImage();  // Out of memory
+    }
+
+    // Every op starts before the padding, so reading its up to 5 bytes stays inside the stream
+    const quint8 *p = in + kHeaderSize;
+    const quint8 *chunksEnd = in + data.size() - kPaddingSize;
+    QRgb index[64];
+    std::memset(index, 0, sizeof(index));
+    QRgb pixel = kStartPixel;
+    int run = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            if (run > 0) {
+                --run;
+            } else {
+                if (p >= chunksEnd) {
+                    return QImage();  // Truncated
+                }
+                const quint8 op = *p++;
+                if (op == kOpRgb) {
+                    pixel = qRgba(p[0], p[1], p[2], qAlpha(pixel));
+                    p += 3;
+                } else if (op == kOpRgba) {
+                    pixel = qRgba(p[0], p[1], p[2], p[3]);
+                    p += 4;
+                } else if ((op & kMask2) == kOpIndex) {
+                    pixel = index[op];
+                } else if ((op & kMask2) == kOpDiff) {
+                    pixel = qRgba((qRed(pixel) + ((op >> 4) & 3) - 2) & 0xff,
+                                  (qGreen(pixel) + ((op >> 2) & 3) - 2) & 0xff,
+                                  (qBlue(pixel) + (op & 3) - 2) & 0xff,
+                                  qAlpha(pixel));
+                } else if ((op & kMask2) == kOpLuma) {
+                    const int dg = (op & 0x3f) - 32;
+                    const quint8 next = *p++;
+                    pixel = qRgba((qRed(pixel) + dg - 8 + ((next >> 4) & 0x0f)) & 0xff,
+                                  (qGreen(pixel) + dg) & 0xff,
+                                  (qBlue(pixel) + dg - 8 + (next & 0x0f)) & 0xff,
+                                  qAlpha(pixel));
+                } else {
+                    run = op & 0x3f;
+                }
+                index[indexOf(pixel)] = pixel;
+            }
+            row[x] = pixel;
+        }
+    }
+    return image;
+}
@@ -0,0 +1,44 @@
+#ifndef QOICODEC_H
+#define QOICODEC_H
+
+#include <QByteArray>
+#include <QImage>
+
+/**
+ * @brief QoiCodec - Lossless in-memory compression of decoded frames (QOI format)
+ *
+ * Used by the compressed frame tier (CompressedFrameCache): frames dropped from
+ * FrameRing are kept compressed, and decompressing one is several times faster
+ * than decoding the JPEG/PNG again. QOI codes each pixel as a run of the previous
+ * pixel, a reference to a recently seen pixel, a small difference from the
+ * previous pixel, or the literal value - one pass, no entropy coding. Renders with
+ * flat backgrounds and smooth gradients shrink to a fraction of their raw size.
+ *
+ * Streams follow the QOI specification (header, ops, end marker), so they can be
+ * dumped to .qoi files for inspection.
+ */
+struct QoiCodec
+{
+    /**
+     * @brief Check whether an image can be encoded without loss
+     * @param image - Decoded frame
+     * @return true for Format_RGB32 and Format_ARGB32 (16-bit and other formats are not encoded)
+     */
+    static bool canEncode(const QImage &image);
+
+    /**
+     * @brief Compress an image
+     * @param image - Format_RGB32 or Format_ARGB32
+     * @return QOI stream, or empty if the image can't be encoded
+     */
+    static QByteArray encode(const QImage &image);
+
+    /**
+     * @brief Decompress an image
+     * @param data - QOI stream from encode()
+     * @return Format_RGB32 (3 channels) or Format_ARGB32 (4 channels) image, or null image if the stream is invalid
+     */
+    static QImage decode(const QByteArray &data);
+};
+
+#endif // QOICODEC_H
@@ -0,0 +1,317 @@
+#include "roistats.h"
+#include <QtAlgorithms>
+#include <cmath>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Running sums over the compared pixels
+ */
+struct Sums
+{
+    qint64 absDiff = 0;
+    qint64 squaredDiff = 0;
+    qint64 changed = 0;
+    int maxDiff = 0;
+};
+
+// 16-bit values of an 8-bit step (8-bit images convert to 16 bits as v * 257)
+const int kWideScale = 257;
+
+void accumulateRowScalar(const QRgb *a, const QRgb *b, int count, int threshold, Sums &sums)
+{
+    for (int x = 0; x < count; ++x) {
+        const int dr = qAbs(qRed(a[x]) - qRed(b[x]));
+        const int dg = qAbs(qGreen(a[x]) - qGreen(b[x]));
+        const int db = qAbs(qBlue(a[x]) - qBlue(b[x]));
+        const int maxChannel = qMax(dr, qMax(dg, db));
+        sums.absDiff += dr + dg + db;
+        sums.squaredDiff += dr * dr + dg * dg + db * db;
+        sums.maxDiff = qMax(sums.maxDiff, maxChannel);
+        sums.changed += maxChannel > threshold ? 1 : 0;
+    }
+}
+
+#ifdef __SSE2__
+// Pixels per pass between flushes of the 32-bit squared-difference lanes:
+// each lane gains at most 2 * 2 * 255^2 per 4 pixels, so 16384 pixels stay below 2^31
+const int kSimdChunk = 16384;
+
+void accumulateRowSse2(const QRgb *a, const QRgb *b, int count, int threshold, Sums &sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+    const __m128i thresholdBytes = _mm_set1_epi8(static_cast<char>(threshold));
+    __m128i maxDiff = zero;
+
+    int x = 0;
+    while (x + 4 <= count) {
+        const int chunkEnd = qMin(count, x + kSimdChunk);
+        __m128i absDiff = zero;      // 2 x 64-bit (psadbw)
+        __m128i squaredDiff = zero;  // 4 x 32-bit
+        for (; x + 4 <= chunkEnd; x += 4) {
+            const __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x));
+            const __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x));
+            // |a - b| per byte, alpha bytes cleared
+            const __m128i diff = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(pa, pb), _mm_subs_epu8(pb, pa)), rgbMask);
+            absDiff = _mm_add_epi64(absDiff, _mm_sad_epu8(diff, zero));
+            const __m128i low = _mm_unpacklo_epi8(diff, zero);
+            const __m128i high = _mm_unpackhi_epi8(diff, zero);
+            squaredDiff = _mm_add_epi32(squaredDiff, _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high)));
+            maxDiff = _mm_max_epu8(maxDiff, diff);
+            // A pixel is unchanged if no channel exceeds the threshold
+            const __m128i over = _mm_subs_epu8(diff, thresholdBytes);
+            const int unchanged = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(over, zero)));
+            sums.changed += 4 - qPopulationCount(static_cast<quint32>(unchanged));
+        }
+
+        alignas(16) qint64 absLanes[2];
+        alignas(16) qint32 squaredLanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(absLanes), absDiff);
+        _mm_store_si128(reinterpret_cast<__m128i *>(squaredLanes), squaredDiff);
+        sums.absDiff += absLanes[0] + absLanes[1];
+        sums.squaredDiff += static_cast<qint64>(squaredLanes[0]) + squaredLanes[1] + squaredLanes[2] + squaredLanes[3];
+    }
+
+    alignas(16) quint8 maxBytes[16];
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxBytes), maxDiff);
+    for (quint8 value : maxBytes) {
+        sums.maxDiff = qMax(sums.maxDiff, static_cast<int>(value));
+    }
+
+    // Last 0-3 pixels
+    accumulateRowScalar(a + x, b + x, count - x, threshold, sums);
+}
+#endif
+
+/**
+ * @brief accumulateRowScalar() for 16-bit channels (RGBA64: R, G, B, A words per pixel)
+ */
+void accumulateRowScalarWide(const quint16 *a, const quint16 *b, int count, int threshold, Sums &sums)
+{
+    for (int x = 0; x < count; ++x, a += 4, b += 4) {
+        const int dr = qAbs(int(a[0]) - int(b[0]));
+        const int dg = qAbs(int(a[1]) - int(b[1]));
+        const int db = qAbs(int(a[2]) - int(b[2]));
+        const int maxChannel = qMax(dr, qMax(dg, db));
+        sums.absDiff += dr + dg + db;
+        sums.squaredDiff += qint64(dr) * dr + qint64(dg) * dg + qint64(db) * db;
+        sums.maxDiff = qMax(sums.maxDiff, maxChannel);
+        sums.changed += maxChannel > threshold ? 1 : 0;
+    }
+}
+
+#ifdef __SSE2__
+/**
+ * @brief accumulateRowSse2() for 16-bit channels, two pixels per register
+ *
+ * Squares no longer fit 16-bit multiplies: differences are widened to 32 bits and
+ * squared into 64-bit lanes (pmuludq). SSE2 has no unsigned 16-bit max, so the
+ * maximum is taken on sign-flipped words.
+ */
+void accumulateRowSse2Wide(const quint16 *a, const quint16 *b, int count, int threshold, Sums &sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i thresholdWords = _mm_set1_epi16(static_cast<short>(threshold));
+    const __m128i signFlip = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i maxDiff = signFlip;  // 0, sign-flipped
+
+    int x = 0;
+    while (x + 2 <= count) {
+        // Each 32-bit lane gains at most 2 * 65535 per 2 pixels: flush well below 2^31
+        const int chunkEnd = qMin(count, x + kSimdChunk);
+        __m128i absDiff = zero;      // 4 x 32-bit
+        __m128i squaredDiff = zero;  // 2 x 64-bit
+        for (; x + 2 <= chunkEnd; x += 2) {
+            const __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 4 * x));
+            const __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 4 * x));
+            // |a - b| per word, alpha words cleared
+            const __m128i diff = _mm_and_si128(_mm_or_si128(_mm_subs_epu16(pa, pb), _mm_subs_epu16(pb, pa)), rgbMask);
+            const __m128i low = _mm_unpacklo_epi16(diff, zero);
+            const __m128i high = _mm_unpackhi_epi16(diff, zero);
+            absDiff = _mm_add_epi32(absDiff, _mm_add_epi32(low, high));
+            squaredDiff = _mm_add_epi64(squaredDiff, _mm_mul_epu32(low, low));
+            squaredDiff = _mm_add_epi64(squaredDiff, _mm_mul_epu32(_mm_srli_epi64(low, 32), _mm_srli_epi64(low, 32)));
+            squaredDiff = _mm_add_epi64(squaredDiff, _mm_mul_epu32(high, high));
+            squaredDiff = _mm_add_epi64(squaredDiff, _mm_mul_epu32(_mm_srli_epi64(high, 32), _mm_srli_epi64(high, 32)));
+            maxDiff = _mm_max_epi16(maxDiff, _mm_xor_si128(diff, signFlip));
+            // A pixel is unchanged if all four of its words are within the threshold
+            const __m128i over = _mm_subs_epu16(diff, thresholdWords);
+            const int unchanged = _mm_movemask_epi8(_mm_cmpeq_epi16(over, zero));
+            sums.changed += ((unchanged & 0xff) != 0xff ? 1 : 0) + ((unchanged >> 8) != 0xff ? 1 : 0);
+        }
+
+        alignas(16) qint32 absLanes[4];
+        alignas(16) qint64 squaredLanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(absLanes), absDiff);
+        _mm_store_si128(reinterpret_cast<__m128i *>(squaredLanes), squaredDiff);
+        sums.absDiff += static_cast<qint64>(absLanes[0]) + absLanes[1] + absLanes[2] + absLanes[3];
+        sums.squaredDiff += squaredLanes[0] + squaredLanes[1];
+    }
+
+    alignas(16) quint16 maxWords[8];
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxWords), _mm_xor_si128(maxDiff, signFlip));
+    for (quint16 value : maxWords) {
+        sums.maxDiff = qMax(sums.maxDiff, static_cast<int>(value));
+    }
+
+    // Last pixel
+    accumulateRowScalarWide(a + 4 * x, b + 4 * x, count - x, threshold, sums);
+}
+#endif
+
+/**
+ * @brief The region of an image as 32-bit pixels, converting only that region if needed
+ * @param image - Source image
+ * @param area - Region (inside the image)
+ * @param origin - Output: top-left of the region in the returned image
+ */
+QImage pixels32(const QImage &image, const QRect &area, QPoint &origin)
+{
+    switch (image.format()) {
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        origin = area.topLeft();
+        return image;
+    default:
+        origin = QPoint(0, 0);
+        return image.copy(area).convertToFormat(QImage::Format_RGB32);
+    }
+}
+
+/**
+ * @brief pixels32() for 16-bit comparisons: the region as RGBA64, converting only that region if needed
+ */
+QImage pixels64(const QImage &image, const QRect &area, QPoint &origin)
+{
+    switch (image.format()) {
+    case QImage::Format_RGBA64:
+    case QImage::Format_RGBX64:
+    case QImage::Format_RGBA64_Premultiplied:
+        origin = area.topLeft();
+        return image;
+    default:
+        origin = QPoint(0, 0);
+        return image.copy(area).convertToFormat(QImage::Format_RGBA64);
+    }
+}
+
+/**
+ * @brief Sums over 8-bit channels (32-bit pixels)
+ */
+Sums sumNarrow(const QImage &a, const QImage &b, const QRect &area, int threshold, bool simd)
+{
+    QPoint originA;
+    QPoint originB;
+    const QImage imageA = pixels32(a, area, originA);
+    const QImage imageB = pixels32(b, area, originB);
+
+    Sums sums;
+    for (int y = 0; y < area.height(); ++y) {
+        const QRgb *rowA = reinterpret_cast<const QRgb *>(imageA.constScanLine(originA.y() + y)) + originA.x();
+        const QRgb *rowB = reinterpret_cast<const QRgb *>(imageB.constScanLine(originB.y() + y)) + originB.x();
+#ifdef __SSE2__
+        if (simd) {
+            accumulateRowSse2(rowA, rowB, area.width(), threshold, sums);
+            continue;
+        }
+#else
+        Q_UNUSED(simd);
+#endif
+        accumulateRowScalar(rowA, rowB, area.width(), threshold, sums);
+    }
+    return sums;
+}
+
+/**
+ * @brief Sums over 16-bit channels (64-bit pixels); threshold on the 16-bit scale
+ */
+Sums sumWide(const QImage &a, const QImage &b, const QRect &area, int threshold, bool simd)
+{
+    QPoint originA;
+    QPoint originB;
+    const QImage imageA = pixels64(a, area, originA);
+    const QImage imageB = pixels64(b, area, originB);
+
+    Sums sums;
+    for (int y = 0; y < area.height(); ++y) {
+        const quint16 *rowA = reinterpret_cast<const quint16 *>(imageA.constScanLine(originA.y() + y)) + 4 * originA.x();
+        const quint16 *rowB = reinterpret_cast<const quint16 *>(imageB.constScanLine(originB.y() + y)) + 4 * originB.x();
+#ifdef __SSE2__
+        if (simd) {
+            accumulateRowSse2Wide(rowA, rowB, area.width(), threshold, sums);
+            continue;
+        }
+#else
+        Q_UNUSED(simd);
+#endif
+        accumulateRowScalarWide(rowA, rowB, area.width(), threshold, sums);
+    }
+    return sums;
+}
+
+RoiStats computeWith(const QImage &a, const QImage &b, const QRect &roi, int changeThreshold, bool simd)
+{
+    RoiStats stats;
+    const QRect area = roi.intersected(a.rect()).intersected(b.rect());
+    if (area.isEmpty()) {
+        return stats;
+    }
+
+    // Full precision if either side has it; sums are then on the 16-bit scale
+    const int threshold = qBound(0, changeThreshold, 255);
+    const bool wide = a.depth() == 64 || b.depth() == 64;
+    const int scale = wide ? kWideScale : 1;
+    const Sums sums = wide ? sumWide(a, b, area, threshold * kWideScale, simd)
+                           : sumNarrow(a, b, area, threshold, simd);
+
+    const qint64 pixels = static_cast<qint64>(area.width()) * area.height();
+    const double samples = pixels * 3.0;
+    const double peak = 255.0 * scale;
+    stats.pixelCount = static_cast<int>(pixels);
+    stats.meanAbsDiff = sums.absDiff / samples / scale;
+    stats.maxAbsDiff = (sums.maxDiff + scale - 1) / scale;
+    const double mse = sums.squaredDiff / samples;
+    stats.psnr = mse > 0.0 ? 10.0 * std::log10(peak * peak / mse) : std::numeric_limits<double>::infinity();
+    stats.changedPercent = 100.0 * sums.changed / pixels;
+    stats.bitsPerChannel = wide ? 16 : 8;
+    return stats;
+}
+
+} // namespace
+
+RoiStats::RoiStats()
+    : pixelCount(0)
+    , meanAbsDiff(0.0)
+    , maxAbsDiff(0)
+    , psnr(0.0)
+    , changedPercent(0.0)
+    , bitsPerChannel(8)
+{
+}
+
+RoiStats RoiStats::compute(const QImage &a, const QImage &b, const QRect &roi, int changeThreshold)
+{
+    return computeWith(a, b, roi, changeThreshold, true);
+}
+
+RoiStats RoiStats::computeScalar(const QImage &a, const QImage &b, const QRect &roi, int changeThreshold)
+{
+    return computeWith(a, b, roi, changeThreshold, false);
+}
+
+bool RoiStats::usesSimd()
+{
+#ifdef __SSE2__
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,55 @@
+#ifndef ROISTATS_H
+#define ROISTATS_H
+
+#include <QImage>
+#include <QRect>
+
+/**
+ * @brief RoiStats - Difference statistics of the A and B renders inside a region
+ *
+ * The per-frame value in compareResult.xml covers the whole frame; when reviewers
+ * zoom into an area they need numbers for just that area. All differences are per
+ * RGB channel (alpha is ignored), on the 0..255 scale of 8-bit images.
+ *
+ * If either image has 16 bits per channel (QImage::Format_RGBA64 and friends, e.g.
+ * 16-bit PNG renders), both are compared at 16 bits and the results scaled to 0..255,
+ * so differences below one 8-bit step still count.
+ *
+ * compute() uses SSE2 where the compiler targets it (every x86-64 build) and falls
+ * back to computeScalar() elsewhere; both give identical results.
+ */
+struct RoiStats
+{
+    int pixelCount;         // Pixels compared (region clipped to both images)
+    double meanAbsDiff;     // Mean absolute difference per channel, 0..255
+    int maxAbsDiff;         // Largest absolute difference of any channel, 0..255 (rounded up)
+    double psnr;            // Peak signal-to-noise ratio in dB (infinity if identical)
+    double changedPercent;  // Pixels with a channel differing by more than the change threshold, 0..100
+    int bitsPerChannel;     // Precision compared at: 8, or 16
+
+    RoiStats();
+
+    bool isValid() const { return pixelCount > 0; }
+
+    /**
+     * @brief Compare two images inside a region
+     * @param a - Original render
+     * @param b - Test render (same pixel grid as a; only the common area is compared)
+     * @param roi - Region in image pixels (clipped to both images)
+     * @param changeThreshold - A pixel counts as changed if a channel differs by more than this
+     * @return Statistics (pixelCount == 0 if the region misses either image)
+     */
+    static RoiStats compute(const QImage &a, const QImage &b, const QRect &roi, int changeThreshold);
+
+    /**
+     * @brief Same as compute(), one pixel at a time (reference for the SIMD path)
+     */
+    static RoiStats computeScalar(const QImage &a, const QImage &b, const QRect &roi, int changeThreshold);
+
+    /**
+     * @brief Whether compute() uses the SSE2 path in this build
+     */
+    static bool usesSimd();
+};
+
+#endif // ROISTATS_H
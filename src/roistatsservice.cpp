@@ -0,0 +1,288 @@
+#include "roistatsservice.h"
+#include "framering.h"
+#include "imageloadermanager.h"
+#include "logger.h"
+#include <QImageReader>
+#include <QPixmap>
+#include <QtConcurrent>
+#include <cmath>
+
+namespace {
+
+const QString kTypeA = QStringLiteral("A");
+const QString kTypeB = QStringLiteral("B");
+const int kDefaultChangeThreshold = 10;  // Above JPEG noise of identical renders
+
+/**
+ * @brief Decode only a region of an image file
+ * @param path - Image file path
+ * @param rect - Region in image pixels (clipped to the image)
+ * @return Region as an image, or null image if the file can't be read
+ */
+QImage decodeRegion(const QString &path, const QRect &rect)
+{
+    if (path.isEmpty()) {
+        return QImage();
+    }
+    QImageReader reader(path);
+    const QRect clipped = reader.size().isValid() ? rect.intersected(QRect(QPoint(0, 0), reader.size())) : rect;
+    if (clipped.isEmpty()) {
+        return QImage();
+    }
+    reader.setClipRect(clipped);
+    return reader.read();
+}
+
+/**
+ * @brief One render of a frame: decoded pixels (all or part of the image), or a file to decode
+ */
+struct FrameSide
+{
+    QImage image;    // Null = decode the region from path
+    QPoint origin;   // Image pixel of image's top-left (non-zero for a region copy)
+    QString path;
+
+    QRect bounds() const { return QRect(origin, image.size()); }
+};
+
+/**
+ * @brief Compare A and B inside a region, decoding from disk what isn't in memory
+ * @param a - A render
+ * @param b - B render
+ * @param rect - Region in image pixels
+ * @param changeThreshold - See RoiStats::compute()
+ * @param clipped - Output: compared region in image pixels (may be null)
+ */
+RoiStats compareRegion(const FrameSide &a, const FrameSide &b, const QRect &rect, int changeThreshold, QRect *clipped)
+{
+    QRect area = rect;
+    if (!a.image.isNull()) {
+        area = area.intersected(a.bounds());
+    }
+    if (!b.image.isNull()) {
+        area = area.intersected(b.bounds());
+    }
+    if (area.isEmpty()) {
+        return RoiStats();
+    }
+
+    // Both in memory on the same pixel grid (e.g. full FrameRing frames): no copies
+    if (!a.image.isNull() && !b.image.isNull() && a.origin == b.origin) {
+        if (clipped) {
+            *clipped = area;
+        }
+        return RoiStats::compute(a.image, b.image, area.translated(-a.origin), changeThreshold);
+    }
+
+    const QImage regionA = a.image.isNull() ? decodeRegion(a.path, area) : a.image.copy(area.translated(-a.origin));
+    const QImage regionB = b.image.isNull() ? decodeRegion(b.path, area) : b.image.copy(area.translated(-b.origin));
+    if (regionA.isNull() || regionB.isNull()) {
+        return RoiStats();
+    }
+    if (clipped) {
+        *clipped = QRect(area.topLeft(), regionA.size().boundedTo(regionB.size()));
+    }
+    return RoiStats::compute(regionA, regionB, regionA.rect(), changeThreshold);
+}
+
+} // namespace
+
+/**
+ * @brief One frame of computeRange(), with everything read from the main thread's caches
+ */
+struct RoiStatsService::RangeJob
+{
+    int frame;
+    FrameSide a;  // FrameRing image, or only the path
+    FrameSide b;
+};
+
+/**
+ * @brief Per-frame work of computeRange()
+ *
+ * Runs on the global thread pool through QtConcurrent::blockingMapped; the
+ * generation check lets a superseded range finish without decoding anything.
+ */
+struct RoiStatsService::RangeWorker
+{
+    typedef RangeResult result_type;
+
+    RangeWorker(const QRect &rect, int changeThreshold, int generation, const std::atomic<int> *latestGeneration)
+        : m_rect(rect)
+        , m_changeThreshold(changeThreshold)
+        , m_generation(generation)
+        , m_latestGeneration(latestGeneration)
+    {
+    }
+
+    RangeResult operator()(const RangeJob &job) const
+    {
+        RangeResult result;
+        if (m_latestGeneration->load(std::memory_order_relaxed) != m_generation) {
+            return result;
+        }
+        result.stats = compareRegion(job.a, job.b, m_rect, m_changeThreshold, nullptr);
+        if (result.stats.isValid()) {
+            result.frame = job.frame;
+        }
+        return result;
+    }
+
+    QRect m_rect;
+    int m_changeThreshold;
+    int m_generation;
+    const std::atomic<int> *m_latestGeneration;
+};
+
+RoiStatsService::RoiStatsService(QObject *parent)
+    : QObject(parent)
+    , m_frameRing(nullptr)
+    , m_imageLoaderManager(nullptr)
+    , m_changeThreshold(kDefaultChangeThreshold)
+    , m_watcher(new QFutureWatcher<QVector<RangeResult>>(this))
+    , m_generation(0)
+    , m_runningGeneration(-1)
+{
+    connect(m_watcher, &QFutureWatcherBase::finished, this, &RoiStatsService::onRangeFinished);
+}
+
+RoiStatsService::~RoiStatsService()
+{
+    ++m_generation;  // Remaining frames are skipped
+    m_watcher->waitForFinished();
+}
+
+void RoiStatsService::setFrameRing(FrameRing *ring)
+{
+    m_frameRing = ring;
+}
+
+void RoiStatsService::setImageLoaderManager(ImageLoaderManager *manager)
+{
+    m_imageLoaderManager = manager;
+}
+
+void RoiStatsService::setChangeThreshold(int threshold)
+{
+    threshold = qBound(0, threshold, 255);
+    if (threshold != m_changeThreshold) {
+        m_changeThreshold = threshold;
+        emit changeThresholdChanged();
+    }
+}
+
+QVariantMap RoiStatsService::frameStats(int frameNumber, const QRectF &roi)
+{
+    QVariantMap map;
+    map["valid"] = false;
+    const QRect rect = roi.toAlignedRect();
+    if (!m_imageLoaderManager || rect.isEmpty()) {
+        return map;
+    }
+
+    // Decoded frames first: the playback ring, then the pixmap cache (converting only the region).
+    // Pixmaps of 16-bit frames are 8-bit display copies; those regions are decoded from disk instead
+    FrameSide sides[2];
+    const QString types[2] = { kTypeA, kTypeB };
+    for (int i = 0; i < 2; ++i) {
+        sides[i].path = m_imageLoaderManager->getImageDiskPath(types[i], frameNumber);
+        if (m_frameRing) {
+            sides[i].image = m_frameRing->image(types[i], frameNumber);
+        }
+        if (sides[i].image.isNull() && !m_imageLoaderManager->isHighBitDepth(types[i])) {
+            const QPixmap pixmap = m_imageLoaderManager->getImageIfCached(types[i], frameNumber);
+            const QRect area = rect.intersected(pixmap.rect());
+            if (!area.isEmpty()) {
+                sides[i].image = pixmap.copy(area).toImage();
+                sides[i].origin = area.topLeft();
+            }
+        }
+    }
+
+    QRect clipped;
+    const RoiStats stats = compareRegion(sides[0], sides[1], rect, m_changeThreshold, &clipped);
+    if (!stats.isValid()) {
+        return map;
+    }
+    map["valid"] = true;
+    map["pixelCount"] = stats.pixelCount;
+    map["meanAbsDiff"] = stats.meanAbsDiff;
+    map["maxAbsDiff"] = stats.maxAbsDiff;
+    map["identical"] = std::isinf(stats.psnr);
+    map["psnr"] = std::isinf(stats.psnr) ? 0.0 : stats.psnr;  // Undefined for identical regions
+    map["changedPercent"] = stats.changedPercent;
+    map["bitsPerChannel"] = stats.bitsPerChannel;
+    map["x"] = clipped.x();
+    map["y"] = clipped.y();
+    map["width"] = clipped.width();
+    map["height"] = clipped.height();
+    return map;
+}
+
+void RoiStatsService::computeRange(int first, int last, const QRectF &roi)
+{
+    const QRect rect = roi.toAlignedRect();
+    if (!m_imageLoaderManager || rect.isEmpty() || last < first) {
+        clearRange();
+        return;
+    }
+
+    // Paths and ring frames are read here; workers only touch their job
+    QVector<RangeJob> jobs;
+    jobs.reserve(last - first + 1);
+    for (int frame = first; frame <= last; ++frame) {
+        RangeJob job;
+        job.frame = frame;
+        if (m_frameRing) {
+            job.a.image = m_frameRing->image(kTypeA, frame);
+            job.b.image = m_frameRing->image(kTypeB, frame);
+        }
+        job.a.path = m_imageLoaderManager->getImageDiskPath(kTypeA, frame);
+        job.b.path = m_imageLoaderManager->getImageDiskPath(kTypeB, frame);
+        jobs.append(job);
+    }
+
+    const int generation = ++m_generation;
+    m_runningGeneration = generation;
+    const RangeWorker worker(rect, m_changeThreshold, generation, &m_generation);
+    QFuture<QVector<RangeResult>> future = QtConcurrent::run([jobs, worker]() {
+        return QtConcurrent::blockingMapped<QVector<RangeResult>>(jobs, worker);
+    });
+    m_watcher->setFuture(future);
+
+    DEBUG_LOG("RoiStatsService") << "computeRange - Frames" << first << "to" << last << "in" << rect;
+    emit rangeRunningChanged();
+}
+
+void RoiStatsService::clearRange()
+{
+    ++m_generation;
+    m_runningGeneration = -1;
+    const bool hadPoints = !m_rangePoints.isEmpty();
+    m_rangePoints.clear();
+    if (hadPoints) {
+        emit rangeReady();
+    }
+}
+
+void RoiStatsService::onRangeFinished()
+{
+    emit rangeRunningChanged();
+
+    // Cleared (or superseded) while running
+    if (m_runningGeneration != m_generation.load()) {
+        return;
+    }
+    m_runningGeneration = -1;
+
+    const QVector<RangeResult> results = m_watcher->result();
+    m_rangePoints.clear();
+    m_rangePoints.reserve(results.size());
+    for (const RangeResult &result : results) {
+        if (result.frame >= 0) {
+            m_rangePoints.append(QPointF(result.frame, 1.0 - result.stats.changedPercent / 100.0));
+        }
+    }
+    DEBUG_LOG("RoiStatsService") << "onRangeFinished -" << m_rangePoints.size() << "of" << results.size() << "frames compared";
+    emit rangeReady();
+}
@@ -0,0 +1,121 @@
+#ifndef ROISTATSSERVICE_H
+#define ROISTATSSERVICE_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QPointF>
+#include <QRectF>
+#include <QVariantMap>
+#include <QVector>
+#include <atomic>
+#include "roistats.h"
+
+// Forward declarations
+class FrameRing;
+class ImageLoaderManager;
+
+/**
+ * @brief RoiStatsService - Difference statistics of the visible region ("roiStats" in QML)
+ *
+ * The A/B/C view passes the image area its synchronized zoom/pan shows (image
+ * pixels, see ImageItem.visibleImageRect()). frameStats() compares the A and B
+ * renders of one frame inside that area; computeRange() does the same for a frame
+ * range on the global thread pool and keeps one point per frame for the timeline
+ * (TimelineSeriesFeeder::refreshRoiCurve()).
+ *
+ * Frames come from the playback FrameRing or the ImageLoaderManager cache when
+ * decoded already; otherwise only the region is decoded from disk (QImageReader
+ * clip rect), so a small region of a 4K sequence is cheap to scan.
+ */
+class RoiStatsService : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int changeThreshold READ changeThreshold WRITE setChangeThreshold NOTIFY changeThresholdChanged)
+    Q_PROPERTY(bool rangeRunning READ rangeRunning NOTIFY rangeRunningChanged)
+    Q_PROPERTY(int rangePointCount READ rangePointCount NOTIFY rangeReady)
+
+public:
+    explicit RoiStatsService(QObject *parent = nullptr);
+    ~RoiStatsService();
+
+    /**
+     * @brief Set the decoded playback frames to read from first
+     * @param ring - FrameRing instance (not owned)
+     */
+    void setFrameRing(FrameRing *ring);
+
+    /**
+     * @brief Set the manager that caches pixmaps and resolves image paths
+     * @param manager - ImageLoaderManager instance (not owned)
+     */
+    void setImageLoaderManager(ImageLoaderManager *manager);
+
+    /**
+     * @brief Compare the A and B renders of a frame inside a region
+     * @param frameNumber - Frame number (1-indexed)
+     * @param roi - Region in image pixels
+     * @return Map with valid, pixelCount, meanAbsDiff, maxAbsDiff, psnr (0 if identical),
+     *         identical, changedPercent, bitsPerChannel (8 or 16) and x/y/width/height of the
+     *         compared (clipped) region
+     */
+    Q_INVOKABLE QVariantMap frameStats(int frameNumber, const QRectF &roi);
+
+    /**
+     * @brief Compare every frame of a range inside a region (asynchronous; rangeReady when done)
+     *
+     * A newer call or clearRange() supersedes a running one.
+     *
+     * @param first - First frame number
+     * @param last - Last frame number
+     * @param roi - Region in image pixels
+     */
+    Q_INVOKABLE void computeRange(int first, int last, const QRectF &roi);
+
+    /**
+     * @brief Drop the range curve and cancel a running range
+     */
+    Q_INVOKABLE void clearRange();
+
+    /**
+     * @brief Range curve: (frame, unchanged fraction 0..1) per frame, sorted by frame
+     *
+     * 1 - changedPercent / 100, so the curve reads like the compareResult.xml values
+     * plotted next to it (1 = region identical).
+     */
+    const QVector<QPointF> &rangePoints() const { return m_rangePoints; }
+
+    int changeThreshold() const { return m_changeThreshold; }
+    void setChangeThreshold(int threshold);
+    bool rangeRunning() const { return m_watcher->isRunning(); }
+    int rangePointCount() const { return m_rangePoints.size(); }
+
+signals:
+    void changeThresholdChanged();
+    void rangeRunningChanged();
+    void rangeReady();
+
+private slots:
+    void onRangeFinished();
+
+private:
+    struct RangeJob;
+    struct RangeWorker;
+
+    // One frame of a range (frame -1 = skipped: superseded, or a render missing)
+    struct RangeResult {
+        int frame;
+        RoiStats stats;
+        RangeResult() : frame(-1) {}
+    };
+
+    FrameRing *m_frameRing;
+    ImageLoaderManager *m_imageLoaderManager;
+    int m_changeThreshold;
+
+    QFutureWatcher<QVector<RangeResult>> *m_watcher;
+    std::atomic<int> m_generation;  // Bumped per range / clear; superseded workers skip their frames
+    int m_runningGeneration;
+    QVector<QPointF> m_rangePoints;
+};
+
+#endif // ROISTATSSERVICE_H
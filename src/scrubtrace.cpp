@@ -0,0 +1,67 @@
+#include "scrubtrace.h"
+#include <QFile>
+#include <algorithm>
+
+QByteArray ScrubTrace::header()
+{
+    return QByteArrayLiteral("timeMs,frame,imageTypes\n");
+}
+
+QByteArray ScrubTrace::formatStep(const Step &step)
+{
+    return QByteArray::number(step.timeMs) + ',' + QByteArray::number(step.frame) + ','
+           + step.imageTypes.join(';').toUtf8() + '\n';
+}
+
+bool ScrubTrace::read(const QString &filePath, QVector<Step> &steps, QString *errorString)
+{
+    steps.clear();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (errorString) {
+            *errorString = QString("Cannot open %1: %2").arg(filePath, file.errorString());
+        }
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#') || line == QString::fromLatin1(header()).trimmed()) {
+            continue;
+        }
+        const QStringList fields = line.split(',');
+        bool timeOk = false;
+        bool frameOk = false;
+        Step step;
+        step.timeMs = fields.value(0).toLongLong(&timeOk);
+        step.frame = fields.value(1).toInt(&frameOk);
+        if (fields.size() != 3 || !timeOk || !frameOk || step.timeMs < 0) {
+            if (errorString) {
+                *errorString = QString("%1:%2: Malformed line \"%3\"").arg(filePath).arg(lineNumber).arg(line);
+            }
+            steps.clear();
+            return false;
+        }
+        step.imageTypes = fields.at(2).split(';', QString::SkipEmptyParts);
+        steps.append(step);
+    }
+
+    // Recordings are in order already; hand-written traces may not be
+    std::stable_sort(steps.begin(), steps.end(), [](const Step &a, const Step &b) { return a.timeMs < b.timeMs; });
+    return true;
+}
+
+bool ScrubTrace::write(const QString &filePath, const QVector<Step> &steps)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QByteArray data = header();
+    for (const Step &step : steps) {
+        data += formatStep(step);
+    }
+    return file.write(data) == data.size();
+}
@@ -0,0 +1,59 @@
+#ifndef SCRUBTRACE_H
+#define SCRUBTRACE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+
+/**
+ * @brief ScrubTrace - Recorded timeline input (frame requests with timestamps)
+ *
+ * "renderCompare --record-scrub <file>" writes every FrameSetPresenter request to a
+ * trace file; tests/scrubreplay replays such a file against the real decode and
+ * presentation pipeline to measure how long each frame set took to appear.
+ *
+ * File format (text, one request per line, '#' starts a comment):
+ *   timeMs,frame,imageTypes
+ *   0,120,A;B;D
+ *   16,123,A;B;D
+ * timeMs is relative to the start of the recording, imageTypes are the visible panes.
+ */
+class ScrubTrace
+{
+public:
+    struct Step {
+        qint64 timeMs;
+        int frame;
+        QStringList imageTypes;
+    };
+
+    /**
+     * @brief First line of a trace file
+     */
+    static QByteArray header();
+
+    /**
+     * @brief Format one request as a trace line (including the newline)
+     */
+    static QByteArray formatStep(const Step &step);
+
+    /**
+     * @brief Read a trace file
+     * @param filePath - Trace file
+     * @param steps - Receives the requests, sorted by time
+     * @param errorString - Optional; receives the reason on failure
+     * @return false if the file can't be read or a line is malformed
+     */
+    static bool read(const QString &filePath, QVector<Step> &steps, QString *errorString = nullptr);
+
+    /**
+     * @brief Write a trace file
+     * @param filePath - Trace file (overwritten)
+     * @param steps - Requests in time order
+     * @return true on success
+     */
+    static bool write(const QString &filePath, const QVector<Step> &steps);
+};
+
+#endif // SCRUBTRACE_H
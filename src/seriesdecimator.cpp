@@ -0,0 +1,75 @@
+#include "seriesdecimator.h"
+#include <algorithm>
+
+QVector<QPointF> SeriesDecimator::minMax(const QVector<QPointF> &points, double xMin, double xMax, int bucketCount)
+{
+    QVector<QPointF> result;
+    if (points.isEmpty() || xMax < xMin) {
+        return result;
+    }
+
+    auto first = std::lower_bound(points.cbegin(), points.cend(), xMin,
+                                  [](const QPointF &point, double x) { return point.x() < x; });
+    auto last = std::upper_bound(first, points.cend(), xMax,
+                                 [](double x, const QPointF &point) { return x < point.x(); });
+
+    // Neighbours just outside the range keep the line running to the chart edges
+    const bool hasBefore = first != points.cbegin();
+    const bool hasAfter = last != points.cend();
+    const int inRange = static_cast<int>(last - first);
+
+    if (bucketCount <= 0 || inRange <= 2 * bucketCount) {
+        result.reserve(inRange + 2);
+        if (hasBefore) {
+            result.append(*(first - 1));
+        }
+        for (auto it = first; it != last; ++it) {
+            result.append(*it);
+        }
+        if (hasAfter) {
+            result.append(*last);
+        }
+        return result;
+    }
+
+    result.reserve(2 * bucketCount + 2);
+    if (hasBefore) {
+        result.append(*(first - 1));
+    }
+
+    const double bucketWidth = (xMax - xMin) / bucketCount;
+    auto it = first;
+    while (it != last) {
+        // Bucket of the current point; the last bucket is closed on xMax
+        int bucket = bucketWidth > 0.0 ? static_cast<int>((it->x() - xMin) / bucketWidth) : 0;
+        bucket = std::min(bucket, bucketCount - 1);
+        const double bucketEnd = (bucket == bucketCount - 1) ? xMax : xMin + (bucket + 1) * bucketWidth;
+
+        auto minIt = it;
+        auto maxIt = it;
+        for (++it; it != last && (it->x() < bucketEnd || bucket == bucketCount - 1); ++it) {
+            if (it->y() < minIt->y()) {
+                minIt = it;
+            }
+            if (it->y() > maxIt->y()) {
+                maxIt = it;
+            }
+        }
+
+        // Emit in frame order so the line series doesn't zig-zag backwards
+        if (minIt == maxIt) {
+            result.append(*minIt);
+        } else if (minIt < maxIt) {
+            result.append(*minIt);
+            result.append(*maxIt);
+        } else {
+            result.append(*maxIt);
+            result.append(*minIt);
+        }
+    }
+
+    if (hasAfter) {
+        result.append(*last);
+    }
+    return result;
+}
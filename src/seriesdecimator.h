@@ -0,0 +1,37 @@
+#ifndef SERIESDECIMATOR_H
+#define SERIESDECIMATOR_H
+
+#include <QVector>
+#include <QPointF>
+
+/**
+ * @brief SeriesDecimator - Min/max per pixel bucket downsampling for timeline series
+ *
+ * A chart a few hundred pixels wide can't show more than a couple of points per
+ * pixel column, but long sequences have tens of thousands of frames. Plotting all
+ * of them overdraws thousands of markers per column.
+ *
+ * The visible X range is split into one bucket per pixel column and only the
+ * lowest and highest point of each bucket are kept (in frame order). Keeping the
+ * minimum means the low-similarity frames we look for are never dropped, and
+ * keeping the maximum keeps the line shape intact.
+ *
+ * Input points must be sorted by X (frame number).
+ */
+class SeriesDecimator
+{
+public:
+    /**
+     * @brief Downsample the points inside [xMin, xMax] to at most 2 points per bucket
+     * @param points - Full-resolution points, sorted by X
+     * @param xMin - Start of the visible range
+     * @param xMax - End of the visible range
+     * @param bucketCount - Number of buckets (normally the plot width in pixels)
+     * @return Decimated points sorted by X. Includes the nearest point on each side
+     *         of the range so a line series still reaches the chart edges.
+     *         If the range holds no more than 2 * bucketCount points they are returned as-is.
+     */
+    static QVector<QPointF> minMax(const QVector<QPointF> &points, double xMin, double xMax, int bucketCount);
+};
+
+#endif // SERIESDECIMATOR_H
@@ -50,6 +50,8 @@
 
 #include "sortfilterproxymodel.h"
 #include "logger.h"
+#include "tracer.h"
+#include "metricsregistry.h"
 #include <QtQml>
 
 SortFilterProxyModel::SortFilterProxyModel(QObject *parent) : QSortFilterProxyModel(parent), m_complete(false)
@@ -80,6 +82,7 @@ QByteArray SortFilterProxyModel::sortRole() const
 
 void SortFilterProxyModel::setSortRole(const QByteArray &role)
 {
+    TRACE_SCOPE("SortFilterProxyModel", "setSortRole");
     if (m_sortRole != role) {
         m_sortRole = role;
         if (m_complete) {
@@ -100,6 +103,7 @@ Qt::SortOrder SortFilterProxyModel::sortOrder() const
 
 void SortFilterProxyModel::setSortOrder(Qt::SortOrder order)
 {
+    TRACE_SCOPE("SortFilterProxyModel", "setSortOrder");
     if (m_complete) {
         // Ensure sortRole is set before sorting
         if (!m_sortRole.isEmpty()) {
@@ -146,6 +150,8 @@ QString SortFilterProxyModel::filterString() const
 
 void SortFilterProxyModel::setFilterString(const QString &filter)
 {
+    TRACE_SCOPE("SortFilterProxyModel", "setFilterString");
+    ScopedLatency latency(MetricsRegistry::ProxyFilterLatency);
     setFilterRegExp(QRegExp(filter, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax())));
 }
 
@@ -176,10 +182,12 @@ QString SortFilterProxyModel::renderVersionFilter() const
 
 void SortFilterProxyModel::setRenderVersionFilter(const QString &version)
 {
+    TRACE_SCOPE("SortFilterProxyModel", "setRenderVersionFilter");
     if (m_renderVersionFilter != version) {
         DEBUG_LOG("SortFilterProxyModel") << "setRenderVersionFilter - Setting filter to:" << version;
         m_renderVersionFilter = version;
         emit renderVersionFilterChanged();
+        ScopedLatency latency(MetricsRegistry::ProxyFilterLatency);
         invalidateFilter();  // Trigger re-filtering when version changes
         DEBUG_LOG("SortFilterProxyModel") << "setRenderVersionFilter - Filter invalidated, row count:" << rowCount();
     }
@@ -187,6 +195,7 @@ void SortFilterProxyModel::setRenderVersionFilter(const QString &version)
 
 void SortFilterProxyModel::sort(int column, Qt::SortOrder order)
 {
+    TRACE_SCOPE("SortFilterProxyModel", "sort");
     Q_UNUSED(column);  // Column is always 0 for role-based models
     if (m_complete) {
         // Ensure sortRole is set for role-based models
@@ -0,0 +1,110 @@
+#include "sparklinerenderer.h"
+#include "logger.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QPainter>
+#include <QPolygonF>
+#include <algorithm>
+
+QVector<QPair<float, float>> SparklineRenderer::envelope(const QVector<float> &values, int columns)
+{
+    QVector<QPair<float, float>> result;
+    if (values.isEmpty() || columns <= 0) {
+        return result;
+    }
+
+    if (values.size() <= columns) {
+        result.reserve(values.size());
+        for (float value : values) {
+            result.append(qMakePair(value, value));
+        }
+        return result;
+    }
+
+    result.reserve(columns);
+    const int count = values.size();
+    for (int column = 0; column < columns; ++column) {
+        // Integer bucket bounds so every value lands in exactly one column
+        const int begin = static_cast<int>(static_cast<qint64>(column) * count / columns);
+        const int end = static_cast<int>(static_cast<qint64>(column + 1) * count / columns);
+        const auto minMax = std::minmax_element(values.constBegin() + begin, values.constBegin() + end);
+        result.append(qMakePair(*minMax.first, *minMax.second));
+    }
+    return result;
+}
+
+QImage SparklineRenderer::render(const QVector<float> &values, const QSize &size, const QColor &color)
+{
+    if (values.isEmpty() || size.isEmpty()) {
+        return QImage();
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    const int width = size.width();
+    const double height = size.height() - 2.0;  // 1px margin top and bottom
+    auto toY = [height](float value) {
+        return 1.0 + (1.0 - std::max(0.0f, std::min(1.0f, value))) * height;
+    };
+
+    const QVector<QPair<float, float>> columns = envelope(values, width);
+    const double step = columns.size() > 1 ? (width - 1.0) / (columns.size() - 1) : 0.0;
+
+    // Zigzag through max and min of each column - draws the full envelope as one polyline
+    QPolygonF polyline;
+    polyline.reserve(columns.size() * 2);
+    for (int i = 0; i < columns.size(); ++i) {
+        const double x = i * step + 0.5;
+        polyline.append(QPointF(x, toY(columns.at(i).second)));
+        if (columns.at(i).first != columns.at(i).second) {
+            polyline.append(QPointF(x, toY(columns.at(i).first)));
+        }
+    }
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(QPen(color, 1.0));
+    if (polyline.size() == 1) {
+        painter.drawPoint(polyline.first());
+    } else {
+        painter.drawPolyline(polyline);
+    }
+    painter.end();
+    return image;
+}
+
+QString SparklineRenderer::cachePath(const QString &xmlPath)
+{
+    const QFileInfo xmlInfo(xmlPath);
+    return QDir::toNativeSeparators(xmlInfo.absoluteDir().absoluteFilePath(xmlInfo.completeBaseName() + "_sparkline.png"));
+}
+
+QString SparklineRenderer::ensureCached(const QString &xmlPath, const QVector<float> &values)
+{
+    if (xmlPath.isEmpty() || values.isEmpty()) {
+        return QString();
+    }
+
+    const QString pngPath = cachePath(xmlPath);
+    const QFileInfo pngInfo(pngPath);
+    if (pngInfo.exists() && pngInfo.lastModified() >= QFileInfo(xmlPath).lastModified()) {
+        return pngPath;
+    }
+
+    const QImage image = render(values);
+    if (image.isNull() || !image.save(pngPath, "PNG")) {
+        DEBUG_LOG("SparklineRenderer") << "ensureCached - Failed to write sparkline:" << pngPath;
+        return QString();
+    }
+    return pngPath;
+}
+
+QString SparklineRenderer::imageSource(const QString &pngPath)
+{
+    if (pngPath.isEmpty()) {
+        return QString();
+    }
+    // QML caches images by URL; the query is ignored when the local file is read
+    return pngPath + "?v=" + QString::number(QFileInfo(pngPath).lastModified().toMSecsSinceEpoch());
+}
@@ -0,0 +1,72 @@
+#ifndef SPARKLINERENDERER_H
+#define SPARKLINERENDERER_H
+
+#include <QVector>
+#include <QPair>
+#include <QImage>
+#include <QColor>
+#include <QSize>
+#include <QString>
+
+/**
+ * @brief SparklineRenderer - Rasterizes an event's per-frame values into a small image
+ *
+ * Used by XmlDataModel's background statistics pass to give the event table a
+ * Sparkline column. The series is reduced to a min/max envelope with one bucket per
+ * pixel column (so single bad frames stay visible) and drawn with QPainter on a
+ * QImage, which is safe off the GUI thread.
+ *
+ * Rendered sparklines are saved as PNG next to the compareResult.xml they were drawn
+ * from and reused while they are newer than the XML, so the table delegate only
+ * loads a small file (asynchronously) and never draws anything itself. The table gets
+ * them through imageSource(), whose query changes when the PNG is re-rendered, so the
+ * cached image in the delegate is replaced after a tester run.
+ */
+class SparklineRenderer
+{
+public:
+    static const int DefaultWidth = 120;
+    static const int DefaultHeight = 32;
+
+    /**
+     * @brief Reduce a series to min/max per column
+     * @param values - Per-frame values in frame order
+     * @param columns - Number of output columns
+     * @return (min, max) per column; one entry per value if there are fewer values than columns
+     */
+    static QVector<QPair<float, float>> envelope(const QVector<float> &values, int columns);
+
+    /**
+     * @brief Draw a sparkline
+     * @param values - Per-frame values in frame order (Y range is fixed to [0, 1])
+     * @param size - Image size in pixels
+     * @param color - Line color
+     * @return Transparent image with the sparkline, or null image if values is empty
+     */
+    static QImage render(const QVector<float> &values, const QSize &size = QSize(DefaultWidth, DefaultHeight),
+                         const QColor &color = QColor("#25ae88"));
+
+    /**
+     * @brief Path of the cached sparkline for a compareResult.xml
+     * @param xmlPath - Path to compareResult.xml
+     * @return Path of the PNG next to it (may not exist yet)
+     */
+    static QString cachePath(const QString &xmlPath);
+
+    /**
+     * @brief Return the cached sparkline for a compareResult.xml, rendering it if missing or stale
+     * @param xmlPath - Path to compareResult.xml the values were read from
+     * @param values - Per-frame values in frame order
+     * @return Path to the PNG, or empty string if it could not be written
+     */
+    static QString ensureCached(const QString &xmlPath, const QVector<float> &values);
+
+    /**
+     * @brief Image source of a cached sparkline that changes whenever the PNG does
+     * @param pngPath - Path returned by ensureCached()
+     * @return "<pngPath>?v=<modification time in ms>", or empty string if pngPath is empty
+     */
+    static QString imageSource(const QString &pngPath);
+};
+
+#endif // SPARKLINERENDERER_H
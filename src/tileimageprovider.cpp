@@ -0,0 +1,37 @@
+#include "tileimageprovider.h"
+#include "imageloadermanager.h"
+#include "tonemapper.h"
+#include "logger.h"
+
+TileImageProvider::TileImageProvider(ImageLoaderManager *imageLoaderManager, ToneMapper *toneMapper)
+    : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading)
+    , m_imageLoaderManager(imageLoaderManager)
+    , m_toneMapper(toneMapper)
+{
+}
+
+QImage TileImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    Q_UNUSED(requestedSize);  // Tiles are already at the resolution they are shown at
+
+    // id: "<type>/<frame>/<level>/<column>/<row>[/<tone mapper revision>]", e.g. "A/388/1/2/0"
+    const QStringList parts = id.split('/');
+    int numbers[4] = { 0, 0, 0, 0 };
+    bool valid = (parts.size() == 5 || parts.size() == 6) && m_imageLoaderManager;
+    for (int i = 0; valid && i < 4; ++i) {
+        numbers[i] = parts.at(i + 1).toInt(&valid);
+    }
+    if (!valid) {
+        DEBUG_LOG("TileImageProvider") << "requestImage - Invalid id:" << id;
+        return QImage();
+    }
+
+    QImage tile = m_imageLoaderManager->getTile(parts.at(0), numbers[0], numbers[1], numbers[2], numbers[3]);
+    if (m_toneMapper && m_toneMapper->appliesTo(parts.at(0))) {
+        tile = m_toneMapper->apply(tile);
+    }
+    if (size) {
+        *size = tile.size();
+    }
+    return tile;
+}
@@ -0,0 +1,35 @@
+#ifndef TILEIMAGEPROVIDER_H
+#define TILEIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+// Forward declarations
+class ImageLoaderManager;
+class ToneMapper;
+
+/**
+ * @brief TileImageProvider - Serves image pyramid tiles to QML ("image://tiles/<type>/<frame>/<level>/<column>/<row>")
+ *
+ * URLs come from ImageLoaderManager::getVisibleTiles(). Tiles are always loaded on
+ * QML's image loader threads, so decoding never blocks zooming or panning.
+ *
+ * Tiles are cached at full precision and tone mapped here (ToneMapper); TiledImageLayer
+ * appends the tone mapper's revision ("/<revision>") so changed settings reload the tiles.
+ */
+class TileImageProvider : public QQuickImageProvider
+{
+public:
+    /**
+     * @param imageLoaderManager - Tile decoder and cache (not owned)
+     * @param toneMapper - Display exposure and curve (not owned, may be null)
+     */
+    TileImageProvider(ImageLoaderManager *imageLoaderManager, ToneMapper *toneMapper);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    ImageLoaderManager *m_imageLoaderManager;
+    ToneMapper *m_toneMapper;
+};
+
+#endif // TILEIMAGEPROVIDER_H
@@ -0,0 +1,128 @@
+#include "tilepyramid.h"
+#include <QImageReader>
+#include <algorithm>
+#include <cmath>
+
+int TilePyramid::levelCount(const QSize &imageSize)
+{
+    if (imageSize.isEmpty()) {
+        return 0;
+    }
+    int levels = 1;
+    QSize size = imageSize;
+    while (size.width() > TileSize || size.height() > TileSize) {
+        size = levelSize(imageSize, levels);
+        ++levels;
+    }
+    return levels;
+}
+
+QSize TilePyramid::levelSize(const QSize &imageSize, int level)
+{
+    const int divisor = 1 << level;
+    return QSize((imageSize.width() + divisor - 1) / divisor, (imageSize.height() + divisor - 1) / divisor);
+}
+
+int TilePyramid::levelForScale(qreal scale, int levelCount)
+{
+    if (levelCount <= 1 || scale <= 0.0) {
+        return std::max(0, levelCount - 1);
+    }
+    // Level L shows 1/2^L image pixels per full-res pixel; stay at or above the display scale
+    const int level = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::max(0, std::min(levelCount - 1, level));
+}
+
+QVector<TileId> TilePyramid::visibleTiles(const QSize &imageSize, int level, const QRectF &visibleRect)
+{
+    QVector<TileId> tiles;
+    const QRectF visible = visibleRect.intersected(QRectF(QPointF(0, 0), QSizeF(imageSize)));
+    if (visible.isEmpty() || level < 0) {
+        return tiles;
+    }
+
+    const int divisor = 1 << level;
+    const QSize size = levelSize(imageSize, level);
+    const int tileSpan = TileSize * divisor;  // Tile size in full-res pixels
+    const int firstColumn = static_cast<int>(visible.left()) / tileSpan;
+    const int firstRow = static_cast<int>(visible.top()) / tileSpan;
+    const int lastColumn = std::min((size.width() - 1) / TileSize,
+                                    (static_cast<int>(std::ceil(visible.right())) - 1) / tileSpan);
+    const int lastRow = std::min((size.height() - 1) / TileSize,
+                                 (static_cast<int>(std::ceil(visible.bottom())) - 1) / tileSpan);
+
+    tiles.reserve((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1));
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            TileId tile;
+            tile.level = level;
+            tile.column = column;
+            tile.row = row;
+            tile.sourceRect = QRect(column * tileSpan, row * tileSpan, tileSpan, tileSpan)
+                                  .intersected(QRect(QPoint(0, 0), imageSize));
+            tiles.append(tile);
+        }
+    }
+    return tiles;
+}
+
+QImage TilePyramid::decodeTile(const QString &path, const QSize &imageSize, int level, int column, int row)
+{
+    const QSize size = levelSize(imageSize, level);
+    const QRect tileRect = QRect(column * TileSize, row * TileSize, TileSize, TileSize)
+                               .intersected(QRect(QPoint(0, 0), size));
+    if (tileRect.isEmpty()) {
+        return QImage();
+    }
+
+    QImageReader reader(path);
+    if (level > 0) {
+        // Scaled decode, then clip in the scaled image
+        reader.setScaledSize(size);
+        reader.setScaledClipRect(tileRect);
+    } else {
+        reader.setClipRect(tileRect);
+    }
+    return reader.read();
+}
+
+bool TilePyramid::decodesClipped(const QString &path, int level)
+{
+    QImageReader reader(path);
+    if (level > 0) {
+        return reader.supportsOption(QImageIOHandler::ScaledSize)
+               && reader.supportsOption(QImageIOHandler::ScaledClipRect);
+    }
+    return reader.supportsOption(QImageIOHandler::ClipRect);
+}
+
+int TilePyramid::columnCount(const QSize &imageSize, int level)
+{
+    return (levelSize(imageSize, level).width() + TileSize - 1) / TileSize;
+}
+
+QVector<QImage> TilePyramid::decodeLevelTiles(const QString &path, const QSize &imageSize, int level)
+{
+    QVector<QImage> tiles;
+    const QSize size = levelSize(imageSize, level);
+    QImageReader reader(path);
+    if (level > 0) {
+        reader.setScaledSize(size);
+    }
+    const QImage image = reader.read();
+    if (image.isNull()) {
+        return tiles;
+    }
+
+    const int columns = columnCount(imageSize, level);
+    const int rows = (size.height() + TileSize - 1) / TileSize;
+    tiles.reserve(columns * rows);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            // copy() detaches, so the level image is freed once cut
+            tiles.append(image.copy(QRect(column * TileSize, row * TileSize, TileSize, TileSize)
+                                        .intersected(image.rect())));
+        }
+    }
+    return tiles;
+}
@@ -0,0 +1,107 @@
+#ifndef TILEPYRAMID_H
+#define TILEPYRAMID_H
+
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief TileId - One tile of a frame's image pyramid
+ */
+struct TileId
+{
+    int level;          // 0 = full resolution, each level halves the size
+    int column;
+    int row;
+    QRect sourceRect;   // Area the tile covers, in full-resolution image pixels
+};
+
+/**
+ * @brief TilePyramid - Geometry and decoding of on-demand tile pyramids for deep zoom
+ *
+ * A frame is never decoded as a whole for zoomed views. Level L of the pyramid is the
+ * frame at 1/2^L size, cut into TileSize x TileSize tiles; a zoomed pane only asks for
+ * the tiles it can see, at the coarsest level that still has at least one image pixel
+ * per screen pixel. Nothing is precomputed - decodeTile() lets QImageReader clip and
+ * scale while decoding (libjpeg decodes at 1/2, 1/4, 1/8 scale directly), so only the
+ * tile is held in memory. JPEG still decodes every scanline above the tile's bottom
+ * edge (rows are skipped, not seeked), so a tile in the bottom row costs about a whole
+ * decode of its level; tiles higher up cost proportionally less.
+ *
+ * Other formats (PNG, TIFF, EXR - the 16-bit renders) ignore the clip: they decode the
+ * whole frame and crop, and scale the whole frame at level > 0. For them
+ * decodesClipped() is false and decodeLevelTiles() decodes a level once and cuts all
+ * of its tiles, which ImageLoaderManager caches in one pass.
+ */
+class TilePyramid
+{
+public:
+    static const int TileSize = 512;
+
+    /**
+     * @brief Number of levels, down to the first one that fits in a single tile
+     * @param imageSize - Full-resolution image size
+     * @return Level count (>= 1 for a valid size, 0 otherwise)
+     */
+    static int levelCount(const QSize &imageSize);
+
+    /**
+     * @brief Image size at a level (rounded up)
+     */
+    static QSize levelSize(const QSize &imageSize, int level);
+
+    /**
+     * @brief Coarsest level that is not magnified at a display scale
+     * @param scale - Screen pixels per full-resolution image pixel
+     * @param levelCount - Levels of the pyramid (see levelCount())
+     * @return Level in [0, levelCount - 1]
+     */
+    static int levelForScale(qreal scale, int levelCount);
+
+    /**
+     * @brief Tiles of a level that intersect an area of the image
+     * @param imageSize - Full-resolution image size
+     * @param level - Pyramid level
+     * @param visibleRect - Visible area in full-resolution image pixels
+     * @return Tiles in row-major order (empty if the area misses the image)
+     */
+    static QVector<TileId> visibleTiles(const QSize &imageSize, int level, const QRectF &visibleRect);
+
+    /**
+     * @brief Decode one tile
+     * @param path - Image file path
+     * @param imageSize - Full-resolution image size (as reported by QImageReader::size())
+     * @param level - Pyramid level
+     * @param column - Tile column
+     * @param row - Tile row
+     * @return Tile image (at most TileSize x TileSize), or null image on failure
+     */
+    static QImage decodeTile(const QString &path, const QSize &imageSize, int level, int column, int row);
+
+    /**
+     * @brief Check whether the file's format clips (and scales) while decoding, like JPEG
+     * @param path - Image file path
+     * @param level - Pyramid level (levels > 0 also need a scaled clip)
+     * @return false if a tile would decode the whole frame (use decodeLevelTiles())
+     */
+    static bool decodesClipped(const QString &path, int level);
+
+    /**
+     * @brief Number of tile columns of a level
+     */
+    static int columnCount(const QSize &imageSize, int level);
+
+    /**
+     * @brief Decode a whole level once and cut it into tiles
+     * @param path - Image file path
+     * @param imageSize - Full-resolution image size
+     * @param level - Pyramid level
+     * @return Tiles in row-major order, columnCount() per row; empty on failure
+     */
+    static QVector<QImage> decodeLevelTiles(const QString &path, const QSize &imageSize, int level);
+};
+
+#endif // TILEPYRAMID_H
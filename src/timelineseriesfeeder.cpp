@@ -0,0 +1,268 @@
+#include "timelineseriesfeeder.h"
+#include "xmldatamodel.h"
+#include "roistatsservice.h"
+#include "seriesdecimator.h"
+#include "versioncomparator.h"
+#include "logger.h"
+#include <QtCharts/QXYSeries>
+#include <QVariantMap>
+#include <algorithm>
+
+TimelineSeriesFeeder::TimelineSeriesFeeder(QObject *parent)
+    : QObject(parent)
+    , m_dataModel(nullptr)
+    , m_roiStats(nullptr)
+    , m_currentRow(-1)
+    , m_hasViewWindow(false)
+    , m_viewStart(0.0)
+    , m_viewEnd(0.0)
+    , m_pixelWidth(0)
+    , m_visiblePointCount(0)
+{
+}
+
+void TimelineSeriesFeeder::setDataModel(XmlDataModel *model)
+{
+    m_dataModel = model;
+}
+
+void TimelineSeriesFeeder::setRoiStatsService(RoiStatsService *service)
+{
+    m_roiStats = service;
+}
+
+bool TimelineSeriesFeeder::loadRow(int rowIndex)
+{
+    m_points.clear();
+    m_filteredPoints.clear();
+    m_index.clear();
+    m_hasViewWindow = false;
+    m_visiblePointCount = 0;
+    m_currentRow = -1;
+    clearOverlay();
+
+    if (!m_dataModel) {
+        DEBUG_LOG("TimelineSeriesFeeder") << "loadRow - No data model set";
+        emit seriesLoaded();
+        return false;
+    }
+
+    if (!m_dataModel->getFramePoints(rowIndex, m_points)) {
+        DEBUG_LOG("TimelineSeriesFeeder") << "loadRow - No frame data for rowIndex:" << rowIndex;
+        emit seriesLoaded();
+        return false;
+    }
+
+    // compareResult.xml lists frames in order, but keep lookups safe if it doesn't
+    const bool sorted = std::is_sorted(m_points.cbegin(), m_points.cend(),
+                                       [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); });
+    if (!sorted) {
+        std::sort(m_points.begin(), m_points.end(),
+                  [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); });
+    }
+
+    // Until a threshold is applied every point is visible
+    m_filteredPoints = m_points;
+    m_index.build(m_points);
+    m_currentRow = rowIndex;
+
+    DEBUG_LOG("TimelineSeriesFeeder") << "loadRow - Loaded" << m_points.size() << "points for rowIndex:" << rowIndex;
+    emit seriesLoaded();
+    emit filterApplied();
+    return true;
+}
+
+void TimelineSeriesFeeder::clear()
+{
+    m_points.clear();
+    m_filteredPoints.clear();
+    m_index.clear();
+    m_hasViewWindow = false;
+    m_visiblePointCount = 0;
+    m_currentRow = -1;
+    clearOverlay();
+    emit seriesLoaded();
+    emit filterApplied();
+}
+
+int TimelineSeriesFeeder::fillSeries(QAbstractSeries *lineSeries, QAbstractSeries *scatterSeries)
+{
+    m_filteredPoints = m_points;
+    refreshVisible(lineSeries, scatterSeries);
+    return m_points.size();
+}
+
+int TimelineSeriesFeeder::applyThreshold(double threshold, QAbstractSeries *lineSeries,
+                                         QAbstractSeries *scatterSeries, QAbstractSeries *underSeries)
+{
+    // Only keep points where Y value is less than or equal to threshold.
+    // Copy whole runs from the index instead of testing every point.
+    m_filteredPoints.clear();
+    m_filteredPoints.reserve(m_index.countAtOrBelow(threshold));
+    const QVector<QPair<int, int>> runs = m_index.runsAtOrBelow(threshold);
+    for (const QPair<int, int> &run : runs) {
+        for (int i = run.first; i <= run.second; ++i) {
+            m_filteredPoints.append(m_points.at(i));
+        }
+    }
+
+    // One replace() per series = one repaint per series
+    refreshVisible(lineSeries, scatterSeries, underSeries);
+
+    DEBUG_LOG("TimelineSeriesFeeder") << "applyThreshold -" << m_filteredPoints.size() << "of" << m_points.size() << "points <=" << threshold;
+    return m_filteredPoints.size();
+}
+
+void TimelineSeriesFeeder::setViewWindow(double start, double end, int pixelWidth)
+{
+    if (end < start) {
+        DEBUG_LOG("TimelineSeriesFeeder") << "setViewWindow - Invalid range:" << start << end;
+        return;
+    }
+    m_hasViewWindow = true;
+    m_viewStart = start;
+    m_viewEnd = end;
+    m_pixelWidth = qMax(0, pixelWidth);
+}
+
+int TimelineSeriesFeeder::refreshVisible(QAbstractSeries *lineSeries, QAbstractSeries *scatterSeries,
+                                         QAbstractSeries *underSeries)
+{
+    const QVector<QPointF> visible = visiblePoints(m_filteredPoints);
+    replaceSeries(lineSeries, visible);
+    replaceSeries(scatterSeries, visible);
+    replaceSeries(underSeries, visible);
+
+    m_visiblePointCount = visible.size();
+    emit filterApplied();
+    return m_visiblePointCount;
+}
+
+int TimelineSeriesFeeder::nextFrameAtOrBelow(int frame, double threshold) const
+{
+    return m_index.nextFrameAtOrBelow(frame, threshold);
+}
+
+int TimelineSeriesFeeder::previousFrameAtOrBelow(int frame, double threshold) const
+{
+    return m_index.previousFrameAtOrBelow(frame, threshold);
+}
+
+int TimelineSeriesFeeder::countAtOrBelow(double threshold) const
+{
+    return m_index.countAtOrBelow(threshold);
+}
+
+QVariantList TimelineSeriesFeeder::runsAtOrBelow(double threshold) const
+{
+    QVariantList result;
+    const QVector<QPair<int, int>> runs = m_index.runsAtOrBelow(threshold);
+    for (const QPair<int, int> &run : runs) {
+        QVariantMap entry;
+        entry["startFrame"] = m_index.frameAt(run.first);
+        entry["endFrame"] = m_index.frameAt(run.second);
+        entry["length"] = run.second - run.first + 1;
+        result.append(entry);
+    }
+    return result;
+}
+
+double TimelineSeriesFeeder::valueAtFrame(int frame) const
+{
+    // Points are sorted by frame number - binary search
+    auto it = std::lower_bound(m_points.cbegin(), m_points.cend(), frame,
+                               [](const QPointF &point, int f) { return point.x() < f; });
+    if (it != m_points.cend() && static_cast<int>(it->x()) == frame) {
+        return it->y();
+    }
+    return -1.0;
+}
+
+int TimelineSeriesFeeder::loadVersionOverlay(QAbstractSeries *overlaySeries, QAbstractSeries *regressedSeries)
+{
+    clearOverlay();
+
+    if (m_dataModel && m_currentRow >= 0) {
+        // Latest version against the one before it (same pair as the table's version columns)
+        const QStringList versions = m_dataModel->getRowRenderVersions(m_currentRow);
+        if (versions.size() >= 2) {
+            const QString baseVersion = versions.at(versions.size() - 2);
+            const QString baseXml = m_dataModel->getCompareResultXmlForVersion(m_currentRow, baseVersion);
+            const QString testXml = m_dataModel->getCompareResultXmlForVersion(m_currentRow, versions.last());
+            QVector<QPointF> testPoints;
+            if (!baseXml.isEmpty() && !testXml.isEmpty()
+                && XmlDataModel::readFrameValues(baseXml, m_overlayPoints)
+                && XmlDataModel::readFrameValues(testXml, testPoints)) {
+                const VersionDiff diff = VersionComparator::compare(m_overlayPoints, testPoints);
+                const QVector<int> regressed = diff.worsenedFrameList(VersionComparator::DefaultTolerance);
+                m_regressedPoints.reserve(regressed.size());
+                // Both lists are sorted by frame - walk them together
+                int t = 0;
+                for (int frame : regressed) {
+                    while (t < testPoints.size() && testPoints.at(t).x() < frame) {
+                        ++t;
+                    }
+                    if (t < testPoints.size()) {
+                        m_regressedPoints.append(testPoints.at(t));
+                    }
+                }
+                m_overlayVersion = baseVersion;
+            } else {
+                m_overlayPoints.clear();
+            }
+        }
+    }
+
+    DEBUG_LOG("TimelineSeriesFeeder") << "loadVersionOverlay - Version:" << m_overlayVersion
+                                      << "regressed frames:" << m_regressedPoints.size();
+    refreshOverlay(overlaySeries, regressedSeries);
+    emit overlayChanged();
+    return m_regressedPoints.size();
+}
+
+void TimelineSeriesFeeder::refreshOverlay(QAbstractSeries *overlaySeries, QAbstractSeries *regressedSeries)
+{
+    replaceSeries(overlaySeries, visiblePoints(m_overlayPoints));
+    replaceSeries(regressedSeries, visiblePoints(m_regressedPoints));
+}
+
+int TimelineSeriesFeeder::refreshRoiCurve(QAbstractSeries *roiSeries)
+{
+    const QVector<QPointF> points = m_roiStats ? visiblePoints(m_roiStats->rangePoints()) : QVector<QPointF>();
+    replaceSeries(roiSeries, points);
+    return points.size();
+}
+
+void TimelineSeriesFeeder::clearOverlay()
+{
+    const bool hadOverlay = !m_overlayVersion.isEmpty();
+    m_overlayVersion.clear();
+    m_overlayPoints.clear();
+    m_regressedPoints.clear();
+    if (hadOverlay) {
+        emit overlayChanged();
+    }
+}
+
+QVector<QPointF> TimelineSeriesFeeder::visiblePoints(const QVector<QPointF> &points) const
+{
+    if (points.isEmpty()) {
+        return points;
+    }
+    const double start = m_hasViewWindow ? m_viewStart : points.first().x();
+    const double end = m_hasViewWindow ? m_viewEnd : points.last().x();
+    return SeriesDecimator::minMax(points, start, end, m_pixelWidth);
+}
+
+void TimelineSeriesFeeder::replaceSeries(QAbstractSeries *series, const QVector<QPointF> &points)
+{
+    if (!series) {
+        return;
+    }
+    QXYSeries *xySeries = qobject_cast<QXYSeries *>(series);
+    if (!xySeries) {
+        DEBUG_LOG("TimelineSeriesFeeder") << "replaceSeries - Series is not an XY series:" << series;
+        return;
+    }
+    xySeries->replace(points);
+}
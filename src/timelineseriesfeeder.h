@@ -0,0 +1,227 @@
+#ifndef TIMELINESERIESFEEDER_H
+#define TIMELINESERIESFEEDER_H
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QVariantList>
+#include <QtCharts/QAbstractSeries>
+#include "framevalueindex.h"
+
+QT_CHARTS_USE_NAMESPACE
+
+// Forward declarations
+class XmlDataModel;
+class RoiStatsService;
+
+/**
+ * @brief TimelineSeriesFeeder - Fills TimelineChart series from C++ in one call per series
+ *
+ * TimelineChart.qml used to copy the frame/value arrays in JavaScript and append
+ * every point to the LineSeries/ScatterSeries individually. Each append triggers a
+ * repaint, which made events with 10k+ frames take seconds to open.
+ *
+ * This class takes the parsed points straight from XmlDataModel's compareResult.xml
+ * cache and pushes them into the QML series with QXYSeries::replace(), so each
+ * series is updated (and repainted) once. Threshold filtering is done natively.
+ *
+ * The series only get the points of the current zoom window, downsampled to
+ * min/max per pixel column (see SeriesDecimator). valueAtFrame() and the
+ * threshold queries (see FrameValueIndex) always use full-resolution data.
+ *
+ * Usage from QML (series are passed by id):
+ *   timelineSeriesFeeder.loadRow(sourceRow)
+ *   timelineSeriesFeeder.setViewWindow(value_start, value_end, chart.plotArea.width)
+ *   timelineSeriesFeeder.applyThreshold(threshold, lineSeries, scatterSeries, scatterUnderValue)
+ */
+class TimelineSeriesFeeder : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY seriesLoaded)
+    Q_PROPERTY(int filteredPointCount READ filteredPointCount NOTIFY filterApplied)
+    Q_PROPERTY(int visiblePointCount READ visiblePointCount NOTIFY filterApplied)
+    Q_PROPERTY(QString overlayVersion READ overlayVersion NOTIFY overlayChanged)
+    Q_PROPERTY(int regressedFrameCount READ regressedFrameCount NOTIFY overlayChanged)
+
+public:
+    explicit TimelineSeriesFeeder(QObject *parent = nullptr);
+
+    /**
+     * @brief Set the data model the points are read from
+     * @param model - XmlDataModel instance (not owned)
+     */
+    void setDataModel(XmlDataModel *model);
+
+    /**
+     * @brief Set the service whose region curve refreshRoiCurve() plots
+     * @param service - RoiStatsService instance (not owned)
+     */
+    void setRoiStatsService(RoiStatsService *service);
+
+    /**
+     * @brief Load the (frame, value) points of a row from the data model
+     * @param rowIndex - Source model row index
+     * @return true if points were loaded
+     */
+    Q_INVOKABLE bool loadRow(int rowIndex);
+
+    /**
+     * @brief Drop the loaded points
+     */
+    Q_INVOKABLE void clear();
+
+    /**
+     * @brief Replace the contents of the given series with all loaded points (downsampled to the view window)
+     * @param lineSeries - QML LineSeries (may be null)
+     * @param scatterSeries - QML ScatterSeries (may be null)
+     * @return Number of full-resolution points loaded
+     */
+    Q_INVOKABLE int fillSeries(QAbstractSeries *lineSeries, QAbstractSeries *scatterSeries);
+
+    /**
+     * @brief Show only points with value <= threshold
+     * @param threshold - Threshold value (points with Y <= threshold are kept)
+     * @param lineSeries - QML LineSeries (may be null)
+     * @param scatterSeries - QML ScatterSeries (may be null)
+     * @param underSeries - Red "under threshold" ScatterSeries (may be null)
+     * @return Number of points that passed the filter
+     */
+    Q_INVOKABLE int applyThreshold(double threshold, QAbstractSeries *lineSeries,
+                                   QAbstractSeries *scatterSeries, QAbstractSeries *underSeries);
+
+    /**
+     * @brief Set the visible frame range and plot width used for downsampling
+     *
+     * Only stores the window - call refreshVisible() to rewrite the series.
+     * loadRow() resets the window to the whole sequence.
+     *
+     * @param start - First visible frame (chart X axis min)
+     * @param end - Last visible frame (chart X axis max)
+     * @param pixelWidth - Plot area width in pixels (one bucket per pixel column, 0 = no downsampling)
+     */
+    Q_INVOKABLE void setViewWindow(double start, double end, int pixelWidth);
+
+    /**
+     * @brief Rewrite the series for the current view window and threshold
+     * @param lineSeries - QML LineSeries (may be null)
+     * @param scatterSeries - QML ScatterSeries (may be null)
+     * @param underSeries - Red "under threshold" ScatterSeries (may be null)
+     * @return Number of points written to each series
+     */
+    Q_INVOKABLE int refreshVisible(QAbstractSeries *lineSeries, QAbstractSeries *scatterSeries,
+                                   QAbstractSeries *underSeries = nullptr);
+
+    /**
+     * @brief Find the next frame after a given frame with value <= threshold
+     * @param frame - Current frame (exclusive)
+     * @param threshold - Threshold value
+     * @return Frame number, or -1 if there is none
+     */
+    Q_INVOKABLE int nextFrameAtOrBelow(int frame, double threshold) const;
+
+    /**
+     * @brief Find the previous frame before a given frame with value <= threshold
+     * @param frame - Current frame (exclusive)
+     * @param threshold - Threshold value
+     * @return Frame number, or -1 if there is none
+     */
+    Q_INVOKABLE int previousFrameAtOrBelow(int frame, double threshold) const;
+
+    /**
+     * @brief Count frames with value <= threshold
+     * @param threshold - Threshold value
+     * @return Number of frames
+     */
+    Q_INVOKABLE int countAtOrBelow(double threshold) const;
+
+    /**
+     * @brief Get the runs of consecutive frames with value <= threshold
+     * @param threshold - Threshold value
+     * @return List of maps with startFrame, endFrame and length, in frame order
+     */
+    Q_INVOKABLE QVariantList runsAtOrBelow(double threshold) const;
+
+    /**
+     * @brief Get the full-resolution value for a frame number
+     * @param frame - Frame number
+     * @return Frame value, or -1.0 if the frame is not in the loaded data
+     */
+    Q_INVOKABLE double valueAtFrame(int frame) const;
+
+    /**
+     * @brief Load the previous render version of the current row as an overlay
+     *
+     * Reads the previous and latest render versions' compareResult.xml, puts the
+     * previous version's curve in overlaySeries and the frames that got worse in the
+     * latest version (at their latest values) in regressedSeries. Both series are
+     * cleared if the row has fewer than two render versions.
+     *
+     * @param overlaySeries - QML LineSeries for the previous version (may be null)
+     * @param regressedSeries - QML ScatterSeries for regressed frames (may be null)
+     * @return Number of regressed frames
+     */
+    Q_INVOKABLE int loadVersionOverlay(QAbstractSeries *overlaySeries, QAbstractSeries *regressedSeries);
+
+    /**
+     * @brief Rewrite the overlay series for the current view window
+     * @param overlaySeries - QML LineSeries for the previous version (may be null)
+     * @param regressedSeries - QML ScatterSeries for regressed frames (may be null)
+     */
+    Q_INVOKABLE void refreshOverlay(QAbstractSeries *overlaySeries, QAbstractSeries *regressedSeries);
+
+    /**
+     * @brief Rewrite the region-of-interest curve (RoiStatsService::rangePoints()) for the current view window
+     * @param roiSeries - QML LineSeries (may be null)
+     * @return Number of points written
+     */
+    Q_INVOKABLE int refreshRoiCurve(QAbstractSeries *roiSeries);
+
+    int pointCount() const { return m_points.size(); }
+    int filteredPointCount() const { return m_filteredPoints.size(); }
+    int visiblePointCount() const { return m_visiblePointCount; }
+    QString overlayVersion() const { return m_overlayVersion; }
+    int regressedFrameCount() const { return m_regressedPoints.size(); }
+
+    /**
+     * @brief Full-resolution points currently loaded (sorted by frame number)
+     */
+    const QVector<QPointF> &points() const { return m_points; }
+
+signals:
+    void seriesLoaded();
+    void filterApplied();
+    void overlayChanged();
+
+private:
+    /**
+     * @brief Replace series contents if the series is an XY series
+     */
+    static void replaceSeries(QAbstractSeries *series, const QVector<QPointF> &points);
+
+    /**
+     * @brief Downsample points for the current view window
+     */
+    QVector<QPointF> visiblePoints(const QVector<QPointF> &points) const;
+
+    /**
+     * @brief Drop the version overlay
+     */
+    void clearOverlay();
+
+    XmlDataModel *m_dataModel;
+    RoiStatsService *m_roiStats;
+    int m_currentRow;                   // Row loaded by loadRow() (-1 = none)
+    QVector<QPointF> m_points;          // Full-resolution data (never filtered)
+    QVector<QPointF> m_filteredPoints;  // Points passing the current threshold
+    FrameValueIndex m_index;            // Threshold queries over m_points
+    bool m_hasViewWindow;               // false = whole sequence is visible
+    double m_viewStart;
+    double m_viewEnd;
+    int m_pixelWidth;
+    int m_visiblePointCount;            // Points currently in the line/scatter series
+    QString m_overlayVersion;           // Render version shown as overlay (empty = none)
+    QVector<QPointF> m_overlayPoints;   // Previous version's points
+    QVector<QPointF> m_regressedPoints; // Frames that got worse, at the latest version's values
+};
+
+#endif // TIMELINESERIESFEEDER_H
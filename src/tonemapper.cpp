@@ -0,0 +1,171 @@
+#include "tonemapper.h"
+#include "logger.h"
+#include <QMutexLocker>
+#include <cmath>
+
+namespace {
+
+const int kTableSize = 65536;
+
+double srgbToLinear(double value)
+{
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+double linearToSrgb(double value)
+{
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+QImage::Format outputFormat(const QImage &image)
+{
+    return image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32;
+}
+
+/**
+ * @brief Map 16-bit RGBA pixels through the table
+ * @param image - Format_RGBA64 or Format_RGBX64 (straight alpha)
+ */
+QImage mapWide(const QImage &image, const QVector<quint8> &table)
+{
+    QImage result(image.size(), outputFormat(image));
+    const quint8 *lookup = table.constData();
+    for (int y = 0; y < image.height(); ++y) {
+        const quint16 *source = reinterpret_cast<const quint16 *>(image.constScanLine(y));
+        QRgb *target = reinterpret_cast<QRgb *>(result.scanLine(y));
+        for (int x = 0; x < image.width(); ++x, source += 4) {
+            target[x] = qRgba(lookup[source[0]], lookup[source[1]], lookup[source[2]], source[3] >> 8);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Map 8-bit pixels through the table (entries v * 257, the 16-bit value of v)
+ * @param image - Format_RGB32 or Format_ARGB32
+ */
+QImage mapNarrow(const QImage &image, const QVector<quint8> &table)
+{
+    quint8 lookup[256];
+    for (int value = 0; value < 256; ++value) {
+        lookup[value] = table.at(value * 257);
+    }
+    QImage result(image.size(), image.format());
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb *source = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        QRgb *target = reinterpret_cast<QRgb *>(result.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const QRgb pixel = source[x];
+            target[x] = qRgba(lookup[qRed(pixel)], lookup[qGreen(pixel)], lookup[qBlue(pixel)], qAlpha(pixel));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+ToneMapper::ToneMapper(QObject *parent)
+    : QObject(parent)
+    , m_exposure(0.0)
+    , m_curve(Clip)
+    , m_revision(0)
+{
+    rebuild();
+}
+
+void ToneMapper::rebuild()
+{
+    if (isIdentity()) {
+        QMutexLocker locker(&m_mutex);
+        m_table.reset();  // apply() passes frames through
+        return;
+    }
+    QVector<quint8> *table = new QVector<quint8>(kTableSize);
+    const double gain = std::pow(2.0, m_exposure);
+    for (int value = 0; value < kTableSize; ++value) {
+        double linear = srgbToLinear(value / 65535.0) * gain;
+        if (m_curve == Reinhard) {
+            linear = linear / (1.0 + linear);
+        }
+        const double encoded = linearToSrgb(qBound(0.0, linear, 1.0));
+        (*table)[value] = static_cast<quint8>(qRound(encoded * 255.0));
+    }
+    QMutexLocker locker(&m_mutex);
+    m_table = QSharedPointer<const QVector<quint8>>(table);
+}
+
+QImage ToneMapper::apply(const QImage &image) const
+{
+    QSharedPointer<const QVector<quint8>> table;
+    {
+        QMutexLocker locker(&m_mutex);
+        table = m_table;
+    }
+    if (image.isNull() || !table) {
+        return image;  // Identity
+    }
+
+    switch (image.format()) {
+    case QImage::Format_RGBA64:
+    case QImage::Format_RGBX64:
+        return mapWide(image, *table);
+    case QImage::Format_RGBA64_Premultiplied:
+        return mapWide(image.convertToFormat(QImage::Format_RGBA64), *table);
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+        return mapNarrow(image, *table);
+    default:
+        return mapNarrow(image.convertToFormat(outputFormat(image)), *table);
+    }
+}
+
+bool ToneMapper::appliesTo(const QString &imageType) const
+{
+    return imageType == QLatin1String("A") || imageType == QLatin1String("B");
+}
+
+void ToneMapper::setExposure(double stops)
+{
+    stops = qBound(-double(MaxExposure), stops, double(MaxExposure));
+    if (stops == m_exposure) {
+        return;
+    }
+    m_exposure = stops;
+    rebuild();
+    ++m_revision;
+    DEBUG_LOG("ToneMapper") << "setExposure -" << m_exposure;
+    emit settingsChanged();
+}
+
+void ToneMapper::setCurve(Curve curve)
+{
+    if (curve == m_curve) {
+        return;
+    }
+    m_curve = curve;
+    rebuild();
+    ++m_revision;
+    DEBUG_LOG("ToneMapper") << "setCurve -" << curveName();
+    emit settingsChanged();
+}
+
+QString ToneMapper::curveName() const
+{
+    return m_curve == Reinhard ? QStringLiteral("Reinhard") : QStringLiteral("Clip");
+}
+
+void ToneMapper::stepExposure(double stops)
+{
+    setExposure(m_exposure + stops);
+}
+
+void ToneMapper::cycleCurve()
+{
+    setCurve(m_curve == Clip ? Reinhard : Clip);
+}
+
+void ToneMapper::reset()
+{
+    setCurve(Clip);
+    setExposure(0.0);
+}
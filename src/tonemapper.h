@@ -0,0 +1,100 @@
+#ifndef TONEMAPPER_H
+#define TONEMAPPER_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+/**
+ * @brief ToneMapper - Exposure and tone curve for displaying the renders ("toneMapper" in QML)
+ *
+ * Decoded frames keep their full precision (16-bit PNG/TIFF frames stay
+ * QImage::Format_RGBA64 in FrameRing and the tile cache; statistics run on them).
+ * Only what the A and B panes show goes through apply(): values are linearized
+ * (sRGB), scaled by 2^exposure, passed through the curve and encoded back to 8 bits,
+ * so detail hidden in the highlights or shadows of a 16-bit render can be brought
+ * into view. The diff (C) and alpha (D) images are never tone mapped.
+ *
+ * The whole transform is one lookup table over all 65536 16-bit values, rebuilt when
+ * a setting changes, so a frame costs one table read per channel whatever the curve.
+ * With the default settings apply() returns frames unchanged.
+ *
+ * Settings change on the main thread; apply() may run on any thread (image providers).
+ */
+class ToneMapper : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double exposure READ exposure WRITE setExposure NOTIFY settingsChanged)
+    Q_PROPERTY(Curve curve READ curve WRITE setCurve NOTIFY settingsChanged)
+    Q_PROPERTY(QString curveName READ curveName NOTIFY settingsChanged)
+    Q_PROPERTY(bool identity READ isIdentity NOTIFY settingsChanged)
+    Q_PROPERTY(int revision READ revision NOTIFY settingsChanged)
+
+public:
+    enum Curve {
+        Clip,       // Values above white are clipped
+        Reinhard    // x / (1 + x): highlights roll off instead of clipping
+    };
+    Q_ENUM(Curve)
+
+    static const int MaxExposure = 8;  // Stops either way
+
+    explicit ToneMapper(QObject *parent = nullptr);
+
+    /**
+     * @brief Tone map an image for display
+     * @param image - Decoded frame (any format; 64-bit formats are read at full precision)
+     * @return 8-bit image (Format_RGB32, or Format_ARGB32 if the image has alpha),
+     *         or the image itself if the settings are the identity
+     */
+    QImage apply(const QImage &image) const;
+
+    /**
+     * @brief Whether an image type is tone mapped (the A and B renders; not diff or alpha images)
+     * @param imageType - Image type: "A", "B", "C", or "D"
+     */
+    Q_INVOKABLE bool appliesTo(const QString &imageType) const;
+
+    /**
+     * @brief Change the exposure by some stops (clamped to +-MaxExposure)
+     */
+    Q_INVOKABLE void stepExposure(double stops);
+
+    /**
+     * @brief Switch to the next curve
+     */
+    Q_INVOKABLE void cycleCurve();
+
+    /**
+     * @brief Back to exposure 0 and the clip curve (frames shown as decoded)
+     */
+    Q_INVOKABLE void reset();
+
+    double exposure() const { return m_exposure; }
+    void setExposure(double stops);
+    Curve curve() const { return m_curve; }
+    void setCurve(Curve curve);
+    QString curveName() const;
+    bool isIdentity() const { return m_exposure == 0.0 && m_curve == Clip; }
+
+    /**
+     * @brief Bumped by every settings change; image URLs include it so QML reloads
+     */
+    int revision() const { return m_revision; }
+
+signals:
+    void settingsChanged();
+
+private:
+    void rebuild();
+
+    double m_exposure;
+    Curve m_curve;
+    int m_revision;
+    mutable QMutex m_mutex;                         // Guards m_table for apply() on other threads
+    QSharedPointer<const QVector<quint8>> m_table;  // 16-bit value -> 8-bit display value (null = identity)
+};
+
+#endif // TONEMAPPER_H
@@ -0,0 +1,219 @@
+#include "tracer.h"
+#include "logger.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+namespace {
+
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    qint64 start;
+    qint64 end;
+    qint64 value;
+};
+
+const quint64 BufferCapacity = 1 << 16;  // Newest spans kept per thread (~2.5 MB)
+
+// Buffers of exited threads kept for the trace file; older ones are reused by new threads
+const size_t MaxFinishedBuffers = 8;
+
+/**
+ * @brief Span ring of one thread - written only by that thread
+ */
+struct ThreadBuffer
+{
+    int threadId;
+    QString threadName;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<quint64> count;  // Spans recorded so far (index modulo BufferCapacity)
+
+    ThreadBuffer() : threadId(0), events(new TraceEvent[BufferCapacity]), count(0) {}
+};
+
+// Buffers of running threads and the newest MaxFinishedBuffers of exited ones, in track order
+QMutex s_registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+std::deque<ThreadBuffer *> s_finishedBuffers;  // Oldest first
+int s_nextThreadId = 1;
+QString s_outputPath;
+std::atomic<qint64> s_sessionStart(0);
+
+/**
+ * @brief Hands the buffer back when its thread exits (thread_local destructor)
+ */
+struct BufferOwner
+{
+    ThreadBuffer *buffer = nullptr;
+    ~BufferOwner();
+};
+
+thread_local BufferOwner t_owner;
+
+BufferOwner::~BufferOwner()
+{
+    if (!buffer) {
+        return;
+    }
+    QMutexLocker locker(&s_registryMutex);
+    s_finishedBuffers.push_back(buffer);
+    // Several threads exiting at once: drop the oldest spans beyond the limit
+    while (s_finishedBuffers.size() > MaxFinishedBuffers) {
+        ThreadBuffer *oldest = s_finishedBuffers.front();
+        s_finishedBuffers.pop_front();
+        s_buffers.erase(std::find_if(s_buffers.begin(), s_buffers.end(),
+                                     [oldest](const std::unique_ptr<ThreadBuffer> &owned) { return owned.get() == oldest; }));
+    }
+}
+
+ThreadBuffer *threadBuffer()
+{
+    if (!t_owner.buffer) {
+        QThread *thread = QThread::currentThread();
+        QMutexLocker locker(&s_registryMutex);
+        ThreadBuffer *buffer = nullptr;
+        if (s_finishedBuffers.size() >= MaxFinishedBuffers) {
+            // Reuse the buffer of the thread that exited first; its track moves to the end
+            buffer = s_finishedBuffers.front();
+            s_finishedBuffers.pop_front();
+            auto it = std::find_if(s_buffers.begin(), s_buffers.end(),
+                                   [buffer](const std::unique_ptr<ThreadBuffer> &owned) { return owned.get() == buffer; });
+            std::unique_ptr<ThreadBuffer> reused = std::move(*it);
+            s_buffers.erase(it);
+            s_buffers.push_back(std::move(reused));
+            buffer->count.store(0, std::memory_order_relaxed);
+        } else {
+            s_buffers.emplace_back(new ThreadBuffer);
+            buffer = s_buffers.back().get();
+        }
+        buffer->threadId = s_nextThreadId++;
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            buffer->threadName = QStringLiteral("Main thread");
+        } else {
+            const QString name = thread->objectName().isEmpty() ? QStringLiteral("Thread") : thread->objectName();
+            buffer->threadName = QString("%1 %2").arg(name).arg(buffer->threadId);
+        }
+        t_owner.buffer = buffer;
+    }
+    return t_owner.buffer;
+}
+
+QByteArray jsonString(const QString &text)
+{
+    QString escaped = text;
+    escaped.replace('\\', QStringLiteral("\\\\")).replace('"', QStringLiteral("\\\""));
+    return '"' + escaped.toUtf8() + '"';
+}
+
+QByteArray micros(qint64 nanoseconds)
+{
+    return QByteArray::number(nanoseconds / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+void Tracer::start(const QString &outputPath)
+{
+    {
+        QMutexLocker locker(&s_registryMutex);
+        s_outputPath = outputPath;
+    }
+    s_sessionStart.store(now());
+    s_enabled.store(true);
+    INFO_LOG("Tracing enabled, trace file:" << outputPath);
+}
+
+bool Tracer::stop()
+{
+    if (!s_enabled.exchange(false)) {
+        return false;
+    }
+    QString outputPath;
+    {
+        QMutexLocker locker(&s_registryMutex);
+        outputPath = s_outputPath;
+    }
+    if (!writeTrace(outputPath)) {
+        ERROR_LOG("Tracer::stop - Failed to write trace file:" << outputPath);
+        return false;
+    }
+    INFO_LOG("Trace written to" << outputPath << "(open in https://ui.perfetto.dev)");
+    return true;
+}
+
+void Tracer::record(const char *category, const char *name, qint64 startNs, qint64 endNs, qint64 value)
+{
+    ThreadBuffer *buffer = threadBuffer();
+    const quint64 index = buffer->count.load(std::memory_order_relaxed);
+    TraceEvent &event = buffer->events[index % BufferCapacity];
+    event.category = category;
+    event.name = name;
+    event.start = startNs;
+    event.end = endNs;
+    event.value = value;
+    // Publish the span to writeTrace()
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+int Tracer::bufferCount()
+{
+    QMutexLocker locker(&s_registryMutex);
+    return static_cast<int>(s_buffers.size());
+}
+
+bool Tracer::writeTrace(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    const qint64 sessionStart = s_sessionStart.load();
+    QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    bool written = true;
+
+    QMutexLocker locker(&s_registryMutex);
+    for (const std::unique_ptr<ThreadBuffer> &buffer : s_buffers) {
+        const QByteArray tid = QByteArray::number(buffer->threadId);
+        json += first ? "" : ",\n";
+        first = false;
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid
+              + ",\"args\":{\"name\":" + jsonString(buffer->threadName) + "}}";
+
+        // Spans of a thread that is still running may be overwritten while we read;
+        // tracing is already off, so at most its last in-flight scopes are affected
+        const quint64 count = buffer->count.load(std::memory_order_acquire);
+        const quint64 firstIndex = count > BufferCapacity ? count - BufferCapacity : 0;
+        for (quint64 i = firstIndex; i < count; ++i) {
+            const TraceEvent &event = buffer->events[i % BufferCapacity];
+            if (event.start < sessionStart) {
+                continue;  // From an earlier start()/stop() session
+            }
+            json += ",\n{\"name\":\"" + QByteArray(event.name) + "\",\"cat\":\"" + QByteArray(event.category)
+                  + "\",\"ph\":\"X\",\"ts\":" + micros(event.start - sessionStart)
+                  + ",\"dur\":" + micros(event.end - event.start)
+                  + ",\"pid\":" + pid + ",\"tid\":" + tid;
+            if (event.value >= 0) {
+                json += ",\"args\":{\"value\":" + QByteArray::number(event.value) + "}";
+            }
+            json += "}";
+        }
+        if (json.size() > (1 << 20)) {
+            written = written && file.write(json) == json.size();
+            json.clear();
+        }
+    }
+    json += "\n]}\n";
+    return written && file.write(json) == json.size();
+}
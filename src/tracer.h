@@ -0,0 +1,125 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Tracer - Low-overhead span tracing with Chrome trace / Perfetto JSON export
+ *
+ * Hot paths are marked with TRACE_SCOPE; each marked scope becomes one span on its
+ * thread's track when tracing is enabled. Spans go into a per-thread ring buffer
+ * (only the newest spans are kept when a buffer wraps), and are written as one JSON
+ * file when tracing stops. The file opens in https://ui.perfetto.dev or chrome://tracing.
+ *
+ * A thread's first span takes a buffer under a lock - allocating one only if no
+ * buffer of an exited thread can be reused; later spans take no locks and allocate
+ * nothing. Buffers of exited threads keep their spans for the trace file, but only
+ * the newest few are kept, so thread pools replacing idle threads don't grow memory.
+ *
+ * Tracing is enabled at startup with "--trace [file]" or RENDERCOMPARE_TRACE=<file>
+ * (see main.cpp). When disabled, a TRACE_SCOPE costs one relaxed atomic load.
+ * Building with RENDERCOMPARE_NO_TRACE compiles all TRACE_SCOPEs out.
+ *
+ * Usage:
+ *   TRACE_SCOPE("ImageLoaderManager", "loadImageFromDisk");
+ *   TRACE_SCOPE_VALUE("XmlDataModel", "getParsedXmlData", rowIndex);  // Shown as an arg
+ *
+ * Category and name must be string literals (only the pointers are stored).
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief Start recording
+     * @param outputPath - Trace file written by stop()
+     */
+    static void start(const QString &outputPath);
+
+    /**
+     * @brief Stop recording and write the trace file
+     * @return true if the file was written (false if tracing wasn't started or the write failed)
+     */
+    static bool stop();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Monotonic timestamp used for spans, in nanoseconds
+     */
+    static qint64 now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Record a finished span on the calling thread
+     * @param category - Category (string literal)
+     * @param name - Span name (string literal)
+     * @param startNs - Start, from now()
+     * @param endNs - End, from now()
+     * @param value - Optional argument shown with the span (-1 = none)
+     */
+    static void record(const char *category, const char *name, qint64 startNs, qint64 endNs, qint64 value);
+
+    /**
+     * @brief Write the recorded spans as Chrome trace event JSON
+     * @param filePath - Output file
+     * @return true on success
+     */
+    static bool writeTrace(const QString &filePath);
+
+    /**
+     * @brief Span buffers held, of running and exited threads (diagnostics and tests)
+     */
+    static int bufferCount();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief TraceScope - Records the lifetime of a scope as a span (use TRACE_SCOPE)
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name, qint64 value = -1)
+        : m_category(category)
+        , m_name(name)
+        , m_value(value)
+        , m_start(Tracer::isEnabled() ? Tracer::now() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_start >= 0) {
+            Tracer::record(m_category, m_name, m_start, Tracer::now(), m_value);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    const char *m_category;
+    const char *m_name;
+    qint64 m_value;
+    qint64 m_start;  // -1 if tracing was disabled when the scope was entered
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifndef RENDERCOMPARE_NO_TRACE
+    #define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+    #define TRACE_SCOPE_VALUE(category, name, value) \
+        TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name, static_cast<qint64>(value))
+#else
+    #define TRACE_SCOPE(category, name) ((void)0)
+    #define TRACE_SCOPE_VALUE(category, name, value) ((void)0)
+#endif
+
+#endif // TRACER_H
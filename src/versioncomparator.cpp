@@ -0,0 +1,109 @@
+#include "versioncomparator.h"
+#include <algorithm>
+
+constexpr double VersionComparator::DefaultTolerance;
+
+VersionDiff::VersionDiff()
+    : commonFrames(0)
+    , worsenedFrames(0)
+    , meanDelta(0.0)
+    , worstDelta(0.0)
+    , worstFrame(-1)
+{
+}
+
+QVector<int> VersionDiff::worsenedFrameList(double tolerance) const
+{
+    QVector<int> result;
+    for (int i = 0; i < deltas.size(); ++i) {
+        if (deltas.at(i) < -tolerance) {
+            result.append(frames.at(i));
+        }
+    }
+    return result;
+}
+
+void VersionComparator::align(const QVector<QPointF> &base, const QVector<QPointF> &test,
+                              QVector<int> &frames, QVector<float> &baseValues, QVector<float> &testValues)
+{
+    frames.clear();
+    baseValues.clear();
+    testValues.clear();
+
+    const int maxCommon = std::min(base.size(), test.size());
+    frames.reserve(maxCommon);
+    baseValues.reserve(maxCommon);
+    testValues.reserve(maxCommon);
+
+    // Fast path: both versions rendered the same frames
+    bool sameFrames = base.size() == test.size();
+    for (int i = 0; sameFrames && i < base.size(); ++i) {
+        sameFrames = base.at(i).x() == test.at(i).x();
+    }
+    if (sameFrames) {
+        for (int i = 0; i < base.size(); ++i) {
+            frames.append(static_cast<int>(base.at(i).x()));
+            baseValues.append(static_cast<float>(base.at(i).y()));
+            testValues.append(static_cast<float>(test.at(i).y()));
+        }
+        return;
+    }
+
+    // Merge-join on frame number
+    int b = 0;
+    int t = 0;
+    while (b < base.size() && t < test.size()) {
+        const double baseFrame = base.at(b).x();
+        const double testFrame = test.at(t).x();
+        if (baseFrame < testFrame) {
+            ++b;
+        } else if (testFrame < baseFrame) {
+            ++t;
+        } else {
+            frames.append(static_cast<int>(baseFrame));
+            baseValues.append(static_cast<float>(base.at(b).y()));
+            testValues.append(static_cast<float>(test.at(t).y()));
+            ++b;
+            ++t;
+        }
+    }
+}
+
+VersionDiff VersionComparator::compare(const QVector<QPointF> &base, const QVector<QPointF> &test,
+                                       double tolerance)
+{
+    VersionDiff diff;
+    QVector<float> baseValues;
+    QVector<float> testValues;
+    align(base, test, diff.frames, baseValues, testValues);
+
+    const int count = diff.frames.size();
+    diff.commonFrames = count;
+    if (count == 0) {
+        return diff;
+    }
+
+    // Delta and reductions over contiguous arrays, no branches in the loop body
+    diff.deltas.resize(count);
+    const float *baseData = baseValues.constData();
+    const float *testData = testValues.constData();
+    float *deltaData = diff.deltas.data();
+    const float limit = static_cast<float>(-tolerance);
+    double sum = 0.0;
+    int worsened = 0;
+    for (int i = 0; i < count; ++i) {
+        const float delta = testData[i] - baseData[i];
+        deltaData[i] = delta;
+        sum += delta;
+        worsened += delta < limit ? 1 : 0;
+    }
+    diff.meanDelta = sum / count;
+    diff.worsenedFrames = worsened;
+
+    const float *worst = std::min_element(deltaData, deltaData + count);
+    if (*worst < 0.0f) {
+        diff.worstDelta = *worst;
+        diff.worstFrame = diff.frames.at(static_cast<int>(worst - deltaData));
+    }
+    return diff;
+}
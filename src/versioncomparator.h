@@ -0,0 +1,69 @@
+#ifndef VERSIONCOMPARATOR_H
+#define VERSIONCOMPARATOR_H
+
+#include <QVector>
+#include <QPointF>
+
+/**
+ * @brief VersionDiff - Result of comparing one test key across two render versions
+ *
+ * Delta is (test value - base value) per frame; similarity values are higher-is-better,
+ * so a negative delta means the frame got worse in the test version.
+ */
+struct VersionDiff
+{
+    int commonFrames;      // Frames present in both series
+    int worsenedFrames;    // Frames with delta < -tolerance
+    double meanDelta;
+    double worstDelta;     // Most negative delta (0 if nothing got worse)
+    int worstFrame;        // Frame of worstDelta (-1 if none)
+    QVector<int> frames;   // Aligned frame numbers (ascending)
+    QVector<float> deltas; // Aligned deltas, same length as frames
+
+    VersionDiff();
+
+    bool isValid() const { return commonFrames > 0; }
+
+    /**
+     * @brief Frames that got worse by more than the tolerance used for the comparison
+     */
+    QVector<int> worsenedFrameList(double tolerance) const;
+};
+
+/**
+ * @brief VersionComparator - Aligns per-frame series of two render versions and diffs them
+ *
+ * Both series are (frame, value) points sorted by frame, as read from each version's
+ * compareResult.xml. They are aligned on frame number into contiguous float arrays
+ * (a merge-join; a straight copy when the frame lists are identical, which is the
+ * common case), and the delta/reduction runs as a branch-free loop over those arrays
+ * so the compiler can vectorize it.
+ */
+class VersionComparator
+{
+public:
+    static constexpr double DefaultTolerance = 0.01;  // Smaller drops are treated as noise
+
+    /**
+     * @brief Compare a test version against a base version
+     * @param base - Base (older) version points, sorted by frame
+     * @param test - Test (newer) version points, sorted by frame
+     * @param tolerance - Minimum drop in value for a frame to count as worsened
+     * @return Diff over the frames both versions have
+     */
+    static VersionDiff compare(const QVector<QPointF> &base, const QVector<QPointF> &test,
+                               double tolerance = DefaultTolerance);
+
+    /**
+     * @brief Align two series on frame number
+     * @param base - Base version points, sorted by frame
+     * @param test - Test version points, sorted by frame
+     * @param frames - Output: frames present in both
+     * @param baseValues - Output: base values for those frames
+     * @param testValues - Output: test values for those frames
+     */
+    static void align(const QVector<QPointF> &base, const QVector<QPointF> &test,
+                      QVector<int> &frames, QVector<float> &baseValues, QVector<float> &testValues);
+};
+
+#endif // VERSIONCOMPARATOR_H
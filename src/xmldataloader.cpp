@@ -1,5 +1,7 @@
 #include "xmldataloader.h"
 #include "logger.h"
+#include "tracer.h"
+#include "metricsregistry.h"
 #include <QFile>
 #include <QDirIterator>
 #include <QFileInfo>
@@ -42,6 +44,7 @@ void XmlDataLoader::loadData(const QString &resultsPath, const QString &testSets
  */
 void XmlDataLoader::doLoad()
 {
+    TRACE_SCOPE("XmlDataLoader", "doLoad");
     // Validate input path
     if (m_resultsPath.isEmpty()) {
         emit errorOccurred("Results path is empty");
@@ -80,6 +83,8 @@ void XmlDataLoader::doLoad()
 
 int XmlDataLoader::readUIDataXML(const QString &uiDataXmlPath, const QString &resultsPathRoot)
 {
+    TRACE_SCOPE("XmlDataLoader", "readUIDataXML");
+    ScopedLatency latency(MetricsRegistry::XmlParseLatency);
     // Ensure path uses native separators
     QString normalizedPath = QDir::toNativeSeparators(uiDataXmlPath);
     QFileInfo fileInfo(normalizedPath);
@@ -202,6 +207,7 @@ int XmlDataLoader::readUIDataXML(const QString &uiDataXmlPath, const QString &re
 
 QString XmlDataLoader::resolveThumbnailPath(const QString &relativeThumbnailPath, const QString &resultsPathRoot) const
 {
+    TRACE_SCOPE("XmlDataLoader", "resolveThumbnailPath");
     if (relativeThumbnailPath.isEmpty()) {
         return QString();
     }
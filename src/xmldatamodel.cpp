@@ -1,6 +1,10 @@
 #include "xmldatamodel.h"
 #include "xmldataloader.h"
+#include "sparklinerenderer.h"
 #include "logger.h"
+#include "tracer.h"
+#include "metricsregistry.h"
+#include "memorygovernor.h"
 #include <QDirIterator>
 #include <QStandardItem>
 #include <QFileInfo>
@@ -12,6 +16,9 @@
 #include <QSet>
 #include <QHash>
 #include <QMutexLocker>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
+#include <algorithm>
 
 // Role names for QML access
 enum {
@@ -26,7 +33,14 @@ enum {
     StatusRole,
     ThumbnailPathRole,
     TestKeyRole,
-    RenderVersionsRole
+    RenderVersionsRole,
+    P5ValueRole,
+    MedianValueRole,
+    FramesUnderRole,
+    LongestBadRunRole,
+    WorstVersionDeltaRole,
+    RegressedFramesRole,
+    SparklinePathRole
 };
 
 /**
@@ -39,6 +53,15 @@ XmlDataModel::XmlDataModel(QObject *parent)
     : QStandardItemModel(parent)
     , m_loaderThread(nullptr)
     , m_loader(nullptr)
+    , m_statsWatcher(nullptr)
+    , m_statsGeneration(0)
+    , m_runningGeneration(-1)
+    , m_statsThreshold(1.0)
+    , m_runningThreshold(1.0)
+    , m_parsedXmlCacheBytes(0)
+    , m_lastParsedRow(-1)
+    , m_memoryGovernor(nullptr)
+    , m_consumerId(0)
 {
     // Define table structure: 11 columns with headers (added testKey)
     setColumnCount(11);
@@ -74,6 +97,11 @@ XmlDataModel::XmlDataModel(QObject *parent)
 
     // Start the background thread (it will wait for loadData() to be called)
     m_loaderThread->start();
+    
+    // Statistics pass runs on the global thread pool once all rows are loaded
+    m_statsWatcher = new QFutureWatcher<QVector<StatsResult>>(this);
+    connect(m_statsWatcher, &QFutureWatcherBase::finished, this, &XmlDataModel::onStatsFinished);
+    connect(this, &XmlDataModel::loadingFinished, this, &XmlDataModel::onLoadingFinished);
 }
 
 /**
@@ -84,6 +112,7 @@ XmlDataModel::XmlDataModel(QObject *parent)
  */
 XmlDataModel::~XmlDataModel()
 {
+    setMemoryGovernor(nullptr);
     if (m_loaderThread) {
         // Signal thread to stop processing
         m_loaderThread->quit();
@@ -121,6 +150,13 @@ QHash<int, QByteArray> XmlDataModel::roleNames() const
     roles[ThumbnailPathRole] = "thumbnailPath";
     roles[TestKeyRole] = "testKey";
     roles[RenderVersionsRole] = "renderVersions";
+    roles[P5ValueRole] = "p5Value";
+    roles[MedianValueRole] = "medianValue";
+    roles[FramesUnderRole] = "framesUnder";
+    roles[LongestBadRunRole] = "longestBadRun";
+    roles[WorstVersionDeltaRole] = "worstVersionDelta";
+    roles[RegressedFramesRole] = "regressedFrames";
+    roles[SparklinePathRole] = "sparklinePath";
     return roles;
 }
 
@@ -159,6 +195,23 @@ QVariant XmlDataModel::data(const QModelIndex &index, int role) const
     } else if (role == RenderVersionsRole) {
         // Render versions is stored in column 11 (index 11)
         column = 11;
+    } else if (role == P5ValueRole) {
+        // Computed statistics columns 12-15 (filled by the statistics pass)
+        column = 12;
+    } else if (role == MedianValueRole) {
+        column = 13;
+    } else if (role == FramesUnderRole) {
+        column = 14;
+    } else if (role == LongestBadRunRole) {
+        column = 15;
+    } else if (role == WorstVersionDeltaRole) {
+        // Version comparison columns 16-17 (filled by the statistics pass)
+        column = 16;
+    } else if (role == RegressedFramesRole) {
+        column = 17;
+    } else if (role == SparklinePathRole) {
+        // Sparkline image path (column 18, filled by the statistics pass)
+        column = 18;
     } else if (role == Qt::DisplayRole) {
         // Default display role - return data from the column
         return QStandardItemModel::data(index, role);
@@ -319,18 +372,27 @@ double XmlDataModel::getColumnWidthRatio(int columnIndex) const
     // Proportional widths for columns - adjust these values to change column sizes
     // Values are ratios (0.0 to 1.0) that sum to 1.0 (fill all available width)
     // Column order: ID, Thumbnail, Event Name, Sport Type, Stadium Name, Category Name,
-    //               Number Of Frames, Min Value, Notes, Status
+    //               Number Of Frames, Min Value, Notes, Status,
+    //               P5 Value, Median Value, Frames Under, Longest Bad Run,
+    //               Worst Version Delta, Regressed Frames, Sparkline
     static const double widths[] = {
         0.030,  // ID (3.0%)
-        0.130,  // Thumbnail (13.0%)
-        0.151,  // Event Name (15.1%)
-        0.065,  // Sport Type (6.5%)
-        0.130,  // Stadium Name (13.0%)
-        0.130,  // Category Name (13.0%)
-        0.086,  // Number Of Frames (8.6%)
-        0.086,  // Min Value (8.6%)
-        0.126,  // Notes (12.6%)
-        0.065   // Status (6.5%)
+        0.090,  // Thumbnail (9.0%)
+        0.100,  // Event Name (10.0%)
+        0.050,  // Sport Type (5.0%)
+        0.080,  // Stadium Name (8.0%)
+        0.080,  // Category Name (8.0%)
+        0.050,  // Number Of Frames (5.0%)
+        0.050,  // Min Value (5.0%)
+        0.075,  // Notes (7.5%)
+        0.050,  // Status (5.0%)
+        0.040,  // P5 Value (4.0%)
+        0.040,  // Median Value (4.0%)
+        0.040,  // Frames Under (4.0%)
+        0.040,  // Longest Bad Run (4.0%)
+        0.045,  // Worst Version Delta (4.5%)
+        0.045,  // Regressed Frames (4.5%)
+        0.095   // Sparkline (9.5%)
     };
     const int maxColumns = sizeof(widths) / sizeof(widths[0]);
 
@@ -349,6 +411,7 @@ int XmlDataModel::rowCount(const QModelIndex &parent) const
 
 bool XmlDataModel::loadData(const QString &resultsPath, const QString &selectedVersion, const QString &testSetsPath)
 {
+    TRACE_SCOPE("XmlDataModel", "loadData");
     Q_UNUSED(selectedVersion);
     
     if (resultsPath.isEmpty()) {
@@ -363,7 +426,15 @@ bool XmlDataModel::loadData(const QString &resultsPath, const QString &selectedV
     clear();
     m_renderVersions.clear();
     clearXmlCache();  // Clear XML parsing cache when reloading
-    setColumnCount(12);  // 12 columns including testKey and renderVersions
+    
+    // Drop statistics of the previous data set; a pass still running is superseded
+    ++m_statsGeneration;
+    m_eventStats.clear();
+    m_statsValues.clear();
+    m_versionComparisons.clear();
+    m_sparklinePaths.clear();
+    
+    setColumnCount(19);  // 12 data columns + 4 statistics columns + 2 version comparison columns + sparkline
     setHorizontalHeaderLabels(QStringList()
         << "ID"
         << "Event Name"
@@ -376,7 +447,14 @@ bool XmlDataModel::loadData(const QString &resultsPath, const QString &selectedV
         << "Status"
         << "Thumbnail"
         << "Test Key"
-        << "Render Versions");
+        << "Render Versions"
+        << "P5 Value"
+        << "Median Value"
+        << "Frames Under"
+        << "Longest Bad Run"
+        << "Worst Version Delta"
+        << "Regressed Frames"
+        << "Sparkline");
 
     // Start loading in background thread
     if (m_loader) {
@@ -401,6 +479,7 @@ bool XmlDataModel::loadData(const QString &resultsPath, const QString &selectedV
  */
 void XmlDataModel::onRowLoaded(const QVariantList &rowData, const QString &xmlPath)
 {
+    TRACE_SCOPE("XmlDataModel", "onRowLoaded");
     Q_UNUSED(xmlPath);  // Not used anymore since we load from uiData.xml instead of individual XML files
     // Validate data size (should have 12 elements: id placeholder + 11 data columns including testKey and renderVersions)
     if (rowData.size() < 12) {
@@ -487,6 +566,7 @@ bool XmlDataModel::updateCell(int rowIndex, int columnIndex, const QString &newV
 
 bool XmlDataModel::saveToXml(const QString &resultsPath)
 {
+    TRACE_SCOPE("XmlDataModel", "saveToXml");
     if (resultsPath.isEmpty()) {
         ERROR_LOG("XmlDataModel::saveToXml - Results path is empty");
         return false;
@@ -716,25 +796,31 @@ void XmlDataModel::clearXmlCache() const
 {
     QMutexLocker locker(&m_cacheMutex);
     m_parsedXmlCache.clear();
+    m_parsedXmlAccessOrder.clear();
+    m_parsedXmlCacheBytes = 0;
     DEBUG_LOG("XmlDataModel") << "clearXmlCache - Cleared XML parsing cache";
 }
 
 bool XmlDataModel::getParsedXmlData(int rowIndex, ParsedXmlData &parsedData) const
 {
+    TRACE_SCOPE_VALUE("XmlDataModel", "getParsedXmlData", rowIndex);
     // Thread safety: Protect cache access with mutex
     // Cache can be accessed from main thread (QML getters) while background thread loads data
     QMutexLocker locker(&m_cacheMutex);
+    m_lastParsedRow = rowIndex;
     
     // Check cache first
     if (m_parsedXmlCache.contains(rowIndex)) {
         parsedData = m_parsedXmlCache[rowIndex];
         // Verify the cached XML path still exists
+        m_parsedXmlAccessOrder.removeOne(rowIndex);
         if (!parsedData.xmlPath.isEmpty() && QFile::exists(parsedData.xmlPath)) {
+            m_parsedXmlAccessOrder.append(rowIndex);
             DEBUG_LOG("XmlDataModel") << "getParsedXmlData - Cache hit for rowIndex:" << rowIndex;
             return true;
         } else {
             // Cache entry is stale, remove it
-            m_parsedXmlCache.remove(rowIndex);
+            m_parsedXmlCacheBytes -= m_parsedXmlCache.take(rowIndex).bytes;
             DEBUG_LOG("XmlDataModel") << "getParsedXmlData - Cache entry stale, removed for rowIndex:" << rowIndex;
         }
     }
@@ -772,17 +858,81 @@ bool XmlDataModel::getParsedXmlData(int rowIndex, ParsedXmlData &parsedData) con
     parsedData.maxVal = maxVal;
     parsedData.frameList_frame = frameList_frame;
     parsedData.frameList_val = frameList_val;
+    parsedData.framePoints.clear();
+    parsedData.framePoints.reserve(frameList_frame.size());
+    for (int i = 0; i < frameList_frame.size() && i < frameList_val.size(); ++i) {
+        parsedData.framePoints.append(QPointF(frameList_frame[i].toInt(), frameList_val[i].toDouble()));
+    }
     parsedData.outputPathList = outputPathList;
     parsedData.origFreeDViewName = origFreeDViewName;
     parsedData.testFreeDViewName = testFreeDViewName;
     parsedData.xmlPath = xmlPath;
+    parsedData.bytes = estimateBytes(parsedData);
     
+    // Another thread may have parsed the same row meanwhile
+    m_parsedXmlCacheBytes += parsedData.bytes - m_parsedXmlCache.value(rowIndex).bytes;
     m_parsedXmlCache[rowIndex] = parsedData;
+    m_parsedXmlAccessOrder.removeOne(rowIndex);
+    m_parsedXmlAccessOrder.append(rowIndex);
     DEBUG_LOG("XmlDataModel") << "getParsedXmlData - Parsed and cached for rowIndex:" << rowIndex;
+    locker.unlock();
     
+    if (m_memoryGovernor) {
+        m_memoryGovernor->requestCheck();
+    }
     return true;
 }
 
+qint64 XmlDataModel::estimateBytes(const ParsedXmlData &data)
+{
+    // QList<QVariant> stores a pointer per element plus the heap-allocated QVariant
+    const qint64 variantBytes = sizeof(void *) + sizeof(QVariant);
+    qint64 bytes = (data.frameList_frame.size() + data.frameList_val.size()) * variantBytes;
+    bytes += data.framePoints.capacity() * static_cast<qint64>(sizeof(QPointF));
+    for (const QString &path : data.outputPathList) {
+        bytes += sizeof(void *) + path.size() * static_cast<qint64>(sizeof(QChar));
+    }
+    bytes += (data.origFreeDViewName.size() + data.testFreeDViewName.size() + data.xmlPath.size()) * static_cast<qint64>(sizeof(QChar));
+    return bytes;
+}
+
+void XmlDataModel::setMemoryGovernor(MemoryGovernor *governor)
+{
+    if (m_memoryGovernor) {
+        m_memoryGovernor->removeConsumer(m_consumerId);
+    }
+    m_memoryGovernor = governor;
+    if (governor) {
+        // Re-parsing one compareResult.xml is cheap, but not free like a tile
+        m_consumerId = governor->addConsumer(QStringLiteral("parsedXml"), 2,
+                                             [this]() { return parsedXmlCacheBytes(); },
+                                             [this](qint64 bytes) { return releaseXmlCache(bytes); });
+    }
+}
+
+qint64 XmlDataModel::parsedXmlCacheBytes() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_parsedXmlCacheBytes;
+}
+
+qint64 XmlDataModel::releaseXmlCache(qint64 bytes)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    const qint64 before = m_parsedXmlCacheBytes;
+    // Least recently used first; the row on screen stays
+    for (auto it = m_parsedXmlAccessOrder.begin();
+         it != m_parsedXmlAccessOrder.end() && before - m_parsedXmlCacheBytes < bytes;) {
+        if (*it == m_lastParsedRow) {
+            ++it;
+            continue;
+        }
+        m_parsedXmlCacheBytes -= m_parsedXmlCache.take(*it).bytes;
+        it = m_parsedXmlAccessOrder.erase(it);
+    }
+    return before - m_parsedXmlCacheBytes;
+}
+
 QString XmlDataModel::findCompareResultXml(int rowIndex) const
 {
     if (rowIndex < 0 || rowIndex >= rowCount() || m_resultsPath.isEmpty()) {
@@ -799,51 +949,91 @@ QString XmlDataModel::findCompareResultXml(int rowIndex) const
     QString testKey = getTestKey(rowIndex);
     DEBUG_LOG("XmlDataModel") << "findCompareResultXml - testKey:" << testKey;
     
+    // Search recursively for compareResult.xml files
+    // This is more expensive but more reliable
+    return pickCompareResultXml(m_resultsPath, eventName, testKey, scanCompareResultXmls(m_resultsPath));
+}
+
+QStringList XmlDataModel::scanCompareResultXmls(const QString &resultsPath)
+{
+    TRACE_SCOPE("XmlDataModel", "scanCompareResultXmls");
+    QStringList files;
+    if (resultsPath.isEmpty()) {
+        return files;
+    }
+    QDirIterator it(resultsPath, QStringList() << "compareResult.xml", 
+                    QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(it.next());
+    }
+    return files;
+}
+
+QString XmlDataModel::pickCompareResultXml(const QString &resultsPath, const QString &eventName,
+                                           const QString &testKey, const QStringList &candidates)
+{
+    TRACE_SCOPE("XmlDataModel", "pickCompareResultXml");
     // Try multiple strategies to find compareResult.xml:
     // 1. Use eventName as eventSet folder name
     // 2. Use first part of testKey
-    // 3. Search recursively from testKey path
+    // 3. Match the recursively found files (candidates) against testKey / eventName,
+    //    most specific match first
     
     QStringList searchPaths;
+    const QStringList testKeyParts = testKey.split("/", QString::SkipEmptyParts);
     
     // Strategy 1: Use eventName directly
     if (!eventName.isEmpty()) {
-        QDir resultsDir(m_resultsPath);
+        QDir resultsDir(resultsPath);
         QString path1 = resultsDir.absoluteFilePath(eventName + "/results/compareResult.xml");
         searchPaths.append(QDir::toNativeSeparators(path1));
     }
     
     // Strategy 2: Use testKey parts
-    if (!testKey.isEmpty()) {
-        QStringList parts = testKey.split("/", QString::SkipEmptyParts);
-        if (!parts.isEmpty()) {
-            // Try first part as eventSet
-            QDir resultsDir(m_resultsPath);
-            QString path2 = resultsDir.absoluteFilePath(parts[0] + "/results/compareResult.xml");
-            searchPaths.append(QDir::toNativeSeparators(path2));
-            
-            // Try building path from testKey: testKey/results/compareResult.xml
-            QString path3 = resultsDir.absoluteFilePath(testKey + "/results/compareResult.xml");
-            searchPaths.append(QDir::toNativeSeparators(path3));
+    if (!testKeyParts.isEmpty()) {
+        // Try first part as eventSet
+        QDir resultsDir(resultsPath);
+        QString path2 = resultsDir.absoluteFilePath(testKeyParts[0] + "/results/compareResult.xml");
+        searchPaths.append(QDir::toNativeSeparators(path2));
+        
+        // Try building path from testKey: testKey/results/compareResult.xml
+        QString path3 = resultsDir.absoluteFilePath(testKey + "/results/compareResult.xml");
+        searchPaths.append(QDir::toNativeSeparators(path3));
+    }
+    
+    // Strategy 3: Recursively found files
+    // Sport and stadium folders (and an event's sets) are shared by many entries, so a
+    // file that merely contains one test key part may belong to a sibling entry. Files
+    // below the entry's own test key folder (<Sport>/<Stadium>/<Event>/<Set>/F####)
+    // come first, then files below its event folder, then the loose matches.
+    const QString testKeyFolder = "/" + QDir::fromNativeSeparators(testKey) + "/";
+    QString eventFolder;
+    if (!eventName.isEmpty()) {
+        int eventPart = -1;
+        for (int i = 0; i < testKeyParts.size() && eventPart < 0; ++i) {
+            if (testKeyParts.at(i).compare(eventName, Qt::CaseInsensitive) == 0) {
+                eventPart = i;
+            }
         }
+        eventFolder = "/" + (eventPart >= 0 ? testKeyParts.mid(0, eventPart + 1).join("/") : eventName) + "/";
     }
-    
-    // Strategy 3: Search recursively for compareResult.xml files
-    // This is more expensive but more reliable
-    QDirIterator it(m_resultsPath, QStringList() << "compareResult.xml", 
-                    QDir::Files, QDirIterator::Subdirectories);
+    QStringList testKeyFiles;
+    QStringList eventFiles;
     QStringList foundFiles;
-    while (it.hasNext()) {
-        QString foundPath = it.next();
+    for (const QString &foundPath : candidates) {
+        const QString path = QDir::fromNativeSeparators(foundPath);
         QFileInfo fileInfo(foundPath);
         QString dirName = fileInfo.dir().dirName();
         
-        // Check if the directory name matches eventName or testKey parts
-        if (!eventName.isEmpty() && dirName.contains(eventName, Qt::CaseInsensitive)) {
+        // Check if the path is below the test key or event folder, or matches eventName or testKey parts
+        if (!testKeyParts.isEmpty() && path.contains(testKeyFolder, Qt::CaseInsensitive)) {
+            testKeyFiles.append(foundPath);
+        } else if (!eventFolder.isEmpty() && path.contains(eventFolder, Qt::CaseInsensitive)) {
+            eventFiles.append(foundPath);
+        } else if (!eventName.isEmpty() && dirName.contains(eventName, Qt::CaseInsensitive)) {
             foundFiles.append(foundPath);
-        } else if (!testKey.isEmpty()) {
-            QStringList parts = testKey.split("/", QString::SkipEmptyParts);
-            for (const QString &part : parts) {
+        } else if (!testKeyParts.isEmpty()) {
+            for (const QString &part : testKeyParts) {
                 if (foundPath.contains(part, Qt::CaseInsensitive)) {
                     foundFiles.append(foundPath);
                     break;
@@ -853,28 +1043,82 @@ QString XmlDataModel::findCompareResultXml(int rowIndex) const
     }
     
     // Add found files to search paths (prioritize them)
-    searchPaths = foundFiles + searchPaths;
+    searchPaths = testKeyFiles + eventFiles + foundFiles + searchPaths;
     
     // Try each path
     for (const QString &compareResultPath : searchPaths) {
-        DEBUG_LOG("XmlDataModel") << "findCompareResultXml - Trying:" << compareResultPath;
+        DEBUG_LOG("XmlDataModel") << "pickCompareResultXml - Trying:" << compareResultPath;
         QFileInfo fileInfo(compareResultPath);
         if (fileInfo.exists() && fileInfo.isFile()) {
-            DEBUG_LOG("XmlDataModel") << "findCompareResultXml - Found file:" << compareResultPath;
+            DEBUG_LOG("XmlDataModel") << "pickCompareResultXml - Found file:" << compareResultPath;
             return compareResultPath;
         }
     }
     
-    DEBUG_LOG("XmlDataModel") << "findCompareResultXml - File not found after trying" << searchPaths.size() << "paths";
+    DEBUG_LOG("XmlDataModel") << "pickCompareResultXml - File not found after trying" << searchPaths.size() << "paths";
     return QString();
 }
 
+bool XmlDataModel::readFrameValues(const QString &xmlPath, QVector<QPointF> &points)
+{
+    TRACE_SCOPE("XmlDataModel", "readFrameValues");
+    ScopedLatency latency(MetricsRegistry::XmlParseLatency);
+    points.clear();
+    
+    QFile file(xmlPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        ERROR_LOG("XmlDataModel::readFrameValues - Failed to open file:" + xmlPath);
+        return false;
+    }
+    
+    // XML structure: <frames><frame><frameIndex>...</frameIndex><value>...</value></frame></frames>
+    QXmlStreamReader reader(&file);
+    bool inFrame = false;
+    bool hasIndex = false;
+    bool hasValue = false;
+    int frameIndex = 0;
+    double value = 0.0;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            const QStringRef name = reader.name();
+            if (name == QLatin1String("frame")) {
+                inFrame = true;
+                hasIndex = false;
+                hasValue = false;
+            } else if (inFrame && name == QLatin1String("frameIndex")) {
+                frameIndex = reader.readElementText().toInt();
+                hasIndex = true;
+            } else if (inFrame && name == QLatin1String("value")) {
+                value = reader.readElementText().toDouble();
+                hasValue = true;
+            }
+        } else if (reader.isEndElement() && reader.name() == QLatin1String("frame")) {
+            if (hasIndex && hasValue) {
+                points.append(QPointF(frameIndex, value));
+            }
+            inFrame = false;
+        }
+    }
+    
+    if (reader.hasError()) {
+        ERROR_LOG(QString("XmlDataModel::readFrameValues - Failed to parse XML: %1 Error: %2").arg(xmlPath).arg(reader.errorString()));
+        return false;
+    }
+    
+    std::sort(points.begin(), points.end(),
+              [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); });
+    return true;
+}
+
 bool XmlDataModel::parseCompareResultXml(const QString &xmlPath, int &startFrame, int &endFrame,
                                          double &minVal, double &maxVal,
                                          QVariantList &frameList_frame, QVariantList &frameList_val,
                                          QStringList &outputPathList,
                                          QString &origFreeDViewName, QString &testFreeDViewName) const
 {
+    TRACE_SCOPE("XmlDataModel", "parseCompareResultXml");
+    ScopedLatency latency(MetricsRegistry::XmlParseLatency);
     // Initialize output parameters
     startFrame = -1;
     endFrame = -1;
@@ -1122,6 +1366,25 @@ QVariantList XmlDataModel::getFrameList_val(int rowIndex) const
     return QVariantList();
 }
 
+bool XmlDataModel::getFramePoints(int rowIndex, QVector<QPointF> &points) const
+{
+    points.clear();
+    
+    // Validate rowIndex bounds
+    if (rowIndex < 0 || rowIndex >= rowCount()) {
+        DEBUG_LOG("XmlDataModel") << "getFramePoints - Invalid rowIndex:" << rowIndex << "rowCount:" << rowCount();
+        return false;
+    }
+    
+    ParsedXmlData parsedData;
+    if (getParsedXmlData(rowIndex, parsedData)) {
+        points = parsedData.framePoints;
+        return true;
+    }
+    
+    return false;
+}
+
 QStringList XmlDataModel::getOutputPathList(int rowIndex) const
 {
     // Validate rowIndex bounds
@@ -1193,3 +1456,358 @@ QString XmlDataModel::getTestFreeDViewName(int rowIndex) const
     DEBUG_LOG("XmlDataModel") << "getTestFreeDViewName - Could not parse renderVersions:" << renderVersions;
     return QString();
 }
+
+// Statistics pass
+
+/**
+ * @brief Per-row work of the statistics pass
+ * 
+ * Runs on the global thread pool through QtConcurrent::blockingMapped, so it must
+ * not touch the model: everything it needs is copied into the StatsJob.
+ */
+struct XmlDataModel::StatsWorker
+{
+    typedef StatsResult result_type;
+    
+    StatsWorker(const QString &resultsPath, const QStringList &candidates, double threshold)
+        : m_resultsPath(resultsPath)
+        , m_candidates(candidates)
+        , m_threshold(threshold)
+    {
+    }
+    
+    StatsResult operator()(const StatsJob &job) const
+    {
+        TRACE_SCOPE_VALUE("XmlDataModel", "statsJob", job.row);
+        StatsResult result;
+        result.row = job.row;
+        
+        const QString xmlPath = pickCompareResultXml(m_resultsPath, job.eventName, job.testKey, m_candidates);
+        if (xmlPath.isEmpty()) {
+            return result;
+        }
+        
+        QVector<QPointF> points;
+        if (!readFrameValues(xmlPath, points)) {
+            return result;
+        }
+        
+        result.values.reserve(points.size());
+        for (const QPointF &point : points) {
+            result.values.append(static_cast<float>(point.y()));
+        }
+        result.stats = EventStats::compute(result.values, m_threshold);
+        result.sparklinePath = SparklineRenderer::imageSource(SparklineRenderer::ensureCached(xmlPath, result.values));
+        
+        // Latest render version against the previous one
+        if (job.versions.size() >= 2) {
+            const QString baseVersion = job.versions.at(job.versions.size() - 2);
+            const QString testVersion = job.versions.last();
+            const QString baseXml = compareResultXmlForVersion(m_resultsPath, job.testKey, baseVersion);
+            const QString testXml = compareResultXmlForVersion(m_resultsPath, job.testKey, testVersion);
+            QVector<QPointF> basePoints;
+            QVector<QPointF> testPoints;
+            if (!baseXml.isEmpty() && !testXml.isEmpty()
+                && readFrameValues(baseXml, basePoints) && readFrameValues(testXml, testPoints)) {
+                result.versionDiff = VersionComparator::compare(basePoints, testPoints);
+                // Only the summary goes back to the main thread
+                result.versionDiff.frames.clear();
+                result.versionDiff.deltas.clear();
+                result.baseVersion = baseVersion;
+                result.testVersion = testVersion;
+            }
+        }
+        return result;
+    }
+    
+    QString m_resultsPath;
+    QStringList m_candidates;
+    double m_threshold;
+};
+
+void XmlDataModel::onLoadingFinished(bool success, int count)
+{
+    if (success && count > 0) {
+        computeEventStats();
+    }
+}
+
+void XmlDataModel::computeEventStats()
+{
+    TRACE_SCOPE("XmlDataModel", "computeEventStats");
+    if (m_resultsPath.isEmpty() || rowCount() == 0) {
+        DEBUG_LOG("XmlDataModel") << "computeEventStats - Nothing to do. rowCount:" << rowCount() << "resultsPath:" << m_resultsPath;
+        return;
+    }
+    
+    // Snapshot what the workers need - the model itself is main-thread only
+    QVector<StatsJob> jobs;
+    jobs.reserve(rowCount());
+    for (int row = 0; row < rowCount(); ++row) {
+        StatsJob job;
+        job.row = row;
+        job.eventName = data(index(row, 1), Qt::DisplayRole).toString();
+        job.testKey = getTestKey(row);
+        job.versions = getRowRenderVersions(row);
+        jobs.append(job);
+    }
+    
+    m_runningGeneration = ++m_statsGeneration;
+    m_runningThreshold = m_statsThreshold;
+    const QString resultsPath = m_resultsPath;
+    const double threshold = m_statsThreshold;
+    
+    QFuture<QVector<StatsResult>> future = QtConcurrent::run([resultsPath, jobs, threshold]() {
+        // One directory scan shared by all events (findCompareResultXml() scans per call),
+        // then one task per event across the pool
+        const QStringList candidates = scanCompareResultXmls(resultsPath);
+        return QtConcurrent::blockingMapped<QVector<StatsResult>>(jobs, StatsWorker(resultsPath, candidates, threshold));
+    });
+    m_statsWatcher->setFuture(future);
+    
+    DEBUG_LOG("XmlDataModel") << "computeEventStats - Started statistics pass for" << jobs.size() << "events";
+    emit statsRunningChanged();
+}
+
+void XmlDataModel::onStatsFinished()
+{
+    TRACE_SCOPE("XmlDataModel", "onStatsFinished");
+    emit statsRunningChanged();
+    
+    // Data was reloaded (or a newer pass started) while this pass was running
+    if (m_runningGeneration != m_statsGeneration) {
+        DEBUG_LOG("XmlDataModel") << "onStatsFinished - Dropping results of a superseded pass";
+        return;
+    }
+    m_runningGeneration = -1;
+    
+    const QVector<StatsResult> results = m_statsWatcher->result();
+    m_eventStats.clear();
+    m_statsValues.clear();
+    m_versionComparisons.clear();
+    m_sparklinePaths.clear();
+    for (const StatsResult &result : results) {
+        if (result.row >= rowCount()) {
+            continue;
+        }
+        if (result.stats.isValid()) {
+            m_eventStats.insert(result.row, result.stats);
+            m_statsValues.insert(result.row, result.values);
+        }
+        if (!result.sparklinePath.isEmpty()) {
+            m_sparklinePaths.insert(result.row, result.sparklinePath);
+        }
+        if (result.versionDiff.isValid()) {
+            VersionComparison comparison;
+            comparison.baseVersion = result.baseVersion;
+            comparison.testVersion = result.testVersion;
+            comparison.diff = result.versionDiff;
+            m_versionComparisons.insert(result.row, comparison);
+        }
+    }
+    
+    // Threshold changed while the pass was running
+    if (m_runningThreshold != m_statsThreshold) {
+        applyStatsThreshold();
+    }
+    
+    writeStatsToModel();
+    DEBUG_LOG("XmlDataModel") << "onStatsFinished - Statistics ready for" << m_eventStats.size() << "of" << results.size() << "events";
+    emit eventStatsReady(m_eventStats.size());
+}
+
+bool XmlDataModel::statsRunning() const
+{
+    return m_statsWatcher && m_statsWatcher->isRunning();
+}
+
+void XmlDataModel::setStatsThreshold(double threshold)
+{
+    if (m_statsThreshold == threshold) {
+        return;
+    }
+    m_statsThreshold = threshold;
+    emit statsThresholdChanged();
+    
+    // A running pass re-applies the new threshold when it finishes
+    if (!m_eventStats.isEmpty()) {
+        applyStatsThreshold();
+        writeStatsToModel();
+    }
+}
+
+void XmlDataModel::applyStatsThreshold()
+{
+    // Pair each row's statistics with its values; each task writes only its own entry
+    struct ThresholdTask {
+        EventStats *stats;
+        const QVector<float> *values;
+    };
+    QVector<ThresholdTask> tasks;
+    tasks.reserve(m_eventStats.size());
+    for (auto it = m_eventStats.begin(); it != m_eventStats.end(); ++it) {
+        auto valuesIt = m_statsValues.constFind(it.key());
+        if (valuesIt != m_statsValues.constEnd()) {
+            ThresholdTask task;
+            task.stats = &it.value();
+            task.values = &valuesIt.value();
+            tasks.append(task);
+        }
+    }
+    
+    const double threshold = m_statsThreshold;
+    QtConcurrent::blockingMap(tasks, [threshold](ThresholdTask &task) {
+        EventStats::applyThreshold(*task.stats, *task.values, threshold);
+    });
+}
+
+void XmlDataModel::writeStatsToModel()
+{
+    TRACE_SCOPE("XmlDataModel", "writeStatsToModel");
+    if (rowCount() == 0 || columnCount() < 19) {
+        return;
+    }
+    
+    // Block per-cell signals: the sort proxy would otherwise re-sort once per cell
+    const bool wasBlocked = blockSignals(true);
+    for (auto it = m_eventStats.constBegin(); it != m_eventStats.constEnd(); ++it) {
+        const int row = it.key();
+        if (row < 0 || row >= rowCount()) {
+            continue;
+        }
+        // Numeric values (not strings) so the columns sort numerically
+        const EventStats &stats = it.value();
+        setData(index(row, 12), stats.p5Value);
+        setData(index(row, 13), stats.medianValue);
+        setData(index(row, 14), stats.framesUnderThreshold);
+        setData(index(row, 15), stats.longestBadRun);
+    }
+    for (auto it = m_versionComparisons.constBegin(); it != m_versionComparisons.constEnd(); ++it) {
+        const int row = it.key();
+        if (row < 0 || row >= rowCount()) {
+            continue;
+        }
+        setData(index(row, 16), it.value().diff.worstDelta);
+        setData(index(row, 17), it.value().diff.worsenedFrames);
+    }
+    for (auto it = m_sparklinePaths.constBegin(); it != m_sparklinePaths.constEnd(); ++it) {
+        const int row = it.key();
+        if (row < 0 || row >= rowCount()) {
+            continue;
+        }
+        setData(index(row, 18), it.value());
+    }
+    blockSignals(wasBlocked);
+    
+    // Role-based sorting reads through column 0, so the range must include it
+    emit QStandardItemModel::dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    emit dataChanged();
+}
+
+QVariantMap XmlDataModel::getEventStats(int rowIndex) const
+{
+    // Validate rowIndex bounds
+    if (rowIndex < 0 || rowIndex >= rowCount()) {
+        DEBUG_LOG("XmlDataModel") << "getEventStats - Invalid rowIndex:" << rowIndex << "rowCount:" << rowCount();
+        return QVariantMap();
+    }
+    
+    auto it = m_eventStats.constFind(rowIndex);
+    if (it == m_eventStats.constEnd()) {
+        return QVariantMap();
+    }
+    
+    const EventStats &stats = it.value();
+    QVariantList histogram;
+    for (int count : stats.histogram) {
+        histogram.append(count);
+    }
+    
+    QVariantMap result;
+    result["frameCount"] = stats.frameCount;
+    result["p5Value"] = stats.p5Value;
+    result["medianValue"] = stats.medianValue;
+    result["p95Value"] = stats.p95Value;
+    result["framesUnder"] = stats.framesUnderThreshold;
+    result["longestBadRun"] = stats.longestBadRun;
+    result["histogram"] = histogram;
+    return result;
+}
+
+// Version-to-version comparison
+
+QStringList XmlDataModel::getRowRenderVersions(int rowIndex) const
+{
+    // Validate rowIndex bounds
+    if (rowIndex < 0 || rowIndex >= rowCount()) {
+        DEBUG_LOG("XmlDataModel") << "getRowRenderVersions - Invalid rowIndex:" << rowIndex << "rowCount:" << rowCount();
+        return QStringList();
+    }
+    
+    // renderVersions is a comma-separated list (column 11)
+    const QString renderVersions = data(index(rowIndex, 11), Qt::DisplayRole).toString();
+    QStringList versions;
+    for (const QString &version : renderVersions.split(',', QString::SkipEmptyParts)) {
+        versions.append(version.trimmed());
+    }
+    
+    // Order by position in uiData.xml's renderVersions section (appended as new versions are tested);
+    // versions missing from that list keep their relative order at the end
+    if (!m_renderVersions.isEmpty()) {
+        std::stable_sort(versions.begin(), versions.end(), [this](const QString &a, const QString &b) {
+            int indexA = m_renderVersions.indexOf(a);
+            int indexB = m_renderVersions.indexOf(b);
+            if (indexA < 0) indexA = m_renderVersions.size();
+            if (indexB < 0) indexB = m_renderVersions.size();
+            return indexA < indexB;
+        });
+    }
+    return versions;
+}
+
+QString XmlDataModel::getCompareResultXmlForVersion(int rowIndex, const QString &version) const
+{
+    // Validate rowIndex bounds
+    if (rowIndex < 0 || rowIndex >= rowCount()) {
+        DEBUG_LOG("XmlDataModel") << "getCompareResultXmlForVersion - Invalid rowIndex:" << rowIndex << "rowCount:" << rowCount();
+        return QString();
+    }
+    return compareResultXmlForVersion(m_resultsPath, getTestKey(rowIndex), version);
+}
+
+QString XmlDataModel::compareResultXmlForVersion(const QString &resultsPath, const QString &testKey,
+                                                 const QString &version)
+{
+    if (resultsPath.isEmpty() || testKey.isEmpty() || version.isEmpty()) {
+        return QString();
+    }
+    QDir resultsDir(resultsPath);
+    const QString path = QDir::toNativeSeparators(
+        resultsDir.absoluteFilePath(testKey + "/" + version + "/results/compareResult.xml"));
+    return QFileInfo(path).isFile() ? path : QString();
+}
+
+QVariantMap XmlDataModel::getVersionComparison(int rowIndex) const
+{
+    // Validate rowIndex bounds
+    if (rowIndex < 0 || rowIndex >= rowCount()) {
+        DEBUG_LOG("XmlDataModel") << "getVersionComparison - Invalid rowIndex:" << rowIndex << "rowCount:" << rowCount();
+        return QVariantMap();
+    }
+    
+    auto it = m_versionComparisons.constFind(rowIndex);
+    if (it == m_versionComparisons.constEnd()) {
+        return QVariantMap();
+    }
+    
+    const VersionComparison &comparison = it.value();
+    QVariantMap result;
+    result["baseVersion"] = comparison.baseVersion;
+    result["testVersion"] = comparison.testVersion;
+    result["commonFrames"] = comparison.diff.commonFrames;
+    result["regressedFrames"] = comparison.diff.worsenedFrames;
+    result["meanDelta"] = comparison.diff.meanDelta;
+    result["worstDelta"] = comparison.diff.worstDelta;
+    result["worstFrame"] = comparison.diff.worstFrame;
+    return result;
+}
@@ -7,20 +7,39 @@
 #include <QVariant>
 #include <QThread>
 #include <QMutex>
+#include <QVector>
+#include <QPointF>
+#include <QHash>
+#include <QVariantMap>
+#include <QFutureWatcher>
+#include "eventstats.h"
+#include "versioncomparator.h"
 
 // Forward declaration
 class XmlDataLoader;
+class MemoryGovernor;
 
 /**
  * @brief XmlDataModel - A QStandardItemModel that loads data from compareResult.xml files
  * 
  * This model reads XML files from the path specified in the INI file and populates
  * a table with the data. Loading is performed in a background thread to prevent UI freezing.
+ * 
+ * After loading finishes, a background statistics pass reads every event's
+ * compareResult.xml in parallel and fills the computed columns 12-15
+ * (P5 Value, Median Value, Frames Under, Longest Bad Run), so the worst
+ * events can be sorted to the top without opening them. For events rendered
+ * with two or more FreeDView versions, the same pass compares the latest
+ * version against the previous one (columns 16-17: Worst Version Delta,
+ * Regressed Frames), and renders a sparkline of each event's values in the
+ * background (column 18, see SparklineRenderer).
  */
 class XmlDataModel : public QStandardItemModel
 {
     Q_OBJECT
     Q_PROPERTY(int rowCount READ rowCount NOTIFY dataChanged)
+    Q_PROPERTY(bool statsRunning READ statsRunning NOTIFY statsRunningChanged)
+    Q_PROPERTY(double statsThreshold READ statsThreshold WRITE setStatsThreshold NOTIFY statsThresholdChanged)
 
 public:
     explicit XmlDataModel(QObject *parent = nullptr);
@@ -166,14 +185,190 @@ public:
      * @return Test FreeDView name, or empty string if not found
      */
     Q_INVOKABLE QString getTestFreeDViewName(int rowIndex) const;
+    
+    /**
+     * @brief Get the parsed (frame, value) points for a specific row
+     * @param rowIndex - The row index in the model
+     * @param points - Output parameter for the points (x = frame number, y = value)
+     * @return true if the compareResult.xml data was available
+     * 
+     * C++ counterpart of getFrameList_frame()/getFrameList_val() for consumers that
+     * feed chart series directly (no QVariantList round-trip through QML).
+     */
+    bool getFramePoints(int rowIndex, QVector<QPointF> &points) const;
+    
+    /**
+     * @brief Start the background statistics pass over all events
+     * 
+     * Runs automatically when loading finishes. Any pass still running is
+     * superseded (its results are dropped).
+     */
+    Q_INVOKABLE void computeEventStats();
+    
+    /**
+     * @brief Get the computed statistics for a specific row
+     * @param rowIndex - The row index in the model
+     * @return Map with frameCount, p5Value, medianValue, p95Value, framesUnder,
+     *         longestBadRun and histogram (list of counts over [0, 1]),
+     *         or empty map if statistics are not available yet
+     */
+    Q_INVOKABLE QVariantMap getEventStats(int rowIndex) const;
+    
+    bool statsRunning() const;
+    double statsThreshold() const { return m_statsThreshold; }
+    
+    /**
+     * @brief Set the threshold for the Frames Under / Longest Bad Run columns
+     * @param threshold - Frames with value <= threshold count as bad
+     * 
+     * Recomputes the threshold-dependent columns from the values kept by the
+     * last statistics pass (no XML is re-read).
+     */
+    void setStatsThreshold(double threshold);
+    
+    /**
+     * @brief Report the parsed compareResult.xml cache to a memory governor
+     * @param governor - Governor (not owned), or nullptr to unregister
+     */
+    void setMemoryGovernor(MemoryGovernor *governor);
+    
+    /**
+     * @brief Estimated memory of the parsed compareResult.xml cache in bytes
+     */
+    qint64 parsedXmlCacheBytes() const;
+    
+    /**
+     * @brief List every compareResult.xml below the results directory (one recursive scan)
+     * @param resultsPath - Path to the testSets_results directory
+     * @return Absolute file paths
+     */
+    static QStringList scanCompareResultXmls(const QString &resultsPath);
+    
+    /**
+     * @brief Pick the compareResult.xml of an event from a list of candidates
+     * @param resultsPath - Path to the testSets_results directory
+     * @param eventName - Event name (model column 1)
+     * @param testKey - Test key (see getTestKey())
+     * @param candidates - Result of scanCompareResultXmls()
+     * @return Path to compareResult.xml, or empty string if not found
+     * 
+     * Same lookup strategies as findCompareResultXml(), without touching the
+     * model, so it can run on worker threads.
+     */
+    static QString pickCompareResultXml(const QString &resultsPath, const QString &eventName,
+                                        const QString &testKey, const QStringList &candidates);
+    
+    /**
+     * @brief Read only the per-frame (frameIndex, value) pairs from compareResult.xml
+     * @param xmlPath - Path to compareResult.xml file
+     * @param points - Output parameter for the points (x = frame number, y = value), sorted by frame
+     * @return true if the file could be read
+     * 
+     * Streaming reader used by the statistics pass; much cheaper than the full
+     * DOM parse of parseCompareResultXml() and safe to call from any thread.
+     */
+    static bool readFrameValues(const QString &xmlPath, QVector<QPointF> &points);
+    
+    /**
+     * @brief Get the render versions of a row, oldest first
+     * @param rowIndex - The row index in the model
+     * @return Version folder names from the row's renderVersions field, ordered as in
+     *         uiData.xml's renderVersions section (later = newer)
+     */
+    Q_INVOKABLE QStringList getRowRenderVersions(int rowIndex) const;
+    
+    /**
+     * @brief Get the compareResult.xml of a row for one render version
+     * @param rowIndex - The row index in the model
+     * @param version - Render version folder name
+     * @return Path to compareResult.xml, or empty string if it doesn't exist
+     */
+    Q_INVOKABLE QString getCompareResultXmlForVersion(int rowIndex, const QString &version) const;
+    
+    /**
+     * @brief Get the version-to-version comparison of a row
+     * @param rowIndex - The row index in the model
+     * @return Map with baseVersion, testVersion, commonFrames, regressedFrames,
+     *         meanDelta, worstDelta and worstFrame, or empty map if the row has
+     *         fewer than two comparable render versions
+     */
+    Q_INVOKABLE QVariantMap getVersionComparison(int rowIndex) const;
+    
+    /**
+     * @brief Build the compareResult.xml path of a test key for one render version
+     * @param resultsPath - Path to the testSets_results directory
+     * @param testKey - Test key (SportType/Stadium/Event/Set/F####)
+     * @param version - Render version folder name
+     * @return Path to compareResult.xml, or empty string if it doesn't exist
+     * 
+     * Layout: testSets_results/<testKey>/<version>/results/compareResult.xml
+     */
+    static QString compareResultXmlForVersion(const QString &resultsPath, const QString &testKey,
+                                              const QString &version);
 
 signals:
     void dataChanged();
     void loadingStarted();
     void loadingFinished(bool success, int count);
     void errorOccurred(const QString &message);
+    void statsRunningChanged();
+    void statsThresholdChanged();
+    void eventStatsReady(int count);
 
 private:
+    // Input and output of the statistics pass (one per row)
+    struct StatsJob {
+        int row;
+        QString eventName;
+        QString testKey;
+        QStringList versions;  // Render versions, oldest first
+    };
+    
+    struct StatsResult {
+        int row;
+        EventStats stats;
+        QVector<float> values;  // Kept so threshold changes don't re-read XML
+        VersionDiff versionDiff;  // Latest vs previous render version (summary only)
+        QString baseVersion;
+        QString testVersion;
+        QString sparklinePath;  // Cached sparkline PNG with its ?v=<mtime> (empty if it could not be written)
+        
+        StatsResult() : row(-1) {}
+    };
+    
+    // Version comparison summary kept per row for getVersionComparison()
+    struct VersionComparison {
+        QString baseVersion;
+        QString testVersion;
+        VersionDiff diff;
+    };
+    
+    // Per-row work of the statistics pass (defined in xmldatamodel.cpp)
+    struct StatsWorker;
+    
+    /**
+     * @brief Recompute the threshold-dependent statistics of all rows (in parallel)
+     */
+    void applyStatsThreshold();
+    
+    /**
+     * @brief Write the computed columns of all rows with statistics into the model
+     * 
+     * Signals are blocked while writing and a single dataChanged() is emitted for
+     * the whole block, so the sort proxy re-sorts once instead of once per cell.
+     */
+    void writeStatsToModel();
+    
+    // Statistics pass state (main thread only)
+    QFutureWatcher<QVector<StatsResult>> *m_statsWatcher;
+    int m_statsGeneration;       // Incremented per pass and per reload; stale results are dropped
+    int m_runningGeneration;     // Generation of the pass m_statsWatcher is running
+    double m_statsThreshold;
+    double m_runningThreshold;   // Threshold the running pass was started with
+    QHash<int, EventStats> m_eventStats;
+    QHash<int, QVector<float>> m_statsValues;
+    QHash<int, VersionComparison> m_versionComparisons;
+    QHash<int, QString> m_sparklinePaths;
     
     // Background loading thread and worker
     QThread *m_loaderThread;
@@ -193,16 +388,36 @@ private:
         double maxVal;
         QVariantList frameList_frame;
         QVariantList frameList_val;
+        QVector<QPointF> framePoints;  // Same data as frameList_frame/frameList_val, as chart-ready points
         QStringList outputPathList;
         QString origFreeDViewName;
         QString testFreeDViewName;
         QString xmlPath;  // Store the path to verify cache validity
+        qint64 bytes;     // Estimated memory of the above, for the memory governor
         
-        ParsedXmlData() : startFrame(-1), endFrame(-1), minVal(-1.0), maxVal(-1.0) {}
+        ParsedXmlData() : startFrame(-1), endFrame(-1), minVal(-1.0), maxVal(-1.0), bytes(0) {}
     };
     
     // Cache of parsed XML data, keyed by row index
     mutable QHash<int, ParsedXmlData> m_parsedXmlCache;
+    mutable qint64 m_parsedXmlCacheBytes;
+    // Cache access order for LRU eviction by the memory governor (most recent at end)
+    mutable QList<int> m_parsedXmlAccessOrder;
+    mutable int m_lastParsedRow;  // Kept when the memory governor trims the cache
+    MemoryGovernor *m_memoryGovernor;
+    int m_consumerId;
+
+    /**
+     * @brief Estimated heap memory of a parsed entry (lists, points and strings)
+     */
+    static qint64 estimateBytes(const ParsedXmlData &data);
+
+    /**
+     * @brief Drop parsed entries other than the current row (MemoryGovernor release callback)
+     * @param bytes - Bytes to free
+     * @return Bytes freed
+     */
+    qint64 releaseXmlCache(qint64 bytes);
     
     // Mutex for thread-safe cache access
     // Cache can be accessed from main thread (QML getters) while background thread loads data
@@ -261,6 +476,16 @@ private slots:
      * @param versionList - List of render version folder names
      */
     void onRenderVersionsLoaded(const QStringList &versionList);
+    
+    /**
+     * @brief Slot called when loading finishes - starts the statistics pass
+     */
+    void onLoadingFinished(bool success, int count);
+    
+    /**
+     * @brief Slot called when the statistics pass finishes
+     */
+    void onStatsFinished();
 };
 
 #endif // XMLDATAMODEL_H
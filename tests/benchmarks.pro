@@ -0,0 +1,99 @@
+###############################################################################
+# Render Compare - Benchmark Project
+# Qt Test Framework (QBENCHMARK) Configuration
+###############################################################################
+
+TEMPLATE = app
+TARGET = benchmarks
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+# Benchmarks measure optimized code
+CONFIG -= debug
+CONFIG += release
+
+# Qt modules required for benchmarks
+QT += core
+QT += xml
+QT += testlib
+QT += concurrent
+QT += gui  # Required for QImage, QPixmap in ImageLoaderManager benchmarks
+QT += qml  # Required for SortFilterProxyModel (QQmlParserStatus)
+
+# Application version (same as main project)
+VERSION = 1.0.0
+
+# Add src directory to include path
+INCLUDEPATH += ../src
+INCLUDEPATH += .
+INCLUDEPATH += benchmarks
+
+# Source files from main project (needed for benchmarking)
+SOURCES += ../src/imageloadermanager.cpp \
+           ../src/xmldatamodel.cpp \
+           ../src/xmldataloader.cpp \
+           ../src/sortfilterproxymodel.cpp \
+           ../src/seriesdecimator.cpp \
+           ../src/framevalueindex.cpp \
+           ../src/eventstats.cpp \
+           ../src/versioncomparator.cpp \
+           ../src/sparklinerenderer.cpp \
+           ../src/framering.cpp \
+           ../src/tilepyramid.cpp \
+           ../src/tracer.cpp \
+           ../src/metricsregistry.cpp \
+           ../src/memorygovernor.cpp \
+           ../src/qoicodec.cpp \
+           ../src/compressedframecache.cpp
+
+HEADERS += ../src/imageloadermanager.h \
+           ../src/xmldatamodel.h \
+           ../src/xmldataloader.h \
+           ../src/sortfilterproxymodel.h \
+           ../src/seriesdecimator.h \
+           ../src/framevalueindex.h \
+           ../src/eventstats.h \
+           ../src/versioncomparator.h \
+           ../src/sparklinerenderer.h \
+           ../src/framering.h \
+           ../src/tilepyramid.h \
+           ../src/tracer.h \
+           ../src/metricsregistry.h \
+           ../src/memorygovernor.h \
+           ../src/qoicodec.h \
+           ../src/compressedframecache.h
+
+# Synthetic data sets (uiData.xml, compareResult.xml, image sequences)
+SOURCES += benchmarks/benchfixtures.cpp
+HEADERS += benchmarks/benchfixtures.h
+
+# Benchmark source files
+# Note: Benchmark files have no QTEST_MAIN - using shared main()
+SOURCES += benchmarks_main.cpp \
+           benchmarks/bench_xmldatamodel.cpp \
+           benchmarks/bench_proxyfilter.cpp \
+           benchmarks/bench_imageloadermanager.cpp \
+           benchmarks/bench_framedecode.cpp
+
+# Output directory
+DESTDIR = $$PWD/../bin
+OBJECTS_DIR = $$PWD/../build/benchmarks
+MOC_DIR = $$PWD/../build/benchmarks
+RCC_DIR = $$PWD/../build/benchmarks
+UI_DIR = $$PWD/../build/benchmarks
+
+# Ensure MOC files are generated properly
+CONFIG += moc
+CONFIG += warn_on
+
+# Create build directory if it doesn't exist
+!exists($$OBJECTS_DIR) {
+    system(mkdir -p $$OBJECTS_DIR)
+}
+!exists($$MOC_DIR) {
+    system(mkdir -p $$MOC_DIR)
+}
+
+# Disable warnings for benchmark files (Qt Test generates some warnings)
+QMAKE_CXXFLAGS += -Wno-unused-parameter
@@ -0,0 +1,205 @@
+/****************************************************************************
+**
+** @file bench_framedecode.cpp
+** @brief Frame decode throughput benchmarks
+**
+** Benchmarks for:
+** - Full-resolution decode of A/B/C (JPEG) and D (PNG) frames
+** - Screen-resolution decode (the panes' decodeSize)
+** - Decompression from the compressed frame tier (QOI), vs. decodeFull
+** - Decode-ahead through FrameRing's worker threads
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QEventLoop>
+#include <QImageReader>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+#include "../src/qoicodec.h"
+#include "benchfixtures.h"
+
+class BenchFrameDecode : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Benchmarks
+    void decodeFull_data();
+    void decodeFull();
+    void decodeScaled_data();
+    void decodeScaled();
+    void decodeCompressed_data();
+    void decodeCompressed();
+    void decodeAhead_data();
+    void decodeAhead();
+
+private:
+    QTemporaryDir m_dir;
+
+    static const int SequenceLength = 8;
+
+    QString sequenceFixture(const QSize &size, const QString &format);
+    QString framePath(const QSize &size, const QString &format, int frame);
+    static void addSequences();
+};
+
+void BenchFrameDecode::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString BenchFrameDecode::sequenceFixture(const QSize &size, const QString &format)
+{
+    const QString basePath = QDir(m_dir.path()).absoluteFilePath(
+        QString("%1x%2_%3/images/").arg(size.width()).arg(size.height()).arg(format));
+    if (!QFile::exists(basePath + "0001." + format)
+        && !BenchFixtures::writeImageSequence(basePath, SequenceLength, size, format)) {
+        return QString();
+    }
+    return basePath;
+}
+
+QString BenchFrameDecode::framePath(const QSize &size, const QString &format, int frame)
+{
+    return sequenceFixture(size, format) + QString("%1").arg(frame, 4, 10, QChar('0')) + "." + format;
+}
+
+void BenchFrameDecode::addSequences()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("1920x1080 jpg") << QSize(1920, 1080) << QString("jpg");
+    QTest::newRow("3840x2160 jpg") << QSize(3840, 2160) << QString("jpg");
+    QTest::newRow("1920x1080 png") << QSize(1920, 1080) << QString("png");
+    QTest::newRow("3840x2160 png") << QSize(3840, 2160) << QString("png");
+}
+
+void BenchFrameDecode::decodeFull_data()
+{
+    addSequences();
+}
+
+void BenchFrameDecode::decodeFull()
+{
+    QFETCH(QSize, size);
+    QFETCH(QString, format);
+    QStringList paths;
+    for (int frame = 1; frame <= SequenceLength; ++frame) {
+        paths.append(framePath(size, format, frame));
+    }
+    QVERIFY(QFile::exists(paths.last()));
+
+    // One frame per iteration; frames/s = 1000 / value
+    int frame = 0;
+    QBENCHMARK {
+        QImage image;
+        QVERIFY(image.load(paths.at(frame)));
+        frame = (frame + 1) % paths.size();
+    }
+}
+
+void BenchFrameDecode::decodeScaled_data()
+{
+    addSequences();
+}
+
+void BenchFrameDecode::decodeScaled()
+{
+    QFETCH(QSize, size);
+    QFETCH(QString, format);
+    QStringList paths;
+    for (int frame = 1; frame <= SequenceLength; ++frame) {
+        paths.append(framePath(size, format, frame));
+    }
+    QVERIFY(QFile::exists(paths.last()));
+
+    // A pane on a 1080p screen: decoded at (at most) 1920x1080, aspect kept
+    const QSize decodeSize = size.scaled(QSize(1920, 1080), Qt::KeepAspectRatio);
+    int frame = 0;
+    QBENCHMARK {
+        QImageReader reader(paths.at(frame));
+        reader.setScaledSize(decodeSize);
+        QVERIFY(!reader.read().isNull());
+        frame = (frame + 1) % paths.size();
+    }
+}
+
+void BenchFrameDecode::decodeCompressed_data()
+{
+    addSequences();
+}
+
+void BenchFrameDecode::decodeCompressed()
+{
+    QFETCH(QSize, size);
+    QFETCH(QString, format);
+    QList<QByteArray> frames;
+    for (int frame = 1; frame <= SequenceLength; ++frame) {
+        QImage image(framePath(size, format, frame));
+        QVERIFY(QoiCodec::canEncode(image));
+        frames.append(QoiCodec::encode(image));
+    }
+
+    // Same sequences as decodeFull, promoted from the compressed tier instead of the files
+    int frame = 0;
+    QBENCHMARK {
+        QVERIFY(!QoiCodec::decode(frames.at(frame)).isNull());
+        frame = (frame + 1) % frames.size();
+    }
+}
+
+void BenchFrameDecode::decodeAhead_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("1920x1080 jpg") << QSize(1920, 1080) << QString("jpg");
+    QTest::newRow("3840x2160 jpg") << QSize(3840, 2160) << QString("jpg");
+}
+
+void BenchFrameDecode::decodeAhead()
+{
+    QFETCH(QSize, size);
+    QFETCH(QString, format);
+    const QString basePath = sequenceFixture(size, format);
+    QVERIFY(!basePath.isEmpty());
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    FrameRing ring;
+    ring.setImageLoaderManager(&manager);
+    ring.setCapacity(SequenceLength);
+
+    // Time until the whole sequence is decoded by the ring's workers
+    QBENCHMARK {
+        ring.clear();
+        QEventLoop loop;
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+        connect(&ring, &FrameRing::frameDecoded, &loop, [&ring, &loop]() {
+            if (ring.size() >= SequenceLength) {
+                loop.quit();
+            }
+        }, Qt::QueuedConnection);
+        for (int frame = 1; frame <= SequenceLength; ++frame) {
+            QVERIFY(ring.request("A", frame));
+        }
+        timeout.start(60000);
+        if (ring.size() < SequenceLength) {
+            loop.exec();
+        }
+        QCOMPARE(ring.size(), ring.capacity());
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in benchmarks_main.cpp instead
+#include "bench_framedecode.moc"
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** @file bench_imageloadermanager.cpp
+** @brief Benchmarks for the ImageLoaderManager caches
+**
+** Benchmarks for:
+** - Frame cache hit and miss (stepping through a sequence)
+** - Tile cache hit and miss
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+
+#include "../src/imageloadermanager.h"
+#include "benchfixtures.h"
+
+class BenchImageLoaderManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Benchmarks
+    void frameCacheHit_data();
+    void frameCacheHit();
+    void frameCacheMiss_data();
+    void frameCacheMiss();
+    void tileCacheHit();
+    void tileCacheMiss();
+
+private:
+    QTemporaryDir m_dir;
+
+    static const int SequenceLength = 8;  // More frames than the default frame cache holds
+
+    QString sequenceFixture(const QSize &size);
+    static void addResolutions();
+};
+
+void BenchImageLoaderManager::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString BenchImageLoaderManager::sequenceFixture(const QSize &size)
+{
+    const QString basePath = QDir(m_dir.path()).absoluteFilePath(
+        QString("%1x%2/imagesA/").arg(size.width()).arg(size.height()));
+    if (!QFile::exists(basePath + "0001.jpg")
+        && !BenchFixtures::writeImageSequence(basePath, SequenceLength, size, "jpg")) {
+        return QString();
+    }
+    return basePath;
+}
+
+void BenchImageLoaderManager::addResolutions()
+{
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("1920x1080") << QSize(1920, 1080);
+    QTest::newRow("3840x2160") << QSize(3840, 2160);
+}
+
+void BenchImageLoaderManager::frameCacheHit_data()
+{
+    addResolutions();
+}
+
+void BenchImageLoaderManager::frameCacheHit()
+{
+    QFETCH(QSize, size);
+    const QString basePath = sequenceFixture(size);
+    QVERIFY(!basePath.isEmpty());
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    QVERIFY(!manager.getImage("A", 1).isNull());
+
+    QBENCHMARK {
+        manager.getImage("A", 1);
+    }
+}
+
+void BenchImageLoaderManager::frameCacheMiss_data()
+{
+    addResolutions();
+}
+
+void BenchImageLoaderManager::frameCacheMiss()
+{
+    QFETCH(QSize, size);
+    const QString basePath = sequenceFixture(size);
+    QVERIFY(!basePath.isEmpty());
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    QVERIFY(manager.getMaxCacheSize() < SequenceLength);
+
+    // Stepping through more frames than the cache holds: every lookup loads from disk
+    int frame = 0;
+    QBENCHMARK {
+        QVERIFY(!manager.getImage("A", frame + 1).isNull());
+        frame = (frame + 1) % SequenceLength;
+    }
+}
+
+void BenchImageLoaderManager::tileCacheHit()
+{
+    const QString basePath = sequenceFixture(QSize(3840, 2160));
+    QVERIFY(!basePath.isEmpty());
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    QVERIFY(!manager.getTile("A", 1, 0, 3, 2).isNull());
+
+    QBENCHMARK {
+        manager.getTile("A", 1, 0, 3, 2);
+    }
+}
+
+void BenchImageLoaderManager::tileCacheMiss()
+{
+    const QString basePath = sequenceFixture(QSize(3840, 2160));
+    QVERIFY(!basePath.isEmpty());
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    manager.setMaxTileCacheMegabytes(0);  // Nothing is kept
+
+    QBENCHMARK {
+        QVERIFY(!manager.getTile("A", 1, 0, 3, 2).isNull());
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in benchmarks_main.cpp instead
+#include "bench_imageloadermanager.moc"
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** @file bench_proxyfilter.cpp
+** @brief Benchmarks for SortFilterProxyModel on top of XmlDataModel
+**
+** Benchmarks for:
+** - Re-filtering the table for one keystroke in the search field
+** - Re-sorting the table by a column
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include "../src/xmldatamodel.h"
+#include "../src/sortfilterproxymodel.h"
+#include "benchfixtures.h"
+
+class BenchProxyFilter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Benchmarks
+    void filterKeystroke_data();
+    void filterKeystroke();
+    void sortColumn_data();
+    void sortColumn();
+
+private:
+    QTemporaryDir m_dir;
+
+    bool loadFixture(XmlDataModel &model, int entryCount);
+    static void addTableSizes();
+};
+
+void BenchProxyFilter::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+bool BenchProxyFilter::loadFixture(XmlDataModel &model, int entryCount)
+{
+    const QString path = QDir(m_dir.path()).absoluteFilePath(QString("uiData_%1/testSets_results").arg(entryCount));
+    if (!QFile::exists(path + "/uiData.xml")
+        && !BenchFixtures::writeUiData(path, entryCount, QStringList() << "freedview_1.0.0")) {
+        return false;
+    }
+    const bool loaded = BenchFixtures::loadModel(model, path);
+    QThreadPool::globalInstance()->waitForDone();  // Statistics pass started by the load
+    return loaded;
+}
+
+void BenchProxyFilter::addTableSizes()
+{
+    QTest::addColumn<int>("entryCount");
+
+    QTest::newRow("1000 entries") << 1000;
+    QTest::newRow("5000 entries") << 5000;
+}
+
+void BenchProxyFilter::filterKeystroke_data()
+{
+    addTableSizes();
+}
+
+void BenchProxyFilter::filterKeystroke()
+{
+    QFETCH(int, entryCount);
+    XmlDataModel model;
+    QVERIFY(loadFixture(model, entryCount));
+
+    // Configured like the proxy in TableviewTable.qml
+    SortFilterProxyModel proxy;
+    proxy.setSource(&model);
+    proxy.setFilterSyntax(SortFilterProxyModel::Wildcard);
+    proxy.setFilterCaseSensitivity(Qt::CaseInsensitive);
+    proxy.setDynamicSortFilter(true);
+    proxy.componentComplete();
+
+    // Typing "stadium 12" and deleting it again: one pattern per keystroke
+    const QString typed = "stadium 12";
+    QStringList keystrokes;
+    for (int i = 1; i <= typed.size(); ++i) {
+        keystrokes.append("*" + typed.left(i) + "*");
+    }
+    for (int i = typed.size() - 1; i >= 0; --i) {
+        keystrokes.append(i > 0 ? "*" + typed.left(i) + "*" : QString("*"));
+    }
+
+    proxy.setFilterString(keystrokes.last());
+    QCOMPARE(proxy.rowCount(), entryCount);
+
+    int keystroke = 0;
+    QBENCHMARK {
+        proxy.setFilterString(keystrokes.at(keystroke));
+        proxy.rowCount();
+        keystroke = (keystroke + 1) % keystrokes.size();
+    }
+}
+
+void BenchProxyFilter::sortColumn_data()
+{
+    addTableSizes();
+}
+
+void BenchProxyFilter::sortColumn()
+{
+    QFETCH(int, entryCount);
+    XmlDataModel model;
+    QVERIFY(loadFixture(model, entryCount));
+
+    SortFilterProxyModel proxy;
+    proxy.setSource(&model);
+    proxy.setSortRole("stadiumName");
+    proxy.setSortCaseSensitivity(Qt::CaseInsensitive);
+    proxy.setDynamicSortFilter(true);
+    proxy.componentComplete();
+
+    // Toggling the sort indicator: alternate directions so every iteration re-sorts
+    Qt::SortOrder order = Qt::AscendingOrder;
+    QBENCHMARK {
+        order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+        proxy.setSortOrder(order);
+    }
+    QCOMPARE(proxy.rowCount(), entryCount);
+}
+
+// QTEST_MAIN removed - using shared main() in benchmarks_main.cpp instead
+#include "bench_proxyfilter.moc"
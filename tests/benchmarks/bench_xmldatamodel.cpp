@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** @file bench_xmldatamodel.cpp
+** @brief Benchmarks for XmlDataModel
+**
+** Benchmarks for:
+** - uiData.xml load until the table is filled (N entries)
+** - Opening an event: first open (scan + parse) and reopening (parse cache)
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include "../src/xmldatamodel.h"
+#include "benchfixtures.h"
+
+class BenchXmlDataModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Benchmarks
+    void loadToTable_data();
+    void loadToTable();
+    void openEvent_data();
+    void openEvent();
+    void reopenEvent_data();
+    void reopenEvent();
+
+private:
+    QTemporaryDir m_dir;
+
+    QString uiDataFixture(int entryCount);
+    QString resultsFixture(int entryCount, int frameCount);
+    static bool openEventRow(const XmlDataModel &model, int row);
+    static void addEventSizes();
+};
+
+void BenchXmlDataModel::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString BenchXmlDataModel::uiDataFixture(int entryCount)
+{
+    // Fixtures are written once and shared by every run of the benchmark function
+    const QString path = QDir(m_dir.path()).absoluteFilePath(QString("uiData_%1/testSets_results").arg(entryCount));
+    if (!QFile::exists(path + "/uiData.xml")
+        && !BenchFixtures::writeUiData(path, entryCount, QStringList() << "freedview_1.0.0")) {
+        return QString();
+    }
+    return path;
+}
+
+QString BenchXmlDataModel::resultsFixture(int entryCount, int frameCount)
+{
+    const QString path = QDir(m_dir.path()).absoluteFilePath(
+        QString("results_%1x%2/testSets_results").arg(entryCount).arg(frameCount));
+    if (!QFile::exists(path + "/uiData.xml")
+        && !BenchFixtures::writeResultsTree(path, entryCount, frameCount,
+                                            QStringList() << "freedview_1.0.0" << "freedview_1.1.0")) {
+        return QString();
+    }
+    return path;
+}
+
+/**
+ * @brief What Main.qml's openSelectedSet() asks the model for when an event is opened
+ */
+bool BenchXmlDataModel::openEventRow(const XmlDataModel &model, int row)
+{
+    const int startFrame = model.getStartFrame(row);
+    const int endFrame = model.getEndFrame(row);
+    model.getMinVal(row);
+    model.getMaxVal(row);
+    const QVariantList frames = model.getFrameList_frame(row);
+    model.getFrameList_val(row);
+    const QStringList outputPaths = model.getOutputPathList(row);
+    model.getOrigFreeDViewName(row);
+    model.getTestFreeDViewName(row);
+    return startFrame > 0 && endFrame >= startFrame && !frames.isEmpty() && outputPaths.size() == 4;
+}
+
+void BenchXmlDataModel::addEventSizes()
+{
+    QTest::addColumn<int>("entryCount");
+    QTest::addColumn<int>("frameCount");
+
+    QTest::newRow("100 events x 1000 frames") << 100 << 1000;
+    QTest::newRow("100 events x 10000 frames") << 100 << 10000;
+    QTest::newRow("1000 events x 1000 frames") << 1000 << 1000;
+}
+
+void BenchXmlDataModel::loadToTable_data()
+{
+    QTest::addColumn<int>("entryCount");
+
+    QTest::newRow("100 entries") << 100;
+    QTest::newRow("1000 entries") << 1000;
+    QTest::newRow("5000 entries") << 5000;
+}
+
+void BenchXmlDataModel::loadToTable()
+{
+    QFETCH(int, entryCount);
+    const QString resultsPath = uiDataFixture(entryCount);
+    QVERIFY(!resultsPath.isEmpty());
+
+    QBENCHMARK {
+        XmlDataModel model;
+        QVERIFY(BenchFixtures::loadModel(model, resultsPath));
+        QCOMPARE(model.rowCount(), entryCount);
+    }
+    // Let the statistics passes started by the loads finish before the next benchmark
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+void BenchXmlDataModel::openEvent_data()
+{
+    addEventSizes();
+}
+
+void BenchXmlDataModel::openEvent()
+{
+    QFETCH(int, entryCount);
+    QFETCH(int, frameCount);
+    const QString resultsPath = resultsFixture(entryCount, frameCount);
+    QVERIFY(!resultsPath.isEmpty());
+
+    XmlDataModel model;
+    QSignalSpy statsReady(&model, &XmlDataModel::eventStatsReady);
+    QVERIFY(BenchFixtures::loadModel(model, resultsPath));
+    QVERIFY(statsReady.count() > 0 || statsReady.wait(120000));
+
+    // Each event is parsed only once per load, so first opens are measured as one
+    // batch of distinct rows (the value is the time for the whole batch)
+    const int batch = qMin(10, entryCount);
+    QBENCHMARK_ONCE {
+        for (int row = 0; row < batch; ++row) {
+            QVERIFY(openEventRow(model, row * (entryCount / batch)));
+        }
+    }
+}
+
+void BenchXmlDataModel::reopenEvent_data()
+{
+    addEventSizes();
+}
+
+void BenchXmlDataModel::reopenEvent()
+{
+    QFETCH(int, entryCount);
+    QFETCH(int, frameCount);
+    const QString resultsPath = resultsFixture(entryCount, frameCount);
+    QVERIFY(!resultsPath.isEmpty());
+
+    XmlDataModel model;
+    QSignalSpy statsReady(&model, &XmlDataModel::eventStatsReady);
+    QVERIFY(BenchFixtures::loadModel(model, resultsPath));
+    QVERIFY(statsReady.count() > 0 || statsReady.wait(120000));
+    QVERIFY(openEventRow(model, 0));
+
+    QBENCHMARK {
+        openEventRow(model, 0);
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in benchmarks_main.cpp instead
+#include "bench_xmldatamodel.moc"
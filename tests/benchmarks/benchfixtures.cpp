@@ -0,0 +1,226 @@
+#include "benchfixtures.h"
+#include "../src/xmldatamodel.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <QXmlStreamWriter>
+
+namespace {
+
+const char *const kSports[] = { "NFL", "NBA", "MLB", "NHL", "Soccer" };
+
+int eventIndexOf(int entryIndex)
+{
+    return entryIndex / 2;
+}
+
+QString sportOf(int entryIndex)
+{
+    return QLatin1String(kSports[eventIndexOf(entryIndex) % 5]);
+}
+
+QString stadiumOf(int entryIndex)
+{
+    return QString("Stadium %1").arg(eventIndexOf(entryIndex) % 40);
+}
+
+bool ensureParentDir(const QString &filePath)
+{
+    return QDir().mkpath(QFileInfo(filePath).absolutePath());
+}
+
+/**
+ * @brief Frame-like content: gradient, sensor-style noise and a shape that moves per frame
+ *
+ * Flat colours would make JPEG/PNG decoding unrealistically cheap.
+ */
+QImage makeFrame(const QSize &size, int frameNumber, bool withAlpha)
+{
+    QImage image(size, withAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    QPainter painter(&image);
+    QLinearGradient gradient(0, 0, size.width(), size.height());
+    gradient.setColorAt(0.0, QColor(30, 90, 40));
+    gradient.setColorAt(1.0, QColor(160, 170, 120));
+    painter.fillRect(image.rect(), gradient);
+    painter.setBrush(QColor(220, 60, 40));
+    painter.setPen(Qt::NoPen);
+    const int step = qMax(1, size.width() / 50);
+    painter.drawEllipse(QPoint((frameNumber * step) % size.width(), size.height() / 2),
+                        size.width() / 12, size.height() / 8);
+    painter.end();
+
+    QRandomGenerator random(static_cast<quint32>(frameNumber));
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const int noise = static_cast<int>(random.bounded(16u)) - 8;
+            const QRgb pixel = line[x];
+            const int alpha = withAlpha ? ((x / 64 + y / 64) % 2 ? 255 : 0) : 255;
+            line[x] = qRgba(qBound(0, qRed(pixel) + noise, 255), qBound(0, qGreen(pixel) + noise, 255),
+                            qBound(0, qBlue(pixel) + noise, 255), alpha);
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+QString BenchFixtures::testKey(int entryIndex)
+{
+    const QString set = entryIndex % 2 == 0 ? QStringLiteral("S170123190428") : QStringLiteral("S170123191502");
+    const QString frameFolder = QString("F%1").arg(1 + (entryIndex % 3) * 111, 4, 10, QChar('0'));
+    return QStringList({sportOf(entryIndex), stadiumOf(entryIndex), eventName(entryIndex), set, frameFolder}).join("/");
+}
+
+QString BenchFixtures::eventName(int entryIndex)
+{
+    return QString("E%1_LIVE").arg(eventIndexOf(entryIndex) + 1, 6, 10, QChar('0'));
+}
+
+bool BenchFixtures::writeUiData(const QString &resultsPath, int entryCount, const QStringList &versions)
+{
+    if (!QDir().mkpath(resultsPath) || versions.isEmpty()) {
+        return false;
+    }
+
+    // One small JPEG, copied as every entry's thumbnail
+    const QString thumbnailSource = QDir(resultsPath).absoluteFilePath("thumbnail_source.jpg");
+    if (!QFile::exists(thumbnailSource) && !makeFrame(QSize(160, 90), 1, false).save(thumbnailSource, "JPG", 80)) {
+        return false;
+    }
+
+    static const char *const statuses[] = { "Ready", "Ready", "Ready", "Not Ready", "In Progress" };
+
+    QFile file(QDir(resultsPath).absoluteFilePath("uiData.xml"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("uiData");
+    xml.writeStartElement("renderVersions");
+    for (const QString &version : versions) {
+        xml.writeTextElement("version", version);
+    }
+    xml.writeEndElement();
+    xml.writeStartElement("entries");
+    for (int i = 0; i < entryCount; ++i) {
+        const QString key = testKey(i);
+        const QString thumbnailPath = key + "/" + versions.first() + "/thumbnail.jpg";
+        const QString thumbnailFile = QDir(resultsPath).absoluteFilePath(thumbnailPath);
+        if (!QFile::exists(thumbnailFile) && (!ensureParentDir(thumbnailFile) || !QFile::copy(thumbnailSource, thumbnailFile))) {
+            return false;
+        }
+
+        xml.writeStartElement("entry");
+        xml.writeTextElement("id", QString::number(i + 1));
+        xml.writeTextElement("eventName", eventName(i));
+        xml.writeTextElement("sportType", sportOf(i));
+        xml.writeTextElement("stadiumName", stadiumOf(i));
+        xml.writeTextElement("categoryName", QString("Category %1").arg(i % 7));
+        xml.writeTextElement("numberOfFrames", QString::number(100 + i % 900));
+        xml.writeTextElement("minValue", QString::number(0.9 + (i % 10) / 100.0));
+        xml.writeTextElement("numFramesUnderMin", QString::number(i % 13));
+        xml.writeTextElement("thumbnailPath", thumbnailPath);
+        xml.writeTextElement("status", statuses[i % 5]);
+        xml.writeTextElement("notes", i % 3 == 0 ? QString("Checked camera %1").arg(i % 16) : QString());
+        xml.writeTextElement("renderVersions", versions.join(","));
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();  // entries
+    xml.writeEndElement();  // uiData
+    xml.writeEndDocument();
+    return !xml.hasError();
+}
+
+bool BenchFixtures::writeCompareResult(const QString &xmlPath, int frameCount, int seed)
+{
+    if (!ensureParentDir(xmlPath)) {
+        return false;
+    }
+    QFile file(xmlPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    // Mostly near-identical frames with occasional dips, like real render comparisons
+    QRandomGenerator random(static_cast<quint32>(seed));
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("compareResult");
+    xml.writeTextElement("startFrame", "1");
+    xml.writeTextElement("endFrame", QString::number(frameCount));
+    xml.writeTextElement("minVal", "0");
+    xml.writeTextElement("maxVal", "1");
+    xml.writeTextElement("sourcePath", "source/");
+    xml.writeTextElement("testPath", "test/");
+    xml.writeTextElement("diffPath", "diff/");
+    xml.writeTextElement("alphaPath", "alpha/");
+    xml.writeTextElement("origFreeDView", "freedview_1.0.0");
+    xml.writeTextElement("testFreedview", "freedview_1.1.0");
+    xml.writeStartElement("frames");
+    for (int frame = 1; frame <= frameCount; ++frame) {
+        const double value = random.bounded(50) == 0 ? 0.7 + random.generateDouble() * 0.25
+                                                     : 0.97 + random.generateDouble() * 0.03;
+        xml.writeStartElement("frame");
+        xml.writeTextElement("frameIndex", QString::number(frame));
+        xml.writeTextElement("value", QString::number(value, 'f', 6));
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();  // frames
+    xml.writeEndElement();  // compareResult
+    xml.writeEndDocument();
+    return !xml.hasError();
+}
+
+bool BenchFixtures::writeResultsTree(const QString &resultsPath, int entryCount, int frameCount,
+                                     const QStringList &versions)
+{
+    if (!writeUiData(resultsPath, entryCount, versions)) {
+        return false;
+    }
+    const QDir resultsDir(resultsPath);
+    for (int i = 0; i < entryCount; ++i) {
+        for (int v = 0; v < versions.size(); ++v) {
+            const QString xmlPath = resultsDir.absoluteFilePath(testKey(i) + "/" + versions.at(v)
+                                                                + "/results/compareResult.xml");
+            if (!writeCompareResult(xmlPath, frameCount, i * versions.size() + v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool BenchFixtures::writeImageSequence(const QString &basePath, int frameCount, const QSize &size,
+                                       const QString &format)
+{
+    if (!ensureParentDir(basePath + "0001." + format)) {
+        return false;
+    }
+    const bool png = format.compare("png", Qt::CaseInsensitive) == 0;
+    for (int frame = 1; frame <= frameCount; ++frame) {
+        const QString path = basePath + QString("%1").arg(frame, 4, 10, QChar('0')) + "." + format;
+        if (!makeFrame(size, frame, png).save(path, png ? "PNG" : "JPG", png ? -1 : 90)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BenchFixtures::loadModel(XmlDataModel &model, const QString &resultsPath, int timeoutMs)
+{
+    QSignalSpy finished(&model, &XmlDataModel::loadingFinished);
+    if (!model.loadData(resultsPath) || !finished.wait(timeoutMs)) {
+        return false;
+    }
+    return finished.first().at(0).toBool();
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** @file benchfixtures.h
+** @brief Synthetic data sets for the benchmark suite
+**
+** Writes testSets_results trees shaped like the ones freeDView_tester
+** produces, at whatever size a benchmark needs:
+** - uiData.xml with N entries (and a thumbnail per entry)
+** - compareResult.xml with M frames per event and render version
+** - A/B/C/D image sequences at a configurable resolution
+**
+****************************************************************************/
+
+#ifndef BENCHFIXTURES_H
+#define BENCHFIXTURES_H
+
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+// Forward declaration
+class XmlDataModel;
+
+class BenchFixtures
+{
+public:
+    /**
+     * @brief Test key of a generated entry: <Sport>/<Stadium>/<Event>/<Set>/F####
+     *
+     * Like real results trees, entries share sport, stadium, set and frame folder
+     * names; two consecutive entries are sets of the same event.
+     */
+    static QString testKey(int entryIndex);
+
+    /**
+     * @brief Event name of a generated entry (as shown in the table, and its event folder)
+     */
+    static QString eventName(int entryIndex);
+
+    /**
+     * @brief Write uiData.xml with N entries and their thumbnails
+     * @param resultsPath - testSets_results root (created if needed)
+     * @param entryCount - Number of entries
+     * @param versions - Render versions listed for every entry
+     * @return true on success
+     */
+    static bool writeUiData(const QString &resultsPath, int entryCount, const QStringList &versions);
+
+    /**
+     * @brief Write one compareResult.xml
+     * @param xmlPath - File to write (parent directories are created)
+     * @param frameCount - Number of <frame> elements (frames 1..frameCount)
+     * @param seed - Varies the frame values between events and versions
+     * @return true on success
+     */
+    static bool writeCompareResult(const QString &xmlPath, int frameCount, int seed);
+
+    /**
+     * @brief Write a complete results tree: uiData.xml plus a compareResult.xml
+     *        per entry and render version
+     * @param resultsPath - testSets_results root
+     * @param entryCount - Number of entries
+     * @param frameCount - Frames per compareResult.xml
+     * @param versions - Render versions (at least one)
+     * @return true on success
+     */
+    static bool writeResultsTree(const QString &resultsPath, int entryCount, int frameCount,
+                                 const QStringList &versions);
+
+    /**
+     * @brief Write an image sequence named like ImageLoaderManager expects
+     * @param basePath - Path prefix, e.g. "<dir>/imagesA/" (frame number and extension are appended)
+     * @param frameCount - Frames 1..frameCount
+     * @param size - Image resolution
+     * @param format - "jpg" or "png"
+     * @return true on success
+     */
+    static bool writeImageSequence(const QString &basePath, int frameCount, const QSize &size,
+                                   const QString &format);
+
+    /**
+     * @brief Load a results tree into a model and wait until the table is filled
+     * @param model - Model to load
+     * @param resultsPath - testSets_results root
+     * @param timeoutMs - Maximum wait
+     * @return true if loading finished successfully in time
+     */
+    static bool loadModel(XmlDataModel &model, const QString &resultsPath, int timeoutMs = 60000);
+};
+
+#endif // BENCHFIXTURES_H
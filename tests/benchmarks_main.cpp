@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** @file benchmarks_main.cpp
+** @brief Main entry point for the benchmark suite
+**
+** Runs every benchmark class in sequence (like tests_main.cpp) and collects
+** the QBENCHMARK results of all classes into one JSON file, so runs can be
+** stored and diffed over time.
+**
+** Usage: benchmarks [BenchClass ...] [-json <file>] [QTest options]
+**   BenchClass  - Run only the named classes (default: all)
+**   -json       - Results file (default: benchmark_results.json)
+** Other options (-iterations, -minimumvalue, -callgrind, -tickcounter, ...)
+** are passed to QTest; the JSON records whichever metric was measured.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QGuiApplication>  // Required for QPixmap operations
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QXmlStreamReader>
+
+// Include benchmark class implementations
+// These files define the benchmark classes but have no QTEST_MAIN
+#include "benchmarks/bench_xmldatamodel.cpp"
+#include "benchmarks/bench_proxyfilter.cpp"
+#include "benchmarks/bench_imageloadermanager.cpp"
+#include "benchmarks/bench_framedecode.cpp"
+
+namespace {
+
+/**
+ * @brief Append the <BenchmarkResult> entries of a QTest XML log to the results
+ *
+ * QTest's XML logger reports the value per iteration.
+ */
+bool collectResults(const QString &xmlPath, const QString &className, QJsonArray &results)
+{
+    QFile file(xmlPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QXmlStreamReader xml(&file);
+    QString function;
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("TestFunction")) {
+            function = attributes.value("name").toString();
+        } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            QJsonObject result;
+            result["benchmark"] = className + "::" + function;
+            result["tag"] = attributes.value("tag").toString();
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results.append(result);
+        }
+    }
+    return !xml.hasError();
+}
+
+/**
+ * @brief Run one benchmark class, with its results logged to XML as well
+ * @return QTest::qExec() status
+ */
+int runBenchmark(QObject *bench, const QStringList &arguments, QJsonArray &results)
+{
+    const QString className = bench->metaObject()->className();
+    QTemporaryDir logDir;
+    const QString xmlPath = logDir.filePath(className + ".xml");
+
+    QStringList benchArguments = arguments;
+    if (!arguments.contains("-o")) {
+        benchArguments << "-o" << "-,txt";  // Keep the usual console output
+    }
+    benchArguments << "-o" << xmlPath + ",xml";
+
+    const int status = QTest::qExec(bench, benchArguments);
+    if (!collectResults(xmlPath, className, results)) {
+        qWarning() << "Could not read benchmark results of" << className;
+        return 1;
+    }
+    return status;
+}
+
+bool writeResults(const QString &jsonPath, const QJsonArray &results)
+{
+    QJsonObject root;
+    root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["qtVersion"] = QString(qVersion());
+    root["platform"] = QSysInfo::prettyProductName();
+    root["cpuArchitecture"] = QSysInfo::currentCpuArchitecture();
+    root["host"] = QSysInfo::machineHostName();
+    root["results"] = results;
+
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    // Indented: one value per line, so two runs diff cleanly
+    return file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) > 0;
+}
+
+} // namespace
+
+// Main function that runs all benchmarks
+int main(int argc, char *argv[])
+{
+    // QGuiApplication required for QPixmap operations (used by ImageLoaderManager)
+    QGuiApplication app(argc, argv);
+
+    // Take the runner's own options out; the rest goes to QTest
+    QStringList arguments = app.arguments();
+    QString jsonPath = "benchmark_results.json";
+    const int jsonIndex = arguments.indexOf("-json");
+    if (jsonIndex > 0 && jsonIndex + 1 < arguments.size()) {
+        jsonPath = arguments.at(jsonIndex + 1);
+        arguments.erase(arguments.begin() + jsonIndex, arguments.begin() + jsonIndex + 2);
+    }
+    QStringList selected;
+    for (int i = arguments.size() - 1; i > 0; --i) {
+        if (arguments.at(i).startsWith("Bench")) {
+            selected.prepend(arguments.takeAt(i));
+        }
+    }
+
+    QJsonArray results;
+    int status = 0;
+    auto run = [&](QObject *bench) {
+        if (selected.isEmpty() || selected.contains(bench->metaObject()->className())) {
+            status |= runBenchmark(bench, arguments, results);
+        }
+    };
+
+    // Run each benchmark class
+    {
+        BenchXmlDataModel bench;
+        run(&bench);
+    }
+
+    {
+        BenchProxyFilter bench;
+        run(&bench);
+    }
+
+    {
+        BenchImageLoaderManager bench;
+        run(&bench);
+    }
+
+    {
+        BenchFrameDecode bench;
+        run(&bench);
+    }
+
+    if (!writeResults(jsonPath, results)) {
+        qWarning() << "Could not write" << jsonPath;
+        status = 1;
+    } else {
+        qInfo() << results.size() << "benchmark results written to" << jsonPath;
+    }
+
+    return (status != 0) ? 1 : 0;
+}
@@ -0,0 +1,41 @@
+###############################################################################
+# Render Compare - Performance Regression Gate
+# Runs the benchmark suite and compares it with a stored baseline
+###############################################################################
+
+TEMPLATE = app
+TARGET = perfgate
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+CONFIG -= debug
+CONFIG += release
+
+# Only reads and compares results; the benchmarks run in their own process (benchmarks.pro)
+QT += core
+QT -= gui
+
+# Application version (same as main project)
+VERSION = 1.0.0
+
+INCLUDEPATH += .
+INCLUDEPATH += perfgate
+
+# Gate
+SOURCES += perfgate_main.cpp \
+           perfgate/perfgate.cpp
+HEADERS += perfgate/perfgate.h
+
+# Output directory (next to the benchmarks executable it runs)
+DESTDIR = $$PWD/../bin
+OBJECTS_DIR = $$PWD/../build/perfgate
+MOC_DIR = $$PWD/../build/perfgate
+RCC_DIR = $$PWD/../build/perfgate
+
+CONFIG += warn_on
+
+# Create build directory if it doesn't exist
+!exists($$OBJECTS_DIR) {
+    system(mkdir -p $$OBJECTS_DIR)
+}
@@ -0,0 +1,367 @@
+#include "perfgate.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Largest sample size for the exact U distribution (table of 21 x 21 x 401 doubles)
+const int kExactLimit = 20;
+
+QString caseName(const QString &benchmark, const QString &tag)
+{
+    return tag.isEmpty() ? benchmark : benchmark + " [" + tag + "]";
+}
+
+/**
+ * @brief P(U >= u) under the null hypothesis, from the exact distribution of U
+ *
+ * U counts the pairs where the second sample's value is larger. count[m][n][u]
+ * is the number of orderings of m + n distinct values with that U: the largest
+ * value either belongs to the second sample (adding m pairs) or to the first.
+ */
+double exactUpperTail(int m, int n, double u)
+{
+    std::vector<std::vector<std::vector<double>>> count(m + 1, std::vector<std::vector<double>>(n + 1));
+    for (int i = 0; i <= m; ++i) {
+        for (int j = 0; j <= n; ++j) {
+            std::vector<double> &cell = count[i][j];
+            cell.assign(i * j + 1, 0.0);
+            if (i == 0 || j == 0) {
+                cell[0] = 1.0;
+                continue;
+            }
+            const std::vector<double> &firstLargest = count[i - 1][j];
+            const std::vector<double> &secondLargest = count[i][j - 1];
+            for (int k = 0; k <= i * j; ++k) {
+                if (k < static_cast<int>(firstLargest.size())) {
+                    cell[k] += firstLargest[k];
+                }
+                if (k >= i && k - i < static_cast<int>(secondLargest.size())) {
+                    cell[k] += secondLargest[k - i];
+                }
+            }
+        }
+    }
+
+    const std::vector<double> &distribution = count[m][n];
+    double total = 0.0;
+    double tail = 0.0;
+    for (int k = 0; k < static_cast<int>(distribution.size()); ++k) {
+        total += distribution[k];
+        if (k >= u - 1e-9) {
+            tail += distribution[k];
+        }
+    }
+    return total > 0.0 ? tail / total : 1.0;
+}
+
+QString formatValue(double value)
+{
+    return QString::number(value, 'g', 4);
+}
+
+QString padded(const QString &text, int width, bool right)
+{
+    return right ? text.rightJustified(width) : text.leftJustified(width);
+}
+
+} // namespace
+
+PerfGate::Comparison::Comparison()
+    : baselineCount(0)
+    , currentCount(0)
+    , baselineMedian(0.0)
+    , currentMedian(0.0)
+    , change(0.0)
+    , pSlower(1.0)
+    , pFaster(1.0)
+    , verdict(Unchanged)
+{
+}
+
+bool PerfGate::readResults(const QString &path, Cases &cases, QString *errorString)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = QString("Cannot open %1: %2").arg(path, file.errorString());
+        }
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!document.isObject()) {
+        if (errorString) {
+            *errorString = QString("%1 is not a JSON object: %2").arg(path, parseError.errorString());
+        }
+        return false;
+    }
+    const QJsonObject root = document.object();
+
+    if (root.value("cases").isArray()) {
+        // Baseline written by writeBaseline()
+        for (const QJsonValue &value : root.value("cases").toArray()) {
+            const QJsonObject entry = value.toObject();
+            Case &target = cases[caseName(entry.value("benchmark").toString(), entry.value("tag").toString())];
+            target.metric = entry.value("metric").toString();
+            for (const QJsonValue &sample : entry.value("samples").toArray()) {
+                target.samples.append(sample.toDouble());
+            }
+        }
+        return true;
+    }
+    if (root.value("results").isArray()) {
+        // One run of the benchmark suite
+        for (const QJsonValue &value : root.value("results").toArray()) {
+            const QJsonObject entry = value.toObject();
+            Case &target = cases[caseName(entry.value("benchmark").toString(), entry.value("tag").toString())];
+            target.metric = entry.value("metric").toString();
+            target.samples.append(entry.value("value").toDouble());
+        }
+        return true;
+    }
+
+    if (errorString) {
+        *errorString = QString("%1 has neither \"results\" nor \"cases\"").arg(path);
+    }
+    return false;
+}
+
+bool PerfGate::writeBaseline(const QString &path, const Cases &cases, const QJsonObject &environment)
+{
+    QJsonArray entries;
+    for (auto it = cases.constBegin(); it != cases.constEnd(); ++it) {
+        // Split "BenchClass::function [tag]" back into the suite's fields
+        QString benchmark = it.key();
+        QString tag;
+        const int tagStart = benchmark.indexOf(" [");
+        if (tagStart > 0 && benchmark.endsWith(']')) {
+            tag = benchmark.mid(tagStart + 2, benchmark.size() - tagStart - 3);
+            benchmark = benchmark.left(tagStart);
+        }
+        QJsonArray samples;
+        for (double sample : it.value().samples) {
+            samples.append(sample);
+        }
+        QJsonObject entry;
+        entry["benchmark"] = benchmark;
+        entry["tag"] = tag;
+        entry["metric"] = it.value().metric;
+        entry["samples"] = samples;
+        entries.append(entry);
+    }
+
+    QJsonObject root = environment;
+    root["cases"] = entries;
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    // Indented like the suite's results, so baseline updates diff cleanly
+    return file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) > 0;
+}
+
+QJsonObject PerfGate::readEnvironment(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    root.remove("cases");
+    root.remove("results");
+    return root;
+}
+
+double PerfGate::median(QVector<double> values)
+{
+    if (values.isEmpty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return (values.size() % 2) ? values.at(middle) : (values.at(middle - 1) + values.at(middle)) / 2.0;
+}
+
+double PerfGate::mannWhitneyGreater(const QVector<double> &a, const QVector<double> &b)
+{
+    const int m = a.size();
+    const int n = b.size();
+    if (m == 0 || n == 0) {
+        return 1.0;
+    }
+
+    // U: pairs where b's value is larger, ties count half
+    double u = 0.0;
+    for (double x : a) {
+        for (double y : b) {
+            if (y > x) {
+                u += 1.0;
+            } else if (y == x) {
+                u += 0.5;
+            }
+        }
+    }
+
+    // Tie groups over both samples
+    QVector<double> all = a + b;
+    std::sort(all.begin(), all.end());
+    double tieTerm = 0.0;
+    for (int i = 0; i < all.size();) {
+        int j = i + 1;
+        while (j < all.size() && all.at(j) == all.at(i)) {
+            ++j;
+        }
+        const double t = j - i;
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    if (tieTerm == 0.0 && m <= kExactLimit && n <= kExactLimit) {
+        return exactUpperTail(m, n, u);
+    }
+
+    const double total = m + n;
+    const double mean = m * n / 2.0;
+    const double variance = m * n / 12.0 * ((total + 1.0) - tieTerm / (total * (total - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;  // Every value equal
+    }
+    const double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+QVector<PerfGate::Comparison> PerfGate::compare(const Cases &baseline, const Cases &current, double alpha, double minChange)
+{
+    QStringList names = baseline.keys();
+    for (const QString &name : current.keys()) {
+        if (!baseline.contains(name)) {
+            names.append(name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+
+    QVector<Comparison> comparisons;
+    for (const QString &name : names) {
+        Comparison comparison;
+        comparison.name = name;
+        const Case before = baseline.value(name);
+        const Case now = current.value(name);
+        comparison.metric = now.metric.isEmpty() ? before.metric : now.metric;
+        comparison.baselineCount = before.samples.size();
+        comparison.currentCount = now.samples.size();
+        comparison.baselineMedian = median(before.samples);
+        comparison.currentMedian = median(now.samples);
+
+        if (before.samples.isEmpty()) {
+            comparison.verdict = Added;
+        } else if (now.samples.isEmpty()) {
+            comparison.verdict = Missing;
+        } else {
+            if (comparison.baselineMedian > 0.0) {
+                comparison.change = comparison.currentMedian / comparison.baselineMedian - 1.0;
+            } else if (comparison.currentMedian > 0.0) {
+                comparison.change = std::numeric_limits<double>::infinity();
+            }
+            comparison.pSlower = mannWhitneyGreater(before.samples, now.samples);
+            comparison.pFaster = mannWhitneyGreater(now.samples, before.samples);
+            // Every QTest metric (time, ticks, instructions, events) is lower-is-better
+            if (comparison.pSlower < alpha && comparison.change > minChange) {
+                comparison.verdict = Regressed;
+            } else if (comparison.pFaster < alpha && comparison.change < -minChange) {
+                comparison.verdict = Improved;
+            }
+        }
+        comparisons.append(comparison);
+    }
+    return comparisons;
+}
+
+QString PerfGate::verdictName(Verdict verdict)
+{
+    switch (verdict) {
+    case Regressed:
+        return "REGRESSED";
+    case Improved:
+        return "improved";
+    case Added:
+        return "new";
+    case Missing:
+        return "missing";
+    case Unchanged:
+    default:
+        return "ok";
+    }
+}
+
+QString PerfGate::formatTable(const QVector<Comparison> &comparisons, bool onlyChanged)
+{
+    // Regressions first (largest first), then improvements, new/missing cases, unchanged
+    QVector<Comparison> rows;
+    for (const Comparison &comparison : comparisons) {
+        if (!onlyChanged || comparison.verdict != Unchanged) {
+            rows.append(comparison);
+        }
+    }
+    auto rank = [](Verdict verdict) {
+        switch (verdict) {
+        case Regressed: return 0;
+        case Improved: return 1;
+        case Added: return 2;
+        case Missing: return 3;
+        default: return 4;
+        }
+    };
+    std::stable_sort(rows.begin(), rows.end(), [&rank](const Comparison &a, const Comparison &b) {
+        if (rank(a.verdict) != rank(b.verdict)) {
+            return rank(a.verdict) < rank(b.verdict);
+        }
+        return a.verdict == Regressed ? a.change > b.change : false;
+    });
+
+    QVector<QStringList> cells;
+    cells.append({"Case", "Metric", "Baseline", "Current", "Change", "p", "Result"});
+    for (const Comparison &row : rows) {
+        const bool measured = row.verdict != Added && row.verdict != Missing;
+        const double p = row.change >= 0.0 ? row.pSlower : row.pFaster;
+        cells.append({row.name,
+                      row.metric,
+                      row.baselineCount ? QString("%1 (n=%2)").arg(formatValue(row.baselineMedian)).arg(row.baselineCount) : QString("-"),
+                      row.currentCount ? QString("%1 (n=%2)").arg(formatValue(row.currentMedian)).arg(row.currentCount) : QString("-"),
+                      measured ? QString("%1%2%").arg(row.change >= 0.0 ? "+" : "").arg(row.change * 100.0, 0, 'f', 1) : QString("-"),
+                      measured ? QString::number(p, 'g', 2) : QString("-"),
+                      verdictName(row.verdict)});
+    }
+
+    QVector<int> widths(cells.first().size(), 0);
+    for (const QStringList &line : cells) {
+        for (int column = 0; column < line.size(); ++column) {
+            widths[column] = qMax(widths[column], line.at(column).size());
+        }
+    }
+
+    QStringList lines;
+    for (int index = 0; index < cells.size(); ++index) {
+        QStringList parts;
+        for (int column = 0; column < cells.at(index).size(); ++column) {
+            // Names and metric left-aligned, numbers right-aligned
+            parts.append(padded(cells.at(index).at(column), widths.at(column), column >= 2 && column <= 5));
+        }
+        lines.append(parts.join("  ").trimmed());
+        if (index == 0) {
+            int width = 0;
+            for (int column : widths) {
+                width += column + 2;
+            }
+            lines.append(QString(width - 2, '-'));
+        }
+    }
+    return lines.join('\n');
+}
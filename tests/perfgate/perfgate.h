@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** @file perfgate.h
+** @brief Statistical comparison of benchmark runs against a stored baseline
+**
+** Collects the results of several runs of the benchmark suite (the JSON files
+** written by benchmarks_main.cpp) into samples per benchmark case, and compares
+** them with the samples of a baseline using a one-sided Mann-Whitney U test:
+** a case regressed when it is significantly slower (p < alpha) AND its median
+** is slower by more than a minimum change, so neither noise nor a tiny but
+** consistent shift fails the gate.
+**
+****************************************************************************/
+
+#ifndef PERFGATE_H
+#define PERFGATE_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+class PerfGate
+{
+public:
+    /**
+     * @brief Measurements of one benchmark case ("BenchClass::function [tag]")
+     */
+    struct Case {
+        QString metric;           // QTest metric, e.g. "WalltimeMilliseconds" (lower is better)
+        QVector<double> samples;  // One value per run, per iteration
+    };
+
+    typedef QMap<QString, Case> Cases;  // Sorted by name, so tables come out in a stable order
+
+    enum Verdict {
+        Unchanged,
+        Regressed,
+        Improved,
+        Added,    // Not in the baseline
+        Missing   // In the baseline, not measured now
+    };
+
+    struct Comparison {
+        QString name;
+        QString metric;
+        int baselineCount;
+        int currentCount;
+        double baselineMedian;
+        double currentMedian;
+        double change;      // currentMedian / baselineMedian - 1 (0.10 = 10% slower)
+        double pSlower;     // One-sided p: current is slower than the baseline
+        double pFaster;     // One-sided p: current is faster
+        Verdict verdict;
+
+        Comparison();
+    };
+
+    /**
+     * @brief Add the results of one benchmarks run (or of a baseline file) to cases
+     *
+     * Reads both the suite's JSON ({"results": [{benchmark, tag, metric, value}]})
+     * and baseline files written by writeBaseline() ({"cases": [{..., samples}]}).
+     *
+     * @param path - JSON file
+     * @param cases - Cases to add the samples to
+     * @param errorString - Optional: reason on failure
+     * @return false if the file can't be read or has neither format
+     */
+    static bool readResults(const QString &path, Cases &cases, QString *errorString = nullptr);
+
+    /**
+     * @brief Write cases as a baseline file
+     * @param path - JSON file
+     * @param cases - Samples to store
+     * @param environment - Extra top-level keys (date, host, runs, ...)
+     */
+    static bool writeBaseline(const QString &path, const Cases &cases, const QJsonObject &environment);
+
+    /**
+     * @brief Read the top-level keys other than the results (date, host, cpuArchitecture, ...)
+     */
+    static QJsonObject readEnvironment(const QString &path);
+
+    /**
+     * @brief Compare current samples with the baseline
+     * @param baseline - Baseline cases
+     * @param current - Cases measured now
+     * @param alpha - Significance level, e.g. 0.05
+     * @param minChange - Smallest median change that counts, e.g. 0.05 for 5%
+     * @return One comparison per case of either side, sorted by name
+     */
+    static QVector<Comparison> compare(const Cases &baseline, const Cases &current, double alpha, double minChange);
+
+    /**
+     * @brief Fixed-width text table, worst regressions first
+     * @param comparisons - Result of compare()
+     * @param onlyChanged - Leave out unchanged cases
+     */
+    static QString formatTable(const QVector<Comparison> &comparisons, bool onlyChanged);
+
+    /**
+     * @brief One-sided Mann-Whitney U test: probability of samples this much larger by chance
+     *
+     * Exact distribution for small samples without ties, otherwise the normal
+     * approximation with tie and continuity correction.
+     *
+     * @param a - First sample
+     * @param b - Second sample
+     * @return p-value for "values of b tend to be larger than values of a" (1.0 if either is empty)
+     */
+    static double mannWhitneyGreater(const QVector<double> &a, const QVector<double> &b);
+
+    /**
+     * @brief Median (mean of the middle two for an even count; 0 if empty)
+     */
+    static double median(QVector<double> values);
+
+    static QString verdictName(Verdict verdict);
+};
+
+#endif // PERFGATE_H
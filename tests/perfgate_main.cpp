@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** @file perfgate_main.cpp
+** @brief Performance regression gate - benchmark runs against a stored baseline
+**
+** Runs the benchmark suite (benchmarks, built by benchmarks.pro into the same
+** directory) several times on its synthetic fixtures, then compares the
+** samples of every case with a baseline using a one-sided Mann-Whitney U
+** test (see perfgate/perfgate.h). Prints a table of regressed, improved, new
+** and missing cases and fails if any case regressed.
+**
+** Usage: perfgate [options] [-- benchmark arguments]
+**   --runs             - Benchmark suite runs (default: 5)
+**   --baseline         - Baseline file (default: perfgate_baseline.json)
+**   --update-baseline  - Store this measurement as the baseline instead of comparing
+**   --alpha            - Significance level (default: 0.05)
+**   --threshold        - Smallest median change that counts, in percent (default: 5)
+**   --benchmarks       - Benchmark executable (default: next to perfgate)
+**   --results          - Compare existing results files instead of running (repeatable)
+**   --all              - Also list unchanged cases
+**   --verbose          - Show the benchmark suite's console output
+** Arguments after "--" go to every benchmark run (class names, QTest options).
+**
+** Exit code: 0 = no regression, 1 = regression, 2 = usage, run or file error
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSysInfo>
+#include <QTemporaryDir>
+
+#include "perfgate/perfgate.h"
+
+namespace {
+
+QString defaultBenchmarksPath()
+{
+#ifdef Q_OS_WIN
+    return QDir(QCoreApplication::applicationDirPath()).filePath("benchmarks.exe");
+#else
+    return QDir(QCoreApplication::applicationDirPath()).filePath("benchmarks");
+#endif
+}
+
+/**
+ * @brief Run the benchmark suite once
+ * @return false if it could not be started, crashed or a benchmark failed
+ */
+bool runSuite(const QString &executable, const QStringList &arguments, const QString &jsonPath, bool verbose)
+{
+    QProcess process;
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    if (!environment.contains("QT_QPA_PLATFORM")) {
+        environment.insert("QT_QPA_PLATFORM", "offscreen");  // No display needed
+    }
+    process.setProcessEnvironment(environment);
+    if (verbose) {
+        process.setProcessChannelMode(QProcess::ForwardedChannels);
+    } else {
+        // Warnings still show; the per-benchmark console output doesn't
+        process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        process.setStandardOutputFile(QProcess::nullDevice());
+    }
+
+    process.start(executable, QStringList(arguments) << "-json" << jsonPath);
+    if (!process.waitForStarted()) {
+        qCritical().noquote() << "Cannot start" << executable << "-" << process.errorString();
+        return false;
+    }
+    process.waitForFinished(-1);
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        qCritical().noquote() << executable << "failed (exit code" << process.exitCode() << ")";
+        return false;
+    }
+    return true;
+}
+
+QJsonObject currentEnvironment(int runs)
+{
+    QJsonObject environment;
+    environment["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    environment["qtVersion"] = QString(qVersion());
+    environment["platform"] = QSysInfo::prettyProductName();
+    environment["cpuArchitecture"] = QSysInfo::currentCpuArchitecture();
+    environment["host"] = QSysInfo::machineHostName();
+    environment["runs"] = runs;
+    return environment;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the benchmark suite and compares it with a baseline");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("runs", "Benchmark suite runs.", "count", "5"));
+    parser.addOption(QCommandLineOption("baseline", "Baseline file.", "file", "perfgate_baseline.json"));
+    parser.addOption(QCommandLineOption("update-baseline", "Store this measurement as the baseline."));
+    parser.addOption(QCommandLineOption("alpha", "Significance level.", "p", "0.05"));
+    parser.addOption(QCommandLineOption("threshold", "Smallest median change that counts, in percent.", "percent", "5"));
+    parser.addOption(QCommandLineOption("benchmarks", "Benchmark executable.", "file", defaultBenchmarksPath()));
+    parser.addOption(QCommandLineOption("results", "Compare existing results files instead of running.", "file"));
+    parser.addOption(QCommandLineOption("all", "Also list unchanged cases."));
+    parser.addOption(QCommandLineOption("verbose", "Show the benchmark suite's console output."));
+    parser.addPositionalArgument("arguments", "Passed to every benchmark run (after --).", "[-- arguments]");
+    parser.process(app);
+
+    const int runs = parser.value("runs").toInt();
+    const double alpha = parser.value("alpha").toDouble();
+    const double minChange = parser.value("threshold").toDouble() / 100.0;
+    if (runs < 1 || alpha <= 0.0 || alpha >= 1.0 || minChange < 0.0) {
+        qCritical() << "Invalid --runs, --alpha or --threshold";
+        return 2;
+    }
+
+    // Measure (or read earlier measurements)
+    PerfGate::Cases current;
+    QString errorString;
+    int measuredRuns = 0;
+    if (parser.isSet("results")) {
+        for (const QString &path : parser.values("results")) {
+            if (!PerfGate::readResults(path, current, &errorString)) {
+                qCritical().noquote() << errorString;
+                return 2;
+            }
+            ++measuredRuns;
+        }
+    } else {
+        const QString executable = parser.value("benchmarks");
+        if (!QFileInfo(executable).isExecutable()) {
+            qCritical().noquote() << "Benchmark executable not found:" << executable << "(build benchmarks.pro first)";
+            return 2;
+        }
+        QTemporaryDir runDir;
+        for (int run = 1; run <= runs; ++run) {
+            qInfo().noquote() << QString("Run %1/%2 ...").arg(run).arg(runs);
+            const QString jsonPath = runDir.filePath(QString("run-%1.json").arg(run));
+            if (!runSuite(executable, parser.positionalArguments(), jsonPath, parser.isSet("verbose"))
+                || !PerfGate::readResults(jsonPath, current, &errorString)) {
+                if (!errorString.isEmpty()) {
+                    qCritical().noquote() << errorString;
+                }
+                return 2;
+            }
+            ++measuredRuns;
+        }
+    }
+    if (current.isEmpty()) {
+        qCritical() << "No benchmark results";
+        return 2;
+    }
+
+    const QString baselinePath = parser.value("baseline");
+    if (parser.isSet("update-baseline")) {
+        if (!PerfGate::writeBaseline(baselinePath, current, currentEnvironment(measuredRuns))) {
+            qCritical().noquote() << "Cannot write" << baselinePath;
+            return 2;
+        }
+        qInfo().noquote() << "Baseline with" << current.size() << "cases written to" << baselinePath;
+        return 0;
+    }
+
+    PerfGate::Cases baseline;
+    if (!PerfGate::readResults(baselinePath, baseline, &errorString)) {
+        qCritical().noquote() << errorString << "- create one with --update-baseline";
+        return 2;
+    }
+    const QJsonObject baselineEnvironment = PerfGate::readEnvironment(baselinePath);
+    if (baselineEnvironment.value("host").toString() != QSysInfo::machineHostName()
+        || baselineEnvironment.value("cpuArchitecture").toString() != QSysInfo::currentCpuArchitecture()) {
+        qWarning().noquote() << "Baseline was measured on" << baselineEnvironment.value("host").toString()
+                             << baselineEnvironment.value("cpuArchitecture").toString()
+                             << "- timings from another machine are not comparable";
+    }
+
+    const QVector<PerfGate::Comparison> comparisons = PerfGate::compare(baseline, current, alpha, minChange);
+    int regressed = 0;
+    int improved = 0;
+    for (const PerfGate::Comparison &comparison : comparisons) {
+        regressed += comparison.verdict == PerfGate::Regressed ? 1 : 0;
+        improved += comparison.verdict == PerfGate::Improved ? 1 : 0;
+    }
+
+    const QString table = PerfGate::formatTable(comparisons, !parser.isSet("all"));
+    if (table.count('\n') > 1) {
+        qInfo().noquote() << "\n" + table + "\n";
+    }
+    qInfo().noquote() << QString("%1 cases, %2 regressed, %3 improved (Mann-Whitney U, alpha %4, threshold %5%, baseline %6)")
+                             .arg(comparisons.size()).arg(regressed).arg(improved)
+                             .arg(alpha).arg(minChange * 100.0).arg(baselineEnvironment.value("date").toString());
+
+    return regressed > 0 ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+#include "scrubreplay.h"
+#include "../src/framering.h"
+#include "../src/framesetpresenter.h"
+#include "../src/playbackengine.h"
+#include "../src/metricsregistry.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+ScrubReplay::Result::Result()
+    : steps(0)
+    , presented(0)
+    , dropped(0)
+    , torn(0)
+    , stalls(0)
+    , durationMs(0)
+    , peakRingBytes(0)
+    , peakRssBytes(-1)
+{
+}
+
+double ScrubReplay::Result::percentileMs(double fraction) const
+{
+    if (latenciesMs.isEmpty()) {
+        return -1.0;
+    }
+    const int rank = std::min(latenciesMs.size() - 1,
+                              std::max(0, static_cast<int>(std::ceil(fraction * latenciesMs.size())) - 1));
+    return latenciesMs.at(rank);
+}
+
+ScrubReplay::ScrubReplay(ImageLoaderManager *manager, QObject *parent)
+    : QObject(parent)
+    , m_manager(manager)
+    , m_speed(1.0)
+    , m_maxWaitMs(-1)
+    , m_stallMs(50.0)  // 3 display frames at 60 Hz
+    , m_ringCapacity(-1)
+{
+}
+
+ScrubReplay::Result ScrubReplay::run(const QVector<ScrubTrace::Step> &steps)
+{
+    Result result;
+    result.steps = steps.size();
+    if (steps.isEmpty()) {
+        return result;
+    }
+
+    // Same objects and wiring as main.cpp
+    PlaybackEngine playbackEngine;
+    playbackEngine.setImageLoaderManager(m_manager);
+    FrameSetPresenter presenter(playbackEngine.frameRing());
+    if (m_maxWaitMs >= 0) {
+        presenter.setMaxWaitMs(m_maxWaitMs);
+    }
+    if (m_ringCapacity > 0) {
+        playbackEngine.frameRing()->setCapacity(m_ringCapacity);
+    }
+    MetricsRegistry::setGauge(MetricsRegistry::FrameRingBytes, 0);
+
+    QEventLoop loop;
+    QElapsedTimer clock;
+    QTimer stepTimer;
+    stepTimer.setSingleShot(true);
+    stepTimer.setTimerType(Qt::PreciseTimer);
+    int nextStep = 0;
+    qint64 requestNs = 0;  // When the newest request was issued
+    int tornSoFar = 0;
+
+    auto samplePeak = [&result]() {
+        result.peakRingBytes = qMax(result.peakRingBytes, MetricsRegistry::gaugeValue(MetricsRegistry::FrameRingBytes));
+    };
+
+    // The presenter only ever presents the newest request, so each frame set belongs to it
+    connect(&presenter, &FrameSetPresenter::frameSetReady, &loop, [&](int) {
+        const double latencyMs = (clock.nsecsElapsed() - requestNs) / 1e6;
+        ++result.presented;
+        if (presenter.tornFrameSets() != tornSoFar) {
+            tornSoFar = presenter.tornFrameSets();
+            ++result.torn;
+            ++result.stalls;
+        } else {
+            result.latenciesMs.append(latencyMs);
+            if (latencyMs > m_stallMs) {
+                ++result.stalls;
+            }
+        }
+        samplePeak();
+        if (nextStep >= steps.size()) {
+            loop.quit();
+        }
+    });
+    connect(playbackEngine.frameRing(), &FrameRing::frameDecoded, &loop, samplePeak, Qt::QueuedConnection);
+
+    // Issue each request at its recorded time (relative to the first one)
+    const qint64 firstTimeMs = steps.first().timeMs;
+    connect(&stepTimer, &QTimer::timeout, &loop, [&]() {
+        const ScrubTrace::Step &step = steps.at(nextStep++);
+        requestNs = clock.nsecsElapsed();
+        presenter.requestFrame(step.frame, step.imageTypes);
+        if (nextStep < steps.size()) {
+            const qint64 dueMs = static_cast<qint64>((steps.at(nextStep).timeMs - firstTimeMs) / m_speed);
+            stepTimer.start(static_cast<int>(qMax<qint64>(0, dueMs - clock.elapsed())));
+        }
+    });
+
+    resetPeakResident();
+    clock.start();
+    stepTimer.start(0);
+    loop.exec();
+
+    result.durationMs = clock.elapsed();
+    result.dropped = presenter.droppedFrameSets();
+    result.peakRssBytes = peakResidentBytes();
+    std::sort(result.latenciesMs.begin(), result.latenciesMs.end());
+    return result;
+}
+
+QVector<ScrubTrace::Step> ScrubReplay::synthesize(const QString &pattern, int frameCount, qint64 durationMs,
+                                                  const QStringList &imageTypes, quint32 seed)
+{
+    QVector<ScrubTrace::Step> steps;
+    if (frameCount < 1 || durationMs <= 0) {
+        return steps;
+    }
+    QRandomGenerator random(seed);
+
+    if (pattern == "drag") {
+        // Mouse moves at 60 Hz; the hand speeds up and slows down every half second
+        double position = 1.0;
+        int direction = 1;
+        double framesPerSecond = 0.0;
+        for (qint64 timeMs = 0, event = 0; timeMs <= durationMs; timeMs += 16, ++event) {
+            if (event % 30 == 0) {
+                framesPerSecond = frameCount * (0.2 + 1.8 * random.generateDouble());
+            }
+            position += direction * framesPerSecond * 0.016;
+            if (position >= frameCount) {
+                position = frameCount;
+                direction = -1;
+            } else if (position <= 1.0) {
+                position = 1.0;
+                direction = 1;
+            }
+            // The slider only reports value changes
+            const int frame = qRound(position);
+            if (steps.isEmpty() || steps.last().frame != frame) {
+                steps.append({timeMs, frame, imageTypes});
+            }
+        }
+    } else if (pattern == "jump") {
+        for (qint64 timeMs = 0; timeMs <= durationMs; timeMs += 150 + random.bounded(350)) {
+            steps.append({timeMs, 1 + random.bounded(frameCount), imageTypes});
+        }
+    } else if (pattern == "step") {
+        // Arrow key held down: ~30 Hz key repeat, turning around at either end
+        int frame = 1;
+        int direction = 1;
+        for (qint64 timeMs = 0; timeMs <= durationMs; timeMs += 33) {
+            steps.append({timeMs, frame, imageTypes});
+            if (frame + direction < 1 || frame + direction > frameCount) {
+                direction = -direction;
+            }
+            frame = qBound(1, frame + direction, frameCount);
+        }
+    }
+    return steps;
+}
+
+void ScrubReplay::resetPeakResident()
+{
+#if defined(Q_OS_LINUX)
+    // "5" resets VmHWM to the current resident size (Linux 4.0+)
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+#endif
+}
+
+qint64 ScrubReplay::peakResidentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!status.atEnd()) {
+            const QByteArray line = status.readLine();
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;  // "VmHWM:  123456 kB"
+            }
+        }
+    }
+    return -1;
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<qint64>(usage.ru_maxrss);  // Bytes on macOS
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** @file scrubreplay.h
+** @brief Replays a scrub trace through the real decode and presentation pipeline
+**
+** Drives ImageLoaderManager, the PlaybackEngine's FrameRing and FrameSetPresenter
+** exactly as the timeline does while scrubbing, with the requests of a recorded
+** (or synthetic) ScrubTrace issued at their original times, and measures:
+** - Latency from each request until its frame set was presented complete
+** - Dropped (overtaken) and torn (incomplete) frame sets, and stalls
+** - Peak decoded-frame memory and peak process memory
+**
+****************************************************************************/
+
+#ifndef SCRUBREPLAY_H
+#define SCRUBREPLAY_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "../src/scrubtrace.h"
+
+// Forward declaration
+class ImageLoaderManager;
+
+class ScrubReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result {
+        int steps;             // Requests replayed
+        int presented;         // Frame sets presented (complete or torn)
+        int dropped;           // Requests overtaken by a newer one before they were presented
+        int torn;              // Frame sets presented incomplete (decode failed or took over maxWaitMs)
+        int stalls;            // Torn, or complete but slower than stallMs
+        QVector<double> latenciesMs;  // Request to complete frame set, sorted ascending
+        qint64 durationMs;     // Wall time of the replay
+        qint64 peakRingBytes;  // Most decoded-frame memory held by the FrameRing
+        qint64 peakRssBytes;   // Peak resident memory of the process (-1 = unknown)
+
+        Result();
+
+        /**
+         * @brief Nearest-rank percentile of the latencies
+         * @param fraction - 0.0 .. 1.0
+         * @return Latency in ms, or -1 if no frame set was presented complete
+         */
+        double percentileMs(double fraction) const;
+    };
+
+    /**
+     * @param manager - Resolves image paths (not owned, image paths must be set)
+     */
+    explicit ScrubReplay(ImageLoaderManager *manager, QObject *parent = nullptr);
+
+    /**
+     * @brief Replay speed (2.0 = requests twice as fast as recorded)
+     */
+    void setSpeed(double speed) { m_speed = speed; }
+
+    /**
+     * @brief Presenter wait for a complete frame set (FrameSetPresenter::maxWaitMs); -1 = app default
+     */
+    void setMaxWaitMs(int ms) { m_maxWaitMs = ms; }
+
+    /**
+     * @brief Latency above which a complete frame set counts as a stall
+     */
+    void setStallMs(double ms) { m_stallMs = ms; }
+
+    /**
+     * @brief FrameRing capacity in images; -1 = as in the app
+     */
+    void setRingCapacity(int images) { m_ringCapacity = images; }
+
+    /**
+     * @brief Replay a trace (blocks, running an event loop, until the last request is presented)
+     * @param steps - Requests in time order
+     * @return Measurements
+     */
+    Result run(const QVector<ScrubTrace::Step> &steps);
+
+    /**
+     * @brief Generate a synthetic trace
+     * @param pattern - "drag" (slider dragged back and forth at 60 Hz), "jump" (clicks on
+     *                  random frames) or "step" (arrow key held down, 1 frame per key repeat)
+     * @param frameCount - Frames 1..frameCount
+     * @param durationMs - Trace length
+     * @param imageTypes - Visible panes, e.g. {"A", "B", "D"}
+     * @param seed - Random seed (same seed = same trace)
+     * @return Requests, empty for an unknown pattern
+     */
+    static QVector<ScrubTrace::Step> synthesize(const QString &pattern, int frameCount, qint64 durationMs,
+                                                const QStringList &imageTypes, quint32 seed);
+
+    /**
+     * @brief Reset the process' peak resident memory counter where the OS allows it (Linux)
+     */
+    static void resetPeakResident();
+
+    /**
+     * @brief Peak resident memory of the process
+     * @return Bytes, or -1 if unknown on this platform
+     */
+    static qint64 peakResidentBytes();
+
+private:
+    ImageLoaderManager *m_manager;
+    double m_speed;
+    int m_maxWaitMs;
+    double m_stallMs;
+    int m_ringCapacity;
+};
+
+#endif // SCRUBREPLAY_H
@@ -0,0 +1,42 @@
+###############################################################################
+# Render Compare - Results Tree Generator
+# Writes synthetic testSets_results trees for load testing
+###############################################################################
+
+TEMPLATE = app
+TARGET = resultsgen
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+# Image encoding dominates; build optimized
+CONFIG -= debug
+CONFIG += release
+
+QT += core
+QT += gui  # QImage, QPainter (no window is opened)
+QT += concurrent
+
+# Application version (same as main project)
+VERSION = 1.0.0
+
+INCLUDEPATH += .
+INCLUDEPATH += resultsgen
+
+# Generator
+SOURCES += resultsgen_main.cpp \
+           resultsgen/resultsgen.cpp
+HEADERS += resultsgen/resultsgen.h
+
+# Output directory
+DESTDIR = $$PWD/../bin
+OBJECTS_DIR = $$PWD/../build/resultsgen
+MOC_DIR = $$PWD/../build/resultsgen
+RCC_DIR = $$PWD/../build/resultsgen
+
+CONFIG += warn_on
+
+# Create build directory if it doesn't exist
+!exists($$OBJECTS_DIR) {
+    system(mkdir -p $$OBJECTS_DIR)
+}
@@ -0,0 +1,552 @@
+#include "resultsgen.h"
+
+#include <QAtomicInteger>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QXmlStreamWriter>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+const char *const kSports[] = { "NFL", "NBA", "MLB", "NHL", "Soccer" };
+const int kSportCount = 5;
+const int kMaxEntriesPerEvent = 98;  // F#### folder numbers stay unique and four digits
+const int kBimodalBrokenPercent = 15;
+const QSize kThumbnailSize(160, 90);
+const int kProgressIntervalMs = 200;
+
+int entriesPerEvent(const ResultsGenerator::Options &options)
+{
+    return qBound(1, options.entriesPerEvent, kMaxEntriesPerEvent);
+}
+
+/**
+ * @brief Generator for one purpose (salt) of one entry and version
+ *
+ * Seeding by (seed, entry, version, salt) keeps every value independent of the
+ * order in which worker threads handle the entries.
+ */
+QRandomGenerator entryRandom(const ResultsGenerator::Options &options, int entryIndex, int versionIndex, quint32 salt)
+{
+    const quint32 seeds[] = { options.seed, static_cast<quint32>(entryIndex), static_cast<quint32>(versionIndex), salt };
+    return QRandomGenerator(seeds, 4);
+}
+
+QString origVersionName()
+{
+    return "freedview_1.3.0.0_1.0.0.0";
+}
+
+QString testVersionName(int versionIndex)
+{
+    return QString("freedview_1.3.%1.0_1.0.0.%1").arg(versionIndex + 1);
+}
+
+QString frameFileName(int frame, const char *extension)
+{
+    return QString("%1.%2").arg(frame, 4, 10, QChar('0')).arg(extension);
+}
+
+bool ensureDir(const QString &path, QString *errorString)
+{
+    if (QDir().mkpath(path)) {
+        return true;
+    }
+    *errorString = "Cannot create " + path;
+    return false;
+}
+
+/**
+ * @brief The entry's scene: gradient plus a fixed noise texture (flat colours would make encoding unrealistically cheap)
+ */
+QImage makeScene(const QSize &size, int entryIndex, const ResultsGenerator::Options &options)
+{
+    QRandomGenerator random = entryRandom(options, entryIndex, 0, 0x5343u);
+    QImage image(size, QImage::Format_RGB32);
+    QPainter painter(&image);
+    QLinearGradient gradient(0, 0, size.width(), size.height());
+    gradient.setColorAt(0.0, QColor(20 + random.bounded(40), 70 + random.bounded(60), 30 + random.bounded(40)));
+    gradient.setColorAt(1.0, QColor(140 + random.bounded(60), 150 + random.bounded(60), 100 + random.bounded(60)));
+    painter.fillRect(image.rect(), gradient);
+    painter.end();
+
+    quint32 state = random.generate() | 1u;
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            // xorshift32: per-pixel QRandomGenerator calls would dominate at 4K
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            const int noise = static_cast<int>(state & 15u) - 8;
+            const QRgb pixel = line[x];
+            line[x] = qRgb(qBound(0, qRed(pixel) + noise, 255), qBound(0, qGreen(pixel) + noise, 255),
+                           qBound(0, qBlue(pixel) + noise, 255));
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Shared state of one image sequence set (all four channels of one entry and version)
+ */
+struct SequenceJob {
+    QString sourceDir;
+    QString testDir;
+    QString diffDir;
+    QString alphaDir;
+    QImage scene;
+    QVector<float> values;
+    int jpegQuality;
+};
+
+/**
+ * @brief Write frame N of all four channels
+ *
+ * The subject moves across the scene; in the test render it is displaced by
+ * (1 - value), and the difference image brightens by the same amount.
+ */
+bool writeFrame(const SequenceJob &job, int frame, qint64 &bytes)
+{
+    const QSize size = job.scene.size();
+    const double value = job.values.at(frame - 1);
+    const int step = qMax(1, size.width() / 50);
+    const QPoint sourceCenter((frame * step) % size.width(), size.height() / 2);
+    const QPoint testCenter(sourceCenter.x() + static_cast<int>((1.0 - value) * size.width() * 0.5), sourceCenter.y());
+    const int rx = qMax(1, size.width() / 12);
+    const int ry = qMax(1, size.height() / 8);
+
+    QImage source = job.scene.copy();
+    QImage test = job.scene.copy();
+    QImage diff(size, QImage::Format_RGB32);
+    diff.fill(Qt::black);
+    QImage alpha(size, QImage::Format_ARGB32);
+    alpha.fill(Qt::transparent);
+
+    QPainter painter;
+    painter.begin(&source);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(220, 60, 40));
+    painter.drawEllipse(sourceCenter, rx, ry);
+    painter.end();
+
+    painter.begin(&test);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(220, 60, 40));
+    painter.drawEllipse(testCenter, rx, ry);
+    painter.end();
+
+    const int level = qBound(0, static_cast<int>((1.0 - value) * 2000.0), 255);
+    painter.begin(&diff);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(level, level, level));
+    painter.drawEllipse(sourceCenter, rx, ry);
+    painter.drawEllipse(testCenter, rx, ry);
+    painter.end();
+
+    painter.begin(&alpha);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::white);
+    painter.drawEllipse(sourceCenter, rx, ry);
+    painter.end();
+
+    const QString paths[] = {
+        job.sourceDir + frameFileName(frame, "jpg"),
+        job.testDir + frameFileName(frame, "jpg"),
+        job.diffDir + frameFileName(frame, "jpg"),
+        job.alphaDir + frameFileName(frame, "png")
+    };
+    if (!source.save(paths[0], "JPG", job.jpegQuality)
+        || !test.save(paths[1], "JPG", job.jpegQuality)
+        || !diff.save(paths[2], "JPG", job.jpegQuality)
+        || !alpha.save(paths[3], "PNG")) {
+        return false;
+    }
+    for (const QString &path : paths) {
+        bytes += QFileInfo(path).size();
+    }
+    return true;
+}
+
+bool writeCompareResult(const QString &xmlPath, const QString &testKey, const QString &version,
+                        const QVector<float> &values)
+{
+    QFile file(xmlPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    const QString orig = version.section("_VS_", 0, 0);
+    const QString test = version.section("_VS_", 1);
+    const QString versionFolder = testKey + "/" + version + "/";
+
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("compareResult");
+    xml.writeTextElement("startFrame", "1");
+    xml.writeTextElement("endFrame", QString::number(values.size()));
+    xml.writeTextElement("minVal", "0");
+    xml.writeTextElement("maxVal", "1");
+    // Relative to the results root, like freeDView_tester writes them
+    xml.writeTextElement("sourcePath", versionFolder + orig + "/");
+    xml.writeTextElement("testPath", versionFolder + test + "/");
+    xml.writeTextElement("diffPath", versionFolder + "diff/");
+    xml.writeTextElement("alphaPath", versionFolder + "alpha/");
+    xml.writeTextElement("origFreeDView", orig);
+    xml.writeTextElement("testFreedview", test);
+    xml.writeStartElement("frames");
+    for (int i = 0; i < values.size(); ++i) {
+        xml.writeStartElement("frame");
+        xml.writeTextElement("frameIndex", QString::number(i + 1));
+        xml.writeTextElement("value", QString::number(values.at(i), 'f', 6));
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();  // frames
+    xml.writeEndElement();  // compareResult
+    xml.writeEndDocument();
+    return !xml.hasError() && file.error() == QFileDevice::NoError;
+}
+
+/**
+ * @brief What uiData.xml needs to know about a written entry
+ */
+struct EntryResult {
+    int entryIndex = 0;
+    bool ok = false;
+    QString thumbnailPath;
+    int numFramesUnderMin = 0;
+    int compareResults = 0;
+    qint64 bytes = 0;
+    QString errorString;
+};
+
+EntryResult writeEntry(const QString &rootPath, int entryIndex, const ResultsGenerator::Options &options,
+                       const QStringList &versions)
+{
+    EntryResult result;
+    result.entryIndex = entryIndex;
+    const QDir root(rootPath);
+    const QString key = ResultsGenerator::testKey(entryIndex, options);
+
+    if (!ResultsGenerator::isReady(entryIndex, options)) {
+        // Not Ready: only the folder, which is also the thumbnail path
+        result.thumbnailPath = key;
+        result.ok = ensureDir(root.absoluteFilePath(key), &result.errorString);
+        return result;
+    }
+
+    for (int v = 0; v < versions.size(); ++v) {
+        const QString resultsDir = root.absoluteFilePath(key + "/" + versions.at(v) + "/results");
+        if (!ensureDir(resultsDir, &result.errorString)) {
+            return result;
+        }
+        const QVector<float> values = ResultsGenerator::frameValues(entryIndex, v, options);
+        const QString xmlPath = resultsDir + "/compareResult.xml";
+        if (!writeCompareResult(xmlPath, key, versions.at(v), values)) {
+            result.errorString = "Cannot write " + xmlPath;
+            return result;
+        }
+        result.bytes += QFileInfo(xmlPath).size();
+        ++result.compareResults;
+
+        if (v == versions.size() - 1) {
+            // The table shows the newest comparison
+            result.numFramesUnderMin = static_cast<int>(std::count_if(values.cbegin(), values.cend(),
+                [&options](float value) { return value < options.minValue; }));
+        }
+    }
+
+    result.thumbnailPath = key + "/" + versions.first() + "/" + origVersionName() + "/thumbnail.jpg";
+    const QString thumbnailFile = root.absoluteFilePath(result.thumbnailPath);
+    if (!ensureDir(QFileInfo(thumbnailFile).absolutePath(), &result.errorString)) {
+        return result;
+    }
+    if (!makeScene(kThumbnailSize, entryIndex, options).save(thumbnailFile, "JPG", options.jpegQuality)) {
+        result.errorString = "Cannot write " + thumbnailFile;
+        return result;
+    }
+    result.bytes += QFileInfo(thumbnailFile).size();
+    result.ok = true;
+    return result;
+}
+
+bool writeUiData(const QString &rootPath, const ResultsGenerator::Options &options, const QStringList &versions,
+                 const QVector<EntryResult> &entries)
+{
+    QFile file(QDir(rootPath).absoluteFilePath("uiData.xml"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("uiData");
+    xml.writeStartElement("renderVersions");
+    for (const QString &version : versions) {
+        xml.writeTextElement("version", version);
+    }
+    xml.writeEndElement();
+    xml.writeStartElement("entries");
+    for (int i = 0; i < entries.size(); ++i) {
+        const bool ready = ResultsGenerator::isReady(i, options);
+        const QStringList parts = ResultsGenerator::testKey(i, options).split('/');
+        xml.writeStartElement("entry");
+        xml.writeTextElement("id", QString::number(i + 1));
+        xml.writeTextElement("eventName", ResultsGenerator::eventName(i, options));
+        xml.writeTextElement("sportType", parts.at(0));
+        xml.writeTextElement("stadiumName", parts.at(1));
+        xml.writeTextElement("categoryName", QString("Category%1").arg(i / entriesPerEvent(options) % 7 + 1));
+        xml.writeTextElement("numberOfFrames", QString::number(options.frameCount));
+        xml.writeTextElement("minValue", QString::number(options.minValue));
+        xml.writeTextElement("numFramesUnderMin", QString::number(entries.at(i).numFramesUnderMin));
+        xml.writeTextElement("thumbnailPath", entries.at(i).thumbnailPath);
+        xml.writeTextElement("status", ready ? "Ready" : "Not Ready");
+        xml.writeTextElement("notes", QString());
+        xml.writeTextElement("renderVersions", ready ? versions.join(",") : QString());
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();  // entries
+    xml.writeEndElement();  // uiData
+    xml.writeEndDocument();
+    return !xml.hasError() && file.error() == QFileDevice::NoError;
+}
+
+/**
+ * @brief Wait for a future, reporting progress from this thread
+ */
+template <typename T>
+void waitWithProgress(QFuture<T> &future, const std::function<void()> &report)
+{
+    while (!future.isFinished()) {
+        if (report) {
+            report();
+        }
+        QThread::msleep(kProgressIntervalMs);
+    }
+    future.waitForFinished();
+}
+
+} // namespace
+
+QString ResultsGenerator::testKey(int entryIndex, const Options &options)
+{
+    const int perEvent = entriesPerEvent(options);
+    const int event = entryIndex / perEvent;
+    const int slot = entryIndex % perEvent;
+    const QString sport = kSports[event % kSportCount];
+    const QString stadium = QString("%1_Stadium%2").arg(sport).arg(event / kSportCount % 8 + 1, 2, 10, QChar('0'));
+    const QString set = QString("Set%1").arg(slot / 2 + 1);
+    // Frame folders are named after the set's start frame
+    const QString frameFolder = QString("F%1").arg((slot + 1) * 100 + event % 100, 4, 10, QChar('0'));
+    return sport + "/" + stadium + "/" + eventName(entryIndex, options) + "/" + set + "/" + frameFolder;
+}
+
+QString ResultsGenerator::eventName(int entryIndex, const Options &options)
+{
+    return QString("Event%1").arg(entryIndex / entriesPerEvent(options) + 1, 5, 10, QChar('0'));
+}
+
+QStringList ResultsGenerator::versionNames(const Options &options)
+{
+    QStringList versions;
+    for (int v = 0; v < qMax(1, options.versionCount); ++v) {
+        versions.append(origVersionName() + "_VS_" + testVersionName(v));
+    }
+    return versions;
+}
+
+bool ResultsGenerator::isReady(int entryIndex, const Options &options)
+{
+    return static_cast<int>(entryRandom(options, entryIndex, 0, 0x4e52u).bounded(100)) >= options.notReadyPercent;
+}
+
+QVector<float> ResultsGenerator::frameValues(int entryIndex, int versionIndex, const Options &options)
+{
+    QRandomGenerator random = entryRandom(options, entryIndex, versionIndex, 0x5641u);
+    const int frameCount = qMax(0, options.frameCount);
+    const int versionCount = qMax(1, options.versionCount);
+    QVector<float> values(frameCount);
+
+    switch (options.distribution) {
+    case Clean:
+        for (float &value : values) {
+            value = static_cast<float>(0.985 + random.generateDouble() * 0.015);
+        }
+        break;
+    case Dips: {
+        int badFrames = 0;
+        for (float &value : values) {
+            if (badFrames == 0 && random.bounded(200) == 0) {
+                badFrames = 5 + random.bounded(36);
+            }
+            value = badFrames > 0 ? static_cast<float>(0.7 + random.generateDouble() * 0.25)
+                                  : static_cast<float>(0.97 + random.generateDouble() * 0.03);
+            badFrames = qMax(0, badFrames - 1);
+        }
+        break;
+    }
+    case Drift: {
+        const double depth = 0.06 * (versionIndex + 1) / versionCount;
+        for (int i = 0; i < frameCount; ++i) {
+            const double progress = frameCount > 1 ? static_cast<double>(i) / (frameCount - 1) : 0.0;
+            values[i] = static_cast<float>(1.0 - depth * progress - random.generateDouble() * 0.01);
+        }
+        break;
+    }
+    case Bimodal: {
+        const bool broken = versionIndex == versionCount - 1
+                            && static_cast<int>(entryRandom(options, entryIndex, 0, 0x424du).bounded(100)) < kBimodalBrokenPercent;
+        for (float &value : values) {
+            value = broken ? static_cast<float>(0.6 + random.generateDouble() * 0.25)
+                           : static_cast<float>(0.985 + random.generateDouble() * 0.015);
+        }
+        break;
+    }
+    }
+    return values;
+}
+
+ResultsGenerator::Distribution ResultsGenerator::distributionFromName(const QString &name, bool *ok)
+{
+    const QString lower = name.toLower();
+    if (ok) {
+        *ok = true;
+    }
+    if (lower == "clean") {
+        return Clean;
+    }
+    if (lower == "dips") {
+        return Dips;
+    }
+    if (lower == "drift") {
+        return Drift;
+    }
+    if (lower == "bimodal") {
+        return Bimodal;
+    }
+    if (ok) {
+        *ok = false;
+    }
+    return Dips;
+}
+
+bool ResultsGenerator::generate(const QString &rootPath, const Options &options, Stats *stats,
+                                const ProgressFunction &progress, QString *errorString)
+{
+    QString error;
+    auto fail = [errorString](const QString &message) {
+        if (errorString) {
+            *errorString = message;
+        }
+        return false;
+    };
+    if (options.entryCount < 0 || options.frameCount < 1 || options.imageSize.isEmpty()) {
+        return fail("Invalid entry count, frame count or image size");
+    }
+    if (!ensureDir(rootPath, &error)) {
+        return fail(error);
+    }
+
+    const QStringList versions = versionNames(options);
+    const int imageEntryLimit = options.imageEntries > 0 ? qMin(options.imageEntries, options.entryCount)
+                                                         : options.entryCount;
+    QVector<int> imageEntries;
+    if (options.images) {
+        for (int i = 0; i < imageEntryLimit; ++i) {
+            if (isReady(i, options)) {
+                imageEntries.append(i);
+            }
+        }
+    }
+
+    // Work units: one per entry, one per image
+    const qint64 total = options.entryCount + static_cast<qint64>(imageEntries.size()) * versions.size() * options.frameCount * 4;
+    QAtomicInteger<qint64> done(0);
+    QAtomicInteger<qint64> bytes(0);
+    auto report = [&]() {
+        if (progress) {
+            progress(done.loadAcquire(), total, bytes.loadAcquire());
+        }
+    };
+
+    // compareResult.xml files and thumbnails, one entry per task
+    QVector<EntryResult> entries(options.entryCount);
+    for (int i = 0; i < entries.size(); ++i) {
+        entries[i].entryIndex = i;
+    }
+    QFuture<void> entryFuture = QtConcurrent::map(entries, [&](EntryResult &entry) {
+        entry = writeEntry(rootPath, entry.entryIndex, options, versions);
+        bytes.fetchAndAddRelaxed(entry.bytes);
+        done.fetchAndAddRelaxed(1);
+    });
+    waitWithProgress(entryFuture, report);
+
+    Stats written;
+    for (const EntryResult &entry : entries) {
+        if (!entry.ok) {
+            return fail(entry.errorString);
+        }
+        written.compareResults += entry.compareResults;
+    }
+    if (!writeUiData(rootPath, options, versions, entries)) {
+        return fail("Cannot write " + QDir(rootPath).absoluteFilePath("uiData.xml"));
+    }
+    written.entries = entries.size();
+    bytes.fetchAndAddRelaxed(QFileInfo(QDir(rootPath).absoluteFilePath("uiData.xml")).size());
+
+    // Image sequences: one set of four channels at a time, frames in parallel
+    const QDir root(rootPath);
+    QVector<int> frames(options.frameCount);
+    for (int i = 0; i < frames.size(); ++i) {
+        frames[i] = i + 1;
+    }
+    for (int entryIndex : imageEntries) {
+        const QImage scene = makeScene(options.imageSize, entryIndex, options);
+        const QString key = testKey(entryIndex, options);
+        for (int v = 0; v < versions.size(); ++v) {
+            SequenceJob job;
+            const QString versionDir = root.absoluteFilePath(key + "/" + versions.at(v)) + "/";
+            job.sourceDir = versionDir + origVersionName() + "/";
+            job.testDir = versionDir + testVersionName(v) + "/";
+            job.diffDir = versionDir + "diff/";
+            job.alphaDir = versionDir + "alpha/";
+            job.scene = scene;
+            job.values = frameValues(entryIndex, v, options);
+            job.jpegQuality = options.jpegQuality;
+            for (const QString &dir : { job.sourceDir, job.testDir, job.diffDir, job.alphaDir }) {
+                if (!ensureDir(dir, &error)) {
+                    return fail(error);
+                }
+            }
+
+            QAtomicInteger<int> failedFrame(0);
+            QFuture<void> frameFuture = QtConcurrent::map(frames, [&](int frame) {
+                qint64 frameBytes = 0;
+                if (!writeFrame(job, frame, frameBytes)) {
+                    failedFrame.testAndSetRelaxed(0, frame);
+                }
+                bytes.fetchAndAddRelaxed(frameBytes);
+                done.fetchAndAddRelaxed(4);
+            });
+            waitWithProgress(frameFuture, report);
+            if (failedFrame.loadAcquire() != 0) {
+                return fail(QString("Cannot write frame %1 of %2").arg(failedFrame.loadAcquire()).arg(versionDir));
+            }
+            written.images += static_cast<qint64>(options.frameCount) * 4;
+        }
+    }
+
+    report();
+    written.bytes = bytes.loadAcquire();
+    if (stats) {
+        *stats = written;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** @file resultsgen.h
+** @brief Synthetic testSets_results trees at production scale
+**
+** Writes a complete results tree in the layout freeDView_tester produces and
+** the application reads:
+**
+**   <root>/uiData.xml
+**   <root>/<Sport>/<Stadium>/<Event>/<Set>/F####/                 (test key)
+**       <orig>_VS_<test>/results/compareResult.xml               (per render version)
+**       <orig>_VS_<test>/<orig>/####.jpg                         (A - source)
+**       <orig>_VS_<test>/<test>/####.jpg                         (B - test)
+**       <orig>_VS_<test>/diff/####.jpg                           (C - difference)
+**       <orig>_VS_<test>/alpha/####.png                          (D - alpha)
+**
+** Frame values follow a configurable distribution and drive the images (the
+** test render drifts and the difference brightens as the value drops), so the
+** table, statistics, version comparison and viewer all see consistent data.
+** Everything is derived from a seed: the same options give the same tree.
+** Images are encoded on the global thread pool.
+**
+****************************************************************************/
+
+#ifndef RESULTSGEN_H
+#define RESULTSGEN_H
+
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+class ResultsGenerator
+{
+public:
+    /**
+     * @brief Shape of the per-frame compare values
+     */
+    enum Distribution {
+        Clean,    // Every frame near-identical (0.985 - 1.0)
+        Dips,     // Near-identical with occasional runs of bad frames
+        Drift,    // Quality drops over the sequence, more in newer versions
+        Bimodal   // Mostly clean, some events broken in the newest version
+    };
+
+    struct Options {
+        int entryCount = 100;          // Table rows (F#### folders)
+        int entriesPerEvent = 4;       // F#### folders per event (two per set)
+        int frameCount = 1000;         // Frames per sequence
+        int versionCount = 2;          // Render versions (<orig>_VS_<test> folders) per entry
+        Distribution distribution = Dips;
+        double minValue = 0.95;        // uiData.xml minValue; numFramesUnderMin counts frames below it
+        int notReadyPercent = 5;       // Entries without results (thumbnail path is the folder)
+        bool images = false;           // Write A/B/C/D image sequences
+        int imageEntries = 0;          // Entries that get images (0 = all)
+        QSize imageSize = QSize(1920, 1080);
+        int jpegQuality = 90;
+        quint32 seed = 1;
+    };
+
+    struct Stats {
+        int entries = 0;
+        int compareResults = 0;
+        qint64 images = 0;
+        qint64 bytes = 0;
+    };
+
+    /**
+     * @brief Progress callback: done and total work units (one per entry and per image)
+     *
+     * Called from the calling thread only.
+     */
+    typedef std::function<void(qint64 done, qint64 total, qint64 bytes)> ProgressFunction;
+
+    /**
+     * @brief Write the tree
+     * @param rootPath - testSets_results root (created if needed; existing files are overwritten)
+     * @param options - Counts, resolution, distribution and seed
+     * @param stats - Optional: what was written
+     * @param progress - Optional: called regularly while writing
+     * @param errorString - Optional: reason on failure
+     * @return true on success
+     */
+    static bool generate(const QString &rootPath, const Options &options, Stats *stats = nullptr,
+                         const ProgressFunction &progress = ProgressFunction(),
+                         QString *errorString = nullptr);
+
+    /**
+     * @brief Test key of an entry (SportType/Stadium/Event/Set/F####)
+     */
+    static QString testKey(int entryIndex, const Options &options);
+
+    /**
+     * @brief Event name of an entry (the event folder)
+     */
+    static QString eventName(int entryIndex, const Options &options);
+
+    /**
+     * @brief Render version folder names, oldest first
+     */
+    static QStringList versionNames(const Options &options);
+
+    /**
+     * @brief Whether an entry is written as Not Ready (no results)
+     */
+    static bool isReady(int entryIndex, const Options &options);
+
+    /**
+     * @brief Compare values of an entry for one render version (frames 1..frameCount)
+     */
+    static QVector<float> frameValues(int entryIndex, int versionIndex, const Options &options);
+
+    /**
+     * @brief Parse a distribution name (clean, dips, drift, bimodal)
+     * @param ok - Optional: false if the name is unknown
+     */
+    static Distribution distributionFromName(const QString &name, bool *ok = nullptr);
+};
+
+#endif // RESULTSGEN_H
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** @file resultsgen_main.cpp
+** @brief Synthetic results tree generator for load testing
+**
+** Writes a testSets_results tree at production scale (see
+** resultsgen/resultsgen.h for the layout): uiData.xml, a compareResult.xml per
+** entry and render version and, optionally, A/B/C/D image sequences. Point
+** renderCompare.ini's setTestPath at the output to load test the
+** application.
+**
+** Usage: resultsgen --out <dir> [options]
+**   --out            - testSets_results root to write (required)
+**   --entries        - Table rows / F#### folders (default: 100)
+**   --per-event      - F#### folders per event (default: 4)
+**   --frames         - Frames per sequence (default: 1000)
+**   --versions       - Render versions per entry (default: 2)
+**   --distribution   - Frame values: clean, dips, drift or bimodal (default: dips)
+**   --min-value      - uiData.xml minValue threshold (default: 0.95)
+**   --not-ready      - Percent of entries without results (default: 5)
+**   --images         - Also write the image sequences
+**   --image-entries  - Only the first N entries get images (default: all)
+**   --size           - Image resolution WxH (default: 1920x1080; 3840x2160 for 4K)
+**   --quality        - JPEG quality (default: 90)
+**   --seed           - Random seed; the same options and seed give the same tree (default: 1)
+**   --threads        - Encoder threads (default: one per core)
+**
+** Example: 1000 table rows of 10000 frames, 4K image sequences for the first
+** two (A/B/C/D of one 4K frame take about 5 MB at quality 90, so this is ~200 GB;
+** the progress lines show the rate):
+**   resultsgen --out /data/load/testSets_results --entries 1000 --frames 10000 --images --image-entries 2 --size 3840x2160
+**
+** Exit code: 0 = success, 1 = write error, 2 = usage error
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include "resultsgen/resultsgen.h"
+
+namespace {
+
+bool parseSize(const QString &text, QSize &size)
+{
+    const QStringList parts = text.toLower().split('x');
+    if (parts.size() != 2) {
+        return false;
+    }
+    bool widthOk = false;
+    bool heightOk = false;
+    size = QSize(parts.at(0).toInt(&widthOk), parts.at(1).toInt(&heightOk));
+    return widthOk && heightOk && !size.isEmpty();
+}
+
+QString formatBytes(qint64 bytes)
+{
+    if (bytes >= Q_INT64_C(1024) * 1024 * 1024) {
+        return QString::number(bytes / (1024.0 * 1024.0 * 1024.0), 'f', 2) + " GB";
+    }
+    return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Writes a synthetic testSets_results tree for load testing");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("out", "testSets_results root to write.", "dir"));
+    parser.addOption(QCommandLineOption("entries", "Table rows (F#### folders).", "count", "100"));
+    parser.addOption(QCommandLineOption("per-event", "F#### folders per event.", "count", "4"));
+    parser.addOption(QCommandLineOption("frames", "Frames per sequence.", "count", "1000"));
+    parser.addOption(QCommandLineOption("versions", "Render versions per entry.", "count", "2"));
+    parser.addOption(QCommandLineOption("distribution", "Frame values: clean, dips, drift or bimodal.", "name", "dips"));
+    parser.addOption(QCommandLineOption("min-value", "uiData.xml minValue threshold.", "value", "0.95"));
+    parser.addOption(QCommandLineOption("not-ready", "Percent of entries without results.", "percent", "5"));
+    parser.addOption(QCommandLineOption("images", "Also write the image sequences."));
+    parser.addOption(QCommandLineOption("image-entries", "Only the first N entries get images (0 = all).", "count", "0"));
+    parser.addOption(QCommandLineOption("size", "Image resolution WxH.", "size", "1920x1080"));
+    parser.addOption(QCommandLineOption("quality", "JPEG quality.", "quality", "90"));
+    parser.addOption(QCommandLineOption("seed", "Random seed.", "seed", "1"));
+    parser.addOption(QCommandLineOption("threads", "Encoder threads (0 = one per core).", "count", "0"));
+    parser.process(app);
+
+    ResultsGenerator::Options options;
+    options.entryCount = parser.value("entries").toInt();
+    options.entriesPerEvent = parser.value("per-event").toInt();
+    options.frameCount = parser.value("frames").toInt();
+    options.versionCount = parser.value("versions").toInt();
+    options.minValue = parser.value("min-value").toDouble();
+    options.notReadyPercent = parser.value("not-ready").toInt();
+    options.images = parser.isSet("images");
+    options.imageEntries = parser.value("image-entries").toInt();
+    options.jpegQuality = parser.value("quality").toInt();
+    options.seed = parser.value("seed").toUInt();
+
+    bool distributionOk = false;
+    options.distribution = ResultsGenerator::distributionFromName(parser.value("distribution"), &distributionOk);
+    const QString outPath = parser.value("out");
+    if (outPath.isEmpty() || !distributionOk || !parseSize(parser.value("size"), options.imageSize)
+        || options.entryCount < 1 || options.frameCount < 1 || options.versionCount < 1
+        || options.notReadyPercent < 0 || options.notReadyPercent > 100) {
+        qCritical() << "Invalid options (--out is required; see --help)";
+        return 2;
+    }
+    const int threads = parser.value("threads").toInt();
+    if (threads > 0) {
+        QThreadPool::globalInstance()->setMaxThreadCount(threads);
+    }
+
+    qInfo().noquote() << QString("Writing %1 entries x %2 versions x %3 frames%4 to %5 (%6 threads)")
+                             .arg(options.entryCount).arg(options.versionCount).arg(options.frameCount)
+                             .arg(options.images ? QString(", images %1x%2").arg(options.imageSize.width()).arg(options.imageSize.height())
+                                                 : QString())
+                             .arg(outPath).arg(QThreadPool::globalInstance()->maxThreadCount());
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastReport = 0;
+    auto progress = [&timer, &lastReport](qint64 done, qint64 total, qint64 bytes) {
+        if (timer.elapsed() - lastReport < 2000) {
+            return;
+        }
+        lastReport = timer.elapsed();
+        const double seconds = timer.elapsed() / 1000.0;
+        qInfo().noquote() << QString("%1% (%2 of %3), %4, %5 MB/s")
+                                 .arg(total > 0 ? 100 * done / total : 100).arg(done).arg(total)
+                                 .arg(formatBytes(bytes)).arg(bytes / (1024.0 * 1024.0) / seconds, 0, 'f', 1);
+    };
+
+    ResultsGenerator::Stats stats;
+    QString errorString;
+    if (!ResultsGenerator::generate(outPath, options, &stats, progress, &errorString)) {
+        qCritical().noquote() << errorString;
+        return 1;
+    }
+
+    qInfo().noquote() << QString("Done in %1 s: %2 entries, %3 compareResult.xml, %4 images, %5")
+                             .arg(timer.elapsed() / 1000.0, 0, 'f', 1).arg(stats.entries).arg(stats.compareResults)
+                             .arg(stats.images).arg(formatBytes(stats.bytes));
+    return 0;
+}
@@ -0,0 +1,107 @@
+###############################################################################
+# Render Compare - Scrub Replay Harness
+# Replays scrub traces through the frame decode and presentation pipeline
+###############################################################################
+
+TEMPLATE = app
+TARGET = scrubreplay
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+# Latencies are measured on optimized code
+CONFIG -= debug
+CONFIG += release
+
+# Qt modules required by the replayed pipeline and the shared fixtures
+QT += core
+QT += xml
+QT += testlib  # QSignalSpy in the fixtures
+QT += concurrent
+QT += gui  # Required for QImage, QPixmap in ImageLoaderManager
+
+# Application version (same as main project)
+VERSION = 1.0.0
+
+# Add src directory to include path
+INCLUDEPATH += ../src
+INCLUDEPATH += .
+INCLUDEPATH += benchmarks
+INCLUDEPATH += replay
+
+# Source files from main project (the replayed pipeline; the XML model for the fixtures)
+SOURCES += ../src/imageloadermanager.cpp \
+           ../src/xmldatamodel.cpp \
+           ../src/xmldataloader.cpp \
+           ../src/seriesdecimator.cpp \
+           ../src/framevalueindex.cpp \
+           ../src/eventstats.cpp \
+           ../src/versioncomparator.cpp \
+           ../src/sparklinerenderer.cpp \
+           ../src/framering.cpp \
+           ../src/tilepyramid.cpp \
+           ../src/tracer.cpp \
+           ../src/metricsregistry.cpp \
+           ../src/playbackengine.cpp \
+           ../src/framesetpresenter.cpp \
+           ../src/scrubtrace.cpp \
+           ../src/memorygovernor.cpp \
+           ../src/qoicodec.cpp \
+           ../src/compressedframecache.cpp \
+           ../src/proxysequence.cpp \
+           ../src/proxybuilder.cpp
+
+HEADERS += ../src/imageloadermanager.h \
+           ../src/xmldatamodel.h \
+           ../src/xmldataloader.h \
+           ../src/seriesdecimator.h \
+           ../src/framevalueindex.h \
+           ../src/eventstats.h \
+           ../src/versioncomparator.h \
+           ../src/sparklinerenderer.h \
+           ../src/framering.h \
+           ../src/tilepyramid.h \
+           ../src/tracer.h \
+           ../src/metricsregistry.h \
+           ../src/playbackengine.h \
+           ../src/framesetpresenter.h \
+           ../src/scrubtrace.h \
+           ../src/memorygovernor.h \
+           ../src/qoicodec.h \
+           ../src/compressedframecache.h \
+           ../src/proxysequence.h \
+           ../src/proxybuilder.h
+
+# Synthetic data sets (uiData.xml, compareResult.xml, image sequences)
+SOURCES += benchmarks/benchfixtures.cpp
+HEADERS += benchmarks/benchfixtures.h
+
+# Replay harness
+SOURCES += scrubreplay_main.cpp \
+           replay/scrubreplay.cpp
+HEADERS += replay/scrubreplay.h
+
+# Peak process memory (GetProcessMemoryInfo)
+win32: LIBS += -lpsapi
+
+# Output directory
+DESTDIR = $$PWD/../bin
+OBJECTS_DIR = $$PWD/../build/scrubreplay
+MOC_DIR = $$PWD/../build/scrubreplay
+RCC_DIR = $$PWD/../build/scrubreplay
+UI_DIR = $$PWD/../build/scrubreplay
+
+# Ensure MOC files are generated properly
+CONFIG += moc
+CONFIG += warn_on
+
+# Create build directory if it doesn't exist
+!exists($$OBJECTS_DIR) {
+    system(mkdir -p $$OBJECTS_DIR)
+}
+!exists($$MOC_DIR) {
+    system(mkdir -p $$MOC_DIR)
+}
+
+# Disable warnings for harness files
+QMAKE_CXXFLAGS += -Wno-unused-parameter
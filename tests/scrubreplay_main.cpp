@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** @file scrubreplay_main.cpp
+** @brief Scrub replay harness - repeatable scrubbing latency measurement
+**
+** Replays a scrub trace (recorded with "renderCompare --record-scrub <file>",
+** or generated) through ImageLoaderManager, FrameRing and FrameSetPresenter
+** on the offscreen platform, then reports frame set latency percentiles,
+** dropped / torn frame sets, stalls and peak memory, as text and as JSON.
+**
+** Usage: scrubreplay [--trace <file> | --pattern drag|jump|step] [options]
+**   --trace       - Recorded trace to replay (default: synthetic)
+**   --pattern     - Synthetic trace: drag, jump or step (default: drag)
+**   --duration    - Synthetic trace length in ms (default: 10000)
+**   --seed        - Synthetic trace seed (default: 1)
+**   --panes       - Visible panes of a synthetic trace (default: A,B,C)
+**   --images      - Image sequence directory (<dir>/A/0001.jpg .. <dir>/D/0001.png);
+**                   generated if missing, reused otherwise (default: temporary)
+**   --frames      - Generated sequence length (default: 60, or the trace's last frame)
+**   --size        - Generated resolution (default: 1920x1080)
+**   --speed       - Replay speed factor (default: 1.0)
+**   --max-wait    - FrameSetPresenter maxWaitMs (default: as in the app)
+**   --stall-ms    - Latency counted as a stall (default: 50)
+**   --capacity    - FrameRing capacity in images (default: as in the app)
+**   --save-trace  - Also write the replayed trace (e.g. to keep a synthetic one)
+**   --json        - Results file (default: scrubreplay_results.json)
+**
+****************************************************************************/
+
+#include <QGuiApplication>  // Required for QPixmap operations (ImageLoaderManager)
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTemporaryDir>
+
+#include "../src/imageloadermanager.h"
+#include "../src/scrubtrace.h"
+#include "benchmarks/benchfixtures.h"
+#include "replay/scrubreplay.h"
+
+namespace {
+
+QString sequencePath(const QString &imagesDir, const QString &imageType)
+{
+    return QDir(imagesDir).absoluteFilePath(imageType) + "/";
+}
+
+/**
+ * @brief Write the A/B/C (JPEG) and D (PNG) sequences unless they are there already
+ */
+bool ensureSequences(const QString &imagesDir, int frameCount, const QSize &size)
+{
+    const QStringList imageTypes = {"A", "B", "C", "D"};
+    for (const QString &imageType : imageTypes) {
+        const QString format = (imageType == "D") ? "png" : "jpg";
+        const QString basePath = sequencePath(imagesDir, imageType);
+        const QString lastFrame = basePath + QString("%1").arg(frameCount, 4, 10, QChar('0')) + "." + format;
+        if (!QFile::exists(lastFrame) && !BenchFixtures::writeImageSequence(basePath, frameCount, size, format)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString formatMs(double ms)
+{
+    return ms < 0 ? QString("-") : QString::number(ms, 'f', 1) + " ms";
+}
+
+bool writeResults(const QString &jsonPath, const QJsonObject &replay, const ScrubReplay::Result &result)
+{
+    QJsonObject latency;
+    latency["p50Ms"] = result.percentileMs(0.50);
+    latency["p90Ms"] = result.percentileMs(0.90);
+    latency["p95Ms"] = result.percentileMs(0.95);
+    latency["p99Ms"] = result.percentileMs(0.99);
+    latency["maxMs"] = result.percentileMs(1.0);
+
+    QJsonObject results;
+    results["steps"] = result.steps;
+    results["presented"] = result.presented;
+    results["complete"] = result.latenciesMs.size();
+    results["dropped"] = result.dropped;
+    results["torn"] = result.torn;
+    results["stalls"] = result.stalls;
+    results["durationMs"] = result.durationMs;
+    results["latency"] = latency;
+    results["peakRingBytes"] = result.peakRingBytes;
+    results["peakRssBytes"] = result.peakRssBytes;
+
+    QJsonObject root;
+    root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["qtVersion"] = QString(qVersion());
+    root["platform"] = QSysInfo::prettyProductName();
+    root["cpuArchitecture"] = QSysInfo::currentCpuArchitecture();
+    root["host"] = QSysInfo::machineHostName();
+    root["replay"] = replay;
+    root["results"] = results;
+
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) > 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // No window is shown - run without a display (CI containers)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays a scrub trace and measures frame set latency");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("trace", "Recorded trace to replay.", "file"));
+    parser.addOption(QCommandLineOption("pattern", "Synthetic trace: drag, jump or step.", "pattern", "drag"));
+    parser.addOption(QCommandLineOption("duration", "Synthetic trace length in ms.", "ms", "10000"));
+    parser.addOption(QCommandLineOption("seed", "Synthetic trace seed.", "seed", "1"));
+    parser.addOption(QCommandLineOption("panes", "Visible panes of a synthetic trace.", "types", "A,B,C"));
+    parser.addOption(QCommandLineOption("images", "Image sequence directory (generated if missing).", "dir"));
+    parser.addOption(QCommandLineOption("frames", "Generated sequence length.", "frames", "60"));
+    parser.addOption(QCommandLineOption("size", "Generated resolution.", "WxH", "1920x1080"));
+    parser.addOption(QCommandLineOption("speed", "Replay speed factor.", "factor", "1.0"));
+    parser.addOption(QCommandLineOption("max-wait", "FrameSetPresenter maxWaitMs.", "ms", "-1"));
+    parser.addOption(QCommandLineOption("stall-ms", "Latency counted as a stall.", "ms", "50"));
+    parser.addOption(QCommandLineOption("capacity", "FrameRing capacity in images.", "images", "-1"));
+    parser.addOption(QCommandLineOption("save-trace", "Also write the replayed trace.", "file"));
+    parser.addOption(QCommandLineOption("json", "Results file.", "file", "scrubreplay_results.json"));
+    parser.process(app);
+
+    // Trace: recorded or synthetic
+    QVector<ScrubTrace::Step> steps;
+    QString traceSource;
+    if (parser.isSet("trace")) {
+        QString errorString;
+        if (!ScrubTrace::read(parser.value("trace"), steps, &errorString)) {
+            qCritical().noquote() << errorString;
+            return 1;
+        }
+        traceSource = parser.value("trace");
+    } else {
+        const QStringList panes = parser.value("panes").split(',', QString::SkipEmptyParts);
+        steps = ScrubReplay::synthesize(parser.value("pattern"), parser.value("frames").toInt(),
+                                        parser.value("duration").toLongLong(), panes, parser.value("seed").toUInt());
+        traceSource = QString("synthetic %1 (seed %2)").arg(parser.value("pattern"), parser.value("seed"));
+    }
+    if (steps.isEmpty()) {
+        qCritical() << "Nothing to replay - empty trace or unknown pattern";
+        return 1;
+    }
+    if (parser.isSet("save-trace") && !ScrubTrace::write(parser.value("save-trace"), steps)) {
+        qWarning() << "Could not write" << parser.value("save-trace");
+    }
+
+    // Image sequences covering every frame of the trace
+    int frameCount = parser.value("frames").toInt();
+    for (const ScrubTrace::Step &step : steps) {
+        frameCount = qMax(frameCount, step.frame);
+    }
+    const QStringList sizeParts = parser.value("size").split('x');
+    const QSize size(sizeParts.value(0).toInt(), sizeParts.value(1).toInt());
+    if (frameCount < 1 || size.isEmpty()) {
+        qCritical() << "Invalid --frames or --size";
+        return 1;
+    }
+    QTemporaryDir temporaryDir;
+    const QString imagesDir = parser.isSet("images") ? parser.value("images") : temporaryDir.path();
+    QElapsedTimer fixtureTimer;
+    fixtureTimer.start();
+    if (!ensureSequences(imagesDir, frameCount, size)) {
+        qCritical().noquote() << "Could not write image sequences to" << imagesDir;
+        return 1;
+    }
+    qInfo().noquote() << "Image sequences ready in" << fixtureTimer.elapsed() << "ms:" << imagesDir;
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(sequencePath(imagesDir, "A"), sequencePath(imagesDir, "B"),
+                          sequencePath(imagesDir, "C"), sequencePath(imagesDir, "D"));
+
+    ScrubReplay replay(&manager);
+    replay.setSpeed(qMax(0.01, parser.value("speed").toDouble()));
+    replay.setMaxWaitMs(parser.value("max-wait").toInt());
+    replay.setStallMs(parser.value("stall-ms").toDouble());
+    replay.setRingCapacity(parser.value("capacity").toInt());
+    const ScrubReplay::Result result = replay.run(steps);
+
+    qInfo().noquote() << "Trace:" << traceSource << "-" << result.steps << "requests in" << result.durationMs << "ms";
+    qInfo().noquote() << "Frame sets:" << result.presented << "presented," << result.latenciesMs.size() << "complete,"
+                      << result.dropped << "dropped," << result.torn << "torn," << result.stalls << "stalls (>"
+                      << parser.value("stall-ms") << "ms or torn)";
+    qInfo().noquote() << "Latency: p50" << formatMs(result.percentileMs(0.50)) << "p90" << formatMs(result.percentileMs(0.90))
+                      << "p99" << formatMs(result.percentileMs(0.99)) << "max" << formatMs(result.percentileMs(1.0));
+    qInfo().noquote() << "Memory: decoded frames peak" << result.peakRingBytes / (1024 * 1024) << "MB, process peak"
+                      << (result.peakRssBytes < 0 ? QString("-") : QString::number(result.peakRssBytes / (1024 * 1024)) + " MB");
+
+    QJsonObject replaySettings;
+    replaySettings["trace"] = traceSource;
+    replaySettings["speed"] = parser.value("speed").toDouble();
+    replaySettings["frames"] = frameCount;
+    replaySettings["size"] = parser.value("size");
+    replaySettings["stallMs"] = parser.value("stall-ms").toDouble();
+    const QString jsonPath = parser.value("json");
+    if (!writeResults(jsonPath, replaySettings, result)) {
+        qWarning() << "Could not write" << jsonPath;
+        return 1;
+    }
+    qInfo().noquote() << "Results written to" << jsonPath;
+
+    return result.presented > 0 ? 0 : 1;
+}
@@ -29,19 +29,105 @@ INCLUDEPATH += .
 SOURCES += ../src/inireader.cpp \
            ../src/imageloadermanager.cpp \
            ../src/xmldatamodel.cpp \
-           ../src/xmldataloader.cpp
+           ../src/xmldataloader.cpp \
+           ../src/seriesdecimator.cpp \
+           ../src/framevalueindex.cpp \
+           ../src/eventstats.cpp \
+           ../src/versioncomparator.cpp \
+           ../src/sparklinerenderer.cpp \
+           ../src/framering.cpp \
+           ../src/playbackengine.cpp \
+           ../src/framesetpresenter.cpp \
+           ../src/abcompositor.cpp \
+           ../src/tilepyramid.cpp \
+           ../src/tracer.cpp \
+           ../src/metricsregistry.cpp \
+           ../src/headlessreport.cpp \
+           ../src/scrubtrace.cpp \
+           ../src/logmodel.cpp \
+           ../src/logarchive.cpp \
+           ../src/logsearchmodel.cpp \
+           ../src/memorygovernor.cpp \
+           ../src/roistats.cpp \
+           ../src/roistatsservice.cpp \
+           ../src/channelhistogram.cpp \
+           ../src/pixelprobe.cpp \
+           ../src/tonemapper.cpp \
+           ../src/qoicodec.cpp \
+           ../src/compressedframecache.cpp \
+           ../src/proxysequence.cpp \
+           ../src/proxybuilder.cpp
 
 HEADERS += ../src/inireader.h \
            ../src/imageloadermanager.h \
            ../src/xmldatamodel.h \
-           ../src/xmldataloader.h
+           ../src/xmldataloader.h \
+           ../src/seriesdecimator.h \
+           ../src/framevalueindex.h \
+           ../src/eventstats.h \
+           ../src/versioncomparator.h \
+           ../src/sparklinerenderer.h \
+           ../src/framering.h \
+           ../src/playbackengine.h \
+           ../src/framesetpresenter.h \
+           ../src/abcompositor.h \
+           ../src/tilepyramid.h \
+           ../src/tracer.h \
+           ../src/metricsregistry.h \
+           ../src/headlessreport.h \
+           ../src/scrubtrace.h \
+           ../src/logmodel.h \
+           ../src/mpmcring.h \
+           ../src/logarchive.h \
+           ../src/logsearchmodel.h \
+           ../src/memorygovernor.h \
+           ../src/roistats.h \
+           ../src/roistatsservice.h \
+           ../src/channelhistogram.h \
+           ../src/pixelprobe.h \
+           ../src/tonemapper.h \
+           ../src/qoicodec.h \
+           ../src/compressedframecache.h \
+           ../src/proxysequence.h \
+           ../src/proxybuilder.h
+
+# Performance gate statistics (perfgate.pro)
+SOURCES += perfgate/perfgate.cpp
+HEADERS += perfgate/perfgate.h
+
+# Results tree generator (resultsgen.pro)
+SOURCES += resultsgen/resultsgen.cpp
+HEADERS += resultsgen/resultsgen.h
 
 # Test source files
 # Note: Individual test files no longer have QTEST_MAIN - using shared main()
 SOURCES += tests_main.cpp \
            unit/test_imageloadermanager.cpp \
            unit/test_inireader.cpp \
-           unit/test_xmldatamodel.cpp
+           unit/test_xmldatamodel.cpp \
+           unit/test_seriesdecimator.cpp \
+           unit/test_framevalueindex.cpp \
+           unit/test_eventstats.cpp \
+           unit/test_versioncomparator.cpp \
+           unit/test_sparklinerenderer.cpp \
+           unit/test_playbackengine.cpp \
+           unit/test_framesetpresenter.cpp \
+           unit/test_abcompositor.cpp \
+           unit/test_tilepyramid.cpp \
+           unit/test_tracer.cpp \
+           unit/test_metricsregistry.cpp \
+           unit/test_headlessreport.cpp \
+           unit/test_scrubtrace.cpp \
+           unit/test_logmodel.cpp \
+           unit/test_logarchive.cpp \
+           unit/test_memorygovernor.cpp \
+           unit/test_perfgate.cpp \
+           unit/test_resultsgen.cpp \
+           unit/test_roistats.cpp \
+           unit/test_pixelprobe.cpp \
+           unit/test_tonemapper.cpp \
+           unit/test_compressedframecache.cpp \
+           unit/test_proxybuilder.cpp
 
 # Output directory
 DESTDIR = $$PWD/../bin
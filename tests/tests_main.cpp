@@ -19,6 +19,29 @@
 #include "unit/test_imageloadermanager.cpp"
 #include "unit/test_inireader.cpp"
 #include "unit/test_xmldatamodel.cpp"
+#include "unit/test_seriesdecimator.cpp"
+#include "unit/test_framevalueindex.cpp"
+#include "unit/test_eventstats.cpp"
+#include "unit/test_versioncomparator.cpp"
+#include "unit/test_sparklinerenderer.cpp"
+#include "unit/test_playbackengine.cpp"
+#include "unit/test_framesetpresenter.cpp"
+#include "unit/test_abcompositor.cpp"
+#include "unit/test_tilepyramid.cpp"
+#include "unit/test_tracer.cpp"
+#include "unit/test_metricsregistry.cpp"
+#include "unit/test_headlessreport.cpp"
+#include "unit/test_scrubtrace.cpp"
+#include "unit/test_logmodel.cpp"
+#include "unit/test_logarchive.cpp"
+#include "unit/test_memorygovernor.cpp"
+#include "unit/test_perfgate.cpp"
+#include "unit/test_resultsgen.cpp"
+#include "unit/test_roistats.cpp"
+#include "unit/test_pixelprobe.cpp"
+#include "unit/test_tonemapper.cpp"
+#include "unit/test_compressedframecache.cpp"
+#include "unit/test_proxybuilder.cpp"
 
 // Main function that runs all tests
 int main(int argc, char *argv[])
@@ -44,5 +67,120 @@ int main(int argc, char *argv[])
         status |= QTest::qExec(&test, argc, argv);
     }
     
+    {
+        TestSeriesDecimator test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestFrameValueIndex test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestEventStats test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestVersionComparator test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestSparklineRenderer test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestPlaybackEngine test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestFrameSetPresenter test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestABCompositor test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestTilePyramid test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestTracer test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestMetricsRegistry test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestHeadlessReport test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestScrubTrace test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestLogModel test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestLogArchive test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestMemoryGovernor test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestPerfGate test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestResultsGenerator test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestRoiStats test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestPixelProbe test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestToneMapper test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestCompressedFrameCache test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
+    {
+        TestProxyBuilder test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    
     return (status != 0) ? 1 : 0;
 }
@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** @file test_abcompositor.cpp
+** @brief Unit tests for ABCompositor
+**
+** Tests for:
+** - Neutral adjustment leaves colours unchanged
+** - Saturation, hue and lightness extremes
+** - Compositing: transparent mask, overlay opacity, missing images
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+
+#include "../src/abcompositor.h"
+
+class TestABCompositor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testNeutralAdjustment();
+    void testAdjustmentExtremes();
+    void testHueRotation();
+    void testTransparentMask();
+    void testOverlayOpacity();
+    void testMissingImages();
+
+private:
+    static bool closeTo(QRgb a, QRgb b, int tolerance = 1);
+};
+
+bool TestABCompositor::closeTo(QRgb a, QRgb b, int tolerance)
+{
+    return qAbs(qRed(a) - qRed(b)) <= tolerance && qAbs(qGreen(a) - qGreen(b)) <= tolerance
+        && qAbs(qBlue(a) - qBlue(b)) <= tolerance && qAbs(qAlpha(a) - qAlpha(b)) <= tolerance;
+}
+
+void TestABCompositor::testNeutralAdjustment()
+{
+    ABCompositeParams params;
+    const QRgb colors[] = { qRgb(200, 40, 90), qRgb(10, 250, 128), qRgb(128, 128, 128), qRgba(0, 0, 255, 100) };
+    for (QRgb color : colors) {
+        QVERIFY(closeTo(ABCompositor::adjustColor(color, params), color));
+    }
+
+    params.hue = 1.0f;  // A full turn is neutral too (the view's default hue)
+    QVERIFY(closeTo(ABCompositor::adjustColor(qRgb(200, 40, 90), params), qRgb(200, 40, 90)));
+}
+
+void TestABCompositor::testAdjustmentExtremes()
+{
+    const QRgb color = qRgb(200, 40, 90);
+    ABCompositeParams params;
+
+    params.lightness = 1.0f;
+    QVERIFY(closeTo(ABCompositor::adjustColor(color, params), qRgb(255, 255, 255)));
+    params.lightness = -1.0f;
+    QVERIFY(closeTo(ABCompositor::adjustColor(color, params), qRgb(0, 0, 0)));
+
+    params.lightness = 0.0f;
+    params.saturation = -1.0f;
+    const QRgb grey = ABCompositor::adjustColor(color, params);
+    QCOMPARE(qRed(grey), qGreen(grey));
+    QCOMPARE(qGreen(grey), qBlue(grey));
+}
+
+void TestABCompositor::testHueRotation()
+{
+    ABCompositeParams params;
+    params.hue = 1.0f / 3.0f;  // Red -> green -> blue
+    QVERIFY(closeTo(ABCompositor::adjustColor(qRgb(255, 0, 0), params), qRgb(0, 255, 0)));
+    QVERIFY(closeTo(ABCompositor::adjustColor(qRgb(0, 255, 0), params), qRgb(0, 0, 255)));
+}
+
+void TestABCompositor::testTransparentMask()
+{
+    QImage base(4, 4, QImage::Format_RGB32);
+    base.fill(qRgb(10, 20, 30));
+    QImage mask(4, 4, QImage::Format_ARGB32);
+    mask.fill(Qt::transparent);
+
+    const QImage result = ABCompositor::composite(base, mask, ABCompositeParams());
+    QCOMPARE(result.size(), base.size());
+    QVERIFY(closeTo(result.pixel(2, 2), qRgb(10, 20, 30), 0));
+}
+
+void TestABCompositor::testOverlayOpacity()
+{
+    QImage base(4, 4, QImage::Format_RGB32);
+    base.fill(qRgb(0, 0, 0));
+    QImage mask(2, 2, QImage::Format_ARGB32);  // Different size - scaled to the base
+    mask.fill(qRgb(200, 100, 50));
+
+    ABCompositeParams params;
+    params.opacity = 1.0f;
+    QVERIFY(closeTo(ABCompositor::composite(base, mask, params).pixel(3, 3), qRgb(200, 100, 50)));
+
+    params.opacity = 0.5f;
+    QVERIFY(closeTo(ABCompositor::composite(base, mask, params).pixel(0, 0), qRgb(100, 50, 25)));
+
+    params.opacity = 0.0f;
+    QVERIFY(closeTo(ABCompositor::composite(base, mask, params).pixel(0, 0), qRgb(0, 0, 0), 0));
+}
+
+void TestABCompositor::testMissingImages()
+{
+    QVERIFY(ABCompositor::composite(QImage(), QImage(), ABCompositeParams()).isNull());
+
+    QImage mask(3, 2, QImage::Format_ARGB32);
+    mask.fill(qRgba(255, 0, 0, 255));
+    const QImage overlayOnly = ABCompositor::composite(QImage(), mask, ABCompositeParams());
+    QCOMPARE(overlayOnly.size(), mask.size());
+    QVERIFY(closeTo(overlayOnly.pixel(1, 1), qRgb(255, 0, 0)));
+
+    QImage base(3, 2, QImage::Format_RGB32);
+    base.fill(qRgb(1, 2, 3));
+    QVERIFY(closeTo(ABCompositor::composite(base, QImage(), ABCompositeParams()).pixel(0, 0), qRgb(1, 2, 3), 0));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_abcompositor.moc"
@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** @file test_compressedframecache.cpp
+** @brief Unit tests for QoiCodec and the compressed frame tier
+**
+** Tests for:
+** - Lossless round trip of opaque and transparent frames (runs, diffs, noise)
+** - Unsupported formats and invalid / truncated streams rejected
+** - Capacity: frames farthest from the last lookup dropped; stale inserts ignored
+** - Frames dropped from FrameRing are compressed and decoded again from memory
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QRandomGenerator>
+
+#include "../src/qoicodec.h"
+#include "../src/compressedframecache.h"
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+
+class TestCompressedFrameCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testRoundTrip_data();
+    void testRoundTrip();
+    void testInvalid();
+    void testCapacity();
+    void testFrameRingDemotion();
+
+private:
+    static quint64 key(int frameNumber) { return (quint64('A') << 32) | static_cast<quint32>(frameNumber); }
+};
+
+void TestCompressedFrameCache::testRoundTrip_data()
+{
+    QTest::addColumn<QImage>("image");
+
+    // Odd sizes, so rows don't line up with runs
+    QImage flat(67, 13, QImage::Format_RGB32);
+    flat.fill(qRgb(30, 30, 40));  // Runs longer than one op holds
+    QTest::newRow("flat") << flat;
+
+    QImage gradient(101, 37, QImage::Format_RGB32);
+    for (int y = 0; y < gradient.height(); ++y) {
+        for (int x = 0; x < gradient.width(); ++x) {
+            gradient.setPixel(x, y, qRgb(x * 2, y * 6, (x + y) * 3 / 2));  // Small and larger steps
+        }
+    }
+    QTest::newRow("gradient") << gradient;
+
+    QRandomGenerator random(74);
+    QImage noise(33, 21, QImage::Format_RGB32);
+    for (int y = 0; y < noise.height(); ++y) {
+        for (int x = 0; x < noise.width(); ++x) {
+            noise.setPixel(x, y, random.generate() | 0xff000000);
+        }
+    }
+    QTest::newRow("noise") << noise;
+
+    QImage alpha(45, 17, QImage::Format_ARGB32);
+    for (int y = 0; y < alpha.height(); ++y) {
+        for (int x = 0; x < alpha.width(); ++x) {
+            alpha.setPixel(x, y, x % 7 == 0 ? random.generate() : qRgba(x, y, 200, x < 20 ? 255 : 0));
+        }
+    }
+    QTest::newRow("alpha") << alpha;
+}
+
+void TestCompressedFrameCache::testRoundTrip()
+{
+    QFETCH(QImage, image);
+    QVERIFY(QoiCodec::canEncode(image));
+    const QByteArray data = QoiCodec::encode(image);
+    QVERIFY(data.startsWith("qoif"));
+
+    const QImage decoded = QoiCodec::decode(data);
+    QCOMPARE(decoded.format(), image.format());
+    QCOMPARE(decoded, image);
+
+    if (QByteArray(QTest::currentDataTag()) == "flat") {
+        QVERIFY(data.size() < 100);
+    }
+}
+
+void TestCompressedFrameCache::testInvalid()
+{
+    QVERIFY(!QoiCodec::canEncode(QImage()));
+    QVERIFY(!QoiCodec::canEncode(QImage(4, 4, QImage::Format_RGBA64)));  // 16-bit frames stay on disk
+    QVERIFY(QoiCodec::encode(QImage(4, 4, QImage::Format_Grayscale8)).isEmpty());
+
+    QVERIFY(QoiCodec::decode(QByteArray()).isNull());
+    QVERIFY(QoiCodec::decode(QByteArray(64, 'x')).isNull());
+
+    QImage image(16, 16, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, qRgb(x * 16, 255 - y * 16, x * y));
+        }
+    }
+    const QByteArray data = QoiCodec::encode(image);
+    QVERIFY(QoiCodec::decode(data.left(data.size() / 2)).isNull());  // Truncated
+}
+
+void TestCompressedFrameCache::testCapacity()
+{
+    CompressedFrameCache cache(1000);
+    const QByteArray frame(300, 'q');
+    for (int frameNumber = 1; frameNumber <= 3; ++frameNumber) {
+        QVERIFY(cache.insert(key(frameNumber), frame, cache.generation()));
+    }
+    QCOMPARE(cache.bytes(), qint64(900));
+    QVERIFY(!cache.insert(key(9), QByteArray(1001, 'q'), cache.generation()));  // Larger than the capacity
+
+    // Over capacity: the frame farthest from the last lookup goes
+    QCOMPARE(cache.data(key(3)), frame);
+    QVERIFY(cache.insert(key(4), frame, cache.generation()));
+    QCOMPARE(cache.size(), 3);
+    QVERIFY(!cache.contains(key(1)));
+    QVERIFY(cache.contains(key(4)));
+
+    QCOMPARE(cache.release(1), qint64(300));
+    QVERIFY(!cache.contains(key(2)));
+
+    // Compressions started before clear() are not inserted
+    const int generation = cache.generation();
+    cache.clear();
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.bytes(), qint64(0));
+    QVERIFY(!cache.insert(key(1), frame, generation));
+    QVERIFY(cache.data(key(3)).isEmpty());
+
+    cache.setCapacityBytes(0);
+    QVERIFY(!cache.insert(key(1), frame, cache.generation()));
+}
+
+void TestCompressedFrameCache::testFrameRingDemotion()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    for (int frameNumber = 1; frameNumber <= 3; ++frameNumber) {
+        QImage frame(48, 32, QImage::Format_RGB32);
+        frame.fill(qRgb(frameNumber * 60, 100, 200));
+        QVERIFY(frame.save(dir.filePath(QString("%1.jpg").arg(frameNumber, 4, 10, QChar('0')))));
+    }
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    FrameRing ring;
+    ring.setImageLoaderManager(&manager);
+    ring.setCapacity(1);
+
+    QVERIFY(ring.request("A", 1));
+    QTRY_VERIFY(ring.contains("A", 1));
+    const QImage first = ring.image("A", 1);
+
+    // Frame 2 takes frame 1's place; frame 1 is compressed in the background
+    QVERIFY(ring.request("A", 2));
+    QTRY_VERIFY(ring.contains("A", 2));
+    QVERIFY(!ring.contains("A", 1));
+    QTRY_COMPARE(ring.compressedFrames()->size(), 1);
+    QVERIFY(ring.compressedFrames()->bytes() < first.sizeInBytes());
+
+    // Decoded again from memory: the file isn't needed
+    QVERIFY(QFile::remove(dir.filePath("0001.jpg")));
+    QVERIFY(ring.request("A", 1));
+    QTRY_VERIFY(ring.contains("A", 1));
+    QCOMPARE(ring.image("A", 1), first);
+
+    // Switching events drops the compressed frames too
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    QCOMPARE(ring.compressedFrames()->size(), 0);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_compressedframecache.moc"
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** @file test_eventstats.cpp
+** @brief Unit tests for EventStats
+**
+** Tests for:
+** - Empty series
+** - Percentiles
+** - Frames under threshold and longest bad run
+** - Histogram
+** - Recomputing for a new threshold
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QVector>
+
+#include "../src/eventstats.h"
+
+class TestEventStats : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testEmptySeries();
+    void testPercentiles();
+    void testThresholdCounts();
+    void testHistogram();
+    void testApplyThreshold();
+};
+
+void TestEventStats::testEmptySeries()
+{
+    EventStats stats = EventStats::compute(QVector<float>(), 0.5);
+    QVERIFY(!stats.isValid());
+    QCOMPARE(stats.framesUnderThreshold, 0);
+    QCOMPARE(stats.longestBadRun, 0);
+}
+
+void TestEventStats::testPercentiles()
+{
+    // Values 0.01 .. 1.00 - nearest-rank percentiles are exact
+    QVector<float> values;
+    for (int i = 100; i >= 1; --i) {
+        values.append(i / 100.0f);
+    }
+    EventStats stats = EventStats::compute(values, 0.0);
+    QCOMPARE(stats.frameCount, 100);
+    QVERIFY(qAbs(stats.p5Value - 0.05) < 1e-6);
+    QVERIFY(qAbs(stats.medianValue - 0.50) < 1e-6);
+    QVERIFY(qAbs(stats.p95Value - 0.95) < 1e-6);
+}
+
+void TestEventStats::testThresholdCounts()
+{
+    // Two bad runs: 3 frames and 2 frames
+    QVector<float> values = { 0.9f, 0.2f, 0.3f, 0.4f, 0.9f, 0.95f, 0.1f, 0.5f, 0.9f };
+    EventStats stats = EventStats::compute(values, 0.5);
+    QCOMPARE(stats.framesUnderThreshold, 5);  // Threshold is inclusive
+    QCOMPARE(stats.longestBadRun, 3);
+}
+
+void TestEventStats::testHistogram()
+{
+    QVector<float> values = { 0.0f, 0.05f, 0.55f, 0.99f, 1.0f, 1.2f };
+    EventStats stats = EventStats::compute(values, 0.5);
+    QCOMPARE(stats.histogram.size(), static_cast<int>(EventStats::HistogramBins));
+    QCOMPARE(stats.histogram.at(0), 2);
+    QCOMPARE(stats.histogram.at(5), 1);
+    QCOMPARE(stats.histogram.at(9), 3);  // 1.0 and out-of-range values clamp to the last bin
+}
+
+void TestEventStats::testApplyThreshold()
+{
+    QVector<float> values = { 0.9f, 0.2f, 0.3f, 0.4f, 0.9f };
+    EventStats stats = EventStats::compute(values, 0.5);
+    const double p5 = stats.p5Value;
+
+    EventStats::applyThreshold(stats, values, 0.25);
+    QCOMPARE(stats.framesUnderThreshold, 1);
+    QCOMPARE(stats.longestBadRun, 1);
+    QCOMPARE(stats.p5Value, p5);  // Percentiles are not threshold-dependent
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_eventstats.moc"
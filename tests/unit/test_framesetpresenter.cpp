@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** @file test_framesetpresenter.cpp
+** @brief Unit tests for FrameSetPresenter
+**
+** Tests for:
+** - Immediate presentation without image panes
+** - Presentation once every pane image is decoded
+** - Dropped (overtaken) and torn (incomplete) frame set counters
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "../src/framesetpresenter.h"
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+
+class TestFrameSetPresenter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test setup
+    void init();
+    void cleanup();
+
+    // Test cases
+    void testNoPanes();
+    void testCompleteFrameSet();
+    void testDroppedFrameSet();
+    void testTornFrameSet();
+
+private:
+    QTemporaryDir *m_dir;
+    ImageLoaderManager *m_manager;
+    FrameRing *m_ring;
+    FrameSetPresenter *m_presenter;
+};
+
+void TestFrameSetPresenter::init()
+{
+    // Frames 1-3 exist for A and B; nothing for C
+    m_dir = new QTemporaryDir();
+    QVERIFY(m_dir->isValid());
+    QDir(m_dir->path()).mkdir("A");
+    QDir(m_dir->path()).mkdir("B");
+    QImage frame(8, 8, QImage::Format_RGB32);
+    frame.fill(Qt::green);
+    for (int i = 1; i <= 3; ++i) {
+        const QString name = QString("%1.jpg").arg(i, 4, 10, QChar('0'));
+        QVERIFY(frame.save(m_dir->filePath("A/" + name)));
+        QVERIFY(frame.save(m_dir->filePath("B/" + name)));
+    }
+
+    m_manager = new ImageLoaderManager();
+    m_manager->setImagePaths(m_dir->filePath("A") + "/", m_dir->filePath("B") + "/",
+                             m_dir->filePath("C") + "/", QString());
+    m_ring = new FrameRing();
+    m_ring->setImageLoaderManager(m_manager);
+    m_presenter = new FrameSetPresenter(m_ring);
+}
+
+void TestFrameSetPresenter::cleanup()
+{
+    delete m_presenter;
+    delete m_ring;
+    delete m_manager;
+    delete m_dir;
+}
+
+void TestFrameSetPresenter::testNoPanes()
+{
+    QSignalSpy readySpy(m_presenter, &FrameSetPresenter::frameSetReady);
+    m_presenter->requestFrame(2, QStringList());
+    QCOMPARE(readySpy.count(), 1);
+    QCOMPARE(readySpy.at(0).at(0).toInt(), 2);
+}
+
+void TestFrameSetPresenter::testCompleteFrameSet()
+{
+    QSignalSpy readySpy(m_presenter, &FrameSetPresenter::frameSetReady);
+    m_presenter->requestFrame(1, QStringList() << "A" << "B");
+    QTRY_COMPARE(readySpy.count(), 1);
+    QCOMPARE(readySpy.at(0).at(0).toInt(), 1);
+    QVERIFY(m_ring->containsFrameSet(1, QStringList() << "A" << "B"));
+    QCOMPARE(m_presenter->tornFrameSets(), 0);
+
+    // Already decoded: presented without waiting
+    m_presenter->requestFrame(1, QStringList() << "A" << "B");
+    QCOMPARE(readySpy.count(), 2);
+}
+
+void TestFrameSetPresenter::testDroppedFrameSet()
+{
+    QSignalSpy readySpy(m_presenter, &FrameSetPresenter::frameSetReady);
+    m_presenter->requestFrame(2, QStringList() << "A" << "B");
+    m_presenter->requestFrame(3, QStringList() << "A" << "B");
+    QTRY_COMPARE(readySpy.count(), 1);
+    QCOMPARE(readySpy.at(0).at(0).toInt(), 3);  // Only the latest request is presented
+    QCOMPARE(m_presenter->droppedFrameSets(), 1);
+}
+
+void TestFrameSetPresenter::testTornFrameSet()
+{
+    // C images don't exist - presented anyway, counted as torn
+    QSignalSpy readySpy(m_presenter, &FrameSetPresenter::frameSetReady);
+    m_presenter->requestFrame(1, QStringList() << "A" << "C");
+    QTRY_COMPARE(readySpy.count(), 1);
+    QCOMPARE(m_presenter->tornFrameSets(), 1);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_framesetpresenter.moc"
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** @file test_framevalueindex.cpp
+** @brief Unit tests for FrameValueIndex class
+**
+** Tests for:
+** - Empty index
+** - Next/previous frame at or below threshold
+** - Count at or below threshold
+** - Runs at or below threshold
+** - Agreement with a linear scan on larger data
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QVector>
+#include <QPointF>
+
+#include "../src/framevalueindex.h"
+
+class TestFrameValueIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testEmptyIndex();
+    void testNextFrame();
+    void testPreviousFrame();
+    void testCount();
+    void testRuns();
+    void testMatchesLinearScan();
+
+private:
+    QVector<QPointF> makeSeries() const;
+};
+
+QVector<QPointF> TestFrameValueIndex::makeSeries() const
+{
+    // Frames 10..19; frames 12, 13 and 17 are below 0.5
+    QVector<QPointF> points;
+    const double values[] = { 0.9, 0.8, 0.4, 0.3, 0.9, 0.95, 0.7, 0.1, 0.6, 0.9 };
+    for (int i = 0; i < 10; ++i) {
+        points.append(QPointF(10 + i, values[i]));
+    }
+    return points;
+}
+
+void TestFrameValueIndex::testEmptyIndex()
+{
+    FrameValueIndex index;
+    QVERIFY(index.isEmpty());
+    QCOMPARE(index.nextFrameAtOrBelow(0, 1.0), -1);
+    QCOMPARE(index.previousFrameAtOrBelow(100, 1.0), -1);
+    QCOMPARE(index.countAtOrBelow(1.0), 0);
+    QVERIFY(index.runsAtOrBelow(1.0).isEmpty());
+}
+
+void TestFrameValueIndex::testNextFrame()
+{
+    FrameValueIndex index;
+    index.build(makeSeries());
+
+    QCOMPARE(index.nextFrameAtOrBelow(0, 0.5), 12);
+    QCOMPARE(index.nextFrameAtOrBelow(12, 0.5), 13);  // Search is exclusive
+    QCOMPARE(index.nextFrameAtOrBelow(13, 0.5), 17);
+    QCOMPARE(index.nextFrameAtOrBelow(17, 0.5), -1);
+    QCOMPARE(index.nextFrameAtOrBelow(0, 0.05), -1);
+}
+
+void TestFrameValueIndex::testPreviousFrame()
+{
+    FrameValueIndex index;
+    index.build(makeSeries());
+
+    QCOMPARE(index.previousFrameAtOrBelow(100, 0.5), 17);
+    QCOMPARE(index.previousFrameAtOrBelow(17, 0.5), 13);  // Search is exclusive
+    QCOMPARE(index.previousFrameAtOrBelow(13, 0.5), 12);
+    QCOMPARE(index.previousFrameAtOrBelow(12, 0.5), -1);
+}
+
+void TestFrameValueIndex::testCount()
+{
+    FrameValueIndex index;
+    index.build(makeSeries());
+
+    QCOMPARE(index.countAtOrBelow(0.0), 0);
+    QCOMPARE(index.countAtOrBelow(0.3), 2);  // Threshold is inclusive
+    QCOMPARE(index.countAtOrBelow(0.5), 3);
+    QCOMPARE(index.countAtOrBelow(1.0), 10);
+}
+
+void TestFrameValueIndex::testRuns()
+{
+    FrameValueIndex index;
+    index.build(makeSeries());
+
+    QVector<QPair<int, int>> runs = index.runsAtOrBelow(0.5);
+    QCOMPARE(runs.size(), 2);
+    QCOMPARE(index.frameAt(runs.at(0).first), 12);
+    QCOMPARE(index.frameAt(runs.at(0).second), 13);
+    QCOMPARE(index.frameAt(runs.at(1).first), 17);
+    QCOMPARE(index.frameAt(runs.at(1).second), 17);
+
+    runs = index.runsAtOrBelow(1.0);
+    QCOMPARE(runs.size(), 1);
+    QCOMPARE(runs.at(0).first, 0);
+    QCOMPARE(runs.at(0).second, 9);
+}
+
+void TestFrameValueIndex::testMatchesLinearScan()
+{
+    QVector<QPointF> points;
+    for (int frame = 0; frame < 5000; ++frame) {
+        // Deterministic pseudo-random values in [0, 1)
+        points.append(QPointF(frame, ((frame * 7919) % 1000) / 1000.0));
+    }
+    FrameValueIndex index;
+    index.build(points);
+
+    const double threshold = 0.05;
+    int expectedCount = 0;
+    for (const QPointF &point : points) {
+        if (point.y() <= threshold) {
+            ++expectedCount;
+        }
+    }
+    QCOMPARE(index.countAtOrBelow(threshold), expectedCount);
+
+    for (int frame = 0; frame < 5000; frame += 37) {
+        int expectedNext = -1;
+        for (const QPointF &point : points) {
+            if (point.x() > frame && point.y() <= threshold) {
+                expectedNext = static_cast<int>(point.x());
+                break;
+            }
+        }
+        QCOMPARE(index.nextFrameAtOrBelow(frame, threshold), expectedNext);
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_framevalueindex.moc"
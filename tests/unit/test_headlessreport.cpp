@@ -0,0 +1,254 @@
+/****************************************************************************
+**
+** @file test_headlessreport.cpp
+** @brief Unit tests for HeadlessReport (renderCompare --headless)
+**
+** Tests for:
+** - Frame ranges at or under the threshold
+** - Loading uiData.xml and computing per-event statistics
+** - Report order (failing, missing, passing)
+** - JSON and CSV output
+** - Sibling events sharing sport, stadium, set and frame folders
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "../src/headlessreport.h"
+
+class TestHeadlessReport : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Test cases
+    void testRangesUnderThreshold();
+    void testComputeStats();
+    void testJsonReport();
+    void testCsvReport();
+    void testLoadError();
+    void testSiblingEvents();
+
+private:
+    bool writeFile(const QString &rootPath, const QString &relativePath, const QByteArray &content);
+    bool writeCompareResult(const QString &rootPath, const QString &resultPath, const QVector<double> &values);
+    QByteArray uiDataXml(const QStringList &events) const;
+
+    QTemporaryDir m_resultsDir;
+};
+
+bool TestHeadlessReport::writeFile(const QString &rootPath, const QString &relativePath, const QByteArray &content)
+{
+    const QString path = QDir(rootPath).filePath(relativePath);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return false;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(content) == content.size();
+}
+
+bool TestHeadlessReport::writeCompareResult(const QString &rootPath, const QString &resultPath,
+                                            const QVector<double> &values)
+{
+    QByteArray xml = "<compareResult>\n<frames>\n";
+    for (int i = 0; i < values.size(); ++i) {
+        xml += "<frame><frameIndex>" + QByteArray::number(i) + "</frameIndex><value>"
+               + QByteArray::number(values.at(i)) + "</value></frame>\n";
+    }
+    xml += "</frames>\n</compareResult>\n";
+    return writeFile(rootPath, resultPath + "/results/compareResult.xml", xml);
+}
+
+QByteArray TestHeadlessReport::uiDataXml(const QStringList &events) const
+{
+    // Each event: "id|eventName|testKey"
+    QByteArray uiData = "<uiData>\n<renderVersions><version>v1</version></renderVersions>\n<entries>\n";
+    for (const QString &event : events) {
+        const QStringList fields = event.split('|');
+        uiData += "<entry><id>" + fields[0].toUtf8() + "</id><eventName>" + fields[1].toUtf8()
+                  + "</eventName><sportType/><stadiumName/><categoryName/><numberOfFrames>6</numberOfFrames>"
+                  + "<minValue/><numFramesUnderMin/><thumbnailPath>" + fields[2].toUtf8()
+                  + "</thumbnailPath><status/><notes/><renderVersions>v1</renderVersions></entry>\n";
+    }
+    uiData += "</entries>\n</uiData>\n";
+    return uiData;
+}
+
+void TestHeadlessReport::initTestCase()
+{
+    QVERIFY(m_resultsDir.isValid());
+
+    // Three events: one with two bad ranges, one passing, one without compareResult.xml
+    QVERIFY(writeFile(m_resultsDir.path(), "uiData.xml",
+                      uiDataXml({"1|Final|Soccer/Alpha/Final/Set1/F0100",
+                                 "2|Semi|Tennis/Beta/Semi/Set2/F0200",
+                                 "3|Open|Golf/Gamma/Open/Set3/F0300"})));
+
+    QVERIFY(writeCompareResult(m_resultsDir.path(), "Soccer/Alpha/Final/Set1/F0100",
+                               {0.99, 0.80, 0.85, 0.99, 0.99, 0.70}));
+    QVERIFY(writeCompareResult(m_resultsDir.path(), "Tennis/Beta/Semi/Set2/F0200",
+                               {0.99, 0.98, 0.97, 0.99, 0.99, 0.99}));
+}
+
+void TestHeadlessReport::testRangesUnderThreshold()
+{
+    const QVector<QPointF> points = {{10, 0.5}, {11, 0.95}, {12, 0.5}, {13, 0.9}, {14, 0.4}, {15, 1.0}};
+    const QVector<HeadlessReport::FrameRange> ranges = HeadlessReport::rangesUnderThreshold(points, 0.9);
+    QCOMPARE(ranges.size(), 2);
+    QCOMPARE(ranges[0].first, 10);
+    QCOMPARE(ranges[0].last, 10);
+    QCOMPARE(ranges[1].first, 12);  // Value == threshold counts as bad
+    QCOMPARE(ranges[1].last, 14);
+
+    QVERIFY(HeadlessReport::rangesUnderThreshold(points, 0.1).isEmpty());
+    QVERIFY(HeadlessReport::rangesUnderThreshold(QVector<QPointF>(), 0.9).isEmpty());
+}
+
+void TestHeadlessReport::testComputeStats()
+{
+    HeadlessReport report(0.9);
+    QVERIFY2(report.load(m_resultsDir.path()), qPrintable(report.errorString()));
+    QCOMPARE(report.results().size(), 3);
+    report.computeStats();
+
+    QCOMPARE(report.failingCount(), 1);
+    QCOMPARE(report.missingCount(), 1);
+
+    for (const HeadlessReport::EventResult &result : report.results()) {
+        if (result.eventName == "Final") {
+            QVERIFY(result.isFailing());
+            QCOMPARE(result.testKey, QString("Soccer/Alpha/Final/Set1/F0100"));
+            QCOMPARE(result.stats.frameCount, 6);
+            QCOMPARE(result.stats.framesUnderThreshold, 3);
+            QCOMPARE(result.stats.longestBadRun, 2);
+            QCOMPARE(result.rangesUnderThreshold.size(), 2);
+            QCOMPARE(result.rangesUnderThreshold[0].first, 1);
+            QCOMPARE(result.rangesUnderThreshold[0].last, 2);
+            QCOMPARE(result.rangesUnderThreshold[1].first, 5);
+        } else if (result.eventName == "Semi") {
+            QVERIFY(!result.isFailing());
+            QVERIFY(!result.isMissing());
+            QVERIFY(result.rangesUnderThreshold.isEmpty());
+        } else {
+            QVERIFY(result.isMissing());
+            QVERIFY(result.xmlPath.isEmpty());
+        }
+    }
+}
+
+void TestHeadlessReport::testJsonReport()
+{
+    HeadlessReport report(0.9);
+    QVERIFY(report.load(m_resultsDir.path()));
+    report.computeStats();
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(report.toJson(false), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonObject root = document.object();
+    QCOMPARE(root.value("threshold").toDouble(), 0.9);
+
+    const QJsonObject summary = root.value("summary").toObject();
+    QCOMPARE(summary.value("events").toInt(), 3);
+    QCOMPARE(summary.value("failing").toInt(), 1);
+    QCOMPARE(summary.value("missing").toInt(), 1);
+    QCOMPARE(summary.value("passing").toInt(), 1);
+
+    // Worst first: failing, missing, passing
+    const QJsonArray events = root.value("events").toArray();
+    QCOMPARE(events.size(), 3);
+    QCOMPARE(events[0].toObject().value("status").toString(), QString("fail"));
+    QCOMPARE(events[1].toObject().value("status").toString(), QString("missing"));
+    QCOMPARE(events[2].toObject().value("status").toString(), QString("pass"));
+
+    const QJsonArray ranges = events[0].toObject().value("rangesUnderThreshold").toArray();
+    QCOMPARE(ranges.size(), 2);
+    QCOMPARE(ranges[0].toArray()[0].toInt(), 1);
+    QCOMPARE(ranges[0].toArray()[1].toInt(), 2);
+    QCOMPARE(ranges[1].toArray()[0].toInt(), 5);
+    QCOMPARE(ranges[1].toArray()[1].toInt(), 5);
+
+    // Passing events are left out unless asked for
+    const QJsonArray failingEvents = QJsonDocument::fromJson(report.toJson(true)).object().value("events").toArray();
+    QCOMPARE(failingEvents.size(), 2);
+}
+
+void TestHeadlessReport::testCsvReport()
+{
+    HeadlessReport report(0.9);
+    QVERIFY(report.load(m_resultsDir.path()));
+    report.computeStats();
+
+    const QList<QByteArray> lines = report.toCsv(false).trimmed().split('\n');
+    QCOMPARE(lines.size(), 4);
+    QVERIFY(lines[0].startsWith("id,eventName,testKey,status,frameCount,framesUnderThreshold,longestBadRun,"));
+    QVERIFY(lines[1].startsWith("1,Final,Soccer/Alpha/Final/Set1/F0100,fail,6,3,2,"));
+    QVERIFY(lines[1].contains(",1-2;5,"));
+    QVERIFY(lines[2].startsWith("3,Open,Golf/Gamma/Open/Set3/F0300,missing,,,,"));
+    QVERIFY(lines[3].startsWith("2,Semi,Tennis/Beta/Semi/Set2/F0200,pass,6,0,0,"));
+
+    QCOMPARE(report.toCsv(true).trimmed().split('\n').size(), 3);
+}
+
+void TestHeadlessReport::testLoadError()
+{
+    QTemporaryDir emptyDir;
+    QVERIFY(emptyDir.isValid());
+
+    HeadlessReport report;
+    QVERIFY(!report.load(emptyDir.path()));
+    QVERIFY(report.errorString().contains("uiData.xml"));
+    QVERIFY(report.results().isEmpty());
+}
+
+void TestHeadlessReport::testSiblingEvents()
+{
+    QTemporaryDir resultsDir;
+    QVERIFY(resultsDir.isValid());
+
+    // Production layout: the sport, stadium, set and frame folders are shared, only the event differs
+    const QString first = "MLB/Dodgers/E15_LIVE_10/S170123190428/F0001";
+    const QString second = "MLB/Dodgers/E16_LIVE_11/S170123190428/F0001";
+    const QString secondSet = "MLB/Dodgers/E16_LIVE_11/S170123191502/F0001";
+    QVERIFY(writeFile(resultsDir.path(), "uiData.xml",
+                      uiDataXml({"1|E15_LIVE_10|" + first, "2|E16_LIVE_11|" + second,
+                                 "3|E16_LIVE_11|" + secondSet})));
+    QVERIFY(writeCompareResult(resultsDir.path(), first + "/v1_VS_v2", {0.99, 0.50, 0.99, 0.99, 0.99, 0.99}));
+    QVERIFY(writeCompareResult(resultsDir.path(), second + "/v1_VS_v2", {0.99, 0.99, 0.99, 0.99, 0.99, 0.99}));
+    QVERIFY(writeCompareResult(resultsDir.path(), secondSet + "/v1_VS_v2", {0.80, 0.80, 0.80, 0.99, 0.99, 0.99}));
+
+    HeadlessReport report(0.9);
+    QVERIFY2(report.load(resultsDir.path()), qPrintable(report.errorString()));
+    QCOMPARE(report.results().size(), 3);
+    report.computeStats();
+
+    QCOMPARE(report.missingCount(), 0);
+    QCOMPARE(report.failingCount(), 2);
+    for (const HeadlessReport::EventResult &result : report.results()) {
+        QVERIFY2(QDir::fromNativeSeparators(result.xmlPath).contains("/" + result.testKey + "/"),
+                 qPrintable(result.testKey + " read " + result.xmlPath));
+        if (result.testKey == first) {
+            QCOMPARE(result.stats.framesUnderThreshold, 1);
+        } else if (result.testKey == second) {
+            QCOMPARE(result.stats.framesUnderThreshold, 0);
+        } else {
+            QCOMPARE(result.stats.framesUnderThreshold, 3);
+            QCOMPARE(result.rangesUnderThreshold.size(), 1);
+            QCOMPARE(result.rangesUnderThreshold[0].last, 2);
+        }
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_headlessreport.moc"
@@ -0,0 +1,242 @@
+/****************************************************************************
+**
+** @file test_logarchive.cpp
+** @brief Unit tests for LogArchive and LogSearchModel
+**
+** Tests for:
+** - Append / read back and session directory layout
+** - Text search (case-insensitive substring, also inside words)
+** - Level and test key filters, search field syntax
+** - Segment rotation
+** - Words too long for the token index
+** - Cancelled searches
+** - LogSearchModel (background search, rows from ranges)
+** - LogModel archiving entries beyond its history
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+
+#include "../src/logarchive.h"
+#include "../src/logsearchmodel.h"
+#include "../src/logmodel.h"
+
+class TestLogArchive : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Test cases
+    void testAppendAndRead();
+    void testTextSearch();
+    void testFilters();
+    void testSegmentRotation();
+    void testLongWords();
+    void testCancel();
+    void testSearchModel();
+    void testLogModelArchive();
+
+private:
+    QVector<quint32> lines(const QVector<LogArchive::LineRange> &ranges) const;
+
+    QTemporaryDir m_dir;
+};
+
+void TestLogArchive::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QVector<quint32> TestLogArchive::lines(const QVector<LogArchive::LineRange> &ranges) const
+{
+    QVector<quint32> result;
+    for (const LogArchive::LineRange &range : ranges) {
+        for (quint32 i = 0; i < range.count; ++i) {
+            result.append(range.first + i);
+        }
+    }
+    return result;
+}
+
+void TestLogArchive::testAppendAndRead()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("read")));
+    archive.append(1000, LogModel::Info, QString(), "Loading uiData.xml");
+    archive.append(2000, LogModel::Error, "Soccer/Final/Set1/F0100", QString::fromUtf8("Frame 12 failed \xE2\x9C\x97"));
+    QCOMPARE(archive.lineCount(), quint32(2));
+
+    LogArchive::Line line;
+    QVERIFY(archive.line(1, line));
+    QCOMPARE(line.timeMs, Q_INT64_C(2000));
+    QCOMPARE(line.level, int(LogModel::Error));
+    QCOMPARE(line.testKey, QString("Soccer/Final/Set1/F0100"));
+    QCOMPARE(line.message, QString::fromUtf8("Frame 12 failed \xE2\x9C\x97"));
+    QVERIFY(!archive.line(2, line));
+
+    // Trimmed to the used size on close
+    archive.close();
+    QFile segment(QDir(m_dir.filePath("read")).filePath("segment-0000.log"));
+    QVERIFY(segment.open(QIODevice::ReadOnly));
+    const QList<QByteArray> fileLines = segment.readAll().split('\n');
+    QCOMPARE(fileLines.size(), 3);  // Two lines and the empty rest after the last '\n'
+    QCOMPARE(fileLines[0], QByteArray("1000\t0\t\tLoading uiData.xml"));
+}
+
+void TestLogArchive::testTextSearch()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("text")));
+    archive.append(0, LogModel::Info, QString(), "ImageLoaderManager started");
+    archive.append(0, LogModel::Info, QString(), "timeout reached");
+    archive.append(0, LogModel::Info, QString(), "reached timeout");
+    archive.append(0, LogModel::Info, QString(), "Reached TIMEOUT again");
+
+    LogArchive::Query query;
+    query.text = "loader";  // Inside a word, other case
+    QCOMPARE(lines(archive.search(query)), QVector<quint32>({0}));
+
+    query.text = "reached timeout";  // Phrase, not just both words
+    QCOMPARE(lines(archive.search(query)), QVector<quint32>({2, 3}));
+
+    query.text = "eached time";
+    QCOMPARE(lines(archive.search(query)), QVector<quint32>({2, 3}));
+
+    query.text = "missing";
+    QVERIFY(archive.search(query).isEmpty());
+
+    // Lines 1..3 as one range
+    query.text = "timeout";
+    const QVector<LogArchive::LineRange> ranges = archive.search(query);
+    QCOMPARE(ranges.size(), 1);
+    QCOMPARE(ranges[0].first, quint32(1));
+    QCOMPARE(ranges[0].count, quint32(3));
+}
+
+void TestLogArchive::testFilters()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("filters")));
+    archive.append(0, LogModel::Info, "Soccer/A/Set1/F0001", "Progress: 1/10 frames");
+    archive.append(0, LogModel::Error, "Soccer/A/Set1/F0001", "Compare failed");
+    archive.append(0, LogModel::Error, "Tennis/B/Set2/F0002", "Compare failed");
+    archive.append(0, LogModel::Debug, QString(), "Compare failed");
+
+    const LogArchive::Query errors = LogArchive::Query::parse("failed", 1u << LogModel::Error);
+    QCOMPARE(lines(archive.search(errors)), QVector<quint32>({1, 2}));
+
+    const LogArchive::Query oneTest = LogArchive::Query::parse("key:Soccer/A/Set1/F0001 compare", 0xF);
+    QCOMPARE(oneTest.testKey, QString("Soccer/A/Set1/F0001"));
+    QCOMPARE(oneTest.text, QString("compare"));
+    QCOMPARE(lines(archive.search(oneTest)), QVector<quint32>({1}));
+
+    // Test key only: every line of that test
+    QCOMPARE(lines(archive.search(LogArchive::Query::parse("key:Soccer/A/Set1/F0001", 0xF))), QVector<quint32>({0, 1}));
+    QVERIFY(archive.search(LogArchive::Query::parse("key:Golf/C/Set3/F0003", 0xF)).isEmpty());
+}
+
+void TestLogArchive::testSegmentRotation()
+{
+    LogArchive archive(4096);
+    QVERIFY(archive.open(m_dir.filePath("rotation")));
+    const int lineCount = 500;
+    for (int i = 0; i < lineCount; ++i) {
+        archive.append(i, LogModel::Info, QString(), QString("line %1 of the rotation test").arg(i, 4, 10, QChar('0')));
+    }
+    QVERIFY(archive.segmentCount() > 3);
+    QCOMPARE(archive.lineCount(), quint32(lineCount));
+
+    LogArchive::Line line;
+    QVERIFY(archive.line(0, line));
+    QCOMPARE(line.message, QString("line 0000 of the rotation test"));
+    QVERIFY(archive.line(lineCount - 1, line));
+    QCOMPARE(line.message, QString("line 0499 of the rotation test"));
+
+    LogArchive::Query query;
+    query.text = "line 0123";
+    QCOMPARE(lines(archive.search(query)), QVector<quint32>({123}));
+
+    // Larger than a segment: cut to fit, never lost
+    archive.append(0, LogModel::Info, QString(), QString(10000, 'x'));
+    QVERIFY(archive.line(lineCount, line));
+    QVERIFY(line.message.size() > 4000 && line.message.size() < 4096);
+}
+
+void TestLogArchive::testLongWords()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("long")));
+    const QString hash = QString("a1b2c3d4").repeated(12);  // 96 characters, not indexed
+    archive.append(0, LogModel::Info, QString(), "checksum " + hash);
+    archive.append(0, LogModel::Info, QString(), "unrelated");
+
+    LogArchive::Query query;
+    query.text = "c3d4a1";
+    QCOMPARE(lines(archive.search(query)), QVector<quint32>({0}));
+}
+
+void TestLogArchive::testCancel()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("cancel")));
+    archive.append(0, LogModel::Info, QString(), "match");
+
+    LogArchive::Query query;
+    query.text = "match";
+    QVERIFY(archive.search(query, []() { return true; }).isEmpty());
+    QCOMPARE(archive.search(query, []() { return false; }).size(), 1);
+}
+
+void TestLogArchive::testSearchModel()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("model")));
+    for (int i = 0; i < 100; ++i) {
+        archive.append(i, (i % 10 == 0) ? LogModel::Error : LogModel::Info, QString(), QString("step %1").arg(i));
+    }
+
+    LogSearchModel model(&archive);
+    QVERIFY(!model.active());
+    model.search("step", 1 << LogModel::Error);
+    QTRY_VERIFY(model.active());
+    QCOMPARE(model.count(), 10);
+    QCOMPARE(model.lineAt(3), 30);
+    QCOMPARE(model.data(model.index(3), LogSearchModel::MessageRole).toString(), QString("step 30"));
+    QCOMPARE(model.data(model.index(3), LogSearchModel::LevelRole).toString(), QString("ERROR"));
+    QCOMPARE(model.lineAt(10), -1);
+
+    model.search("step 5", 0xF);  // 5, 50..59
+    QTRY_COMPARE(model.count(), 11);
+    QCOMPARE(model.lineAt(1), 50);
+
+    model.search(QString(), 0xF);  // Empty field: no search
+    QVERIFY(!model.active());
+    QCOMPARE(model.rowCount(), 0);
+}
+
+void TestLogArchive::testLogModelArchive()
+{
+    LogArchive archive;
+    QVERIFY(archive.open(m_dir.filePath("logmodel")));
+    LogModel logModel(2, 16);
+    logModel.setArchive(&archive);
+
+    logModel.append(LogModel::Info, "before");
+    logModel.flush();
+    logModel.setCurrentTestKey("Soccer/A/Set1/F0001");
+    for (int i = 0; i < 4; ++i) {
+        logModel.append(LogModel::Info, QString("during %1").arg(i));
+    }
+    logModel.flush();
+
+    QCOMPARE(logModel.totalCount(), 2);  // History full
+    QCOMPARE(archive.lineCount(), quint32(5));  // Archive has them all
+    QCOMPARE(lines(archive.search(LogArchive::Query::parse("key:Soccer/A/Set1/F0001", 0xF))), QVector<quint32>({1, 2, 3, 4}));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_logarchive.moc"
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** @file test_logmodel.cpp
+** @brief Unit tests for LogModel and MpmcRing
+**
+** Tests for:
+** - MpmcRing FIFO order and full / empty behavior
+** - MpmcRing with concurrent producers and consumers
+** - LogModel rows after a drain
+** - Level filter
+** - History limit (oldest entries evicted)
+** - Logging from worker threads
+** - Clear
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QThread>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/logmodel.h"
+#include "../src/mpmcring.h"
+
+class TestLogModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testRingFifo();
+    void testRingConcurrent();
+    void testAppendAndFlush();
+    void testLevelFilter();
+    void testHistoryLimit();
+    void testWorkerThreads();
+    void testClear();
+
+private:
+    QString messageAt(const LogModel &model, int row) const;
+};
+
+QString TestLogModel::messageAt(const LogModel &model, int row) const
+{
+    return model.data(model.index(row), LogModel::MessageRole).toString();
+}
+
+void TestLogModel::testRingFifo()
+{
+    MpmcRing<int> ring(3);
+    QCOMPARE(ring.capacity(), 4);  // Rounded up to a power of two
+
+    int value = 0;
+    QVERIFY(!ring.pop(value));
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(ring.push(i));
+    }
+    QVERIFY(!ring.push(5));  // Full
+
+    QVERIFY(ring.pop(value));
+    QCOMPARE(value, 1);
+    QVERIFY(ring.push(5));  // Slot free again (next lap)
+    for (int expected = 2; expected <= 5; ++expected) {
+        QVERIFY(ring.pop(value));
+        QCOMPARE(value, expected);
+    }
+    QVERIFY(!ring.pop(value));
+}
+
+void TestLogModel::testRingConcurrent()
+{
+    const int producers = 4;
+    const int perProducer = 20000;
+    MpmcRing<int> ring(64);
+    std::atomic<long long> sum(0);
+    std::atomic<int> popped(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring, p]() {
+            for (int i = 1; i <= perProducer; ++i) {
+                while (!ring.push(p * perProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&]() {
+            int value = 0;
+            while (popped.load() < producers * perProducer) {
+                if (ring.pop(value)) {
+                    sum += value;
+                    ++popped;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // Every value exactly once: 1 + 2 + ... + n
+    const long long n = static_cast<long long>(producers) * perProducer;
+    QCOMPARE(popped.load(), producers * perProducer);
+    QCOMPARE(sum.load(), n * (n + 1) / 2);
+}
+
+void TestLogModel::testAppendAndFlush()
+{
+    LogModel model(100, 16);
+    QSignalSpy addedSpy(&model, &LogModel::entriesAdded);
+
+    model.append(LogModel::Info, "first");
+    model.append(LogModel::Error, "second");
+    model.append(LogModel::Info, QString());  // Ignored
+    QCOMPARE(model.rowCount(), 0);  // Not drained yet
+
+    model.flush();
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(addedSpy.count(), 1);  // One batch
+    QCOMPARE(messageAt(model, 0), QString("first"));
+    QCOMPARE(model.data(model.index(1), LogModel::LevelRole).toString(), QString("ERROR"));
+    QVERIFY(model.data(model.index(0), LogModel::TimestampRole).toString().contains(':'));
+    QVERIFY(model.plainText().endsWith("[ERROR] second"));
+
+    // The queued drain finds nothing left
+    QTest::qWait(10);
+    QCOMPARE(model.rowCount(), 2);
+}
+
+void TestLogModel::testLevelFilter()
+{
+    LogModel model(100, 16);
+    model.append(LogModel::Info, "info");
+    model.append(LogModel::Debug, "debug");
+    model.append(LogModel::Warning, "warning");
+    model.flush();
+
+    model.setShowDebug(false);
+    QCOMPARE(model.count(), 2);
+    QCOMPARE(model.totalCount(), 3);
+    QCOMPARE(messageAt(model, 1), QString("warning"));
+
+    // New entries are filtered as they arrive
+    model.append(LogModel::Debug, "debug 2");
+    model.flush();
+    QCOMPARE(model.count(), 2);
+
+    model.setShowDebug(true);
+    QCOMPARE(model.count(), 4);
+    QCOMPARE(messageAt(model, 3), QString("debug 2"));
+}
+
+void TestLogModel::testHistoryLimit()
+{
+    LogModel model(3, 16);
+    for (int i = 0; i < 5; ++i) {
+        model.append(LogModel::Info, QString::number(i));
+    }
+    model.flush();
+    QCOMPARE(model.totalCount(), 3);
+    QCOMPARE(messageAt(model, 0), QString("2"));
+
+    model.append(LogModel::Info, "5");
+    model.flush();
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(messageAt(model, 0), QString("3"));
+    QCOMPARE(messageAt(model, 2), QString("5"));
+}
+
+void TestLogModel::testWorkerThreads()
+{
+    LogModel model(10000, 8192);
+    const int threadCount = 4;
+    const int perThread = 500;
+
+    QList<QThread *> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.append(QThread::create([&model, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                model.append(LogModel::Info, QString("worker %1 line %2").arg(t).arg(i));
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : threads) {
+        QVERIFY(thread->wait(5000));
+        delete thread;
+    }
+
+    // Drained on the GUI thread by the queued call
+    QTRY_COMPARE(model.totalCount(), threadCount * perThread);
+    QCOMPARE(model.droppedCount(), 0);
+}
+
+void TestLogModel::testClear()
+{
+    LogModel model(100, 16);
+    QSignalSpy clearedSpy(&model, &LogModel::logCleared);
+    model.append(LogModel::Warning, "old");
+    model.flush();
+
+    model.clear();
+    QCOMPARE(clearedSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 0);
+
+    // Only the "Log cleared" note remains
+    model.flush();
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(messageAt(model, 0), QString("Log cleared"));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_logmodel.moc"
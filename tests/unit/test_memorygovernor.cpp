@@ -0,0 +1,327 @@
+/****************************************************************************
+**
+** @file test_memorygovernor.cpp
+** @brief Unit tests for MemoryGovernor
+**
+** Tests for:
+** - MemAvailable parsing from a /proc/meminfo style file
+** - Budget enforcement, lowest priority first, with headroom
+** - Trimming under system memory pressure
+** - Per-cache breakdown and consumer removal
+** - Queued checks requested by the caches
+** - Consumers registering while the callbacks run
+** - ImageLoaderManager byte accounting and release
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QImage>
+#include <QSemaphore>
+#include <thread>
+
+#include "../src/memorygovernor.h"
+#include "../src/imageloadermanager.h"
+
+class TestMemoryGovernor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testReadMeminfo();
+    void testBudgetPriorityOrder();
+    void testSystemPressure();
+    void testBreakdown();
+    void testRemoveConsumer();
+    void testRequestCheck();
+    void testCallbacksUnlocked();
+    void testImageLoaderManagerAccounting();
+
+private:
+    /**
+     * @brief Fake cache holding a byte count; release frees in 1 KB steps
+     */
+    struct FakeCache {
+        qint64 bytes = 0;
+        qint64 released = 0;
+    };
+
+    static int addFake(MemoryGovernor &governor, const QString &name, int priority, FakeCache *cache);
+    static bool writeMeminfo(const QString &path, qint64 availableKb);
+};
+
+int TestMemoryGovernor::addFake(MemoryGovernor &governor, const QString &name, int priority, FakeCache *cache)
+{
+    return governor.addConsumer(name, priority,
+                                [cache]() { return cache->bytes; },
+                                [cache](qint64 bytes) {
+                                    const qint64 steps = (bytes + 1023) / 1024;
+                                    const qint64 freed = qMin(cache->bytes, steps * 1024);
+                                    cache->bytes -= freed;
+                                    cache->released += freed;
+                                    return freed;
+                                });
+}
+
+bool TestMemoryGovernor::writeMeminfo(const QString &path, qint64 availableKb)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    file.write("MemTotal:       16303844 kB\n");
+    file.write("MemFree:          512000 kB\n");
+    file.write(QString("MemAvailable:   %1 kB\n").arg(availableKb).toLatin1());
+    file.write("Buffers:          123456 kB\n");
+    return true;
+}
+
+void TestMemoryGovernor::testReadMeminfo()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("meminfo");
+    QVERIFY(writeMeminfo(path, 8030412));
+    QCOMPARE(MemoryGovernor::readAvailableSystemBytes(path), Q_INT64_C(8030412) * 1024);
+
+    // No such file (e.g. not Linux) or no MemAvailable line
+    QCOMPARE(MemoryGovernor::readAvailableSystemBytes(dir.filePath("missing")), qint64(-1));
+    QFile file(dir.filePath("old"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("MemTotal: 1024 kB\nMemFree: 512 kB\n");
+    file.close();
+    QCOMPARE(MemoryGovernor::readAvailableSystemBytes(file.fileName()), qint64(-1));
+}
+
+void TestMemoryGovernor::testBudgetPriorityOrder()
+{
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());  // No system memory - budget only
+    governor.setBudgetBytes(1000 * 1024);
+
+    FakeCache tiles, images, frames;
+    tiles.bytes = 300 * 1024;
+    images.bytes = 400 * 1024;
+    frames.bytes = 500 * 1024;
+    addFake(governor, "tiles", 0, &tiles);
+    addFake(governor, "frames", 3, &frames);
+    addFake(governor, "images", 1, &images);
+
+    // 1200 KB used, trimmed to 900 KB (10% headroom): tiles go first and are enough
+    governor.enforce();
+    QCOMPARE(tiles.released, qint64(300 * 1024));
+    QCOMPARE(images.released, qint64(0));
+    QCOMPARE(frames.released, qint64(0));
+    QCOMPARE(governor.usedBytes(), qint64(900 * 1024));
+
+    // Grow past the budget again: tiles are empty, so the images give back the excess
+    frames.bytes += 200 * 1024;
+    governor.enforce();
+    QCOMPARE(images.released, qint64(200 * 1024));
+    QCOMPARE(frames.released, qint64(0));
+    QVERIFY(governor.usedBytes() <= 900 * 1024);
+
+    // Under budget nothing is released
+    governor.enforce();
+    QCOMPARE(images.released, qint64(200 * 1024));
+
+    // Budget 0 = unlimited
+    governor.setBudgetBytes(0);
+    frames.bytes += 10 * 1024 * 1024;
+    governor.enforce();
+    QCOMPARE(frames.released, qint64(0));
+    QVERIFY(!governor.underPressure());
+}
+
+void TestMemoryGovernor::testSystemPressure()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("meminfo");
+
+    MemoryGovernor governor;
+    governor.setMeminfoPath(path);
+    governor.setBudgetBytes(0);
+    governor.setMinAvailableBytes(100 * 1024);
+
+    FakeCache tiles, frames;
+    tiles.bytes = 50 * 1024;
+    frames.bytes = 200 * 1024;
+    addFake(governor, "tiles", 0, &tiles);
+    addFake(governor, "frames", 3, &frames);
+
+    // Plenty of memory
+    QVERIFY(writeMeminfo(path, 1024));
+    governor.enforce();
+    QVERIFY(!governor.underPressure());
+    QCOMPARE(governor.availableSystemBytes(), qint64(1024 * 1024));
+    QCOMPARE(tiles.released + frames.released, qint64(0));
+
+    // 30 KB available, 100 KB wanted: the caches give back the 70 KB shortfall, tiles first
+    QVERIFY(writeMeminfo(path, 30));
+    governor.enforce();
+    QVERIFY(governor.underPressure());
+    QCOMPARE(tiles.released, qint64(50 * 1024));
+    QCOMPARE(frames.released, qint64(20 * 1024));
+
+    // Threshold 0 ignores system memory
+    governor.setMinAvailableBytes(0);
+    governor.enforce();
+    QVERIFY(!governor.underPressure());
+    QCOMPARE(frames.released, qint64(20 * 1024));
+}
+
+void TestMemoryGovernor::testBreakdown()
+{
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());
+    governor.setBudgetBytes(100 * 1024);
+
+    FakeCache xml, frames;
+    xml.bytes = 60 * 1024;
+    frames.bytes = 80 * 1024;
+    addFake(governor, "parsedXml", 2, &xml);
+    addFake(governor, "frameRing", 3, &frames);
+
+    QSignalSpy spy(&governor, &MemoryGovernor::usageChanged);
+    governor.enforce();
+    QCOMPARE(spy.count(), 1);
+
+    // Largest first, with what each released
+    const QVariantList breakdown = governor.breakdown();
+    QCOMPARE(breakdown.size(), 2);
+    const QVariantMap first = breakdown.at(0).toMap();
+    const QVariantMap second = breakdown.at(1).toMap();
+    QCOMPARE(first.value("name").toString(), QString("frameRing"));
+    QCOMPARE(first.value("priority").toInt(), 3);
+    QCOMPARE(first.value("bytes").toLongLong(), qint64(80 * 1024));
+    QCOMPARE(first.value("releasedBytes").toLongLong(), qint64(0));
+    QCOMPARE(second.value("name").toString(), QString("parsedXml"));
+    QCOMPARE(second.value("bytes").toLongLong(), qint64(10 * 1024));
+    QCOMPARE(second.value("releasedBytes").toLongLong(), qint64(50 * 1024));
+}
+
+void TestMemoryGovernor::testRemoveConsumer()
+{
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());
+    governor.setBudgetBytes(10 * 1024);
+
+    FakeCache removed, kept;
+    removed.bytes = 100 * 1024;
+    kept.bytes = 5 * 1024;
+    const int id = addFake(governor, "removed", 0, &removed);
+    addFake(governor, "kept", 1, &kept);
+    governor.removeConsumer(id);
+    governor.removeConsumer(12345);  // Unknown ids are ignored
+
+    governor.enforce();
+    QCOMPARE(removed.released, qint64(0));
+    QCOMPARE(governor.usedBytes(), qint64(5 * 1024));
+    QCOMPARE(governor.breakdown().size(), 1);
+}
+
+void TestMemoryGovernor::testRequestCheck()
+{
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());
+    governor.setBudgetBytes(10 * 1024);
+
+    FakeCache cache;
+    cache.bytes = 50 * 1024;
+    addFake(governor, "cache", 0, &cache);
+
+    // A burst of requests (e.g. one per decoded frame) runs one check, later, on the event loop
+    QSignalSpy spy(&governor, &MemoryGovernor::usageChanged);
+    for (int i = 0; i < 10; ++i) {
+        governor.requestCheck();
+    }
+    QCOMPARE(cache.released, qint64(0));
+    QTRY_COMPARE(spy.count(), 1);
+    QVERIFY(cache.bytes <= 9 * 1024);
+    QTest::qWait(20);
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestMemoryGovernor::testCallbacksUnlocked()
+{
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());
+    governor.setBudgetBytes(10 * 1024);
+
+    // While this cache releases, another thread registers a cache (e.g. a second window opening)
+    FakeCache cache, late;
+    cache.bytes = 50 * 1024;
+    late.bytes = 1024;
+    QSemaphore added;
+    bool addedDuringRelease = false;
+    std::thread adder;
+    governor.addConsumer("cache", 0,
+                         [&cache]() { return cache.bytes; },
+                         [&](qint64 bytes) {
+                             if (!adder.joinable()) {
+                                 adder = std::thread([&]() {
+                                     addFake(governor, "late", 1, &late);
+                                     added.release();
+                                 });
+                                 addedDuringRelease = added.tryAcquire(1, 5000);
+                             }
+                             const qint64 freed = qMin(cache.bytes, bytes);
+                             cache.bytes -= freed;
+                             return freed;
+                         });
+
+    governor.enforce();
+    adder.join();
+    QVERIFY(addedDuringRelease);
+    QVERIFY(cache.bytes <= 9 * 1024);
+    QCOMPARE(late.released, qint64(0));
+
+    // The cache added meanwhile counts from the next check on
+    governor.enforce();
+    QCOMPARE(governor.breakdown().size(), 2);
+    QCOMPARE(governor.usedBytes(), cache.bytes + late.bytes);
+}
+
+void TestMemoryGovernor::testImageLoaderManagerAccounting()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    for (int frame = 1; frame <= 3; ++frame) {
+        QImage image(64, 32, QImage::Format_RGB32);
+        image.fill(Qt::darkGray);
+        QVERIFY(image.save(dir.filePath(QString("a_%1.jpg").arg(frame, 4, 10, QChar('0'))), "JPG"));
+    }
+
+    MemoryGovernor governor;
+    governor.setMeminfoPath(QString());
+    governor.setBudgetBytes(0);
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.filePath("a_"), QString(), QString(), QString());
+    manager.setMemoryGovernor(&governor);
+    for (int frame = 1; frame <= 3; ++frame) {
+        QVERIFY(!manager.getImage("A", frame).isNull());
+    }
+
+    const QPixmap pixmap = manager.getImageIfCached("A", 3);
+    const qint64 pixmapBytes = static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    QCOMPARE(manager.getCacheBytes(), 3 * pixmapBytes);
+    governor.enforce();
+    QCOMPARE(governor.usedBytes(), 3 * pixmapBytes);
+
+    // Over budget: the least recently used images go
+    governor.setBudgetBytes(2 * pixmapBytes);
+    governor.enforce();
+    QCOMPARE(manager.getCacheSize(), 1);
+    QCOMPARE(manager.getCacheBytes(), pixmapBytes);
+    QVERIFY(manager.getImageIfCached("A", 1).isNull());
+    QVERIFY(!manager.getImageIfCached("A", 3).isNull());
+
+    manager.clearCache();
+    QCOMPARE(manager.getCacheBytes(), qint64(0));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_memorygovernor.moc"
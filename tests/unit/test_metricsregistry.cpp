@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** @file test_metricsregistry.cpp
+** @brief Unit tests for MetricsRegistry and LatencyHistogram
+**
+** Tests for:
+** - Histogram bucket boundaries
+** - Percentile estimates (within bucket precision)
+** - Concurrent recording from several threads
+** - Snapshot contents (hit rates, gauges, latency percentiles)
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QThread>
+#include <vector>
+#include <memory>
+
+#include "../src/metricsregistry.h"
+
+class TestMetricsRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testBucketBounds();
+    void testPercentiles();
+    void testConcurrentRecording();
+    void testSnapshot();
+};
+
+void TestMetricsRegistry::testBucketBounds()
+{
+    QCOMPARE(LatencyHistogram::bucketIndex(-5), 0);
+    QCOMPARE(LatencyHistogram::bucketIndex(0), 0);
+    QCOMPARE(LatencyHistogram::bucketIndex(3), 3);
+    QCOMPARE(LatencyHistogram::bucketIndex(4), 4);
+    QCOMPARE(LatencyHistogram::bucketIndex(8), 8);
+
+    // Every value lies within its bucket, buckets are at most 25% of their lower bound wide
+    for (qint64 value = 1; value < 100000000; value = value * 3 / 2 + 1) {
+        const int index = LatencyHistogram::bucketIndex(value);
+        const qint64 lower = LatencyHistogram::bucketLowerBound(index);
+        const qint64 upper = LatencyHistogram::bucketLowerBound(index + 1);
+        QVERIFY2(lower <= value && value < upper, qPrintable(QString::number(value)));
+        QVERIFY(upper - lower <= qMax<qint64>(1, lower / 4));
+    }
+
+    // Values beyond the range go into the last bucket
+    QCOMPARE(LatencyHistogram::bucketIndex(Q_INT64_C(1) << 40), LatencyHistogram::BucketCount - 1);
+}
+
+void TestMetricsRegistry::testPercentiles()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(LatencyHistogram::percentileMs(histogram.takeCounts(), 0.5), -1.0);
+
+    for (int i = 0; i < 90; ++i) {
+        histogram.record(1000000);    // 1 ms
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(100000000);  // 100 ms
+    }
+    const QVector<quint64> counts = histogram.takeCounts();
+    const double p50 = LatencyHistogram::percentileMs(counts, 0.50);
+    const double p99 = LatencyHistogram::percentileMs(counts, 0.99);
+    QVERIFY2(qAbs(p50 - 1.0) <= 0.125, qPrintable(QString::number(p50)));
+    QVERIFY2(qAbs(p99 - 100.0) <= 12.5, qPrintable(QString::number(p99)));
+
+    // takeCounts() starts a new window
+    QCOMPARE(LatencyHistogram::percentileMs(histogram.takeCounts(), 0.5), -1.0);
+}
+
+void TestMetricsRegistry::testConcurrentRecording()
+{
+    LatencyHistogram histogram;
+    const int threadCount = 4;
+    const int samplesPerThread = 20000;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(QThread::create([&histogram, t]() {
+            for (int i = 0; i < samplesPerThread; ++i) {
+                histogram.record((t + 1) * 1000000LL);
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const std::unique_ptr<QThread> &thread : threads) {
+        QVERIFY(thread->wait(10000));
+    }
+
+    quint64 total = 0;
+    for (quint64 count : histogram.takeCounts()) {
+        total += count;
+    }
+    QCOMPARE(total, static_cast<quint64>(threadCount * samplesPerThread));  // No sample lost
+}
+
+void TestMetricsRegistry::testSnapshot()
+{
+    MetricsRegistry registry;
+    QSignalSpy spy(&registry, &MetricsRegistry::snapshotChanged);
+    registry.takeSnapshot();  // Drop samples recorded by other tests
+    QCOMPARE(spy.count(), 1);
+
+    MetricsRegistry::increment(MetricsRegistry::TileCacheHits, 3);
+    MetricsRegistry::increment(MetricsRegistry::TileCacheMisses);
+    MetricsRegistry::setGauge(MetricsRegistry::TileCacheBytes, 1024);
+    MetricsRegistry::setGauge(MetricsRegistry::FrameRingBytes, 2048);
+    MetricsRegistry::recordLatency(MetricsRegistry::DecodeLatency, 8000000);  // 8 ms
+    {
+        ScopedLatency latency(MetricsRegistry::XmlParseLatency);
+        QThread::msleep(2);
+    }
+    registry.takeSnapshot();
+
+    QVariantMap snapshot = registry.snapshot();
+    QCOMPARE(snapshot.value("tileCacheHitRate").toDouble(), 0.75);
+    QCOMPARE(snapshot.value("imageCacheHitRate").toDouble(), -1.0);  // No lookups
+    QCOMPARE(snapshot.value("cacheBytes").toLongLong(), Q_INT64_C(3072));
+    QVERIFY(qAbs(snapshot.value("decodeP50Ms").toDouble() - 8.0) <= 1.0);
+    QVERIFY(snapshot.value("xmlParseP99Ms").toDouble() >= 1.75);
+    QCOMPARE(snapshot.value("scrubToPresentP50Ms").toDouble(), -1.0);
+
+    // Percentiles stay until new samples arrive, rates cover the last interval only
+    registry.takeSnapshot();
+    snapshot = registry.snapshot();
+    QVERIFY(qAbs(snapshot.value("decodeP50Ms").toDouble() - 8.0) <= 1.0);
+    QCOMPARE(snapshot.value("decodePerSecond").toDouble(), 0.0);
+    QCOMPARE(snapshot.value("tileCacheHitRate").toDouble(), -1.0);
+
+    // Snapshots are taken periodically only while active
+    QVERIFY(!registry.isActive());
+    registry.setInterval(20);
+    registry.setActive(true);
+    QTRY_VERIFY(spy.count() >= 6);
+    registry.setActive(false);
+    QVERIFY(!registry.isActive());
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_metricsregistry.moc"
@@ -0,0 +1,228 @@
+/****************************************************************************
+**
+** @file test_perfgate.cpp
+** @brief Unit tests for PerfGate (performance regression gate)
+**
+** Tests for:
+** - Median
+** - Mann-Whitney U p-values (exact and normal approximation with ties)
+** - Reading suite results and baseline round trip
+** - Regressed / improved / unchanged / new / missing verdicts
+** - Result table order
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "../perfgate/perfgate.h"
+
+class TestPerfGate : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testMedian();
+    void testMannWhitneyExact();
+    void testMannWhitneyTies();
+    void testReadResults();
+    void testCompare();
+    void testFormatTable();
+
+private:
+    static PerfGate::Case makeCase(const QVector<double> &samples);
+};
+
+PerfGate::Case TestPerfGate::makeCase(const QVector<double> &samples)
+{
+    PerfGate::Case result;
+    result.metric = "WalltimeMilliseconds";
+    result.samples = samples;
+    return result;
+}
+
+void TestPerfGate::testMedian()
+{
+    QCOMPARE(PerfGate::median({}), 0.0);
+    QCOMPARE(PerfGate::median({3.0}), 3.0);
+    QCOMPARE(PerfGate::median({5.0, 1.0, 3.0}), 3.0);
+    QCOMPARE(PerfGate::median({4.0, 1.0, 3.0, 2.0}), 2.5);
+}
+
+void TestPerfGate::testMannWhitneyExact()
+{
+    const QVector<double> baseline = {10.0, 10.2, 9.9, 10.1, 10.05};
+    const QVector<double> slower = {11.0, 11.3, 10.9, 11.1, 11.2};
+
+    // All 5 slower than all 5: 1 of C(10, 5) = 252 orderings
+    QVERIFY(qAbs(PerfGate::mannWhitneyGreater(baseline, slower) - 1.0 / 252.0) < 1e-12);
+    // The other direction is certain
+    QVERIFY(qAbs(PerfGate::mannWhitneyGreater(slower, baseline) - 1.0) < 1e-12);
+
+    // Interleaved samples are not significant
+    const QVector<double> mixed = {9.95, 10.15, 10.03, 9.98, 10.25};
+    QVERIFY(PerfGate::mannWhitneyGreater(baseline, mixed) > 0.2);
+
+    // 3 vs 3, all larger: 1 / C(6, 3)
+    QVERIFY(qAbs(PerfGate::mannWhitneyGreater({1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}) - 1.0 / 20.0) < 1e-12);
+
+    QCOMPARE(PerfGate::mannWhitneyGreater({}, slower), 1.0);
+}
+
+void TestPerfGate::testMannWhitneyTies()
+{
+    // Identical samples: no evidence either way
+    const QVector<double> same = {1.0, 2.0, 2.0, 3.0, 4.0};
+    QVERIFY(PerfGate::mannWhitneyGreater(same, same) > 0.5);
+
+    // All values equal: zero variance
+    QCOMPARE(PerfGate::mannWhitneyGreater({2.0, 2.0, 2.0}, {2.0, 2.0}), 1.0);
+
+    // Clearly larger despite ties (normal approximation)
+    const QVector<double> before = {5.0, 5.0, 6.0, 6.0, 6.0, 7.0, 7.0, 5.0};
+    const QVector<double> after = {8.0, 8.0, 9.0, 9.0, 9.0, 8.0, 10.0, 7.0};
+    QVERIFY(PerfGate::mannWhitneyGreater(before, after) < 0.01);
+
+    // Large samples use the normal approximation too
+    QVector<double> small;
+    QVector<double> large;
+    for (int i = 0; i < 30; ++i) {
+        small.append(100.0 + i);
+        large.append(120.0 + i);
+    }
+    QVERIFY(PerfGate::mannWhitneyGreater(small, large) < 0.001);
+    QVERIFY(PerfGate::mannWhitneyGreater(large, small) > 0.999);
+}
+
+void TestPerfGate::testReadResults()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // Two runs of the suite
+    for (int run = 0; run < 2; ++run) {
+        QJsonObject result;
+        result["benchmark"] = "BenchXmlDataModel::loadToTable";
+        result["tag"] = "1000 entries";
+        result["metric"] = "WalltimeMilliseconds";
+        result["value"] = 60.0 + run;
+        result["iterations"] = 4;
+        QJsonObject untagged;
+        untagged["benchmark"] = "BenchProxyFilter::sort";
+        untagged["tag"] = "";
+        untagged["metric"] = "WalltimeMilliseconds";
+        untagged["value"] = 3.5;
+        QJsonObject root;
+        root["host"] = "build-01";
+        root["results"] = QJsonArray({result, untagged});
+        QFile file(dir.filePath(QString("run-%1.json").arg(run)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    PerfGate::Cases cases;
+    QVERIFY(PerfGate::readResults(dir.filePath("run-0.json"), cases));
+    QVERIFY(PerfGate::readResults(dir.filePath("run-1.json"), cases));
+    QCOMPARE(cases.size(), 2);
+    const PerfGate::Case load = cases.value("BenchXmlDataModel::loadToTable [1000 entries]");
+    QCOMPARE(load.metric, QString("WalltimeMilliseconds"));
+    QCOMPARE(load.samples, QVector<double>({60.0, 61.0}));
+    QCOMPARE(cases.value("BenchProxyFilter::sort").samples.size(), 2);
+
+    // Baseline round trip keeps names, metrics, samples and the environment
+    QJsonObject environment;
+    environment["host"] = "build-01";
+    environment["runs"] = 2;
+    const QString baselinePath = dir.filePath("baseline.json");
+    QVERIFY(PerfGate::writeBaseline(baselinePath, cases, environment));
+    PerfGate::Cases reread;
+    QVERIFY(PerfGate::readResults(baselinePath, reread));
+    QCOMPARE(reread.keys(), cases.keys());
+    QCOMPARE(reread.value("BenchXmlDataModel::loadToTable [1000 entries]").samples, load.samples);
+    QCOMPARE(PerfGate::readEnvironment(baselinePath).value("host").toString(), QString("build-01"));
+    QVERIFY(!PerfGate::readEnvironment(baselinePath).contains("cases"));
+
+    // Errors
+    QString errorString;
+    QVERIFY(!PerfGate::readResults(dir.filePath("missing.json"), reread, &errorString));
+    QVERIFY(!errorString.isEmpty());
+    QFile other(dir.filePath("other.json"));
+    QVERIFY(other.open(QIODevice::WriteOnly));
+    other.write("{\"something\": 1}");
+    other.close();
+    QVERIFY(!PerfGate::readResults(other.fileName(), reread, &errorString));
+}
+
+void TestPerfGate::testCompare()
+{
+    PerfGate::Cases baseline;
+    PerfGate::Cases current;
+    baseline["slower"] = makeCase({10.0, 10.2, 9.9, 10.1, 10.05});
+    current["slower"] = makeCase({11.0, 11.3, 10.9, 11.1, 11.2});         // +10%, significant
+    baseline["faster"] = makeCase({20.0, 20.5, 19.8, 20.2, 20.1});
+    current["faster"] = makeCase({15.0, 15.2, 14.9, 15.1, 15.3});         // -25%, significant
+    baseline["tiny"] = makeCase({10.0, 10.2, 9.9, 10.1, 10.05});
+    current["tiny"] = makeCase({10.3, 10.35, 10.31, 10.32, 10.33});       // Significant but under 5%
+    baseline["noisy"] = makeCase({10.0, 14.0, 8.0, 12.0, 9.0});
+    current["noisy"] = makeCase({11.0, 15.0, 9.0, 13.0, 8.5});            // Slower median, not significant
+    baseline["removed"] = makeCase({1.0, 1.0});
+    current["added"] = makeCase({2.0, 2.0});
+
+    const QVector<PerfGate::Comparison> comparisons = PerfGate::compare(baseline, current, 0.05, 0.05);
+    QCOMPARE(comparisons.size(), 6);
+    QHash<QString, PerfGate::Comparison> byName;
+    for (const PerfGate::Comparison &comparison : comparisons) {
+        byName.insert(comparison.name, comparison);
+    }
+
+    QCOMPARE(byName.value("slower").verdict, PerfGate::Regressed);
+    QVERIFY(qAbs(byName.value("slower").change - (11.1 / 10.05 - 1.0)) < 1e-9);
+    QVERIFY(byName.value("slower").pSlower < 0.01);
+    QCOMPARE(byName.value("faster").verdict, PerfGate::Improved);
+    QCOMPARE(byName.value("tiny").verdict, PerfGate::Unchanged);
+    QCOMPARE(byName.value("noisy").verdict, PerfGate::Unchanged);
+    QCOMPARE(byName.value("removed").verdict, PerfGate::Missing);
+    QCOMPARE(byName.value("added").verdict, PerfGate::Added);
+
+    // A stricter alpha or a larger threshold let the regression pass
+    for (const PerfGate::Comparison &comparison : PerfGate::compare(baseline, current, 0.001, 0.05)) {
+        QVERIFY(comparison.verdict != PerfGate::Regressed);
+    }
+    for (const PerfGate::Comparison &comparison : PerfGate::compare(baseline, current, 0.05, 0.20)) {
+        QVERIFY(comparison.verdict != PerfGate::Regressed);
+    }
+}
+
+void TestPerfGate::testFormatTable()
+{
+    PerfGate::Cases baseline;
+    PerfGate::Cases current;
+    baseline["a::ok"] = makeCase({1.0, 1.0, 1.0});
+    current["a::ok"] = makeCase({1.0, 1.0, 1.0});
+    baseline["b::small"] = makeCase({10.0, 10.1, 10.2, 10.3, 10.4});
+    current["b::small"] = makeCase({11.5, 11.6, 11.7, 11.8, 11.9});     // ~+15%
+    baseline["c::large"] = makeCase({10.0, 10.1, 10.2, 10.3, 10.4});
+    current["c::large"] = makeCase({20.0, 20.1, 20.2, 20.3, 20.4});     // ~+97%
+    const QVector<PerfGate::Comparison> comparisons = PerfGate::compare(baseline, current, 0.05, 0.05);
+
+    // Only changed cases, worst regression first, under a header and rule
+    const QStringList lines = PerfGate::formatTable(comparisons, true).split('\n');
+    QCOMPARE(lines.size(), 4);
+    QVERIFY(lines.at(0).startsWith("Case"));
+    QVERIFY(lines.at(1).startsWith("---"));
+    QVERIFY(lines.at(2).startsWith("c::large"));
+    QVERIFY(lines.at(2).contains("REGRESSED"));
+    QVERIFY(lines.at(2).contains("(n=5)"));
+    QVERIFY(lines.at(3).startsWith("b::small"));
+
+    // With unchanged cases
+    const QString all = PerfGate::formatTable(comparisons, false);
+    QVERIFY(all.contains("a::ok"));
+    QVERIFY(all.contains("+0.0%"));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_perfgate.moc"
@@ -0,0 +1,224 @@
+/****************************************************************************
+**
+** @file test_pixelprobe.cpp
+** @brief Unit tests for ChannelHistogram and PixelProbe
+**
+** Tests for:
+** - Channel histogram counts, clipping and other pixel formats
+** - Samples of every pane from the pixmap cache; panes without images skipped
+** - Panes not decoded yet are requested from the FrameRing and filled in
+** - Viewport histograms: coalesced requests, pane switch, inactive probe
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "../src/channelhistogram.h"
+#include "../src/pixelprobe.h"
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+
+class TestPixelProbe : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test setup
+    void init();
+    void cleanup();
+
+    // Test cases
+    void testHistogramCounts();
+    void testHistogramFormats();
+    void testSamplesFromCache();
+    void testSamplesFromFrameRing();
+    void testViewportHistogram();
+    void testInactive();
+
+private:
+    QString framePath(const QString &imageType, int frameNumber) const;
+
+    QTemporaryDir *m_dir;
+    ImageLoaderManager *m_manager;
+    PixelProbe *m_probe;
+};
+
+void TestPixelProbe::init()
+{
+    // Frames 1-2 for A, B and C (solid colors); no alpha images
+    m_dir = new QTemporaryDir();
+    QVERIFY(m_dir->isValid());
+    const QStringList types = QStringList() << "A" << "B" << "C";
+    const QList<QRgb> colors = QList<QRgb>() << qRgb(200, 40, 40) << qRgb(40, 200, 40) << qRgb(40, 40, 200);
+    for (int i = 0; i < types.size(); ++i) {
+        QDir(m_dir->path()).mkdir(types.at(i));
+        QImage frame(40, 20, QImage::Format_RGB32);
+        frame.fill(colors.at(i));
+        for (int frameNumber = 1; frameNumber <= 2; ++frameNumber) {
+            QVERIFY(frame.save(framePath(types.at(i), frameNumber)));
+        }
+    }
+
+    m_manager = new ImageLoaderManager();
+    m_manager->setImagePaths(m_dir->filePath("A") + "/", m_dir->filePath("B") + "/",
+                             m_dir->filePath("C") + "/", QString());
+    m_probe = new PixelProbe();
+    m_probe->setImageLoaderManager(m_manager);
+    m_probe->setActive(true);
+}
+
+void TestPixelProbe::cleanup()
+{
+    delete m_probe;
+    delete m_manager;
+    delete m_dir;
+}
+
+QString TestPixelProbe::framePath(const QString &imageType, int frameNumber) const
+{
+    return m_dir->filePath(QString("%1/%2.jpg").arg(imageType).arg(frameNumber, 4, 10, QChar('0')));
+}
+
+void TestPixelProbe::testHistogramCounts()
+{
+    // Odd width so rows end outside the unrolled groups
+    QImage image(7, 3, QImage::Format_RGB32);
+    image.fill(qRgb(10, 20, 30));
+    image.setPixel(0, 0, qRgb(255, 0, 128));
+    image.setPixel(6, 2, qRgb(255, 0, 128));
+
+    const ChannelHistogram histogram = ChannelHistogram::compute(image, image.rect());
+    QVERIFY(histogram.isValid());
+    QCOMPARE(histogram.pixelCount, 21);
+    QCOMPARE(histogram.red.size(), ChannelHistogram::Bins);
+    QCOMPARE(histogram.red.at(10), 19u);
+    QCOMPARE(histogram.red.at(255), 2u);
+    QCOMPARE(histogram.green.at(20), 19u);
+    QCOMPARE(histogram.green.at(0), 2u);
+    QCOMPARE(histogram.blue.at(30), 19u);
+    QCOMPARE(histogram.blue.at(128), 2u);
+    QCOMPARE(histogram.maxCount(), 19u);
+
+    // Clipped region
+    const ChannelHistogram corner = ChannelHistogram::compute(image, QRect(-3, -3, 4, 4));
+    QCOMPARE(corner.pixelCount, 1);
+    QCOMPARE(corner.red.at(255), 1u);
+    QVERIFY(!ChannelHistogram::compute(image, QRect(20, 0, 5, 5)).isValid());
+    QCOMPARE(ChannelHistogram().maxCount(), 0u);
+}
+
+void TestPixelProbe::testHistogramFormats()
+{
+    QImage image(9, 5, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, qRgba(x * 20, y * 40, x + y, 255));
+        }
+    }
+    const QRect rect(2, 1, 5, 3);
+    const ChannelHistogram argb = ChannelHistogram::compute(image, rect);
+    const ChannelHistogram rgb888 = ChannelHistogram::compute(image.convertToFormat(QImage::Format_RGB888), rect);
+    QCOMPARE(rgb888.pixelCount, 15);
+    QCOMPARE(rgb888.red, argb.red);
+    QCOMPARE(rgb888.green, argb.green);
+    QCOMPARE(rgb888.blue, argb.blue);
+}
+
+void TestPixelProbe::testSamplesFromCache()
+{
+    QSignalSpy changed(m_probe, &PixelProbe::samplesChanged);
+    QVERIFY(!m_manager->getImage("A", 1).isNull());
+    QVERIFY(!m_manager->getImage("B", 1).isNull());
+    QVERIFY(!m_manager->getImage("C", 1).isNull());
+
+    m_probe->probe(1, QPointF(5.7, 3.2));
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(m_probe->position(), QPoint(5, 3));
+
+    // A, B and C; no alpha images
+    const QVariantList samples = m_probe->samples();
+    QCOMPARE(samples.size(), 3);
+    const QStringList types = QStringList() << "A" << "B" << "C";
+    for (int i = 0; i < samples.size(); ++i) {
+        const QVariantMap sample = samples.at(i).toMap();
+        QCOMPARE(sample.value("type").toString(), types.at(i));
+        QVERIFY(sample.value("valid").toBool());
+        const QRgb expected = QImage(framePath(types.at(i), 1)).pixel(5, 3);
+        QCOMPARE(sample.value("r").toInt(), qRed(expected));
+        QCOMPARE(sample.value("g").toInt(), qGreen(expected));
+        QCOMPARE(sample.value("b").toInt(), qBlue(expected));
+    }
+
+    // Same pixel again: nothing to update
+    m_probe->probe(1, QPointF(5.1, 3.9));
+    QCOMPARE(changed.count(), 1);
+
+    // Not decoded and no FrameRing: not valid
+    m_probe->probe(2, QPointF(5, 3));
+    QVERIFY(!m_probe->samples().first().toMap().value("valid").toBool());
+}
+
+void TestPixelProbe::testSamplesFromFrameRing()
+{
+    FrameRing ring;
+    ring.setImageLoaderManager(m_manager);
+    m_probe->setFrameRing(&ring);
+
+    // Requested from the ring, filled in when decoded
+    m_probe->probe(2, QPointF(1, 1));
+    QVERIFY(!m_probe->samples().first().toMap().value("valid").toBool());
+    QTRY_VERIFY(ring.containsFrameSet(2, QStringList() << "A" << "B" << "C"));
+    QTRY_VERIFY(m_probe->samples().last().toMap().value("valid").toBool());
+    for (const QVariant &sample : m_probe->samples()) {
+        QVERIFY(sample.toMap().value("valid").toBool());
+    }
+    m_probe->setFrameRing(nullptr);
+}
+
+void TestPixelProbe::testViewportHistogram()
+{
+    QSignalSpy changed(m_probe, &PixelProbe::histogramChanged);
+
+    // Burst of viewports: the first starts, the rest collapse into the latest
+    for (int i = 0; i < 20; ++i) {
+        m_probe->requestHistogram(1, QRectF(0, 0, 10 + i, 10));
+    }
+    QTRY_COMPARE(m_probe->histogramPixels(), 29 * 10);
+    QVERIFY(changed.count() <= 2);
+
+    // Read from disk (not decoded): solid color, so one bin holds every pixel
+    const QRgb color = QImage(framePath("A", 1)).pixel(0, 0);
+    QCOMPARE(m_probe->channelHistogram().red.at(qRed(color)), 290u);
+    QCOMPARE(m_probe->histogramMax(), 290);
+    QCOMPARE(m_probe->histogram().size(), 3);
+
+    // From the pixmap cache after switching panes; clipped to the image
+    QVERIFY(!m_manager->getImage("B", 1).isNull());
+    m_probe->setHistogramType("B");
+    QCOMPARE(m_probe->histogramPixels(), 0);
+    m_probe->requestHistogram(1, QRectF(30, 10, 100, 100));
+    QTRY_COMPARE(m_probe->histogramPixels(), 10 * 10);
+    const QRgb green = QImage(framePath("B", 1)).pixel(35, 15);
+    QCOMPARE(m_probe->channelHistogram().green.at(qGreen(green)), 100u);
+
+    m_probe->clear();
+    QCOMPARE(m_probe->histogramPixels(), 0);
+    QVERIFY(m_probe->samples().isEmpty());
+}
+
+void TestPixelProbe::testInactive()
+{
+    m_probe->setActive(false);
+    QSignalSpy samples(m_probe, &PixelProbe::samplesChanged);
+    QSignalSpy histogram(m_probe, &PixelProbe::histogramChanged);
+    m_probe->probe(1, QPointF(1, 1));
+    m_probe->requestHistogram(1, QRectF(0, 0, 10, 10));
+    QTest::qWait(50);
+    QCOMPARE(samples.count(), 0);
+    QCOMPARE(histogram.count(), 0);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_pixelprobe.moc"
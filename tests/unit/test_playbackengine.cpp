@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** @file test_playbackengine.cpp
+** @brief Unit tests for PlaybackEngine and its FrameRing
+**
+** Tests for:
+** - Elapsed-time frame targeting (forward, reverse, clamping)
+** - Skipping to the newest ready frame
+** - Background decode into FrameRing and frameSource() URLs
+** - Ring eviction
+** - Canceling one requester's queued decodes keeps the others', decodes each frame once
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QSet>
+
+#include "../src/playbackengine.h"
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+
+class TestPlaybackEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testTargetFrame();
+    void testPickReadyFrame();
+    void testFrameRingDecode();
+    void testFrameRingEviction();
+    void testFrameRingCancelQueued();
+};
+
+void TestPlaybackEngine::testTargetFrame()
+{
+    // 100ms per frame: 350ms after frame 10 the clock is at frame 13
+    QCOMPARE(PlaybackEngine::targetFrame(10, 1, 350, 100, 1, 100), 13);
+    QCOMPARE(PlaybackEngine::targetFrame(10, -1, 350, 100, 1, 100), 7);
+
+    // Clamped to the range
+    QCOMPARE(PlaybackEngine::targetFrame(98, 1, 1000, 100, 1, 100), 100);
+    QCOMPARE(PlaybackEngine::targetFrame(3, -1, 1000, 100, 1, 100), 1);
+}
+
+void TestPlaybackEngine::testPickReadyFrame()
+{
+    QSet<int> ready = { 11, 12, 14 };
+    auto isReady = [&ready](int frame) { return ready.contains(frame); };
+
+    // Target ready: show it (frames in between are skipped)
+    QCOMPARE(PlaybackEngine::pickReadyFrame(10, 14, isReady), 14);
+    // Target not ready: newest ready frame before it
+    QCOMPARE(PlaybackEngine::pickReadyFrame(10, 13, isReady), 12);
+    // Nothing ready: stay
+    QCOMPARE(PlaybackEngine::pickReadyFrame(14, 16, isReady), 14);
+    // Reverse
+    QCOMPARE(PlaybackEngine::pickReadyFrame(16, 13, isReady), 14);
+}
+
+void TestPlaybackEngine::testFrameRingDecode()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QImage frame(16, 8, QImage::Format_RGB32);
+    frame.fill(Qt::red);
+    QVERIFY(frame.save(dir.filePath("0001.jpg")));
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    PlaybackEngine engine;
+    engine.setImageLoaderManager(&manager);
+    FrameRing *ring = engine.frameRing();
+
+    // Not decoded yet: plain file URL
+    QVERIFY(engine.frameSource("A", 1).startsWith("file:///"));
+
+    QSignalSpy decodedSpy(ring, &FrameRing::frameDecoded);
+    ring->request("A", 1);
+    QTRY_VERIFY(ring->contains("A", 1));
+    QTRY_COMPARE(decodedSpy.count(), 1);
+    QCOMPARE(ring->image("A", 1).size(), QSize(16, 8));
+    QVERIFY(ring->containsFrameSet(1, QStringList() << "A"));
+    QVERIFY(!ring->containsFrameSet(1, QStringList() << "A" << "B"));
+    QCOMPARE(engine.frameSource("A", 1), QString("image://frames/A/1"));
+
+    // Switching events drops decoded frames
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    QCOMPARE(ring->size(), 0);
+}
+
+void TestPlaybackEngine::testFrameRingEviction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QImage frame(8, 8, QImage::Format_RGB32);
+    frame.fill(Qt::blue);
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(frame.save(dir.filePath(QString("%1.jpg").arg(i, 4, 10, QChar('0')))));
+    }
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    FrameRing ring;
+    ring.setImageLoaderManager(&manager);
+    for (int i = 1; i <= 4; ++i) {
+        ring.request("A", i);
+    }
+    QTRY_COMPARE(ring.size(), 4);
+
+    ring.retainRange(2, 3);
+    QCOMPARE(ring.size(), 2);
+    QVERIFY(!ring.contains("A", 1));
+    QVERIFY(ring.contains("A", 3));
+}
+
+void TestPlaybackEngine::testFrameRingCancelQueued()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QImage frame(256, 256, QImage::Format_RGB32);
+    frame.fill(Qt::green);
+    for (int i = 1; i <= 12; ++i) {
+        QVERIFY(frame.save(dir.filePath(QString("%1.jpg").arg(i, 4, 10, QChar('0')))));
+    }
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.path() + "/", QString(), QString(), QString());
+    FrameRing ring;
+    ring.setImageLoaderManager(&manager);
+    ring.setCapacity(32);
+    QObject context;
+    QHash<int, int> decoded;
+    connect(&ring, &FrameRing::frameDecoded, &context, [&decoded](const QString &, int frameNumber) {
+        ++decoded[frameNumber];
+    }, Qt::QueuedConnection);
+
+    // A scrubber and a decode-ahead share the ring (and frame 3)
+    QObject scrubber;
+    QObject decodeAhead;
+    for (int i = 1; i <= 8; ++i) {
+        QVERIFY(ring.request("A", i, &scrubber));
+    }
+    for (int i = 9; i <= 12; ++i) {
+        QVERIFY(ring.request("A", i, &decodeAhead));
+    }
+    QVERIFY(ring.request("A", 3, &decodeAhead));
+
+    // The scrubber moved on: the decode-ahead's frames are decoded anyway
+    ring.cancelQueued(&scrubber);
+    QTRY_VERIFY(ring.containsFrameSet(3, {"A"}));
+    for (int i = 9; i <= 12; ++i) {
+        QTRY_VERIFY(ring.contains("A", i));
+    }
+
+    // Requested again, including decodes that were running: each decoded only once
+    for (int i = 1; i <= 8; ++i) {
+        QVERIFY(ring.request("A", i, &scrubber));
+    }
+    QTRY_COMPARE(ring.size(), 12);
+    QTest::qWait(50);
+    for (int i = 1; i <= 12; ++i) {
+        QCOMPARE(decoded.value(i), 1);
+    }
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_playbackengine.moc"
@@ -0,0 +1,309 @@
+/****************************************************************************
+**
+** @file test_proxybuilder.cpp
+** @brief Unit tests for scrub proxies (ProxySequence, ProxyBuilder)
+**
+** Tests for:
+** - Proxy file round trip, frames without a proxy, damaged and truncated files rejected
+** - Proxy files over 2 GB (sparse file)
+** - Background build at reduced size; proxies reused until a sequence is re-rendered
+**   or the size limit changes
+** - FrameSetPresenter shows proxies at once and full resolution once scrubbing pauses
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDataStream>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "../src/proxysequence.h"
+#include "../src/proxybuilder.h"
+#include "../src/qoicodec.h"
+#include "../src/framesetpresenter.h"
+#include "../src/framering.h"
+#include "../src/imageloadermanager.h"
+
+class TestProxyBuilder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test setup
+    void init();
+    void cleanup();
+
+    // Test cases
+    void testSequenceRoundTrip();
+    void testInvalidSequence();
+    void testLargeSequence();
+    void testBuild();
+    void testRebuildRerendered();
+    void testRebuildMaxDimension();
+    void testPresenterProxies();
+
+private:
+    void buildProxies();
+
+    QTemporaryDir *m_dir;
+    ImageLoaderManager *m_manager;
+    ProxyBuilder *m_builder;
+};
+
+void TestProxyBuilder::init()
+{
+    // Frames 1-4 of A and B at 200x100; nothing for C
+    m_dir = new QTemporaryDir();
+    QVERIFY(m_dir->isValid());
+    QDir(m_dir->path()).mkdir("A");
+    QDir(m_dir->path()).mkdir("B");
+    QDir(m_dir->path()).mkdir("cache");
+    for (int i = 1; i <= 4; ++i) {
+        QImage frame(200, 100, QImage::Format_RGB32);
+        frame.fill(qRgb(i * 50, 120, 200));
+        const QString name = QString("%1.jpg").arg(i, 4, 10, QChar('0'));
+        QVERIFY(frame.save(m_dir->filePath("A/" + name)));
+        QVERIFY(frame.save(m_dir->filePath("B/" + name)));
+    }
+
+    m_manager = new ImageLoaderManager();
+    m_manager->setImagePaths(m_dir->filePath("A") + "/", m_dir->filePath("B") + "/",
+                             m_dir->filePath("C") + "/", QString());
+    m_builder = new ProxyBuilder();
+    m_builder->setImageLoaderManager(m_manager);
+    m_builder->setCacheDirectory(m_dir->filePath("cache"));
+    m_builder->setMaxDimension(64);
+}
+
+void TestProxyBuilder::cleanup()
+{
+    delete m_builder;
+    delete m_manager;
+    delete m_dir;
+}
+
+void TestProxyBuilder::buildProxies()
+{
+    QSignalSpy finishedSpy(m_builder, &ProxyBuilder::buildFinished);
+    m_builder->open(1, 4);
+    QVERIFY(m_builder->isBuilding());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QVERIFY(finishedSpy.at(0).at(0).toBool());
+    QVERIFY(!m_builder->isBuilding());
+}
+
+void TestProxyBuilder::testSequenceRoundTrip()
+{
+    QImage frame(30, 20, QImage::Format_RGB32);
+    frame.fill(qRgb(10, 200, 90));
+    const QString filePath = m_dir->filePath("cache/sequence.rcproxy");
+
+    ProxySequenceWriter writer(filePath);
+    QVERIFY(writer.begin("/renders/A/", 1234, 640, 10, 3));
+    QVERIFY(writer.addFrame(QoiCodec::encode(frame)));
+    QVERIFY(writer.addFrame(QByteArray()));  // Frame 11 couldn't be read
+    QVERIFY(writer.addFrame(QoiCodec::encode(frame)));
+    QVERIFY(!writer.addFrame(QoiCodec::encode(frame)));  // More than announced
+    QVERIFY(writer.commit(QSize(300, 200)));
+
+    ProxySequence sequence;
+    QVERIFY(sequence.open(filePath));
+    QCOMPARE(sequence.sourcePath(), QString("/renders/A/"));
+    QCOMPARE(sequence.sourceStamp(), qint64(1234));
+    QCOMPARE(sequence.maxDimension(), 640);
+    QCOMPARE(sequence.firstFrame(), 10);
+    QCOMPARE(sequence.frameCount(), 3);
+    QCOMPARE(sequence.sourceSize(), QSize(300, 200));
+    QVERIFY(sequence.contains(10));
+    QVERIFY(!sequence.contains(11));
+    QVERIFY(!sequence.contains(13));
+    QCOMPARE(sequence.frame(12), frame);
+    QVERIFY(sequence.frame(11).isNull());
+
+    // A canceled rewrite keeps the committed file
+    ProxySequenceWriter canceled(filePath);
+    QVERIFY(canceled.begin("/renders/A/", 5678, 640, 10, 3));
+    canceled.cancel();
+    ProxySequence reopened;
+    QVERIFY(reopened.open(filePath));
+    QCOMPARE(reopened.sourceStamp(), qint64(1234));
+}
+
+void TestProxyBuilder::testInvalidSequence()
+{
+    ProxySequence sequence;
+    QVERIFY(!sequence.open(m_dir->filePath("cache/missing.rcproxy")));
+
+    QFile file(m_dir->filePath("cache/damaged.rcproxy"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(64, 'x'));
+    file.close();
+    QVERIFY(!sequence.open(file.fileName()));
+    QVERIFY(!sequence.isOpen());
+
+    // A valid header announcing far more frames than the file holds is rejected before the index is read
+    QFile truncated(m_dir->filePath("cache/truncated.rcproxy"));
+    QVERIFY(truncated.open(QIODevice::WriteOnly));
+    QDataStream stream(&truncated);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << quint32(0x52435058) << quint32(2) << QString("/renders/A/") << qint64(1234) << qint32(640) << qint32(1)
+           << qint32(200000000) << qint32(300) << qint32(200) << qint64(0) << qint32(0);
+    truncated.close();
+    QVERIFY(!sequence.open(truncated.fileName()));
+    QVERIFY(!sequence.isOpen());
+    QCOMPARE(sequence.frameCount(), 0);
+
+    QCOMPARE(ProxySequence::fileNameFor("/renders/A/"), ProxySequence::fileNameFor("/renders//A/"));
+    QVERIFY(ProxySequence::fileNameFor("/renders/A/") != ProxySequence::fileNameFor("/renders/B/"));
+}
+
+void TestProxyBuilder::testLargeSequence()
+{
+    // Frame 2 stored past 3 GB: the index must be read and checked with 64-bit offsets
+    QImage frame(30, 20, QImage::Format_RGB32);
+    frame.fill(qRgb(10, 200, 90));
+    const QByteArray data = QoiCodec::encode(frame);
+    const qint64 offset = 3LL * 1024 * 1024 * 1024;
+    auto writeSparse = [&](const QString &filePath, qint64 fileSize) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << quint32(0x52435058) << quint32(2) << QString("/renders/A/") << qint64(1234) << qint32(640)
+               << qint32(1) << qint32(2) << qint32(300) << qint32(200) << qint64(0) << qint32(0) << offset
+               << qint32(data.size());
+        return file.resize(fileSize) && file.seek(offset) && file.write(data.left(fileSize - offset)) > 0;
+    };
+
+    const QString filePath = m_dir->filePath("cache/large.rcproxy");
+    if (!writeSparse(filePath, offset + data.size())) {
+        QSKIP("No sparse file support in the temporary directory");
+    }
+    ProxySequence sequence;
+    QVERIFY(sequence.open(filePath));
+    QCOMPARE(sequence.frameCount(), 2);
+    QVERIFY(!sequence.contains(1));
+    QVERIFY(sequence.contains(2));
+    QCOMPARE(sequence.frame(2), frame);
+
+    // Same index, but the last frame runs past the end of the file
+    const QString truncatedPath = m_dir->filePath("cache/large-truncated.rcproxy");
+    QVERIFY(writeSparse(truncatedPath, offset + data.size() - 1));
+    ProxySequence truncated;
+    QVERIFY(!truncated.open(truncatedPath));
+    QVERIFY(!truncated.isOpen());
+
+    QFile::remove(filePath);
+    QFile::remove(truncatedPath);
+}
+
+void TestProxyBuilder::testBuild()
+{
+    buildProxies();
+    QCOMPARE(m_builder->proxyTypes(), QStringList({"A", "B"}));
+    QCOMPARE(m_builder->progress(), 0.0);
+
+    const QImage proxy = m_builder->frame("A", 2);
+    QCOMPARE(proxy.size(), QSize(64, 32));
+    QVERIFY(qAbs(qRed(proxy.pixel(32, 16)) - 100) < 8);  // JPEG rounding
+    QCOMPARE(m_builder->frameSource("A", 2), QString("image://proxies/A/2"));
+    QVERIFY(m_builder->frameSource("C", 2).isEmpty());
+    QVERIFY(m_builder->frameSource("A", 5).isEmpty());
+    QVERIFY(m_builder->containsFrameSet(2, {"A", "B"}));
+    QVERIFY(!m_builder->containsFrameSet(2, {"A", "C"}));
+
+    // Reopening the event reuses the proxy files
+    QSignalSpy finishedSpy(m_builder, &ProxyBuilder::buildFinished);
+    m_builder->open(1, 4);
+    QVERIFY(!m_builder->isBuilding());
+    QCOMPARE(m_builder->proxyTypes(), QStringList({"A", "B"}));
+    QCOMPARE(finishedSpy.count(), 0);
+
+    // Switching events closes them
+    m_manager->setImagePaths(m_dir->filePath("B") + "/", QString(), QString(), QString());
+    QVERIFY(m_builder->proxyTypes().isEmpty());
+    QVERIFY(m_builder->frame("A", 2).isNull());
+}
+
+void TestProxyBuilder::testRebuildRerendered()
+{
+    buildProxies();
+
+    // A re-rendered: its last frame is newer than the proxy
+    QImage frame(200, 100, QImage::Format_RGB32);
+    frame.fill(Qt::white);
+    QVERIFY(frame.save(m_dir->filePath("A/0004.jpg")));
+    QFile file(m_dir->filePath("A/0004.jpg"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+
+    QSignalSpy finishedSpy(m_builder, &ProxyBuilder::buildFinished);
+    m_builder->refresh();
+    QVERIFY(m_builder->isBuilding());
+    QCOMPARE(m_builder->proxyTypes(), QStringList({"B"}));  // The old A proxies are not shown
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(m_builder->proxyTypes(), QStringList({"A", "B"}));
+    QCOMPARE(qRed(m_builder->frame("A", 4).pixel(10, 10)), 255);
+}
+
+void TestProxyBuilder::testRebuildMaxDimension()
+{
+    buildProxies();
+    QCOMPARE(m_builder->frame("A", 2).size(), QSize(64, 32));
+
+    // A new size limit rebuilds the open event's proxies at once
+    QSignalSpy finishedSpy(m_builder, &ProxyBuilder::buildFinished);
+    m_builder->setMaxDimension(100);
+    QVERIFY(m_builder->isBuilding());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(m_builder->frame("A", 2).size(), QSize(100, 50));
+
+    // Proxies of another size limit are not reused by a later session
+    ProxyBuilder other;
+    other.setImageLoaderManager(m_manager);
+    other.setCacheDirectory(m_dir->filePath("cache"));
+    other.setMaxDimension(64);
+    QSignalSpy otherFinishedSpy(&other, &ProxyBuilder::buildFinished);
+    other.open(1, 4);
+    QVERIFY(other.isBuilding());
+    QTRY_COMPARE(otherFinishedSpy.count(), 1);
+    QCOMPARE(other.frame("A", 2).size(), QSize(64, 32));
+}
+
+void TestProxyBuilder::testPresenterProxies()
+{
+    buildProxies();
+    FrameRing ring;
+    ring.setImageLoaderManager(m_manager);
+    FrameSetPresenter presenter(&ring);
+    presenter.setProxyBuilder(m_builder);
+    presenter.setSettleMs(50);
+    QSignalSpy readySpy(&presenter, &FrameSetPresenter::frameSetReady);
+
+    // Not decoded yet: presented from the proxies at once
+    presenter.requestFrame(3, {"A", "B"});
+    QCOMPARE(readySpy.count(), 1);
+    QCOMPARE(readySpy.at(0).at(0).toInt(), 3);
+    QVERIFY(presenter.proxyFrames());
+    QVERIFY(!ring.contains("A", 3));
+
+    // Scrubbing paused: presented again at full resolution
+    QTRY_COMPARE(readySpy.count(), 2);
+    QCOMPARE(readySpy.at(1).at(0).toInt(), 3);
+    QVERIFY(!presenter.proxyFrames());
+    QVERIFY(ring.containsFrameSet(3, {"A", "B"}));
+    QCOMPARE(presenter.presentedFrameSets(), 1);
+    QCOMPARE(presenter.droppedFrameSets(), 0);
+    QCOMPARE(presenter.tornFrameSets(), 0);
+
+    // Decoded frame sets don't use the proxies
+    presenter.requestFrame(3, {"A", "B"});
+    QCOMPARE(readySpy.count(), 3);
+    QVERIFY(!presenter.proxyFrames());
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_proxybuilder.moc"
@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** @file test_resultsgen.cpp
+** @brief Unit tests for ResultsGenerator (synthetic results trees)
+**
+** Tests for:
+** - Test keys derived by XmlDataLoader match the generated layout
+** - compareResult.xml lookup with shared sport / stadium / event folders
+** - Image paths resolved by XmlDataModel point at the generated sequences
+** - Value distributions and uiData.xml numFramesUnderMin
+** - Same seed, same tree
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QImageReader>
+#include <QDomDocument>
+
+#include "../src/xmldatamodel.h"
+#include "../resultsgen/resultsgen.h"
+
+class TestResultsGenerator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testLayout();
+    void testCompareResultLookup();
+    void testImageSequences();
+    void testDistributions();
+    void testDeterministic();
+
+private:
+    static ResultsGenerator::Options smallOptions();
+    static bool loadModel(XmlDataModel &model, const QString &resultsPath);
+    static QByteArray readFile(const QString &path);
+};
+
+ResultsGenerator::Options TestResultsGenerator::smallOptions()
+{
+    ResultsGenerator::Options options;
+    options.entryCount = 12;
+    options.entriesPerEvent = 4;
+    options.frameCount = 40;
+    options.versionCount = 2;
+    options.notReadyPercent = 20;
+    options.imageSize = QSize(64, 36);
+    options.seed = 7;
+    return options;
+}
+
+bool TestResultsGenerator::loadModel(XmlDataModel &model, const QString &resultsPath)
+{
+    QSignalSpy finished(&model, &XmlDataModel::loadingFinished);
+    if (!model.loadData(resultsPath) || !finished.wait(10000)) {
+        return false;
+    }
+    return finished.first().at(0).toBool();
+}
+
+QByteArray TestResultsGenerator::readFile(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void TestResultsGenerator::testLayout()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const ResultsGenerator::Options options = smallOptions();
+    ResultsGenerator::Stats stats;
+    QString errorString;
+    QVERIFY2(ResultsGenerator::generate(dir.path(), options, &stats, ResultsGenerator::ProgressFunction(), &errorString),
+             qPrintable(errorString));
+
+    int ready = 0;
+    for (int i = 0; i < options.entryCount; ++i) {
+        ready += ResultsGenerator::isReady(i, options) ? 1 : 0;
+    }
+    QVERIFY(ready > 0 && ready < options.entryCount);  // Seed 7 writes both kinds
+    QCOMPARE(stats.entries, options.entryCount);
+    QCOMPARE(stats.compareResults, ready * options.versionCount);
+    QCOMPARE(stats.images, qint64(0));
+
+    // Five levels; entries of one event share the sport, stadium and event folders
+    const QString key = ResultsGenerator::testKey(0, options);
+    QCOMPARE(key.split('/').size(), 5);
+    QVERIFY(QRegularExpression("/F\\d{4}$").match(key).hasMatch());
+    QCOMPARE(ResultsGenerator::testKey(1, options).section('/', 0, 2), key.section('/', 0, 2));
+    QVERIFY(ResultsGenerator::testKey(1, options) != key);
+    QVERIFY(ResultsGenerator::testKey(4, options).section('/', 2, 2) != key.section('/', 2, 2));
+
+    // XmlDataLoader derives the same test keys from the thumbnail paths (image or, Not Ready, folder)
+    XmlDataModel model;
+    QVERIFY(loadModel(model, dir.path()));
+    QCOMPARE(model.rowCount(), options.entryCount);
+    QCOMPARE(model.getFreeDViewVerList(), ResultsGenerator::versionNames(options));
+    for (int row = 0; row < model.rowCount(); ++row) {
+        const int entry = model.data(model.index(row, 0)).toInt() - 1;
+        QCOMPARE(model.getTestKey(row), ResultsGenerator::testKey(entry, options));
+        if (ResultsGenerator::isReady(entry, options)) {
+            QVERIFY(QFileInfo(model.getThumbnailPath(row)).isFile());
+            QCOMPARE(model.getRowRenderVersions(row), ResultsGenerator::versionNames(options));
+        }
+    }
+}
+
+void TestResultsGenerator::testCompareResultLookup()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const ResultsGenerator::Options options = smallOptions();
+    QVERIFY(ResultsGenerator::generate(dir.path(), options));
+
+    const QStringList candidates = XmlDataModel::scanCompareResultXmls(dir.path());
+    for (int i = 0; i < options.entryCount; ++i) {
+        const QString key = ResultsGenerator::testKey(i, options);
+        const QString picked = XmlDataModel::pickCompareResultXml(dir.path(), ResultsGenerator::eventName(i, options),
+                                                                  key, candidates);
+        if (!ResultsGenerator::isReady(i, options)) {
+            // Not Ready entries have no results; any other entry's file would be wrong
+            QVERIFY(!QDir::fromNativeSeparators(picked).contains("/" + key + "/"));
+            continue;
+        }
+        // Never a sibling F#### folder of the same event
+        QVERIFY2(QDir::fromNativeSeparators(picked).contains("/" + key + "/"), qPrintable(picked));
+        for (const QString &version : ResultsGenerator::versionNames(options)) {
+            QVERIFY(!XmlDataModel::compareResultXmlForVersion(dir.path(), key, version).isEmpty());
+        }
+    }
+}
+
+void TestResultsGenerator::testImageSequences()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ResultsGenerator::Options options = smallOptions();
+    options.entryCount = 3;
+    options.notReadyPercent = 0;
+    options.frameCount = 5;
+    options.images = true;
+    options.imageEntries = 2;
+    ResultsGenerator::Stats stats;
+    QVERIFY(ResultsGenerator::generate(dir.path(), options, &stats));
+    QCOMPARE(stats.images, qint64(2 * 2 * 5 * 4));
+    QVERIFY(stats.bytes > 0);
+
+    // The paths the viewer gets from compareResult.xml, plus frame number and extension
+    XmlDataModel model;
+    QVERIFY(loadModel(model, dir.path()));
+    for (int row = 0; row < model.rowCount(); ++row) {
+        const int entry = model.data(model.index(row, 0)).toInt() - 1;
+        const QStringList paths = model.getOutputPathList(row);
+        QCOMPARE(paths.size(), 4);
+        for (int channel = 0; channel < 4; ++channel) {
+            const QString first = paths.at(channel) + (channel == 3 ? "0001.png" : "0001.jpg");
+            const QString last = paths.at(channel) + (channel == 3 ? "0005.png" : "0005.jpg");
+            QCOMPARE(QFileInfo(first).isFile(), entry < 2);
+            QCOMPARE(QFileInfo(last).isFile(), entry < 2);
+            if (entry < 2) {
+                QCOMPARE(QImageReader(first).size(), options.imageSize);
+            }
+        }
+    }
+}
+
+void TestResultsGenerator::testDistributions()
+{
+    ResultsGenerator::Options options = smallOptions();
+    options.frameCount = 5000;
+
+    options.distribution = ResultsGenerator::Clean;
+    for (float value : ResultsGenerator::frameValues(0, 0, options)) {
+        QVERIFY(value >= 0.985f && value <= 1.0f);
+    }
+
+    // Runs of bad frames, at most 40 long
+    options.distribution = ResultsGenerator::Dips;
+    const QVector<float> dips = ResultsGenerator::frameValues(0, 0, options);
+    QCOMPARE(dips.size(), 5000);
+    int bad = 0;
+    int run = 0;
+    int longestRun = 0;
+    for (float value : dips) {
+        QVERIFY(value >= 0.7f && value <= 1.0f);
+        run = value < 0.95f ? run + 1 : 0;
+        bad += value < 0.95f ? 1 : 0;
+        longestRun = qMax(longestRun, run);
+    }
+    QVERIFY(bad > 0 && bad < 2500);
+    QVERIFY(longestRun >= 5 && longestRun <= 80);  // Two runs can touch
+
+    // Newer versions drift further
+    options.distribution = ResultsGenerator::Drift;
+    const QVector<float> older = ResultsGenerator::frameValues(0, 0, options);
+    const QVector<float> newer = ResultsGenerator::frameValues(0, 1, options);
+    QVERIFY(older.first() > 0.98f && newer.first() > 0.98f);
+    QVERIFY(qAbs(older.last() - 0.965f) < 0.011f);
+    QVERIFY(qAbs(newer.last() - 0.935f) < 0.011f);
+
+    // Only the newest version of some entries is broken
+    options.distribution = ResultsGenerator::Bimodal;
+    int broken = 0;
+    for (int entry = 0; entry < 200; ++entry) {
+        QVERIFY(ResultsGenerator::frameValues(entry, 0, options).first() >= 0.985f);
+        broken += ResultsGenerator::frameValues(entry, 1, options).first() < 0.85f ? 1 : 0;
+    }
+    QVERIFY(broken > 10 && broken < 60);
+
+    bool ok = false;
+    QCOMPARE(ResultsGenerator::distributionFromName("Drift", &ok), ResultsGenerator::Drift);
+    QVERIFY(ok);
+    ResultsGenerator::distributionFromName("gaussian", &ok);
+    QVERIFY(!ok);
+
+    // uiData.xml counts the newest version's frames below minValue
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    options.entryCount = 4;
+    options.notReadyPercent = 0;
+    options.frameCount = 400;
+    options.distribution = ResultsGenerator::Dips;
+    QVERIFY(ResultsGenerator::generate(dir.path(), options));
+    QDomDocument document;
+    QVERIFY(document.setContent(readFile(dir.filePath("uiData.xml"))));
+    const QDomNodeList entries = document.elementsByTagName("entry");
+    QCOMPARE(entries.size(), 4);
+    for (int i = 0; i < entries.size(); ++i) {
+        const QVector<float> values = ResultsGenerator::frameValues(i, options.versionCount - 1, options);
+        const int expected = static_cast<int>(std::count_if(values.cbegin(), values.cend(),
+            [&options](float value) { return value < options.minValue; }));
+        QCOMPARE(entries.at(i).firstChildElement("numFramesUnderMin").text().toInt(), expected);
+    }
+}
+
+void TestResultsGenerator::testDeterministic()
+{
+    QTemporaryDir first;
+    QTemporaryDir second;
+    QVERIFY(first.isValid() && second.isValid());
+    ResultsGenerator::Options options = smallOptions();
+    QVERIFY(ResultsGenerator::generate(first.path(), options));
+    QVERIFY(ResultsGenerator::generate(second.path(), options));
+
+    const QString xml = ResultsGenerator::testKey(0, options) + "/" + ResultsGenerator::versionNames(options).last()
+                        + "/results/compareResult.xml";
+    QCOMPARE(readFile(first.filePath("uiData.xml")), readFile(second.filePath("uiData.xml")));
+    QCOMPARE(readFile(first.filePath(xml)), readFile(second.filePath(xml)));
+
+    options.seed = 8;
+    QVERIFY(ResultsGenerator::frameValues(0, 0, options) != ResultsGenerator::frameValues(0, 0, smallOptions()));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_resultsgen.moc"
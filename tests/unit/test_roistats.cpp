@@ -0,0 +1,330 @@
+/****************************************************************************
+**
+** @file test_roistats.cpp
+** @brief Unit tests for RoiStats and RoiStatsService
+**
+** Tests for:
+** - Mean / max absolute difference, PSNR and changed pixels of known images
+** - SIMD path matches the scalar reference (odd widths, random regions)
+** - Region clipping, alpha ignored, other pixel formats
+** - 16-bit images compared at full precision (SIMD and scalar, 16-bit PNG frames)
+** - Statistics of the visible region of a frame (decoded or read from disk)
+** - Range curve over a frame sequence, superseded and cleared ranges
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <cmath>
+
+#include "../src/roistats.h"
+#include "../src/roistatsservice.h"
+#include "../src/imageloadermanager.h"
+
+class TestRoiStats : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testKnownValues();
+    void testIdentical();
+    void testSimdMatchesScalar();
+    void testClipping();
+    void testHighBitDepth();
+    void testFrameStats();
+    void testRange();
+
+private:
+    static QImage solid(const QSize &size, QRgb color);
+    static QImage noise(const QSize &size, quint64 seed);
+    static bool writeSequence(const QString &root, int frames, int changedFrame);
+};
+
+QImage TestRoiStats::solid(const QSize &size, QRgb color)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    return image;
+}
+
+QImage TestRoiStats::noise(const QSize &size, quint64 seed)
+{
+    QRandomGenerator generator(seed);
+    QImage image(size, QImage::Format_ARGB32);
+    for (int y = 0; y < size.height(); ++y) {
+        QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < size.width(); ++x) {
+            row[x] = generator.generate();
+        }
+    }
+    return image;
+}
+
+bool TestRoiStats::writeSequence(const QString &root, int frames, int changedFrame)
+{
+    // A and B identical except changedFrame, where B is inverted
+    QDir(root).mkdir("A");
+    QDir(root).mkdir("B");
+    const QImage image = solid(QSize(64, 32), qRgb(40, 120, 200));
+    QImage inverted = image;
+    inverted.invertPixels();
+    for (int i = 1; i <= frames; ++i) {
+        const QString name = QString("%1.jpg").arg(i, 4, 10, QChar('0'));
+        if (!image.save(root + "/A/" + name) || !(i == changedFrame ? inverted : image).save(root + "/B/" + name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestRoiStats::testKnownValues()
+{
+    // Left half of B is 20 brighter in red: 16 of 32 pixels differ in one channel
+    const QImage a = solid(QSize(8, 4), qRgb(100, 100, 100));
+    QImage b = a;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            b.setPixel(x, y, qRgb(120, 100, 100));
+        }
+    }
+
+    const RoiStats stats = RoiStats::compute(a, b, a.rect(), 10);
+    QVERIFY(stats.isValid());
+    QCOMPARE(stats.pixelCount, 32);
+    QCOMPARE(stats.maxAbsDiff, 20);
+    QCOMPARE(stats.meanAbsDiff, 16 * 20 / 96.0);
+    QCOMPARE(stats.psnr, 10.0 * std::log10(255.0 * 255.0 / (16 * 400 / 96.0)));
+    QCOMPARE(stats.changedPercent, 50.0);
+
+    // Changed means more than the threshold
+    QCOMPARE(RoiStats::compute(a, b, a.rect(), 20).changedPercent, 0.0);
+    QCOMPARE(RoiStats::compute(a, b, a.rect(), 19).changedPercent, 50.0);
+
+    // Only the unchanged right half
+    const RoiStats right = RoiStats::compute(a, b, QRect(4, 0, 4, 4), 10);
+    QCOMPARE(right.pixelCount, 16);
+    QCOMPARE(right.maxAbsDiff, 0);
+}
+
+void TestRoiStats::testIdentical()
+{
+    const QImage image = noise(QSize(33, 17), 1);
+    const RoiStats stats = RoiStats::compute(image, image, image.rect(), 0);
+    QCOMPARE(stats.pixelCount, 33 * 17);
+    QCOMPARE(stats.meanAbsDiff, 0.0);
+    QCOMPARE(stats.maxAbsDiff, 0);
+    QVERIFY(std::isinf(stats.psnr));
+    QCOMPARE(stats.changedPercent, 0.0);
+}
+
+void TestRoiStats::testSimdMatchesScalar()
+{
+    // Odd width so rows end in a scalar tail; random regions and thresholds
+    const QImage a = noise(QSize(257, 41), 2);
+    const QImage b = noise(QSize(257, 41), 3);
+    QRandomGenerator generator(4);
+    for (int i = 0; i < 50; ++i) {
+        const int x = generator.bounded(257);
+        const int y = generator.bounded(41);
+        const QRect roi(x, y, 1 + generator.bounded(257 - x), 1 + generator.bounded(41 - y));
+        const int threshold = generator.bounded(256);
+        const RoiStats simd = RoiStats::compute(a, b, roi, threshold);
+        const RoiStats scalar = RoiStats::computeScalar(a, b, roi, threshold);
+        QCOMPARE(simd.pixelCount, scalar.pixelCount);
+        QCOMPARE(simd.maxAbsDiff, scalar.maxAbsDiff);
+        QCOMPARE(simd.meanAbsDiff, scalar.meanAbsDiff);
+        QCOMPARE(simd.psnr, scalar.psnr);
+        QCOMPARE(simd.changedPercent, scalar.changedPercent);
+    }
+
+    // Rows long enough to flush the 32-bit squared-difference lanes
+    const QImage black = solid(QSize(40000, 1), qRgb(0, 0, 0));
+    const QImage white = solid(QSize(40000, 1), qRgb(255, 255, 255));
+    const RoiStats wide = RoiStats::compute(black, white, black.rect(), 10);
+    QCOMPARE(wide.meanAbsDiff, 255.0);
+    QCOMPARE(wide.psnr, 0.0);
+    QCOMPARE(wide.changedPercent, 100.0);
+}
+
+void TestRoiStats::testClipping()
+{
+    const QImage a = solid(QSize(10, 10), qRgb(0, 0, 0));
+    const QImage b = solid(QSize(6, 12), qRgb(10, 10, 10));
+
+    // Clipped to both images
+    QCOMPARE(RoiStats::compute(a, b, QRect(-5, -5, 100, 100), 0).pixelCount, 6 * 10);
+    QCOMPARE(RoiStats::compute(a, b, QRect(4, 8, 4, 4), 0).pixelCount, 2 * 2);
+    QVERIFY(!RoiStats::compute(a, b, QRect(7, 0, 3, 3), 0).isValid());
+    QVERIFY(!RoiStats::compute(a, b, QRect(), 0).isValid());
+
+    // Alpha is not compared
+    QImage transparent(a.size(), QImage::Format_ARGB32);
+    transparent.fill(qRgba(0, 0, 0, 0));
+    QImage opaque(a.size(), QImage::Format_ARGB32);
+    opaque.fill(qRgba(0, 0, 0, 255));
+    QCOMPARE(RoiStats::compute(transparent, opaque, a.rect(), 0).maxAbsDiff, 0);
+
+    // Other formats are converted (only the region)
+    const QImage first = noise(QSize(31, 9), 5).convertToFormat(QImage::Format_RGB32);
+    const QImage second = noise(QSize(31, 9), 6).convertToFormat(QImage::Format_RGB32);
+    const QRect roi(3, 2, 20, 5);
+    const RoiStats rgb32 = RoiStats::compute(first, second, roi, 10);
+    const RoiStats rgb888 = RoiStats::compute(first.convertToFormat(QImage::Format_RGB888),
+                                              second.convertToFormat(QImage::Format_RGB888), roi, 10);
+    QCOMPARE(rgb888.pixelCount, rgb32.pixelCount);
+    QCOMPARE(rgb888.meanAbsDiff, rgb32.meanAbsDiff);
+    QCOMPARE(rgb888.changedPercent, rgb32.changedPercent);
+}
+
+void TestRoiStats::testHighBitDepth()
+{
+    // 8-bit images widened to 16 bits give the same statistics
+    const QImage a = noise(QSize(37, 11), 7).convertToFormat(QImage::Format_RGB32);
+    const QImage b = noise(QSize(37, 11), 8).convertToFormat(QImage::Format_RGB32);
+    const RoiStats narrow = RoiStats::compute(a, b, a.rect(), 10);
+    const RoiStats wide = RoiStats::compute(a.convertToFormat(QImage::Format_RGBA64), b, a.rect(), 10);
+    QCOMPARE(narrow.bitsPerChannel, 8);
+    QCOMPARE(wide.bitsPerChannel, 16);
+    QCOMPARE(wide.pixelCount, narrow.pixelCount);
+    QCOMPARE(wide.maxAbsDiff, narrow.maxAbsDiff);
+    QCOMPARE(wide.meanAbsDiff, narrow.meanAbsDiff);
+    QCOMPARE(wide.psnr, narrow.psnr);
+    QCOMPARE(wide.changedPercent, narrow.changedPercent);
+
+    // A difference below one 8-bit step: invisible at 8 bits, measured at 16
+    QImage dark(QSize(9, 3), QImage::Format_RGBX64);
+    dark.fill(QColor::fromRgba64(1000, 1000, 1000));
+    QImage lighter(dark.size(), QImage::Format_RGBX64);
+    lighter.fill(QColor::fromRgba64(1100, 1000, 1000));
+    QVERIFY(std::isinf(RoiStats::compute(dark.convertToFormat(QImage::Format_RGB32),
+                                         lighter.convertToFormat(QImage::Format_RGB32), dark.rect(), 0).psnr));
+    const RoiStats subtle = RoiStats::compute(dark, lighter, dark.rect(), 0);
+    QCOMPARE(subtle.meanAbsDiff, 100 / 3.0 / 257.0);
+    QCOMPARE(subtle.maxAbsDiff, 1);  // Rounded up
+    QCOMPARE(subtle.changedPercent, 100.0);
+    QVERIFY(!std::isinf(subtle.psnr));
+
+    // SIMD matches scalar (odd widths, random regions, rows long enough to flush)
+    const QImage first = noise(QSize(129, 13), 9).convertToFormat(QImage::Format_RGBA64);
+    QImage second = noise(QSize(129, 13), 10).convertToFormat(QImage::Format_RGBA64);
+    QRandomGenerator generator(11);
+    for (int y = 0; y < second.height(); ++y) {
+        quint16 *row = reinterpret_cast<quint16 *>(second.scanLine(y));
+        for (int x = 0; x < second.width() * 4; ++x) {
+            row[x] = static_cast<quint16>(generator.bounded(65536));  // Not multiples of 257
+        }
+    }
+    for (int i = 0; i < 50; ++i) {
+        const int x = generator.bounded(129);
+        const int y = generator.bounded(13);
+        const QRect roi(x, y, 1 + generator.bounded(129 - x), 1 + generator.bounded(13 - y));
+        const int threshold = generator.bounded(256);
+        const RoiStats simd = RoiStats::compute(first, second, roi, threshold);
+        const RoiStats scalar = RoiStats::computeScalar(first, second, roi, threshold);
+        QCOMPARE(simd.maxAbsDiff, scalar.maxAbsDiff);
+        QCOMPARE(simd.meanAbsDiff, scalar.meanAbsDiff);
+        QCOMPARE(simd.psnr, scalar.psnr);
+        QCOMPARE(simd.changedPercent, scalar.changedPercent);
+    }
+    QImage black(QSize(40001, 1), QImage::Format_RGBX64);
+    black.fill(QColor::fromRgba64(0, 0, 0));
+    QImage white(black.size(), QImage::Format_RGBX64);
+    white.fill(QColor::fromRgba64(65535, 65535, 65535));
+    const RoiStats extreme = RoiStats::compute(black, white, black.rect(), 10);
+    QCOMPARE(extreme.meanAbsDiff, 255.0);
+    QCOMPARE(extreme.psnr, 0.0);
+    QCOMPARE(extreme.changedPercent, 100.0);
+
+    // 16-bit PNG frames: detected, read from disk at full precision (not from the 8-bit pixmaps)
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir(dir.path()).mkdir("A");
+    QDir(dir.path()).mkdir("B");
+    QVERIFY(dark.save(dir.filePath("A/0001.png")));
+    QVERIFY(lighter.save(dir.filePath("B/0001.png")));
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.filePath("A") + "/", dir.filePath("B") + "/", QString(), QString());
+    QVERIFY(manager.isHighBitDepth("A"));
+    QVERIFY(!manager.getImage("A", 1).isNull());
+    RoiStatsService service;
+    service.setImageLoaderManager(&manager);
+    const QVariantMap stats = service.frameStats(1, QRectF(0, 0, 9, 3));
+    QVERIFY(stats.value("valid").toBool());
+    QCOMPARE(stats.value("bitsPerChannel").toInt(), 16);
+    QVERIFY(!stats.value("identical").toBool());
+    QCOMPARE(stats.value("meanAbsDiff").toDouble(), subtle.meanAbsDiff);
+}
+
+void TestRoiStats::testFrameStats()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeSequence(dir.path(), 2, 2));
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.filePath("A") + "/", dir.filePath("B") + "/", QString(), QString());
+    RoiStatsService service;
+    service.setImageLoaderManager(&manager);
+
+    // Not decoded anywhere: the region is read from disk
+    QVariantMap stats = service.frameStats(1, QRectF(10, 5, 20, 10));
+    QVERIFY(stats.value("valid").toBool());
+    QVERIFY(stats.value("identical").toBool());
+    QCOMPARE(stats.value("pixelCount").toInt(), 200);
+    QCOMPARE(stats.value("changedPercent").toDouble(), 0.0);
+
+    // Clipped to the image
+    stats = service.frameStats(2, QRectF(50.5, 20, 100, 100));
+    QVERIFY(stats.value("valid").toBool());
+    QCOMPARE(stats.value("x").toInt(), 50);
+    QCOMPARE(stats.value("width").toInt(), 14);
+    QCOMPARE(stats.value("height").toInt(), 12);
+    QCOMPARE(stats.value("changedPercent").toDouble(), 100.0);
+    QVERIFY(!stats.value("identical").toBool());
+
+    // From the pixmap cache, only B cached: same result
+    QVERIFY(!manager.getImage("B", 2).isNull());
+    QVERIFY(!manager.getImageIfCached("B", 2).isNull());
+    const QVariantMap cached = service.frameStats(2, QRectF(50.5, 20, 100, 100));
+    QCOMPARE(cached.value("pixelCount"), stats.value("pixelCount"));
+    QCOMPARE(cached.value("changedPercent"), stats.value("changedPercent"));
+
+    // Missing frame or empty region
+    QVERIFY(!service.frameStats(3, QRectF(0, 0, 10, 10)).value("valid").toBool());
+    QVERIFY(!service.frameStats(1, QRectF()).value("valid").toBool());
+}
+
+void TestRoiStats::testRange()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(writeSequence(dir.path(), 5, 3));
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.filePath("A") + "/", dir.filePath("B") + "/", QString(), QString());
+    RoiStatsService service;
+    service.setImageLoaderManager(&manager);
+    QSignalSpy ready(&service, &RoiStatsService::rangeReady);
+
+    // A superseded range never reports
+    service.computeRange(1, 2, QRectF(0, 0, 8, 8));
+    service.computeRange(1, 6, QRectF(0, 0, 16, 16));
+    QVERIFY(service.rangeRunning());
+    QVERIFY(ready.wait(10000));
+    QTest::qWait(50);
+    QCOMPARE(ready.count(), 1);
+    QVERIFY(!service.rangeRunning());
+
+    // One point per frame that has both renders: unchanged fraction
+    const QVector<QPointF> expected = { QPointF(1, 1), QPointF(2, 1), QPointF(3, 0), QPointF(4, 1), QPointF(5, 1) };
+    QCOMPARE(service.rangePoints(), expected);
+    QCOMPARE(service.rangePointCount(), 5);
+
+    service.clearRange();
+    QCOMPARE(ready.count(), 2);
+    QVERIFY(service.rangePoints().isEmpty());
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_roistats.moc"
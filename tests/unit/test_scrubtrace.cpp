@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** @file test_scrubtrace.cpp
+** @brief Unit tests for ScrubTrace and scrub recording in FrameSetPresenter
+**
+** Tests for:
+** - Write / read round trip
+** - Comments, blank lines and out-of-order lines
+** - Malformed lines
+** - Recording frame requests from FrameSetPresenter
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+
+#include "../src/scrubtrace.h"
+#include "../src/framesetpresenter.h"
+
+class TestScrubTrace : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Test cases
+    void testRoundTrip();
+    void testCommentsAndOrder();
+    void testMalformed();
+    void testPresenterRecording();
+
+private:
+    bool writeText(const QString &path, const QByteArray &text);
+
+    QTemporaryDir m_dir;
+};
+
+void TestScrubTrace::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+bool TestScrubTrace::writeText(const QString &path, const QByteArray &text)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(text) == text.size();
+}
+
+void TestScrubTrace::testRoundTrip()
+{
+    const QVector<ScrubTrace::Step> steps = {{0, 120, {"A", "B", "D"}}, {16, 123, {"A", "B", "D"}}, {40, 7, {}}};
+    const QString path = m_dir.filePath("roundtrip.csv");
+    QVERIFY(ScrubTrace::write(path, steps));
+
+    QVector<ScrubTrace::Step> read;
+    QVERIFY(ScrubTrace::read(path, read));
+    QCOMPARE(read.size(), 3);
+    QCOMPARE(read[1].timeMs, Q_INT64_C(16));
+    QCOMPARE(read[1].frame, 123);
+    QCOMPARE(read[1].imageTypes, QStringList({"A", "B", "D"}));
+    QVERIFY(read[2].imageTypes.isEmpty());  // Slider only, no panes
+}
+
+void TestScrubTrace::testCommentsAndOrder()
+{
+    const QString path = m_dir.filePath("edited.csv");
+    QVERIFY(writeText(path, "# Hand-edited\ntimeMs,frame,imageTypes\n\n50,3,A\n10,1,A;C\n"));
+
+    QVector<ScrubTrace::Step> steps;
+    QVERIFY(ScrubTrace::read(path, steps));
+    QCOMPARE(steps.size(), 2);
+    QCOMPARE(steps[0].frame, 1);  // Sorted by time
+    QCOMPARE(steps[0].imageTypes, QStringList({"A", "C"}));
+    QCOMPARE(steps[1].timeMs, Q_INT64_C(50));
+}
+
+void TestScrubTrace::testMalformed()
+{
+    const QString path = m_dir.filePath("malformed.csv");
+    QVERIFY(writeText(path, "0,1,A\nsoon,2,A\n"));
+
+    QVector<ScrubTrace::Step> steps;
+    QString errorString;
+    QVERIFY(!ScrubTrace::read(path, steps, &errorString));
+    QVERIFY(steps.isEmpty());
+    QVERIFY2(errorString.contains(":2:"), qPrintable(errorString));  // Line number
+
+    QVERIFY(!ScrubTrace::read(m_dir.filePath("missing.csv"), steps, &errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void TestScrubTrace::testPresenterRecording()
+{
+    const QString path = m_dir.filePath("recorded.csv");
+    {
+        FrameSetPresenter presenter(nullptr);
+        QVERIFY(presenter.setRecordPath(path));
+        presenter.requestFrame(5, QStringList());
+        QTest::qWait(20);
+        presenter.requestFrame(9, QStringList({"A"}));
+        QVERIFY(presenter.setRecordPath(QString()));  // Stop recording
+        presenter.requestFrame(11, QStringList());
+    }
+
+    QVector<ScrubTrace::Step> steps;
+    QVERIFY(ScrubTrace::read(path, steps));
+    QCOMPARE(steps.size(), 2);
+    QCOMPARE(steps[0].frame, 5);
+    QCOMPARE(steps[1].frame, 9);
+    QCOMPARE(steps[1].imageTypes, QStringList({"A"}));
+    QVERIFY(steps[1].timeMs >= steps[0].timeMs + 15);
+
+    QVERIFY(!FrameSetPresenter(nullptr).setRecordPath(m_dir.filePath("no/such/dir/trace.csv")));
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_scrubtrace.moc"
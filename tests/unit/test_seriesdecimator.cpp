@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** @file test_seriesdecimator.cpp
+** @brief Unit tests for SeriesDecimator class
+**
+** Tests for:
+** - Small ranges returned unchanged
+** - Output size bounded by bucket count
+** - Low-value outliers are kept
+** - Output stays sorted by frame
+** - Zoom window and edge neighbours
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QVector>
+#include <QPointF>
+
+#include "../src/seriesdecimator.h"
+
+class TestSeriesDecimator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testEmptyInput();
+    void testSmallRangeUnchanged();
+    void testOutputBoundedByBuckets();
+    void testKeepsOutliers();
+    void testOutputSorted();
+    void testZoomWindow();
+
+private:
+    QVector<QPointF> makeSeries(int frameCount) const;
+};
+
+QVector<QPointF> TestSeriesDecimator::makeSeries(int frameCount) const
+{
+    // Similarity values close to 1.0 with a small repeating ripple
+    QVector<QPointF> points;
+    points.reserve(frameCount);
+    for (int frame = 0; frame < frameCount; ++frame) {
+        points.append(QPointF(frame, 0.95 + 0.001 * (frame % 7)));
+    }
+    return points;
+}
+
+void TestSeriesDecimator::testEmptyInput()
+{
+    QVector<QPointF> points;
+    QVERIFY(SeriesDecimator::minMax(points, 0.0, 100.0, 10).isEmpty());
+}
+
+void TestSeriesDecimator::testSmallRangeUnchanged()
+{
+    QVector<QPointF> points = makeSeries(50);
+    QVector<QPointF> result = SeriesDecimator::minMax(points, 0.0, 49.0, 100);
+    QCOMPARE(result.size(), points.size());
+    QCOMPARE(result.first().x(), 0.0);
+    QCOMPARE(result.last().x(), 49.0);
+}
+
+void TestSeriesDecimator::testOutputBoundedByBuckets()
+{
+    QVector<QPointF> points = makeSeries(20000);
+    QVector<QPointF> result = SeriesDecimator::minMax(points, 0.0, 19999.0, 400);
+    QVERIFY(result.size() <= 2 * 400);
+    QVERIFY(result.size() >= 400);
+}
+
+void TestSeriesDecimator::testKeepsOutliers()
+{
+    QVector<QPointF> points = makeSeries(20000);
+    points[12345] = QPointF(12345, 0.2);
+    points[12346] = QPointF(12346, 0.3);
+
+    QVector<QPointF> result = SeriesDecimator::minMax(points, 0.0, 19999.0, 300);
+    bool foundOutlier = false;
+    for (const QPointF &point : result) {
+        if (qFuzzyCompare(point.y(), 0.2)) {
+            QCOMPARE(point.x(), 12345.0);
+            foundOutlier = true;
+        }
+    }
+    QVERIFY(foundOutlier);
+}
+
+void TestSeriesDecimator::testOutputSorted()
+{
+    QVector<QPointF> points = makeSeries(10000);
+    QVector<QPointF> result = SeriesDecimator::minMax(points, 0.0, 9999.0, 123);
+    for (int i = 1; i < result.size(); ++i) {
+        QVERIFY(result.at(i - 1).x() < result.at(i).x());
+    }
+}
+
+void TestSeriesDecimator::testZoomWindow()
+{
+    QVector<QPointF> points = makeSeries(10000);
+    QVector<QPointF> result = SeriesDecimator::minMax(points, 100.0, 200.0, 500);
+
+    // 101 frames in range plus one neighbour on each side
+    QCOMPARE(result.size(), 103);
+    QCOMPARE(result.first().x(), 99.0);
+    QCOMPARE(result.last().x(), 201.0);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_seriesdecimator.moc"
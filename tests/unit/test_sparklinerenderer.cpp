@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** @file test_sparklinerenderer.cpp
+** @brief Unit tests for SparklineRenderer
+**
+** Tests for:
+** - Min/max envelope
+** - Rendered image size and content
+** - PNG cache next to compareResult.xml, image source changing on re-render
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QVector>
+#include <QImage>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "../src/sparklinerenderer.h"
+
+class TestSparklineRenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testEnvelopeShortSeries();
+    void testEnvelopeKeepsOutliers();
+    void testRender();
+    void testEnsureCached();
+};
+
+void TestSparklineRenderer::testEnvelopeShortSeries()
+{
+    QVector<float> values = { 0.1f, 0.5f, 0.9f };
+    QVector<QPair<float, float>> envelope = SparklineRenderer::envelope(values, 10);
+    QCOMPARE(envelope.size(), 3);
+    QCOMPARE(envelope.at(1).first, 0.5f);
+    QCOMPARE(envelope.at(1).second, 0.5f);
+
+    QVERIFY(SparklineRenderer::envelope(QVector<float>(), 10).isEmpty());
+}
+
+void TestSparklineRenderer::testEnvelopeKeepsOutliers()
+{
+    // One bad frame in 1000 must survive the reduction to 10 columns
+    QVector<float> values(1000, 0.9f);
+    values[537] = 0.05f;
+    QVector<QPair<float, float>> envelope = SparklineRenderer::envelope(values, 10);
+    QCOMPARE(envelope.size(), 10);
+    QCOMPARE(envelope.at(5).first, 0.05f);
+    QCOMPARE(envelope.at(5).second, 0.9f);
+    QCOMPARE(envelope.at(4).first, 0.9f);
+}
+
+void TestSparklineRenderer::testRender()
+{
+    QVector<float> values(500, 0.5f);
+    QImage image = SparklineRenderer::render(values, QSize(60, 20), Qt::red);
+    QCOMPARE(image.size(), QSize(60, 20));
+
+    // Something was drawn, the rest is transparent
+    int drawn = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            drawn += qAlpha(image.pixel(x, y)) > 0 ? 1 : 0;
+        }
+    }
+    QVERIFY(drawn > 0);
+    QVERIFY(drawn < image.width() * image.height());
+
+    QVERIFY(SparklineRenderer::render(QVector<float>()).isNull());
+}
+
+void TestSparklineRenderer::testEnsureCached()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString xmlPath = dir.filePath("compareResult.xml");
+    QFile xml(xmlPath);
+    QVERIFY(xml.open(QIODevice::WriteOnly));
+    xml.write("<frames/>");
+    xml.close();
+
+    QVector<float> values = { 0.9f, 0.2f, 0.8f };
+    const QString pngPath = SparklineRenderer::ensureCached(xmlPath, values);
+    QCOMPARE(pngPath, SparklineRenderer::cachePath(xmlPath));
+    QVERIFY(QFile::exists(pngPath));
+    QCOMPARE(QImage(pngPath).size(), QSize(SparklineRenderer::DefaultWidth, SparklineRenderer::DefaultHeight));
+
+    QVERIFY(SparklineRenderer::ensureCached(xmlPath, QVector<float>()).isEmpty());
+
+    // A tester run rewrites the XML: the re-rendered PNG gets a new image source
+    QVERIFY(xml.open(QIODevice::ReadWrite));
+    QVERIFY(xml.setFileTime(QDateTime::currentDateTime().addSecs(-180), QFileDevice::FileModificationTime));
+    xml.close();
+    QFile png(pngPath);
+    QVERIFY(png.open(QIODevice::ReadWrite));
+    QVERIFY(png.setFileTime(QDateTime::currentDateTime().addSecs(-120), QFileDevice::FileModificationTime));
+    png.close();
+    const QString oldSource = SparklineRenderer::imageSource(pngPath);
+    QVERIFY(oldSource.startsWith(pngPath + "?v="));
+    QCOMPARE(SparklineRenderer::imageSource(SparklineRenderer::ensureCached(xmlPath, values)), oldSource);  // Still fresh
+
+    QVERIFY(xml.open(QIODevice::ReadWrite));
+    QVERIFY(xml.setFileTime(QDateTime::currentDateTime().addSecs(-60), QFileDevice::FileModificationTime));
+    xml.close();
+    QCOMPARE(SparklineRenderer::ensureCached(xmlPath, values), pngPath);
+    QVERIFY(SparklineRenderer::imageSource(pngPath) != oldSource);
+    QVERIFY(SparklineRenderer::imageSource(QString()).isEmpty());
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_sparklinerenderer.moc"
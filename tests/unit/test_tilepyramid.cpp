@@ -0,0 +1,209 @@
+/****************************************************************************
+**
+** @file test_tilepyramid.cpp
+** @brief Unit tests for TilePyramid and the ImageLoaderManager tile cache
+**
+** Tests for:
+** - Level count and level sizes
+** - Level selection for a display scale
+** - Visible tile ranges
+** - Decoding single tiles (clipped and scaled)
+** - Decoding a whole level at once for formats that can't clip (PNG)
+** - Tile caching in ImageLoaderManager
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QImage>
+#include <QPainter>
+#include <QTemporaryDir>
+
+#include "../src/tilepyramid.h"
+#include "../src/imageloadermanager.h"
+
+class TestTilePyramid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testLevels();
+    void testLevelForScale();
+    void testVisibleTiles();
+    void testDecodeTile();
+    void testDecodeLevelTiles();
+    void testTileCache();
+    void testLevelTileCache();
+
+private:
+    static QImage makeTestImage(const QSize &size);
+};
+
+QImage TestTilePyramid::makeTestImage(const QSize &size)
+{
+    // Left half red, right half blue
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QPainter painter(&image);
+    painter.fillRect(QRect(size.width() / 2, 0, size.width() - size.width() / 2, size.height()), Qt::blue);
+    return image;
+}
+
+void TestTilePyramid::testLevels()
+{
+    QCOMPARE(TilePyramid::levelCount(QSize()), 0);
+    QCOMPARE(TilePyramid::levelCount(QSize(512, 300)), 1);
+    QCOMPARE(TilePyramid::levelCount(QSize(1300, 700)), 3);   // 1300, 650, 325
+    QCOMPARE(TilePyramid::levelCount(QSize(7680, 4320)), 5);  // 8K: 7680 .. 480
+
+    QCOMPARE(TilePyramid::levelSize(QSize(1300, 701), 1), QSize(650, 351));
+    QCOMPARE(TilePyramid::levelSize(QSize(1300, 701), 2), QSize(325, 176));
+}
+
+void TestTilePyramid::testLevelForScale()
+{
+    QCOMPARE(TilePyramid::levelForScale(1.0, 5), 0);
+    QCOMPARE(TilePyramid::levelForScale(4.0, 5), 0);    // Magnified - full resolution
+    QCOMPARE(TilePyramid::levelForScale(0.5, 5), 1);
+    QCOMPARE(TilePyramid::levelForScale(0.3, 5), 1);    // Never coarser than the display
+    QCOMPARE(TilePyramid::levelForScale(0.01, 5), 4);   // Clamped to the last level
+    QCOMPARE(TilePyramid::levelForScale(0.3, 1), 0);
+}
+
+void TestTilePyramid::testVisibleTiles()
+{
+    const QSize imageSize(1300, 700);
+
+    // Everything at level 0: 3 x 2 tiles, edge tiles clipped to the image
+    QVector<TileId> tiles = TilePyramid::visibleTiles(imageSize, 0, QRectF(0, 0, 1300, 700));
+    QCOMPARE(tiles.size(), 6);
+    QCOMPARE(tiles.last().column, 2);
+    QCOMPARE(tiles.last().row, 1);
+    QCOMPARE(tiles.last().sourceRect, QRect(1024, 512, 276, 188));
+
+    // A window inside one tile, and one ending exactly on a tile edge
+    tiles = TilePyramid::visibleTiles(imageSize, 0, QRectF(600, 100, 200, 200));
+    QCOMPARE(tiles.size(), 1);
+    QCOMPARE(tiles.first().column, 1);
+    tiles = TilePyramid::visibleTiles(imageSize, 0, QRectF(0, 0, 512, 512));
+    QCOMPARE(tiles.size(), 1);
+
+    // Level 1 tiles cover 1024 full-res pixels
+    tiles = TilePyramid::visibleTiles(imageSize, 1, QRectF(900, 0, 300, 300));
+    QCOMPARE(tiles.size(), 2);
+    QCOMPARE(tiles.at(1).sourceRect, QRect(1024, 0, 276, 700));
+
+    QVERIFY(TilePyramid::visibleTiles(imageSize, 0, QRectF(2000, 0, 100, 100)).isEmpty());
+}
+
+void TestTilePyramid::testDecodeTile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QSize imageSize(1300, 700);
+    const QString path = dir.filePath("frame.png");
+    QVERIFY(makeTestImage(imageSize).save(path));
+
+    const QImage fullTile = TilePyramid::decodeTile(path, imageSize, 0, 2, 1);
+    QCOMPARE(fullTile.size(), QSize(276, 188));
+    QCOMPARE(QColor(fullTile.pixel(10, 10)), QColor(Qt::blue));
+
+    const QImage scaledTile = TilePyramid::decodeTile(path, imageSize, 1, 0, 0);
+    QCOMPARE(scaledTile.size(), QSize(512, 350));
+    QVERIFY(QColor(scaledTile.pixel(10, 10)).red() > 200);
+    QVERIFY(QColor(scaledTile.pixel(500, 10)).blue() > 200);
+
+    QVERIFY(TilePyramid::decodeTile(path, imageSize, 0, 5, 0).isNull());
+}
+
+void TestTilePyramid::testDecodeLevelTiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QSize imageSize(1300, 700);
+    const QString pngPath = dir.filePath("frame.png");
+    const QString jpgPath = dir.filePath("frame.jpg");
+    QVERIFY(makeTestImage(imageSize).save(pngPath));
+    QVERIFY(makeTestImage(imageSize).save(jpgPath, "JPG", 95));
+
+    // Only JPEG clips (and scales) while decoding
+    QVERIFY(TilePyramid::decodesClipped(jpgPath, 0));
+    QVERIFY(TilePyramid::decodesClipped(jpgPath, 1));
+    QVERIFY(!TilePyramid::decodesClipped(pngPath, 0));
+    QVERIFY(!TilePyramid::decodesClipped(pngPath, 1));
+
+    // One decode, the same tiles as decodeTile()
+    QCOMPARE(TilePyramid::columnCount(imageSize, 0), 3);
+    const QVector<QImage> tiles = TilePyramid::decodeLevelTiles(pngPath, imageSize, 0);
+    QCOMPARE(tiles.size(), 6);
+    QCOMPARE(tiles.at(5).size(), QSize(276, 188));
+    QCOMPARE(tiles.at(5).convertToFormat(QImage::Format_ARGB32),
+             TilePyramid::decodeTile(pngPath, imageSize, 0, 2, 1).convertToFormat(QImage::Format_ARGB32));
+
+    QCOMPARE(TilePyramid::columnCount(imageSize, 1), 2);
+    const QVector<QImage> scaledTiles = TilePyramid::decodeLevelTiles(pngPath, imageSize, 1);
+    QCOMPARE(scaledTiles.size(), 2);
+    QCOMPARE(scaledTiles.at(0).size(), QSize(512, 350));
+    QCOMPARE(scaledTiles.at(1).size(), QSize(138, 350));
+
+    QVERIFY(TilePyramid::decodeLevelTiles(dir.filePath("missing.png"), imageSize, 0).isEmpty());
+}
+
+void TestTilePyramid::testTileCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir(dir.path()).mkpath("imagesA");
+    const QString basePath = QDir(dir.path()).absoluteFilePath("imagesA/");
+    QVERIFY(makeTestImage(QSize(1300, 700)).save(basePath + "0001.jpg", "JPG", 95));
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    QCOMPARE(manager.getImageSize("A", 1), QSize(1300, 700));
+
+    // Zoomed in on the right edge at 2x: full-resolution tiles of that area only
+    const QVariantList tiles = manager.getVisibleTiles("A", 1, 2.0, 1100, 0, 200, 300);
+    QCOMPARE(tiles.size(), 1);
+    const QVariantMap tile = tiles.first().toMap();
+    QCOMPARE(tile.value("source").toString(), QString("image://tiles/A/1/0/2/0"));
+    QCOMPARE(tile.value("x").toInt(), 1024);
+
+    const QImage decoded = manager.getTile("A", 1, 0, 2, 0);
+    QCOMPARE(decoded.size(), QSize(276, 512));
+    QVERIFY(QColor(decoded.pixel(100, 100)).blue() > 200);
+    QCOMPARE(manager.getTileCacheSize(), 1);
+    manager.getTile("A", 1, 0, 2, 0);
+    QCOMPARE(manager.getTileCacheSize(), 1);  // Served from the cache
+
+    manager.setMaxTileCacheMegabytes(0);
+    QCOMPARE(manager.getTileCacheSize(), 0);
+    QVERIFY(manager.getTile("A", 1, 7, 0, 0).isNull());  // No such level
+}
+
+void TestTilePyramid::testLevelTileCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir(dir.path()).mkpath("imagesA");
+    const QString basePath = QDir(dir.path()).absoluteFilePath("imagesA/");
+    QVERIFY(makeTestImage(QSize(1300, 700)).save(basePath + "0001.png"));
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(basePath, QString(), QString(), QString());
+    QCOMPARE(manager.getImageSize("A", 1), QSize(1300, 700));
+
+    // PNG: the first tile decodes the whole level and caches all 6 tiles
+    const QImage decoded = manager.getTile("A", 1, 0, 2, 1);
+    QCOMPARE(decoded.size(), QSize(276, 188));
+    QCOMPARE(QColor(decoded.pixel(10, 10)), QColor(Qt::blue));
+    QCOMPARE(manager.getTileCacheSize(), 6);
+    QCOMPARE(manager.getTile("A", 1, 0, 0, 0).size(), QSize(512, 512));
+    QCOMPARE(manager.getTileCacheSize(), 6);  // Served from the cache
+
+    QVERIFY(manager.getTile("A", 1, 0, 3, 0).isNull());  // No such tile
+    QCOMPARE(manager.getTileCacheSize(), 6);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_tilepyramid.moc"
@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** @file test_tonemapper.cpp
+** @brief Unit tests for ToneMapper and high-bit-depth frame detection
+**
+** Tests for:
+** - Default settings pass frames through untouched
+** - Exposure brightens / darkens, clips at white, keeps alpha; settings are clamped
+** - 8-bit and 16-bit input of the same values map alike; 16-bit detail survives
+** - Reinhard curve rolls off highlights; only A/B renders are tone mapped
+** - Frame extension and bit depth detected per image type
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "../src/tonemapper.h"
+#include "../src/imageloadermanager.h"
+
+class TestToneMapper : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testIdentity();
+    void testExposure();
+    void testHighBitDepth();
+    void testReinhard();
+    void testFrameFormatDetection();
+};
+
+void TestToneMapper::testIdentity()
+{
+    ToneMapper toneMapper;
+    QVERIFY(toneMapper.isIdentity());
+    QCOMPARE(toneMapper.revision(), 0);
+
+    QImage image(4, 4, QImage::Format_RGBA64);
+    image.fill(QColor::fromRgba64(1000, 20000, 65535));
+    const QImage result = toneMapper.apply(image);
+    QCOMPARE(result.cacheKey(), image.cacheKey());  // Not even copied
+
+    // Back to the identity after changes
+    toneMapper.setExposure(2.0);
+    toneMapper.cycleCurve();
+    QVERIFY(!toneMapper.isIdentity());
+    toneMapper.reset();
+    QVERIFY(toneMapper.isIdentity());
+    QCOMPARE(toneMapper.apply(image).cacheKey(), image.cacheKey());
+}
+
+void TestToneMapper::testExposure()
+{
+    ToneMapper toneMapper;
+    QSignalSpy changed(&toneMapper, &ToneMapper::settingsChanged);
+
+    QImage image(3, 1, QImage::Format_ARGB32);
+    image.setPixel(0, 0, qRgba(0, 0, 0, 255));
+    image.setPixel(1, 0, qRgba(128, 64, 32, 200));
+    image.setPixel(2, 0, qRgba(255, 255, 255, 255));
+
+    toneMapper.setExposure(1.0);
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(toneMapper.revision(), 1);
+    const QImage brighter = toneMapper.apply(image);
+    QCOMPARE(brighter.format(), QImage::Format_ARGB32);
+    QCOMPARE(brighter.pixel(0, 0), qRgba(0, 0, 0, 255));
+    QVERIFY(qRed(brighter.pixel(1, 0)) > 128);
+    QVERIFY(qGreen(brighter.pixel(1, 0)) > 64);
+    QCOMPARE(qAlpha(brighter.pixel(1, 0)), 200);
+    QCOMPARE(brighter.pixel(2, 0), qRgba(255, 255, 255, 255));  // Clipped
+
+    toneMapper.setExposure(-1.0);
+    QVERIFY(qRed(toneMapper.apply(image).pixel(1, 0)) < 128);
+
+    // Same value: no change; out of range: clamped
+    toneMapper.setExposure(-1.0);
+    QCOMPARE(changed.count(), 2);
+    toneMapper.stepExposure(100.0);
+    QCOMPARE(toneMapper.exposure(), double(ToneMapper::MaxExposure));
+}
+
+void TestToneMapper::testHighBitDepth()
+{
+    ToneMapper toneMapper;
+    toneMapper.setExposure(4.0);
+
+    // 8-bit values and their 16-bit equivalents map the same
+    QImage narrow(256, 1, QImage::Format_RGB32);
+    for (int x = 0; x < 256; ++x) {
+        narrow.setPixel(x, 0, qRgb(x, 255 - x, x / 2));
+    }
+    const QImage fromNarrow = toneMapper.apply(narrow);
+    const QImage fromWide = toneMapper.apply(narrow.convertToFormat(QImage::Format_RGBX64));
+    QCOMPARE(fromWide.format(), QImage::Format_RGB32);
+    for (int x = 0; x < 256; ++x) {
+        QCOMPARE(fromWide.pixel(x, 0), fromNarrow.pixel(x, 0));
+    }
+
+    // Two 16-bit shadows within one 8-bit step come apart once exposed
+    QImage shadows(2, 1, QImage::Format_RGBX64);
+    shadows.setPixelColor(0, 0, QColor::fromRgba64(1000, 1000, 1000));
+    shadows.setPixelColor(1, 0, QColor::fromRgba64(1100, 1100, 1100));
+    const QImage eightBit = shadows.convertToFormat(QImage::Format_RGB32);
+    QCOMPARE(eightBit.pixel(0, 0), eightBit.pixel(1, 0));
+    const QImage exposed = toneMapper.apply(shadows);
+    QVERIFY(qRed(exposed.pixel(1, 0)) > qRed(exposed.pixel(0, 0)));
+}
+
+void TestToneMapper::testReinhard()
+{
+    ToneMapper toneMapper;
+    QVERIFY(toneMapper.appliesTo("A"));
+    QVERIFY(toneMapper.appliesTo("B"));
+    QVERIFY(!toneMapper.appliesTo("C"));
+    QVERIFY(!toneMapper.appliesTo("D"));
+
+    toneMapper.cycleCurve();
+    QCOMPARE(toneMapper.curve(), ToneMapper::Reinhard);
+    QCOMPARE(toneMapper.curveName(), QString("Reinhard"));
+    QVERIFY(!toneMapper.isIdentity());
+
+    // White rolls off below white; more exposure brings it closer, without clipping
+    QImage white(1, 1, QImage::Format_RGB32);
+    white.fill(qRgb(255, 255, 255));
+    const int atZero = qRed(toneMapper.apply(white).pixel(0, 0));
+    QVERIFY(atZero < 255);
+    toneMapper.setExposure(3.0);
+    const int atThree = qRed(toneMapper.apply(white).pixel(0, 0));
+    QVERIFY(atThree > atZero);
+    QVERIFY(atThree < 255);
+}
+
+void TestToneMapper::testFrameFormatDetection()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QStringList folders = QStringList() << "A" << "B" << "C" << "D";
+    for (const QString &folder : folders) {
+        QDir(dir.path()).mkdir(folder);
+    }
+
+    // A: 16-bit PNG renders; B: JPEG (the default, even if stray PNGs exist); C: 8-bit PNG; D: empty
+    QImage wide(8, 8, QImage::Format_RGBX64);
+    wide.fill(QColor::fromRgba64(30000, 20000, 10000));
+    QVERIFY(wide.save(dir.filePath("A/0001.png")));
+    QImage narrow(8, 8, QImage::Format_RGB32);
+    narrow.fill(qRgb(10, 20, 30));
+    QVERIFY(narrow.save(dir.filePath("B/0001.jpg")));
+    QVERIFY(narrow.save(dir.filePath("B/preview.png")));
+    QVERIFY(narrow.save(dir.filePath("C/0001.png")));
+
+    ImageLoaderManager manager;
+    manager.setImagePaths(dir.filePath("A") + "/", dir.filePath("B") + "/",
+                          dir.filePath("C") + "/", dir.filePath("D") + "/");
+    QString basePath;
+    QString extension;
+    QVERIFY(manager.getImageTypePathAndExtension("A", basePath, extension));
+    QCOMPARE(extension, QString(".png"));
+    QVERIFY(manager.isHighBitDepth("A"));
+    QVERIFY(manager.getImageTypePathAndExtension("B", basePath, extension));
+    QCOMPARE(extension, QString(".jpg"));
+    QVERIFY(!manager.isHighBitDepth("B"));
+    QVERIFY(manager.getImageTypePathAndExtension("C", basePath, extension));
+    QCOMPARE(extension, QString(".png"));
+    QVERIFY(!manager.isHighBitDepth("C"));
+    QVERIFY(manager.getImageTypePathAndExtension("D", basePath, extension));
+    QCOMPARE(extension, QString(".png"));
+
+    // Decoded at full precision
+    QVERIFY(manager.getImageDiskPath("A", 1).endsWith("0001.png"));
+    QCOMPARE(QImage(manager.getImageDiskPath("A", 1)).depth(), 64);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_tonemapper.moc"
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** @file test_tracer.cpp
+** @brief Unit tests for Tracer
+**
+** Tests for:
+** - No spans while tracing is disabled
+** - Span recording with optional argument
+** - Chrome trace JSON output (thread names, spans from worker threads)
+** - Bounded buffers when many short-lived threads record spans
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include "../src/tracer.h"
+
+class TestTracer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testDisabled();
+    void testTraceFile();
+    void testShortLivedThreads();
+
+private:
+    static QJsonArray readEvents(const QString &path);
+    static QJsonArray spansNamed(const QJsonArray &events, const QString &name);
+};
+
+QJsonArray TestTracer::readEvents(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonArray();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object().value("traceEvents").toArray();
+}
+
+QJsonArray TestTracer::spansNamed(const QJsonArray &events, const QString &name)
+{
+    QJsonArray spans;
+    for (const QJsonValue &event : events) {
+        if (event.toObject().value("ph").toString() == "X" && event.toObject().value("name").toString() == name) {
+            spans.append(event);
+        }
+    }
+    return spans;
+}
+
+void TestTracer::testDisabled()
+{
+    QVERIFY(!Tracer::isEnabled());
+    {
+        TRACE_SCOPE("TestTracer", "untracedSpan");
+    }
+    QVERIFY(!Tracer::stop());  // Nothing to write when tracing wasn't started
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("trace.json");
+    Tracer::start(path);
+    QVERIFY(Tracer::stop());
+    QVERIFY(spansNamed(readEvents(path), "untracedSpan").isEmpty());
+}
+
+void TestTracer::testTraceFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("trace.json");
+
+    Tracer::start(path);
+    QVERIFY(Tracer::isEnabled());
+    {
+        TRACE_SCOPE_VALUE("TestTracer", "outerSpan", 7);
+        TRACE_SCOPE("TestTracer", "innerSpan");
+        QThread::msleep(2);
+    }
+    QScopedPointer<QThread> worker(QThread::create([]() {
+        TRACE_SCOPE("TestTracer", "workerSpan");
+    }));
+    worker->setObjectName("TraceWorker");
+    worker->start();
+    QVERIFY(worker->wait(5000));
+    QVERIFY(Tracer::stop());
+    QVERIFY(!Tracer::isEnabled());
+
+    const QJsonArray events = readEvents(path);
+    QVERIFY(!events.isEmpty());
+
+    const QJsonArray outer = spansNamed(events, "outerSpan");
+    QCOMPARE(outer.size(), 1);
+    const QJsonObject span = outer.first().toObject();
+    QCOMPARE(span.value("cat").toString(), QString("TestTracer"));
+    QVERIFY(span.value("dur").toDouble() >= 2000.0);  // Microseconds
+    QCOMPARE(span.value("args").toObject().value("value").toInt(), 7);
+
+    const QJsonObject inner = spansNamed(events, "innerSpan").first().toObject();
+    QVERIFY(inner.value("ts").toDouble() >= span.value("ts").toDouble());
+    QVERIFY(!inner.contains("args"));
+
+    // Worker spans are on their own, named thread track
+    const QJsonObject workerSpan = spansNamed(events, "workerSpan").first().toObject();
+    QVERIFY(workerSpan.value("tid").toInt() != span.value("tid").toInt());
+    QString threadName;
+    for (const QJsonValue &event : events) {
+        const QJsonObject object = event.toObject();
+        if (object.value("ph").toString() == "M" && object.value("tid").toInt() == workerSpan.value("tid").toInt()) {
+            threadName = object.value("args").toObject().value("name").toString();
+        }
+    }
+    QVERIFY(threadName.startsWith("TraceWorker"));
+}
+
+void TestTracer::testShortLivedThreads()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("trace.json");
+    const int before = Tracer::bufferCount();
+
+    // Like QThreadPool replacing idle threads: each new thread records, then exits
+    Tracer::start(path);
+    for (int i = 0; i < 20; ++i) {
+        QScopedPointer<QThread> worker(QThread::create([i]() {
+            TRACE_SCOPE_VALUE("TestTracer", "shortLivedSpan", i);
+        }));
+        worker->start();
+        QVERIFY(worker->wait(5000));
+    }
+
+    // Buffers are handed back once the threads are gone; at most 8 exited ones are kept
+    QTRY_VERIFY(Tracer::bufferCount() <= before + 8);
+    QVERIFY(Tracer::stop());
+
+    // The newest exited threads are still in the trace
+    const QJsonArray spans = spansNamed(readEvents(path), "shortLivedSpan");
+    QVERIFY(!spans.isEmpty());
+    QVERIFY(spans.size() <= 8);
+    bool hasLast = false;
+    for (const QJsonValue &span : spans) {
+        hasLast = hasLast || span.toObject().value("args").toObject().value("value").toInt() == 19;
+    }
+    QVERIFY(hasLast);
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_tracer.moc"
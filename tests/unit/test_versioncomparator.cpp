@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** @file test_versioncomparator.cpp
+** @brief Unit tests for VersionComparator
+**
+** Tests for:
+** - Identical frame lists
+** - Alignment of partially overlapping frame lists
+** - Worsened frames and tolerance
+** - Empty / disjoint series
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QVector>
+#include <QPointF>
+
+#include "../src/versioncomparator.h"
+
+class TestVersionComparator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Test cases
+    void testIdenticalFrames();
+    void testAlignment();
+    void testTolerance();
+    void testNoCommonFrames();
+};
+
+void TestVersionComparator::testIdenticalFrames()
+{
+    QVector<QPointF> base = { {0, 0.9}, {1, 0.9}, {2, 0.9}, {3, 0.9} };
+    QVector<QPointF> test = { {0, 0.9}, {1, 0.5}, {2, 0.95}, {3, 0.9} };
+
+    VersionDiff diff = VersionComparator::compare(base, test);
+    QVERIFY(diff.isValid());
+    QCOMPARE(diff.commonFrames, 4);
+    QCOMPARE(diff.worsenedFrames, 1);
+    QCOMPARE(diff.worstFrame, 1);
+    QVERIFY(qAbs(diff.worstDelta + 0.4) < 1e-6);
+    QVERIFY(qAbs(diff.meanDelta - (-0.35 / 4)) < 1e-6);
+}
+
+void TestVersionComparator::testAlignment()
+{
+    // Frames 2-4 are common; base has 0-4, test has 2-6
+    QVector<QPointF> base = { {0, 0.1}, {1, 0.1}, {2, 0.8}, {3, 0.8}, {4, 0.8} };
+    QVector<QPointF> test = { {2, 0.8}, {3, 0.6}, {4, 0.8}, {5, 0.1}, {6, 0.1} };
+
+    VersionDiff diff = VersionComparator::compare(base, test);
+    QCOMPARE(diff.commonFrames, 3);
+    QCOMPARE(diff.frames, QVector<int>({ 2, 3, 4 }));
+    QCOMPARE(diff.worsenedFrameList(VersionComparator::DefaultTolerance), QVector<int>({ 3 }));
+}
+
+void TestVersionComparator::testTolerance()
+{
+    // Drops smaller than the tolerance are noise; improvements never count
+    QVector<QPointF> base = { {0, 0.9}, {1, 0.9}, {2, 0.5} };
+    QVector<QPointF> test = { {0, 0.895}, {1, 0.8}, {2, 0.9} };
+
+    VersionDiff diff = VersionComparator::compare(base, test, 0.01);
+    QCOMPARE(diff.worsenedFrames, 1);
+    QCOMPARE(diff.worstFrame, 1);
+
+    diff = VersionComparator::compare(base, test, 0.2);
+    QCOMPARE(diff.worsenedFrames, 0);
+
+    // Nothing got worse at all
+    diff = VersionComparator::compare(base, base);
+    QCOMPARE(diff.worstDelta, 0.0);
+    QCOMPARE(diff.worstFrame, -1);
+}
+
+void TestVersionComparator::testNoCommonFrames()
+{
+    QVector<QPointF> base = { {0, 0.9}, {1, 0.9} };
+    QVector<QPointF> test = { {5, 0.9}, {6, 0.9} };
+
+    QVERIFY(!VersionComparator::compare(base, test).isValid());
+    QVERIFY(!VersionComparator::compare(QVector<QPointF>(), test).isValid());
+}
+
+// QTEST_MAIN removed - using shared main() in tests_main.cpp instead
+#include "test_versioncomparator.moc"
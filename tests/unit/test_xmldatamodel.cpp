@@ -9,6 +9,7 @@
 ** - Column width ratios
 ** - Row count
 ** - Test key extraction
+** - compareResult.xml lookup among sibling events sharing path parts
 **
 ****************************************************************************/
 
@@ -43,6 +44,7 @@ private slots:
     void testUpdateCellInvalid();
     void testGetThumbnailPath();
     void testGetTestKey();
+    void testPickCompareResultXmlSiblings();
 
 private:
     XmlDataModel *m_model;
@@ -238,5 +240,32 @@ void TestXmlDataModel::testGetTestKey()
     QVERIFY(testKey.isEmpty());
 }
 
+void TestXmlDataModel::testPickCompareResultXmlSiblings()
+{
+    // Two events of the same sport and stadium; the second has two frame folders
+    const QString root = QDir(m_tempDir->path()).filePath("siblings");
+    const QString versions = "/freedview_1_VS_freedview_2/results/compareResult.xml";
+    const QString other = root + "/MLB/Dodgers/E15_LIVE_10/S170123190428/F0001" + versions;
+    const QString first = root + "/MLB/Dodgers/E16_LIVE_11/S170123190428/F0001" + versions;
+    const QString second = root + "/MLB/Dodgers/E16_LIVE_11/S170123190428/F0002" + versions;
+    for (const QString &path : {other, first, second}) {
+        QVERIFY(QDir().mkpath(QFileInfo(path).path()));
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("<root/>");
+    }
+
+    // The sibling event comes first in the scan and shares the sport, stadium and set
+    const QStringList candidates = {other, first, second};
+    QCOMPARE(XmlDataModel::pickCompareResultXml(root, "E16_LIVE_11", "MLB/Dodgers/E16_LIVE_11/S170123190428/F0002",
+                                                candidates), second);
+    QCOMPARE(XmlDataModel::pickCompareResultXml(root, "E16_LIVE_11", "MLB/Dodgers/E16_LIVE_11/S170123190428/F0001",
+                                                candidates), first);
+
+    // No file for the frame folder: one of the same event, never the sibling's
+    QCOMPARE(XmlDataModel::pickCompareResultXml(root, "E16_LIVE_11", "MLB/Dodgers/E16_LIVE_11/S170123190428/F0003",
+                                                candidates), first);
+}
+
 // QTEST_MAIN removed - using shared main() in tests_main.cpp instead
 #include "test_xmldatamodel.moc"